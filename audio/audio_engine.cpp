@@ -19,7 +19,11 @@
 #define RW_HAS_MINIAUDIO 0
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -32,23 +36,132 @@ namespace audio {
 
 namespace {
 
+using Clock = std::chrono::steady_clock;
+
+// A virtual voice must be this much louder than a real one to take its
+// place, so voices of (nearly) equal loudness do not trade places on every
+// play — each swap cuts a sound mid-playback.
+constexpr float kRealVoiceBias = 1.1f;
+// Dropped sounds are logged at most this often, as one summary line.
+constexpr std::chrono::seconds kDropLogInterval{1};
+
+// A file decoded once to interleaved f32 at the engine's rate / channels.
+struct Clip {
+    std::vector<float> pcm;
+    ma_uint64          frames = 0;
+    uint32_t           channels = 0;
+    uint32_t           sample_rate = 0;
+    uint64_t           last_use = 0;
+    size_t bytes() const { return pcm.size() * sizeof(float); }
+};
+
+enum class Source : uint8_t { kClip, kStream, kPcm, kPcmStream };
+
+// openPcmStream() voices: a single-producer ring (appendPcm(), always under
+// State::mtx) drained by the audio thread.  `ds` must be the first member —
+// miniaudio hands the read callback a pointer to it.
+struct PcmStream {
+    ma_data_source_base ds{};
+    ma_pcm_rb           rb{};
+    uint32_t            sample_rate = 0;
+    std::atomic<bool>   finished{false};
+};
+
+// Audio thread.  Copies what the ring holds and pads a starved read with
+// silence, so the voice stays alive across a late append; only a finished
+// stream runs dry.
+ma_result pcmStreamRead(ma_data_source* ds, void* out, ma_uint64 frame_count,
+                        ma_uint64* frames_read) {
+    PcmStream& ps = *static_cast<PcmStream*>(ds);
+    // Load the flag BEFORE draining: finishPcm() follows the last append,
+    // so a ring found empty after seeing it set really is the end.
+    const bool finished = ps.finished.load(std::memory_order_acquire);
+    float* dst = static_cast<float*>(out);
+    ma_uint64 done = 0;
+    while (done < frame_count) {
+        ma_uint32 n = (ma_uint32)std::min<ma_uint64>(frame_count - done,
+                                                     0xffffffffu);
+        void* src = nullptr;
+        if (ma_pcm_rb_acquire_read(&ps.rb, &n, &src) != MA_SUCCESS || n == 0)
+            break;
+        std::memcpy(dst + done, src, n * sizeof(float));
+        ma_pcm_rb_commit_read(&ps.rb, n);
+        done += n;
+    }
+    if (done < frame_count && !finished) {
+        std::memset(dst + done, 0, (size_t)(frame_count - done) * sizeof(float));
+        done = frame_count;
+    }
+    if (frames_read) *frames_read = done;
+    return (done == 0 && finished) ? MA_AT_END : MA_SUCCESS;
+}
+
+ma_result pcmStreamFormat(ma_data_source* ds, ma_format* format,
+                          ma_uint32* channels, ma_uint32* sample_rate,
+                          ma_channel* channel_map, size_t channel_map_cap) {
+    const PcmStream& ps = *static_cast<const PcmStream*>(ds);
+    if (format)      *format = ma_format_f32;
+    if (channels)    *channels = 1;
+    if (sample_rate) *sample_rate = ps.sample_rate;
+    if (channel_map && channel_map_cap) channel_map[0] = MA_CHANNEL_MONO;
+    return MA_SUCCESS;
+}
+
+ma_data_source_vtable g_pcm_stream_vtable = {
+    pcmStreamRead,
+    nullptr,          // onSeek — a live stream has no position to seek to
+    pcmStreamFormat,
+    nullptr,          // onGetCursor
+    nullptr,          // onGetLength — unknown until finished
+    nullptr,          // onSetLooping
+    0
+};
+
+// One entry of the fixed voice pool.  The miniaudio objects are embedded so
+// a slot never moves once its sound is initialised.
 struct Voice {
-    std::unique_ptr<ma_sound>        sound;
-    // Owning copy of raw PCM for playPcm() voices (file voices leave these
-    // empty).  ma_audio_buffer refers into pcm — keep both alive together.
-    std::unique_ptr<ma_audio_buffer> buffer;
-    std::vector<float>               pcm;
-    bool                             looping = false;
-    int                              bus     = 0;
+    ma_sound                    sound{};
+    // Clip voices: this voice's cursor into the shared clip->pcm.
+    ma_audio_buffer_ref         ref{};
+    // playPcm voices: owning copy of the samples (buffer refers into pcm).
+    ma_audio_buffer             buffer{};
+    std::vector<float>          pcm;
+    // openPcmStream voices.  Heap-held: the ring is sized per stream.
+    std::unique_ptr<PcmStream>  pcm_stream;
+    std::shared_ptr<const Clip> clip;
+    Source                      source     = Source::kClip;
+    uint32_t                    generation = 0;
+    uint32_t                    active_pos = 0;     // index in State::active
+    bool                        active     = false;
+    bool                        real       = false; // `sound` initialised
+    bool                        looping    = false;
+    int                         bus        = 0;
+    float                       volume     = 1.0f;
+    // Virtual voices: frame reached when it went virtual, and when.
+    ma_uint64                   cursor     = 0;
+    Clock::time_point           virtual_since{};
 };
 
 struct State {
     ma_engine                          engine{};
+    ma_context                         context{};
+    bool                               own_context = false;
     ma_sound_group                     groups[AudioEngine::kNumBuses]{};
     float                              volumes[AudioEngine::kNumBuses] =
                                            {1.0f, 1.0f, 1.0f};
-    std::unordered_map<uint64_t, Voice> voices;
-    uint64_t                           next_handle = 1;
+    AudioEngineConfig                  config;
+    std::unique_ptr<Voice[]>           voices;
+    std::vector<uint32_t>              free_slots;
+    std::vector<uint32_t>              active;      // slot indices in use
+    std::vector<uint32_t>              scratch;     // update() ranking
+    std::unordered_map<std::string, std::shared_ptr<Clip>> clips;
+    size_t                             clip_bytes  = 0;
+    uint64_t                           use_clock   = 0;
+    uint64_t                           clip_decodes = 0;
+    uint64_t                           clip_hits    = 0;
+    uint64_t                           dropped      = 0;
+    uint64_t                           dropped_unlogged = 0;
+    Clock::time_point                  last_drop_log{};
     bool                               inited      = false;
     bool                               failed      = false;
     std::mutex                         mtx;
@@ -59,13 +172,43 @@ State& S() {
     return s;
 }
 
+uint64_t makeHandle(uint32_t slot, uint32_t generation) {
+    return ((uint64_t)generation << 32) | (uint64_t)(slot + 1);
+}
+
 // Caller must hold S().mtx.
-bool initLocked() {
+Voice* lookupLocked(uint64_t handle) {
+    State& s = S();
+    if (!s.inited) return nullptr;
+    const uint32_t slot = (uint32_t)(handle & 0xffffffffu);
+    if (slot == 0 || slot > s.config.max_voices) return nullptr;
+    Voice& v = s.voices[slot - 1];
+    if (!v.active || v.generation != (uint32_t)(handle >> 32)) return nullptr;
+    return &v;
+}
+
+// Caller must hold S().mtx.
+bool initLocked(const AudioEngineConfig& config) {
     State& s = S();
     if (s.inited) return true;
     if (s.failed) return false;
-    if (ma_engine_init(nullptr, &s.engine) != MA_SUCCESS) {
+    s.config = config;
+    s.config.max_voices = std::max<uint32_t>(1, s.config.max_voices);
+    ma_engine_config ecfg = ma_engine_config_init();
+    if (s.config.null_backend) {
+        const ma_backend backends[] = { ma_backend_null };
+        if (ma_context_init(backends, 1, nullptr, &s.context) != MA_SUCCESS) {
+            std::printf("[audio] null backend unavailable — audio disabled\n");
+            s.failed = true;
+            return false;
+        }
+        s.own_context = true;
+        ecfg.pContext = &s.context;
+    }
+    if (ma_engine_init(&ecfg, &s.engine) != MA_SUCCESS) {
         std::printf("[audio] ma_engine_init failed — audio disabled\n");
+        if (s.own_context) ma_context_uninit(&s.context);
+        s.own_context = false;
         s.failed = true;
         return false;
     }
@@ -75,11 +218,21 @@ bool initLocked() {
             std::printf("[audio] bus %d init failed — audio disabled\n", i);
             for (int j = 0; j < i; ++j) ma_sound_group_uninit(&s.groups[j]);
             ma_engine_uninit(&s.engine);
+            if (s.own_context) ma_context_uninit(&s.context);
+            s.own_context = false;
             s.failed = true;
             return false;
         }
         ma_sound_group_set_volume(&s.groups[i], s.volumes[i]);
     }
+    const uint32_t n = s.config.max_voices;
+    s.voices = std::make_unique<Voice[]>(n);
+    s.free_slots.clear();
+    s.free_slots.reserve(n);
+    for (uint32_t i = n; i > 0; --i) s.free_slots.push_back(i - 1);
+    s.active.clear();
+    s.active.reserve(n);
+    s.scratch.reserve(n);
     s.inited = true;
     std::printf("[audio] engine initialised (%u Hz, %u ch)\n",
                 ma_engine_get_sample_rate(&s.engine),
@@ -87,41 +240,279 @@ bool initLocked() {
     return true;
 }
 
+// Caller must hold S().mtx.
+void uninitSoundLocked(Voice& v) {
+    if (!v.real) return;
+    ma_sound_uninit(&v.sound);
+    if (v.source == Source::kClip) ma_audio_buffer_ref_uninit(&v.ref);
+    if (v.source == Source::kPcm)  ma_audio_buffer_uninit(&v.buffer);
+    if (v.source == Source::kPcmStream) {
+        ma_data_source_uninit(&v.pcm_stream->ds);
+        ma_pcm_rb_uninit(&v.pcm_stream->rb);
+    }
+    v.real = false;
+}
+
+// Caller must hold S().mtx.
+Voice* allocVoiceLocked(uint32_t& out_slot) {
+    State& s = S();
+    if (s.free_slots.empty()) {
+        // A saturated pool drops sounds every frame (footsteps, impacts):
+        // count them all, report them once in a while.
+        ++s.dropped;
+        ++s.dropped_unlogged;
+        const Clock::time_point now = Clock::now();
+        if (now - s.last_drop_log >= kDropLogInterval) {
+            std::printf("[audio] all %u voices in use — %llu sound(s) "
+                        "dropped\n", s.config.max_voices,
+                        (unsigned long long)s.dropped_unlogged);
+            s.dropped_unlogged = 0;
+            s.last_drop_log = now;
+        }
+        return nullptr;
+    }
+    out_slot = s.free_slots.back();
+    s.free_slots.pop_back();
+    Voice& v = s.voices[out_slot];
+    v.active     = true;
+    v.real       = false;
+    v.looping    = false;   // a recycled slot may have held a loop
+    v.active_pos = (uint32_t)s.active.size();
+    s.active.push_back(out_slot);
+    return &v;
+}
+
+// Caller must hold S().mtx.
+void releaseVoiceLocked(uint32_t slot) {
+    State& s = S();
+    Voice& v = s.voices[slot];
+    uninitSoundLocked(v);
+    v.clip.reset();
+    v.pcm.clear();
+    v.pcm_stream.reset();
+    v.active = false;
+    v.cursor = 0;
+    ++v.generation;
+    const uint32_t pos = v.active_pos;
+    s.active[pos] = s.active.back();
+    s.voices[s.active[pos]].active_pos = pos;
+    s.active.pop_back();
+    s.free_slots.push_back(slot);
+}
+
+// Caller must hold S().mtx.  Frame a virtual clip voice has reached; false
+// if a one-shot ran off its end while virtual.
+bool virtualCursorLocked(const Voice& v, ma_uint64& out) {
+    const double secs = std::chrono::duration<double>(
+        Clock::now() - v.virtual_since).count();
+    ma_uint64 pos = v.cursor + (ma_uint64)(secs * v.clip->sample_rate);
+    if (pos >= v.clip->frames) {
+        if (!v.looping || v.clip->frames == 0) return false;
+        pos %= v.clip->frames;
+    }
+    out = pos;
+    return true;
+}
+
+// Caller must hold S().mtx.  Start mixing a clip voice from `cursor`.
+bool makeRealLocked(Voice& v, ma_uint64 cursor) {
+    State& s = S();
+    const Clip& c = *v.clip;
+    if (ma_audio_buffer_ref_init(ma_format_f32, c.channels, c.pcm.data(),
+                                 c.frames, &v.ref) != MA_SUCCESS)
+        return false;
+    v.ref.sampleRate = c.sample_rate;
+    if (ma_sound_init_from_data_source(
+            &s.engine, &v.ref, MA_SOUND_FLAG_NO_SPATIALIZATION,
+            &s.groups[v.bus], &v.sound) != MA_SUCCESS) {
+        ma_audio_buffer_ref_uninit(&v.ref);
+        return false;
+    }
+    v.real = true;
+    ma_sound_set_volume(&v.sound, v.volume);
+    ma_sound_set_looping(&v.sound, v.looping ? MA_TRUE : MA_FALSE);
+    if (cursor) ma_sound_seek_to_pcm_frame(&v.sound, cursor);
+    ma_sound_start(&v.sound);
+    return true;
+}
+
+// Caller must hold S().mtx.
+void makeVirtualLocked(Voice& v) {
+    ma_uint64 cursor = 0;
+    ma_sound_get_cursor_in_pcm_frames(&v.sound, &cursor);
+    uninitSoundLocked(v);
+    v.cursor        = cursor;
+    v.virtual_since = Clock::now();
+}
+
 // Caller must hold S().mtx.
 void reapFinishedLocked() {
     State& s = S();
-    for (auto it = s.voices.begin(); it != s.voices.end();) {
-        Voice& v = it->second;
-        if (!v.looping && v.sound &&
-            !ma_sound_is_playing(v.sound.get()) &&
-            ma_sound_at_end(v.sound.get())) {
-            ma_sound_uninit(v.sound.get());
-            if (v.buffer) ma_audio_buffer_uninit(v.buffer.get());
-            it = s.voices.erase(it);
-        } else {
-            ++it;
+    for (size_t i = s.active.size(); i-- > 0;) {
+        const uint32_t slot = s.active[i];
+        Voice& v = s.voices[slot];
+        bool done = false;
+        if (v.real) {
+            done = !v.looping && !ma_sound_is_playing(&v.sound) &&
+                   ma_sound_at_end(&v.sound);
+        } else if (v.source == Source::kClip) {
+            ma_uint64 pos = 0;
+            done = !virtualCursorLocked(v, pos);
         }
+        if (done) releaseVoiceLocked(slot);
+    }
+}
+
+// Caller must hold S().mtx.  Keep the loudest max_real_voices clip voices
+// real and the rest virtual.  Real voices rank kRealVoiceBias louder than
+// they are and win ties, and the order is total (slot last), so the result
+// never depends on the order of s.active.  Demotions run before promotions
+// so the cap holds throughout.
+void rebalanceLocked() {
+    State& s = S();
+    s.scratch.clear();
+    for (uint32_t slot : s.active)
+        if (s.voices[slot].source == Source::kClip) s.scratch.push_back(slot);
+    auto score = [&s](uint32_t slot) {
+        const Voice& v = s.voices[slot];
+        return v.volume * s.volumes[v.bus] * (v.real ? kRealVoiceBias : 1.0f);
+    };
+    const size_t keep = std::min<size_t>(s.config.max_real_voices,
+                                         s.scratch.size());
+    if (keep < s.scratch.size()) {
+        std::nth_element(s.scratch.begin(), s.scratch.begin() + keep,
+                         s.scratch.end(), [&](uint32_t a, uint32_t b) {
+                             const float sa = score(a), sb = score(b);
+                             if (sa != sb) return sa > sb;
+                             const bool ra = s.voices[a].real;
+                             const bool rb = s.voices[b].real;
+                             if (ra != rb) return ra;
+                             return a < b;
+                         });
+    }
+    for (size_t i = keep; i < s.scratch.size(); ++i) {
+        Voice& v = s.voices[s.scratch[i]];
+        if (v.real) makeVirtualLocked(v);
+    }
+    for (size_t i = 0; i < keep; ++i) {
+        const uint32_t slot = s.scratch[i];
+        Voice& v = s.voices[slot];
+        if (v.real) continue;
+        ma_uint64 cursor = 0;
+        if (!virtualCursorLocked(v, cursor) || !makeRealLocked(v, cursor))
+            releaseVoiceLocked(slot);
+    }
+}
+
+// Caller must hold S().mtx.
+void evictClipsLocked(size_t budget) {
+    State& s = S();
+    while (s.clip_bytes > budget) {
+        auto victim = s.clips.end();
+        for (auto it = s.clips.begin(); it != s.clips.end(); ++it) {
+            if (it->second.use_count() > 1) continue;   // a voice holds it
+            if (victim == s.clips.end() ||
+                it->second->last_use < victim->second->last_use)
+                victim = it;
+        }
+        if (victim == s.clips.end()) return;
+        s.clip_bytes -= victim->second->bytes();
+        s.clips.erase(victim);
+    }
+}
+
+enum class DecodeResult { kOk, kTooLong, kFailed };
+
+// Decode a whole file to f32 at the engine format.  Runs WITHOUT the state
+// lock so a slow disk or a long mp3 never blocks other audio calls.
+DecodeResult decodeClip(const std::string& path, uint32_t channels,
+                        uint32_t sample_rate, size_t max_bytes, Clip& out) {
+    ma_decoder_config cfg =
+        ma_decoder_config_init(ma_format_f32, channels, sample_rate);
+    ma_decoder dec;
+    if (ma_decoder_init_file(path.c_str(), &cfg, &dec) != MA_SUCCESS)
+        return DecodeResult::kFailed;
+    ma_uint64 length = 0;
+    if (ma_decoder_get_length_in_pcm_frames(&dec, &length) == MA_SUCCESS &&
+        length * channels * sizeof(float) > max_bytes) {
+        ma_decoder_uninit(&dec);
+        return DecodeResult::kTooLong;
+    }
+    out.channels    = channels;
+    out.sample_rate = sample_rate;
+    out.pcm.resize((size_t)(length ? length : sample_rate) * channels);
+    ma_uint64 frames = 0;
+    for (;;) {
+        const ma_uint64 cap = out.pcm.size() / channels;
+        if (frames == cap) {
+            if (cap * channels * sizeof(float) > max_bytes) break;
+            out.pcm.resize((size_t)cap * 2 * channels);
+        }
+        ma_uint64 got = 0;
+        const ma_result r = ma_decoder_read_pcm_frames(
+            &dec, out.pcm.data() + frames * channels,
+            out.pcm.size() / channels - frames, &got);
+        frames += got;
+        if (r != MA_SUCCESS || got == 0) break;
+    }
+    ma_decoder_uninit(&dec);
+    if (frames * channels * sizeof(float) > max_bytes)
+        return DecodeResult::kTooLong;
+    if (frames == 0) return DecodeResult::kFailed;
+    out.pcm.resize((size_t)frames * channels);
+    out.pcm.shrink_to_fit();
+    out.frames = frames;
+    return DecodeResult::kOk;
+}
+
+// Caller must hold S().mtx.
+uint64_t playStreamLocked(const std::string& path, AudioEngine::Bus bus,
+                          bool loop, float volume) {
+    State& s = S();
+    uint32_t slot = 0;
+    Voice* v = allocVoiceLocked(slot);
+    if (!v) return 0;
+    v->source  = Source::kStream;
+    v->bus     = (int)bus;
+    v->looping = loop;
+    v->volume  = volume;
+    const ma_result r = ma_sound_init_from_file(
+        &s.engine, path.c_str(),
+        MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_NO_SPATIALIZATION,
+        &s.groups[(int)bus], nullptr, &v->sound);
+    if (r != MA_SUCCESS) {
+        std::printf("[audio] failed to stream '%s' (err %d)\n",
+                    path.c_str(), (int)r);
+        releaseVoiceLocked(slot);
+        return 0;
     }
+    v->real = true;
+    ma_sound_set_volume(&v->sound, volume);
+    ma_sound_set_looping(&v->sound, loop ? MA_TRUE : MA_FALSE);
+    ma_sound_start(&v->sound);
+    return makeHandle(slot, v->generation);
 }
 
 } // namespace
 
-bool AudioEngine::init() {
+bool AudioEngine::init(const AudioEngineConfig& config) {
     std::lock_guard<std::mutex> lk(S().mtx);
-    return initLocked();
+    return initLocked(config);
 }
 
 void AudioEngine::shutdown() {
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
     if (!s.inited) return;
-    for (auto& [h, v] : s.voices) {
-        if (v.sound) ma_sound_uninit(v.sound.get());
-        if (v.buffer) ma_audio_buffer_uninit(v.buffer.get());
-    }
-    s.voices.clear();
+    while (!s.active.empty()) releaseVoiceLocked(s.active.back());
     for (int i = 0; i < kNumBuses; ++i) ma_sound_group_uninit(&s.groups[i]);
     ma_engine_uninit(&s.engine);
+    if (s.own_context) ma_context_uninit(&s.context);
+    s.own_context = false;
+    s.voices.reset();
+    s.free_slots.clear();
+    s.clips.clear();
+    s.clip_bytes = 0;
     s.inited = false;
 }
 
@@ -133,29 +524,72 @@ bool AudioEngine::ready() {
 uint64_t AudioEngine::playFile(const std::string& path, Bus bus, bool loop,
                                float volume) {
     State& s = S();
-    std::lock_guard<std::mutex> lk(s.mtx);
-    if (!initLocked()) return 0;
-    reapFinishedLocked();
+    std::shared_ptr<const Clip> clip;
+    uint32_t channels = 0, sample_rate = 0;
+    size_t max_clip_bytes = 0;
+    {
+        std::lock_guard<std::mutex> lk(s.mtx);
+        if (!initLocked(AudioEngineConfig{})) return 0;
+        reapFinishedLocked();
+        // Music is long and plays once or twice — stream it.
+        if (bus == Bus::kMusic) return playStreamLocked(path, bus, loop, volume);
+        auto it = s.clips.find(path);
+        if (it != s.clips.end()) {
+            it->second->last_use = ++s.use_clock;
+            ++s.clip_hits;
+            clip = it->second;
+        }
+        channels       = ma_engine_get_channels(&s.engine);
+        sample_rate    = ma_engine_get_sample_rate(&s.engine);
+        max_clip_bytes = s.config.clip_cache_bytes / 4;
+    }
 
-    Voice v;
-    v.sound   = std::make_unique<ma_sound>();
-    v.looping = loop;
-    v.bus     = (int)bus;
-    const ma_result r = ma_sound_init_from_file(
-        &s.engine, path.c_str(),
-        MA_SOUND_FLAG_NO_SPATIALIZATION,
-        &s.groups[(int)bus], nullptr, v.sound.get());
-    if (r != MA_SUCCESS) {
-        std::printf("[audio] failed to load '%s' (err %d)\n",
-                    path.c_str(), (int)r);
-        return 0;
+    if (!clip) {
+        auto decoded = std::make_shared<Clip>();
+        const DecodeResult r =
+            decodeClip(path, channels, sample_rate, max_clip_bytes, *decoded);
+        std::lock_guard<std::mutex> lk(s.mtx);
+        if (!s.inited) return 0;
+        if (r == DecodeResult::kFailed) {
+            std::printf("[audio] failed to load '%s'\n", path.c_str());
+            return 0;
+        }
+        if (r == DecodeResult::kTooLong)
+            return playStreamLocked(path, bus, loop, volume);
+        // Another thread may have decoded the same file meanwhile.
+        auto it = s.clips.find(path);
+        if (it == s.clips.end()) {
+            ++s.clip_decodes;
+            s.clip_bytes += decoded->bytes();
+            it = s.clips.emplace(path, std::move(decoded)).first;
+        }
+        it->second->last_use = ++s.use_clock;
+        clip = it->second;
     }
-    ma_sound_set_volume(v.sound.get(), volume);
-    ma_sound_set_looping(v.sound.get(), loop ? MA_TRUE : MA_FALSE);
-    ma_sound_start(v.sound.get());
 
-    const uint64_t h = s.next_handle++;
-    s.voices.emplace(h, std::move(v));
+    std::lock_guard<std::mutex> lk(s.mtx);
+    if (!s.inited) return 0;
+    uint32_t slot = 0;
+    Voice* v = allocVoiceLocked(slot);
+    if (!v) return 0;
+    v->source        = Source::kClip;
+    v->clip          = std::move(clip);
+    v->bus           = (int)bus;
+    v->looping       = loop;
+    v->volume        = volume;
+    v->cursor        = 0;
+    v->virtual_since = Clock::now();
+    const uint64_t h = makeHandle(slot, v->generation);
+    // Starts virtual; the ranking makes it real if it is loud enough.  A
+    // voice that stays virtual is a valid handle.  It only disappears here
+    // when promoting it failed (the mixer could not start the sound), which
+    // is a failure like any other.
+    rebalanceLocked();
+    evictClipsLocked(s.config.clip_cache_bytes);
+    if (!lookupLocked(h)) {
+        std::printf("[audio] could not start '%s'\n", path.c_str());
+        return 0;
+    }
     return h;
 }
 
@@ -164,86 +598,172 @@ uint64_t AudioEngine::playPcm(const float* samples, size_t sample_count,
     if (!samples || sample_count == 0) return 0;
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
-    if (!initLocked()) return 0;
+    if (!initLocked(AudioEngineConfig{})) return 0;
     reapFinishedLocked();
 
-    Voice v;
-    v.bus = (int)bus;
-    v.pcm.assign(samples, samples + sample_count);
-    v.buffer = std::make_unique<ma_audio_buffer>();
+    uint32_t slot = 0;
+    Voice* v = allocVoiceLocked(slot);
+    if (!v) return 0;
+    v->source = Source::kPcm;
+    v->bus    = (int)bus;
+    v->volume = volume;
+    v->pcm.assign(samples, samples + sample_count);
     ma_audio_buffer_config cfg = ma_audio_buffer_config_init(
-        ma_format_f32, /*channels=*/1, sample_count, v.pcm.data(), nullptr);
+        ma_format_f32, /*channels=*/1, sample_count, v->pcm.data(), nullptr);
     cfg.sampleRate = sample_rate;
-    if (ma_audio_buffer_init(&cfg, v.buffer.get()) != MA_SUCCESS) {
+    if (ma_audio_buffer_init(&cfg, &v->buffer) != MA_SUCCESS) {
         std::printf("[audio] playPcm: buffer init failed\n");
+        releaseVoiceLocked(slot);
         return 0;
     }
-    v.sound = std::make_unique<ma_sound>();
     if (ma_sound_init_from_data_source(
-            &s.engine, v.buffer.get(), MA_SOUND_FLAG_NO_SPATIALIZATION,
-            &s.groups[(int)bus], v.sound.get()) != MA_SUCCESS) {
-        ma_audio_buffer_uninit(v.buffer.get());
+            &s.engine, &v->buffer, MA_SOUND_FLAG_NO_SPATIALIZATION,
+            &s.groups[(int)bus], &v->sound) != MA_SUCCESS) {
+        ma_audio_buffer_uninit(&v->buffer);
         std::printf("[audio] playPcm: sound init failed\n");
+        releaseVoiceLocked(slot);
         return 0;
     }
-    ma_sound_set_volume(v.sound.get(), volume);
-    ma_sound_start(v.sound.get());
+    v->real = true;
+    ma_sound_set_volume(&v->sound, volume);
+    ma_sound_start(&v->sound);
+    return makeHandle(slot, v->generation);
+}
 
-    const uint64_t h = s.next_handle++;
-    s.voices.emplace(h, std::move(v));
-    return h;
+uint64_t AudioEngine::openPcmStream(uint32_t sample_rate, Bus bus,
+                                   float volume, float capacity_seconds) {
+    if (sample_rate == 0) return 0;
+    State& s = S();
+    std::lock_guard<std::mutex> lk(s.mtx);
+    if (!initLocked(AudioEngineConfig{})) return 0;
+    reapFinishedLocked();
+
+    uint32_t slot = 0;
+    Voice* v = allocVoiceLocked(slot);
+    if (!v) return 0;
+    v->source = Source::kPcmStream;
+    v->bus    = (int)bus;
+    v->volume = volume;
+    v->pcm_stream = std::make_unique<PcmStream>();
+    PcmStream& ps = *v->pcm_stream;
+    ps.sample_rate = sample_rate;
+    const ma_uint32 frames = (ma_uint32)std::max(
+        1.0f, capacity_seconds * (float)sample_rate);
+    if (ma_pcm_rb_init(ma_format_f32, 1, frames, nullptr, nullptr,
+                       &ps.rb) != MA_SUCCESS) {
+        std::printf("[audio] openPcmStream: ring init failed\n");
+        releaseVoiceLocked(slot);
+        return 0;
+    }
+    ma_data_source_config dcfg = ma_data_source_config_init();
+    dcfg.vtable = &g_pcm_stream_vtable;
+    if (ma_data_source_init(&dcfg, &ps.ds) != MA_SUCCESS) {
+        ma_pcm_rb_uninit(&ps.rb);
+        std::printf("[audio] openPcmStream: data source init failed\n");
+        releaseVoiceLocked(slot);
+        return 0;
+    }
+    if (ma_sound_init_from_data_source(
+            &s.engine, &ps.ds, MA_SOUND_FLAG_NO_SPATIALIZATION,
+            &s.groups[(int)bus], &v->sound) != MA_SUCCESS) {
+        ma_data_source_uninit(&ps.ds);
+        ma_pcm_rb_uninit(&ps.rb);
+        std::printf("[audio] openPcmStream: sound init failed\n");
+        releaseVoiceLocked(slot);
+        return 0;
+    }
+    v->real = true;
+    ma_sound_set_volume(&v->sound, volume);
+    ma_sound_start(&v->sound);
+    return makeHandle(slot, v->generation);
+}
+
+size_t AudioEngine::appendPcm(uint64_t handle, const float* samples,
+                              size_t sample_count) {
+    if (!samples || sample_count == 0) return 0;
+    std::lock_guard<std::mutex> lk(S().mtx);
+    Voice* v = lookupLocked(handle);
+    if (!v || v->source != Source::kPcmStream ||
+        v->pcm_stream->finished.load(std::memory_order_relaxed))
+        return 0;
+    ma_pcm_rb& rb = v->pcm_stream->rb;
+    size_t done = 0;
+    while (done < sample_count) {
+        ma_uint32 n = (ma_uint32)std::min<size_t>(sample_count - done,
+                                                  0xffffffffu);
+        void* dst = nullptr;
+        if (ma_pcm_rb_acquire_write(&rb, &n, &dst) != MA_SUCCESS || n == 0)
+            break;
+        std::memcpy(dst, samples + done, n * sizeof(float));
+        ma_pcm_rb_commit_write(&rb, n);
+        done += n;
+    }
+    return done;
+}
+
+void AudioEngine::finishPcm(uint64_t handle) {
+    std::lock_guard<std::mutex> lk(S().mtx);
+    Voice* v = lookupLocked(handle);
+    if (v && v->source == Source::kPcmStream)
+        v->pcm_stream->finished.store(true, std::memory_order_release);
+}
+
+size_t AudioEngine::pcmQueued(uint64_t handle) {
+    std::lock_guard<std::mutex> lk(S().mtx);
+    Voice* v = lookupLocked(handle);
+    if (!v || v->source != Source::kPcmStream) return 0;
+    return ma_pcm_rb_available_read(&v->pcm_stream->rb);
 }
 
 void AudioEngine::stop(uint64_t handle) {
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
-    auto it = s.voices.find(handle);
-    if (it == s.voices.end()) return;
-    if (it->second.sound) ma_sound_uninit(it->second.sound.get());
-    if (it->second.buffer) ma_audio_buffer_uninit(it->second.buffer.get());
-    s.voices.erase(it);
+    if (lookupLocked(handle))
+        releaseVoiceLocked((uint32_t)(handle & 0xffffffffu) - 1);
 }
 
 void AudioEngine::stopAll() {
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
-    for (auto& [h, v] : s.voices) {
-        if (v.sound) ma_sound_uninit(v.sound.get());
-        if (v.buffer) ma_audio_buffer_uninit(v.buffer.get());
-    }
-    s.voices.clear();
+    if (!s.inited) return;
+    while (!s.active.empty()) releaseVoiceLocked(s.active.back());
 }
 
 void AudioEngine::stopBus(Bus bus) {
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
     if (!s.inited) return;
-    for (auto it = s.voices.begin(); it != s.voices.end();) {
-        Voice& v = it->second;
-        if (v.bus == (int)bus) {
-            ma_sound_uninit(v.sound.get());
-            if (v.buffer) ma_audio_buffer_uninit(v.buffer.get());
-            it = s.voices.erase(it);
-        } else {
-            ++it;
-        }
+    for (size_t i = s.active.size(); i-- > 0;) {
+        const uint32_t slot = s.active[i];
+        if (s.voices[slot].bus == (int)bus) releaseVoiceLocked(slot);
     }
 }
 
 bool AudioEngine::isPlaying(uint64_t handle) {
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
-    auto it = s.voices.find(handle);
-    return it != s.voices.end() && it->second.sound &&
-           ma_sound_is_playing(it->second.sound.get());
+    const Voice* v = lookupLocked(handle);
+    if (!v) return false;
+    if (!v->real) {
+        ma_uint64 pos = 0;
+        return virtualCursorLocked(*v, pos);
+    }
+    return ma_sound_is_playing(&v->sound);
 }
 
-void AudioEngine::setVolume(uint64_t handle, float v) {
+bool AudioEngine::isVirtual(uint64_t handle) {
+    std::lock_guard<std::mutex> lk(S().mtx);
+    const Voice* v = lookupLocked(handle);
+    return v && !v->real;
+}
+
+void AudioEngine::setVolume(uint64_t handle, float volume) {
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
-    auto it = s.voices.find(handle);
-    if (it != s.voices.end() && it->second.sound)
-        ma_sound_set_volume(it->second.sound.get(), v);
+    Voice* v = lookupLocked(handle);
+    if (!v) return;
+    v->volume = volume;
+    if (v->real) ma_sound_set_volume(&v->sound, volume);
 }
 
 void AudioEngine::setBusVolume(Bus bus, float v) {
@@ -261,12 +781,42 @@ float AudioEngine::busVolume(Bus bus) {
 void AudioEngine::update() {
     State& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
-    if (s.inited) reapFinishedLocked();
+    if (!s.inited) return;
+    reapFinishedLocked();
+    rebalanceLocked();
+}
+
+void AudioEngine::trimClipCache() {
+    std::lock_guard<std::mutex> lk(S().mtx);
+    evictClipsLocked(0);
+}
+
+AudioEngineStats AudioEngine::stats() {
+    State& s = S();
+    std::lock_guard<std::mutex> lk(s.mtx);
+    AudioEngineStats st;
+    for (uint32_t slot : s.active) {
+        const Voice& v = s.voices[slot];
+        switch (v.source) {
+        case Source::kClip:
+            (v.real ? st.real_voices : st.virtual_voices)++;
+            break;
+        case Source::kStream: ++st.stream_voices; break;
+        case Source::kPcm:
+        case Source::kPcmStream: ++st.pcm_voices; break;
+        }
+    }
+    st.cached_clips = s.clips.size();
+    st.cached_bytes = s.clip_bytes;
+    st.clip_decodes = s.clip_decodes;
+    st.clip_hits    = s.clip_hits;
+    st.dropped_sounds = s.dropped;
+    return st;
 }
 
 #else // !RW_HAS_MINIAUDIO — stub backend (engine builds without audio)
 
-bool AudioEngine::init() {
+bool AudioEngine::init(const AudioEngineConfig&) {
     static bool warned = false;
     if (!warned) {
         warned = true;
@@ -285,14 +835,24 @@ uint64_t AudioEngine::playPcm(const float*, size_t, uint32_t, Bus, float) {
     init();
     return 0;
 }
+uint64_t AudioEngine::openPcmStream(uint32_t, Bus, float, float) {
+    init();
+    return 0;
+}
+size_t AudioEngine::appendPcm(uint64_t, const float*, size_t) { return 0; }
+void   AudioEngine::finishPcm(uint64_t) {}
+size_t AudioEngine::pcmQueued(uint64_t) { return 0; }
 void  AudioEngine::stop(uint64_t) {}
 void  AudioEngine::stopAll() {}
 void  AudioEngine::stopBus(Bus) {}
 bool  AudioEngine::isPlaying(uint64_t) { return false; }
+bool  AudioEngine::isVirtual(uint64_t) { return false; }
 void  AudioEngine::setVolume(uint64_t, float) {}
 void  AudioEngine::setBusVolume(Bus, float) {}
 float AudioEngine::busVolume(Bus) { return 1.0f; }
 void  AudioEngine::update() {}
+void  AudioEngine::trimClipCache() {}
+AudioEngineStats AudioEngine::stats() { return {}; }
 
 #endif // RW_HAS_MINIAUDIO
 
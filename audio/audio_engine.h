@@ -13,32 +13,91 @@
 // File playback supports .wav / .mp3 / .flac (miniaudio built-in decoders).
 // playPcm() exists for the ML text-to-voice path: a TTS backend synthesises
 // mono float32 PCM and hands it straight to the voice bus without touching
-// disk.
+// disk.  openPcmStream() is its streaming form: one voice fed sentence by
+// sentence through appendPcm() while it plays, so consecutive lines join
+// without a gap.
+//
+// Playback paths:
+//   - one-shots / SFX are decoded ONCE into a shared clip cache (f32 PCM at
+//     the engine's rate and channel count); every voice playing the same
+//     file reads the same samples through its own cursor.  Unused clips
+//     are evicted least-recently-played first once the cache exceeds
+//     clip_cache_bytes.
+//   - kMusic, and any file whose decoded PCM would take more than a quarter
+//     of the cache, streams instead: miniaudio's resource manager decodes
+//     it page by page on its job thread.
+//   - playPcm() voices own their samples.
+//   - PCM stream voices read a fixed-size lock-free ring that appendPcm()
+//     fills; starved, they play silence until more arrives or until
+//     finishPcm() lets them end.
+//
+// Voice virtualisation: at most max_real_voices cached-clip voices are
+// mixed at a time — the loudest (volume x bus volume), re-ranked every
+// update(), with a small bias toward voices that are already real so
+// equally loud sounds do not keep swapping.  The rest are VIRTUAL: their sound is released and only a start
+// cursor and a timestamp are kept, so a crowd of emitters costs nothing in
+// the mixer.  A virtual voice that becomes loud enough is resumed at the
+// position it would have reached.  Streams and PCM voices (music, dialog)
+// are never virtualised.
+//
+// Voices live in a fixed slot pool allocated at init; handles carry a
+// generation so a stale handle never aliases a recycled slot.  The audio
+// thread only ever reads pre-decoded memory or the resource manager's
+// stream pages — nothing on it allocates.
 //
 // Implementation detail: if third_parties/miniaudio/miniaudio.h is absent
 // (CMake downloads it at configure time), every call degrades to a no-op
 // returning failure — the engine still builds and runs silently.
 // ─────────────────────────────────────────────────────────────────────────────
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
 namespace engine {
 namespace audio {
 
+struct AudioEngineConfig {
+    // Decoded-clip cache budget.
+    size_t   clip_cache_bytes = 64ull << 20;
+    // Cached-clip voices mixed at once; quieter ones go virtual.
+    uint32_t max_real_voices = 32;
+    // Voices tracked at once (real + virtual + streams + PCM).
+    uint32_t max_voices = 256;
+    // Use miniaudio's null backend (no output device; mixes in real time
+    // on its own thread).  For tests and headless tools.
+    bool     null_backend = false;
+};
+
+struct AudioEngineStats {
+    uint32_t real_voices = 0;       // cached-clip voices being mixed
+    uint32_t virtual_voices = 0;
+    uint32_t stream_voices = 0;
+    uint32_t pcm_voices = 0;        // playPcm() and PCM stream voices
+    size_t   cached_clips = 0;
+    size_t   cached_bytes = 0;
+    uint64_t clip_decodes = 0;      // cache misses
+    uint64_t clip_hits = 0;
+    uint64_t dropped_sounds = 0;    // no free voice slot (play* returned 0)
+};
+
 class AudioEngine {
 public:
     enum class Bus : int { kMusic = 0, kSfx = 1, kVoice = 2 };
     static constexpr int kNumBuses = 3;
 
-    // Idempotent; called automatically by play*().  Returns false when the
-    // backend is unavailable (no miniaudio.h at build time, or no output
-    // device at runtime).
-    static bool init();
+    // Idempotent; called automatically by play*() with the default config.
+    // `config` only takes effect on the call that actually initialises.
+    // Returns false when the backend is unavailable (no miniaudio.h at build
+    // time, or no output device at runtime).
+    static bool init(const AudioEngineConfig& config = {});
     static void shutdown();
     static bool ready();
 
-    // Start a file on a bus.  Returns a handle (0 = failure).  Non-looping
-    // sounds self-release once finished (reaped inside update()).
+    // Start a file on a bus.  Returns a handle, also when the voice starts
+    // virtual (isVirtual()).  0 = failure: the file did not decode, every
+    // voice slot is taken (counted in stats().dropped_sounds), or the
+    // mixer could not start it.  Non-looping sounds self-release once
+    // finished (reaped inside update()).
     static uint64_t playFile(const std::string& path, Bus bus,
                              bool loop = false, float volume = 1.0f);
 
@@ -48,10 +107,26 @@ public:
                             uint32_t sample_rate, Bus bus,
                             float volume = 1.0f);
 
+    // Appendable mono float32 PCM voice, started empty.  `capacity_seconds`
+    // sizes its ring; appendPcm() COPIES in as much as fits and returns
+    // the sample count taken, so a producer running ahead waits for
+    // playback to drain the ring.  The voice plays silence while starved
+    // and ends only once finishPcm() was called and the ring is empty.
+    static uint64_t openPcmStream(uint32_t sample_rate, Bus bus,
+                                  float volume = 1.0f,
+                                  float capacity_seconds = 30.0f);
+    static size_t   appendPcm(uint64_t handle, const float* samples,
+                              size_t sample_count);
+    static void     finishPcm(uint64_t handle);
+    // Samples appended but not yet played (0 for a stale handle).
+    static size_t   pcmQueued(uint64_t handle);
+
     static void stop(uint64_t handle);
     static void stopAll();
     static void stopBus(Bus bus);
+    // True for a virtual voice too — it is still logically playing.
     static bool isPlaying(uint64_t handle);
+    static bool isVirtual(uint64_t handle);
 
     // Live per-sound volume (0..1).  No-op if the handle has finished.
     static void setVolume(uint64_t handle, float volume);
@@ -59,9 +134,14 @@ public:
     static void  setBusVolume(Bus bus, float v);   // 0..1
     static float busVolume(Bus bus);
 
-    // Per-frame housekeeping: releases finished one-shot sounds.  Cheap;
-    // call once per frame from the app loop.
+    // Per-frame housekeeping: releases finished one-shot sounds and
+    // re-ranks voices for virtualisation.  Cheap; call once per frame from
+    // the app loop.
     static void update();
+
+    // Drop every cached clip no voice is playing.
+    static void trimClipCache();
+    static AudioEngineStats stats();
 };
 
 } // namespace audio
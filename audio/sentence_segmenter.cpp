@@ -0,0 +1,169 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// sentence_segmenter.cpp — see sentence_segmenter.h for the rules.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "audio/sentence_segmenter.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace engine {
+namespace audio {
+
+namespace {
+
+// Length of the UTF-8 sequence `lead` starts (1 for a stray continuation
+// byte, so a scan always advances).
+size_t seqLen(unsigned char lead) {
+    if (lead < 0x80)         return 1;
+    if ((lead >> 5) == 0x6)  return 2;
+    if ((lead >> 4) == 0xE)  return 3;
+    if ((lead >> 3) == 0x1E) return 4;
+    return 1;
+}
+
+uint32_t decode(const std::string& s, size_t i, size_t n) {
+    const unsigned char lead = (unsigned char)s[i];
+    if (n == 1) return lead;
+    uint32_t c = lead & (0x7Fu >> n);
+    for (size_t k = 1; k < n; ++k)
+        c = (c << 6) | ((unsigned char)s[i + k] & 0x3Fu);
+    return c;
+}
+
+bool isLatinStop(uint32_t c) { return c == '.' || c == '!' || c == '?'; }
+
+// 。！？；…
+bool isCjkStop(uint32_t c) {
+    return c == 0x3002 || c == 0xFF01 || c == 0xFF1F || c == 0xFF1B ||
+           c == 0x2026;
+}
+
+// Quotes and brackets that close over a sentence end: " ' ) ] ” ’ 」 』 ） 】 》
+bool isCloser(uint32_t c) {
+    return c == '"' || c == '\'' || c == ')' || c == ']' || c == 0x201D ||
+           c == 0x2019 || c == 0x300D || c == 0x300F || c == 0xFF09 ||
+           c == 0x3011 || c == 0x300B;
+}
+
+// Where a run-on is best cut: , : ; ， 、 ：
+bool isSoftBreak(uint32_t c) {
+    return c == ',' || c == ':' || c == ';' || c == 0xFF0C || c == 0x3001 ||
+           c == 0xFF1A;
+}
+
+bool isSpace(uint32_t c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == 0x3000;
+}
+
+// Letters / digits / ideographs — anything a voice would actually say.
+bool isSpoken(uint32_t c) {
+    if (c < 0x80)
+        return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') ||
+               (c >= 'a' && c <= 'z');
+    if (c >= 0xC0 && c < 0x2000) return true;          // Latin-1 .. Greek ext
+    if (c < 0x2E80) return false;                      // punctuation, symbols
+    if (c >= 0x3000 && c <= 0x303F) return false;      // CJK punctuation
+    if (c >= 0xFF00 && c <= 0xFF20) return c >= 0xFF10 && c <= 0xFF19;
+    return true;
+}
+
+} // namespace
+
+void SentenceSegmenter::emit(size_t end, size_t resume,
+                             std::vector<std::string>& out) {
+    size_t b = 0, e = end;
+    bool spoken = false;
+    // Trim whitespace (incl. the ideographic space) and look for a
+    // speakable character in one pass.
+    for (size_t i = 0; i < end;) {
+        const size_t n =
+            std::min(seqLen((unsigned char)pending_[i]), end - i);
+        const uint32_t c = decode(pending_, i, n);
+        if (isSpace(c)) {
+            if (i == b) b = i + n;
+        } else {
+            e = i + n;
+            spoken = spoken || isSpoken(c);
+        }
+        i += n;
+    }
+    if (spoken && e > b) out.push_back(pending_.substr(b, e - b));
+    pending_.erase(0, resume);
+    scan_ = 0;
+}
+
+void SentenceSegmenter::feed(const std::string& text,
+                             std::vector<std::string>& out) {
+    pending_ += text;
+    size_t i = scan_;
+    while (i < pending_.size()) {
+        const size_t n = seqLen((unsigned char)pending_[i]);
+        if (i + n > pending_.size()) break;             // split character
+        const uint32_t c = decode(pending_, i, n);
+        if (c == '\n') {
+            emit(i, i + 1, out);
+            i = 0;
+            continue;
+        }
+        if (!isLatinStop(c) && !isCjkStop(c)) {
+            i += n;
+            continue;
+        }
+        // Swallow further marks and closers, then let the next character
+        // decide.  No next character yet: wait for more text.
+        bool cjk = isCjkStop(c);
+        bool decided = false, boundary = false;
+        size_t j = i + n;
+        while (j < pending_.size()) {
+            const size_t m = seqLen((unsigned char)pending_[j]);
+            if (j + m > pending_.size()) break;
+            const uint32_t d = decode(pending_, j, m);
+            if (isLatinStop(d) || isCjkStop(d)) {
+                cjk = cjk || isCjkStop(d);
+            } else if (!isCloser(d)) {
+                decided = true;
+                boundary = cjk || isSpace(d);
+                break;
+            }
+            j += m;
+        }
+        if (!decided) break;
+        if (boundary) {
+            emit(j, j, out);
+            i = 0;
+        } else {
+            i = j;
+        }
+    }
+    scan_ = i;
+
+    // Run-on: cut after the last soft break inside the first max_bytes_,
+    // else the last space, else the last whole character that fits.
+    while (scan_ > max_bytes_ && max_bytes_ > 0) {
+        size_t soft = 0, space = 0, fit = 0;
+        for (size_t k = 0; k < scan_;) {
+            const size_t m = seqLen((unsigned char)pending_[k]);
+            if (k + m > max_bytes_) break;
+            const uint32_t c = decode(pending_, k, m);
+            if (isSoftBreak(c)) soft = k + m;
+            if (isSpace(c))     space = k + m;
+            k += m;
+            fit = k;
+        }
+        const size_t cut = soft  ? soft
+                         : space ? space
+                         : fit   ? fit
+                                 : max_bytes_;
+        const size_t left = scan_ - cut;
+        emit(cut, cut, out);
+        scan_ = left;
+    }
+}
+
+void SentenceSegmenter::flush(std::vector<std::string>& out) {
+    emit(pending_.size(), pending_.size(), out);
+    reset();
+}
+
+} // namespace audio
+} // namespace engine
@@ -0,0 +1,58 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// sentence_segmenter.h — cuts streamed dialogue text into speakable sentences.
+//
+// A streaming chat reply arrives a few bytes at a time; TTS wants whole
+// sentences (prosody needs the full clause) but should start on the FIRST
+// one instead of waiting for the reply to finish.  feed() takes each new
+// piece and hands back every sentence it completed; flush() ends the
+// stream and returns the tail.
+//
+// Boundaries:
+//   - . ! ? (and runs like "?!" or "...") followed by whitespace — so
+//     "3.14" and "v1.2" stay whole;
+//   - CJK 。！？；and the ellipsis …, which need no following space;
+//   - a newline.
+// Closing quotes / brackets right after the mark stay with the sentence.
+// Since the next piece may still add a closer, a mark at the very end of
+// the buffer is only decided once more text (or flush()) arrives.
+//
+// A run-on longer than max_bytes without a boundary is cut after its last
+// comma / colon (else its last space, else at max_bytes on a UTF-8
+// boundary), so one unpunctuated paragraph cannot hold speech back.
+// Fragments holding no letters or digits ("...", "—") are dropped.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace engine {
+namespace audio {
+
+class SentenceSegmenter {
+public:
+    explicit SentenceSegmenter(size_t max_bytes = 240)
+        : max_bytes_(max_bytes) {}
+
+    // Append the next piece of UTF-8 text — it may end mid-character.
+    // Sentences it completes are appended to `out`, trimmed.
+    void feed(const std::string& text, std::vector<std::string>& out);
+
+    // End of stream: whatever is pending becomes the last sentence.
+    void flush(std::vector<std::string>& out);
+
+    void reset() {
+        pending_.clear();
+        scan_ = 0;
+    }
+
+private:
+    void emit(size_t end, size_t resume, std::vector<std::string>& out);
+
+    std::string pending_;
+    size_t      scan_ = 0;      // bytes of pending_ known to hold no boundary
+    size_t      max_bytes_;
+};
+
+} // namespace audio
+} // namespace engine
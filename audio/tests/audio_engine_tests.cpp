@@ -0,0 +1,342 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// audio_engine_tests.cpp — standalone tests for AudioEngine's clip cache,
+// voice virtualisation and handle pool (audio/audio_engine.*).
+//
+// Runs on miniaudio's null backend, so no output device is needed.  Writes a
+// few tiny 16-bit WAVs to a temp directory and checks: a replay hits the
+// clip cache instead of decoding again, unused clips are evicted to the
+// budget, only the loudest max_real_voices voices are mixed (and the ranking
+// follows volume changes), equally loud newcomers never displace voices
+// already mixed, a full voice pool counts its drops, kMusic streams
+// instead of caching, a stale
+// handle never reaches a recycled slot, and a PCM stream voice plays its
+// appends back to back, idles through a starved ring and ends once
+// finished and drained.
+//
+// Build:
+//   g++ -std=c++20 -I. audio/tests/audio_engine_tests.cpp
+//       audio/audio_engine.cpp -lpthread -ldl -lm -o audio_engine_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "audio/audio_engine.h"
+
+using namespace engine::audio;
+namespace fs = std::filesystem;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+using Bus = AudioEngine::Bus;
+
+static fs::path g_dir;
+
+// Mono 16-bit WAV of `seconds` of a quiet square wave.
+static std::string writeWav(const std::string& name, double seconds) {
+    const uint32_t rate = 48000;
+    const uint32_t frames = (uint32_t)(seconds * rate);
+    std::vector<int16_t> samples(frames);
+    for (uint32_t i = 0; i < frames; ++i)
+        samples[i] = (i / 64) % 2 ? 2000 : -2000;
+
+    const std::string path = (g_dir / name).string();
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    CHECK(f != nullptr);
+    auto u32 = [f](uint32_t v) { std::fwrite(&v, 4, 1, f); };
+    auto u16 = [f](uint16_t v) { std::fwrite(&v, 2, 1, f); };
+    const uint32_t data_bytes = frames * 2;
+    std::fwrite("RIFF", 1, 4, f); u32(36 + data_bytes);
+    std::fwrite("WAVE", 1, 4, f);
+    std::fwrite("fmt ", 1, 4, f); u32(16);
+    u16(1); u16(1); u32(rate); u32(rate * 2); u16(2); u16(16);
+    std::fwrite("data", 1, 4, f); u32(data_bytes);
+    std::fwrite(samples.data(), 2, frames, f);
+    std::fclose(f);
+    return path;
+}
+
+static void testClipCache() {
+    const std::string a = writeWav("a.wav", 0.5);
+    const AudioEngineStats s0 = AudioEngine::stats();
+
+    const uint64_t h1 = AudioEngine::playFile(a, Bus::kSfx);
+    CHECK(h1 != 0);
+    const uint64_t h2 = AudioEngine::playFile(a, Bus::kSfx);
+    CHECK(h2 != 0 && h2 != h1);
+
+    const AudioEngineStats s1 = AudioEngine::stats();
+    CHECK(s1.clip_decodes == s0.clip_decodes + 1);
+    CHECK(s1.clip_hits == s0.clip_hits + 1);
+    CHECK(s1.cached_clips == 1);
+    CHECK(s1.cached_bytes > 0);
+
+    // Clips a voice still plays survive a trim; idle ones do not.
+    AudioEngine::trimClipCache();
+    CHECK(AudioEngine::stats().cached_clips == 1);
+    AudioEngine::stopAll();
+    AudioEngine::trimClipCache();
+    CHECK(AudioEngine::stats().cached_clips == 0);
+    CHECK(AudioEngine::stats().cached_bytes == 0);
+}
+
+static void testCacheBudget() {
+    // The engine was initialised with a 2 MB cache; a 1.2 s clip is
+    // ~450 KB at 48 kHz stereo f32 (under the quarter-cache stream limit),
+    // so ten of them cannot all stay.
+    size_t peak = 0;
+    for (int i = 0; i < 10; ++i) {
+        const std::string p = writeWav("b" + std::to_string(i) + ".wav", 1.2);
+        const uint64_t h = AudioEngine::playFile(p, Bus::kSfx);
+        CHECK(h != 0);
+        AudioEngine::stop(h);
+        peak = std::max(peak, AudioEngine::stats().cached_bytes);
+    }
+    CHECK(peak <= (2u << 20));
+    CHECK(AudioEngine::stats().cached_clips < 10);
+    AudioEngine::trimClipCache();
+}
+
+static void testVirtualisation() {
+    const std::string loop = writeWav("loop.wav", 0.25);
+    std::vector<uint64_t> h;
+    for (int i = 0; i < 5; ++i)
+        h.push_back(AudioEngine::playFile(loop, Bus::kSfx, /*loop=*/true,
+                                          0.1f + 0.1f * (float)i));
+    for (uint64_t v : h) CHECK(v != 0);
+
+    AudioEngineStats s = AudioEngine::stats();
+    CHECK(s.real_voices == 2);
+    CHECK(s.virtual_voices == 3);
+    CHECK(!AudioEngine::isVirtual(h[4]) && !AudioEngine::isVirtual(h[3]));
+    CHECK(AudioEngine::isVirtual(h[0]));
+    for (uint64_t v : h) CHECK(AudioEngine::isPlaying(v));
+
+    // The quietest becomes the loudest: it is resumed, h[3] goes virtual.
+    AudioEngine::setVolume(h[0], 1.0f);
+    AudioEngine::update();
+    CHECK(!AudioEngine::isVirtual(h[0]));
+    CHECK(AudioEngine::isVirtual(h[3]));
+    s = AudioEngine::stats();
+    CHECK(s.real_voices == 2 && s.virtual_voices == 3);
+
+    // Stopping a real voice frees the slot for the next loudest.
+    AudioEngine::stop(h[4]);
+    AudioEngine::update();
+    CHECK(!AudioEngine::isVirtual(h[3]));
+    CHECK(AudioEngine::stats().real_voices == 2);
+    AudioEngine::stopAll();
+    CHECK(AudioEngine::stats().virtual_voices == 0);
+}
+
+static void testEqualLoudnessKeepsRealVoices() {
+    const std::string a = writeWav("equal.wav", 0.5);
+    const uint64_t r0 = AudioEngine::playFile(a, Bus::kSfx, true, 0.5f);
+    const uint64_t r1 = AudioEngine::playFile(a, Bus::kSfx, true, 0.5f);
+    CHECK(r0 && r1);
+    CHECK(!AudioEngine::isVirtual(r0) && !AudioEngine::isVirtual(r1));
+    // Equally loud — and slightly louder, inside the bias — newcomers
+    // stay virtual instead of cutting a playing voice.
+    std::vector<uint64_t> late;
+    for (int i = 0; i < 4; ++i) {
+        late.push_back(AudioEngine::playFile(a, Bus::kSfx, true,
+                                             i < 2 ? 0.5f : 0.52f));
+        CHECK(late.back() != 0);
+        CHECK(AudioEngine::isVirtual(late.back()));
+        CHECK(!AudioEngine::isVirtual(r0) && !AudioEngine::isVirtual(r1));
+    }
+    // Stopping a real voice in the middle of s.active reorders it; the
+    // survivor keeps its place.
+    AudioEngine::stop(r0);
+    AudioEngine::update();
+    CHECK(!AudioEngine::isVirtual(r1));
+    CHECK(AudioEngine::stats().real_voices == 2);
+    // Clearly louder still wins.
+    const uint64_t loud = AudioEngine::playFile(a, Bus::kSfx, true, 1.0f);
+    CHECK(!AudioEngine::isVirtual(loud));
+    AudioEngine::stopAll();
+}
+
+static void testDroppedSounds() {
+    const std::string a = writeWav("drop.wav", 0.5);
+    const uint64_t before = AudioEngine::stats().dropped_sounds;
+    std::vector<uint64_t> h;
+    for (int i = 0; i < 16; ++i) {            // max_voices
+        h.push_back(AudioEngine::playFile(a, Bus::kSfx, true, 0.5f));
+        CHECK(h.back() != 0);
+    }
+    for (int i = 0; i < 3; ++i)
+        CHECK(AudioEngine::playFile(a, Bus::kSfx, true, 0.5f) == 0);
+    CHECK(AudioEngine::stats().dropped_sounds == before + 3);
+    AudioEngine::stop(h[5]);
+    CHECK(AudioEngine::playFile(a, Bus::kSfx, true, 0.5f) != 0);
+    CHECK(AudioEngine::stats().dropped_sounds == before + 3);
+    AudioEngine::stopAll();
+}
+
+static void testOneShotFinishesWhileVirtual() {
+    const std::string blip = writeWav("blip.wav", 0.05);
+    const std::string loud = writeWav("loud.wav", 0.5);
+    const uint64_t l0 = AudioEngine::playFile(loud, Bus::kSfx, true, 1.0f);
+    const uint64_t l1 = AudioEngine::playFile(loud, Bus::kSfx, true, 1.0f);
+    const uint64_t b  = AudioEngine::playFile(blip, Bus::kSfx, false, 0.1f);
+    CHECK(l0 && l1 && b);
+    CHECK(AudioEngine::isVirtual(b));
+    CHECK(AudioEngine::isPlaying(b));
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    CHECK(!AudioEngine::isPlaying(b));
+    AudioEngine::update();
+    CHECK(AudioEngine::stats().virtual_voices == 0);
+    AudioEngine::stopAll();
+}
+
+static void testMusicStreams() {
+    const std::string m = writeWav("music.wav", 1.0);
+    const size_t clips = AudioEngine::stats().cached_clips;
+    const uint64_t h = AudioEngine::playFile(m, Bus::kMusic, true);
+    CHECK(h != 0);
+    const AudioEngineStats s = AudioEngine::stats();
+    CHECK(s.stream_voices == 1);
+    CHECK(s.cached_clips == clips);
+    CHECK(!AudioEngine::isVirtual(h));
+    AudioEngine::stop(h);
+    CHECK(AudioEngine::stats().stream_voices == 0);
+}
+
+static void testStaleHandles() {
+    const std::string a = writeWav("stale.wav", 0.5);
+    const uint64_t h1 = AudioEngine::playFile(a, Bus::kSfx, true);
+    CHECK(h1 != 0);
+    AudioEngine::stop(h1);
+    CHECK(!AudioEngine::isPlaying(h1));
+    // LIFO free list: the next voice reuses the slot with a new generation.
+    const uint64_t h2 = AudioEngine::playFile(a, Bus::kSfx, true);
+    CHECK(h2 != 0);
+    CHECK((h2 & 0xffffffffu) == (h1 & 0xffffffffu));
+    CHECK(h2 != h1);
+    AudioEngine::stop(h1);                 // must not touch h2's voice
+    CHECK(AudioEngine::isPlaying(h2));
+    CHECK(!AudioEngine::isPlaying(0));
+    AudioEngine::stopAll();
+    AudioEngine::trimClipCache();
+}
+
+static void testPcm() {
+    std::vector<float> pcm(2400, 0.0f);
+    const uint64_t h = AudioEngine::playPcm(pcm.data(), pcm.size(), 24000,
+                                            Bus::kVoice);
+    CHECK(h != 0);
+    CHECK(AudioEngine::stats().pcm_voices == 1);
+    CHECK(!AudioEngine::isVirtual(h));
+    AudioEngine::stop(h);
+}
+
+static void testPcmStream() {
+    const uint32_t rate = 24000;
+    const std::vector<float> tenth(rate / 10, 0.0f);
+
+    // Two appends 0.2 s long each, the second landing while the first
+    // still plays: the voice runs them back to back and ends ~0.4 s in.
+    const auto t0 = std::chrono::steady_clock::now();
+    const uint64_t h = AudioEngine::openPcmStream(rate, Bus::kVoice);
+    CHECK(h != 0);
+    CHECK(AudioEngine::stats().pcm_voices == 1);
+    CHECK(AudioEngine::appendPcm(h, tenth.data(), tenth.size()) ==
+          tenth.size());
+    CHECK(AudioEngine::appendPcm(h, tenth.data(), tenth.size()) ==
+          tenth.size());
+    CHECK(AudioEngine::pcmQueued(h) > 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(AudioEngine::isPlaying(h));
+    CHECK(AudioEngine::appendPcm(h, tenth.data(), tenth.size()) ==
+          tenth.size());
+    CHECK(AudioEngine::appendPcm(h, tenth.data(), tenth.size()) ==
+          tenth.size());
+    AudioEngine::finishPcm(h);
+    CHECK(AudioEngine::appendPcm(h, tenth.data(), tenth.size()) == 0);
+    while (AudioEngine::isPlaying(h))
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    const double secs = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+    CHECK(secs > 0.35 && secs < 0.7);
+    AudioEngine::update();
+    CHECK(AudioEngine::stats().pcm_voices == 0);
+    CHECK(AudioEngine::appendPcm(h, tenth.data(), tenth.size()) == 0);
+
+    // Starved but not finished: the voice idles instead of ending.
+    const uint64_t s = AudioEngine::openPcmStream(rate, Bus::kVoice);
+    CHECK(s != 0);
+    CHECK(AudioEngine::appendPcm(s, tenth.data(), tenth.size() / 2) ==
+          tenth.size() / 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    CHECK(AudioEngine::pcmQueued(s) == 0);
+    AudioEngine::update();
+    CHECK(AudioEngine::isPlaying(s));
+    AudioEngine::finishPcm(s);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK(!AudioEngine::isPlaying(s));
+
+    // The ring bounds how far a producer can run ahead.
+    const uint64_t c = AudioEngine::openPcmStream(rate, Bus::kVoice, 1.0f,
+                                                  /*capacity_seconds=*/0.25f);
+    CHECK(c != 0);
+    const std::vector<float> second(rate, 0.0f);
+    const size_t took = AudioEngine::appendPcm(c, second.data(),
+                                               second.size());
+    CHECK(took > 0 && took <= rate / 4);
+    AudioEngine::stop(c);
+    CHECK(AudioEngine::pcmQueued(c) == 0);
+
+    // Only stream voices take appends.
+    const uint64_t p = AudioEngine::playPcm(tenth.data(), tenth.size(), rate,
+                                            Bus::kVoice);
+    CHECK(p != 0);
+    CHECK(AudioEngine::appendPcm(p, tenth.data(), tenth.size()) == 0);
+    AudioEngine::stopAll();
+}
+
+int main() {
+    g_dir = fs::temp_directory_path() / "rw_audio_engine_tests";
+    fs::remove_all(g_dir);
+    fs::create_directories(g_dir);
+
+    AudioEngineConfig cfg;
+    cfg.clip_cache_bytes = 2u << 20;
+    cfg.max_real_voices  = 2;
+    cfg.max_voices       = 16;
+    cfg.null_backend     = true;
+    if (!AudioEngine::init(cfg)) {
+        std::printf("SKIP: audio backend unavailable\n");
+        return 0;
+    }
+
+    testClipCache();
+    testCacheBudget();
+    testVirtualisation();
+    testEqualLoudnessKeepsRealVoices();
+    testDroppedSounds();
+    testOneShotFinishesWhileVirtual();
+    testMusicStreams();
+    testStaleHandles();
+    testPcm();
+    testPcmStream();
+
+    AudioEngine::shutdown();
+    fs::remove_all(g_dir);
+    std::printf("audio_engine_tests: %d checks passed\n", g_checks);
+    return 0;
+}
@@ -0,0 +1,145 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// sentence_segmenter_tests.cpp — standalone tests for the streaming sentence
+// splitter that feeds dialogue replies to TTS (audio/sentence_segmenter.*).
+//
+// Checks Latin and CJK boundaries, closers staying with their sentence,
+// decimals and a mark at the end of a piece waiting for more text, UTF-8
+// characters split across pieces, the run-on cut, dropping punctuation-only
+// fragments — and that feeding a reply byte by byte yields the same
+// sentences as feeding it whole.
+//
+// Build:
+//   g++ -std=c++20 -I. audio/tests/sentence_segmenter_tests.cpp
+//       audio/sentence_segmenter.cpp -o sentence_segmenter_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "audio/sentence_segmenter.h"
+
+using namespace engine::audio;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+using Lines = std::vector<std::string>;
+
+static Lines whole(const std::string& text, size_t max_bytes = 240) {
+    SentenceSegmenter seg(max_bytes);
+    Lines out;
+    seg.feed(text, out);
+    seg.flush(out);
+    return out;
+}
+
+static Lines byteByByte(const std::string& text, size_t max_bytes = 240) {
+    SentenceSegmenter seg(max_bytes);
+    Lines out;
+    for (char c : text) seg.feed(std::string(1, c), out);
+    seg.flush(out);
+    return out;
+}
+
+static void testLatin() {
+    const Lines l = whole("Hello there. How are you?! I'm fine... "
+                          "Pi is 3.14 today.\nNew line");
+    CHECK(l.size() == 5);
+    CHECK(l[0] == "Hello there.");
+    CHECK(l[1] == "How are you?!");
+    CHECK(l[2] == "I'm fine...");
+    CHECK(l[3] == "Pi is 3.14 today.");
+    CHECK(l[4] == "New line");
+
+    // Closers stay with the sentence they close.
+    const Lines q = whole("He said \"Go now.\" Then (quietly) he left.) Ok");
+    CHECK(q.size() == 3);
+    CHECK(q[0] == "He said \"Go now.\"");
+    CHECK(q[1] == "Then (quietly) he left.)");
+    CHECK(q[2] == "Ok");
+}
+
+static void testCjk() {
+    // "你好。今天天气不错！" + 「走吧。」 + "好吗？" (no spaces between)
+    const std::string text =
+        "\xE4\xBD\xA0\xE5\xA5\xBD\xE3\x80\x82"
+        "\xE4\xBB\x8A\xE5\xA4\xA9\xE5\xA4\xA9\xE6\xB0\x94"
+        "\xE4\xB8\x8D\xE9\x94\x99\xEF\xBC\x81"
+        "\xE3\x80\x8C\xE8\xB5\xB0\xE5\x90\xA7\xE3\x80\x82\xE3\x80\x8D"
+        "\xE5\xA5\xBD\xE5\x90\x97\xEF\xBC\x9F";
+    const Lines l = whole(text);
+    CHECK(l.size() == 4);
+    CHECK(l[0] == "\xE4\xBD\xA0\xE5\xA5\xBD\xE3\x80\x82");
+    CHECK(l[2] == "\xE3\x80\x8C\xE8\xB5\xB0\xE5\x90\xA7\xE3\x80\x82"
+                  "\xE3\x80\x8D");
+    CHECK(l[3] == "\xE5\xA5\xBD\xE5\x90\x97\xEF\xBC\x9F");
+    CHECK(byteByByte(text) == l);
+}
+
+static void testStreaming() {
+    SentenceSegmenter seg;
+    Lines out;
+    seg.feed("First one", out);
+    CHECK(out.empty());
+    // A mark at the end of a piece is undecided: "." could be "3.14".
+    seg.feed(" ends.", out);
+    CHECK(out.empty());
+    seg.feed(" Second", out);
+    CHECK(out.size() == 1 && out[0] == "First one ends.");
+    seg.feed(" 2.5 km away", out);
+    CHECK(out.size() == 1);
+    seg.flush(out);
+    CHECK(out.size() == 2 && out[1] == "Second 2.5 km away");
+
+    // The segmenter is reusable after flush(); reset() drops the pending text.
+    seg.feed("Dropped text", out);
+    seg.reset();
+    seg.feed("Kept. ", out);
+    CHECK(out.size() == 3 && out[2] == "Kept.");
+
+    const std::string reply =
+        "Greetings, traveller. The road north is closed! Take the river "
+        "path (it is 2.5 li shorter). \xE4\xBD\xA0\xE5\xA5\xBD\xE3\x80\x82"
+        "Farewell.";
+    CHECK(byteByByte(reply) == whole(reply));
+    CHECK(whole(reply).size() == 5);
+}
+
+static void testRunOnAndNoise() {
+    std::string run;
+    for (int i = 0; i < 30; ++i) run += "and then, ";
+    const Lines l = whole(run, 64);
+    CHECK(l.size() > 3);
+    for (const auto& s : l) CHECK(s.size() <= 64);
+    CHECK(l.front().back() == ',');     // cut after a soft break
+    CHECK(byteByByte(run, 64) == l);
+
+    // No soft break at all: cut on a character boundary (3-byte CJK).
+    std::string cjk;
+    for (int i = 0; i < 40; ++i) cjk += "\xE5\xA5\xBD";
+    const Lines c = whole(cjk, 50);
+    CHECK(c.size() == 3);
+    CHECK(c[0].size() == 48 && c[1].size() == 48 && c[2].size() == 24);
+
+    // Punctuation-only fragments are not sent to the voice.
+    const Lines n = whole("... \xE2\x80\xA6 !\n\nReal words.\n  ");
+    CHECK(n.size() == 1 && n[0] == "Real words.");
+    CHECK(whole("").empty());
+}
+
+int main() {
+    testLatin();
+    testCjk();
+    testStreaming();
+    testRunOnAndNoise();
+    std::printf("sentence_segmenter_tests: %d checks passed\n", g_checks);
+    return 0;
+}
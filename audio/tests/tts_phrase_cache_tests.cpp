@@ -0,0 +1,184 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// tts_phrase_cache_tests.cpp — standalone tests for TtsEngine's synthesized-
+// line cache (audio/tts_phrase_cache.*).
+//
+// Checks that the key separates voice / speaker / speed / text (and rounds
+// speed jitter away), least-recently-used eviction under the byte budget,
+// that an oversized line is not kept, that the disk tier persists marked
+// lines across cache instances and is promoted into memory on a hit, that a
+// truncated or foreign disk file reads as a miss, and concurrent use from
+// several worker threads.
+//
+// Build:
+//   g++ -std=c++20 -I. audio/tests/tts_phrase_cache_tests.cpp
+//       audio/tts_phrase_cache.cpp -lpthread -o tts_phrase_cache_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "audio/tts_phrase_cache.h"
+
+using namespace engine::audio;
+namespace fs = std::filesystem;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static std::shared_ptr<const TtsPcm> makePcm(size_t samples, float value) {
+    auto p = std::make_shared<TtsPcm>();
+    p->samples.assign(samples, value);
+    p->sample_rate = 22050;
+    return p;
+}
+
+static TtsPhraseKey key(const std::string& text, int speaker = 0,
+                        float speed = 1.0f, const std::string& voice = "amy") {
+    return TtsPhraseKey{voice, speaker, speed, text};
+}
+
+static void testKeys() {
+    const std::string a = TtsPhraseCache::keyString(key("Halt!"));
+    CHECK(a == TtsPhraseCache::keyString(key("Halt!", 0, 1.0004f)));
+    CHECK(a != TtsPhraseCache::keyString(key("Halt!", 0, 1.1f)));
+    CHECK(a != TtsPhraseCache::keyString(key("Halt!", 1)));
+    CHECK(a != TtsPhraseCache::keyString(key("Halt!", 0, 1.0f, "ryan")));
+    CHECK(a != TtsPhraseCache::keyString(key("Halt")));
+    CHECK(TtsPhraseCache::hashKey(a) ==
+          TtsPhraseCache::hashKey(TtsPhraseCache::keyString(key("Halt!"))));
+    CHECK(TtsPhraseCache::hashKey(a) !=
+          TtsPhraseCache::hashKey(TtsPhraseCache::keyString(key("Halt?"))));
+}
+
+static void testMemoryLru() {
+    // 1000 samples = 4000 bytes a line; room for four.
+    TtsPhraseCache cache(16000);
+    CHECK(cache.find(key("a")) == nullptr);
+    for (const char* t : {"a", "b", "c", "d"})
+        cache.insert(key(t), makePcm(1000, 0.5f));
+    TtsPhraseCacheStats st = cache.stats();
+    CHECK(st.lines == 4 && st.bytes == 16000);
+    CHECK(st.misses == 1);
+
+    const auto hit = cache.find(key("a"));          // a is now the newest
+    CHECK(hit && hit->samples.size() == 1000 && hit->sample_rate == 22050);
+    cache.insert(key("e"), makePcm(1000, 0.5f));    // evicts b
+    CHECK(cache.contains(key("a")));
+    CHECK(!cache.contains(key("b")));
+    CHECK(cache.contains(key("e")));
+    st = cache.stats();
+    CHECK(st.lines == 4 && st.bytes == 16000 && st.hits == 1);
+
+    // A hit on a line keeps it alive for its holder even once evicted.
+    for (const char* t : {"f", "g", "h", "i"})
+        cache.insert(key(t), makePcm(1000, 0.5f));
+    CHECK(!cache.contains(key("a")));
+    CHECK(hit->samples.size() == 1000);
+
+    // Over a quarter of the budget: not kept.
+    cache.insert(key("long"), makePcm(1001, 0.5f));
+    CHECK(!cache.contains(key("long")));
+    CHECK(cache.stats().bytes == 16000);
+
+    // Re-inserting replaces in place.
+    cache.insert(key("f"), makePcm(500, 0.25f));
+    CHECK(cache.stats().bytes == 16000 - 2000);
+    CHECK(cache.find(key("f"))->samples[0] == 0.25f);
+
+    cache.clear();
+    CHECK(cache.stats().lines == 0 && cache.stats().bytes == 0);
+}
+
+static void testDiskTier(const fs::path& dir) {
+    {
+        TtsPhraseCache cache(1 << 20, dir.string());
+        cache.insert(key("Welcome, stranger."), makePcm(3000, 0.125f),
+                     /*persist=*/true);
+        cache.insert(key("Transient line."), makePcm(3000, 0.125f));
+        CHECK(cache.contains(key("Welcome, stranger."), /*on_disk=*/true));
+        CHECK(!cache.contains(key("Transient line."), true));
+    }
+    size_t files = 0;
+    for (const auto& e : fs::directory_iterator(dir)) {
+        CHECK(e.path().extension() == ".rwtts");
+        ++files;
+    }
+    CHECK(files == 1);
+
+    // A fresh cache (a new session) reads the stock line back from disk
+    // once, then serves it from memory.
+    TtsPhraseCache cache(1 << 20, dir.string());
+    const auto p = cache.find(key("Welcome, stranger."));
+    CHECK(p && p->samples.size() == 3000 && p->samples[2999] == 0.125f);
+    CHECK(p->sample_rate == 22050);
+    CHECK(cache.find(key("Welcome, stranger.")) == p);
+    CHECK(cache.find(key("Transient line.")) == nullptr);
+    TtsPhraseCacheStats st = cache.stats();
+    CHECK(st.disk_hits == 1 && st.hits == 1 && st.misses == 1);
+
+    // A file stored under another line's name is not that line.
+    const std::string stock = (dir / fs::directory_iterator(dir)->path()
+                                         .filename()).string();
+    const uint64_t other = TtsPhraseCache::hashKey(
+        TtsPhraseCache::keyString(key("Other line.")));
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.rwtts",
+                  (unsigned long long)other);
+    fs::copy_file(stock, dir / name);
+    CHECK(TtsPhraseCache(1 << 20, dir.string()).find(key("Other line.")) ==
+          nullptr);
+
+    // Truncated: a miss, not a short line.
+    fs::resize_file(stock, fs::file_size(stock) - 8);
+    CHECK(TtsPhraseCache(1 << 20, dir.string())
+              .find(key("Welcome, stranger.")) == nullptr);
+}
+
+static void testThreads() {
+    TtsPhraseCache cache(64 * 4000);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w) {
+        workers.emplace_back([&cache, w] {
+            for (int i = 0; i < 2000; ++i) {
+                const TtsPhraseKey k = key("line " + std::to_string(i % 100));
+                if (auto p = cache.find(k)) {
+                    if (p->samples.size() != 1000) std::abort();
+                } else {
+                    cache.insert(k, makePcm(1000, (float)w));
+                }
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+    const TtsPhraseCacheStats st = cache.stats();
+    CHECK(st.lines <= 64);
+    CHECK(st.bytes <= 64 * 4000);
+    CHECK(st.hits + st.misses == 8000);
+    CHECK(st.hits > 0);
+}
+
+int main() {
+    const fs::path dir = fs::temp_directory_path() / "rw_tts_phrase_cache_tests";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    testKeys();
+    testMemoryLru();
+    testDiskTier(dir);
+    testThreads();
+
+    fs::remove_all(dir);
+    std::printf("tts_phrase_cache_tests: %d checks passed\n", g_checks);
+    return 0;
+}
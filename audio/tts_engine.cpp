@@ -1,5 +1,5 @@
 // ─────────────────────────────────────────────────────────────────────────────
-// tts_engine.cpp — sherpa-onnx offline TTS behind a worker thread.
+// tts_engine.cpp — sherpa-onnx offline TTS behind a pool of worker threads.
 //
 // The sherpa-onnx SDK (DLL + import lib + C API header) is auto-downloaded
 // by CMake into third_parties/sherpa-onnx/; HAS_SHERPA_ONNX is defined only
@@ -8,6 +8,7 @@
 // ─────────────────────────────────────────────────────────────────────────────
 #include "audio/tts_engine.h"
 #include "audio/audio_engine.h"
+#include "audio/tts_phrase_cache.h"
 
 #include <algorithm>
 #include <atomic>
@@ -18,10 +19,12 @@
 #include <cstring>
 #include <deque>
 #include <filesystem>
+#include <memory>
 #include <mutex>
 #include <random>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #if defined(HAS_SHERPA_ONNX)
@@ -38,10 +41,15 @@ namespace {
 namespace fs = std::filesystem;
 
 struct Request {
+    enum Kind { kSpeak, kAppend, kPrefetch };
     uint64_t    id;
+    Kind        kind;       // kAppend: enqueue(), continue the open utterance
     std::string text;
     int         speaker_id;
     float       speed;
+    int         channel;    // -1 for prefetches
+    uint64_t    epoch;      // the channel's Channel::epoch when queued
+    bool        stock;      // also keep it in the disk tier
 };
 
 // sherpa-onnx ships several offline-TTS model FAMILIES, each needing a
@@ -168,31 +176,53 @@ bool analyzeVoiceDir(const fs::path& d, VoiceInfo& out) {
     return true;
 }
 
+// One speaker slot.  Guarded by TtsState::mtx.
+struct Channel {
+    // Bumped whenever the channel's queued speech is cancelled — speak(),
+    // stop(), a voice switch — so a line already being synthesized knows
+    // it was superseded.
+    uint64_t epoch = 0;
+    uint64_t playing = 0;           // AudioEngine handle of its open stream
+    int      synthesizing = 0;      // its lines a worker has taken
+};
+
+struct Worker {
+    std::thread         thread;
+    std::deque<Request> queue;      // speech for the channels it serves
+};
+
 struct TtsState {
     std::string             voices_root;     // assets/ml_models/tts (for listing)
     std::string             model_dir;       // resolved voice directory
     VoiceInfo               voice;           // resolved family + file paths
     bool                    model_found = false;
 
-    std::thread             worker;
+    // Fixed once started: channel c is served by workers[c % size].
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::deque<Request>     prefetch;        // taken by idle workers
+    std::vector<std::string> prefetching;    // keyString()s being synthesized
+    std::unordered_map<int, Channel> channels;
     std::mutex              mtx;
     std::condition_variable cv;
-    std::deque<Request>     queue;
     bool                    quit = false;
     bool                    worker_started = false;
-    bool                    reload_voice = false;  // worker rebuilds tts
+    uint64_t                voice_gen = 0;   // setVoice(): workers rebuild tts
+    int                     threads_per_worker = 2;
+
+    // Created before the workers start and never replaced; thread-safe.
+    std::unique_ptr<TtsPhraseCache> cache;
 
     // Last spoken line, kept so the editor voice picker can re-audition.
     std::string             last_text;
     int                     last_speaker = 0;
     float                   last_speed   = 1.0f;
 
-    std::atomic<uint64_t>   playing_handle{0};
-    std::atomic<bool>       synthesizing{false};
+    std::atomic<uint64_t>   synthesized{0};
+    std::atomic<uint64_t>   prefetched{0};
     uint64_t                next_id = 1;
 
-    // Join the worker on static teardown so the std::thread destructor never
-    // runs while the thread is still joinable (which would call std::terminate
+    // Join the workers on static teardown so no std::thread destructor runs
+    // while the thread is still joinable (which would call std::terminate
     // during program exit / atexit).  Safety net independent of whether
     // TtsEngine::shutdown() was called.
     ~TtsState() {
@@ -201,7 +231,8 @@ struct TtsState {
             quit = true;
         }
         cv.notify_all();
-        if (worker.joinable()) worker.join();
+        for (auto& w : workers)
+            if (w->thread.joinable()) w->thread.join();
     }
 };
 
@@ -293,7 +324,8 @@ bool resolveModelDir(const std::string& dir) {
 // (Re)build a sherpa-onnx TTS instance from S()'s current model paths.
 // Caller passes a snapshot of the paths (taken under lock) so the heavy
 // SherpaOnnxCreateOfflineTts call runs without holding the mutex.
-const SherpaOnnxOfflineTts* buildTts(const VoiceInfo& v) {
+// num_threads is this instance's share of the synthesis CPU budget.
+const SherpaOnnxOfflineTts* buildTts(const VoiceInfo& v, int num_threads) {
     if (v.type == VoiceType::kUnsupported) return nullptr;
 
     SherpaOnnxOfflineTtsConfig config;
@@ -340,28 +372,59 @@ const SherpaOnnxOfflineTts* buildTts(const VoiceInfo& v) {
     default:
         return nullptr;
     }
-    config.model.num_threads = 2;       // CPU synth; keep the cores
-    config.model.provider    = "cpu";   // for the engine
+    config.model.num_threads = num_threads; // CPU synth; keep the cores
+    config.model.provider    = "cpu";       // for the engine
     config.max_num_sentences = 2;       // chunked synthesis
     return SherpaOnnxCreateOfflineTts(&config);
 }
 
-// Worker thread: owns the sherpa-onnx instance.  Rebuilds it on demand when
-// the editor switches voices (reload_voice), so the (heavy, ~1s) model load
-// never touches the render thread.
-void workerMain() {
+// Caller must hold S().mtx; the pool must be running.
+Worker& workerForLocked(int channel) {
+    TtsState& s = S();
+    return *s.workers[(size_t)channel % s.workers.size()];
+}
+
+// Drop the channel's queued speech and invalidate the line a worker may be
+// synthesizing for it.  Returns the handle still playing, which the caller
+// stops (outside the lock) if it should go silent now.
+// Caller must hold S().mtx.
+uint64_t cancelLocked(int channel) {
+    Channel& c = S().channels[channel];
+    ++c.epoch;
+    auto& q = workerForLocked(channel).queue;
+    q.erase(std::remove_if(q.begin(), q.end(),
+                           [&](const Request& r) {
+                               return r.channel == channel;
+                           }),
+            q.end());
+    const uint64_t h = c.playing;
+    c.playing = 0;
+    return h;
+}
+
+// Worker thread: owns one sherpa-onnx instance and the PCM streams of the
+// channels it serves.  Rebuilds the instance when the editor switches
+// voices (voice_gen), so the (heavy, ~1s) model load never touches the
+// render thread.  With no speech of its own queued it takes prefetches.
+void workerMain(size_t index) {
     TtsState& s = S();
+    Worker& self = *s.workers[index];     // the vector is fixed by now
 
+    std::string voice_name;               // phrase cache key
+    uint64_t gen = 0;
     auto load = [&]() -> const SherpaOnnxOfflineTts* {
         VoiceInfo vi;
         std::string dir;
+        int threads = 1;
         {
             std::lock_guard<std::mutex> lk(s.mtx);
             vi = s.voice; dir = s.model_dir;
+            gen = s.voice_gen; threads = s.threads_per_worker;
         }
-        const SherpaOnnxOfflineTts* t = buildTts(vi);
-        if (t) std::printf("[tts] voice ready: %s\n",
-                           fs::path(dir).filename().string().c_str());
+        voice_name = fs::path(dir).filename().string();
+        const SherpaOnnxOfflineTts* t = buildTts(vi, threads);
+        if (t) std::printf("[tts] voice ready: %s (worker %zu)\n",
+                           voice_name.c_str(), index);
         else   std::printf("[tts] failed to create TTS from '%s'\n",
                            dir.c_str());
         return t;
@@ -370,61 +433,184 @@ void workerMain() {
     const SherpaOnnxOfflineTts* tts = load();
     if (!tts) return;
 
+    // The PCM stream each channel's current utterance plays on.  It stays
+    // open while lines keep coming; once nothing is queued and the stream
+    // has played out, it is finished so the voice can end.
+    struct Stream {
+        uint64_t handle = 0;
+        uint32_t rate = 0;
+    };
+    std::unordered_map<int, Stream> streams;
+    auto closeDrained = [&] {
+        for (auto it = streams.begin(); it != streams.end();) {
+            if (AudioEngine::pcmQueued(it->second.handle) == 0) {
+                AudioEngine::finishPcm(it->second.handle);
+                it = streams.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    };
+    // Still the channel's newest speech (no speak() / stop() since)?
+    auto live = [&](const Request& r) {
+        std::lock_guard<std::mutex> lk(s.mtx);
+        return s.channels[r.channel].epoch == r.epoch;
+    };
+
     for (;;) {
         Request req;
         {
             std::unique_lock<std::mutex> lk(s.mtx);
-            s.cv.wait(lk, [&] {
-                return s.quit || s.reload_voice || !s.queue.empty();
-            });
+            auto ready = [&] {
+                return s.quit || s.voice_gen != gen || !self.queue.empty() ||
+                       !s.prefetch.empty();
+            };
+            // With a stream open, wake now and then to close it once it
+            // has drained.
+            while (!ready()) {
+                if (streams.empty()) {
+                    s.cv.wait(lk, ready);
+                    break;
+                }
+                if (s.cv.wait_for(lk, std::chrono::milliseconds(20), ready))
+                    break;
+                lk.unlock();
+                closeDrained();
+                lk.lock();
+            }
             if (s.quit) break;
-            if (s.reload_voice) {
-                s.reload_voice = false;
+            if (s.voice_gen != gen) {
                 lk.unlock();
-                // Stop the current line, swap the model, then fall through
-                // to drain any queued (re-audition) request with the new
-                // voice.
-                const uint64_t prev = s.playing_handle.exchange(0);
-                if (prev) AudioEngine::stop(prev);
+                // Silence this worker's channels and swap the model; queued
+                // (re-audition) lines then play with the new voice.
+                for (const auto& st : streams)
+                    AudioEngine::stop(st.second.handle);
+                streams.clear();
                 SherpaOnnxDestroyOfflineTts(tts);
                 tts = load();
                 if (!tts) return;
-                lk.lock();
+                continue;
+            }
+            if (!self.queue.empty()) {
+                req = std::move(self.queue.front());
+                self.queue.pop_front();
+                ++s.channels[req.channel].synthesizing;
+            } else {
+                req = std::move(s.prefetch.front());
+                s.prefetch.pop_front();
+                s.prefetching.push_back(TtsPhraseCache::keyString(
+                    {voice_name, req.speaker_id, req.speed, req.text}));
+            }
+        }
+        const bool speech = req.kind != Request::kPrefetch;
+        // Done with the request short of playing it.
+        auto settle = [&] {
+            std::lock_guard<std::mutex> lk(s.mtx);
+            if (speech) {
+                --s.channels[req.channel].synthesizing;
+                return;
             }
-            if (s.queue.empty()) continue;
-            req = std::move(s.queue.front());
-            s.queue.pop_front();
+            const std::string ks = TtsPhraseCache::keyString(
+                {voice_name, req.speaker_id, req.speed, req.text});
+            auto it = std::find(s.prefetching.begin(), s.prefetching.end(), ks);
+            if (it != s.prefetching.end()) s.prefetching.erase(it);
+        };
+
+        // Phrase cache first (memory, then the disk tier).
+        const TtsPhraseKey key{voice_name, req.speaker_id, req.speed, req.text};
+        if (!speech && s.cache->contains(key, req.stock)) {
+            settle();
+            continue;
+        }
+        std::shared_ptr<const TtsPcm> pcm = s.cache->find(key);
+        if (pcm && req.stock) s.cache->insert(key, pcm, /*persist=*/true);
+
+        if (!pcm) {
+            SherpaOnnxGenerationConfig gen_cfg;
+            std::memset(&gen_cfg, 0, sizeof(gen_cfg));
+            gen_cfg.sid   = req.speaker_id;
+            gen_cfg.speed = req.speed;
+            const SherpaOnnxGeneratedAudio* audio =
+                SherpaOnnxOfflineTtsGenerateWithConfig(
+                    tts, req.text.c_str(), &gen_cfg, nullptr, nullptr);
+            if (!audio || audio->n <= 0) {
+                if (audio) SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+                std::printf("[tts] synthesis produced no audio\n");
+                settle();
+                continue;
+            }
+            auto fresh = std::make_shared<TtsPcm>();
+            fresh->samples.assign(audio->samples, audio->samples + audio->n);
+            fresh->sample_rate = (uint32_t)audio->sample_rate;
+            SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+            s.synthesized.fetch_add(1);
+            if (!speech) s.prefetched.fetch_add(1);
+            s.cache->insert(key, fresh, req.stock);
+            pcm = std::move(fresh);
+        }
+        if (!speech) {
+            settle();
+            continue;
         }
 
-        s.synthesizing.store(true);
-        SherpaOnnxGenerationConfig gen_cfg;
-        std::memset(&gen_cfg, 0, sizeof(gen_cfg));
-        gen_cfg.sid   = req.speaker_id;
-        gen_cfg.speed = req.speed;
-        const SherpaOnnxGeneratedAudio* audio =
-            SherpaOnnxOfflineTtsGenerateWithConfig(
-                tts, req.text.c_str(), &gen_cfg, nullptr, nullptr);
-        s.synthesizing.store(false);
-        if (!audio || audio->n <= 0) {
-            if (audio) SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
-            std::printf("[tts] synthesis produced no audio\n");
+        // speak() / stop() while this line was synthesizing dropped it.
+        if (!live(req)) {
+            settle();
             continue;
         }
 
-        // Dialog semantics: a new line replaces whatever is still playing.
-        const uint64_t prev = s.playing_handle.exchange(0);
-        if (prev) AudioEngine::stop(prev);
+        // Dialog semantics: a new line replaces whatever the channel is
+        // still playing.  An appended line rides the open stream when it is
+        // still sounding, so it starts exactly where the previous one ends.
+        Stream& st = streams[req.channel];
+        if (req.kind == Request::kSpeak ||
+            !AudioEngine::isPlaying(st.handle) || pcm->sample_rate != st.rate) {
+            if (req.kind == Request::kSpeak) {
+                if (st.handle) AudioEngine::stop(st.handle);
+            } else if (st.handle) {
+                AudioEngine::finishPcm(st.handle);
+            }
+            st.handle = AudioEngine::openPcmStream(pcm->sample_rate,
+                                                   AudioEngine::Bus::kVoice);
+            st.rate = pcm->sample_rate;
+        }
+        const uint64_t stream = st.handle;
+        bool current;
+        {
+            std::lock_guard<std::mutex> lk(s.mtx);
+            Channel& c = s.channels[req.channel];
+            current = c.epoch == req.epoch;
+            if (current) c.playing = stream;
+            --c.synthesizing;
+        }
+        if (!current) {                     // cancelled while opening
+            AudioEngine::stop(stream);
+            streams.erase(req.channel);
+            continue;
+        }
 
-        const uint64_t h = AudioEngine::playPcm(
-            audio->samples, (size_t)audio->n, (uint32_t)audio->sample_rate,
-            AudioEngine::Bus::kVoice);
-        s.playing_handle.store(h);
-        SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+        // The ring holds 30 s; a longer line waits for playback to make
+        // room, and gives up if the voice is stopped or superseded.
+        const size_t n = pcm->samples.size();
+        size_t fed = 0;
+        while (stream && fed < n) {
+            fed += AudioEngine::appendPcm(stream, pcm->samples.data() + fed,
+                                          n - fed);
+            if (fed == n || !live(req) || !AudioEngine::isPlaying(stream))
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
     }
 
+    for (const auto& st : streams) AudioEngine::finishPcm(st.second.handle);
     SherpaOnnxDestroyOfflineTts(tts);
 }
 
+int envInt(const char* name, int fallback) {
+    const char* v = std::getenv(name);
+    return v && v[0] ? std::atoi(v) : fallback;
+}
+
 // Caller must hold S().mtx.
 bool ensureWorkerLocked(const std::string& model_dir_hint) {
     TtsState& s = S();
@@ -441,7 +627,26 @@ bool ensureWorkerLocked(const std::string& model_dir_hint) {
                                            : model_dir_hint.c_str());
         return false;
     }
-    s.worker = std::thread(workerMain);
+
+    // CPU budget: RW_TTS_THREADS across the whole pool, so more workers
+    // means more concurrent speakers, not more cores.
+    const int workers = std::clamp(envInt("RW_TTS_WORKERS", 1), 1, 8);
+    const int threads = std::max(envInt("RW_TTS_THREADS", 2), 1);
+    s.threads_per_worker = std::max(threads / workers, 1);
+    const size_t cache_mb = (size_t)std::max(envInt("RW_TTS_CACHE_MB", 32), 0);
+    const char* disk = std::getenv("RW_TTS_DISK_CACHE");
+    std::string disk_dir = disk && disk[0] ? disk : "tts_cache";
+    if (disk_dir == "off") disk_dir.clear();
+    s.cache = std::make_unique<TtsPhraseCache>(cache_mb << 20, disk_dir);
+    std::printf("[tts] %d synthesis worker(s) x %d thread(s), phrase cache "
+                "%zu MB%s%s\n", workers, s.threads_per_worker, cache_mb,
+                disk_dir.empty() ? "" : ", stock lines in ",
+                disk_dir.c_str());
+
+    for (int i = 0; i < workers; ++i)
+        s.workers.push_back(std::make_unique<Worker>());
+    for (int i = 0; i < workers; ++i)
+        s.workers[i]->thread = std::thread(workerMain, (size_t)i);
     return true;
 }
 
@@ -461,7 +666,8 @@ void TtsEngine::shutdown() {
         s.quit = true;
     }
     s.cv.notify_all();
-    if (s.worker.joinable()) s.worker.join();
+    for (auto& w : s.workers)
+        if (w->thread.joinable()) w->thread.join();
 }
 
 bool TtsEngine::available() {
@@ -472,8 +678,9 @@ bool TtsEngine::available() {
 }
 
 uint64_t TtsEngine::speak(const std::string& text, int speaker_id,
-                          float speed) {
+                          float speed, int channel) {
     if (text.empty()) return 0;
+    channel = std::max(channel, 0);
     TtsState& s = S();
     uint64_t id = 0;
     {
@@ -482,15 +689,80 @@ uint64_t TtsEngine::speak(const std::string& text, int speaker_id,
         id = s.next_id++;
         // Remember the line so the editor voice picker can re-audition it.
         s.last_text = text; s.last_speaker = speaker_id; s.last_speed = speed;
-        // Dialog semantics: drop anything still waiting — only the newest
-        // line matters.
-        s.queue.clear();
-        s.queue.push_back(Request{id, text, speaker_id, speed});
+        // Dialog semantics: drop anything still waiting on this channel —
+        // only the newest line matters.  The line playing keeps going until
+        // this one is ready to replace it.
+        cancelLocked(channel);
+        // Take over a prefetch of the same line that has not started yet.
+        bool stock = false;
+        auto& pf = s.prefetch;
+        pf.erase(std::remove_if(pf.begin(), pf.end(),
+                                [&](const Request& r) {
+                                    const bool same =
+                                        r.text == text &&
+                                        r.speaker_id == speaker_id &&
+                                        r.speed == speed;
+                                    stock = stock || (same && r.stock);
+                                    return same;
+                                }),
+                 pf.end());
+        workerForLocked(channel).queue.push_back(
+            Request{id, Request::kSpeak, text, speaker_id, speed, channel,
+                    s.channels[channel].epoch, stock});
+    }
+    s.cv.notify_all();
+    return id;
+}
+
+uint64_t TtsEngine::enqueue(const std::string& text, int speaker_id,
+                            float speed, int channel) {
+    if (text.empty()) return 0;
+    channel = std::max(channel, 0);
+    TtsState& s = S();
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lk(s.mtx);
+        if (!ensureWorkerLocked("")) return 0;
+        id = s.next_id++;
+        // The picker re-auditions the whole utterance, not its last piece.
+        if (!s.last_text.empty()) s.last_text += ' ';
+        s.last_text += text;
+        s.last_speaker = speaker_id; s.last_speed = speed;
+        workerForLocked(channel).queue.push_back(
+            Request{id, Request::kAppend, text, speaker_id, speed, channel,
+                    s.channels[channel].epoch, false});
     }
-    s.cv.notify_one();
+    s.cv.notify_all();
     return id;
 }
 
+void TtsEngine::prefetch(const std::string& text, int speaker_id,
+                         float speed, bool stock) {
+    if (text.empty()) return;
+    // Predictions go stale: past this many waiting, the oldest is dropped.
+    constexpr size_t kMaxPrefetch = 64;
+    TtsState& s = S();
+    {
+        std::lock_guard<std::mutex> lk(s.mtx);
+        if (!ensureWorkerLocked("")) return;
+        const TtsPhraseKey key{fs::path(s.model_dir).filename().string(),
+                               speaker_id, speed, text};
+        if (s.cache->contains(key, stock)) return;
+        if (std::find(s.prefetching.begin(), s.prefetching.end(),
+                      TtsPhraseCache::keyString(key)) != s.prefetching.end())
+            return;
+        for (const Request& r : s.prefetch) {
+            if (r.text == text && r.speaker_id == speaker_id &&
+                r.speed == speed && (r.stock || !stock))
+                return;
+        }
+        if (s.prefetch.size() >= kMaxPrefetch) s.prefetch.pop_front();
+        s.prefetch.push_back(Request{s.next_id++, Request::kPrefetch, text,
+                                     speaker_id, speed, -1, 0, stock});
+    }
+    s.cv.notify_all();
+}
+
 std::vector<std::string> TtsEngine::listVoices() {
     namespace fs = std::filesystem;
     TtsState& s = S();
@@ -526,10 +798,10 @@ std::string TtsEngine::currentVoice() {
 bool TtsEngine::setVoice(const std::string& voice_name) {
     namespace fs = std::filesystem;
     TtsState& s = S();
-    bool ok = false;
+    std::vector<uint64_t> silenced;
     {
         std::lock_guard<std::mutex> lk(s.mtx);
-        // Make sure the worker exists (and voices_root is known).
+        // Make sure the workers exist (and voices_root is known).
         if (!ensureWorkerLocked("")) return false;
         const std::string root =
             s.voices_root.empty() ? "assets/ml_models/tts" : s.voices_root;
@@ -545,7 +817,7 @@ bool TtsEngine::setVoice(const std::string& voice_name) {
 
         s.model_dir  = vd.string();
         s.voice      = vi;
-        s.reload_voice = true;
+        ++s.voice_gen;
 
         // Re-audition with the new voice: the last dialog line if one has
         // played, otherwise a default sample so the picker always speaks.
@@ -554,13 +826,15 @@ bool TtsEngine::setVoice(const std::string& voice_name) {
             s.last_speaker = 0;
             s.last_speed = 1.0f;
         }
-        s.queue.clear();
-        s.queue.push_back(Request{s.next_id++, s.last_text,
-                                  s.last_speaker, s.last_speed});
-        ok = true;
+        for (auto& c : s.channels) silenced.push_back(cancelLocked(c.first));
+        workerForLocked(0).queue.push_back(
+            Request{s.next_id++, Request::kSpeak, s.last_text, s.last_speaker,
+                    s.last_speed, 0, s.channels[0].epoch, false});
     }
-    s.cv.notify_one();
-    return ok;
+    for (uint64_t h : silenced)
+        if (h) AudioEngine::stop(h);
+    s.cv.notify_all();
+    return true;
 }
 
 uint64_t TtsEngine::repeatLast() {
@@ -574,21 +848,57 @@ uint64_t TtsEngine::repeatLast() {
     return speak(t, spk, spd);
 }
 
-void TtsEngine::stop() {
+void TtsEngine::stop(int channel) {
     TtsState& s = S();
+    std::vector<uint64_t> silenced;
     {
         std::lock_guard<std::mutex> lk(s.mtx);
-        s.queue.clear();
+        if (s.workers.empty()) return;
+        if (channel >= 0) {
+            silenced.push_back(cancelLocked(channel));
+        } else {
+            for (auto& c : s.channels)
+                silenced.push_back(cancelLocked(c.first));
+        }
     }
-    const uint64_t h = s.playing_handle.exchange(0);
-    if (h) AudioEngine::stop(h);
+    for (uint64_t h : silenced)
+        if (h) AudioEngine::stop(h);
 }
 
-bool TtsEngine::speaking() {
+bool TtsEngine::speaking(int channel) {
     TtsState& s = S();
-    if (s.synthesizing.load()) return true;
-    const uint64_t h = s.playing_handle.load();
-    return h != 0 && AudioEngine::isPlaying(h);
+    std::lock_guard<std::mutex> lk(s.mtx);
+    if (s.workers.empty()) return false;
+    auto busy = [&](int ch, const Channel& c) {
+        if (c.synthesizing > 0) return true;
+        for (const Request& r : workerForLocked(ch).queue)
+            if (r.channel == ch) return true;
+        return c.playing != 0 && AudioEngine::isPlaying(c.playing);
+    };
+    if (channel >= 0) {
+        auto it = s.channels.find(channel);
+        return it != s.channels.end() && busy(channel, it->second);
+    }
+    for (const auto& c : s.channels)
+        if (busy(c.first, c.second)) return true;
+    return false;
+}
+
+TtsStats TtsEngine::stats() {
+    TtsState& s = S();
+    std::lock_guard<std::mutex> lk(s.mtx);
+    TtsStats st;
+    st.workers     = (uint32_t)s.workers.size();
+    st.synthesized = s.synthesized.load();
+    st.prefetched  = s.prefetched.load();
+    if (s.cache) {
+        const TtsPhraseCacheStats cs = s.cache->stats();
+        st.cache_hits   = cs.hits + cs.disk_hits;
+        st.disk_hits    = cs.disk_hits;
+        st.cached_lines = cs.lines;
+        st.cached_bytes = cs.bytes;
+    }
+    return st;
 }
 
 #else // !HAS_SHERPA_ONNX — stubs (engine builds without the SDK)
@@ -604,12 +914,18 @@ bool TtsEngine::init(const std::string&) {
 }
 void     TtsEngine::shutdown() {}
 bool     TtsEngine::available() { return false; }
-uint64_t TtsEngine::speak(const std::string&, int, float) {
+uint64_t TtsEngine::speak(const std::string&, int, float, int) {
+    init("");
+    return 0;
+}
+uint64_t TtsEngine::enqueue(const std::string&, int, float, int) {
     init("");
     return 0;
 }
-void TtsEngine::stop() {}
-bool TtsEngine::speaking() { return false; }
+void     TtsEngine::prefetch(const std::string&, int, float, bool) {}
+void     TtsEngine::stop(int) {}
+bool     TtsEngine::speaking(int) { return false; }
+TtsStats TtsEngine::stats() { return {}; }
 std::vector<std::string> TtsEngine::listVoices() { return {}; }
 std::string TtsEngine::currentVoice() { return std::string(); }
 bool     TtsEngine::setVoice(const std::string&) { return false; }
@@ -2,10 +2,28 @@
 // ─────────────────────────────────────────────────────────────────────────────
 // tts_engine.h — runtime text-to-voice (sherpa-onnx + Piper-style VITS voice).
 //
-// Static singleton over a background synthesis thread: speak() enqueues a
-// line, the worker synthesizes float PCM via sherpa-onnx (CPU, real-time
+// Static singleton over a pool of synthesis worker threads: speak() enqueues a
+// line, a worker synthesizes float PCM via sherpa-onnx (CPU, real-time
 // factor << 1 for Piper voices) and plays it on AudioEngine's kVoice bus.
-// A new speak() supersedes the currently playing line — dialog semantics.
+// A new speak() supersedes the line playing on the same CHANNEL — dialog
+// semantics per speaker; lines on different channels play side by side.
+//
+// Streamed replies: speak() the first sentence, enqueue() the rest as the
+// chat model produces them.  An utterance plays on ONE AudioEngine PCM
+// stream; the worker synthesizes sentence N+1 while sentence N plays and
+// appends it to that stream, so sentences join without a gap and the first
+// one is heard after a single sentence of synthesis.
+//
+// Phrase cache: synthesized lines are kept (audio/tts_phrase_cache.h) keyed
+// by voice, speaker_id, speed and text, so a repeated bark, greeting or
+// repeatLast() plays without synthesis.  prefetch() fills the cache ahead
+// of time from idle workers; lines prefetched as STOCK also go to an
+// on-disk tier and survive restarts.
+//
+// Workers: each channel is served by one worker (channel % workers), each
+// worker owns its own sherpa-onnx instance, and the CPU budget is split
+// between them — workers x threads-per-worker never exceeds it.  One
+// worker (the default) serializes all speakers on one model instance.
 //
 // Voice model: first directory under assets/ml_models/tts/ containing a .onnx
 // + tokens.txt (Setup.bat downloads vits-piper-en_US-amy-medium by default;
@@ -14,7 +32,16 @@
 // Backend availability: compiled in only when CMake found the sherpa-onnx
 // SDK (HAS_SHERPA_ONNX).  Without it — or without a voice model on disk —
 // every call is a safe no-op and available() returns false.
+//
+// Configuration (env vars, read once when the workers start):
+//   RW_TTS_WORKERS    — synthesis workers, 1 by default (max 8).
+//   RW_TTS_THREADS    — CPU threads for synthesis across ALL workers, 2 by
+//                       default; each worker gets max(1, threads / workers).
+//   RW_TTS_CACHE_MB   — in-memory phrase cache budget, 32 by default.
+//   RW_TTS_DISK_CACHE — stock-line directory, "tts_cache" in the working
+//                       directory by default; "off" disables the disk tier.
 // ─────────────────────────────────────────────────────────────────────────────
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -22,10 +49,20 @@
 namespace engine {
 namespace audio {
 
+struct TtsStats {
+    uint32_t workers = 0;
+    uint64_t synthesized = 0;       // lines run through sherpa-onnx
+    uint64_t prefetched = 0;        // ... of which for prefetch()
+    uint64_t cache_hits = 0;        // lines played without synthesis
+    uint64_t disk_hits = 0;         // ... of which read from the disk tier
+    size_t   cached_lines = 0;      // in memory
+    size_t   cached_bytes = 0;
+};
+
 class TtsEngine {
 public:
     // Lazily called by speak(); explicit init lets the app choose the model
-    // directory.  Heavy model load happens on the worker thread, so this
+    // directory.  Heavy model load happens on the worker threads, so this
     // never blocks the frame.
     static bool init(const std::string& model_dir = "");
     static void shutdown();
@@ -34,17 +71,40 @@ public:
     static bool available();
 
     // Queue a line for synthesis + playback on the voice bus.  Cancels the
-    // currently playing line first.  speaker_id selects the voice in multi-
-    // speaker models (0 for single-speaker); speed 1.0 = natural.
+    // line playing (or waiting) on the same channel first.  speaker_id
+    // selects the voice in multi-speaker models (0 for single-speaker);
+    // speed 1.0 = natural.  channel (>= 0) is one speaker's slot — give
+    // NPCs that may talk over each other different channels.
     // Returns a request id (0 = backend unavailable).
     static uint64_t speak(const std::string& text, int speaker_id = 0,
-                          float speed = 1.0f);
+                          float speed = 1.0f, int channel = 0);
+
+    // Continue the channel's current utterance with another line: queued
+    // behind whatever is waiting or playing, nothing is cancelled.  Played
+    // back to back with the line before it while that one is still
+    // sounding; after the voice has gone quiet it simply starts a new
+    // utterance.
+    static uint64_t enqueue(const std::string& text, int speaker_id = 0,
+                            float speed = 1.0f, int channel = 0);
+
+    // Synthesize a line the game expects to need soon into the phrase
+    // cache, without playing it.  Prefetches run only on workers with no
+    // speech of their own to do, and lines already cached are skipped.
+    // `stock` also writes the line to the disk tier, for fixed lines that
+    // come back every session.  A speak() of a line still waiting here
+    // takes it over (keeping `stock`).
+    static void prefetch(const std::string& text, int speaker_id = 0,
+                         float speed = 1.0f, bool stock = false);
+
+    // Stop playback and drop queued lines on `channel` (-1 = every
+    // channel).  Pending prefetches are kept.
+    static void stop(int channel = -1);
 
-    // Stop playback and drop any queued lines.
-    static void stop();
+    // True while a line is queued, being synthesized or playing on
+    // `channel` (-1 = any channel).  Prefetches do not count.
+    static bool speaking(int channel = -1);
 
-    // True while a line is being synthesized or played.
-    static bool speaking();
+    static TtsStats stats();
 
     // ── Live voice switching (editor voice picker) ──────────────────────
     // Folder names of every installed voice under assets/ml_models/tts (each a
@@ -56,8 +116,9 @@ public:
 
     // Switch to the named voice (one of listVoices()) and re-synthesize the
     // last spoken line with it, so the picker can be auditioned one-by-one.
-    // The sherpa instance is rebuilt on the worker thread — never blocks the
-    // frame.  Returns false if the name doesn't match an installed voice.
+    // Stops every channel.  The sherpa instances are rebuilt on the worker
+    // threads — never blocks the frame.  Returns false if the name doesn't
+    // match an installed voice.
     static bool setVoice(const std::string& voice_name);
 
     // Re-speak the most recent line with the current voice (0 if nothing has
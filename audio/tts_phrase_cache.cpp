@@ -0,0 +1,210 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// tts_phrase_cache.cpp — see tts_phrase_cache.h.
+//
+// Disk file layout (little-endian, as written by the host):
+//   char     magic[8]      "RWTTSPC1"
+//   uint32_t sample_rate
+//   uint32_t key_bytes
+//   uint64_t sample_count
+//   char     key[key_bytes]            keyString() of the line
+//   float    samples[sample_count]     mono f32 PCM
+// ─────────────────────────────────────────────────────────────────────────────
+#include "audio/tts_phrase_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace engine {
+namespace audio {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char kMagic[8] = {'R', 'W', 'T', 'T', 'S', 'P', 'C', '1'};
+
+bool readDisk(const std::string& path, const std::string& key, TtsPcm& out) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char     magic[8];
+    uint32_t rate = 0, key_bytes = 0;
+    uint64_t count = 0;
+    bool ok = std::fread(magic, 1, 8, f) == 8 &&
+              std::memcmp(magic, kMagic, 8) == 0 &&
+              std::fread(&rate, 4, 1, f) == 1 &&
+              std::fread(&key_bytes, 4, 1, f) == 1 &&
+              std::fread(&count, 8, 1, f) == 1 &&
+              key_bytes == key.size() && rate > 0 && count > 0;
+    if (ok) {
+        std::string stored(key_bytes, '\0');
+        ok = std::fread(stored.data(), 1, key_bytes, f) == key_bytes &&
+             stored == key;
+    }
+    if (ok) {
+        // Size the buffer from the file, not the header, so a truncated
+        // file cannot request a huge allocation.
+        const long at = std::ftell(f);
+        std::fseek(f, 0, SEEK_END);
+        const long end = std::ftell(f);
+        std::fseek(f, at, SEEK_SET);
+        ok = end - at == (long)(count * sizeof(float));
+    }
+    if (ok) {
+        out.sample_rate = rate;
+        out.samples.resize((size_t)count);
+        ok = std::fread(out.samples.data(), sizeof(float), (size_t)count, f) ==
+             (size_t)count;
+    }
+    std::fclose(f);
+    return ok;
+}
+
+void writeDisk(const std::string& path, const std::string& key,
+               const TtsPcm& pcm) {
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    const std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) {
+        std::printf("[tts.cache] cannot write '%s'\n", tmp.c_str());
+        return;
+    }
+    const uint32_t rate = pcm.sample_rate;
+    const uint32_t key_bytes = (uint32_t)key.size();
+    const uint64_t count = pcm.samples.size();
+    bool ok = std::fwrite(kMagic, 1, 8, f) == 8 &&
+              std::fwrite(&rate, 4, 1, f) == 1 &&
+              std::fwrite(&key_bytes, 4, 1, f) == 1 &&
+              std::fwrite(&count, 8, 1, f) == 1 &&
+              std::fwrite(key.data(), 1, key.size(), f) == key.size() &&
+              std::fwrite(pcm.samples.data(), sizeof(float), (size_t)count,
+                          f) == (size_t)count;
+    ok = (std::fclose(f) == 0) && ok;
+    if (ok) fs::rename(tmp, path, ec);
+    if (!ok || ec) {
+        fs::remove(tmp, ec);
+        std::printf("[tts.cache] failed to store '%s'\n", path.c_str());
+    }
+}
+
+} // namespace
+
+std::string TtsPhraseCache::keyString(const TtsPhraseKey& key) {
+    char num[48];
+    std::snprintf(num, sizeof(num), "\x1f%d\x1f%d\x1f", key.speaker_id,
+                  (int)(key.speed * 1000.0f + (key.speed < 0 ? -0.5f : 0.5f)));
+    return key.voice + num + key.text;
+}
+
+uint64_t TtsPhraseCache::hashKey(const std::string& key_string) {
+    uint64_t h = 14695981039346656037ull;           // FNV-1a 64
+    for (unsigned char c : key_string) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::string TtsPhraseCache::diskPath(uint64_t hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.rwtts",
+                  (unsigned long long)hash);
+    return (fs::path(disk_dir_) / name).string();
+}
+
+std::shared_ptr<const TtsPcm> TtsPhraseCache::find(const TtsPhraseKey& key) {
+    const std::string ks = keyString(key);
+    const uint64_t h = hashKey(ks);
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        auto it = entries_.find(h);
+        if (it != entries_.end() && it->second.key == ks) {
+            it->second.last_use = ++use_clock_;
+            ++stats_.hits;
+            return it->second.pcm;
+        }
+        if (disk_dir_.empty()) {
+            ++stats_.misses;
+            return nullptr;
+        }
+    }
+    auto pcm = std::make_shared<TtsPcm>();
+    const bool on_disk = readDisk(diskPath(h), ks, *pcm);
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (!on_disk) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.disk_hits;
+    insertLocked(h, ks, pcm);
+    return pcm;
+}
+
+bool TtsPhraseCache::contains(const TtsPhraseKey& key, bool on_disk) {
+    const std::string ks = keyString(key);
+    const uint64_t h = hashKey(ks);
+    if (on_disk) {
+        if (disk_dir_.empty()) return false;
+        std::error_code ec;
+        return fs::exists(diskPath(h), ec);
+    }
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto it = entries_.find(h);
+    return it != entries_.end() && it->second.key == ks;
+}
+
+void TtsPhraseCache::insert(const TtsPhraseKey& key,
+                            std::shared_ptr<const TtsPcm> pcm, bool persist) {
+    if (!pcm || pcm->samples.empty()) return;
+    const std::string ks = keyString(key);
+    const uint64_t h = hashKey(ks);
+    if (persist && !disk_dir_.empty()) {
+        const std::string path = diskPath(h);
+        std::error_code ec;
+        if (!fs::exists(path, ec)) writeDisk(path, ks, *pcm);
+    }
+    std::lock_guard<std::mutex> lk(mtx_);
+    insertLocked(h, ks, std::move(pcm));
+}
+
+// Caller must hold mtx_.
+void TtsPhraseCache::insertLocked(uint64_t hash, const std::string& key,
+                                  std::shared_ptr<const TtsPcm> pcm) {
+    if (pcm->bytes() > budget_ / 4) return;        // would crowd out the rest
+    Entry& e = entries_[hash];
+    if (e.pcm) bytes_ -= e.pcm->bytes();           // replace (or collision)
+    e.key      = key;
+    e.pcm      = std::move(pcm);
+    e.last_use = ++use_clock_;
+    bytes_ += e.pcm->bytes();
+    evictLocked();
+}
+
+// Caller must hold mtx_.
+void TtsPhraseCache::evictLocked() {
+    while (bytes_ > budget_ && !entries_.empty()) {
+        auto victim = entries_.begin();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+            if (it->second.last_use < victim->second.last_use) victim = it;
+        bytes_ -= victim->second.pcm->bytes();
+        entries_.erase(victim);
+    }
+}
+
+void TtsPhraseCache::clear() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    entries_.clear();
+    bytes_ = 0;
+}
+
+TtsPhraseCacheStats TtsPhraseCache::stats() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    TtsPhraseCacheStats st = stats_;
+    st.lines = entries_.size();
+    st.bytes = bytes_;
+    return st;
+}
+
+} // namespace audio
+} // namespace engine
@@ -0,0 +1,107 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// tts_phrase_cache.h — synthesized-line cache behind TtsEngine.
+//
+// Barks, greetings and repeated dialog lines would otherwise be synthesized
+// again on every speak(); a cached line starts playing with no synthesis at
+// all.  Entries are keyed by a 64-bit hash of (voice, speaker_id, speed,
+// text) and keep the full key, so a hash collision reads as a miss rather
+// than the wrong line.
+//
+// Two tiers:
+//   - memory: mono f32 PCM, least-recently-used lines dropped past the byte
+//     budget; a line bigger than a quarter of the budget is not kept.
+//   - disk (optional): one <hash>.rwtts file per line, for STOCK lines the
+//     game marks persistent.  Read back on a memory miss (and promoted into
+//     memory), so stock lines survive restarts.  Files are written to a
+//     temp name and renamed into place; a file whose header or key does not
+//     match is ignored.  The disk tier is unbounded — it only ever holds
+//     what was explicitly marked.
+//
+// Thread-safe: several synthesis workers share one cache.  Disk reads and
+// writes run outside the lock.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace engine {
+namespace audio {
+
+struct TtsPcm {
+    std::vector<float> samples;      // mono
+    uint32_t           sample_rate = 0;
+    size_t bytes() const { return samples.size() * sizeof(float); }
+};
+
+struct TtsPhraseKey {
+    std::string voice;               // voice folder name
+    int         speaker_id = 0;
+    float       speed = 1.0f;
+    std::string text;
+};
+
+struct TtsPhraseCacheStats {
+    uint64_t hits = 0;               // served from memory
+    uint64_t disk_hits = 0;          // served from the disk tier
+    uint64_t misses = 0;
+    size_t   lines = 0;              // in memory
+    size_t   bytes = 0;
+};
+
+class TtsPhraseCache {
+public:
+    explicit TtsPhraseCache(size_t budget_bytes = 32ull << 20,
+                            std::string disk_dir = "")
+        : budget_(budget_bytes), disk_dir_(std::move(disk_dir)) {}
+
+    // Canonical key text (speed rounded to 1/1000) and its FNV-1a hash,
+    // which also names the disk file.
+    static std::string keyString(const TtsPhraseKey& key);
+    static uint64_t    hashKey(const std::string& key_string);
+
+    // Memory, then disk.  nullptr on a miss.
+    std::shared_ptr<const TtsPcm> find(const TtsPhraseKey& key);
+
+    // Memory-only probe that does not touch the LRU order or the stats —
+    // lets prefetch() skip lines that are already there.  With
+    // `on_disk`, also requires the line's disk file to exist.
+    bool contains(const TtsPhraseKey& key, bool on_disk = false);
+
+    // Keep `pcm` for `key`; `persist` also writes it to the disk tier (if
+    // one is configured and the file is not there yet).
+    void insert(const TtsPhraseKey& key, std::shared_ptr<const TtsPcm> pcm,
+                bool persist = false);
+
+    void clear();
+    TtsPhraseCacheStats stats();
+
+private:
+    struct Entry {
+        std::string                   key;   // keyString(), collision guard
+        std::shared_ptr<const TtsPcm> pcm;
+        uint64_t                      last_use = 0;
+    };
+
+    std::string diskPath(uint64_t hash) const;
+    // Caller must hold mtx_.
+    void insertLocked(uint64_t hash, const std::string& key,
+                      std::shared_ptr<const TtsPcm> pcm);
+    void evictLocked();
+
+    std::mutex                          mtx_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    size_t                              budget_;
+    size_t                              bytes_ = 0;
+    uint64_t                            use_clock_ = 0;
+    std::string                         disk_dir_;
+    TtsPhraseCacheStats                 stats_;
+};
+
+} // namespace audio
+} // namespace engine
@@ -87,6 +87,29 @@ struct WorldBounds {
     glm::vec3 extents = glm::vec3(0.0f);
 };
 
+// ── Scene objects ────────────────────────────────────────────────────────--
+// Set by SceneChunkLoader from the scene::Object an entity was made from.
+
+// A node inside the parent entity's asset (scene::Object::source_node_index);
+// the parent carries the StreamingComponent that loads the file.
+struct SceneNode {
+    int32_t source_node_index = -1;
+};
+
+// Point light (".rwlight" object); position from WorldTransform.
+struct PointLight {
+    glm::vec3 color     = glm::vec3(1.0f, 0.85f, 0.6f);
+    float     intensity = 20.0f;
+    float     radius    = 12.0f;
+};
+
+// Music emitter (".rwbgm" object).
+struct AudioEmitter {
+    std::string clip;
+    bool        loop   = true;
+    float       volume = 1.0f;
+};
+
 // ── Tags (empty payload) ─────────────────────────────────────────────────--
 struct Active {};          // entity participates in systems (gate)
 struct Visible {};         // entity should be drawn (render gather gate)
@@ -0,0 +1,116 @@
+// scene_chunk_loader.cpp — see scene_chunk_loader.h.
+#include "ecs/scene_chunk_loader.h"
+
+#include "ecs/asset_streamer.h"
+#include "ecs/components.h"
+#include "ecs/world.h"
+
+namespace engine {
+namespace ecs {
+
+namespace {
+
+bool endsWith(std::string_view s, std::string_view suffix) {
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+bool SceneChunkLoader::open(const std::string& path) {
+    done_.clear();
+    materialized_ = 0;
+    by_id_.clear();
+    root_ = kNull;
+    if (!archive_.open(path)) return false;
+    done_.assign(archive_.chunks().size(), 0);
+
+    const scene::Transform& r = archive_.root();
+    LocalTransform xform;
+    xform.translation = r.translation;
+    xform.rotation    = r.rotation;
+    xform.scale       = r.scale;
+    root_ = world_.createAt(xform);
+    world_.registry().emplace<Name>(root_, Name{archive_.name()});
+    return true;
+}
+
+size_t SceneChunkLoader::materializeNear(const glm::vec3& focus, float radius,
+                                         size_t max_chunks) {
+    if (chunksPending() == 0) return 0;
+    archive_.chunksNear(focus, radius, near_);
+    size_t created = 0, chunks = 0;
+    for (uint32_t c : near_) {
+        if (chunks == max_chunks) break;
+        if (done_[c]) continue;
+        created += materializeChunk(c);
+        ++chunks;
+    }
+    return created;
+}
+
+size_t SceneChunkLoader::materializeAll() {
+    size_t created = 0;
+    for (uint32_t c = 0; c < (uint32_t)done_.size(); ++c)
+        created += materializeChunk(c);
+    return created;
+}
+
+size_t SceneChunkLoader::materializeChunk(uint32_t chunk) {
+    if (chunk >= done_.size() || done_[chunk]) return 0;
+    // Marked even when decoding fails, so a bad chunk is reported once
+    // rather than retried every frame.
+    done_[chunk] = 1;
+    ++materialized_;
+    if (!archive_.readChunk(chunk, view_)) return 0;
+
+    entt::registry& reg = world_.registry();
+    const scene::SceneChunkView& v = view_;
+    created_.resize(v.count);
+    for (uint32_t i = 0; i < v.count; ++i) {
+        const scene::Transform t = v.transform(i);
+        LocalTransform xform;
+        xform.translation = t.translation;
+        xform.rotation    = t.rotation;
+        xform.scale       = t.scale;
+        const Entity e = world_.createAt(xform);
+        created_[i] = e;
+
+        const uint64_t id = uint64_t(v.scene_index[i]) + 1;
+        reg.emplace<PersistentId>(e, PersistentId{id});
+        reg.emplace<Name>(e, Name{std::string(v.name(i))});
+        if (v.flags[i] & scene::kObjectVisible) reg.emplace<Visible>(e);
+        by_id_[id] = e;
+
+        const std::string_view asset = archive_.str(v.asset[i]);
+        if (endsWith(asset, ".rwlight")) {
+            const float* l = v.light + 5 * i;
+            reg.emplace<PointLight>(
+                e, PointLight{glm::vec3(l[0], l[1], l[2]), l[3], l[4]});
+        } else if (endsWith(asset, ".rwbgm")) {
+            reg.emplace<AudioEmitter>(
+                e, AudioEmitter{std::string(archive_.str(v.audio_clip[i])),
+                                (v.flags[i] & scene::kObjectAudioLoop) != 0,
+                                v.audio_volume[i]});
+        } else if (v.source_node[i] >= 0) {
+            reg.emplace<SceneNode>(e, SceneNode{v.source_node[i]});
+        } else if (!asset.empty()) {
+            StreamingComponent sc;
+            sc.asset_path = std::string(asset);
+            reg.emplace<StreamingComponent>(e, std::move(sc));
+        }
+    }
+
+    // Parents after every entity of the chunk exists — the file does not
+    // promise a parent precedes its children.
+    for (uint32_t i = 0; i < v.count; ++i) {
+        const Entity p = v.parent[i] < 0
+                             ? root_
+                             : find(uint64_t(v.parent[i]) + 1);
+        if (p != kNull) reg.emplace<Parent>(created_[i], Parent{p});
+    }
+    return v.count;
+}
+
+}  // namespace ecs
+}  // namespace engine
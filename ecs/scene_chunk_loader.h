@@ -0,0 +1,92 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// scene_chunk_loader.h — turns a compact scene file into entities, chunk by
+// chunk.
+//
+// open() reads only the archive's header and chunk index
+// (scene/scene_archive.h).  materializeNear(spawn, radius) then creates the
+// entities of the chunks around the player and leaves every other chunk on
+// disk, so opening a scene no longer costs time in proportion to its object
+// count.  Call materializeNear() again as the focus moves — with a chunk
+// budget to bound the frame — and the deferred chunks come in as they get
+// close.  A chunk is materialised at most once; nothing is ever unloaded
+// here (StreamingSystem handles asset residency).
+//
+// open() creates one ROOT entity carrying Scene::root; top-level objects
+// are its children, so focus positions passed in are in scene space.
+// Each object becomes an entity with PersistentId (its index in the scene's
+// object list + 1), Name, LocalTransform / WorldTransform / DirtyTransform,
+// Parent when it has one (a group and its children always share a chunk),
+// Visible when visible, and by kind:
+//   whole-file model object   StreamingComponent{asset_path}
+//   node inside its parent    SceneNode{source_node_index}
+//   ".rwlight"                PointLight
+//   ".rwbgm"                  AudioEmitter
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ecs/entity.h"
+#include "scene/scene_archive.h"
+
+namespace engine {
+namespace ecs {
+
+class World;
+
+class SceneChunkLoader {
+public:
+    explicit SceneChunkLoader(World& world) : world_(world) {}
+
+    // Open a v6 scene.  Nothing is materialised yet.  False when the file
+    // is missing, corrupt or an older format (load those whole with
+    // scene::loadSceneBinary).  Entities already created from a previous
+    // open() are left to the caller.
+    bool open(const std::string& path);
+
+    const scene::SceneArchive& archive() const { return archive_; }
+    Entity root() const { return root_; }
+
+    // Materialise the not-yet-loaded chunks within `radius` of `focus`
+    // (XZ, scene space), nearest first, at most `max_chunks` of them.
+    // Returns the number of entities created.
+    size_t materializeNear(const glm::vec3& focus, float radius,
+                           size_t max_chunks =
+                               std::numeric_limits<size_t>::max());
+
+    // Materialise one chunk (no-op if it already is).  Returns the number
+    // of entities created; 0 also when the chunk fails to decode.
+    size_t materializeChunk(uint32_t chunk);
+
+    // Everything still deferred.
+    size_t materializeAll();
+
+    // Entity of a materialised object, kNull otherwise.
+    Entity find(uint64_t persistent_id) const {
+        auto it = by_id_.find(persistent_id);
+        return it == by_id_.end() ? kNull : it->second;
+    }
+
+    size_t chunksMaterialized() const { return materialized_; }
+    size_t chunksPending() const { return done_.size() - materialized_; }
+
+private:
+    World&                                 world_;
+    Entity                                 root_ = kNull;
+    scene::SceneArchive                    archive_;
+    scene::SceneChunkView                  view_;
+    std::vector<uint8_t>                   done_;      // per chunk
+    size_t                                 materialized_ = 0;
+    std::unordered_map<uint64_t, Entity>   by_id_;
+    std::vector<uint32_t>                  near_;      // scratch
+    std::vector<Entity>                    created_;   // scratch
+};
+
+}  // namespace ecs
+}  // namespace engine
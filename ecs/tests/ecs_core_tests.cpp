@@ -4,16 +4,20 @@
 // Builds against the real EnTT on the engine, or the minimal EnTT-API stand-in
 // in the sandbox. Exercises: deferred-deleter GC timing, transform hierarchy
 // propagation + world bounds, generational handle invalidation, and the
-// streaming state machine (with a mock streamer). No Vulkan required.
+// streaming state machine (with a mock streamer), and chunk-by-chunk scene
+// materialisation. No Vulkan required.
 //
 // Build (sandbox):
 //   g++ -std=c++20 -I<sim_engine> -I<stub-entt-dir> -I<glm-dir> \
 //       ecs/tests/ecs_core_tests.cpp ecs/transform_system.cpp \
-//       ecs/streaming_system.cpp ecs/lifetime_system.cpp ecs/world.cpp -o tests
+//       ecs/streaming_system.cpp ecs/lifetime_system.cpp ecs/world.cpp \
+//       ecs/scene_chunk_loader.cpp scene/scene_archive.cpp scene/scene_io.cpp \
+//       helper/zstd_block.cpp -o tests
 // ─────────────────────────────────────────────────────────────────────────────
 #include <cassert>
 #include <cmath>
 #include <cstdio>
+#include <filesystem>
 #include <vector>
 
 #include "ecs/asset_streamer.h"
@@ -22,9 +26,11 @@
 #include "ecs/animation_system.h"
 #include "ecs/material_cache.h"
 #include "ecs/culling_system.h"
+#include "ecs/scene_chunk_loader.h"
 #include "ecs/streaming_system.h"
 #include "ecs/transform_system.h"
 #include "ecs/world.h"
+#include "scene/scene_io.h"
 
 using namespace engine::ecs;
 
@@ -399,6 +405,99 @@ static void test_material_set_lifecycle() {
     std::printf("  [ok] MaterialSet entity lifecycle\n");
 }
 
+// A saved scene opens with no entities; the chunk around the spawn point
+// materialises first, the rest only when asked, each object exactly once
+// with its components and its parent link.
+static void test_scene_chunk_loader() {
+    namespace sc = engine::scene;
+    sc::Scene s;
+    s.root.translation = glm::vec3(0.0f, 10.0f, 0.0f);
+    sc::Object group;                         // 0: near spawn
+    group.name = "barn";
+    group.asset_path = "assets/barn.glb";
+    group.is_group = true;
+    group.transform.translation = glm::vec3(4.0f, 0.0f, 4.0f);
+    s.objects.push_back(group);
+    sc::Object node;                          // 1: child of the barn
+    node.name = "barn/door";
+    node.asset_path = group.asset_path;
+    node.parent_index = 0;
+    node.source_node_index = 2;
+    node.visible = false;
+    node.transform.translation = glm::vec3(100.0f, 0.0f, 0.0f);
+    s.objects.push_back(node);
+    sc::Object light;                         // 2: next chunk over
+    light.name = "lamp";
+    light.asset_path = "assets/lamp.rwlight";
+    light.light_intensity = 3.0f;
+    light.transform.translation = glm::vec3(40.0f, 2.0f, 4.0f);
+    s.objects.push_back(light);
+    sc::Object radio;                         // 3: far away
+    radio.name = "radio";
+    radio.asset_path = "assets/radio.rwbgm";
+    radio.audio_clip = "content/audio/song.wav";
+    radio.audio_volume = 0.5f;
+    radio.transform.translation = glm::vec3(-900.0f, 0.0f, 0.0f);
+    s.objects.push_back(radio);
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "rw_ecs_chunks.rwscene")
+            .string();
+    sc::SceneSaveOptions opt;
+    opt.chunk_size = 32.0f;
+    CHECK(sc::saveSceneBinary(path, s, opt));
+
+    World w;
+    auto& reg = w.registry();
+    SceneChunkLoader loader(w);
+    CHECK(loader.open(path));
+    CHECK(loader.chunksPending() == 3);
+    CHECK(loader.find(1) == kNull);
+    const Entity root = loader.root();
+    CHECK(approx(reg.get<LocalTransform>(root).translation,
+                 glm::vec3(0.0f, 10.0f, 0.0f)));
+
+    // Spawn at the barn: its chunk only, group and child together.
+    CHECK(loader.materializeNear(glm::vec3(2.0f, 0.0f, 2.0f), 5.0f) == 2);
+    CHECK(loader.chunksMaterialized() == 1);
+    const Entity barn = loader.find(1), door = loader.find(2);
+    CHECK(barn != kNull && door != kNull);
+    CHECK(loader.find(3) == kNull);
+    CHECK(reg.get<Name>(barn).value == "barn");
+    CHECK(reg.get<PersistentId>(door).value == 2);
+    CHECK(reg.get<StreamingComponent>(barn).asset_path == "assets/barn.glb");
+    CHECK(reg.get<SceneNode>(door).source_node_index == 2);
+    CHECK(!reg.all_of<StreamingComponent>(door));
+    CHECK(reg.all_of<Visible>(barn) && !reg.all_of<Visible>(door));
+    CHECK(reg.get<Parent>(door).parent == barn);
+    CHECK(reg.get<Parent>(barn).parent == root);
+
+    // Walking over: the budget holds it to one chunk per call, and chunks
+    // already in are not created twice.
+    CHECK(loader.materializeNear(glm::vec3(30.0f, 0.0f, 4.0f), 2000.0f, 1) == 1);
+    const Entity lamp = loader.find(3);
+    CHECK(lamp != kNull);
+    CHECK(approx(reg.get<PointLight>(lamp).intensity, 3.0f));
+    CHECK(loader.chunksPending() == 1);
+
+    CHECK(loader.materializeAll() == 1);
+    CHECK(loader.materializeAll() == 0);
+    CHECK(loader.materializeNear(glm::vec3(0.0f), 5000.0f) == 0);
+    const Entity r = loader.find(4);
+    CHECK(reg.get<AudioEmitter>(r).clip == "content/audio/song.wav");
+    CHECK(approx(reg.get<AudioEmitter>(r).volume, 0.5f));
+    CHECK(reg.get<AudioEmitter>(r).loop);
+
+    // Transforms compose through the root.
+    w.updateTransforms();
+    CHECK(approx(reg.get<WorldTransform>(door).position(),
+                 glm::vec3(104.0f, 10.0f, 4.0f)));
+
+    CHECK(!loader.open(path + ".missing"));
+    std::remove(path.c_str());
+    std::printf("  [ok] scene chunk loader\n");
+}
+
 int main() {
     std::printf("ECS core tests:\n");
     test_deferred_deleter();
@@ -409,6 +508,7 @@ int main() {
     test_animation();
     test_material_cache();
     test_material_set_lifecycle();
+    test_scene_chunk_loader();
     std::printf("ALL PASSED (%d checks)\n", g_checks);
     return 0;
 }
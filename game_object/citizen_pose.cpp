@@ -0,0 +1,279 @@
+#include "citizen_pose.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace engine {
+namespace game_object {
+namespace {
+
+constexpr float kTwoPi  = 6.28318531f;
+constexpr float kFourPi = 12.56637061f;
+
+// x wrapped into [0, range) -> unorm16, rounded to nearest.  The top
+// code decodes to `range` itself, which is the same angle as 0.
+uint16_t packAngle(float x, float range) {
+    float u = x;
+    if (!(u >= 0.0f && u < range)) {           // fmod only off the
+        u = std::fmod(u, range);               // common path
+        if (u < 0.0f) u += range;
+        if (!(u >= 0.0f)) u = 0.0f;            // NaN
+    }
+    return uint16_t(std::min(u / range * 65535.0f + 0.5f, 65535.0f));
+}
+// UNORM decode, as the vertex fetch does it: code / 65535.
+float unpackUnorm(uint16_t q, float range) {
+    return float(q) / 65535.0f * range;
+}
+uint16_t packSize(float v) {
+    const float u = std::clamp(v / kCitizenSizeRange, 0.0f, 1.0f);
+    return uint16_t(u * 65535.0f + 0.5f);
+}
+
+}  // namespace
+
+glm::vec3 dutyColor(int duty) {
+    static const glm::vec3 table[] = {
+        {0.6f, 0.6f, 0.6f},                    // resident
+        {0.92f, 0.95f, 0.98f}, {0.95f, 0.75f, 0.80f},
+        {0.25f, 0.60f, 0.35f}, {0.16f, 0.22f, 0.45f},
+        {0.10f, 0.16f, 0.38f}, {0.75f, 0.15f, 0.10f},
+        {0.92f, 0.90f, 0.85f}, {0.30f, 0.28f, 0.30f},
+        {0.85f, 0.55f, 0.15f}, {0.35f, 0.42f, 0.55f},
+        {0.55f, 0.35f, 0.60f}, {0.85f, 0.75f, 0.20f},
+        {0.90f, 0.70f, 0.75f}, {0.55f, 0.55f, 0.55f},
+        {0.40f, 0.35f, 0.30f}, {0.70f, 0.55f, 0.75f},
+        {0.80f, 0.50f, 0.20f},
+    };
+    if (duty < 0 || duty >= int(sizeof(table) / sizeof(table[0])))
+        return table[0];
+    return table[duty];
+}
+
+float citizenSeed(uint32_t pid) {
+    // 0.7315 is just an irrational-ish stride through the id space.
+    // Every pose frequency is a multiple of 0.5 rad/s, so 4*pi is a
+    // whole number of cycles of all of them and the reduction changes
+    // no pose — it only keeps the argument small enough for a GPU sin.
+    return std::fmod(float(pid) * 0.7315f, kFourPi);
+}
+
+CitizenRecord packCitizen(const CitizenPose& pose) {
+    CitizenRecord r;
+    r.root[0] = pose.root.x;
+    r.root[1] = pose.root.y;
+    r.root[2] = pose.root.z;
+    r.yaw = packAngle(pose.yaw, kTwoPi);
+    r.phase = packAngle(pose.phase, kTwoPi);
+    r.bits = uint32_t(std::clamp(pose.act, 0, 15)) |
+             uint32_t(std::clamp(pose.duty, 0, 31)) << 4 |
+             (pose.detailed ? kCitizenDetailed : 0u) |
+             (pose.lying ? kCitizenLying : 0u) |
+             (pose.seated ? kCitizenSeated : 0u) |
+             (pose.hidden ? kCitizenHidden : 0u) |
+             uint32_t(packAngle(pose.seed, kFourPi)) << 16;
+    r.height = packSize(pose.height);
+    r.bulk = packSize(pose.bulk);
+    return r;
+}
+
+CitizenPose unpackCitizen(const CitizenRecord& r) {
+    CitizenPose p;
+    p.root = glm::vec3(r.root[0], r.root[1], r.root[2]);
+    p.yaw = unpackUnorm(r.yaw, kTwoPi);
+    p.phase = unpackUnorm(r.phase, kTwoPi);
+    p.act = int(r.bits & 15u);
+    p.duty = int((r.bits >> 4) & 31u);
+    p.detailed = (r.bits & kCitizenDetailed) != 0;
+    p.lying = (r.bits & kCitizenLying) != 0;
+    p.seated = (r.bits & kCitizenSeated) != 0;
+    p.hidden = (r.bits & kCitizenHidden) != 0;
+    p.seed = unpackUnorm(uint16_t(r.bits >> 16), kFourPi);
+    p.height = unpackUnorm(r.height, kCitizenSizeRange);
+    p.bulk = unpackUnorm(r.bulk, kCitizenSizeRange);
+    return p;
+}
+
+int expandCitizen(const CitizenRecord& rec, float anim_t,
+                  CitizenPart* out) {
+    if (rec.bits & kCitizenHidden) return 0;
+    const CitizenPose a = unpackCitizen(rec);
+    const bool walking = a.act == kActWalk;
+    const float s = a.height / 1.75f;
+    const float bw = a.bulk;
+    glm::vec4 col(dutyColor(a.duty), 0.12f);
+
+    if (!a.detailed) {
+        // FAR TIER: one box, person-sized, duty-tinted — a figure at a
+        // distance, not a puppet.  Slight walk bob keeps crowds alive.
+        // T(root + bob) * rotY(yaw) * T(0, 0.875 s, 0) * S(half),
+        // written out: it runs for the whole visible town.
+        float bob = walking ? std::abs(std::cos(a.phase)) * 0.03f * s
+                            : 0.0f;
+        const float c = std::cos(a.yaw), sn = std::sin(a.yaw);
+        const glm::vec3 half(0.20f * s * bw, 0.875f * s, 0.13f * s * bw);
+        out[0].xform = glm::mat4(
+            glm::vec4(c * half.x, 0.0f, -sn * half.x, 0.0f),
+            glm::vec4(0.0f, half.y, 0.0f, 0.0f),
+            glm::vec4(sn * half.z, 0.0f, c * half.z, 0.0f),
+            glm::vec4(a.root.x, a.root.y + bob + 0.875f * s, a.root.z,
+                      1.0f));
+        out[0].color = col;
+        return 1;
+    }
+
+    const float swing = std::sin(a.phase);
+    // Per-person offset on the shared real-time pose clock, so two
+    // neighbours standing in the same doorway are not one puppet
+    // mirrored.
+    const float anim_phase = anim_t + a.seed;
+    float root_y = a.root.y;
+    float torso_pitch = 0.0f;
+    float leg_l = 0.0f, leg_r = 0.0f, arm_l = 0.0f, arm_r = 0.0f;
+    bool sitting = false;
+    switch (a.act) {
+    case kActWalk:
+        leg_l = swing * 0.55f;
+        leg_r = -swing * 0.55f;
+        arm_l = -swing * 0.45f;
+        arm_r = swing * 0.45f;
+        root_y += std::abs(std::cos(a.phase)) * 0.03f * s;
+        break;
+    case kActSleepish:
+        if (a.lying) {
+            // LYING DOWN.  R below is rotY(yaw) * rotX(pitch) applied
+            // about the ROOT, which sits between the feet — so a
+            // quarter turn of pitch tips the whole figure flat, on its
+            // back, extending from the root toward its head.
+            // furnitureAnchor put the root at the foot of the mattress
+            // exactly this reason.  Limbs stay straight; the shared
+            // breath below is the only motion.
+            torso_pitch = -1.5707963f;
+            // The quarter turn also stands the torso's DEPTH on end:
+            // local +Z (half-extent 0.11) becomes world up, so the
+            // body's centreline has to rise by that much or half the
+            // sleeper is inside the mattress.
+            root_y += 0.12f * s;
+        } else {
+            // No bed in this house — dozing upright, the old behaviour.
+            arm_l = arm_r = 0.04f * std::sin(anim_phase * 0.5f);
+        }
+        break;
+    case kActSit:
+    case kActDeskWork:
+        if (a.seated) {
+            sitting = true;
+            leg_l = leg_r = -1.45f;    // thighs forward
+            arm_l = arm_r = a.act == kActDeskWork ? -0.9f : -0.4f;
+        } else {
+            // NOTHING TO SIT ON.  The pose used to be unconditional, so
+            // a person whose room had no free chair — or none at all —
+            // was drawn folded into a sitting shape in mid-air, which
+            // is the single most conspicuous thing this system did.  A
+            // figure standing where it should be sitting is a modelling
+            // shortfall; a figure sitting on nothing is a bug, and only
+            // one of the two reads as a mistake.
+            arm_l = arm_r = 0.10f * std::sin(anim_phase * 0.5f);
+        }
+        break;
+    case kActCook:
+        // Cook and play arms run on their own offset, carried in the
+        // phase field (see CitizenSystem::packPerson).
+        arm_r = -1.1f + 0.25f * std::sin(anim_t * 4.0f + a.phase);
+        arm_l = -0.5f;
+        torso_pitch = 0.12f;
+        break;
+    case kActBrowse:
+        arm_r = -0.9f;
+        torso_pitch = 0.08f;
+        break;
+    case kActWash:
+        // Washing up: both hands down in the basin, a slight lean over
+        // it, and a small scrub off the real-time pose clock.  TWO arms
+        // rather than the cook's one is the whole read — from behind,
+        // one arm out is stirring and two is washing.
+        arm_l = -1.15f + 0.10f * std::sin(anim_phase * 3.0f);
+        arm_r = -1.15f - 0.10f * std::sin(anim_phase * 3.0f);
+        torso_pitch = 0.15f;
+        break;
+    case kActCare:
+        // rounds: slow sway + attending arm
+        arm_l = -0.7f + 0.2f * std::sin(anim_phase * 2.0f);
+        torso_pitch = 0.16f;
+        break;
+    case kActPlay:
+        arm_l = std::sin(anim_t * 5.0f + a.phase) * 0.8f;
+        arm_r = -std::sin(anim_t * 5.0f + a.phase) * 0.8f;
+        break;
+    default:
+        // STANDING IDLE.  A 0.06 rad arm sway was the whole of it, and
+        // on a box figure that is a 3 cm displacement nobody reads as
+        // motion — hence "they don't move at all" even when the sim is
+        // ticking.  Give it a slow weight shift instead, at an
+        // amplitude that survives being seen from ten metres.
+        arm_l = arm_r = 0.10f * std::sin(anim_phase * 0.5f);
+        break;
+    }
+    // Everyone who is not WALKING still breathes: a small torso pitch
+    // and root rise, ~14 cycles a minute, desynchronized per person so
+    // a street does not inhale in unison.  Without it a seated desk
+    // worker, a browsing shopper and a sleeper are all mannequins —
+    // the walk cycle was the only motion this system had.
+    if (!walking) {
+        const float br = std::sin(anim_phase * 1.5f);
+        // A sleeper's breath is the RISE only: adding it to the pitch
+        // would rock a flat body end over end about its feet, which at
+        // 1.7 m of lever arm is a visible see-saw rather than a breath.
+        if (!a.lying) torso_pitch += 0.015f * br;
+        root_y += 0.008f * s * br;
+    }
+    if (sitting) root_y -= 0.42f * s;
+
+    const glm::mat4 base =
+        glm::translate(glm::mat4(1.0f),
+                       glm::vec3(a.root.x, root_y, a.root.z)) *
+        glm::rotate(glm::mat4(1.0f), a.yaw, glm::vec3(0, 1, 0)) *
+        glm::rotate(glm::mat4(1.0f), torso_pitch, glm::vec3(1, 0, 0));
+    int n = 0;
+    auto part = [&](glm::vec3 centre, glm::vec3 half, float pivot_rot,
+                    glm::vec3 pivot, const glm::vec4& c) {
+        glm::mat4 M = base;
+        if (pivot_rot != 0.0f) {
+            M = M * glm::translate(glm::mat4(1.0f), pivot) *
+                glm::rotate(glm::mat4(1.0f), pivot_rot,
+                            glm::vec3(1, 0, 0)) *
+                glm::translate(glm::mat4(1.0f), -pivot);
+        }
+        M = M * glm::translate(glm::mat4(1.0f), centre) *
+            glm::scale(glm::mat4(1.0f), half);
+        out[n++] = {M, c};
+    };
+    // Part order is the part index citizen_crowd.vert derives from the
+    // vertex index: torso, head, arm l/r, leg l/r.
+    // torso / head keep the walk-neutral frame
+    part({0.0f, 1.18f * s, 0.0f},
+         {0.17f * s * bw, 0.27f * s, 0.11f * s * bw}, 0.0f, {}, col);
+    const glm::vec4 head_col = glm::vec4(glm::mix(
+        glm::vec3(0.87f, 0.72f, 0.58f), glm::vec3(col), 0.15f), 0.12f);
+    part({0.0f, 1.62f * s, 0.0f},
+         {0.105f * s, 0.115f * s, 0.105f * s}, 0.0f, {}, head_col);
+    // limbs swing about their pivots
+    part({-0.235f * s * bw, 1.14f * s, 0.0f},
+         {0.05f * s, 0.27f * s, 0.05f * s},
+         arm_l, {-0.235f * s * bw, 1.40f * s, 0.0f}, col);
+    part({0.235f * s * bw, 1.14f * s, 0.0f},
+         {0.05f * s, 0.27f * s, 0.05f * s},
+         arm_r, {0.235f * s * bw, 1.40f * s, 0.0f}, col);
+    part({-0.09f * s, 0.47f * s, 0.0f},
+         {0.07f * s * bw, 0.44f * s, 0.07f * s * bw},
+         leg_l, {-0.09f * s, 0.90f * s, 0.0f}, col);
+    part({0.09f * s, 0.47f * s, 0.0f},
+         {0.07f * s * bw, 0.44f * s, 0.07f * s * bw},
+         leg_r, {0.09f * s, 0.90f * s, 0.0f}, col);
+    return n;
+}
+
+}  // namespace game_object
+}  // namespace engine
@@ -0,0 +1,110 @@
+#pragma once
+
+// citizen_pose.h — the per-person render record and its expansion into
+// box parts.
+//
+// CitizenSystem resolves everything that needs the simulation — which
+// activity a person is doing, which bed or chair they are on, where
+// that puts their root — and packs it into one CitizenRecord.  What
+// remains is a pure function of the record and the shared pose clock:
+// six posed boxes for a detailed figure, one for a distant one.
+//
+// That function runs in TWO places.  expandCitizen() here is the CPU
+// reference: the CPU draw path emits its parts, and the unit tests
+// (game_object/tests/citizen_pose_tests.cpp) pin its behaviour without
+// a GPU.  citizen_crowd.vert is the same expansion per vertex, which is
+// what lets the GPU path upload 24 B per person instead of 80 B per
+// part.  The two must change together — the pose table, the part
+// layout and the duty colours are written out in both.
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace engine {
+namespace game_object {
+
+// ── enums kept as ints in the structs so the header stays light ──────
+enum Activity {
+    kActIdle = 0, kActWalk, kActSit, kActCook, kActBrowse, kActCare,
+    kActDeskWork, kActPlay, kActSleepish,
+    // Washing up at the kitchen sink.  APPENDED, not inserted: these
+    // values are what activityOf() maps city_sim's schedule strings
+    // onto, and renumbering them would silently re-label every
+    // activity in every existing map.
+    kActWash
+};
+
+// Role tint for a Duty value (the enum lives in citizen_system.cpp);
+// out-of-range duties get the resident grey.  Mirrored by kDutyColor
+// in citizen_crowd.vert.
+glm::vec3 dutyColor(int duty);
+
+// One box: its full world transform and colour (rgb role tint, a the
+// readability lift citizen.frag adds).  The CPU path's instance stream.
+struct CitizenPart {
+    glm::mat4 xform;
+    glm::vec4 color;
+};
+
+// ── THE 24-BYTE RECORD ───────────────────────────────────────────────
+// The GPU path's instance stream, read as four vertex attributes:
+//   root   R32G32B32_SFLOAT  body root — the anchor for someone on
+//                            furniture, the sim position otherwise
+//   angles R16G16_UNORM      yaw, walk phase over [0, 2*pi) — for a
+//                            cook or a player, the arm offset instead
+//   bits   R32_UINT          act:4 | duty:5 | flags:4 | seed:16 (<<16)
+//   size   R16G16_UNORM      height, bulk over [0, kCitizenSizeRange]
+// `seed` is the person's offset on the pose clock, over [0, 4*pi).
+struct CitizenRecord {
+    float    root[3];
+    uint16_t yaw;
+    uint16_t phase;
+    uint32_t bits;
+    uint16_t height;
+    uint16_t bulk;
+};
+static_assert(sizeof(CitizenRecord) == 24, "vertex stream layout");
+
+constexpr uint32_t kCitizenDetailed = 1u << 9;   // six parts, posed
+constexpr uint32_t kCitizenLying    = 1u << 10;  // on a bed
+constexpr uint32_t kCitizenSeated   = 1u << 11;  // on a chair
+// Draws nothing: a slot kept for a person not drawn this frame, so the
+// people behind them keep their place in the stream.
+constexpr uint32_t kCitizenHidden   = 1u << 12;
+constexpr float    kCitizenSizeRange = 4.0f;     // metres / factor
+// Parts a detailed figure expands to: torso, head, arms, legs.
+constexpr int      kCitizenParts = 6;
+
+// The record unpacked.  Exactly what both expansions compute from, so
+// a CPU frame and a GPU frame of the same records agree.
+struct CitizenPose {
+    glm::vec3 root{0.0f};
+    float     yaw = 0.0f;
+    float     phase = 0.0f;
+    int       act = kActIdle;
+    int       duty = 0;
+    bool      detailed = false;
+    bool      lying = false;
+    bool      seated = false;
+    bool      hidden = false;
+    float     seed = 0.0f;
+    float     height = 1.7f;
+    float     bulk = 1.0f;
+};
+
+// Quantises `pose` (angles wrapped, sizes clamped to the range).
+CitizenRecord packCitizen(const CitizenPose& pose);
+CitizenPose   unpackCitizen(const CitizenRecord& rec);
+// Pose-clock offset for person `pid`: desynchronises neighbours, and
+// is already reduced to the clock's common period.
+float citizenSeed(uint32_t pid);
+
+// Writes the record's parts to `out` (room for kCitizenParts) at pose
+// time `anim_t` and returns how many: kCitizenParts for a detailed
+// figure, 1 for a far one, 0 for a hidden slot.
+int expandCitizen(const CitizenRecord& rec, float anim_t,
+                  CitizenPart* out);
+
+}  // namespace game_object
+}  // namespace engine
@@ -1,12 +1,16 @@
 #include "citizen_system.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <limits>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <type_traits>
 #include <unordered_map>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -14,6 +18,8 @@
 #include "json.hpp"   // vendored at third_parties/tinygltf/json.hpp
 #include "drawable_object.h"   // PcgInstanceRegistry (furniture)
 #include "helper/engine_helper.h"
+#include "helper/model_inspect.h"   // stableFileHash / stableContentHash
+#include "helper/thread_pool.h"
 #include "renderer/renderer_helper.h"
 #include "shaders/global_definition.glsl.h"
 
@@ -24,15 +30,7 @@ namespace game_object {
 namespace {
 
 // ── enums kept as ints in the structs so the header stays light ──────
-enum Activity {
-    kActIdle = 0, kActWalk, kActSit, kActCook, kActBrowse, kActCare,
-    kActDeskWork, kActPlay, kActSleepish,
-    // Washing up at the kitchen sink.  APPENDED, not inserted: these
-    // values are what activityOf() maps city_sim's schedule strings
-    // onto, and renumbering them would silently re-label every
-    // activity in every existing map.
-    kActWash
-};
+// (Activity lives in citizen_pose.h: the pose expansion switches on it.)
 // Which piece of furniture a home anchor resolved to.  kAnchorNone
 // is "this house has none of it" — the caller falls back.
 enum AnchorKind { kAnchorNone = 0, kAnchorBed, kAnchorStove, kAnchorSeat,
@@ -64,24 +62,6 @@ int dutyEnum(const std::string& d) {
     return kDutyWorker;
 }
 
-glm::vec3 dutyColor(int duty) {
-    static const glm::vec3 table[] = {
-        {0.6f, 0.6f, 0.6f},                    // resident
-        {0.92f, 0.95f, 0.98f}, {0.95f, 0.75f, 0.80f},
-        {0.25f, 0.60f, 0.35f}, {0.16f, 0.22f, 0.45f},
-        {0.10f, 0.16f, 0.38f}, {0.75f, 0.15f, 0.10f},
-        {0.92f, 0.90f, 0.85f}, {0.30f, 0.28f, 0.30f},
-        {0.85f, 0.55f, 0.15f}, {0.35f, 0.42f, 0.55f},
-        {0.55f, 0.35f, 0.60f}, {0.85f, 0.75f, 0.20f},
-        {0.90f, 0.70f, 0.75f}, {0.55f, 0.55f, 0.55f},
-        {0.40f, 0.35f, 0.30f}, {0.70f, 0.55f, 0.75f},
-        {0.80f, 0.50f, 0.20f},
-    };
-    if (duty < 0 || duty >= int(sizeof(table) / sizeof(table[0])))
-        return table[0];
-    return table[duty];
-}
-
 float parseClock(const std::string& hhmm) {
     if (hhmm.size() < 4) return 0.0f;
     return float(std::atoi(hhmm.substr(0, 2).c_str())) * 60.0f +
@@ -130,15 +110,88 @@ float h01(uint32_t a, uint32_t b) {
     return float(h) / 4294967296.0f;
 }
 
+// ── .rwcity layout ──────────────────────────────────────────────────
+//   header : "RWCITY\0\0", u32 format, u32 reserved, u64 source key,
+//            u64 payload bytes, u64 payload hash
+//   payload: the sections in writeCitySidecar order; a vector is a u64
+//            count then its elements' bytes, a string a u32 length then
+//            its bytes.
+// Bump kRwCityFormat whenever loadCity would derive something different
+// from the same JSONs — a household-size tweak changes nothing on disk
+// the key could see.
+constexpr char     kRwCityMagic[8] = {'R', 'W', 'C', 'I', 'T', 'Y', 0, 0};
+constexpr uint32_t kRwCityFormat = 1;
+constexpr size_t   kRwCityHeaderBytes = 8 + 4 + 4 + 8 + 8 + 8;
+
+struct CityWriter {
+    std::vector<uint8_t> out;
+    template <typename T>
+    void pod(const T& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* b = reinterpret_cast<const uint8_t*>(&v);
+        out.insert(out.end(), b, b + sizeof(T));
+    }
+    template <typename T>
+    void vec(const std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        pod(uint64_t(v.size()));
+        const auto* b = reinterpret_cast<const uint8_t*>(v.data());
+        out.insert(out.end(), b, b + v.size() * sizeof(T));
+    }
+    void str(const std::string& s) {
+        pod(uint32_t(s.size()));
+        out.insert(out.end(), s.begin(), s.end());
+    }
+};
+
+// Bounds-checked: a short or inconsistent payload clears `ok` and every
+// later read is a no-op.
+struct CityReader {
+    const uint8_t* p = nullptr;
+    const uint8_t* end = nullptr;
+    bool ok = true;
+    template <typename T>
+    void pod(T& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (!ok || size_t(end - p) < sizeof(T)) { ok = false; return; }
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+    }
+    template <typename T>
+    void vec(std::vector<T>& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        uint64_t n = 0;
+        pod(n);
+        if (!ok || n > uint64_t(end - p) / sizeof(T)) { ok = false; return; }
+        v.resize(size_t(n));
+        if (n) std::memcpy(v.data(), p, size_t(n) * sizeof(T));
+        p += size_t(n) * sizeof(T);
+    }
+    void str(std::string& s) {
+        uint32_t n = 0;
+        pod(n);
+        if (!ok || n > uint64_t(end - p)) { ok = false; return; }
+        s.assign(reinterpret_cast<const char*>(p), n);
+        p += n;
+    }
+};
+
+// Heap order for the far-tier wake events: soonest on top, ties by
+// person so a frame's pops do not depend on heap history.
+bool wakeLater(const std::pair<float, uint32_t>& a,
+               const std::pair<float, uint32_t>& b) {
+    return a.first > b.first || (a.first == b.first && a.second > b.second);
+}
+
 constexpr float kClockScale = 60.0f;      // 1 real s = 1 game minute
 // EVERYONE is simulated, but at two rates.  Inside kNearSimRadius a
 // person gets the full per-frame tick — walking interpolation, yaw,
-// gait phase, door gestures.  Beyond it, a round-robin ring
-// (kFarSimPerFrame persons/frame) snaps each person to their current
-// schedule step's anchor: at 150k+ persons the full walk tick every
+// gait phase, door gestures.  Beyond it, a person is touched only when
+// their schedule step ends (the wake heap in update()) and is snapped to
+// the next step's anchor: at 150k+ persons the full walk tick every
 // frame is real milliseconds, and a commuter 3 km away lerping between
-// anchors is indistinguishable from one teleported there once a
-// second.  Approach them and the near tick resumes mid-schedule.
+// anchors is indistinguishable from one teleported there on the hour.
+// Approach them and the near tick resumes mid-schedule.
 //
 // Rendering stays tiered by distance: full seven-box articulation
 // inside kDetailRadius (capped at kMaxDetailed nearest so a packed
@@ -150,7 +203,6 @@ constexpr float kClockScale = 60.0f;      // 1 real s = 1 game minute
 // raising the cutoff until the crowd fits (nearest, tallest figures
 // keep priority as the angular test is height/dist).
 constexpr float kNearSimRadius = 700.0f;
-constexpr size_t kFarSimPerFrame = 8192;
 constexpr float kDetailRadius = 300.0f;
 // ── THE BUDGETS THAT WERE REALLY DRAW-CALL BUDGETS ──────────────────
 // 320 detailed figures and 12000 far parts were sized against a draw
@@ -175,6 +227,11 @@ constexpr float kDetailRadius = 300.0f;
 // is visible" is the rule now.
 constexpr size_t kMaxDetailed = 4096;
 constexpr size_t kMaxFarParts = 200000;   // far-tier safety valve
+// Parallel tick (planChunks): populations below kParallelMinPersons
+// run on the calling thread, and no chunk is cut smaller than
+// kMinChunkPersons — under that a pool hand-off outweighs the work.
+constexpr size_t kParallelMinPersons = 4096;
+constexpr size_t kMinChunkPersons = 1024;
 constexpr float kShowRadius = 10000.0f;   // 10 km
 // Sub-pixel cutoff, not a budget: 0.0003 rad of height is about a third
 // of a pixel at 1440p, so this only drops people who could not put a
@@ -216,10 +273,10 @@ constexpr float kWalkTimeScale = 6.0f;
 // never pops a limb.  Wrapping at all is what keeps the sine arguments
 // in a precise part of the float range over a long session.
 constexpr float kAnimWrap = 25.13274123f;   // 8 * pi
-// Staggered height refresh for everyone the near tier did not reach.
-// Sized against the population this system now carries (~4 residents
-// per house): at 1024 a 228k-person town took ~220 frames to come
-// round, long enough that a far commuter's height visibly snaps.
+// Height refreshes a frame for persons the near tier did not clamp:
+// far step snaps and walkers leaving the ring (ground_queue_).  Only
+// a morning rush or a clock jump fills the queue past this; ordinary
+// frames drain it in one go.
 constexpr size_t kFarClampPerFrame = 4096;
 // How many houses per grid cell get promoted to destinations by
 // synthesizeResidents (first four workplaces, the rest shops).  Lives
@@ -232,10 +289,13 @@ constexpr int kSchoolsPerCell = 4;
 // treated as while steering — the archetypes run ~11-14 m across at the
 // shipped scale, so ~6.5 m plus a shoulder keeps a walker off the walls
 // without carving a wide berth through a tight street.  kAvoidLook is
-// how far ahead the walker checks, kAvoidCell the spatial-hash cell.
+// how far ahead the walker checks, kAvoidCell the avoidance-grid cell.
 constexpr float kHouseBlockR = 7.0f;
 constexpr float kAvoidLook   = 9.0f;
 constexpr float kAvoidCell   = 48.0f;
+// Dense avoidance grid ceiling: 4M cells of 48 m is a ~100 km square,
+// far past any placed map; beyond it the bounds are a broken manifest.
+constexpr int64_t kMaxAvoidCells = int64_t(1) << 22;
 // HOUSEHOLD SIZE.  A house holds a FAMILY, not a lone occupant: the
 // population is house_count x [kHouseholdMin, kHouseholdMax] drawn per
 // house, so a 57k-house town carries ~230k people rather than 57k.
@@ -330,8 +390,10 @@ std::shared_ptr<er::BufferInfo>     CitizenSystem::s_cube_nrm_;
 std::shared_ptr<er::BufferInfo>     CitizenSystem::s_cube_idx_;
 uint32_t                            CitizenSystem::s_cube_index_count_ = 0;
 std::shared_ptr<er::Device>         CitizenSystem::s_device_;
-std::shared_ptr<er::BufferInfo>     CitizenSystem::s_inst_buf_;
-uint32_t                            CitizenSystem::s_inst_capacity_ = 0;
+std::shared_ptr<er::Pipeline>       CitizenSystem::s_crowd_pipeline_;
+CitizenSystem::UploadSlot CitizenSystem::s_upload_[kUploadSlots];
+uint32_t                            CitizenSystem::s_upload_frame_ = 0;
+size_t                              CitizenSystem::s_upload_written_ = 0;
 
 void CitizenSystem::initStaticMembers(
     const std::shared_ptr<er::Device>& device,
@@ -398,8 +460,40 @@ void CitizenSystem::initStaticMembers(
         graphic_pipeline_info, shader_modules, frame_buffer_format,
         raster_override, std::source_location::current());
 
+    // ── THE RECORD STREAM ───────────────────────────────────────────
+    // Same mesh bindings; binding 2 is one CitizenRecord per person,
+    // its four fields at 10-13 (layout in citizen_pose.h).
+    bindings[2].stride = sizeof(CitizenRecord);
+    attribs.resize(6);
+    const er::Format rec_fmt[4] = {
+        er::Format::R32G32B32_SFLOAT, er::Format::R16G16_UNORM,
+        er::Format::R32_UINT, er::Format::R16G16_UNORM};
+    const uint32_t rec_off[4] = {
+        uint32_t(offsetof(CitizenRecord, root)),
+        uint32_t(offsetof(CitizenRecord, yaw)),
+        uint32_t(offsetof(CitizenRecord, bits)),
+        uint32_t(offsetof(CitizenRecord, height))};
+    for (int k = 0; k < 4; ++k) {
+        attribs[2 + k].binding = 2;
+        attribs[2 + k].location = uint32_t(10 + k);
+        attribs[2 + k].format = rec_fmt[k];
+        attribs[2 + k].offset = rec_off[k];
+    }
+    er::ShaderModuleList crowd_modules(2);
+    crowd_modules[0] = er::helper::loadShaderModule(
+        device, "citizen_crowd_vert.spv",
+        er::ShaderStageFlagBits::VERTEX_BIT,
+        std::source_location::current());
+    crowd_modules[1] = shader_modules[1];
+    s_crowd_pipeline_ = device->createPipeline(
+        s_pipeline_layout_, bindings, attribs, input_assembly,
+        graphic_pipeline_info, crowd_modules, frame_buffer_format,
+        raster_override, std::source_location::current());
+
     // Unit cube centred at origin, half-extent 1, 24 verts so every
-    // face gets its own flat normal.
+    // face gets its own flat normal.  Laid down kCitizenParts times:
+    // citizen_crowd.vert takes the part from gl_VertexIndex / 24, and
+    // the CPU path draws the first copy alone.
     static const glm::vec3 face_n[6] = {
         {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1},
         {0, 0, -1}};
@@ -425,6 +519,15 @@ void CitizenSystem::initStaticMembers(
         idx.insert(idx.end(), {base, base + 2, base + 1,
                                base, base + 3, base + 2});
     }
+    const uint32_t cube_verts = uint32_t(pos.size());
+    const size_t cube_idx = idx.size();
+    for (int k = 1; k < kCitizenParts; ++k) {
+        pos.insert(pos.end(), pos.begin(), pos.begin() + cube_verts);
+        nrm.insert(nrm.end(), nrm.begin(), nrm.begin() + cube_verts);
+        for (size_t j = 0; j < cube_idx; ++j) {
+            idx.push_back(idx[j] + uint32_t(k) * cube_verts);
+        }
+    }
     s_cube_pos_ = helper::createUnifiedMeshBuffer(
         device, SET_FLAG_BIT(BufferUsage, VERTEX_BUFFER_BIT),
         pos.size() * sizeof(pos[0]), pos.data(),
@@ -437,7 +540,7 @@ void CitizenSystem::initStaticMembers(
         device, SET_FLAG_BIT(BufferUsage, INDEX_BUFFER_BIT),
         idx.size() * sizeof(idx[0]), idx.data(),
         std::source_location::current());
-    s_cube_index_count_ = uint32_t(idx.size());
+    s_cube_index_count_ = uint32_t(cube_idx);
 }
 
 void CitizenSystem::destroyStaticMembers(
@@ -447,11 +550,16 @@ void CitizenSystem::destroyStaticMembers(
     s_pipeline_layout_ = nullptr;
     if (s_pipeline_) device->destroyPipeline(s_pipeline_);
     s_pipeline_ = nullptr;
-    if (s_inst_buf_) {
-        s_inst_buf_->destroy(device);
-        s_inst_buf_ = nullptr;
+    if (s_crowd_pipeline_) device->destroyPipeline(s_crowd_pipeline_);
+    s_crowd_pipeline_ = nullptr;
+    for (UploadSlot& slot : s_upload_) {
+        if (slot.buf) {
+            if (slot.mapped) device->unmapMemory(slot.buf->memory);
+            slot.buf->destroy(device);
+        }
+        slot = UploadSlot{};
     }
-    s_inst_capacity_ = 0;
+    s_upload_frame_ = 0;
     s_device_ = nullptr;
     if (s_cube_pos_) s_cube_pos_->destroy(device);
     if (s_cube_nrm_) s_cube_nrm_->destroy(device);
@@ -463,16 +571,7 @@ bool CitizenSystem::loadCity(const std::string& city_json_path,
                              const std::string& world_json_path,
                              const std::string& indoor_json_path) {
     using nlohmann::json;
-    loaded_ = false;
-    houses_.clear();
-    house_school_seats_.clear();
-    graphs_.clear();
-    house_graph_.clear();
-    house_yaw_.clear();
-    house_scale_.clear();
-    buildings_.clear();
-    persons_.clear();
-    sim_.clear();
+    clearCity();
     std::error_code ec;
     // ── WHAT IS ACTUALLY REQUIRED ────────────────────────────────────
     // Only the WORLD manifest: it carries the house transforms, which
@@ -495,6 +594,29 @@ bool CitizenSystem::loadCity(const std::string& city_json_path,
                   << std::endl;
         return false;
     }
+    // The compiled city, when it is still the city these files describe.
+    const std::string sidecar_path =
+        std::filesystem::path(world_json_path)
+            .replace_extension(".rwcity").string();
+    const uint64_t source_key =
+        citySourceKey(city_json_path, world_json_path, indoor_json_path);
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        if (source_key && readCitySidecar(sidecar_path, source_key)) {
+            loaded_ = !persons_.empty();
+            std::cout << "[citizen] loaded " << persons_.size()
+                      << " persons, " << buildings_.size()
+                      << " buildings, " << houses_.size() << " houses from "
+                      << std::filesystem::path(sidecar_path)
+                             .filename().string()
+                      << " in "
+                      << std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - t0).count()
+                      << " ms" << std::endl;
+            return loaded_;
+        }
+        clearCity();
+    }
     const bool have_city = std::filesystem::exists(city_json_path, ec);
     if (!have_city) {
         std::cout << "[citizen] no city json (" << city_json_path
@@ -641,15 +763,18 @@ bool CitizenSystem::loadCity(const std::string& city_json_path,
                         : st == "heavy" ? 1.1f : 1.35f;
             }
             if (p.duty == kDutyStudent) p.speed = 1.5f;
+            std::vector<Step> weekday, weekend;
             if (pj.contains("schedule")) {
                 const auto& sc = pj["schedule"];
                 p.works_weekend = sc.value("works_weekend", false);
-                p.weekday = parseSched(sc["weekday"], p.duty);
-                p.weekend = parseSched(sc["weekend"], p.duty);
+                weekday = parseSched(sc["weekday"], p.duty);
+                weekend = parseSched(sc["weekend"], p.duty);
             } else if (pj.contains("routine")) {
-                p.weekday = parseSched(pj["routine"], p.duty);
+                weekday = parseSched(pj["routine"], p.duty);
             }
-            if (p.weekday.empty()) continue;
+            if (weekday.empty()) continue;
+            p.weekday = packSchedule(weekday);
+            p.weekend = packSchedule(weekend);
             persons_.push_back(std::move(p));
         }
         // Seat every city-json resident within their household the
@@ -672,6 +797,7 @@ bool CitizenSystem::loadCity(const std::string& city_json_path,
                       << std::endl;
             buildings_.clear();
             persons_.clear();
+            steps_.clear();
         }
         }   // if (have_city)
 
@@ -722,6 +848,9 @@ bool CitizenSystem::loadCity(const std::string& city_json_path,
                          "tools/terrain/city_sim.py to populate every "
                          "household." << std::endl;
         }
+        if (loaded_ && source_key) {
+            writeCitySidecar(sidecar_path, source_key);
+        }
     } catch (const std::exception& e) {
         std::cout << "[citizen] city load failed: " << e.what()
                   << std::endl;
@@ -740,6 +869,7 @@ void CitizenSystem::synthesizeResidents() {
     // destination anchors picked out of the house field, and one
     // household per house with a real day built around each of them.
     persons_.clear();
+    steps_.clear();
     buildings_.clear();
     if (houses_.empty()) return;
 
@@ -889,6 +1019,11 @@ void CitizenSystem::synthesizeResidents() {
     // ── 2. RESIDENTS ─────────────────────────────────────────────────
     const int hh_avg = (kHouseholdMin + kHouseholdMax + 1) / 2;
     persons_.reserve(houses_.size() * size_t(hh_avg));
+    // Eleven weekday hinges and nine weekend ones per resident.
+    steps_.reserve(houses_.size() * size_t(hh_avg) * 20);
+    // Day-plan scratch, reused for every resident before it is packed
+    // into steps_.
+    std::vector<Step> weekday, weekend;
     for (size_t i = 0; i < houses_.size(); ++i) {
         // A SCHOOL IS NOT A DWELLING.  Its rooms hold desks, not beds,
         // so nobody lives here — and letting a household move in would
@@ -1071,7 +1206,7 @@ void CitizenSystem::synthesizeResidents() {
             // sleep -> out -> home -> sleep.
             const float errand1 = jit(11.0f * 60.0f, 300.0f, 0x111u);
             const float errand2 = jit(16.0f * 60.0f, 300.0f, 0x112u);
-            p.weekday = {
+            weekday = {
                 step(0.0f,                              kActSleepish, -1),
                 step(jit(wake,   90.0f, 0x101u),        home_act,     -1),
                 step(jit(leave, 150.0f, 0x102u),        dest_act,     dest),
@@ -1098,7 +1233,7 @@ void CitizenSystem::synthesizeResidents() {
             // Weekend: a lie-in, an errand or a stroll, home for the
             // evening.  Whoever works weekends keeps the weekday shape
             // (scheduleOf only reaches for this list when they do not).
-            p.weekend = {
+            weekend = {
                 step(0.0f,                              kActSleepish, -1),
                 step(jit( 9.00f * 60.0f, 150.0f, 0x201u), home_act,   -1),
                 step(jit(11.00f * 60.0f, 240.0f, 0x202u), kActBrowse, shop),
@@ -1123,15 +1258,17 @@ void CitizenSystem::synthesizeResidents() {
                                           1439.0f);
                 }
             };
-            clamp_day(p.weekday);
-            clamp_day(p.weekend);
+            clamp_day(weekday);
+            clamp_day(weekend);
             // Jitter can reorder two hinges that started close together;
             // currentStep walks the list assuming ascending minutes.
             auto by_time = [](const Step& a, const Step& b) {
                 return a.minutes < b.minutes;
             };
-            std::sort(p.weekday.begin(), p.weekday.end(), by_time);
-            std::sort(p.weekend.begin(), p.weekend.end(), by_time);
+            std::sort(weekday.begin(), weekday.end(), by_time);
+            std::sort(weekend.begin(), weekend.end(), by_time);
+            p.weekday = packSchedule(weekday);
+            p.weekend = packSchedule(weekend);
             persons_.push_back(std::move(p));
         }   // household seat
     }   // house
@@ -1193,11 +1330,11 @@ void CitizenSystem::setTimeOfDayHours(float hours) {
 void CitizenSystem::placeAll() {
     // Wipe the per-person sim state: pos 0, inited false, cur_step -1.
     // The next update() then places every person at the anchor their
-    // schedule names for the CURRENT clock (near ones immediately, the
-    // rest over the next few frames via the far ring) — which is the
-    // whole spawn-on-Play behaviour, without a second placement path
-    // that could disagree with the simulation's own.
-    sim_.assign(persons_.size(), SimState{});
+    // schedule names for the CURRENT clock, all in that one frame (see
+    // replanAll) — which is the whole spawn-on-Play behaviour, without
+    // a second placement path that could disagree with the
+    // simulation's own.
+    resetSim();
     // Restart the clock-rate measurement: the gap across an edit-mode
     // pause is not a rate sample, and a rate carried over from a
     // faster session would sprint everyone for its first second.
@@ -1212,23 +1349,74 @@ void CitizenSystem::placeAll() {
 }
 
 void CitizenSystem::buildHouseGrid() {
-    house_grid_.clear();
-    house_grid_.reserve(houses_.size() / 4 + 16);
+    house_cell_first_.clear();
+    house_cell_items_.clear();
+    house_nx_ = house_nz_ = 0;
+    // Cell bounds of every placeable house.  A house at a non-finite
+    // position has no cell (and never had one that anybody queried).
+    int32_t x0 = std::numeric_limits<int32_t>::max();
+    int32_t z0 = std::numeric_limits<int32_t>::max();
+    int32_t x1 = std::numeric_limits<int32_t>::min();
+    int32_t z1 = std::numeric_limits<int32_t>::min();
+    auto cellOf = [](float v) { return int32_t(std::floor(v / kAvoidCell)); };
+    for (const glm::vec3& h : houses_) {
+        if (!std::isfinite(h.x) || !std::isfinite(h.z)) continue;
+        const int32_t cx = cellOf(h.x), cz = cellOf(h.z);
+        x0 = std::min(x0, cx); x1 = std::max(x1, cx);
+        z0 = std::min(z0, cz); z1 = std::max(z1, cz);
+    }
+    if (x0 > x1) return;
+    const int64_t nx = int64_t(x1) - x0 + 1, nz = int64_t(z1) - z0 + 1;
+    if (nx * nz > kMaxAvoidCells) {
+        std::cout << "[citizen] houses span " << nx << " x " << nz
+                  << " avoidance cells — steering disabled" << std::endl;
+        return;
+    }
+    house_cx0_ = x0;
+    house_cz0_ = z0;
+    house_nx_ = int32_t(nx);
+    house_nz_ = int32_t(nz);
+    // Counting sort: bin, prefix-sum, fill.  Filling in house order
+    // keeps every cell ascending, the order the steering sums in.
+    house_cell_first_.assign(size_t(nx * nz) + 1, 0);
+    auto cellIndex = [&](const glm::vec3& h) {
+        return size_t(cellOf(h.z) - house_cz0_) * size_t(house_nx_) +
+               size_t(cellOf(h.x) - house_cx0_);
+    };
+    for (const glm::vec3& h : houses_) {
+        if (!std::isfinite(h.x) || !std::isfinite(h.z)) continue;
+        ++house_cell_first_[cellIndex(h) + 1];
+    }
+    for (size_t c = 1; c < house_cell_first_.size(); ++c) {
+        house_cell_first_[c] += house_cell_first_[c - 1];
+    }
+    house_cell_items_.resize(house_cell_first_.back());
+    std::vector<uint32_t> fill(house_cell_first_.begin(),
+                               house_cell_first_.end() - 1);
     for (size_t i = 0; i < houses_.size(); ++i) {
         const glm::vec3& h = houses_[i];
-        const int32_t cx = int32_t(std::floor(h.x / kAvoidCell));
-        const int32_t cz = int32_t(std::floor(h.z / kAvoidCell));
-        const uint64_t k =
-            (uint64_t(uint32_t(cx)) << 32) | uint32_t(cz);
-        house_grid_[k].push_back(int(i));
+        if (!std::isfinite(h.x) || !std::isfinite(h.z)) continue;
+        house_cell_items_[fill[cellIndex(h)]++] = int(i);
+    }
+}
+
+std::pair<const int*, const int*> CitizenSystem::housesInCell(
+    int32_t cx, int32_t cz) const {
+    const int64_t lx = int64_t(cx) - house_cx0_;
+    const int64_t lz = int64_t(cz) - house_cz0_;
+    if (lx < 0 || lz < 0 || lx >= house_nx_ || lz >= house_nz_) {
+        return {nullptr, nullptr};
     }
+    const size_t c = size_t(lz) * size_t(house_nx_) + size_t(lx);
+    const int* items = house_cell_items_.data();
+    return {items + house_cell_first_[c], items + house_cell_first_[c + 1]};
 }
 
 glm::vec2 CitizenSystem::steerAroundHouses(const glm::vec2& pos,
                                            const glm::vec2& dir,
                                            int exempt_house,
                                            int exempt_dest) const {
-    if (house_grid_.empty()) return dir;
+    if (house_cell_items_.empty()) return dir;
     // The two buildings this walker is allowed to be inside: the house
     // they live in, and the house they are walking to.  Everything else
     // is an obstacle — walking through the neighbours is what this
@@ -1240,18 +1428,14 @@ glm::vec2 CitizenSystem::steerAroundHouses(const glm::vec2& pos,
         const Building& b = buildings_[exempt_dest];
         const int32_t cx = int32_t(std::floor(b.centre.x / kAvoidCell));
         const int32_t cz = int32_t(std::floor(b.centre.y / kAvoidCell));
-        const uint64_t k =
-            (uint64_t(uint32_t(cx)) << 32) | uint32_t(cz);
-        auto it = house_grid_.find(k);
-        if (it != house_grid_.end()) {
-            float best = 4.0f * 4.0f;
-            for (int hi : it->second) {
-                const glm::vec3& h = houses_[hi];
-                const float dx = h.x - b.centre.x;
-                const float dz = h.z - b.centre.y;
-                const float d2 = dx * dx + dz * dz;
-                if (d2 < best) { best = d2; dest_house = hi; }
-            }
+        const auto [h0, h1] = housesInCell(cx, cz);
+        float best = 4.0f * 4.0f;
+        for (const int* it = h0; it != h1; ++it) {
+            const glm::vec3& h = houses_[*it];
+            const float dx = h.x - b.centre.x;
+            const float dz = h.z - b.centre.y;
+            const float d2 = dx * dx + dz * dz;
+            if (d2 < best) { best = d2; dest_house = *it; }
         }
     }
 
@@ -1262,11 +1446,9 @@ glm::vec2 CitizenSystem::steerAroundHouses(const glm::vec2& pos,
     const int32_t c1z = int32_t(std::floor((pos.y + kAvoidLook) / kAvoidCell));
     for (int32_t cx = c0x; cx <= c1x; ++cx) {
         for (int32_t cz = c0z; cz <= c1z; ++cz) {
-            const uint64_t k =
-                (uint64_t(uint32_t(cx)) << 32) | uint32_t(cz);
-            auto it = house_grid_.find(k);
-            if (it == house_grid_.end()) continue;
-            for (int hi : it->second) {
+            const auto [h0, h1] = housesInCell(cx, cz);
+            for (const int* it = h0; it != h1; ++it) {
+                const int hi = *it;
                 if (hi == exempt_house || hi == dest_house) continue;
                 const glm::vec3& h = houses_[hi];
                 const glm::vec2 to_h(h.x - pos.x, h.z - pos.y);
@@ -1311,6 +1493,231 @@ glm::vec2 CitizenSystem::steerAroundHouses(const glm::vec2& pos,
     return out / L;
 }
 
+void CitizenSystem::clearCity() {
+    loaded_ = false;
+    houses_.clear();
+    house_school_seats_.clear();
+    graphs_.clear();
+    house_graph_.clear();
+    house_yaw_.clear();
+    house_scale_.clear();
+    buildings_.clear();
+    persons_.clear();
+    steps_.clear();
+    beds_.clear(); stoves_.clear(); seats_.clear(); sinks_.clear();
+    house_beds_.clear(); house_stoves_.clear();
+    house_seats_.clear(); house_sinks_.clear();
+    house_cell_first_.clear();
+    house_cell_items_.clear();
+    house_nx_ = house_nz_ = 0;
+    district_centre_ = glm::vec2(0.0f);
+    resetSim();
+}
+
+uint64_t CitizenSystem::citySourceKey(
+    const std::string& city_json_path, const std::string& world_json_path,
+    const std::string& indoor_json_path) const {
+    // Absent optional inputs hash as a fixed tag, so "no city json" and
+    // "an empty city json" are different cities.  0 = cannot key (the
+    // world manifest is unreadable): no sidecar either way.
+    uint64_t h = helper::stableContentHash(&kRwCityFormat,
+                                           sizeof(kRwCityFormat));
+    auto fold = [&h](const std::string& path, bool required) {
+        uint64_t fh = 0x6e6f6e65ull;                    // "none"
+        std::error_code ec;
+        if (!path.empty() && std::filesystem::exists(path, ec)) {
+            if (!helper::stableFileHash(path, fh)) return false;
+        } else if (required) {
+            return false;
+        }
+        h = helper::stableContentHash(&fh, sizeof(fh), h);
+        return true;
+    };
+    if (!fold(world_json_path, true) || !fold(city_json_path, false) ||
+        !fold(indoor_json_path, false)) {
+        return 0;
+    }
+    // The furniture came out of the instance registry, loaded from its
+    // own json at terrain apply.
+    const uint64_t reg = PcgInstanceRegistry::get().sourceHash();
+    h = helper::stableContentHash(&reg, sizeof(reg), h);
+    return h ? h : 1;
+}
+
+void CitizenSystem::writeCitySidecar(const std::string& path,
+                                     uint64_t key) const {
+    CityWriter w;
+    w.vec(houses_);
+    w.vec(house_school_seats_);
+    w.vec(house_graph_);
+    w.vec(house_yaw_);
+    w.vec(house_scale_);
+    w.pod(uint64_t(graphs_.size()));
+    for (const IndoorGraph& g : graphs_) {
+        w.vec(g.rooms);
+        w.vec(g.doors);
+        w.vec(g.street);
+        w.vec(g.next_);
+        w.vec(g.dist_);
+    }
+    w.pod(uint64_t(buildings_.size()));
+    for (const Building& b : buildings_) {
+        w.str(b.type);
+        w.pod(b.house);
+        w.pod(b.entrance);
+        w.pod(b.centre);
+        w.pod(b.yaw);
+        w.pod(b.base_y);
+        w.pod(b.spread);
+        w.pod(b.headcount);
+    }
+    w.vec(persons_);
+    w.vec(steps_);
+    w.vec(beds_);   w.vec(house_beds_);
+    w.vec(stoves_); w.vec(house_stoves_);
+    w.vec(seats_);  w.vec(house_seats_);
+    w.vec(sinks_);  w.vec(house_sinks_);
+    w.pod(house_cx0_); w.pod(house_cz0_);
+    w.pod(house_nx_);  w.pod(house_nz_);
+    w.vec(house_cell_first_);
+    w.vec(house_cell_items_);
+    w.pod(district_centre_);
+
+    CityWriter hdr;
+    for (char c : kRwCityMagic) hdr.pod(c);
+    hdr.pod(kRwCityFormat);
+    hdr.pod(uint32_t(0));
+    hdr.pod(key);
+    hdr.pod(uint64_t(w.out.size()));
+    hdr.pod(helper::stableContentHash(w.out.data(), w.out.size()));
+
+    // Temp + rename, so a crash mid-write never leaves a torn sidecar
+    // under the real name.
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) return;              // read-only map folder: no cache
+        f.write(reinterpret_cast<const char*>(hdr.out.data()),
+                std::streamsize(hdr.out.size()));
+        f.write(reinterpret_cast<const char*>(w.out.data()),
+                std::streamsize(w.out.size()));
+        if (!f) {
+            f.close();
+            std::error_code ec;
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return;
+    }
+    std::cout << "[citizen] compiled city written to "
+              << std::filesystem::path(path).filename().string() << " ("
+              << (hdr.out.size() + w.out.size()) / 1024 << " KB)"
+              << std::endl;
+}
+
+bool CitizenSystem::readCitySidecar(const std::string& path, uint64_t key) {
+    std::ifstream f(path, std::ios::binary | std::ios::ate);
+    if (!f) return false;
+    const std::streamsize size = f.tellg();
+    if (size < std::streamsize(kRwCityHeaderBytes)) return false;
+    std::vector<uint8_t> buf(static_cast<size_t>(size));
+    f.seekg(0);
+    if (!f.read(reinterpret_cast<char*>(buf.data()), size)) return false;
+
+    CityReader r{buf.data(), buf.data() + buf.size()};
+    char magic[8] = {};
+    for (char& c : magic) r.pod(c);
+    uint32_t format = 0, reserved = 0;
+    uint64_t file_key = 0, payload_bytes = 0, payload_hash = 0;
+    r.pod(format);
+    r.pod(reserved);
+    r.pod(file_key);
+    r.pod(payload_bytes);
+    r.pod(payload_hash);
+    if (!r.ok || std::memcmp(magic, kRwCityMagic, sizeof(magic)) != 0 ||
+        format != kRwCityFormat || file_key != key ||
+        payload_bytes != uint64_t(r.end - r.p) ||
+        helper::stableContentHash(r.p, size_t(payload_bytes)) !=
+            payload_hash) {
+        return false;
+    }
+
+    r.vec(houses_);
+    r.vec(house_school_seats_);
+    r.vec(house_graph_);
+    r.vec(house_yaw_);
+    r.vec(house_scale_);
+    uint64_t n_graphs = 0;
+    r.pod(n_graphs);
+    if (!r.ok || n_graphs > uint64_t(r.end - r.p)) return false;
+    graphs_.resize(size_t(n_graphs));
+    for (IndoorGraph& g : graphs_) {
+        r.vec(g.rooms);
+        r.vec(g.doors);
+        r.vec(g.street);
+        r.vec(g.next_);
+        r.vec(g.dist_);
+    }
+    uint64_t n_buildings = 0;
+    r.pod(n_buildings);
+    if (!r.ok || n_buildings > uint64_t(r.end - r.p)) return false;
+    buildings_.resize(size_t(n_buildings));
+    for (Building& b : buildings_) {
+        r.str(b.type);
+        r.pod(b.house);
+        r.pod(b.entrance);
+        r.pod(b.centre);
+        r.pod(b.yaw);
+        r.pod(b.base_y);
+        r.pod(b.spread);
+        r.pod(b.headcount);
+    }
+    r.vec(persons_);
+    r.vec(steps_);
+    r.vec(beds_);   r.vec(house_beds_);
+    r.vec(stoves_); r.vec(house_stoves_);
+    r.vec(seats_);  r.vec(house_seats_);
+    r.vec(sinks_);  r.vec(house_sinks_);
+    r.pod(house_cx0_); r.pod(house_cz0_);
+    r.pod(house_nx_);  r.pod(house_nz_);
+    r.vec(house_cell_first_);
+    r.vec(house_cell_items_);
+    r.pod(district_centre_);
+    if (!r.ok || r.p != r.end) return false;
+
+    // The hash says these are the bytes that were written; these say
+    // they were written by a build that lays the tables out the same
+    // way, which is what every index below is trusted on.
+    const size_t nh = houses_.size();
+    if (house_yaw_.size() != nh || house_scale_.size() != nh) return false;
+    for (const Person& p : persons_) {
+        if (p.house < 0 || size_t(p.house) >= nh ||
+            uint64_t(p.weekday.first) + p.weekday.count > steps_.size() ||
+            uint64_t(p.weekend.first) + p.weekend.count > steps_.size()) {
+            return false;
+        }
+    }
+    for (int gi : house_graph_) {
+        if (gi >= int(graphs_.size())) return false;
+    }
+    const uint64_t cells = uint64_t(std::max(house_nx_, 0)) *
+                           uint64_t(std::max(house_nz_, 0));
+    if (cells ? (house_cell_first_.size() != cells + 1 ||
+                 house_cell_first_.back() != house_cell_items_.size())
+              : !house_cell_first_.empty()) {
+        return false;
+    }
+    for (int hi : house_cell_items_) {
+        if (hi < 0 || size_t(hi) >= nh) return false;
+    }
+    return true;
+}
+
 bool CitizenSystem::loadIndoor(const std::string& path,
                                const std::vector<std::string>& house_node,
                                const std::vector<int>& house_node_idx) {
@@ -1712,16 +2119,12 @@ void CitizenSystem::harvestFurniture() {
         float best_d2 = kFurnitureBindR * kFurnitureBindR;
         for (int dz = -1; dz <= 1; ++dz) {
             for (int dx = -1; dx <= 1; ++dx) {
-                const uint64_t k =
-                    (uint64_t(uint32_t(cx + dx)) << 32) |
-                    uint32_t(cz + dz);
-                auto it = house_grid_.find(k);
-                if (it == house_grid_.end()) continue;
-                for (int hi : it->second) {
-                    const glm::vec3& h = houses_[size_t(hi)];
+                const auto [h0, h1] = housesInCell(cx + dx, cz + dz);
+                for (const int* it = h0; it != h1; ++it) {
+                    const glm::vec3& h = houses_[size_t(*it)];
                     const float ddx = h.x - p.x, ddz = h.z - p.z;
                     const float d2 = ddx * ddx + ddz * ddz;
-                    if (d2 < best_d2) { best_d2 = d2; best = hi; }
+                    if (d2 < best_d2) { best_d2 = d2; best = *it; }
                 }
             }
         }
@@ -1971,8 +2374,150 @@ glm::vec3 CitizenSystem::placePos(const Person& p, const Step& s,
             b.entrance.y + std::sin(th) * rr + jz * 0.1f * wob};
 }
 
-int CitizenSystem::currentStep(const std::vector<Step>& sched,
-                               float tod) const {
+CitizenSystem::ScheduleRef CitizenSystem::packSchedule(
+    const std::vector<Step>& steps) {
+    ScheduleRef r;
+    r.first = uint32_t(steps_.size());
+    r.count = uint32_t(steps.size());
+    steps_.insert(steps_.end(), steps.begin(), steps.end());
+    return r;
+}
+
+void CitizenSystem::resetSim() {
+    const size_t n = persons_.size();
+    sim_pos_.assign(n, glm::vec3(0.0f));
+    sim_flags_.assign(n, 0);
+    sim_yaw_.assign(n, 0.0f);
+    sim_phase_.assign(n, 0.0f);
+    sim_gesture_t_.assign(n, 0.0f);
+    sim_step_.assign(n, -1);
+    sim_nav_room_.assign(n, int16_t(-1));
+    person_grid_.clear();
+    wake_heap_.clear();
+    near_list_.clear();
+    near_prev_.clear();
+    ground_queue_.clear();
+    event_clock_ = -1.0f;
+    replan_ = true;
+}
+
+CitizenSystem::SimState CitizenSystem::loadSim(size_t i) const {
+    SimState a;
+    a.pos = sim_pos_[i];
+    a.yaw = sim_yaw_[i];
+    a.phase = sim_phase_[i];
+    a.gesture_t = sim_gesture_t_[i];
+    a.cur_step = sim_step_[i];
+    a.nav_room = sim_nav_room_[i];
+    a.walking = (sim_flags_[i] & kSimWalking) != 0;
+    a.inited = (sim_flags_[i] & kSimInited) != 0;
+    return a;
+}
+
+void CitizenSystem::storeSim(size_t i, const SimState& a) {
+    sim_pos_[i] = a.pos;
+    sim_yaw_[i] = a.yaw;
+    sim_phase_[i] = a.phase;
+    sim_gesture_t_[i] = a.gesture_t;
+    sim_step_[i] = a.cur_step;
+    sim_nav_room_[i] = a.nav_room;
+    sim_flags_[i] = uint8_t((sim_flags_[i] & ~(kSimInited | kSimWalking)) |
+                            (a.inited ? kSimInited : 0) |
+                            (a.walking ? kSimWalking : 0));
+}
+
+void CitizenSystem::queueGround(uint32_t i) {
+    if (sim_flags_[i] & kSimGroundQueued) return;
+    sim_flags_[i] |= kSimGroundQueued;
+    ground_queue_.push_back(i);
+}
+
+bool CitizenSystem::snapToSchedule(size_t i, float tod) {
+    const Person& p = persons_[i];
+    const StepSpan sched = scheduleOf(p);
+    const int cs = currentStep(sched, tod);
+    const Step home_step{};
+    const Step& st = cs >= 0 ? sched[cs] : home_step;
+    uint8_t& flags = sim_flags_[i];
+    if (!(flags & kSimInited)) {
+        flags |= kSimInited;
+        sim_yaw_[i] = h01(uint32_t(i), 77u) * 6.2831853f;
+    }
+    flags &= uint8_t(~kSimWalking);
+    if (cs == sim_step_[i] && glm::length(sim_pos_[i]) >= 1e-6f) {
+        return false;
+    }
+    sim_step_[i] = cs;
+    sim_gesture_t_[i] = 0.0f;
+    sim_pos_[i] = placePos(p, st, int(i));
+    return true;
+}
+
+float CitizenSystem::nextWake(const Person& p, float now) const {
+    const float tod = std::fmod(now, 1440.0f);
+    const StepSpan sched = scheduleOf(p);
+    // currentStep is the LAST step at or before tod, so the next one is
+    // strictly later; past the last, the day itself ends.
+    const size_t next = size_t(currentStep(sched, tod) + 1);
+    return (now - tod) + (next < sched.size() ? sched[next].minutes
+                                              : 1440.0f);
+}
+
+void CitizenSystem::replanAll(float tod) {
+    const size_t n = persons_.size();
+    wake_heap_.resize(n);
+    // Everyone outside the near ring onto the current step's anchor, and
+    // everyone's next wake — independent per person, so chunked.
+    runChunks(n, [&](size_t c, size_t i0, size_t i1) {
+        auto& snapped = tick_chunks_[c].snapped;
+        snapped.clear();
+        for (size_t i = i0; i < i1; ++i) {
+            if (!(sim_flags_[i] & kSimNear) && snapToSchedule(i, tod)) {
+                snapped.push_back(uint32_t(i));
+            }
+            wake_heap_[i] = {nextWake(persons_[i], clock_min_), uint32_t(i)};
+        }
+    });
+    std::make_heap(wake_heap_.begin(), wake_heap_.end(), wakeLater);
+    for (const TickChunk& ch : tick_chunks_) {
+        for (uint32_t i : ch.snapped) queueGround(i);
+    }
+    person_grid_.build(uint32_t(n), [&](uint32_t i, float& x, float& z) {
+        x = sim_pos_[i].x;
+        z = sim_pos_[i].z;
+    });
+    event_clock_ = clock_min_;
+    replan_ = false;
+}
+
+void CitizenSystem::planChunks(size_t n) {
+    // Below a few thousand people the whole tick is tens of
+    // microseconds and a pool hand-off costs more than it saves.
+    size_t chunks = 1;
+    if (n >= kParallelMinPersons) {
+        if (!tick_pool_) tick_pool_ = std::make_shared<helper::ThreadPool>();
+        // One chunk a worker — parallelFor hands out one contiguous
+        // range per thread anyway, so more would only add merge work.
+        chunks = std::min(tick_pool_->numThreads(), n / kMinChunkPersons);
+        chunks = std::max<size_t>(chunks, 1);
+    }
+    if (tick_chunks_.size() != chunks) tick_chunks_.resize(chunks);
+}
+
+void CitizenSystem::runChunks(
+    size_t n, const std::function<void(size_t, size_t, size_t)>& fn) {
+    const size_t chunks = tick_chunks_.size();
+    auto slice = [&](size_t c) {
+        fn(c, n * c / chunks, n * (c + 1) / chunks);
+    };
+    if (chunks <= 1 || !tick_pool_) {
+        for (size_t c = 0; c < chunks; ++c) slice(c);
+        return;
+    }
+    tick_pool_->parallelFor(chunks, slice);
+}
+
+int CitizenSystem::currentStep(const StepSpan& sched, float tod) const {
     int cur = -1;
     for (size_t i = 0; i < sched.size(); ++i) {
         if (sched[i].minutes <= tod) cur = int(i);
@@ -2028,126 +2573,184 @@ void CitizenSystem::update(float delta_t, const glm::vec3& camera_pos,
         std::min(kWalkTimeScale,
                  std::max(1.0f, kWalkTimeScale * clock_rate_));
 
-    if (sim_.size() != persons_.size()) sim_.resize(persons_.size());
+    if (sim_pos_.size() != persons_.size()) resetSim();
 
     // ── EVERYONE is simulated; only the NEAR ring pays per frame ─────
     // Inside kNearSimRadius: the full walk tick, every frame.  Beyond:
-    // the round-robin ring below snaps persons to their schedule
-    // anchors.  What does NOT scale at all is the terrain ground
-    // query, so that runs per frame only inside kGroundClampRadius and
-    // as its own slow ring (kFarClampPerFrame/frame) — a far
-    // commuter's height refreshes every couple of seconds, which at
-    // 700 m+ is beneath notice.
+    // the wake heap below snaps a person to their schedule anchor when
+    // their step ends, and nobody else is touched.  What does NOT scale
+    // at all is the terrain ground query, so that runs per frame only
+    // inside kGroundClampRadius, and out here only for persons who
+    // actually moved (ground_queue_, kFarClampPerFrame a frame).
+    //
+    // The near tick is split into contiguous slices of the ring and
+    // run on the pool: one person's tick reads only their own state
+    // and the load-time tables, so slices never touch each other.
     const size_t n = persons_.size();
     const float near2 = kNearSimRadius * kNearSimRadius;
-    size_t near_clamps = 0;
-    bool clamp_budget_hit = false;
-    // Rotating start so the budgeted clamp tier is fair over frames.
+    planChunks(n);
+    if (replan_ || clock_min_ < event_clock_) replanAll(tod);
+
+    // ── WHO IS IN THE NEAR RING ──────────────────────────────────────
+    // A grid query, in ring order from a rotating start so the budgeted
+    // clamp tier is fair over frames.
     const size_t near_start = n ? (near_clamp_cursor_ % n) : 0;
-    for (size_t k = 0; k < n; ++k) {
-        size_t i = near_start + k;
-        if (i >= n) i -= n;
-        SimState& a = sim_[i];
-        if (a.inited) {
-            const float dcx0 = a.pos.x - camera_pos.x;
-            const float dcz0 = a.pos.z - camera_pos.z;
-            if (dcx0 * dcx0 + dcz0 * dcz0 > near2) continue;
-        }
-        const Person& p = persons_[i];
-        const auto& sched = scheduleOf(p);
-        int cs = currentStep(sched, tod);
-        const Step home_step{};
-        const Step& st = cs >= 0 ? sched[cs] : home_step;
-        if (!a.inited) {
-            a.inited = true;
-            a.pos = placePos(p, st, int(i));
-            a.cur_step = cs;
-            a.yaw = h01(uint32_t(i), 77u) * 6.2831853f;
-        }
-        if (cs != a.cur_step) {
-            a.cur_step = cs;
-            a.gesture_t = 0.0f;
-        }
-        glm::vec3 target = placePos(p, st, int(i));
-        // ── INDOOR ROUTING ───────────────────────────────────────────
-        // Replace the destination with the next DOORWAY on the way to
-        // it while one is still needed.  Near tier only, and only when
-        // the map shipped a graph: without it this is a no-op and the
-        // walk is the straight line it always was.
-        if (!graphs_.empty()) {
-            const int nav_h = anchorHouse(p, st);
-            if (nav_h >= 0) {
-                glm::vec3 wp;
-                if (indoorWaypoint(nav_h, a.pos, target, a.nav_room, wp)) {
-                    target = wp;
+    near_prev_.swap(near_list_);
+    near_list_.clear();
+    person_grid_.forEachCandidate(
+        camera_pos.x, camera_pos.z, kNearSimRadius, [&](uint32_t i) {
+            const float dcx0 = sim_pos_[i].x - camera_pos.x;
+            const float dcz0 = sim_pos_[i].z - camera_pos.z;
+            if (dcx0 * dcx0 + dcz0 * dcz0 <= near2) near_list_.push_back(i);
+        });
+    std::sort(near_list_.begin(), near_list_.end());
+    std::rotate(near_list_.begin(),
+                std::lower_bound(near_list_.begin(), near_list_.end(),
+                                 uint32_t(near_start)),
+                near_list_.end());
+    for (uint32_t i : near_prev_) sim_flags_[i] &= uint8_t(~kSimNear);
+    for (uint32_t i : near_list_) sim_flags_[i] |= kSimNear;
+    // Left the ring: from here on they are a far person, so they get
+    // the far snap now — the walk stops where it stands unless the
+    // clock has jumped past their step since the last near tick — and
+    // one exact height query, since past kGroundClampRadius the walk
+    // only blended it between anchors.
+    for (uint32_t i : near_prev_) {
+        if (sim_flags_[i] & kSimNear) continue;
+        const glm::vec3 from = sim_pos_[i];
+        if (snapToSchedule(i, tod)) {
+            person_grid_.move(i, from.x, from.z, sim_pos_[i].x, sim_pos_[i].z);
+        }
+        queueGround(i);
+    }
+
+    const bool want_clamp = bool(ground_);
+    runChunks(near_list_.size(), [&](size_t c, size_t k0, size_t k1) {
+        TickChunk& ch = tick_chunks_[c];
+        ch.clamp.clear();
+        ch.moved.clear();
+        for (size_t k = k0; k < k1; ++k) {
+            const size_t i = near_list_[k];
+            SimState a = loadSim(i);
+            const glm::vec2 from(a.pos.x, a.pos.z);
+            const Person& p = persons_[i];
+            const StepSpan sched = scheduleOf(p);
+            int cs = currentStep(sched, tod);
+            const Step home_step{};
+            const Step& st = cs >= 0 ? sched[cs] : home_step;
+            if (!a.inited) {
+                a.inited = true;
+                a.pos = placePos(p, st, int(i));
+                a.cur_step = cs;
+                a.yaw = h01(uint32_t(i), 77u) * 6.2831853f;
+            }
+            if (cs != a.cur_step) {
+                a.cur_step = cs;
+                a.gesture_t = 0.0f;
+            }
+            glm::vec3 target = placePos(p, st, int(i));
+            // ── INDOOR ROUTING ───────────────────────────────────────
+            // Replace the destination with the next DOORWAY on the way
+            // to it while one is still needed.  Near tier only, and
+            // only when the map shipped a graph: without it this is a
+            // no-op and the walk is the straight line it always was.
+            if (!graphs_.empty()) {
+                const int nav_h = anchorHouse(p, st);
+                if (nav_h >= 0) {
+                    glm::vec3 wp;
+                    if (indoorWaypoint(nav_h, a.pos, target, a.nav_room,
+                                       wp)) {
+                        target = wp;
+                    }
+                } else {
+                    a.nav_room = -1;     // outdoors — no route room to hold
                 }
-            } else {
-                a.nav_room = -1;         // outdoors — no route room to hold
             }
-        }
-        glm::vec3 d = target - a.pos;
-        d.y = 0.0f;
-        float dist = glm::length(d);
-        a.walking = dist > 0.6f;
-        if (a.walking) {
-            glm::vec3 dir = d / dist;
-            // Walk AROUND the neighbours' houses rather than through
-            // them.  Near tier only: this is the tier that actually
-            // interpolates a walk, and the only one anybody can see.
-            //
-            // Only while EN ROUTE.  On the final approach the target
-            // itself is usually inside a building — their workplace,
-            // or an outdoors spot that happens to sit in a neighbour's
-            // footprint — and steering away from it there would have
-            // them orbit it forever, never arriving and never leaving
-            // the walk pose.  Inside the last few metres, go straight.
-            if (dist > kHouseBlockR + 3.0f) {
-                const glm::vec2 sd = steerAroundHouses(
-                    glm::vec2(a.pos.x, a.pos.z),
-                    glm::vec2(dir.x, dir.z),
-                    p.house, st.place);
-                dir.x = sd.x;
-                dir.z = sd.y;
+            glm::vec3 d = target - a.pos;
+            d.y = 0.0f;
+            float dist = glm::length(d);
+            a.walking = dist > 0.6f;
+            if (a.walking) {
+                glm::vec3 dir = d / dist;
+                // Walk AROUND the neighbours' houses rather than through
+                // them.  Near tier only: this is the tier that actually
+                // interpolates a walk, and the only one anybody can see.
+                //
+                // Only while EN ROUTE.  On the final approach the target
+                // itself is usually inside a building — their
+                // workplace, or an outdoors spot that happens to sit in
+                // a neighbour's footprint — and steering away from it
+                // there would have them orbit it forever, never
+                // arriving and never leaving the walk pose.  Inside the
+                // last few metres, go straight.
+                if (dist > kHouseBlockR + 3.0f) {
+                    const glm::vec2 sd = steerAroundHouses(
+                        glm::vec2(a.pos.x, a.pos.z),
+                        glm::vec2(dir.x, dir.z),
+                        p.house, st.place);
+                    dir.x = sd.x;
+                    dir.z = sd.y;
+                }
+                const float v = p.speed * walk_scale;
+                a.pos += dir * std::min(v * delta_t, dist) * 1.0f;
+                a.yaw = std::atan2(dir.x, dir.z);
+                a.phase += delta_t * v * 1.7f;
+                // walking between anchors: carry Y by blending the two
+                // endpoints' base heights so far commuters don't
+                // tunnel; the ground clamp below refines it when it is
+                // their turn
+                a.pos.y += (target.y - a.pos.y) *
+                           std::min(1.0f, p.speed * delta_t /
+                                              std::max(dist, 1e-3f));
+            } else if (dist < 0.9f && a.gesture_t < 1.2f &&
+                       st.place == -1) {
+                a.gesture_t += delta_t;  // door-open pause at home
             }
-            const float v = p.speed * walk_scale;
-            a.pos += dir * std::min(v * delta_t, dist) * 1.0f;
-            a.yaw = std::atan2(dir.x, dir.z);
-            a.phase += delta_t * v * 1.7f;
-            // walking between anchors: carry Y by blending the two
-            // endpoints' base heights so far commuters don't tunnel;
-            // the ground clamp below refines it when it is their turn
-            a.pos.y += (target.y - a.pos.y) *
-                       std::min(1.0f, p.speed * delta_t /
-                                          std::max(dist, 1e-3f));
-        } else if (dist < 0.9f && a.gesture_t < 1.2f &&
-                   st.place == -1) {
-            a.gesture_t += delta_t;    // door-open pause at home
-        }
-        // near-camera: exact terrain clamp — unconditional up close,
-        // budgeted + round-robin out to kGroundClampRadius (see
-        // kAlwaysClampR / kNearClampPerFrame).
-        if (ground_) {
-            const float dcx = a.pos.x - camera_pos.x;
-            const float dcz = a.pos.z - camera_pos.z;
-            const float dc2 = dcx * dcx + dcz * dcz;
-            const bool always = dc2 < kAlwaysClampR * kAlwaysClampR;
-            if (dc2 < kGroundClampRadius * kGroundClampRadius &&
-                (always || !clamp_budget_hit)) {
-                float gy;
-                glm::vec3 gn;
+            storeSim(i, a);
+            if (a.pos.x != from.x || a.pos.z != from.y) {
+                ch.moved.emplace_back(uint32_t(i), from);
+            }
+            // Terrain clamp candidate, applied below in ring order.
+            if (want_clamp) {
+                const float dcx = a.pos.x - camera_pos.x;
+                const float dcz = a.pos.z - camera_pos.z;
+                const float dc2 = dcx * dcx + dcz * dcz;
+                if (dc2 < kGroundClampRadius * kGroundClampRadius) {
+                    ch.clamp.emplace_back(
+                        uint32_t(i),
+                        uint8_t(dc2 < kAlwaysClampR * kAlwaysClampR));
+                }
+            }
+        }
+    });
+    // near-camera: exact terrain clamp — unconditional up close,
+    // budgeted + round-robin out to kGroundClampRadius (see
+    // kAlwaysClampR / kNearClampPerFrame).  On this thread: the ground
+    // query is the terrain's, and nothing says it is re-entrant.  The
+    // chunks hand their candidates over in ring order, so the budget
+    // and the cursor below land exactly where a serial walk put them.
+    size_t near_clamps = 0;
+    bool clamp_budget_hit = false;
+    if (want_clamp) {
+        for (const TickChunk& ch : tick_chunks_) {
+            for (const auto& [i, always] : ch.clamp) {
+                if (!always && clamp_budget_hit) continue;
                 if (!always && ++near_clamps >= kNearClampPerFrame) {
                     // Resume HERE next frame.  The cursor advances by
                     // CANDIDATES CONSUMED, not by a fixed index
                     // stride: strided, the served window would slide
                     // by budget * |candidates| / population per frame
                     // and a 400 m ring would take ~150 frames to come
-                    // round — slower than the blanket far ring below,
-                    // which would make this whole tier pointless.
+                    // round — slower than a blanket ring over the whole
+                    // town, which would make this tier pointless.
                     clamp_budget_hit = true;
-                    near_clamp_cursor_ = i + 1;
+                    near_clamp_cursor_ = size_t(i) + 1;
                 }
-                if (ground_(a.pos.x, a.pos.z, a.pos.y + 1.0f, gy, gn)) {
-                    a.pos.y = gy;
+                glm::vec3& pos = sim_pos_[i];
+                float gy;
+                glm::vec3 gn;
+                if (ground_(pos.x, pos.z, pos.y + 1.0f, gy, gn)) {
+                    pos.y = gy;
                 }
             }
         }
@@ -2155,68 +2758,88 @@ void CitizenSystem::update(float delta_t, const glm::vec3& camera_pos,
     // Budget never bound: everyone in the ring was clamped this frame,
     // so there is nothing to resume from.
     if (!clamp_budget_hit) near_clamp_cursor_ = 0;
-    // far persons: staggered schedule ring.  Each visit snaps the
-    // person to their CURRENT step's anchor — no walking interpolation
-    // out here (a lerp nobody can resolve is a lerp nobody pays for).
-    // With kFarSimPerFrame per frame a 150k-person town fully
-    // refreshes in ~20 frames — well inside one game-minute tick.
-    if (n) {
-        for (size_t k = 0; k < kFarSimPerFrame; ++k) {
-            const size_t i = (sim_cursor_ + k) % n;
-            SimState& a = sim_[i];
-            if (a.inited) {
-                const float dcx = a.pos.x - camera_pos.x;
-                const float dcz = a.pos.z - camera_pos.z;
-                if (dcx * dcx + dcz * dcz <= near2) continue;
-            }
-            const Person& p = persons_[i];
-            const auto& sched = scheduleOf(p);
-            const int cs = currentStep(sched, tod);
-            const Step home_step{};
-            const Step& st = cs >= 0 ? sched[cs] : home_step;
-            if (!a.inited) {
-                a.inited = true;
-                a.yaw = h01(uint32_t(i), 77u) * 6.2831853f;
-            }
-            if (cs != a.cur_step || glm::length(a.pos) < 1e-6f) {
-                a.cur_step = cs;
-                a.gesture_t = 0.0f;
-                a.pos = placePos(p, st, int(i));
+    // The grid follows the walkers (serially: it is one structure).
+    for (const TickChunk& ch : tick_chunks_) {
+        for (const auto& [i, from] : ch.moved) {
+            person_grid_.move(i, from.x, from.y, sim_pos_[i].x, sim_pos_[i].z);
+        }
+    }
+
+    // ── FAR PERSONS: only those whose step just ended ───────────────
+    // Each is snapped to their CURRENT step's anchor — no walking
+    // interpolation out here (a lerp nobody can resolve is a lerp
+    // nobody pays for) — and re-filed for the end of that step.  A near
+    // person's entry is just re-filed: the near tick walks them.  Pops
+    // first, pushes after, so an entry due again this frame (float
+    // rounding at a step edge) waits for the next.
+    woken_.clear();
+    while (!wake_heap_.empty() && wake_heap_.front().first <= clock_min_) {
+        std::pop_heap(wake_heap_.begin(), wake_heap_.end(), wakeLater);
+        woken_.push_back(wake_heap_.back().second);
+        wake_heap_.pop_back();
+    }
+    for (uint32_t i : woken_) {
+        if (!(sim_flags_[i] & kSimNear)) {
+            const glm::vec3 from = sim_pos_[i];
+            if (snapToSchedule(i, tod)) {
+                person_grid_.move(i, from.x, from.z,
+                                  sim_pos_[i].x, sim_pos_[i].z);
+                queueGround(i);
             }
-            a.walking = false;
         }
-        sim_cursor_ = (sim_cursor_ + kFarSimPerFrame) % n;
+        wake_heap_.emplace_back(nextWake(persons_[i], clock_min_), i);
+        std::push_heap(wake_heap_.begin(), wake_heap_.end(), wakeLater);
     }
-    // far persons: staggered ground refresh ring
-    if (ground_ && n) {
-        for (size_t k = 0; k < kFarClampPerFrame; ++k) {
-            const size_t i = (clamp_cursor_ + k) % n;
-            SimState& a = sim_[i];
+    event_clock_ = clock_min_;
+    // far persons: height refresh for whoever moved.  A miss (terrain
+    // not streamed in under them yet) goes to the back of the queue.
+    if (ground_) {
+        for (size_t k = 0; k < kFarClampPerFrame && !ground_queue_.empty();
+             ++k) {
+            const uint32_t i = ground_queue_.front();
+            ground_queue_.pop_front();
+            sim_flags_[i] &= uint8_t(~kSimGroundQueued);
+            glm::vec3& pos = sim_pos_[i];
             float gy;
             glm::vec3 gn;
-            if (a.inited &&
-                ground_(a.pos.x, a.pos.z, a.pos.y + 2.0f, gy, gn)) {
-                a.pos.y = gy;
+            if (ground_(pos.x, pos.z, pos.y + 2.0f, gy, gn)) {
+                pos.y = gy;
+            } else {
+                queueGround(i);
             }
         }
-        clamp_cursor_ = (clamp_cursor_ + kFarClampPerFrame) % n;
     }
 
     // ── RENDER TIERS ─────────────────────────────────────────────────
     // Everyone inside kShowRadius emits; the nearest kMaxDetailed
     // inside kDetailRadius get the full articulated figure, the rest a
     // single person-box (or nothing once they fall under kMinAngular).
+    // Chunked like the tick: detail candidates and parts are gathered
+    // per chunk and concatenated in person order.
+    // GPU expansion packs records instead of parts (see the emission
+    // below); the CPU path expands every part here.
+    const bool records = gpu_expand_ && s_crowd_pipeline_;
     frame_parts_.clear();
+    if (!records) frame_records_.clear();
+    frame_detailed_ = 0;
+    frame_far_ = 0;
     std::vector<std::pair<float, int>>& near_ids = near_ids_;
     near_ids.clear();
-    for (size_t i = 0; i < n; ++i) {
-        if (!sim_[i].inited) continue;
-        const float dx = sim_[i].pos.x - camera_pos.x;
-        const float dz = sim_[i].pos.z - camera_pos.z;
-        const float d2 = dx * dx + dz * dz;
-        if (d2 < kDetailRadius * kDetailRadius) {
-            near_ids.emplace_back(d2, int(i));
+    runChunks(n, [&](size_t c, size_t i0, size_t i1) {
+        auto& out = tick_chunks_[c].near;
+        out.clear();
+        for (size_t i = i0; i < i1; ++i) {
+            if (!(sim_flags_[i] & kSimInited)) continue;
+            const float dx = sim_pos_[i].x - camera_pos.x;
+            const float dz = sim_pos_[i].z - camera_pos.z;
+            const float d2 = dx * dx + dz * dz;
+            if (d2 < kDetailRadius * kDetailRadius) {
+                out.emplace_back(d2, int(i));
+            }
         }
+    });
+    for (const TickChunk& ch : tick_chunks_) {
+        near_ids.insert(near_ids.end(), ch.near.begin(), ch.near.end());
     }
     size_t keep = std::min(near_ids.size(), kMaxDetailed);
     std::partial_sort(near_ids.begin(), near_ids.begin() + keep,
@@ -2227,24 +2850,111 @@ void CitizenSystem::update(float delta_t, const glm::vec3& camera_pos,
     for (const auto& [d2, i] : near_ids) is_detailed[i] = 1;
 
     if (far_thresh_ < kMinAngular) far_thresh_ = kMinAngular;
+    // Which far persons pass the angular cutoff.  Detailed ones return
+    // false: they always emit, outside the far cap.
+    auto farVisible = [&](size_t i, float d2) {
+        if (is_detailed[i]) return false;
+        const float dist = std::sqrt(std::max(d2, 1.0f));
+        return persons_[i].height / dist >= far_thresh_;
+    };
+    auto showD2 = [&](size_t i) {
+        const float dx = sim_pos_[i].x - camera_pos.x;
+        const float dz = sim_pos_[i].z - camera_pos.z;
+        return dx * dx + dz * dz;
+    };
+    // The hard ceiling goes to the FIRST eligible persons in index
+    // order, so count per chunk first and share the ceiling out in
+    // chunk order before anyone emits.
+    runChunks(n, [&](size_t c, size_t i0, size_t i1) {
+        size_t eligible = 0;
+        for (size_t i = i0; i < i1; ++i) {
+            if (!(sim_flags_[i] & kSimInited)) continue;
+            const float d2 = showD2(i);
+            if (d2 > kShowRadius * kShowRadius) continue;
+            eligible += farVisible(i, d2);
+        }
+        tick_chunks_[c].far_eligible = eligible;
+    });
+    // hard ceiling so the first frame at a new vantage cannot
+    // burst-draw the whole town before the controller reacts
+    const size_t far_cap = kMaxFarParts + kMaxFarParts / 2;
     size_t far_emitted = 0;
-    for (size_t i = 0; i < n; ++i) {
-        if (!sim_[i].inited) continue;
-        const float dx = sim_[i].pos.x - camera_pos.x;
-        const float dz = sim_[i].pos.z - camera_pos.z;
-        const float d2 = dx * dx + dz * dz;
-        if (d2 > kShowRadius * kShowRadius) continue;
-        if (is_detailed[i]) {
-            emitPerson(int(i), sim_[i], persons_[i], true);
-        } else {
-            const float dist = std::sqrt(std::max(d2, 1.0f));
-            if (persons_[i].height / dist < far_thresh_) continue;
-            // hard ceiling so the first frame at a new vantage cannot
-            // burst-draw the whole town before the controller reacts
-            if (far_emitted >= kMaxFarParts + kMaxFarParts / 2) continue;
-            ++far_emitted;
-            emitPerson(int(i), sim_[i], persons_[i], false);
+    for (TickChunk& ch : tick_chunks_) {
+        ch.far_allowed = std::min(ch.far_eligible, far_cap - far_emitted);
+        far_emitted += ch.far_allowed;
+    }
+    // ── THE RECORD LAYOUT ───────────────────────────────────────────
+    // Records are laid out for the upload diff, not for compactness:
+    // far slot i is person i's, every frame — a far-tier record when
+    // they are drawn as one, the constant hidden record otherwise —
+    // and the detailed figures follow the n slots.  So a person who
+    // did not move writes the same bytes into the same place, and a
+    // face leaving the far tier does not shift everyone behind it.
+    // The hidden slots cost the far draw a degenerate box each.
+    if (records) frame_records_.resize(n);
+    runChunks(n, [&](size_t c, size_t i0, size_t i1) {
+        TickChunk& ch = tick_chunks_[c];
+        ch.parts.clear();
+        ch.near_recs.clear();
+        size_t allowed = ch.far_allowed;
+        for (size_t i = i0; i < i1; ++i) {
+            bool show = false;
+            const bool detailed = is_detailed[i] != 0;
+            if ((sim_flags_[i] & kSimInited)) {
+                const float d2 = showD2(i);
+                if (d2 <= kShowRadius * kShowRadius) {
+                    show = detailed || (allowed && farVisible(i, d2));
+                    if (show && !detailed) --allowed;
+                }
+            }
+            if (!records) {
+                if (show) {
+                    emitPerson(int(i), loadSim(i), persons_[i], detailed,
+                               ch.parts);
+                }
+                continue;
+            }
+            CitizenRecord& slot = frame_records_[i];
+            if (!show || detailed) {
+                slot = CitizenRecord{};
+                slot.bits = kCitizenHidden;
+            } else {
+                slot = packPerson(int(i), loadSim(i), persons_[i], false);
+            }
+            if (show && detailed) {
+                ch.near_recs.push_back(
+                    packPerson(int(i), loadSim(i), persons_[i], true));
+            }
+        }
+    });
+    // Concatenate: every chunk copies into its own slice of the frame.
+    if (records) {
+        size_t total = n;
+        for (TickChunk& ch : tick_chunks_) {
+            ch.first_near = total;
+            total += ch.near_recs.size();
+        }
+        frame_records_.resize(total);
+        frame_detailed_ = total - n;
+        frame_far_ = far_emitted;
+        for (const TickChunk& ch : tick_chunks_) {
+            std::copy(ch.near_recs.begin(), ch.near_recs.end(),
+                      frame_records_.begin() + ptrdiff_t(ch.first_near));
+        }
+    } else {
+        size_t total = 0;
+        for (TickChunk& ch : tick_chunks_) {
+            ch.first_part = total;
+            total += ch.parts.size();
         }
+        frame_parts_.resize(total);
+        runChunks(tick_chunks_.size(), [&](size_t, size_t c0, size_t c1) {
+            for (size_t c = c0; c < c1; ++c) {
+                const TickChunk& ch = tick_chunks_[c];
+                std::copy(ch.parts.begin(), ch.parts.end(),
+                          frame_parts_.begin() + ptrdiff_t(ch.first_part));
+            }
+        });
     }
     // Far-tier draw budget: a whole town in frame is >100k one-box
     // persons — more push-constant draws than the pass can afford.
@@ -2273,10 +2983,10 @@ void CitizenSystem::update(float delta_t, const glm::vec3& camera_pos,
         float best_d2 = std::numeric_limits<float>::max();
         int best_i = -1;
         for (size_t i = 0; i < n; ++i) {
-            if (!sim_[i].inited) continue;
+            if (!(sim_flags_[i] & kSimInited)) continue;
             ++n_init;
-            const float dx = sim_[i].pos.x - camera_pos.x;
-            const float dz = sim_[i].pos.z - camera_pos.z;
+            const float dx = sim_pos_[i].x - camera_pos.x;
+            const float dz = sim_pos_[i].z - camera_pos.z;
             const float d2 = dx * dx + dz * dz;
             if (d2 < kDetailRadius * kDetailRadius) ++in_detail;
             if (d2 < kNearSimRadius * kNearSimRadius) ++in_near;
@@ -2295,15 +3005,20 @@ void CitizenSystem::update(float delta_t, const glm::vec3& camera_pos,
                   << " | <300m " << in_detail
                   << "  <700m " << in_near
                   << "  <10km " << in_show
-                  << " | drawn parts " << frame_parts_.size()
-                  << " (far_thresh " << far_thresh_ << ")";
+                  << " | drawn parts "
+                  << (frame_parts_.size() + frame_detailed_ * kCitizenParts +
+                      frame_far_)
+                  << " (far_thresh " << far_thresh_ << ")"
+                  << (frame_records_.empty() ? " cpu" : " gpu")
+                  << ", last upload " << s_upload_written_ / 1024 << " KiB";
         if (best_i >= 0) {
             std::cout << " | nearest #" << best_i << " at ("
-                      << int(sim_[best_i].pos.x) << ", "
-                      << int(sim_[best_i].pos.y) << ", "
-                      << int(sim_[best_i].pos.z) << ") d="
+                      << int(sim_pos_[best_i].x) << ", "
+                      << int(sim_pos_[best_i].y) << ", "
+                      << int(sim_pos_[best_i].z) << ") d="
                       << int(std::sqrt(best_d2)) << "m"
-                      << (sim_[best_i].walking ? " walking" : " idle");
+                      << ((sim_flags_[best_i] & kSimWalking) ? " walking"
+                                                             : " idle");
         }
         std::cout << " | cam (" << int(camera_pos.x) << ", "
                   << int(camera_pos.z) << ") district "
@@ -2336,27 +3051,26 @@ void CitizenSystem::update(float delta_t, const glm::vec3& camera_pos,
     }
 }
 
-void CitizenSystem::emitPerson(int pid_i, const SimState& a,
-                               const Person& p, bool detailed) {
+CitizenRecord CitizenSystem::packPerson(int pid_i, const SimState& a,
+                                        const Person& p,
+                                        bool detailed) const {
+    CitizenPose pose;
+    pose.root = a.pos;
+    pose.yaw = a.yaw;
+    pose.phase = a.phase;
+    pose.act = a.walking ? kActWalk : kActIdle;
+    pose.duty = p.duty;
+    pose.detailed = detailed;
+    pose.height = p.height;
+    pose.bulk = p.bulk;
     if (!detailed) {
-        // FAR TIER: one box, person-sized, duty-tinted — a figure at a
-        // distance, not a puppet.  Slight walk bob keeps crowds alive.
-        const float s = p.height / 1.75f;
-        float bob = a.walking
-                        ? std::abs(std::cos(a.phase)) * 0.03f * s : 0.0f;
-        glm::mat4 M =
-            glm::translate(glm::mat4(1.0f),
-                           {a.pos.x, a.pos.y + bob, a.pos.z}) *
-            glm::rotate(glm::mat4(1.0f), a.yaw, glm::vec3(0, 1, 0)) *
-            glm::translate(glm::mat4(1.0f), {0.0f, 0.875f * s, 0.0f}) *
-            glm::scale(glm::mat4(1.0f),
-                       {0.20f * s * p.bulk, 0.875f * s,
-                        0.13f * s * p.bulk});
-        frame_parts_.push_back({M, glm::vec4(dutyColor(p.duty), 0.12f)});
-        return;
+        // FAR TIER: the person-box needs no activity and no pose clock,
+        // only the bob.
+        return packCitizen(pose);
     }
+    pose.seed = citizenSeed(uint32_t(pid_i));
 
-    const auto& sched = scheduleOf(p);
+    const StepSpan sched = scheduleOf(p);
     const Step home_step{};
     const Step& st = a.cur_step >= 0 ? sched[a.cur_step] : home_step;
     // resolveActivity carries the night rule, and it is the SAME call
@@ -2370,6 +3084,13 @@ void CitizenSystem::emitPerson(int pid_i, const SimState& a,
         a.gesture_t < 1.2f && st.place == -1) {
         act = kActBrowse;              // arm-forward: opening the door
     }
+    pose.act = act;
+    // Cook and play arms were always offset by the person id itself
+    // rather than the seed.  Someone standing at a stove has no walk
+    // phase, so the offset travels in that field.
+    if (act == kActCook || act == kActPlay) {
+        pose.phase = float(pid_i);
+    }
 
     // ── ON THE FURNITURE ─────────────────────────────────────────────
     // At home, the anchor carries both the spot and the FACING: a bed
@@ -2379,178 +3100,103 @@ void CitizenSystem::emitPerson(int pid_i, const SimState& a,
     // rewrites y every frame, and neither of those belongs on a
     // mattress.  Costs one array index, and only for the few hundred
     // figures the detail tier draws.
-    glm::vec3 body_pos = a.pos;
-    float     body_yaw = a.yaw;
-    bool      lying    = false;
-    bool      seated   = false;
     if (!a.walking) {
         const Anchor an = furnitureAnchor(p, st, act);
         if (an.kind != kAnchorNone) {
-            body_pos = an.pos;
-            body_yaw = an.yaw;
-            lying    = (an.kind == kAnchorBed);
-            seated   = (an.kind == kAnchorSeat);
-        }
-    }
-
-    const float s = p.height / 1.75f;
-    const float bw = p.bulk;
-    glm::vec4 col(dutyColor(p.duty), 0.12f);
-
-    const float swing = std::sin(a.phase);
-    // Per-person offset on the shared real-time pose clock, so two
-    // neighbours standing in the same doorway are not one puppet
-    // mirrored.  0.7315 is just an irrational-ish stride through the
-    // id space; the offset is scaled by each frequency below, which
-    // keeps the 8*pi wrap seamless for every half-integer rate.
-    const float anim_phase = anim_t_ + float(pid_i) * 0.7315f;
-    float root_y = body_pos.y;
-    float torso_pitch = 0.0f;
-    float leg_l = -0.0f, leg_r = 0.0f, arm_l = 0.0f, arm_r = 0.0f;
-    bool sitting = false;
-    switch (act) {
-    case kActWalk:
-        leg_l = swing * 0.55f;
-        leg_r = -swing * 0.55f;
-        arm_l = -swing * 0.45f;
-        arm_r = swing * 0.45f;
-        root_y += std::abs(std::cos(a.phase)) * 0.03f * s;
-        break;
-    case kActSleepish:
-        if (lying) {
-            // LYING DOWN.  R below is rotY(yaw) * rotX(pitch) applied
-            // about the ROOT, which sits between the feet — so a
-            // quarter turn of pitch tips the whole figure flat, on its
-            // back, extending from the root toward its head.
-            // furnitureAnchor put the root at the foot of the mattress
-            // exactly this reason.  Limbs stay straight; the shared
-            // breath below is the only motion.
-            torso_pitch = -1.5707963f;
-            arm_l = arm_r = 0.0f;
-            leg_l = leg_r = 0.0f;
-            // The quarter turn also stands the torso's DEPTH on end:
-            // local +Z (half-extent 0.11) becomes world up, so the
-            // body's centreline has to rise by that much or half the
-            // sleeper is inside the mattress.
-            root_y += 0.12f * s;
-        } else {
-            // No bed in this house — dozing upright, the old behaviour.
-            arm_l = arm_r = 0.04f * std::sin(anim_phase * 0.5f);
+            pose.root   = an.pos;
+            pose.yaw    = an.yaw;
+            pose.lying  = (an.kind == kAnchorBed);
+            pose.seated = (an.kind == kAnchorSeat);
         }
-        break;
-    case kActSit:
-    case kActDeskWork:
-        if (seated) {
-            sitting = true;
-            leg_l = leg_r = -1.45f;    // thighs forward
-            arm_l = arm_r = act == kActDeskWork ? -0.9f : -0.4f;
-        } else {
-            // NOTHING TO SIT ON.  The pose used to be unconditional, so
-            // a person whose room had no free chair — or none at all —
-            // was drawn folded into a sitting shape in mid-air, which
-            // is the single most conspicuous thing this system did.  A
-            // figure standing where it should be sitting is a modelling
-            // shortfall; a figure sitting on nothing is a bug, and only
-            // one of the two reads as a mistake.
-            arm_l = arm_r = 0.10f * std::sin(anim_phase * 0.5f);
+    }
+    return packCitizen(pose);
+}
+
+void CitizenSystem::emitPerson(int pid_i, const SimState& a,
+                               const Person& p, bool detailed,
+                               std::vector<PartInstance>& out) const {
+    const size_t at = out.size();
+    out.resize(at + (detailed ? kCitizenParts : 1));
+    expandCitizen(packPerson(pid_i, a, p, detailed), anim_t_, &out[at]);
+}
+
+CitizenSystem::UploadSlot* CitizenSystem::uploadInstances(const void* data,
+                                                          size_t count,
+                                                          size_t stride) {
+    const size_t bytes = count * stride;
+    UploadSlot& slot = s_upload_[s_upload_frame_++ % kUploadSlots];
+    // Grown in powers of two and never shrunk: the crowd in view swings
+    // frame to frame as the camera turns, and reallocating a
+    // multi-megabyte buffer on every swing would cost more than the
+    // headroom it reclaims.  HOST_VISIBLE | HOST_COHERENT so the fill
+    // is a memcpy with no staging copy and no barrier.  This slot was
+    // last drawn from kUploadSlots frames ago, which the frame fences
+    // have retired, so rewriting or replacing it is safe.
+    if (!slot.buf || bytes > slot.capacity) {
+        size_t cap = slot.capacity ? slot.capacity : size_t(256) * 1024;
+        while (cap < bytes) cap *= 2;
+        if (slot.buf) {
+            if (slot.mapped) s_device_->unmapMemory(slot.buf->memory);
+            slot.buf->destroy(s_device_);
         }
-        break;
-    case kActCook:
-        arm_r = -1.1f + 0.25f * std::sin(anim_t_ * 4.0f +
-                                         float(pid_i));
-        arm_l = -0.5f;
-        torso_pitch = 0.12f;
-        break;
-    case kActBrowse:
-        arm_r = -0.9f;
-        torso_pitch = 0.08f;
-        break;
-    case kActWash:
-        // Washing up: both hands down in the basin, a slight lean over
-        // it, and a small scrub off the real-time pose clock.  TWO arms
-        // rather than the cook's one is the whole read — from behind,
-        // one arm out is stirring and two is washing.
-        arm_l = -1.15f + 0.10f * std::sin(anim_phase * 3.0f);
-        arm_r = -1.15f - 0.10f * std::sin(anim_phase * 3.0f);
-        torso_pitch = 0.15f;
-        break;
-    case kActCare:
-        // rounds: slow sway + attending arm
-        arm_l = -0.7f + 0.2f * std::sin(anim_phase * 2.0f);
-        torso_pitch = 0.16f;
-        break;
-    case kActPlay:
-        arm_l = std::sin(anim_t_ * 5.0f + float(pid_i)) * 0.8f;
-        arm_r = -std::sin(anim_t_ * 5.0f + float(pid_i)) * 0.8f;
-        break;
-    default: {
-        // STANDING IDLE.  A 0.06 rad arm sway was the whole of it, and
-        // on a box figure that is a 3 cm displacement nobody reads as
-        // motion — hence "they don't move at all" even when the sim is
-        // ticking.  Give it a slow weight shift instead, at an
-        // amplitude that survives being seen from ten metres.
-        arm_l = arm_r = 0.10f * std::sin(anim_phase * 0.5f);
-        break;
+        slot = UploadSlot{};
+        slot.buf = std::make_shared<er::BufferInfo>();
+        er::Helper::createBuffer(
+            s_device_,
+            SET_2_FLAG_BITS(BufferUsage, VERTEX_BUFFER_BIT,
+                            TRANSFER_DST_BIT),
+            SET_2_FLAG_BITS(MemoryProperty, HOST_VISIBLE_BIT,
+                            HOST_COHERENT_BIT),
+            0,
+            slot.buf->buffer,
+            slot.buf->memory,
+            std::source_location::current(),
+            uint64_t(cap),
+            nullptr);
+        slot.mapped = static_cast<uint8_t*>(
+            s_device_->mapMemory(slot.buf->memory, uint64_t(cap), 0));
+        if (!slot.mapped) {
+            slot.buf->destroy(s_device_);
+            slot = UploadSlot{};
+            return nullptr;
+        }
+        slot.capacity = cap;
+        std::cout << "[citizen] instance buffer " << (&slot - s_upload_)
+                  << " -> " << cap / 1024 << " KiB" << std::endl;
     }
+    // Write what changed since this slot was last filled, element by
+    // element, each run of changed elements as one copy.  Elements, not
+    // pages: the people who move in a frame are a few percent of the
+    // town but scattered through it, so nearly every page holds one.
+    // The compare runs on cached memory; the mapping is write-combined,
+    // where every byte not written is the saving.
+    const auto* src = static_cast<const uint8_t*>(data);
+    const size_t old = std::min(slot.shadow.size(), bytes);
+    slot.shadow.resize(bytes);
+    uint8_t* shadow = slot.shadow.data();
+    size_t written = 0;
+    for (size_t e = 0; e < count;) {
+        const size_t at = e * stride;
+        if (at + stride <= old &&
+            std::memcmp(shadow + at, src + at, stride) == 0) {
+            ++e;
+            continue;
+        }
+        size_t end = e + 1;
+        while (end < count &&
+               !(end * stride + stride <= old &&
+                 std::memcmp(shadow + end * stride, src + end * stride,
+                             stride) == 0)) {
+            ++end;
+        }
+        const size_t len = (end - e) * stride;
+        std::memcpy(slot.mapped + at, src + at, len);
+        std::memcpy(shadow + at, src + at, len);
+        written += len;
+        e = end;
     }
-    // Everyone who is not WALKING still breathes: a small torso pitch
-    // and root rise, ~14 cycles a minute, desynchronized per person so
-    // a street does not inhale in unison.  Without it a seated desk
-    // worker, a browsing shopper and a sleeper are all mannequins —
-    // the walk cycle was the only motion this system had.
-    if (act != kActWalk) {
-        const float br = std::sin(anim_phase * 1.5f);
-        // A sleeper's breath is the RISE only: adding it to the pitch
-        // would rock a flat body end over end about its feet, which at
-        // 1.7 m of lever arm is a visible see-saw rather than a breath.
-        if (!lying) torso_pitch += 0.015f * br;
-        root_y += 0.008f * s * br;
-    }
-    if (sitting) root_y -= 0.42f * s;
-
-    const glm::mat4 R =
-        glm::rotate(glm::mat4(1.0f), body_yaw, glm::vec3(0, 1, 0)) *
-        glm::rotate(glm::mat4(1.0f), torso_pitch, glm::vec3(1, 0, 0));
-    auto part = [&](glm::vec3 centre, glm::vec3 half, float pivot_rot,
-                    glm::vec3 pivot) {
-        glm::mat4 M = glm::translate(glm::mat4(1.0f),
-                                     glm::vec3(body_pos.x, root_y,
-                                               body_pos.z)) * R;
-        if (pivot_rot != 0.0f) {
-            M = M * glm::translate(glm::mat4(1.0f), pivot) *
-                glm::rotate(glm::mat4(1.0f), pivot_rot,
-                            glm::vec3(1, 0, 0)) *
-                glm::translate(glm::mat4(1.0f), -pivot);
-        }
-        M = M * glm::translate(glm::mat4(1.0f), centre) *
-            glm::scale(glm::mat4(1.0f), half);
-        frame_parts_.push_back({M, col});
-    };
-    // torso / head keep the walk-neutral frame
-    part({0.0f, 1.18f * s, 0.0f},
-         {0.17f * s * bw, 0.27f * s, 0.11f * s * bw}, 0.0f, {});
-    glm::vec4 head_col = glm::vec4(glm::mix(
-        glm::vec3(0.87f, 0.72f, 0.58f), glm::vec3(col), 0.15f), 0.12f);
-    {
-        glm::vec4 keep = col;
-        col = head_col;
-        part({0.0f, 1.62f * s, 0.0f},
-             {0.105f * s, 0.115f * s, 0.105f * s}, 0.0f, {});
-        col = keep;
-    }
-    // limbs swing about their pivots
-    part({-0.235f * s * bw, 1.14f * s, 0.0f},
-         {0.05f * s, 0.27f * s, 0.05f * s},
-         arm_l, {-0.235f * s * bw, 1.40f * s, 0.0f});
-    part({0.235f * s * bw, 1.14f * s, 0.0f},
-         {0.05f * s, 0.27f * s, 0.05f * s},
-         arm_r, {0.235f * s * bw, 1.40f * s, 0.0f});
-    part({-0.09f * s, 0.47f * s, 0.0f},
-         {0.07f * s * bw, 0.44f * s, 0.07f * s * bw},
-         leg_l, {-0.09f * s, 0.90f * s, 0.0f});
-    part({0.09f * s, 0.47f * s, 0.0f},
-         {0.07f * s * bw, 0.44f * s, 0.07f * s * bw},
-         leg_r, {0.09f * s, 0.90f * s, 0.0f});
+    s_upload_written_ = written;
+    return &slot;
 }
 
 void CitizenSystem::draw(
@@ -2559,45 +3205,21 @@ void CitizenSystem::draw(
     const std::shared_ptr<er::ImageView>& color_view,
     const std::shared_ptr<er::ImageView>& depth_view,
     const glm::uvec2& buffer_size) {
-    if (!loaded_ || frame_parts_.empty() || !s_pipeline_) return;
+    const bool records = !frame_records_.empty();
+    if (!loaded_ || (!records && frame_parts_.empty()) || !s_pipeline_) {
+        return;
+    }
+    if (records && !s_crowd_pipeline_) return;
     if (!color_view || !depth_view) return;
     if (!s_device_) return;
     // ── UPLOAD THE INSTANCE STREAM ──────────────────────────────────
-    // Grown in powers of two and never shrunk: the crowd in view swings
-    // frame to frame as the camera turns, and reallocating a
-    // multi-megabyte buffer on every swing would cost more than the
-    // headroom it reclaims.  HOST_VISIBLE | HOST_COHERENT so the fill
-    // is a memcpy with no staging copy and no barrier.
-    {
-        const uint32_t need = uint32_t(frame_parts_.size());
-        if (!s_inst_buf_ || need > s_inst_capacity_) {
-            uint32_t cap = s_inst_capacity_ ? s_inst_capacity_ : 4096u;
-            while (cap < need) cap *= 2u;
-            if (s_inst_buf_) s_inst_buf_->destroy(s_device_);
-            s_inst_buf_ = std::make_shared<er::BufferInfo>();
-            er::Helper::createBuffer(
-                s_device_,
-                SET_2_FLAG_BITS(BufferUsage, VERTEX_BUFFER_BIT,
-                                TRANSFER_DST_BIT),
-                SET_2_FLAG_BITS(MemoryProperty, HOST_VISIBLE_BIT,
-                                HOST_COHERENT_BIT),
-                0,
-                s_inst_buf_->buffer,
-                s_inst_buf_->memory,
-                std::source_location::current(),
-                uint64_t(cap) * sizeof(PartInstance),
-                nullptr);
-            s_inst_capacity_ = cap;
-            std::cout << "[citizen] instance buffer -> " << cap
-                      << " parts ("
-                      << (uint64_t(cap) * sizeof(PartInstance)) / 1024
-                      << " KiB)" << std::endl;
-        }
-        s_device_->updateBufferMemory(
-            s_inst_buf_->memory,
-            uint64_t(need) * sizeof(PartInstance),
-            frame_parts_.data());
-    }
+    UploadSlot* slot =
+        records ? uploadInstances(frame_records_.data(),
+                                  frame_records_.size(),
+                                  sizeof(CitizenRecord))
+                : uploadInstances(frame_parts_.data(), frame_parts_.size(),
+                                  sizeof(PartInstance));
+    if (!slot) return;
     if (!s_pipeline_layout_ || !s_cube_pos_ || !s_cube_nrm_ ||
         !s_cube_idx_) {
         return;
@@ -2652,14 +3274,15 @@ void CitizenSystem::draw(
     scissors[0].offset = {0, 0};
     scissors[0].extent = {buffer_size.x, buffer_size.y};
 
-    cmd_buf->bindPipeline(er::PipelineBindPoint::GRAPHICS, s_pipeline_);
+    cmd_buf->bindPipeline(er::PipelineBindPoint::GRAPHICS,
+                          records ? s_crowd_pipeline_ : s_pipeline_);
     cmd_buf->setViewports(viewports, 0, 1);
     cmd_buf->setScissors(scissors, 0, 1);
     cmd_buf->bindDescriptorSets(er::PipelineBindPoint::GRAPHICS,
                                 s_pipeline_layout_, desc_sets);
     std::vector<std::shared_ptr<er::Buffer>> vbs = {
         s_cube_pos_->buffer, s_cube_nrm_->buffer,
-        s_inst_buf_->buffer};
+        slot->buf->buffer};
     std::vector<uint64_t> offs = {0, 0, 0};
     cmd_buf->bindVertexBuffers(0, vbs, offs);
     cmd_buf->bindIndexBuffer(s_cube_idx_->buffer, 0,
@@ -2668,16 +3291,45 @@ void CitizenSystem::draw(
     // drawIndexed per box, which is what actually capped the visible
     // population: the cost was never the 12 triangles of a box, it was
     // the draw call in front of them.
-    cmd_buf->drawIndexed(s_cube_index_count_,
-                         uint32_t(frame_parts_.size()));
+    if (!records) {
+        cmd_buf->drawIndexed(s_cube_index_count_,
+                             uint32_t(frame_parts_.size()));
+    } else {
+        // Two with GPU expansion: the detailed figures draw the whole
+        // body mesh, the far tier its first cube, from the same stream.
+        glsl::CitizenCrowdParams params{};
+        params.anim_t = anim_t_;
+        // The stages must be the whole range the layout declares, not
+        // just the one that reads it.
+        cmd_buf->pushConstants(
+            SET_2_FLAG_BITS(ShaderStage, VERTEX_BIT, FRAGMENT_BIT),
+            s_pipeline_layout_,
+            &params,
+            sizeof(params));
+        const uint32_t n_near = uint32_t(frame_detailed_);
+        const uint32_t n_slots = uint32_t(frame_records_.size()) - n_near;
+        if (frame_far_) {
+            cmd_buf->drawIndexed(s_cube_index_count_, n_slots);
+        }
+        if (n_near) {
+            cmd_buf->drawIndexed(s_cube_index_count_ * kCitizenParts,
+                                 n_near, 0, 0, n_slots);
+        }
+    }
     cmd_buf->endDynamicRendering();
 }
 
 void CitizenSystem::destroy(const std::shared_ptr<er::Device>& device) {
     (void)device;
     persons_.clear();
-    sim_.clear();
+    steps_.clear();
+    resetSim();
     frame_parts_.clear();
+    frame_records_.clear();
+    frame_detailed_ = 0;
+    frame_far_ = 0;
+    tick_chunks_.clear();
+    tick_pool_.reset();
     is_detailed_.clear();
     is_detailed_.shrink_to_fit();
     near_ids_.clear();
@@ -6,6 +6,8 @@
 //   <map>_pcg_city.json         persons: home, duty, age, body sheet,
 //                               weekday/weekend schedules (city_sim.py)
 //   <map>_pcg_world.json        house instance transforms (columnar)
+// and leaves the result compiled next to them for the next load:
+//   <map>_pcg_world.rwcity      binary sidecar, see readCitySidecar
 //
 // and turns the persons nearest the camera into ARTICULATED BOX FIGURES
 // — pelvis, torso, head, two arms, two legs, seven unit cubes per
@@ -17,25 +19,46 @@
 // between home, school, daycare and their workplace, terrain-clamped
 // through the same ground query the player's foot IK uses.
 //
-// Rendering is one pipeline + one shared unit-cube mesh + one push
-// constant (transform + role colour) per part, drawn into the forward
-// colour/depth buffers in a LOAD-op dynamic-rendering pass right after
-// the terrain tiles — depth-tested against the world, tonemapped with
-// the shared scene curve.  Citizens are DELIBERATELY absent from the
+// Rendering is one shared body mesh (six unit cubes) drawn instanced
+// into the forward colour/depth buffers in a LOAD-op dynamic-rendering
+// pass right after the terrain tiles — depth-tested against the world,
+// tonemapped with the shared scene curve.  By default the instance
+// stream is one 24 B CitizenRecord per visible person and
+// citizen_crowd.vert poses the parts; the CPU path, which builds a
+// transform + colour per part (citizen_pose.h), stays as the reference
+// and the fallback.  Citizens are DELIBERATELY absent from the
 // shadow/RT paths: they are gameplay markers, and thousands of
 // 7-box figures in a TLAS rebuilt per frame is exactly the cost this
 // engine spent the week avoiding.
+//
+// The per-frame tick is data-parallel: simulation state is held as
+// struct-of-arrays (a position scan touches positions and nothing
+// else), every schedule lives in one shared Step arena, and the near
+// tier and the part emission run in contiguous chunks on a worker
+// pool.  Each chunk emits into its own buffer and the buffers are
+// concatenated in person order, so the frame is identical to what a
+// serial walk produces; the terrain query, which is not thread-safe,
+// stays on the calling thread.
+//
+// Far citizens are EVENT-DRIVEN.  A schedule is piecewise constant, so
+// a person beyond the near ring changes only at their next step time:
+// each person has one entry in a min-heap keyed on that game minute,
+// and a frame pops what the clock passed — nothing else.  Who is near
+// comes from a plan-position grid of the population, not a scan.
 
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "citizen_pose.h"
+#include "helper/plan_grid.h"
 #include "renderer/renderer.h"
 
 namespace engine {
+namespace helper { class ThreadPool; }
 namespace game_object {
 
 class CitizenSystem {
@@ -107,6 +130,13 @@ public:
     size_t populationLoaded() const { return persons_.size(); }
     size_t activeCount() const { return persons_.size(); }
 
+    // GPU expansion (default on): upload a CitizenRecord per person and
+    // pose the parts in citizen_crowd.vert.  Off, or before the crowd
+    // pipeline exists, update() builds every part on the CPU instead —
+    // the same expansion, 80 B per part.  Takes effect next update().
+    void setGpuExpansion(bool on) { gpu_expand_ = on; }
+    bool gpuExpansion() const { return gpu_expand_; }
+
 private:
     struct Step {
         float minutes = 0.0f;          // time of day, minutes
@@ -114,6 +144,23 @@ private:
         int   place = -1;              // building index, -1 = home,
                                        // -2 = outdoors
     };
+    // One schedule: a [first, first + count) slice of steps_.  Every
+    // day plan of the town sits in that one array — two heap vectors
+    // per person was a quarter of a million allocations for a village,
+    // and a pointer chase per person per frame in the tick.
+    struct ScheduleRef {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+    // What scheduleOf hands out: a view into steps_, indexable like the
+    // vector it replaced.  Valid until the next loadCity.
+    struct StepSpan {
+        const Step* data = nullptr;
+        size_t      count = 0;
+        const Step& operator[](size_t i) const { return data[i]; }
+        size_t size() const { return count; }
+        bool   empty() const { return count == 0; }
+    };
     struct Person {
         int   house = 0;
         int   slot = 0;                // index among this destination's
@@ -132,8 +179,8 @@ private:
         float bulk = 1.0f;             // width factor from body status
         float speed = 1.35f;           // walk m/s
         bool  works_weekend = false;
-        std::vector<Step> weekday;
-        std::vector<Step> weekend;
+        ScheduleRef weekday;           // slices of steps_
+        ScheduleRef weekend;
     };
     struct Building {
         std::string type;
@@ -161,7 +208,10 @@ private:
         // packing.
         int   headcount = 1;
     };
-    struct SimState {                   // per-person, ALWAYS ticking
+    // One person's sim state as the tick and emitPerson work on it.
+    // STORED column-wise (sim_pos_ and friends below): loadSim gathers
+    // a person into one of these, storeSim scatters it back.
+    struct SimState {
         glm::vec3 pos{0.0f};
         float yaw = 0.0f;
         float phase = 0.0f;            // walk cycle
@@ -181,6 +231,8 @@ private:
         bool  inited = false;
     };
 
+    using PartInstance = CitizenPart;
+
     // ── FURNITURE ANCHORS ────────────────────────────────────────────
     // The placement stage puts REAL furniture inside these houses —
     // obj_bed*, obj_cooktop*, obj_chair* out of room_decals.glb — and
@@ -228,10 +280,14 @@ private:
     // exactly the bug this prevents).
     int resolveActivity(const Step& s) const;
 
-    const std::vector<Step>& scheduleOf(const Person& p) const {
-        return (isWeekend() && !p.works_weekend && !p.weekend.empty())
-                   ? p.weekend : p.weekday;
+    StepSpan scheduleOf(const Person& p) const {
+        const ScheduleRef& r =
+            (isWeekend() && !p.works_weekend && p.weekend.count)
+                ? p.weekend : p.weekday;
+        return {steps_.data() + r.first, r.count};
     }
+    // Appends a (sorted) day plan to steps_ and returns its slice.
+    ScheduleRef packSchedule(const std::vector<Step>& steps);
     // Fallback population: a HOUSEHOLD of 3-5 per house, synthesized
     // from the world manifest alone.  Household size is drawn per house
     // and the seats read as a family (earner, second adult, students),
@@ -250,17 +306,36 @@ private:
     // Citizens walked the straight line between anchors, which took
     // them clean through their neighbours' houses.  There is no nav
     // mesh here (and ~230k agents could not afford one), so this is local
-    // steering: houses are treated as discs in a coarse spatial hash,
+    // steering: houses are treated as discs in a coarse spatial grid,
     // and a walker whose next step would enter one slides along its
     // tangent instead.  `exempt_*` are the buildings they are allowed
     // to be inside — their own home, and wherever they are heading.
     void buildHouseGrid();
     glm::vec2 steerAroundHouses(const glm::vec2& pos, const glm::vec2& dir,
                                 int exempt_house, int exempt_dest) const;
-    std::unordered_map<uint64_t, std::vector<int>> house_grid_;
-    int currentStep(const std::vector<Step>& sched, float tod) const;
+    // The grid is DENSE over the houses' bounds, in kAvoidCell cells
+    // keyed by floor(coord / kAvoidCell): cell (cx, cz) holds houses
+    // house_cell_items_[house_cell_first_[c] .. house_cell_first_[c+1])
+    // in ascending index, c = (cz - house_cz0_) * house_nx_ + (cx -
+    // house_cx0_).  A lookup is an index, not a hash probe — the
+    // steering runs it for every walker in the near tier, every frame.
+    int32_t house_cx0_ = 0, house_cz0_ = 0;
+    int32_t house_nx_ = 0, house_nz_ = 0;
+    std::vector<uint32_t> house_cell_first_;
+    std::vector<int>      house_cell_items_;
+    // Houses filed in cell (cx, cz), as [begin, end); empty outside.
+    std::pair<const int*, const int*> housesInCell(int32_t cx,
+                                                   int32_t cz) const;
+    int currentStep(const StepSpan& sched, float tod) const;
+    // Person pid's render record: activity, furniture and root
+    // resolved against the sim.  Const and free of shared writes, so
+    // chunks of the population can pack concurrently.
+    CitizenRecord packPerson(int pid, const SimState& a, const Person& p,
+                             bool detailed) const;
+    // Appends person pid's parts to `out` — packPerson expanded on the
+    // CPU, the reference for what citizen_crowd.vert draws.
     void emitPerson(int pid, const SimState& a, const Person& p,
-                    bool detailed);
+                    bool detailed, std::vector<PartInstance>& out) const;
 
     // static render objects
     static std::shared_ptr<renderer::PipelineLayout> s_pipeline_layout_;
@@ -269,13 +344,36 @@ private:
     static std::shared_ptr<renderer::BufferInfo>     s_cube_nrm_;
     static std::shared_ptr<renderer::BufferInfo>     s_cube_idx_;
     static uint32_t                                  s_cube_index_count_;
+    // Records drawn by citizen_crowd.vert; same layout and mesh.
+    static std::shared_ptr<renderer::Pipeline>       s_crowd_pipeline_;
     // ── PER-FRAME INSTANCE STREAM ───────────────────────────────────
-    // frame_parts_ uploaded once and drawn with ONE instanced call.
-    // The device is kept because draw() is handed a command buffer and
-    // nothing else, and the buffer has to grow with the crowd.
+    // frame_records_ (or frame_parts_) uploaded once and drawn with
+    // instanced calls.  The device is kept because draw() is handed a
+    // command buffer and nothing else, and the buffer has to grow with
+    // the crowd.
+    //
+    // Two slots, used alternately — one per frame in flight — each
+    // persistently mapped and each with a CPU copy of what it holds.
+    // A frame writes only the elements that differ from that copy: a
+    // far-tier person standing still packs to the same 24 bytes in the
+    // same slot frame after frame (the pose clock is a push constant),
+    // so most of a town's stream is never written again.
+    struct UploadSlot {
+        std::shared_ptr<renderer::BufferInfo> buf;
+        uint8_t*             mapped = nullptr;
+        size_t               capacity = 0;      // bytes
+        std::vector<uint8_t> shadow;            // what `mapped` holds
+    };
+    static constexpr int    kUploadSlots = 2;
     static std::shared_ptr<renderer::Device>         s_device_;
-    static std::shared_ptr<renderer::BufferInfo>     s_inst_buf_;
-    static uint32_t                                  s_inst_capacity_;
+    static UploadSlot                                s_upload_[kUploadSlots];
+    static uint32_t                                  s_upload_frame_;
+    static size_t                                    s_upload_written_;
+    // Copies `count` elements of `stride` bytes into this frame's slot,
+    // writing only the ones that changed, and returns the slot —
+    // nullptr if it can't grow.
+    static UploadSlot* uploadInstances(const void* data, size_t count,
+                                       size_t stride);
 
     bool loaded_ = false;
     std::vector<glm::vec3> houses_;
@@ -337,6 +435,23 @@ private:
     bool loadIndoor(const std::string& path,
                     const std::vector<std::string>& house_node,
                     const std::vector<int>& house_node_idx);
+
+    // ── COMPILED CITY: THE .rwcity SIDECAR ──────────────────────────
+    // Everything loadCity derives — houses, buildings, persons and the
+    // step arena, indoor graphs with their next-hop/dist tables,
+    // furniture slices, the avoidance grid — dumped after a JSON load
+    // and read back with ONE file read on the next, instead of three
+    // json parses, the all-pairs BFS, the furniture harvest and the
+    // resident synthesis.  Keyed by the content hash of the source
+    // JSONs and of the instance registry the furniture came from; a
+    // key mismatch or a damaged file falls through to the JSON path,
+    // which then rewrites it.
+    void clearCity();
+    uint64_t citySourceKey(const std::string& city_json_path,
+                           const std::string& world_json_path,
+                           const std::string& indoor_json_path) const;
+    bool readCitySidecar(const std::string& path, uint64_t key);
+    void writeCitySidecar(const std::string& path, uint64_t key) const;
     // House-local <-> world for house `hi` (yaw + per-axis scale).
     glm::vec2 worldToLocal(int hi, const glm::vec2& w) const;
     glm::vec2 localToWorld(int hi, const glm::vec2& l) const;
@@ -358,10 +473,56 @@ private:
                         glm::vec3& out_wp) const;
     std::vector<Building>  buildings_;
     std::vector<Person>    persons_;
-    std::vector<SimState>  sim_;       // parallel to persons_
-    size_t clamp_cursor_ = 0;          // far-person ground refresh ring
-    size_t sim_cursor_ = 0;            // far-person schedule ring
+    std::vector<Step>      steps_;     // schedule arena (ScheduleRef)
+    // ── SIM STATE, column-wise, parallel to persons_ ─────────────────
+    // The hot scans — near-ring test, render tiers, terrain rings —
+    // read positions and flags only, and now stream just those.
+    // kSimNear: in the near ring this frame (the near tick owns them).
+    // kSimGroundQueued: already waiting in ground_queue_.
+    enum : uint8_t {
+        kSimInited = 1, kSimWalking = 2, kSimNear = 4, kSimGroundQueued = 8
+    };
+    std::vector<glm::vec3> sim_pos_;
+    std::vector<uint8_t>   sim_flags_;
+    std::vector<float>     sim_yaw_, sim_phase_, sim_gesture_t_;
+    std::vector<int>       sim_step_;
+    std::vector<int16_t>   sim_nav_room_;
+    void resetSim();                   // everyone uninited, sized to n
+    SimState loadSim(size_t i) const;
+    void storeSim(size_t i, const SimState& a);
     size_t near_clamp_cursor_ = 0;     // budgeted near-ring clamp start
+
+    // ── FAR TIER: NEXT-TRANSITION EVENTS ────────────────────────────
+    // wake_heap_ holds exactly ONE (game minute, pid) entry per person,
+    // soonest on top: the minute their current step ends — their next
+    // Step::minutes, or midnight, when the day (and maybe the
+    // weekday/weekend plan) turns over.  update() pops everything the
+    // clock has passed, so a slider jump of six hours lands everyone on
+    // the right step in that same frame.  A clock that runs BACKWARDS
+    // (a scrub, the week wrap) or a reset re-plans the whole town once.
+    std::vector<std::pair<float, uint32_t>> wake_heap_;
+    std::vector<uint32_t> woken_;      // per-frame scratch
+    float event_clock_ = -1.0f;        // clock_min_ the heap was drained to
+    bool  replan_ = true;
+    // Everyone onto their step for the current clock, grid and heap
+    // rebuilt — placement after a reset, and the backwards-clock path.
+    void replanAll(float tod);
+    // Far-person step snap: init, and move to the current step's anchor
+    // when the step changed.  True when the position moved.  Touches
+    // only person i's state, so it is safe across chunks.
+    bool snapToSchedule(size_t i, float tod);
+    // Week minute at which person p's current step ends.
+    float nextWake(const Person& p, float now) const;
+
+    // Persons by plan position: the near ring is a grid query, and only
+    // the near tick and far step snaps ever move anyone in it.
+    helper::PlanGrid person_grid_;
+    std::vector<uint32_t> near_list_;  // this frame's near ring, ring order
+    std::vector<uint32_t> near_prev_;  // last frame's
+    // Persons whose height needs the terrain query: moved by a far snap
+    // or just left the near ring.  Drained kFarClampPerFrame a frame.
+    std::deque<uint32_t> ground_queue_;
+    void queueGround(uint32_t i);
     float  far_thresh_ = 0.0f;         // adaptive far-tier angular cutoff
                                        // (0 = seed from kMinAngular)
     float  dbg_timer_ = 0.0f;          // [citizen] telemetry cadence
@@ -390,8 +551,45 @@ private:
     float clock_rate_ = 0.0f;          // 0 = unmeasured -> life speed
     GroundQueryFn ground_;
 
-    struct PartInstance { glm::mat4 xform; glm::vec4 color; };
     std::vector<PartInstance> frame_parts_;
+    // GPU expansion: this frame's records — one far slot per person
+    // (hidden unless frame_far_'s far tier draws them), then the
+    // frame_detailed_ detailed figures.  frame_parts_ stays empty while
+    // they are in use, and the other way round.
+    bool gpu_expand_ = true;
+    std::vector<CitizenRecord> frame_records_;
+    size_t frame_detailed_ = 0;
+    size_t frame_far_ = 0;
+
+    // ── PARALLEL TICK ────────────────────────────────────────────────
+    // The population is cut into contiguous chunks, each run as one
+    // pool task.  A chunk owns its scratch: the terrain-clamp
+    // candidates its near tick found (applied afterwards on the calling
+    // thread, in ring order, so the per-frame clamp budget and its
+    // resume cursor behave exactly as in a serial walk), its share of
+    // the detail candidates, and the parts it emitted.  Created lazily
+    // on the first update big enough to split.
+    struct TickChunk {
+        std::vector<std::pair<uint32_t, uint8_t>> clamp;  // (pid, always)
+        std::vector<std::pair<uint32_t, glm::vec2>> moved; // (pid, old xz)
+        std::vector<uint32_t>                     snapped; // replanAll
+        std::vector<std::pair<float, int>>        near;
+        std::vector<PartInstance>                 parts;
+        std::vector<CitizenRecord>                near_recs;
+        size_t far_eligible = 0;       // far-tier candidates in chunk
+        size_t far_allowed = 0;        // ...of which the cap lets through
+        size_t first_part = 0;         // where `parts` lands in the frame
+        size_t first_near = 0;         // ...and near_recs
+    };
+    std::vector<TickChunk> tick_chunks_;
+    std::shared_ptr<helper::ThreadPool> tick_pool_;
+    // Sizes tick_chunks_ for a population of n, spinning up the pool
+    // when it is worth splitting.
+    void planChunks(size_t n);
+    // fn(chunk, first, last) over tick_chunks_.size() contiguous slices
+    // of [0, n); on the pool when there is more than one.
+    void runChunks(size_t n,
+                   const std::function<void(size_t, size_t, size_t)>& fn);
     // Per-frame scratch, kept as members so the render-tier pass does
     // not heap-allocate (and free) a population-sized buffer every
     // frame — with 3-5 residents per house that is a quarter-megabyte
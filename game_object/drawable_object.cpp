@@ -9,6 +9,7 @@
 #include <iomanip>
 #include <limits>
 #include <algorithm>
+#include <numeric>        // std::iota, PCG registry name index
 #include <cctype>
 #include <stdexcept>
 #include <memory>
@@ -21,11 +22,13 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <exception>      // std::exception_ptr, import-pool task errors
 
 #include "helper/engine_helper.h"
 #include "helper/bvh.h"
 #include "helper/mesh_tool.h"
 #include "helper/model_inspect.h"
+#include "helper/thread_pool.h"
 #include "game_object/drawable_object.h"
 #include "game_object/mesh_load_task_manager.h"
 #include "renderer/renderer_helper.h"
@@ -565,6 +568,80 @@ static void calculateBbox(
     }
 }
 
+// ── Import pool ────────────────────────────────────────────────────────────
+// The CPU half of a glTF / FBX import (image decode, per-mesh geometry,
+// LOD and cluster builds) fans out here.  Loaders call parallelFor from the
+// MeshLoadTaskManager worker or the main thread, never from a pool worker,
+// and keep every device call on the calling thread — the transient upload
+// channel is routed by thread id.  Pool tasks must not throw; they park
+// exceptions for the calling thread to rethrow in order.
+static helper::ThreadPool& importPool() {
+    static helper::ThreadPool pool;
+    return pool;
+}
+
+static bool isImportCancelled(const std::atomic<bool>* cancel) {
+    return cancel && cancel->load(std::memory_order_acquire);
+}
+
+// tinygltf image callback that keeps the encoded bytes instead of decoding
+// them during the parse, so decodeGltfImages() can decode every image on
+// the import pool afterwards.
+struct DeferredGltfImages {
+    std::vector<std::vector<unsigned char>> encoded;   // by image index
+};
+
+static bool deferGltfImage(
+    tinygltf::Image* /*image*/,
+    const int image_idx,
+    std::string* /*err*/,
+    std::string* /*warn*/,
+    int /*req_width*/,
+    int /*req_height*/,
+    const unsigned char* bytes,
+    int size,
+    void* user_data) {
+    auto* deferred = static_cast<DeferredGltfImages*>(user_data);
+    if (image_idx < 0) return false;
+    if (size_t(image_idx) >= deferred->encoded.size()) {
+        deferred->encoded.resize(size_t(image_idx) + 1);
+    }
+    deferred->encoded[image_idx].assign(bytes, bytes + size);
+    return true;
+}
+
+// Decodes the images deferGltfImage() kept with tinygltf's own decoder, so
+// the pixels are exactly what a normal parse would have produced.
+static bool decodeGltfImages(
+    tinygltf::Model& model,
+    DeferredGltfImages& deferred,
+    const std::string& input_filename,
+    const std::atomic<bool>* cancel) {
+    const size_t num_images =
+        std::min(model.images.size(), deferred.encoded.size());
+    std::vector<std::string> errors(num_images);
+    importPool().parallelFor(num_images, [&](size_t i_img) {
+        auto& encoded = deferred.encoded[i_img];
+        if (encoded.empty() || isImportCancelled(cancel)) return;
+        std::string warn;
+        if (!tinygltf::LoadImageData(
+                &model.images[i_img], int(i_img), &errors[i_img], &warn,
+                0, 0, encoded.data(), int(encoded.size()), nullptr) &&
+            errors[i_img].empty()) {
+            errors[i_img] = "could not decode image " + std::to_string(i_img);
+        }
+        std::vector<unsigned char>().swap(encoded);
+    });
+    for (const auto& err : errors) {
+        if (!err.empty()) {
+            std::cout << "ERR: " << err << std::endl;
+            std::cout << "Failed to load .glTF : " << input_filename << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
 static void setupMeshState(
     const std::shared_ptr<renderer::Device>& device,
     const tinygltf::Model& model,
@@ -1142,7 +1219,8 @@ static void setupMeshState(
     const std::shared_ptr<renderer::Device>& device,
     const ufbx_abi ufbx_scene* fbx_scene,
     std::shared_ptr<ego::DrawableData>& drawable_object,
-    const std::string& asset_key) {
+    const std::string& asset_key,
+    const std::atomic<bool>* cancel) {
 
     // allocate texture memory at first.
     std::vector<size_t> texture_hash_table;
@@ -1189,7 +1267,30 @@ static void setupMeshState(
         if (em_tex) texture_is_srgb[em_tex->typed_id] = true;
     }
 
-    for (size_t i_tex = 0; i_tex < fbx_scene->textures.count; i_tex++) {
+    // Decode on the import pool (file read + PNG/JPG/DDS parse is most of
+    // an FBX import's texture time), then create the images here in
+    // texture order: device calls stay on the loader thread.  Textures the
+    // shared cache already holds are not decoded at all.
+    const size_t num_textures = fbx_scene->textures.count;
+    const auto tex_format = renderer::Format::R8G8B8A8_UNORM;
+    std::vector<helper::DecodedTextureImage> decoded(num_textures);
+    std::vector<std::exception_ptr> decode_errors(num_textures);
+    importPool().parallelFor(num_textures, [&](size_t i_tex) {
+        if (isImportCancelled(cancel)) return;
+        const char* tex_file = fbx_scene->textures[i_tex]->filename.data;
+        const bool srgb = texture_is_srgb[i_tex];
+        if (helper::isTextureCached(tex_file, srgb, tex_format)) return;
+        try {
+            helper::decodeTextureImage(tex_file, tex_format, srgb, decoded[i_tex]);
+        } catch (...) {
+            decode_errors[i_tex] = std::current_exception();
+        }
+    });
+
+    for (size_t i_tex = 0; i_tex < num_textures; i_tex++) {
+        if (isImportCancelled(cancel)) return;
+        if (decode_errors[i_tex]) std::rethrow_exception(decode_errors[i_tex]);
+
         auto& dst_tex = drawable_object->textures_[i_tex];
         const auto& src_tex = fbx_scene->textures[i_tex];
 
@@ -1201,16 +1302,24 @@ static void setupMeshState(
         dst_tex.source_filename_ = src_tex->filename.data
             ? std::string(src_tex->filename.data) : std::string();
 
-        glm::uvec3 size(0);
-        auto format = renderer::Format::R8G8B8A8_UNORM;
-        helper::createTextureImage(
-            device,
-            src_tex->filename.data,
-            format,
-            texture_is_srgb[i_tex],
-            dst_tex,
-            std::source_location::current(),
-            /*cacheable=*/true);
+        if (decoded[i_tex].file_name.empty()) {
+            // Was cached when the decode ran: served from the cache.
+            helper::createTextureImage(
+                device,
+                src_tex->filename.data,
+                tex_format,
+                texture_is_srgb[i_tex],
+                dst_tex,
+                std::source_location::current(),
+                /*cacheable=*/true);
+        } else {
+            helper::createTextureImage(
+                device,
+                decoded[i_tex],
+                dst_tex,
+                std::source_location::current(),
+                /*cacheable=*/true);
+        }
     }
 
     // Material
@@ -1496,20 +1605,28 @@ static void setupMeshState(
     }
 }
 
-static void setupMesh(
-    const std::shared_ptr<renderer::Device>& device,
+// One FBX mesh between its CPU build and its GPU upload.  Owned by
+// setupMeshes for the duration of one wave.
+struct FbxMeshBuild {
+    helper::Mesh          full_lod_meshes;   // LOD0 + appended LOD faces
+    std::vector<uint32_t> new_indices;       // all LODs, flattened
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> lod_indice_info;
+    std::ostringstream    log;               // merged in mesh order
+};
+
+// CPU half of one FBX mesh: corner dedup, n-gon fan triangulation,
+// cluster sidecar and the QEM LOD chain.  Touches only meshes_[mesh_idx]
+// and `build`, and no device state, so meshes run on the import pool in
+// parallel.  uploadMesh() finishes the mesh on the loader thread.
+static void buildMesh(
     const ufbx_abi ufbx_scene* fbx_scene,
     std::shared_ptr<ego::DrawableData>& drawable_object,
     const uint32_t& mesh_idx,
-    std::ostringstream& log_buf) {
-
-    auto vertex_buffer_idx = mesh_idx * 2;
-    auto indice_buffer_idx = mesh_idx * 2 + 1;
+    FbxMeshBuild& build) {
 
     const ufbx_mesh* src_mesh = fbx_scene->meshes[mesh_idx];
     auto& drawable_mesh = drawable_object->meshes_[mesh_idx];
-    auto& vertex_buffer = drawable_object->buffers_[vertex_buffer_idx];
-    auto& indice_buffer = drawable_object->buffers_[indice_buffer_idx];
+    std::ostringstream& log_buf = build.log;
 
     // ufbx is loaded WITHOUT triangulation (opts = {0}), so faces can be
     // n-gons and num_faces != num_triangles in general.  The face loop
@@ -1529,7 +1646,7 @@ static void setupMesh(
     }
 
     std::unordered_map<size_t, VertexHashInfo> vertex_map;
-    std::vector<uint32_t> new_indices;
+    std::vector<uint32_t>& new_indices = build.new_indices;
     std::vector<uint32_t> indice_match_table;
     new_indices.reserve(src_mesh->num_indices * 3);
     indice_match_table.reserve(src_mesh->num_indices * 3);
@@ -1615,7 +1732,7 @@ static void setupMesh(
                                            "  (source connected)")
                       << std::endl;
             if (part.num_faces > 200) {
-                static int s_pav = 0;
+                static std::atomic<int> s_pav{0};    // meshes build in parallel
                 std::ofstream raw(
                     "G:/work/procedure-world-sim/debug_source_raw_" +
                     std::to_string(s_pav++) + ".obj");
@@ -1681,15 +1798,15 @@ static void setupMesh(
             // n-gons (i.e. whether the missing-triangle bug was firing).
             // Throttled to the first 20 occurrences.
             if (face.num_indices != 3) {
-                static int s_ngon_log = 0;
-                if (s_ngon_log < 20) {
-                    ++s_ngon_log;
+                static std::atomic<int> s_ngon_log{0};
+                const int n_logged = s_ngon_log.fetch_add(1) + 1;
+                if (n_logged <= 20) {
                     std::cout << "[mesh.fbx] non-triangle face: num_indices="
                               << face.num_indices
                               << " -> fan-triangulated into "
                               << (face.num_indices >= 2
                                       ? face.num_indices - 2 : 0)
-                              << " tri(s) (#" << s_ngon_log << "/20)"
+                              << " tri(s) (#" << n_logged << "/20)"
                               << std::endl;
                 }
             }
@@ -1805,7 +1922,7 @@ static void setupMesh(
         drawable_mesh.primitives_.push_back(primitive_info);
     }
 
-    helper::Mesh full_lod_meshes;
+    helper::Mesh& full_lod_meshes = build.full_lod_meshes;
     full_lod_meshes.vertex_data_ptr->reserve(indice_match_table.size() * 3);
     full_lod_meshes.faces_ptr->reserve(src_mesh->num_indices);
 
@@ -1838,26 +1955,15 @@ static void setupMesh(
     // new_indices.size()/3 faces and drawable_vertices populated above.
     // The HLOD loop below will APPEND higher-LOD faces onto the same arrays;
     // we want clusters for the base LOD only, so build them here first.
-    helper::buildClusterMesh(full_lod_meshes, drawable_mesh.cluster_mesh_);
-    // Only build the expanded per-triangle debug vertex buffer when the
-    // cluster-debug visualisation is actually active.  Building it for every
-    // FBX mesh unconditionally wastes hundreds of MB of GPU memory on large
-    // scenes (Bistro: ~500 meshes × many triangles × 48 bytes/vertex).
-    // The cluster indirect renderer (GPU culling path) does NOT need this
-    // buffer — it uses cluster_global_mesh_idx_ >= 0 to identify its meshes.
-    if (engine::helper::clusterRenderingEnabled()) {
-        ego::ClusterDebugDraw::uploadForMesh(
-            device,
-            drawable_mesh.cluster_mesh_,
-            drawable_mesh.cluster_debug_gpu_);
-    }
-
+    //
     // ── Build cluster_prim_map_ ─────────────────────────────────────────────
     // Each cluster in the mesh-level cluster_mesh_ is assigned to the primitive
     // whose contiguous face range contains the cluster's first face index.
     // This keeps ONE cluster mesh per FBX mesh (efficient packing / low cluster
     // count) while still giving uploadMeshClusters the per-cluster material info
     // it needs — avoiding the 3-10× cluster explosion of per-primitive building.
+    // The part ranges also go to the meshlet builder so that no cluster
+    // straddles two parts.
     {
         // prim_face_start[i] = first global face index owned by primitive i.
         // prim_face_start[num_parts] = total face count (sentinel).
@@ -1872,6 +1978,11 @@ static void setupMesh(
         }
         prim_face_start.push_back(face_offset);  // sentinel
 
+        helper::ClusterBuildOptions cluster_opts;
+        cluster_opts.range_starts = prim_face_start;
+        helper::buildClusterMesh(full_lod_meshes, drawable_mesh.cluster_mesh_,
+                                 cluster_opts);
+
         drawable_mesh.cluster_prim_map_.clear();
         drawable_mesh.cluster_prim_map_.reserve(
             drawable_mesh.cluster_mesh_.clusters.size());
@@ -1893,8 +2004,8 @@ static void setupMesh(
     }
 
     // create HLOD
-    std::vector<std::vector<std::pair<uint32_t, uint32_t>>>
-        lod_indice_info(helper::c_num_lods + 1);
+    auto& lod_indice_info = build.lod_indice_info;
+    lod_indice_info.resize(helper::c_num_lods + 1);
     {
 #if DEBUG_OUTPUT
         log_buf << "====================" << std::endl;
@@ -1951,13 +2062,16 @@ static void setupMesh(
             size_t target_total = std::max(
                 size_t(double(total_src_faces) * helper::c_target_lod_ratio), size_t(1));
 
-            // Decimate the whole mesh with QEM
+            // Decimate the whole mesh with QEM.  No pool: this already
+            // runs on an import worker.
             helper::Mesh decimated;
             std::vector<int32_t> dec_part_ids;
+            helper::DecimateOptions dec_opts;
+            dec_opts.attribute_aware = true;
             helper::decimateMesh(
                 combined, combined_part_ids,
                 decimated, dec_part_ids,
-                target_total, log_buf);
+                target_total, log_buf, dec_opts);
 
 #if DEBUG_OUTPUT
             log_buf << "  lod " << i_lod + 1 << ": "
@@ -1999,6 +2113,69 @@ static void setupMesh(
         new_indices.push_back(face.v_indices[2]);
     }
 
+    // CPU-side position companion array for the collision-mesh
+    // builder. Must use the *deduped* vertices that `new_indices`
+    // (and therefore the per-primitive `vertex_indices_` captured
+    // above) reference -- not the raw FBX `vertex_position` table.
+    // `drawable_vertices` is the same buffer uploadMesh() sends to
+    // the GPU vertex buffer, so positions are guaranteed to
+    // match the GPU index buffer 1:1.
+    //
+    // Captured unconditionally (no longer gated on has_bvh_trees)
+    // so the collision-debug viz can show every mesh, including
+    // those whose every material part missed the BVH gate. The
+    // memory cost is one CPU-side glm::vec3 per deduped vertex,
+    // bounded by the size of the GPU vertex buffer we're about to
+    // upload anyway.
+    //
+    // LOD-N (N>=1) vertices were appended to drawable_vertices by
+    // the HLOD loop above, but LOD0 indices reference only the front
+    // portion of the array, so storing the full array is safe --
+    // the LOD tail is just unreferenced extra memory.
+    if (drawable_vertices && !drawable_vertices->empty()) {
+        auto positions = std::make_shared<std::vector<glm::vec3>>();
+        positions->reserve(drawable_vertices->size());
+        for (const auto& v : *drawable_vertices) {
+            positions->push_back(v.position);
+        }
+        drawable_mesh.vertex_position_ = std::move(positions);
+    }
+}
+
+// GPU half of one FBX mesh: vertex / index buffers, the optional cluster
+// debug buffer, and the buffer views + primitive descriptors that depend
+// on the chosen index width.  Device calls, so loader thread only.
+static void uploadMesh(
+    const std::shared_ptr<renderer::Device>& device,
+    const ufbx_abi ufbx_scene* fbx_scene,
+    std::shared_ptr<ego::DrawableData>& drawable_object,
+    const uint32_t& mesh_idx,
+    FbxMeshBuild& build) {
+
+    auto vertex_buffer_idx = mesh_idx * 2;
+    auto indice_buffer_idx = mesh_idx * 2 + 1;
+
+    const ufbx_mesh* src_mesh = fbx_scene->meshes[mesh_idx];
+    auto& drawable_mesh = drawable_object->meshes_[mesh_idx];
+    auto& vertex_buffer = drawable_object->buffers_[vertex_buffer_idx];
+    auto& indice_buffer = drawable_object->buffers_[indice_buffer_idx];
+    const auto& new_indices = build.new_indices;
+    const auto& drawable_vertices = build.full_lod_meshes.vertex_data_ptr;
+    const auto& lod_indice_info = build.lod_indice_info;
+
+    // Only build the expanded per-triangle debug vertex buffer when the
+    // cluster-debug visualisation is actually active.  Building it for every
+    // FBX mesh unconditionally wastes hundreds of MB of GPU memory on large
+    // scenes (Bistro: ~500 meshes × many triangles × 48 bytes/vertex).
+    // The cluster indirect renderer (GPU culling path) does NOT need this
+    // buffer — it uses cluster_global_mesh_idx_ >= 0 to identify its meshes.
+    if (engine::helper::clusterRenderingEnabled()) {
+        ego::ClusterDebugDraw::uploadForMesh(
+            device,
+            drawable_mesh.cluster_mesh_,
+            drawable_mesh.cluster_debug_gpu_);
+    }
+
     renderer::Helper::createBuffer(
         device,
         SET_4_FLAG_BITS(
@@ -2064,35 +2241,7 @@ static void setupMesh(
         index_type = renderer::IndexType::UINT32;
     }
 
-    // CPU-side position companion array for the collision-mesh
-    // builder. Must use the *deduped* vertices that `new_indices`
-    // (and therefore the per-primitive `vertex_indices_` captured
-    // above) reference -- not the raw FBX `vertex_position` table.
-    // `drawable_vertices` is the same buffer about to be uploaded
-    // to the GPU vertex buffer, so positions are guaranteed to
-    // match the GPU index buffer 1:1.
-    //
-    // Captured unconditionally (no longer gated on has_bvh_trees)
-    // so the collision-debug viz can show every mesh, including
-    // those whose every material part missed the BVH gate. The
-    // memory cost is one CPU-side glm::vec3 per deduped vertex,
-    // bounded by the size of the GPU vertex buffer we're about to
-    // upload anyway.
-    //
-    // LOD-N (N>=1) vertices are appended to drawable_vertices later
-    // in this function, but LOD0 indices reference only the front
-    // portion of the array, so storing the full array is safe --
-    // the LOD tail is just unreferenced extra memory.
-    if (drawable_vertices && !drawable_vertices->empty()) {
-        auto positions = std::make_shared<std::vector<glm::vec3>>();
-        positions->reserve(drawable_vertices->size());
-        for (const auto& v : *drawable_vertices) {
-            positions->push_back(v.position);
-        }
-        drawable_mesh.vertex_position_ = std::move(positions);
-    }
-
-    num_traingles = 0;
+    size_t num_traingles = 0;
     uint32_t buffer_offset = 0;
     auto pos_view_idx = mesh_idx * 4;
     drawable_object->buffer_views_[pos_view_idx].buffer_idx = vertex_buffer_idx;
@@ -2209,12 +2358,40 @@ static void setupMeshes(
     const std::shared_ptr<renderer::Device>& device,
     const ufbx_abi ufbx_scene* fbx_scene,
     std::shared_ptr<ego::DrawableData>& drawable_object,
-    std::ostringstream& log_buf) {
-    drawable_object->meshes_.resize(fbx_scene->meshes.count);
-    drawable_object->buffers_.resize(fbx_scene->meshes.count * 2);
-    drawable_object->buffer_views_.resize(fbx_scene->meshes.count * 4);
-    for (int i_mesh = 0; i_mesh < fbx_scene->meshes.count; i_mesh++) {
-        setupMesh(device, fbx_scene, drawable_object, i_mesh, log_buf);
+    std::ostringstream& log_buf,
+    const std::atomic<bool>* cancel) {
+    const size_t num_meshes = fbx_scene->meshes.count;
+    drawable_object->meshes_.resize(num_meshes);
+    drawable_object->buffers_.resize(num_meshes * 2);
+    drawable_object->buffer_views_.resize(num_meshes * 4);
+
+    // Meshes build on the import pool one wave at a time and upload here
+    // in mesh order, so the log and the GPU resources come out exactly as
+    // a serial import would.  The wave bounds how many meshes' CPU arrays
+    // (all LODs) are alive at once on a Bistro-sized file.
+    auto& pool = importPool();
+    const size_t wave = std::max<size_t>(pool.numThreads() * 4, 1);
+    for (size_t first = 0; first < num_meshes; first += wave) {
+        if (isImportCancelled(cancel)) return;
+        const size_t count = std::min(wave, num_meshes - first);
+        std::vector<FbxMeshBuild> builds(count);
+        std::vector<std::exception_ptr> errors(count);
+        pool.parallelFor(count, [&](size_t i) {
+            if (isImportCancelled(cancel)) return;
+            try {
+                buildMesh(
+                    fbx_scene, drawable_object, uint32_t(first + i), builds[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+        for (size_t i = 0; i < count; i++) {
+            if (errors[i]) std::rethrow_exception(errors[i]);
+            if (isImportCancelled(cancel)) return;
+            log_buf << builds[i].log.str();
+            uploadMesh(
+                device, fbx_scene, drawable_object, uint32_t(first + i), builds[i]);
+        }
     }
 }
 
@@ -6706,11 +6883,14 @@ bool PcgInstanceRegistry::load(const std::string& json_path) {
         return false;
     }
     if (!doc.contains("categories")) return false;
+    uint64_t source_hash = 0;
+    helper::stableFileHash(json_path, source_hash);
     static const std::map<std::string, uint8_t> kCat = {
         {"rocks", 0}, {"trees", 1}, {"bushes", 2},
         {"houses", 3}, {"objects", 4}};
 
-    std::lock_guard<std::mutex> lk(mu_);
+    std::unique_lock<std::shared_mutex> lk(mu_);
+    source_hash_ = source_hash;
     nodes_.clear(); recs_.clear();
     by_id_.clear(); by_pos_.clear();
     binds_.clear(); dirty_.clear();
@@ -6762,55 +6942,150 @@ bool PcgInstanceRegistry::load(const std::string& json_path) {
             by_pos_.emplace(posKey(r.node, r.t.x, r.t.z), idx);
         }
     }
+    buildIndices();
     std::cout << "[pcg-registry] " << recs_.size()
               << " physical props loaded from " << json_path << std::endl;
     return !recs_.empty();
 }
 
 void PcgInstanceRegistry::clear() {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::unique_lock<std::shared_mutex> lk(mu_);
+    source_hash_ = 0;
     nodes_.clear(); recs_.clear();
     by_id_.clear(); by_pos_.clear();
     binds_.clear(); dirty_.clear();
+    buildIndices();
+}
+
+void PcgInstanceRegistry::buildIndices() {
+    grid_.build((uint32_t)recs_.size(), [&](uint32_t i, float& x, float& z) {
+        x = recs_[i].t.x;
+        z = recs_[i].t.z;
+    });
+    // names repeat across categories; ties keep node order, so the
+    // first of equal names wins everywhere, as the old scans did
+    node_order_.resize(nodes_.size());
+    std::iota(node_order_.begin(), node_order_.end(), 0u);
+    std::sort(node_order_.begin(), node_order_.end(),
+              [&](uint32_t a, uint32_t b) {
+                  const int c = nodes_[a].compare(nodes_[b]);
+                  return c != 0 ? c < 0 : a < b;
+              });
+    node_rec_first_.assign(nodes_.size() + 1, 0);
+    for (const auto& r : recs_) {
+        if (r.node < nodes_.size()) ++node_rec_first_[r.node + 1];
+    }
+    for (size_t n = 0; n < nodes_.size(); ++n) {
+        node_rec_first_[n + 1] += node_rec_first_[n];
+    }
+    node_recs_.resize(node_rec_first_.back());
+    std::vector<uint32_t> at(node_rec_first_.begin(),
+                             node_rec_first_.end() - 1);
+    for (uint32_t i = 0; i < (uint32_t)recs_.size(); ++i) {
+        if (recs_[i].node < nodes_.size()) {
+            node_recs_[at[recs_[i].node]++] = i;   // ascending rec idx
+        }
+    }
 }
 
 size_t PcgInstanceRegistry::size() const {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::shared_lock<std::shared_mutex> lk(mu_);
     return recs_.size();
 }
 
+uint64_t PcgInstanceRegistry::sourceHash() const {
+    std::shared_lock<std::shared_mutex> lk(mu_);
+    return source_hash_;
+}
+
 const PcgInstanceRecord* PcgInstanceRegistry::find(uint64_t id) const {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::shared_lock<std::shared_mutex> lk(mu_);
     const auto it = by_id_.find(id);
     // stable storage: recs_ only mutates under load/clear, which also
     // invalidate every id a caller could be holding
     return it == by_id_.end() ? nullptr : &recs_[it->second];
 }
 
-std::vector<uint64_t> PcgInstanceRegistry::queryRadius(
-    const glm::vec3& p, float radius, int category) const {
-    std::lock_guard<std::mutex> lk(mu_);
-    std::vector<uint64_t> out;
+void PcgInstanceRegistry::appendRadius(const glm::vec3& p, float radius,
+                                       int category,
+                                       std::vector<uint64_t>& out) const {
+    // caller holds mu_ (shared is enough)
     const float r2 = radius * radius;
-    for (const auto& r : recs_) {
-        if (category >= 0 && r.category != (uint8_t)category) continue;
+    grid_.forEachCandidate(p.x, p.z, radius, [&](uint32_t i) {
+        const auto& r = recs_[i];
+        if (category >= 0 && r.category != (uint8_t)category) return;
         const float dx = r.t.x - p.x, dz = r.t.z - p.z;
         if (dx * dx + dz * dz <= r2) out.push_back(r.id);
-    }
+    });
+}
+
+std::vector<uint64_t> PcgInstanceRegistry::queryRadius(
+    const glm::vec3& p, float radius, int category) const {
+    std::shared_lock<std::shared_mutex> lk(mu_);
+    std::vector<uint64_t> out;
+    appendRadius(p, radius, category, out);
     return out;
 }
 
+void PcgInstanceRegistry::queryRadiusBatch(
+    const std::vector<PcgRadiusQuery>& queries,
+    std::vector<uint64_t>& out_ids,
+    std::vector<uint32_t>& out_first) const {
+    std::shared_lock<std::shared_mutex> lk(mu_);
+    out_ids.clear();
+    out_first.clear();
+    out_first.reserve(queries.size() + 1);
+    for (const auto& q : queries) {
+        out_first.push_back((uint32_t)out_ids.size());
+        appendRadius(q.p, q.radius, q.category, out_ids);
+    }
+    out_first.push_back((uint32_t)out_ids.size());
+}
+
+void PcgInstanceRegistry::appendPrefix(
+    const std::string& prefix, int category,
+    std::vector<PcgInstanceRecord>& out,
+    std::vector<uint32_t>& scratch) const {
+    // caller holds mu_ (shared is enough).  Names starting with `prefix`
+    // are one contiguous run of the sorted index.
+    scratch.clear();
+    auto it = std::lower_bound(
+        node_order_.begin(), node_order_.end(), prefix,
+        [&](uint32_t n, const std::string& p) { return nodes_[n] < p; });
+    for (; it != node_order_.end(); ++it) {
+        const std::string& nm = nodes_[*it];
+        if (nm.compare(0, prefix.size(), prefix) != 0) break;
+        for (uint32_t k = node_rec_first_[*it];
+             k < node_rec_first_[*it + 1]; ++k) {
+            const uint32_t i = node_recs_[k];
+            if (category >= 0 && recs_[i].category != (uint8_t)category) {
+                continue;
+            }
+            scratch.push_back(i);
+        }
+    }
+    std::sort(scratch.begin(), scratch.end());   // registry order
+    out.reserve(out.size() + scratch.size());
+    for (uint32_t i : scratch) out.push_back(recs_[i]);
+}
+
 std::vector<PcgInstanceRecord> PcgInstanceRegistry::queryByNodePrefix(
     const std::string& prefix, int category) const {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::shared_lock<std::shared_mutex> lk(mu_);
     std::vector<PcgInstanceRecord> out;
-    for (const auto& r : recs_) {
-        if (category >= 0 && r.category != (uint8_t)category) continue;
-        if (r.node >= nodes_.size()) continue;
-        const std::string& nm = nodes_[r.node];
-        if (nm.size() < prefix.size()) continue;
-        if (nm.compare(0, prefix.size(), prefix) != 0) continue;
-        out.push_back(r);
+    std::vector<uint32_t> scratch;
+    appendPrefix(prefix, category, out, scratch);
+    return out;
+}
+
+std::vector<std::vector<PcgInstanceRecord>>
+PcgInstanceRegistry::queryByNodePrefixBatch(
+    const std::vector<std::string>& prefixes, int category) const {
+    std::shared_lock<std::shared_mutex> lk(mu_);
+    std::vector<std::vector<PcgInstanceRecord>> out(prefixes.size());
+    std::vector<uint32_t> scratch;
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+        appendPrefix(prefixes[i], category, out[i], scratch);
     }
     return out;
 }
@@ -6841,7 +7116,7 @@ void PcgInstanceRegistry::queueRecord(uint32_t rec_idx,
 }
 
 bool PcgInstanceRegistry::setState(uint64_t id, uint8_t state) {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::unique_lock<std::shared_mutex> lk(mu_);
     const auto it = by_id_.find(id);
     if (it == by_id_.end() || state > 2) return false;
     PcgInstanceRecord& r = recs_[it->second];
@@ -6865,10 +7140,11 @@ bool PcgInstanceRegistry::setState(uint64_t id, uint8_t state) {
 
 bool PcgInstanceRegistry::setTransform(uint64_t id, const glm::vec3& t,
                                        float yaw, float scale) {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::unique_lock<std::shared_mutex> lk(mu_);
     const auto it = by_id_.find(id);
     if (it == by_id_.end()) return false;
     PcgInstanceRecord& r = recs_[it->second];
+    grid_.move(it->second, r.t.x, r.t.z, t.x, t.z);
     r.t = t; r.yaw = yaw; r.scale = scale;
     if (r.state == 2) return true;        // stays hidden; transform kept
     r.state = 1;                          // it moved: it is moving
@@ -6882,23 +7158,28 @@ void PcgInstanceRegistry::bindBakedRange(
     uint32_t first_slot,
     const std::vector<float>& translations,
     size_t count) {
-    std::lock_guard<std::mutex> lk(mu_);
+    std::unique_lock<std::shared_mutex> lk(mu_);
     if (recs_.empty() || count == 0) return;
     // longest registry key that prefixes this node's name — same rule
-    // the world-manifest overrides use (find_over above)
+    // the world-manifest overrides use (find_over above): the whole
+    // name, or the part before any '_' that has more after it.  Tried
+    // longest first against the sorted name index.
     int best = -1;
-    size_t best_len = 0;
-    for (size_t k = 0; k < nodes_.size(); ++k) {
-        const std::string& key = nodes_[k];
-        if (node_name.size() > key.size() + 1 &&
-            node_name[key.size()] == '_' &&
-            node_name.compare(0, key.size(), key) == 0 &&
-            key.size() > best_len) {
-            best = (int)k;
-            best_len = key.size();
-        } else if (node_name == key && key.size() > best_len) {
-            best = (int)k;
-            best_len = key.size();
+    for (size_t len = node_name.size(); len > 0 && best < 0; --len) {
+        if (len < node_name.size() &&
+            (node_name[len] != '_' || len + 1 == node_name.size())) {
+            continue;
+        }
+        const auto it = std::lower_bound(
+            node_order_.begin(), node_order_.end(), len,
+            [&](uint32_t n, size_t l) {
+                return nodes_[n].compare(0, std::string::npos,
+                                         node_name, 0, l) < 0;
+            });
+        if (it != node_order_.end() &&
+            nodes_[*it].compare(0, std::string::npos, node_name, 0, len) ==
+                0) {
+            best = (int)*it;
         }
     }
     if (best < 0) return;                 // not a physical prop (clutter…)
@@ -6944,7 +7225,7 @@ void PcgInstanceRegistry::flushDirty(
     // Take a bounded batch under the lock; record commands outside it.
     std::vector<std::pair<uint32_t, BakedInstanceXform>> batch;
     {
-        std::lock_guard<std::mutex> lk(mu_);
+        std::unique_lock<std::shared_mutex> lk(mu_);
         const auto it = dirty_.find(data.get());
         if (it == dirty_.end() || it->second.empty()) return;
         auto& q = it->second;
@@ -7148,6 +7429,7 @@ void AnimChannelInfo::update(DrawableData* object, float time, float time_scale/
     {
         target_node.scale_ = glm::mix(lower->second, upper->second, ratio);
     }
+    object->markNodeDirty(node_idx_);
 }
 
 glm::mat4 NodeInfo::getLocalMatrix(
@@ -7183,38 +7465,151 @@ glm::mat4 DrawableData::getNodeMatrix(
     return node_matrix;
 }
 
-void DrawableData::updateJoints(
+void DrawableData::markNodeDirty(int32_t node_idx) {
+    if (node_idx < 0 || size_t(node_idx) >= nodes_.size()) return;
+    nodes_[node_idx].local_dirty_ = true;
+    m_hierarchy_dirty_ = true;
+    // Flag the ancestor chain up to the first node already flagged —
+    // everything above it is flagged too, so repeated writes under one
+    // branch (every bone of a rig, every frame) stay O(1) amortised.
+    int32_t idx = node_idx;
+    while (idx >= 0 && !nodes_[idx].subtree_dirty_) {
+        nodes_[idx].subtree_dirty_ = true;
+        idx = nodes_[idx].parent_idx_;
+    }
+}
+
+void DrawableData::buildNodeOrder() {
+    const size_t num_nodes = nodes_.size();
+    node_order_.clear();
+    node_order_.reserve(num_nodes);
+    node_subtree_end_.assign(num_nodes, 0);
+    node_world_changed_.assign(num_nodes, 0);
+
+    // Iterative preorder from every root (explicit stack: rigs are
+    // shallow, but generated layouts can nest grouping nodes deeply).
+    // The stack holds (node, position-in-order) and the second entry is
+    // revisited once the subtree is done, to record where it ended.
+    std::vector<std::pair<int32_t, int32_t>> stack;
+    std::vector<uint8_t> visited(num_nodes, 0);
+    auto visitRoot = [&](int32_t root) {
+        stack.push_back({ root, -1 });
+        while (!stack.empty()) {
+            auto [idx, pos] = stack.back();
+            stack.pop_back();
+            if (pos >= 0) {
+                node_subtree_end_[pos] = uint32_t(node_order_.size());
+                continue;
+            }
+            if (visited[idx]) continue;
+            visited[idx] = 1;
+            const int32_t my_pos = int32_t(node_order_.size());
+            node_order_.push_back(idx);
+            stack.push_back({ idx, my_pos });
+            const auto& children = nodes_[idx].child_idx_;
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                if (*it >= 0 && size_t(*it) < num_nodes &&
+                    nodes_[*it].parent_idx_ == idx)
+                    stack.push_back({ *it, -1 });
+            }
+        }
+    };
+    for (size_t i = 0; i < num_nodes; i++) {
+        if (nodes_[i].parent_idx_ < 0) visitRoot(int32_t(i));
+    }
+    // A node whose parent does not list it as a child (malformed file)
+    // is unreached above; append it as its own subtree so every node
+    // still gets a matrix.
+    for (size_t i = 0; i < num_nodes; i++) {
+        if (!visited[i]) visitRoot(int32_t(i));
+    }
+
+    skinned_nodes_.clear();
+    if (!skins_.empty()) {
+        std::fill(visited.begin(), visited.end(), 0);
+        std::vector<int32_t> walk;
+        for (auto& scene : scenes_) {
+            for (auto root : scene.nodes_) walk.push_back(root);
+        }
+        while (!walk.empty()) {
+            const int32_t idx = walk.back();
+            walk.pop_back();
+            if (idx < 0 || size_t(idx) >= num_nodes || visited[idx]) continue;
+            visited[idx] = 1;
+            if (nodes_[idx].skin_idx_ > -1) skinned_nodes_.push_back(idx);
+            for (auto child : nodes_[idx].child_idx_) walk.push_back(child);
+        }
+    }
+}
+
+bool DrawableData::updateHierarchy(bool use_local_matrix_only) {
+    if (node_order_.size() != nodes_.size()) {
+        buildNodeOrder();
+        m_hierarchy_local_only_ = -1;
+    }
+    const bool full = m_hierarchy_local_only_ != int8_t(use_local_matrix_only);
+    m_hierarchy_local_only_ = int8_t(use_local_matrix_only);
+
+    bool any_changed = false;
+    const uint32_t count = uint32_t(node_order_.size());
+    uint32_t k = 0;
+    while (k < count) {
+        const int32_t idx = node_order_[k];
+        auto& node = nodes_[idx];
+        const int32_t parent = node.parent_idx_;
+        const bool parent_changed =
+            parent >= 0 && node_world_changed_[parent] != 0;
+        // Clean branch under an unchanged parent: nothing below moves.
+        // (A node reached here always has its parent visited earlier in
+        // this sweep, so node_world_changed_[parent] is current.)
+        if (!full && !parent_changed && !node.subtree_dirty_) {
+            k = node_subtree_end_[k];
+            continue;
+        }
+        const bool recompute = full || parent_changed || node.local_dirty_;
+        if (recompute) {
+            const glm::mat4 local = node.getLocalMatrix(use_local_matrix_only);
+            node.cached_matrix_ =
+                parent >= 0 ? nodes_[parent].cached_matrix_ * local : local;
+            any_changed = true;
+        }
+        node_world_changed_[idx] = recompute ? 1 : 0;
+        node.local_dirty_ = false;
+        node.subtree_dirty_ = false;
+        k++;
+    }
+    m_hierarchy_dirty_ = false;
+    return any_changed;
+}
+
+void DrawableData::updateNodeJoints(
     const std::shared_ptr<renderer::Device>& device,
     int32_t node_idx) {
     auto& node = nodes_[node_idx];
-    if (node.skin_idx_ > -1)
-    {
-        // Update the joint matrices
-        auto inverse_transform = glm::inverse(node.getCachedMatrix());
-        auto& skin = skins_[node.skin_idx_];
-        auto num_joints = skin.joints_.size();
-        std::vector<glm::mat4> joint_matrices(num_joints);
-        for (size_t i = 0; i < num_joints; i++) {
-            joint_matrices[i] =
-                inverse_transform *
-                nodes_[skin.joints_[i]].getCachedMatrix() *
-                skin.inverse_bind_matrices_[i];
-        }
-
-        // Keep a CPU copy for the RT-shadow skeleton path (CPU-skins the
-        // character into world space each frame from these).
-        skin.joint_matrices_cpu_ = joint_matrices;
-
-        renderer::Helper::updateBufferWithSrcData(
-            device,
-            joint_matrices.size() * sizeof(glm::mat4),
-            joint_matrices.data(),
-            skin.joints_buffer_.memory);
-    }
+    if (node.skin_idx_ < 0)
+        return;
 
-    for (auto& child : node.child_idx_) {
-        updateJoints(device, child);
+    // Update the joint matrices
+    auto inverse_transform = glm::inverse(node.getCachedMatrix());
+    auto& skin = skins_[node.skin_idx_];
+    auto num_joints = skin.joints_.size();
+    std::vector<glm::mat4> joint_matrices(num_joints);
+    for (size_t i = 0; i < num_joints; i++) {
+        joint_matrices[i] =
+            inverse_transform *
+            nodes_[skin.joints_[i]].getCachedMatrix() *
+            skin.inverse_bind_matrices_[i];
     }
+
+    // Keep a CPU copy for the RT-shadow skeleton path (CPU-skins the
+    // character into world space each frame from these).
+    skin.joint_matrices_cpu_ = joint_matrices;
+
+    renderer::Helper::updateBufferWithSrcData(
+        device,
+        joint_matrices.size() * sizeof(glm::mat4),
+        joint_matrices.data(),
+        skin.joints_buffer_.memory);
 }
 
 void DrawableData::update(
@@ -7248,20 +7643,27 @@ void DrawableData::update(
         }
     }
 
-    // update hierarchy matrix
-    for (auto i_node = 0; i_node < nodes_.size(); i_node++) {
-        nodes_[i_node].cached_matrix_ =
-            getNodeMatrix(i_node, use_local_matrix_only);
+    // ── Static fast path ─────────────────────────────────────────────
+    // Nothing wrote a node since the last pass (no channels ran, no
+    // controller / ECS pose, same matrix mode): every cached_matrix_
+    // and every uploaded joint matrix is still current.  This is the
+    // steady state of every unanimated, unskinned prop.
+    if (!m_hierarchy_dirty_ &&
+        m_hierarchy_local_only_ == int8_t(use_local_matrix_only) &&
+        node_order_.size() == nodes_.size()) {
+        return;
     }
 
+    // update hierarchy matrix — one forward sweep in parent-before-
+    // child order, touching only dirty nodes and their descendants.
+    const bool matrices_changed = updateHierarchy(use_local_matrix_only);
+
     // update joints — gated on skins_ (not animations_) so procedurally-
     // posed rigs like scene-skinned.gltf still get their GPU joint
-    // matrices uploaded each frame.
-    if (skins_.size() > 0) {
-        for (auto& scene : scenes_) {
-            for (auto& node : scene.nodes_) {
-                updateJoints(device, node);
-            }
+    // matrices uploaded each frame they are posed.
+    if (matrices_changed) {
+        for (auto node_idx : skinned_nodes_) {
+            updateNodeJoints(device, node_idx);
         }
     }
 }
@@ -7584,9 +7986,11 @@ std::shared_ptr<DrawableObject> DrawableObject::createAsync(
     s_in_flight_loads_[file_name].push_back(obj);
 
     // Shared mailbox: phase 2 (worker thread) writes `data`; phase 3
-    // (main thread, after fence signals) reads it. The MeshLoadTaskManager
-    // runs phase3 only after phase2's command buffer fence signals, so
-    // there is a natural happens-before between the two lambdas.
+    // (main thread, once the task's upload ticket completes) reads it. The
+    // MeshLoadTaskManager hands the task to the main thread under its lock
+    // and runs phase3 only after the upload scheduler's timeline reaches
+    // the task's upload_ticket, so there is a natural happens-before
+    // between the two lambdas.
     struct LoadState {
         std::shared_ptr<DrawableData> data;
     };
@@ -7599,21 +8003,23 @@ std::shared_ptr<DrawableObject> DrawableObject::createAsync(
         [device, file_name, ext, state](
             const std::shared_ptr<renderer::Device>& /*dev*/,
             const std::shared_ptr<renderer::CommandBuffer>& /*cmd_buf*/,
-            std::string& err_out) -> bool {
+            std::string& err_out,
+            const std::atomic<bool>& cancel) -> bool {
             // NOTE: we deliberately do not record into the provided
             // cmd_buf. loadGltfModel / loadFbxModel perform their GPU
             // uploads via renderer::Helper::createBuffer, which goes
             // through the thread-routed transient channel
             // (VulkanDevice::setupTransientCommandBuffer dispatched
             // by loader_thread_id_). That keeps the existing helper
-            // code unmodified. The outer cmd_buf is submitted empty,
-            // and its fence signals near-instantly, which is what
-            // drives phase 3 on the next main-thread poll().
+            // code unmodified. Those uploads land in the shared
+            // UploadScheduler batch; the task's upload_ticket is the
+            // batch's timeline value, and phase 3 runs on the first
+            // main-thread poll() after the timeline reaches it.
             try {
                 if (ext == ".fbx") {
-                    state->data = loadFbxModel(device, file_name);
+                    state->data = loadFbxModel(device, file_name, &cancel);
                 } else if (ext == ".gltf" || ext == ".glb") {
-                    state->data = loadGltfModel(device, file_name);
+                    state->data = loadGltfModel(device, file_name, &cancel);
                 } else if (ext == ".rwobj") {
                     // Native render-ready asset: small per-object load
                     // (baked .rwgeo + .rwtex), no source-model parse.
@@ -7642,6 +8048,12 @@ std::shared_ptr<DrawableObject> DrawableObject::createAsync(
                     err_out = "unsupported mesh extension: " + ext;
                     return false;
                 }
+                // The source-model importers stop between meshes /
+                // textures once the task is cancelled and return null.
+                if (cancel.load(std::memory_order_acquire)) {
+                    err_out = "cancelled: " + file_name;
+                    return false;
+                }
                 // Mirror the sync constructor's effective_opaque_
                 // scan + alpha-companion-texture build so async-
                 // loaded meshes also benefit from the no-frag shadow
@@ -9638,6 +10050,7 @@ void DrawableObject::setRootNodeTransform(
         if (object_->m_debug_scale_ > 0.0f) {
             n.scale_ = glm::vec3(object_->m_debug_scale_);
         }
+        object_->markNodeDirty(idx);
     };
     for (auto root_idx : scene.nodes_) apply_to_node(root_idx);
 
@@ -9668,6 +10081,7 @@ bool DrawableObject::setNodeRotationByName(
     int idx = findNodeIndexByName(name);
     if (idx < 0) return false;
     object_->nodes_[idx].rotation_ = rotation;
+    object_->markNodeDirty(idx);
     return true;
 }
 
@@ -9764,13 +10178,19 @@ std::shared_ptr<renderer::BufferInfo> DrawableObject::getGameObjectsBuffer() {
 
 std::shared_ptr<ego::DrawableData> DrawableObject::loadGltfModel(
     const std::shared_ptr<renderer::Device>& device,
-    const std::string& input_filename)
+    const std::string& input_filename,
+    const std::atomic<bool>* cancel)
 {
     tinygltf::Model model;
     tinygltf::TinyGLTF loader;
     std::string err;
     std::string warn;
 
+    // Images are decoded after the parse, in parallel, instead of one by
+    // one inside it.
+    DeferredGltfImages deferred_images;
+    loader.SetImageLoader(deferGltfImage, &deferred_images);
+
     std::string ext = getFilePathExtension(input_filename);
 
     bool ret = false;
@@ -9795,11 +10215,20 @@ std::shared_ptr<ego::DrawableData> DrawableObject::loadGltfModel(
         std::cout << "Failed to load .glTF : " << input_filename << std::endl;
         return nullptr;
     }
+    if (!decodeGltfImages(model, deferred_images, input_filename, cancel) ||
+        isImportCancelled(cancel)) {
+        return nullptr;
+    }
 
     auto drawable_object = std::make_shared<ego::DrawableData>(device);
     drawable_object->meshes_.reserve(model.meshes.size());
 
     setupMeshState(device, model, drawable_object, input_filename);
+    if (isImportCancelled(cancel)) {
+        // Resources created so far stay with the open upload batch, same
+        // as a load that threw.
+        return nullptr;
+    }
     setupMeshes(model, drawable_object);
     setupAnimations(model, drawable_object);
     setupSkins(device, model, drawable_object);
@@ -9958,7 +10387,8 @@ std::shared_ptr<ego::DrawableData> DrawableObject::loadGltfModel(
 
 std::shared_ptr<ego::DrawableData> DrawableObject::loadFbxModel(
     const std::shared_ptr<renderer::Device>& device,
-    const std::string& input_filename)
+    const std::string& input_filename,
+    const std::atomic<bool>* cancel)
 {
     ufbx_load_opts opts = { 0 };
     ufbx_error error;
@@ -9972,9 +10402,18 @@ std::shared_ptr<ego::DrawableData> DrawableObject::loadFbxModel(
 
     drawable_object->m_flip_v_ = true;
 
-    setupMeshState(device, fbx_scene, drawable_object, input_filename);
+    // Textures decode and meshes build on the import pool; both stages
+    // stop early once `cancel` is raised.  Resources created before that
+    // stay with the open upload batch, same as a load that threw.
     std::ostringstream log_buf;
-    setupMeshes(device, fbx_scene, drawable_object, log_buf);
+    setupMeshState(device, fbx_scene, drawable_object, input_filename, cancel);
+    if (!isImportCancelled(cancel)) {
+        setupMeshes(device, fbx_scene, drawable_object, log_buf, cancel);
+    }
+    if (isImportCancelled(cancel)) {
+        ufbx_free_scene(fbx_scene);
+        return nullptr;
+    }
 //    setupAnimations(model, drawable_object);
 //    setupSkins(device, model, drawable_object);
     setupNodes(fbx_scene, drawable_object);
@@ -10585,15 +11024,19 @@ std::shared_ptr<ego::DrawableData> DrawableObject::loadRwObjModel(
     }
 
     // ── Cluster sidecar (Nanite-lite GPU culling path) ─────────────────
-    helper::buildClusterMesh(cpu_mesh, drawable_mesh.cluster_mesh_);
     {
         // cluster → primitive map: sections are contiguous FACE ranges,
-        // so the cluster's first face index resolves its section.
+        // so the cluster's first face index resolves its section.  The
+        // meshlet builder keeps every cluster inside one section.
         std::vector<uint32_t> sec_face_start(num_sections + 1, 0);
         for (size_t si = 0; si < num_sections; ++si) {
             sec_face_start[si] = md.sections[si].first_index / 3;
         }
         sec_face_start[num_sections] = index_count / 3;
+        helper::ClusterBuildOptions cluster_opts;
+        cluster_opts.range_starts = sec_face_start;
+        helper::buildClusterMesh(cpu_mesh, drawable_mesh.cluster_mesh_,
+                                 cluster_opts);
         drawable_mesh.cluster_prim_map_.clear();
         for (const auto& cluster : drawable_mesh.cluster_mesh_.clusters) {
             uint32_t prim_idx = 0;
@@ -11446,7 +11889,9 @@ std::shared_ptr<ego::DrawableData> DrawableObject::loadRwCharacter(
                           scene.bbox_min_, scene.bbox_max_);
     }
 
-    // Bind-pose hierarchy + first joint upload (skins_ gate runs updateJoints).
+    // Bind-pose hierarchy + first joint upload: the first pass builds
+    // node_order_, sweeps every node (all start dirty) and uploads joints
+    // for each node in skinned_nodes_.
     drawable_object->update(device, 0, 0.0f, /*use_local_matrix_only=*/false);
     setupRaytracing(drawable_object);
 
@@ -12218,7 +12663,14 @@ std::shared_ptr<ego::DrawableData> DrawableObject::loadRwInstanced(
                 }
             }
             if (!cluster_src.faces_ptr->empty()) {
-                helper::buildClusterMesh(cluster_src, mesh.cluster_mesh_);
+                // One builder range per run of same-primitive faces.
+                helper::ClusterBuildOptions cluster_opts;
+                for (uint32_t f = 0; f < face_prim.size(); ++f) {
+                    if (f == 0 || face_prim[f] != face_prim[f - 1])
+                        cluster_opts.range_starts.push_back(f);
+                }
+                helper::buildClusterMesh(cluster_src, mesh.cluster_mesh_,
+                                         cluster_opts);
                 if (mesh.cluster_mesh_.empty()) ++cs_noclusters;
                 else ++cs_ok;
                 mesh.cluster_prim_map_.clear();
@@ -1,11 +1,13 @@
 #pragma once
 #include <atomic>
-#include <mutex>          // PcgInstanceRegistry guards its tables
+#include <mutex>
+#include <shared_mutex>   // PcgInstanceRegistry guards its tables
 #include <unordered_map>
 #include <utility>        // std::pair, for DrawableData::mesh_instance_range_
 #include "renderer/renderer.h"
 #include "helper/bvh.h"
 #include "helper/cluster_mesh.h"  // Optional "Nanite-lite" cluster sidecar.
+#include "helper/plan_grid.h"   // PcgInstanceRegistry radius queries.
 #include "cluster_debug_draw.h"   // Per-mesh GPU buffers for the cluster debug draw path.
 #include "ecs/material.h"         // Renderer-free MaterialDesc (dedup identity).
 
@@ -207,7 +209,7 @@ struct SkinInfo {
     renderer::BufferInfo    joints_buffer_;
     std::shared_ptr<renderer::DescriptorSet>    desc_set_;
     // CPU copy of the last joint matrices uploaded to joints_buffer_
-    // (updateJoints).  Consumed by the RT-shadow skeleton path, which
+    // (updateNodeJoints).  Consumed by the RT-shadow skeleton path, which
     // CPU-skins the character into world space each frame.
     std::vector<glm::mat4>  joint_matrices_cpu_;
 };
@@ -449,6 +451,15 @@ struct NodeInfo {
     glm::mat4                   matrix_ = glm::mat4(1.0f);
 
     glm::mat4                   cached_matrix_ = glm::mat4(1.0f);
+    // ── Incremental hierarchy refresh ─────────────────────────────
+    // local_dirty_: translation_/rotation_/scale_/matrix_ changed since
+    // the last DrawableData::update hierarchy pass.  subtree_dirty_:
+    // this node OR a descendant is local_dirty_, so the pass can skip a
+    // clean branch whole.  Both start set (first pass computes every
+    // node).  Write them through DrawableData::markNodeDirty only — it
+    // keeps the ancestor chain consistent.
+    bool                        local_dirty_ = true;
+    bool                        subtree_dirty_ = true;
     glm::mat4 getLocalMatrix(bool use_local_matrix_only);
     const glm::mat4& getCachedMatrix() const {
         return cached_matrix_;
@@ -496,6 +507,26 @@ struct DrawableData {
     // draw for any other node but still recurses children, so a filtered
     // node deep in the hierarchy is reached regardless of its parents.
     int32_t m_only_render_node_ = -1;
+    // ── Hierarchy pass state (DrawableData::update) ──────────────────
+    // node_order_ is every node in parent-before-child PREORDER, so one
+    // forward sweep computes world = world[parent] * local, and
+    // node_subtree_end_[k] (position just past node_order_[k]'s subtree)
+    // lets the sweep jump over a branch with no dirty node in it.
+    // skinned_nodes_ lists the scene-reachable nodes that own a skin —
+    // the only ones whose joints the pass uploads.  All three are built
+    // lazily on the first pass (and rebuilt if nodes_ is resized).
+    std::vector<int32_t>        node_order_;
+    std::vector<uint32_t>       node_subtree_end_;
+    std::vector<int32_t>        skinned_nodes_;
+    // Scratch for the sweep: node's world matrix changed this pass.
+    std::vector<uint8_t>        node_world_changed_;
+    // Any node dirty since the last pass.  While clear — a static prop,
+    // or a rig nobody posed this frame — update() does no hierarchy or
+    // joint work at all.
+    bool m_hierarchy_dirty_ = true;
+    // use_local_matrix_only of the last pass (-1 = none yet); a change
+    // of mode invalidates every cached matrix.
+    int8_t m_hierarchy_local_only_ = -1;
     // Same-frame dedup stamp for DrawableData::update() — many wrappers can
     // share one DrawableData (placed sub-objects); the hierarchy/animation/
     // joint refresh only needs to run once per frame.
@@ -802,7 +833,7 @@ public:
     // The world matrix is the cached matrix of the node that OWNS the
     // skin — controller/animation placement flows through the node
     // hierarchy, so this is the full world placement the raster path
-    // uses.  Joint matrices are the CPU copies cached by updateJoints.
+    // uses.  Joint matrices are the CPU copies cached by updateNodeJoints.
     const std::shared_ptr<RtSkinSource>& getRtSkinSource() const {
         return rt_skin_source_;
     }
@@ -830,11 +861,27 @@ public:
         bool use_local_matrix_only,
         bool skip_animations = false);
 
+    // Full parent-chain product for one node, recomputed from scratch
+    // (update() refreshes cached_matrix_ through updateHierarchy).
     glm::mat4 getNodeMatrix(
         const int32_t& node_idx,
         bool use_local_matrix_only);
 
-    void updateJoints(
+    // Flag a node whose local transform was just written.  Every writer
+    // of translation_/rotation_/scale_/matrix_ after load must call this
+    // (animation channels, setNodeLocalTRS, setNodeRotationByName,
+    // setRootNodeTransform) or the node keeps its old cached_matrix_.
+    void markNodeDirty(int32_t node_idx);
+
+    // Rebuilds node_order_ / node_subtree_end_ / skinned_nodes_.
+    void buildNodeOrder();
+
+    // One preorder sweep refreshing cached_matrix_ for dirty nodes and
+    // their descendants.  Returns true if any cached_matrix_ changed.
+    bool updateHierarchy(bool use_local_matrix_only);
+
+    // Joint upload for the skin owned by this one node (no recursion).
+    void updateNodeJoints(
         const std::shared_ptr<renderer::Device>& device,
         int32_t node_idx);
 
@@ -1459,6 +1506,7 @@ public:
         if (!object_ || node_idx >= object_->nodes_.size()) return;
         auto& n = object_->nodes_[node_idx];
         n.translation_ = t; n.rotation_ = r; n.scale_ = s;
+        object_->markNodeDirty(int32_t(node_idx));
     }
 
     // Model-space AABB of a SKINNED character derived from its joint
@@ -1786,13 +1834,19 @@ public:
 
     static std::shared_ptr<renderer::BufferInfo> getGameObjectsBuffer();
 
+    // Source-model importers.  CPU work (image decode, per-mesh geometry,
+    // LOD and cluster builds) runs on a shared import pool; device calls
+    // stay on the calling thread.  A raised `cancel` stops the import
+    // between textures / meshes and returns null.
     static std::shared_ptr<DrawableData> loadGltfModel(
         const std::shared_ptr<renderer::Device>& device,
-        const std::string& input_filename);
+        const std::string& input_filename,
+        const std::atomic<bool>* cancel = nullptr);
 
     static std::shared_ptr<DrawableData> loadFbxModel(
         const std::shared_ptr<renderer::Device>& device,
-        const std::string& input_filename);
+        const std::string& input_filename,
+        const std::atomic<bool>* cancel = nullptr);
 
     // Native render-ready asset load: a .rwobj object reference whose
     // baked geometry (.rwgeo v3, sections + .rwtex textures) was written
@@ -1885,9 +1939,17 @@ bool loadPcgWorldManifest(
 // through vkCmdUpdateBuffer (64 B per slot) from the per-frame update
 // pass, with the same barriers every other in-place rewrite uses.
 //
-// Thread contract: load/bind run on asset-load threads, set*/find on
-// gameplay, flushDirty on the render thread — one mutex covers all of
-// it; every call is short.
+// SPATIAL QUERIES.  Gameplay asks "what is near here" every frame from
+// many callers (citizens after benches, a pushed prop after its
+// neighbours, AI after trees), so records are filed in a plan grid
+// sized to the level at load and kept current by setTransform, and node
+// names in a sorted index for the prefix queries and the bind-time name
+// match.
+//
+// Thread contract: load/bind run on asset-load threads, set*/find/query*
+// on gameplay, flushDirty on the render thread — one shared mutex covers
+// all of it, with find and the queries taking it shared so concurrent
+// gameplay readers never serialise; every call is short.
 struct PcgInstanceRecord {
     uint64_t  id = 0;
     uint32_t  node = 0;          // index into the loaded node-name table
@@ -1899,6 +1961,12 @@ struct PcgInstanceRecord {
     float     scale = 1.0f;
 };
 
+struct PcgRadiusQuery {
+    glm::vec3 p{0.0f};
+    float     radius = 0.0f;
+    int       category = -1;     // -1 = every category
+};
+
 class PcgInstanceRegistry {
 public:
     static PcgInstanceRegistry& get();
@@ -1909,23 +1977,40 @@ public:
     bool load(const std::string& json_path);
     void clear();
     size_t size() const;
+    // Content hash of the json the registry was loaded from (0 when
+    // empty) — for caches derived from the records, e.g. the citizens'
+    // furniture anchors in the .rwcity sidecar.
+    uint64_t sourceHash() const;
 
     const PcgInstanceRecord* find(uint64_t id) const;   // nullptr if unknown
     // ids within `radius` of `p` (plan distance), optionally one
-    // category only.  Linear scan — fine for occasional gameplay
-    // queries, wrong inside a per-frame loop over many callers.
+    // category only, in no particular order.  Grid lookup: cost follows
+    // the records near `p`, not the registry size.  Destroyed props are
+    // included, as before — check find(id)->state where it matters.
     std::vector<uint64_t> queryRadius(const glm::vec3& p, float radius,
                                       int category = -1) const;
+    // Every query of a frame under ONE lock: the ids of queries[i] are
+    // out_ids[out_first[i] .. out_first[i + 1]).  Both outputs are
+    // overwritten; pass the same vectors every frame and nothing
+    // allocates once they have grown.
+    void queryRadiusBatch(const std::vector<PcgRadiusQuery>& queries,
+                          std::vector<uint64_t>& out_ids,
+                          std::vector<uint32_t>& out_first) const;
 
     // Every record whose NODE NAME starts with `prefix`, optionally in
     // one category — "obj_bed" over category 4 is every bed the
     // placement stage put in the level, at the transform it was placed
     // at.  Returned BY VALUE: the caller (CitizenSystem, binning
     // furniture to houses at load) keeps the snapshot, and handing out
-    // pointers into recs_ past the lock would be a lie.  Linear scan
-    // like queryRadius — a load-time query, not a per-frame one.
+    // pointers into recs_ past the lock would be a lie.  Records come
+    // in registry order; the matching names are one range of the sorted
+    // name index, so only matching records are visited.
     std::vector<PcgInstanceRecord> queryByNodePrefix(
         const std::string& prefix, int category = -1) const;
+    // queryByNodePrefix for several prefixes under one lock; out[i]
+    // answers prefixes[i].
+    std::vector<std::vector<PcgInstanceRecord>> queryByNodePrefixBatch(
+        const std::vector<std::string>& prefixes, int category = -1) const;
 
     // Runtime state.  setTransform re-places the prop (marks it moving);
     // setState(2) hides every bound GPU slot via a zero-scale rewrite,
@@ -1948,12 +2033,23 @@ private:
     uint64_t posKey(uint32_t node, float x, float z) const;
     BakedInstanceXform xformOf(const PcgInstanceRecord& r) const;
     void queueRecord(uint32_t rec_idx, const BakedInstanceXform& x);
-
-    mutable std::mutex mu_;
+    void buildIndices();                  // caller holds mu_ exclusively
+    void appendRadius(const glm::vec3& p, float radius, int category,
+                      std::vector<uint64_t>& out) const;
+    void appendPrefix(const std::string& prefix, int category,
+                      std::vector<PcgInstanceRecord>& out,
+                      std::vector<uint32_t>& scratch) const;
+
+    mutable std::shared_mutex mu_;
+    uint64_t source_hash_ = 0;
     std::vector<std::string> nodes_;
     std::vector<PcgInstanceRecord> recs_;
     std::unordered_map<uint64_t, uint32_t> by_id_;
     std::unordered_map<uint64_t, uint32_t> by_pos_;   // posKey -> rec idx
+    helper::PlanGrid grid_;                           // rec idx by plan cell
+    std::vector<uint32_t> node_order_;     // node idx sorted by (name, idx)
+    std::vector<uint32_t> node_rec_first_; // CSR: recs of node n are
+    std::vector<uint32_t> node_recs_;      //   node_recs_[first[n]..[n+1])
     struct Binding {
         std::weak_ptr<DrawableData> data;
         uint32_t slot;
@@ -1965,4 +2061,4 @@ private:
 };
 
 } // namespace game_object
-} // namespace engine
\ No newline at end of file
+} // namespace engine
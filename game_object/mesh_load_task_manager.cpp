@@ -8,6 +8,7 @@
 #include <chrono>
 #include <iostream>
 
+#include "helper/engine_helper.h"
 #include "renderer/renderer.h"
 
 namespace engine {
@@ -17,6 +18,12 @@ namespace {
 // Chosen to avoid the 16ms frame budget: if we do find a task whose fence
 // signaled but phase3 takes longer than this, log it as a hitch warning.
 constexpr double kPhase3HitchMs = 4.0;
+
+// Batch submit policy for the worker: submit when the pending queue runs
+// dry, or when the open batch holds this many bytes / is this old, so a
+// long stream of loads still reaches the GPU a few times per frame.
+constexpr uint64_t kFlushBatchBytes = 16ull << 20;
+constexpr double   kFlushBatchAgeMs = 8.0;
 }  // namespace
 
 MeshLoadTaskManager::MeshLoadTaskManager(
@@ -30,6 +37,10 @@ MeshLoadTaskManager::MeshLoadTaskManager(
         std::cout
             << "[MESHLOAD] async path enabled (worker thread + loader queue)"
             << std::endl;
+        upload_scheduler_ = std::make_unique<renderer::UploadScheduler>(
+            device_,
+            device_->getLoaderQueue(),
+            device_->getLoaderCommandPool());
         worker_ = std::thread([this]() { workerLoop(); });
     } else {
         std::cout
@@ -41,8 +52,16 @@ MeshLoadTaskManager::MeshLoadTaskManager(
 MeshLoadTaskManager::~MeshLoadTaskManager() {
     // Flag the worker to stop, wake it up, and join. If no worker was
     // started (sync fallback), just return — there's nothing to clean up.
+    // Queued and half-imported loads are cancelled first: the worker then
+    // drains the queue without running their phase2.
+    cancelAll();
     shutdown_.store(true, std::memory_order_release);
     pending_cv_.notify_all();
+    // A worker throttled on the frame budget would otherwise sit out its
+    // wait with nobody calling poll().
+    if (upload_scheduler_) {
+        upload_scheduler_->releaseThrottle();
+    }
     if (worker_.joinable()) {
         worker_.join();
     }
@@ -51,6 +70,7 @@ MeshLoadTaskManager::~MeshLoadTaskManager() {
     // than aborting mid-copy (which risks use-after-free on buffers the
     // mesh holds shared_ptrs to), block until everything drains.
     waitAll();
+    upload_scheduler_.reset();
 }
 
 std::shared_ptr<MeshLoadTask> MeshLoadTaskManager::submit(
@@ -72,15 +92,14 @@ std::shared_ptr<MeshLoadTask> MeshLoadTaskManager::submit(
         // With async disabled we used the transient compute queue which
         // blocks until the fence signals inside submitAndWaitTransientCommandBuffer,
         // so phase3 can run immediately.
-        if (task->status.load(std::memory_order_acquire) !=
-            MeshLoadStatus::kError &&
-            task->phase3_fn) {
+        const auto phase2_status = task->status.load(std::memory_order_acquire);
+        const bool failed = phase2_status == MeshLoadStatus::kError ||
+                            phase2_status == MeshLoadStatus::kCancelled;
+        if (!failed && task->phase3_fn) {
             task->phase3_fn();
         }
         task->status.store(
-            task->status.load() == MeshLoadStatus::kError
-                ? MeshLoadStatus::kError
-                : MeshLoadStatus::kFinalized,
+            failed ? phase2_status : MeshLoadStatus::kFinalized,
             std::memory_order_release);
         return task;
     }
@@ -94,7 +113,30 @@ std::shared_ptr<MeshLoadTask> MeshLoadTaskManager::submit(
     return task;
 }
 
+void MeshLoadTaskManager::submitTextureMipStreams() {
+    // The worker only reads; nothing here touches the image.  The frames
+    // in flight keep sampling the placeholders until the copy, which is
+    // recorded on a later frame's graphics command buffer behind a
+    // barrier (helper::recordTextureMipUploads) — never on this thread's
+    // transient channel, which would race those frames.
+    for (auto& stream : helper::takeTextureMipStreams()) {
+        submit(
+            stream->ktx2_path,
+            [stream](const std::shared_ptr<renderer::Device>&,
+                     const std::shared_ptr<renderer::CommandBuffer>&,
+                     std::string& error,
+                     const std::atomic<bool>&) {
+                return helper::readTextureMipStream(*stream, error);
+            },
+            [stream]() {
+                helper::queueTextureMipUpload(stream);
+            });
+    }
+}
+
 void MeshLoadTaskManager::poll(size_t max_finalize_per_call) {
+    submitTextureMipStreams();
+
     if (!async_enabled_) {
         // Sync path finalizes inside submit(); nothing to poll.
         return;
@@ -107,6 +149,8 @@ void MeshLoadTaskManager::poll(size_t max_finalize_per_call) {
     //
     // `max_finalize_per_call` (0 == unlimited) caps the batch — see the
     // header comment for the rationale.
+    upload_scheduler_->beginFrame();
+
     std::vector<std::shared_ptr<MeshLoadTask>> ready;
     {
         std::lock_guard<std::mutex> lock(in_flight_mutex_);
@@ -117,7 +161,10 @@ void MeshLoadTaskManager::poll(size_t max_finalize_per_call) {
                 break;
             }
             auto& task = *it;
-            if (task->fence && device_->isFenceSignaled(task->fence)) {
+            const bool done = task->fence
+                ? device_->isFenceSignaled(task->fence)
+                : upload_scheduler_->isComplete(task->upload_ticket);
+            if (done) {
                 ready.push_back(task);
                 it = in_flight_tasks_.erase(it);
             } else {
@@ -212,6 +259,18 @@ void MeshLoadTaskManager::waitAll() {
     }
 }
 
+void MeshLoadTaskManager::cancelAll() {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    auto copy = pending_tasks_;
+    while (!copy.empty()) {
+        copy.front()->cancel();
+        copy.pop();
+    }
+    if (running_task_) {
+        running_task_->cancel();
+    }
+}
+
 void MeshLoadTaskManager::workerLoop() {
     // Register ourselves with the device so the transient command-buffer
     // dispatch in VulkanDevice routes our setup/submit calls to the
@@ -222,9 +281,18 @@ void MeshLoadTaskManager::workerLoop() {
         device_->registerLoaderThread(std::this_thread::get_id());
     }
 
-    // Single-threaded drain loop. One command buffer per task, one fence
-    // per task — simple and safe. If we later see measurable per-task
-    // allocator overhead, we can pool command buffers by length bucket.
+    // Route Helper uploads on this thread into the shared batch, and make
+    // sure that batch is submitted before any transient command buffer
+    // that might read from it.
+    renderer::UploadScheduler::ThreadBinding upload_binding(
+        upload_scheduler_.get());
+    device_->setLoaderTransientPrologue(
+        [this]() { upload_scheduler_->flush(); });
+
+    // Single-threaded drain loop. Tasks accumulate into the scheduler's
+    // open batch; it goes to the GPU when the queue drains or the batch
+    // is big / old enough (see kFlushBatch*).
+    auto batch_opened = std::chrono::high_resolution_clock::now();
     while (true) {
         std::shared_ptr<MeshLoadTask> task;
         {
@@ -235,24 +303,61 @@ void MeshLoadTaskManager::workerLoop() {
             });
             if (shutdown_.load(std::memory_order_acquire) &&
                 pending_tasks_.empty()) {
-                return;
+                break;
             }
             task = pending_tasks_.front();
             pending_tasks_.pop();
+            running_task_ = task;
             // Mark busy WHILE still holding pending_mutex_, so waitAll() (which
             // checks pending-empty + !busy under the same lock) never sees this
             // task vanish between the pending queue and in_flight_.
             worker_busy_.store(true, std::memory_order_release);
         }
+        if (!upload_scheduler_->hasPendingWork()) {
+            batch_opened = std::chrono::high_resolution_clock::now();
+        }
         runPhase2(task);                 // pushes the task into in_flight_
+
+        bool queue_drained;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            running_task_.reset();
+            queue_drained = pending_tasks_.empty();
+        }
+        const double batch_age_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - batch_opened).count();
+        if (queue_drained ||
+            upload_scheduler_->pendingBytes() >= kFlushBatchBytes ||
+            batch_age_ms >= kFlushBatchAgeMs) {
+            upload_scheduler_->flush();
+        }
         worker_busy_.store(false, std::memory_order_release);
     }
+
+    upload_scheduler_->flush();
+    device_->setLoaderTransientPrologue({});
 }
 
 void MeshLoadTaskManager::runPhase2(
     const std::shared_ptr<MeshLoadTask>& task) {
+    if (task->cancel_requested.load(std::memory_order_acquire)) {
+        task->status.store(MeshLoadStatus::kCancelled,
+            std::memory_order_release);
+        std::cout
+            << "[MESHLOAD] cancelled before phase2: '" << task->filename
+            << "'" << std::endl;
+        return;
+    }
     task->status.store(MeshLoadStatus::kRunning, std::memory_order_release);
 
+    // A phase2 that returned false after cancel() was asked to stop; that
+    // is not an error.
+    auto fail_status = [&task]() {
+        return task->cancel_requested.load(std::memory_order_acquire)
+            ? MeshLoadStatus::kCancelled
+            : MeshLoadStatus::kError;
+    };
+
     try {
         if (async_enabled_) {
             // Async path: use the loader command pool + loader queue.
@@ -273,17 +378,22 @@ void MeshLoadTaskManager::runPhase2(
             std::string err;
             bool ok = false;
             if (task->phase2_fn) {
-                ok = task->phase2_fn(device_, task->cmd_buf, err);
+                ok = task->phase2_fn(
+                    device_, task->cmd_buf, err, task->cancel_requested);
             }
 
             if (!ok) {
                 task->error_message =
                     err.empty() ? "phase2_fn returned false" : err;
-                task->status.store(MeshLoadStatus::kError,
+                task->status.store(fail_status(),
                     std::memory_order_release);
                 // End the buffer so Vulkan validation doesn't complain
-                // about a left-open buffer, then let it drop with the task.
+                // about a left-open buffer, and give it back to the pool.
+                // Uploads phase2 already staged stay in the batch; the
+                // resources they target are owned by the task's lambdas.
                 task->cmd_buf->endCommandBuffer();
+                device_->freeCommandBuffers(cmd_pool, { task->cmd_buf });
+                task->cmd_buf.reset();
                 std::cerr
                     << "[MESHLOAD] phase2 error for '" << task->filename
                     << "': " << task->error_message << std::endl;
@@ -292,8 +402,10 @@ void MeshLoadTaskManager::runPhase2(
 
             task->cmd_buf->endCommandBuffer();
 
-            task->fence = device_->createFence(std::source_location::current());
-            device_->getLoaderQueue()->submit({ task->cmd_buf }, task->fence);
+            // No per-task submit or fence: the command buffer rides along in
+            // the scheduler's next batch, after the copies phase2 staged.
+            task->upload_ticket =
+                upload_scheduler_->attachCommandBuffer(task->cmd_buf);
 
             task->status.store(MeshLoadStatus::kGpuSubmitted,
                 std::memory_order_release);
@@ -312,13 +424,14 @@ void MeshLoadTaskManager::runPhase2(
             std::string err;
             bool ok = false;
             if (task->phase2_fn) {
-                ok = task->phase2_fn(device_, cmd_buf, err);
+                ok = task->phase2_fn(
+                    device_, cmd_buf, err, task->cancel_requested);
             }
 
             if (!ok) {
                 task->error_message =
                     err.empty() ? "phase2_fn returned false" : err;
-                task->status.store(MeshLoadStatus::kError,
+                task->status.store(fail_status(),
                     std::memory_order_release);
                 // endCommandBuffer + submitAndWait are driven by the
                 // transient API; we have to close it out to keep the
@@ -336,7 +449,7 @@ void MeshLoadTaskManager::runPhase2(
         }
     } catch (const std::exception& e) {
         task->error_message = std::string("phase2 threw: ") + e.what();
-        task->status.store(MeshLoadStatus::kError,
+        task->status.store(fail_status(),
             std::memory_order_release);
         std::cerr
             << "[MESHLOAD] phase2 exception for '" << task->filename
@@ -7,14 +7,29 @@
 //
 //   Phase 1 (main thread):     construct task shell, enqueue.
 //   Phase 2 (worker thread):   parse file / build CPU buffers /
-//                              create GPU buffers+images / record copies
-//                              / submit to the loader queue with a fence.
-//   Phase 3 (main thread):     after the fence signals, allocate
+//                              create GPU buffers+images / stage uploads
+//                              into the shared UploadScheduler batch.
+//   Phase 3 (main thread):     after the batch's timeline value is
+//                              reached, allocate
 //                              descriptor sets + create pipelines +
 //                              publish the finished object.
 //
-// The main thread polls via poll() once per frame; tasks whose fence has
-// signaled invoke their user-supplied phase3_fn on the polling thread.
+// The main thread polls via poll() once per frame; tasks whose upload
+// ticket has completed invoke their user-supplied phase3_fn on the polling
+// thread.
+//
+// All async tasks share one renderer::UploadScheduler: every Helper upload
+// issued from phase2 lands in a persistent staging ring and one command
+// buffer, and the worker submits that batch (with the tasks' own command
+// buffers) in a single vkQueueSubmit when it runs out of queued work, the
+// batch gets large or old, or a transient submit needs it.  Completion is a
+// timeline-semaphore value, so a burst of streamed .rwobj costs a handful of
+// submits instead of several submit+fence waits per object.
+//
+// Phase 2 may fan its CPU work (decode, mesh processing, cluster builds)
+// out to a thread pool, but every device call stays on the worker: the
+// transient upload channel is routed by thread id.  A task can be
+// cancelled cooperatively — see MeshLoadTask::cancel().
 //
 // If the device does not expose a loader queue (single-queue hardware),
 // submit() falls back to running phase2+phase3 synchronously on the
@@ -32,6 +47,7 @@
 #include <vector>
 
 #include "renderer/renderer.h"
+#include "renderer/upload_scheduler.h"
 
 namespace engine {
 namespace game_object {
@@ -41,9 +57,10 @@ namespace game_object {
 enum class MeshLoadStatus : uint32_t {
     kPending      = 0,   // sitting in the queue
     kRunning      = 1,   // worker is running phase2
-    kGpuSubmitted = 2,   // phase2 finished, fence submitted, waiting
+    kGpuSubmitted = 2,   // phase2 finished, uploads batched, waiting
     kFinalized    = 3,   // phase3 ran, task complete
-    kError        = 4    // phase2 failed; see error_message
+    kError        = 4,   // phase2 failed; see error_message
+    kCancelled    = 5    // cancel() landed before phase2 finished
 };
 
 struct MeshLoadTask {
@@ -53,21 +70,35 @@ struct MeshLoadTask {
     std::atomic<MeshLoadStatus> status{MeshLoadStatus::kPending};
 
     // GPU sync: set by the worker before moving the task to "in-flight".
-    // The main thread polls fence via Device::isFenceSignaled.
+    // Async tasks complete when the upload scheduler's timeline reaches
+    // upload_ticket; `fence` is only set by callers that submit on their own.
     std::shared_ptr<renderer::Fence>         fence;
     std::shared_ptr<renderer::CommandBuffer> cmd_buf;
+    uint64_t                                 upload_ticket = 0;
 
     // Populated on error; readable once status == kError.
     std::string error_message;
 
+    // Cooperative cancellation.  cancel() only raises the flag: a task
+    // still queued is dropped without running phase2, and a running phase2
+    // sees the flag through its `cancel` argument and is expected to stop
+    // between units of work and return false.  Either way phase3 never
+    // runs.  Once phase2 has handed its uploads to the GPU the flag is
+    // ignored — the load completes normally.
+    std::atomic<bool> cancel_requested{false};
+    void cancel() { cancel_requested.store(true, std::memory_order_release); }
+
     // Phase 2 runs on the worker. It receives the device (for buffer /
     // image creation), a recording command buffer pre-begun with the
-    // one-time-submit flag, and an error-string out param. Return true on
-    // success (the manager will endCommandBuffer + submit with fence).
+    // one-time-submit flag, an error-string out param and the task's
+    // cancel flag. Return true on success (the manager will
+    // endCommandBuffer and hand the buffer to the upload scheduler's next
+    // batch).
     using Phase2Fn = std::function<bool(
         const std::shared_ptr<renderer::Device>& /*device*/,
         const std::shared_ptr<renderer::CommandBuffer>& /*cmd_buf*/,
-        std::string& /*error_out*/)>;
+        std::string& /*error_out*/,
+        const std::atomic<bool>& /*cancel*/)>;
 
     // Phase 3 runs on the main thread after the fence has signaled.
     // All descriptor-pool / pipeline work belongs here because those
@@ -101,7 +132,10 @@ public:
         MeshLoadTask::Phase3Fn      phase3_fn);
 
     // Main-thread tick. Runs phase3_fn for any in-flight tasks whose
-    // fence has signaled. Cheap when nothing is ready.
+    // uploads have completed, and opens the upload scheduler's next frame
+    // budget. Cheap when nothing is ready.  Also submits the high-mip
+    // streams of .ktx2 textures queued since the last tick, see
+    // submitTextureMipStreams.
     //
     // `max_finalize_per_call` caps how many ready tasks have their
     // phase3_fn invoked in this poll.  The natural per-frame call should
@@ -119,6 +153,11 @@ public:
     // Useful at shutdown or for the startup-asset barrier.
     void waitAll();
 
+    // cancel() every task still queued or in phase2.  Tasks already waiting
+    // on the GPU are left to finish.  The destructor calls this so a quit
+    // during a big import does not sit out the whole file.
+    void cancelAll();
+
     // HUD-friendly query: count of tasks not yet finalized.
     size_t inFlightCount() const;
 
@@ -136,6 +175,11 @@ private:
     // with a submitted fence; on failure status becomes kError.
     void runPhase2(const std::shared_ptr<MeshLoadTask>& task);
 
+    // One task per .ktx2 texture created from its mip tail since the last
+    // poll (helper::takeTextureMipStreams): phase2 reads the high mips,
+    // phase3 queues them for helper::recordTextureMipUploads.
+    void submitTextureMipStreams();
+
     // Shared across construction / destruction.
     std::shared_ptr<renderer::Device> device_;
     bool                              async_enabled_ = false;
@@ -151,9 +195,17 @@ private:
     // queues and return prematurely (which would let a load finalize against a
     // descriptor pool the caller is about to destroy).
     std::atomic<bool>                             worker_busy_{false};
+    // The task the worker is running phase2 for, so cancelAll() can reach
+    // it.  Guarded by pending_mutex_.
+    std::shared_ptr<MeshLoadTask>                 running_task_;
+
+    // Batched uploads for the async path (nullptr when running inline).
+    // Recording side is owned by the worker thread; poll() only reads the
+    // timeline and ticks the per-frame budget.
+    std::unique_ptr<renderer::UploadScheduler>    upload_scheduler_;
 
-    // Tasks whose phase2 has been submitted to the GPU and are waiting
-    // on their fence. Polled and drained by the main thread.
+    // Tasks whose phase2 has been handed to the GPU and are waiting on
+    // their upload ticket. Polled and drained by the main thread.
     mutable std::mutex                            in_flight_mutex_;
     std::vector<std::shared_ptr<MeshLoadTask>>    in_flight_tasks_;
 
@@ -0,0 +1,375 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// citizen_pose_tests.cpp — standalone unit tests for the citizen render
+// record and its expansion (game_object/citizen_pose.*).
+//
+// Pure CPU: the record is the 24-byte vertex stream the crowd pipeline
+// declares, packs and unpacks within its quantisation, and expands to
+// nothing, one box or six by its flags.  Posed figures land where a
+// person should: standing on the root, flat on a bed, lowered onto a
+// chair.  Then a line-for-line transliteration of citizen_crowd.vert's
+// vertex math is run against the matrices for every corner of every part
+// of a few thousand random records — the GPU and CPU paths must draw the
+// same town.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. game_object/tests/citizen_pose_tests.cpp
+//       game_object/citizen_pose.cpp -o citizen_pose_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "game_object/citizen_pose.h"
+
+using namespace engine::game_object;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static bool near(float a, float b, float eps) { return std::abs(a - b) <= eps; }
+
+static glm::vec3 corner(const CitizenPart& p, float x, float y, float z) {
+    return glm::vec3(p.xform * glm::vec4(x, y, z, 1.0f));
+}
+static glm::vec3 centre(const CitizenPart& p) { return corner(p, 0, 0, 0); }
+
+static CitizenPose standing(int act) {
+    CitizenPose a;
+    a.root = glm::vec3(10.0f, 2.0f, -5.0f);
+    a.act = act;
+    a.duty = 3;
+    a.detailed = true;
+    a.height = 1.75f;
+    a.bulk = 1.0f;
+    return a;
+}
+
+static void testRecordLayout() {
+    // What the crowd pipeline's attribute descriptions assume.
+    CHECK(sizeof(CitizenRecord) == 24);
+    CHECK(offsetof(CitizenRecord, root) == 0);
+    CHECK(offsetof(CitizenRecord, yaw) == 12);
+    CHECK(offsetof(CitizenRecord, phase) == 14);
+    CHECK(offsetof(CitizenRecord, bits) == 16);
+    CHECK(offsetof(CitizenRecord, height) == 20);
+    CHECK(offsetof(CitizenRecord, bulk) == 22);
+    // act and duty fields stay clear of the flags and the seed
+    CHECK((kCitizenDetailed | kCitizenLying | kCitizenSeated |
+           kCitizenHidden) >> 9 == 15u);
+    CHECK(kActWash < 16);
+}
+
+static void testPackRoundTrip() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> ang(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> pos(-3000.0f, 3000.0f);
+    std::uniform_real_distribution<float> size(0.3f, 3.5f);
+    const float two_pi = 6.28318531f, four_pi = 12.56637061f;
+    // one unorm16 step of the widest range, and a little for the wrap
+    const float eps = four_pi / 65535.0f;
+    auto same_angle = [&](float a, float b, float period) {
+        const float d = std::fmod(std::abs(a - b), period);
+        return std::min(d, period - d) <= eps;
+    };
+    for (int i = 0; i < 5000; ++i) {
+        CitizenPose a;
+        a.root = glm::vec3(pos(rng), pos(rng) * 0.01f, pos(rng));
+        a.yaw = ang(rng);
+        a.phase = ang(rng);
+        a.act = i % 10;
+        a.duty = i % 18;
+        a.detailed = i & 1;
+        a.lying = i & 2;
+        a.seated = i & 4;
+        a.hidden = i % 7 == 0;
+        a.seed = citizenSeed(uint32_t(i * 97));
+        a.height = size(rng);
+        a.bulk = size(rng);
+        const CitizenPose b = unpackCitizen(packCitizen(a));
+        CHECK(b.root == a.root);                 // float, not quantised
+        CHECK(same_angle(a.yaw, b.yaw, two_pi));
+        CHECK(same_angle(a.phase, b.phase, two_pi));
+        CHECK(same_angle(a.seed, b.seed, four_pi));
+        CHECK(b.act == a.act && b.duty == a.duty);
+        CHECK(b.detailed == a.detailed && b.lying == a.lying);
+        CHECK(b.seated == a.seated && b.hidden == a.hidden);
+        CHECK(near(b.height, a.height, 1e-4f));
+        CHECK(near(b.bulk, a.bulk, 1e-4f));
+    }
+    // sizes clamp to the range, angles wrap, NaN does not poison the bits
+    CitizenPose a;
+    a.height = 9.0f;
+    a.bulk = -1.0f;
+    a.yaw = -0.5f;
+    a.phase = NAN;
+    const CitizenPose b = unpackCitizen(packCitizen(a));
+    CHECK(b.height == kCitizenSizeRange && b.bulk == 0.0f);
+    CHECK(near(b.yaw, two_pi - 0.5f, 1e-3f));
+    CHECK(b.phase == 0.0f);
+    // the seed is already reduced: a GPU sin never sees a large argument
+    for (uint32_t pid = 0; pid < 200000; pid += 977) {
+        const float s = citizenSeed(pid);
+        CHECK(s >= 0.0f && s < four_pi);
+    }
+}
+
+static void testExpansionCounts() {
+    CitizenPart out[kCitizenParts];
+    CitizenPose a = standing(kActIdle);
+    CHECK(expandCitizen(packCitizen(a), 1.0f, out) == kCitizenParts);
+    a.detailed = false;
+    CHECK(expandCitizen(packCitizen(a), 1.0f, out) == 1);
+    a.hidden = true;
+    a.detailed = true;
+    CHECK(expandCitizen(packCitizen(a), 1.0f, out) == 0);
+
+    // The far box stands on the root and is as tall as the person.
+    a = standing(kActIdle);
+    a.detailed = false;
+    a.yaw = 0.7f;
+    expandCitizen(packCitizen(a), 0.0f, out);
+    CHECK(near(corner(out[0], 0, -1, 0).y, a.root.y, 1e-4f));
+    CHECK(near(corner(out[0], 0, 1, 0).y, a.root.y + 1.75f, 1e-3f));
+    CHECK(near(centre(out[0]).x, a.root.x, 1e-4f));
+    CHECK(near(centre(out[0]).z, a.root.z, 1e-4f));
+    CHECK(out[0].color == glm::vec4(dutyColor(3), 0.12f));
+}
+
+static void testStandingFigure() {
+    CitizenPart out[kCitizenParts];
+    const CitizenPose a = standing(kActIdle);
+    expandCitizen(packCitizen(a), 2.5f, out);
+    // torso, head, arm l/r, leg l/r, upright over the root
+    const float breath = 0.02f;
+    CHECK(near(centre(out[0]).y, a.root.y + 1.18f, breath));
+    CHECK(near(centre(out[1]).y, a.root.y + 1.62f, breath));
+    CHECK(near(centre(out[4]).y, a.root.y + 0.47f, breath));
+    CHECK(near(corner(out[4], 0, -1, 0).y, a.root.y + 0.03f, breath));
+    for (int i = 0; i < 2; ++i) {
+        CHECK(near(centre(out[i]).x, a.root.x, breath));
+        CHECK(near(centre(out[i]).z, a.root.z, breath));
+    }
+    // left is -X at yaw 0, and the head is skin rather than role tint
+    CHECK(centre(out[2]).x < a.root.x && centre(out[3]).x > a.root.x);
+    CHECK(centre(out[4]).x < a.root.x && centre(out[5]).x > a.root.x);
+    CHECK(out[1].color != out[0].color);
+
+    // The pose clock repeats every 4*pi — citizenSeed's reduction
+    // relies on it.
+    CitizenPart later[kCitizenParts];
+    for (int act = 0; act <= kActWash; ++act) {
+        CitizenPose b = standing(act);
+        b.phase = 1.1f;
+        expandCitizen(packCitizen(b), 2.5f, out);
+        expandCitizen(packCitizen(b), 2.5f + 12.56637061f, later);
+        for (int i = 0; i < kCitizenParts; ++i) {
+            const glm::vec3 d = centre(out[i]) - centre(later[i]);
+            CHECK(std::abs(d.x) + std::abs(d.y) + std::abs(d.z) < 1e-3f);
+        }
+    }
+}
+
+static void testLyingAndSeated() {
+    CitizenPart out[kCitizenParts];
+    CitizenPose a = standing(kActSleepish);
+    a.lying = true;
+    a.yaw = 1.5707963f;
+    expandCitizen(packCitizen(a), 0.7f, out);
+    // Flat: every part's centre within a hand of mattress height, the
+    // head a body length from the root along the yaw.
+    for (int i = 0; i < kCitizenParts; ++i) {
+        CHECK(near(centre(out[i]).y, a.root.y + 0.12f, 0.15f));
+    }
+    const glm::vec3 head = centre(out[1]) - a.root;
+    CHECK(std::sqrt(head.x * head.x + head.z * head.z) > 1.5f);
+    // A sleeper without a bed dozes upright.
+    a.lying = false;
+    expandCitizen(packCitizen(a), 0.7f, out);
+    CHECK(near(centre(out[1]).y, a.root.y + 1.62f, 0.03f));
+
+    // Seated: the body drops onto the chair and the thighs go forward.
+    CitizenPose s = standing(kActDeskWork);
+    s.seated = true;
+    expandCitizen(packCitizen(s), 0.7f, out);
+    CHECK(near(centre(out[0]).y, s.root.y + 1.18f - 0.42f, 0.02f));
+    // leg centre swung from below the hip to in front of it (yaw 0)
+    CHECK(near(centre(out[4]).y, s.root.y + 0.90f - 0.42f, 0.08f));
+    CHECK(centre(out[4]).z - s.root.z > 0.35f);
+    // Nothing to sit on: standing, not folded in mid-air.
+    s.seated = false;
+    expandCitizen(packCitizen(s), 0.7f, out);
+    CHECK(near(centre(out[0]).y, s.root.y + 1.18f, 0.02f));
+}
+
+// ── citizen_crowd.vert, transliterated ─────────────────────────────────
+// Kept as close to the GLSL as C++ allows, so a change to one that is
+// not made to the other shows up here as a mismatch.
+static glm::vec3 rotX(glm::vec3 v, float a) {
+    float c = std::cos(a), s = std::sin(a);
+    return glm::vec3(v.x, c * v.y - s * v.z, s * v.y + c * v.z);
+}
+static glm::vec3 rotY(glm::vec3 v, float a) {
+    float c = std::cos(a), s = std::sin(a);
+    return glm::vec3(c * v.x + s * v.z, v.y, -s * v.x + c * v.z);
+}
+
+static glm::vec3 shaderVertex(const CitizenRecord& r, float anim_t,
+                              int part, glm::vec3 in_position) {
+    const float kTwoPi = 6.28318531f, kFourPi = 12.56637061f;
+    const glm::vec3 in_root(r.root[0], r.root[1], r.root[2]);
+    float yaw = r.yaw / 65535.0f * kTwoPi;
+    float phase = r.phase / 65535.0f * kTwoPi;
+    int act = int(r.bits & 15u);
+    float seed = float(r.bits >> 16) / 65535.0f * kFourPi;
+    float s = r.height / 65535.0f * kCitizenSizeRange / 1.75f;
+    float bw = r.bulk / 65535.0f * kCitizenSizeRange;
+    bool walking = act == kActWalk;
+
+    if ((r.bits & kCitizenDetailed) == 0u) {
+        float bob = walking ? std::abs(std::cos(phase)) * 0.03f * s : 0.0f;
+        glm::vec3 local = in_position * glm::vec3(0.20f * s * bw, 0.875f * s,
+                                                  0.13f * s * bw) +
+                          glm::vec3(0.0f, 0.875f * s, 0.0f);
+        return rotY(local, yaw) + in_root + glm::vec3(0.0f, bob, 0.0f);
+    }
+    bool lying = (r.bits & kCitizenLying) != 0u;
+    bool seated = (r.bits & kCitizenSeated) != 0u;
+    float swing = std::sin(phase);
+    float anim_phase = anim_t + seed;
+    float root_y = in_root.y;
+    float pitch = 0.0f;
+    float leg_l = 0.0f, leg_r = 0.0f, arm_l = 0.0f, arm_r = 0.0f;
+    bool sitting = false;
+    if (act == kActWalk) {
+        leg_l = swing * 0.55f;
+        leg_r = -swing * 0.55f;
+        arm_l = -swing * 0.45f;
+        arm_r = swing * 0.45f;
+        root_y += std::abs(std::cos(phase)) * 0.03f * s;
+    } else if (act == kActSleepish) {
+        if (lying) {
+            pitch = -1.5707963f;
+            root_y += 0.12f * s;
+        } else {
+            arm_l = arm_r = 0.04f * std::sin(anim_phase * 0.5f);
+        }
+    } else if (act == kActSit || act == kActDeskWork) {
+        if (seated) {
+            sitting = true;
+            leg_l = leg_r = -1.45f;
+            arm_l = arm_r = act == kActDeskWork ? -0.9f : -0.4f;
+        } else {
+            arm_l = arm_r = 0.10f * std::sin(anim_phase * 0.5f);
+        }
+    } else if (act == kActCook) {
+        arm_r = -1.1f + 0.25f * std::sin(anim_t * 4.0f + phase);
+        arm_l = -0.5f;
+        pitch = 0.12f;
+    } else if (act == kActBrowse) {
+        arm_r = -0.9f;
+        pitch = 0.08f;
+    } else if (act == kActWash) {
+        arm_l = -1.15f + 0.10f * std::sin(anim_phase * 3.0f);
+        arm_r = -1.15f - 0.10f * std::sin(anim_phase * 3.0f);
+        pitch = 0.15f;
+    } else if (act == kActCare) {
+        arm_l = -0.7f + 0.2f * std::sin(anim_phase * 2.0f);
+        pitch = 0.16f;
+    } else if (act == kActPlay) {
+        arm_l = std::sin(anim_t * 5.0f + phase) * 0.8f;
+        arm_r = -std::sin(anim_t * 5.0f + phase) * 0.8f;
+    } else {
+        arm_l = arm_r = 0.10f * std::sin(anim_phase * 0.5f);
+    }
+    if (!walking) {
+        float br = std::sin(anim_phase * 1.5f);
+        if (!lying) pitch += 0.015f * br;
+        root_y += 0.008f * s * br;
+    }
+    if (sitting) root_y -= 0.42f * s;
+
+    glm::vec3 centre, half_ext, pivot(0.0f);
+    float rot = 0.0f;
+    if (part == 0) {
+        centre = glm::vec3(0.0f, 1.18f * s, 0.0f);
+        half_ext = glm::vec3(0.17f * s * bw, 0.27f * s, 0.11f * s * bw);
+    } else if (part == 1) {
+        centre = glm::vec3(0.0f, 1.62f * s, 0.0f);
+        half_ext = glm::vec3(0.105f * s, 0.115f * s, 0.105f * s);
+    } else if (part <= 3) {
+        float side = part == 2 ? -1.0f : 1.0f;
+        centre = glm::vec3(side * 0.235f * s * bw, 1.14f * s, 0.0f);
+        half_ext = glm::vec3(0.05f * s, 0.27f * s, 0.05f * s);
+        pivot = glm::vec3(centre.x, 1.40f * s, 0.0f);
+        rot = part == 2 ? arm_l : arm_r;
+    } else {
+        float side = part == 4 ? -1.0f : 1.0f;
+        centre = glm::vec3(side * 0.09f * s, 0.47f * s, 0.0f);
+        half_ext = glm::vec3(0.07f * s * bw, 0.44f * s, 0.07f * s * bw);
+        pivot = glm::vec3(centre.x, 0.90f * s, 0.0f);
+        rot = part == 4 ? leg_l : leg_r;
+    }
+    glm::vec3 local = in_position * half_ext + centre;
+    if (rot != 0.0f) local = pivot + rotX(local - pivot, rot);
+    return rotY(rotX(local, pitch), yaw) +
+           glm::vec3(in_root.x, root_y, in_root.z);
+}
+
+static void testShaderMatchesReference() {
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    CitizenPart out[kCitizenParts];
+    float worst = 0.0f;
+    for (int i = 0; i < 4000; ++i) {
+        CitizenPose a;
+        a.root = glm::vec3(u(rng) * 4000.0f - 2000.0f, u(rng) * 30.0f,
+                           u(rng) * 4000.0f - 2000.0f);
+        a.yaw = u(rng) * 6.2831853f;
+        a.phase = u(rng) * 6.2831853f;
+        a.act = i % (kActWash + 1);
+        a.duty = i % 18;
+        a.detailed = i % 5 != 0;
+        a.lying = (i / 3) % 2 == 0;
+        a.seated = (i / 7) % 2 == 0;
+        a.seed = citizenSeed(uint32_t(i));
+        a.height = 1.1f + u(rng) * 0.9f;
+        a.bulk = 0.8f + u(rng) * 0.5f;
+        const CitizenRecord r = packCitizen(a);
+        const float anim_t = u(rng) * 300.0f;
+        const int n = expandCitizen(r, anim_t, out);
+        for (int p = 0; p < n; ++p) {
+            for (int c = 0; c < 8; ++c) {
+                const glm::vec3 v(c & 1 ? 1.0f : -1.0f, c & 2 ? 1.0f : -1.0f,
+                                  c & 4 ? 1.0f : -1.0f);
+                const glm::vec3 d =
+                    corner(out[p], v.x, v.y, v.z) - shaderVertex(r, anim_t, p, v);
+                worst = std::max({ worst, std::abs(d.x), std::abs(d.y),
+                                   std::abs(d.z) });
+            }
+        }
+    }
+    // float error at 2 km from the origin, nothing more
+    CHECK(worst < 1e-3f);
+    std::printf("  shader vs reference: worst corner error %.2e m\n", worst);
+}
+
+int main() {
+    testRecordLayout();
+    testPackRoundTrip();
+    testExpansionCounts();
+    testStandingFigure();
+    testLyingAndSeated();
+    testShaderMatchesReference();
+    std::printf("citizen_pose_tests: %d checks passed\n", g_checks);
+    return 0;
+}
@@ -2,12 +2,15 @@
 
 #include <array>
 #include <chrono>
+#include <cstdlib>
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "helper/model_inspect.h"
@@ -81,6 +84,118 @@ private:
     std::chrono::steady_clock::time_point last_{};
 };
 
+// ── Skip-if-unchanged ────────────────────────────────────────────────────
+// A library re-import hands over every source again, and most have not
+// changed.  import.rwmeta records what the group was baked from — the
+// source's size, mtime and content hash, the same stamp for every
+// external file the bake read (textures, glTF .bin buffers), the import
+// mode and the bake version — and a source whose stamps all still match
+// is skipped outright: no parse, no bake, no sidecar rewrites.  Size +
+// mtime are checked first so an untouched multi-GB source is not even
+// read; a touched-but-identical file costs one hash and still skips.
+// Sources that did change go through the bake, which skips again per
+// texture and per object (bake.manifest), so one repainted texture
+// re-encodes one texture.
+struct SourceStamp {
+    unsigned long long size  = 0;
+    long long          mtime = 0;
+    std::string        hash;            // 16 hex chars; empty = unread
+};
+
+SourceStamp statSource(const std::filesystem::path& p) {
+    SourceStamp st;
+    std::error_code ec;
+    st.size = (unsigned long long)std::filesystem::file_size(p, ec);
+    const auto t = std::filesystem::last_write_time(p, ec);
+    if (!ec) st.mtime = (long long)t.time_since_epoch().count();
+    return st;
+}
+
+bool hashSource(const std::filesystem::path& p, SourceStamp& st) {
+    uint64_t h = 0;
+    if (!stableFileHash(p.string(), h)) return false;
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)h);
+    st.hash = hex;
+    return true;
+}
+
+// True when the file at `p` still matches the recorded stamp.  `st` is
+// the fresh stat; its hash is filled in whenever it is known.
+bool stampMatches(const std::filesystem::path& p, SourceStamp& st,
+                  const std::string& size, const std::string& mtime,
+                  const std::string& hash) {
+    if (size != std::to_string(st.size) || hash.empty()) return false;
+    if (mtime == std::to_string(st.mtime)) {
+        st.hash = hash;
+        return true;
+    }
+    return hashSource(p, st) && st.hash == hash;
+}
+
+// An external file the bake reads besides the source itself.
+struct DependencyStamp {
+    std::string path;                   // portable, as written to rwmeta
+    SourceStamp stamp;
+};
+
+std::unordered_map<std::string, std::string> readMeta(
+    const std::filesystem::path& path) {
+    std::unordered_map<std::string, std::string> kv;
+    std::ifstream in(path);
+    std::string line;
+    while (in && std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        const size_t eq = line.find('=');
+        if (eq != std::string::npos)
+            kv.emplace(line.substr(0, eq), line.substr(eq + 1));
+    }
+    return kv;
+}
+
+// True when `group_dir` already holds this exact import.  Fills in
+// st.hash whenever it had to read the source.  Dependencies are the ones
+// recorded by the last bake ("dependency.<k>=<size> <mtime> <hash>
+// <path>"); one that changed or disappeared forces a re-bake.
+bool groupIsCurrent(const std::filesystem::path& src,
+                    const std::filesystem::path& group_dir,
+                    const std::string& mode, SourceStamp& st) {
+    std::error_code ec;
+    if (!std::filesystem::exists(group_dir / "bake.manifest", ec))
+        return false;
+    const auto meta = readMeta(group_dir / "import.rwmeta");
+    auto get = [&](const std::string& k) {
+        const auto it = meta.find(k);
+        return it == meta.end() ? std::string() : it->second;
+    };
+    if (get("import_mode") != mode ||
+        get("bake_version") != renderReadyBakeVersion())
+        return false;
+    // Sidecars from before dependencies were recorded cannot vouch for
+    // the textures; bake once more to write them.
+    const std::string dep_count_s = get("dependency_count");
+    if (dep_count_s.empty()) return false;
+    if (!stampMatches(src, st, get("source_size"), get("source_mtime"),
+                      get("source_hash")))
+        return false;
+
+    const unsigned long dep_count =
+        std::strtoul(dep_count_s.c_str(), nullptr, 10);
+    for (unsigned long k = 0; k < dep_count; ++k) {
+        const std::string rec = get("dependency." + std::to_string(k));
+        std::istringstream ss(rec);
+        std::string size, mtime, hash, path;
+        if (!(ss >> size >> mtime >> hash)) return false;
+        std::getline(ss >> std::ws, path);
+        if (path.empty() ||
+            !std::filesystem::is_regular_file(path, ec))
+            return false;
+        SourceStamp dep = statSource(path);
+        if (!stampMatches(path, dep, size, mtime, hash)) return false;
+    }
+    return true;
+}
+
 // Replace this group's rows in content/asset_index.tsv (stable IDs make
 // re-imports idempotent), append the fresh ones.  Columns:
 //   id <TAB> type <TAB> name <TAB> path
@@ -224,6 +339,33 @@ bool importOneAssetToContent(const std::string& chosen,
     // rebuilds the instanced drawable from exactly these files, bands
     // and world-manifest bindings intact.  glTF is a SOURCE format; it
     // never lands in content/.
+    const fs::path group_dir = fs::path(import_dir) / src.stem();
+    const std::string bake_mode = (mode == "group") ? mode : "bake";
+    SourceStamp stamp = statSource(src);
+    if (groupIsCurrent(src, group_dir, bake_mode, stamp)) {
+        std::cout << "[import] '" << chosen << "' unchanged since the "
+                  << "last import — kept '" << group_dir.generic_string()
+                  << "'" << std::endl;
+        return true;
+    }
+    if (stamp.hash.empty() && !hashSource(src, stamp)) {
+        std::cerr << "[import] cannot read '" << chosen << "'" << std::endl;
+        return false;
+    }
+    // Stamped BEFORE the bake, like the source: an edit that lands while
+    // the bake runs just makes the next import bake again.
+    std::vector<DependencyStamp> dep_stamps;
+    for (const auto& [rel, abs] : listModelFileDependencies(chosen)) {
+        DependencyStamp d;
+        d.path = portablePath(abs);
+        d.stamp = statSource(abs);
+        if (!hashSource(abs, d.stamp)) {
+            std::cerr << "[import] cannot read dependency '" << abs
+                      << "' of '" << chosen << "'" << std::endl;
+            return false;
+        }
+        dep_stamps.push_back(std::move(d));
+    }
     const bool instanced = modelHasGpuInstancing(chosen);
     // Generated terrain is never skinned, but guard anyway: the static
     // bake would freeze a rig.
@@ -233,7 +375,6 @@ bool importOneAssetToContent(const std::string& chosen,
                   << std::endl;
         return importOneAssetToContent(chosen, import_dir, "copy");
     }
-    const fs::path group_dir = fs::path(import_dir) / src.stem();
     std::vector<BakedObject> baked;
     // Publish per-object progress for whoever is watching (the stage
     // runner polls the sidecar while its blocking DLL call runs).  The
@@ -312,27 +453,6 @@ bool importOneAssetToContent(const std::string& chosen,
             }
         }
     }
-    {
-        std::ofstream meta((group_dir / "import.rwmeta").string(),
-                           std::ios::trunc);
-        meta << "id=" << group_id << "\n"
-             << "guid=" << guid << "\n"
-             << "source=" << portablePath(chosen) << "\n"
-             << "imported_unix=" << (long long)now_t << "\n";
-        if (wrote_rwinst) {
-            // main= is what the group placement resolves: ONE scene
-            // object built by the native instanced loader — never one
-            // object per node, which is what per-node .rwobj files
-            // would produce for a group with thousands of instances.
-            meta << "type=instanced_group\n"
-                 << "main=instances.rwinst\n";
-        } else {
-            meta << "type=model_group\n";
-        }
-        meta << "subobjects_baked=1\n";
-        for (const auto& b : baked) meta << "subobject=" << b.name << "\n";
-    }
-
     auto sanitize = [](std::string s2) {
         for (auto& ch : s2) {
             if (ch == '/' || ch == '\\' || ch == ':' || ch == '*' ||
@@ -389,6 +509,39 @@ bool importOneAssetToContent(const std::string& chosen,
         }
     }
     updateAssetIndex(group_rel, index_rows);
+    // Written LAST: its source stamp is what a later import trusts to
+    // skip this group, so it must not claim a bake that did not finish.
+    {
+        std::ofstream meta((group_dir / "import.rwmeta").string(),
+                           std::ios::trunc);
+        meta << "id=" << group_id << "\n"
+             << "guid=" << guid << "\n"
+             << "source=" << portablePath(chosen) << "\n"
+             << "imported_unix=" << (long long)now_t << "\n"
+             << "import_mode=" << bake_mode << "\n"
+             << "bake_version=" << renderReadyBakeVersion() << "\n"
+             << "source_size=" << stamp.size << "\n"
+             << "source_mtime=" << stamp.mtime << "\n"
+             << "source_hash=" << stamp.hash << "\n"
+             << "dependency_count=" << dep_stamps.size() << "\n";
+        for (size_t k = 0; k < dep_stamps.size(); ++k) {
+            const SourceStamp& ds = dep_stamps[k].stamp;
+            meta << "dependency." << k << "=" << ds.size << ' ' << ds.mtime
+                 << ' ' << ds.hash << ' ' << dep_stamps[k].path << "\n";
+        }
+        if (wrote_rwinst) {
+            // main= is what the group placement resolves: ONE scene
+            // object built by the native instanced loader — never one
+            // object per node, which is what per-node .rwobj files
+            // would produce for a group with thousands of instances.
+            meta << "type=instanced_group\n"
+                 << "main=instances.rwinst\n";
+        } else {
+            meta << "type=model_group\n";
+        }
+        meta << "subobjects_baked=1\n";
+        for (const auto& b : baked) meta << "subobject=" << b.name << "\n";
+    }
     std::cout << "[import] baked '" << chosen << "' -> "
               << baked.size() << " render-ready object(s) in '"
               << group_dir.generic_string() << "'  (group id " << group_id
@@ -0,0 +1,445 @@
+//
+// asset_index.cpp — background directory index + change watching for the
+// editor browsers.  See asset_index.h for the model.
+//
+#include "asset_index.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+namespace helper {
+
+namespace fs = std::filesystem;
+
+namespace {
+// How long the index thread sleeps between mtime sweeps when the platform
+// gives us no change notifications.
+constexpr int kPollIntervalMs = 1000;
+
+std::string lowerExt(const std::string& name) {
+    std::string ext = fs::path(name).extension().string();
+    for (auto& c : ext) c = (char)std::tolower((unsigned char)c);
+    return ext;
+}
+}  // namespace
+
+// Everything known about one directory.  `all` holds every on-disk entry
+// (including the ones the snapshot hides — the ".disabled" markers are
+// needed to flag their targets).  Mutated only by the index thread (in
+// place) or replaced wholesale by install().
+struct AssetIndex::DirModel {
+    bool exists = false;
+    std::map<std::string, AssetIndexEntry> all;
+    fs::file_time_type dir_mtime{};
+    int wd = -1;
+    uint64_t last_used = 0;
+    std::shared_ptr<const AssetDirectorySnapshot> snap;
+};
+
+AssetIndex::AssetIndex(const AssetIndexOptions& options)
+    : options_(options) {
+    watchInit();
+    worker_ = std::thread([this]() { workerLoop(); });
+}
+
+AssetIndex::~AssetIndex() {
+    stop_.store(true, std::memory_order_release);
+    cv_.notify_all();
+    wake();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    watchShutdown();
+}
+
+std::shared_ptr<const AssetDirectorySnapshot> AssetIndex::snapshot(
+    const std::string& dir) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = dirs_.find(dir);
+        if (it != dirs_.end()) {
+            it->second->last_used = ++use_clock_;
+            return it->second->snap;
+        }
+        if (std::find(scan_queue_.begin(), scan_queue_.end(), dir) ==
+            scan_queue_.end()) {
+            scan_queue_.push_back(dir);
+        }
+    }
+    cv_.notify_one();
+    wake();
+    return nullptr;
+}
+
+void AssetIndex::rescan(const std::string& dir) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (dirs_.find(dir) == dirs_.end()) {
+            return;
+        }
+    }
+    install(dir, scanDirectory(dir));
+}
+
+size_t AssetIndex::directoryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dirs_.size();
+}
+
+bool AssetIndex::makeEntry(const std::string& dir,
+                           const std::string& name,
+                           AssetIndexEntry& out) const {
+    const fs::path p = fs::path(dir) / name;
+    std::error_code ec;
+    const fs::file_status st = fs::status(p, ec);
+    if (ec || !fs::exists(st)) {
+        return false;
+    }
+
+    out = AssetIndexEntry{};
+    out.name   = name;
+    out.path   = p.string();
+    out.is_dir = fs::is_directory(st);
+    if (!out.is_dir) {
+        out.ext = lowerExt(name);
+        if (fs::is_regular_file(st)) {
+            out.size = fs::file_size(p, ec);
+            if (ec) out.size = 0;
+        }
+    } else {
+        std::error_code mec;
+        out.is_group_dir   = fs::exists(p / "import.rwmeta", mec);
+        out.is_terrain_dir = fs::exists(p / "terrain.rwmeta", mec);
+    }
+    const auto mt = fs::last_write_time(p, ec);
+    out.mtime = ec ? 0 : (int64_t)mt.time_since_epoch().count();
+    return true;
+}
+
+std::shared_ptr<AssetIndex::DirModel> AssetIndex::scanDirectory(
+    const std::string& dir) const {
+    auto model = std::make_shared<DirModel>();
+    std::error_code ec;
+    model->exists = fs::is_directory(dir, ec);
+    if (!model->exists) {
+        return model;
+    }
+    model->dir_mtime = fs::last_write_time(dir, ec);
+    for (auto it = fs::directory_iterator(dir, ec);
+         !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        const std::string name = it->path().filename().string();
+        AssetIndexEntry e;
+        if (makeEntry(dir, name, e)) {
+            model->all.emplace(name, std::move(e));
+        }
+    }
+    return model;
+}
+
+std::shared_ptr<const AssetDirectorySnapshot> AssetIndex::publish(
+    const std::string& dir, const DirModel& model,
+    uint64_t generation) const {
+    auto snap = std::make_shared<AssetDirectorySnapshot>();
+    snap->dir = dir;
+    snap->exists = model.exists;
+    snap->generation = generation;
+
+    std::vector<AssetIndexEntry> files;
+    for (const auto& kv : model.all) {
+        const AssetIndexEntry& src = kv.second;
+        if (!src.name.empty() && src.name[0] == '.') continue;
+        if (options_.is_far_lod && options_.is_far_lod(src)) {
+            ++snap->far_lod_hidden;
+            continue;
+        }
+        if (options_.include && !options_.include(src)) continue;
+        AssetIndexEntry e = src;
+        e.disabled = model.all.count(src.name + ".disabled") != 0;
+        (e.is_dir ? snap->entries : files).push_back(std::move(e));
+    }
+    // std::map iteration is already name-ordered; dirs were appended first.
+    snap->dir_count = snap->entries.size();
+    snap->entries.insert(snap->entries.end(),
+                         std::make_move_iterator(files.begin()),
+                         std::make_move_iterator(files.end()));
+    return snap;
+}
+
+void AssetIndex::install(const std::string& dir,
+                         std::shared_ptr<DirModel> model) {
+    // Numbered under the lock: rescan() on the UI thread and the index
+    // thread may install the same directory at once, and each snapshot
+    // must still get a number nobody has seen.
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = ++generation_clock_;
+    }
+    auto snap = publish(dir, *model, generation);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = dirs_.find(dir);
+    if (it != dirs_.end()) {
+        model->wd = it->second->wd;
+        model->last_used = it->second->last_used;
+    } else {
+        model->last_used = ++use_clock_;
+    }
+    if (model->exists && model->wd < 0) {
+        model->wd = watchAdd(dir);
+    }
+    model->snap = std::move(snap);
+    dirs_[dir] = std::move(model);
+}
+
+void AssetIndex::evictLocked() {
+    if (dirs_.size() <= options_.max_directories) {
+        return;
+    }
+    std::vector<std::pair<uint64_t, std::string>> order;
+    order.reserve(dirs_.size());
+    for (const auto& kv : dirs_) {
+        order.emplace_back(kv.second->last_used, kv.first);
+    }
+    std::sort(order.begin(), order.end());
+    const size_t drop = dirs_.size() - options_.max_directories;
+    for (size_t i = 0; i < drop; ++i) {
+        auto it = dirs_.find(order[i].second);
+        if (it->second->wd >= 0) {
+            watchRemove(it->second->wd);
+        }
+        dirs_.erase(it);
+    }
+}
+
+// Re-stat one entry of an indexed directory and republish it.
+void AssetIndex::applyEntryChange(const std::string& dir,
+                                  const std::string& name) {
+    std::shared_ptr<DirModel> model;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = dirs_.find(dir);
+        if (it == dirs_.end()) return;
+        model = it->second;
+    }
+
+    AssetIndexEntry e;
+    const bool present = makeEntry(dir, name, e);
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (present) {
+            model->all[name] = std::move(e);
+        } else {
+            model->all.erase(name);
+        }
+        generation = ++generation_clock_;
+    }
+    // Only this thread mutates `all` in place, so publishing outside the
+    // lock is safe; a concurrent rescan() replaces the model instead.
+    auto snap = publish(dir, *model, generation);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = dirs_.find(dir);
+    if (it != dirs_.end() && it->second == model) {
+        model->snap = std::move(snap);
+    }
+}
+
+void AssetIndex::pollDirectoryTimes() {
+    std::vector<std::pair<std::string, fs::file_time_type>> dirs;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dirs.reserve(dirs_.size());
+        for (const auto& kv : dirs_) {
+            dirs.emplace_back(kv.first, kv.second->dir_mtime);
+        }
+    }
+    for (const auto& d : dirs) {
+        if (stop_.load(std::memory_order_acquire)) return;
+        std::error_code ec;
+        const bool exists = fs::is_directory(d.first, ec);
+        const auto mt = exists ? fs::last_write_time(d.first, ec)
+                               : fs::file_time_type{};
+        if (mt != d.second) {
+            install(d.first, scanDirectory(d.first));
+        }
+    }
+}
+
+void AssetIndex::workerLoop() {
+    while (!stop_.load(std::memory_order_acquire)) {
+        std::vector<std::string> todo;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            todo.swap(scan_queue_);
+        }
+        for (const auto& dir : todo) {
+            if (stop_.load(std::memory_order_acquire)) return;
+            install(dir, scanDirectory(dir));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            evictLocked();
+        }
+
+        if (!watchPoll(kPollIntervalMs)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            const bool woke = cv_.wait_for(
+                lock, std::chrono::milliseconds(kPollIntervalMs), [this]() {
+                    return stop_.load(std::memory_order_acquire) ||
+                           !scan_queue_.empty();
+                });
+            lock.unlock();
+            if (!woke) {
+                pollDirectoryTimes();
+            }
+        }
+    }
+}
+
+#ifdef __linux__
+
+void AssetIndex::watchInit() {
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0 && pipe2(wake_pipe_, O_NONBLOCK | O_CLOEXEC) != 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+}
+
+void AssetIndex::watchShutdown() {
+    if (inotify_fd_ >= 0) close(inotify_fd_);
+    if (wake_pipe_[0] >= 0) close(wake_pipe_[0]);
+    if (wake_pipe_[1] >= 0) close(wake_pipe_[1]);
+    inotify_fd_ = -1;
+    wake_pipe_[0] = wake_pipe_[1] = -1;
+}
+
+int AssetIndex::watchAdd(const std::string& dir) {
+    if (inotify_fd_ < 0) return -1;
+    const int wd = inotify_add_watch(
+        inotify_fd_, dir.c_str(),
+        IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+        IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF |
+        IN_ONLYDIR);
+    if (wd >= 0) {
+        wd_to_dir_[wd] = dir;
+    }
+    return wd;
+}
+
+void AssetIndex::watchRemove(int wd) {
+    if (inotify_fd_ < 0) return;
+    inotify_rm_watch(inotify_fd_, wd);
+    wd_to_dir_.erase(wd);
+}
+
+void AssetIndex::wake() {
+    if (wake_pipe_[1] >= 0) {
+        const char b = 1;
+        (void)!write(wake_pipe_[1], &b, 1);
+    }
+}
+
+bool AssetIndex::watchPoll(int timeout_ms) {
+    if (inotify_fd_ < 0) return false;
+
+    pollfd fds[2] = {
+        { inotify_fd_,   POLLIN, 0 },
+        { wake_pipe_[0], POLLIN, 0 },
+    };
+    if (poll(fds, 2, timeout_ms) <= 0) return true;
+
+    if (fds[1].revents & POLLIN) {
+        char drain[64];
+        while (read(wake_pipe_[0], drain, sizeof(drain)) > 0) {}
+    }
+    if (!(fds[0].revents & POLLIN)) return true;
+
+    // Collect (dir, name) pairs first so a burst of events on one file
+    // (create + several writes + close) costs one stat.
+    std::vector<std::pair<std::string, std::string>> changes;
+    std::vector<std::string> rescans;
+    alignas(inotify_event) char buf[64 * 1024];
+    for (;;) {
+        const ssize_t n = read(inotify_fd_, buf, sizeof(buf));
+        if (n <= 0) break;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (ssize_t off = 0; off < n;) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(buf + off);
+            off += sizeof(inotify_event) + ev->len;
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                // Lost events: trust nothing, re-scan everything indexed.
+                for (const auto& kv : dirs_) rescans.push_back(kv.first);
+                continue;
+            }
+            auto it = wd_to_dir_.find(ev->wd);
+            if (it == wd_to_dir_.end()) continue;
+            const std::string& dir = it->second;
+            if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                rescans.push_back(dir);
+                if (ev->mask & IN_IGNORED) {
+                    auto dit = dirs_.find(dir);
+                    if (dit != dirs_.end()) dit->second->wd = -1;
+                    wd_to_dir_.erase(it);
+                }
+                continue;
+            }
+            if (ev->len == 0) continue;
+            const std::string name(ev->name);
+            changes.emplace_back(dir, name);
+            // A group / terrain marker appearing or vanishing changes how
+            // the PARENT lists this folder.
+            if (name == "import.rwmeta" || name == "terrain.rwmeta") {
+                const fs::path d(dir);
+                changes.emplace_back(d.parent_path().string(),
+                                     d.filename().string());
+            }
+        }
+    }
+
+    std::sort(changes.begin(), changes.end());
+    changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+    std::sort(rescans.begin(), rescans.end());
+    rescans.erase(std::unique(rescans.begin(), rescans.end()), rescans.end());
+
+    for (const auto& dir : rescans) {
+        if (stop_.load(std::memory_order_acquire)) return true;
+        install(dir, scanDirectory(dir));
+    }
+    for (const auto& c : changes) {
+        if (stop_.load(std::memory_order_acquire)) return true;
+        if (std::binary_search(rescans.begin(), rescans.end(), c.first)) {
+            continue;
+        }
+        applyEntryChange(c.first, c.second);
+    }
+    return true;
+}
+
+#else  // !__linux__ — no change notifications; pollDirectoryTimes() covers it.
+
+void AssetIndex::watchInit() {}
+void AssetIndex::watchShutdown() {}
+int  AssetIndex::watchAdd(const std::string&) { return -1; }
+void AssetIndex::watchRemove(int) {}
+void AssetIndex::wake() {}
+bool AssetIndex::watchPoll(int) { return false; }
+
+#endif
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,147 @@
+#pragma once
+//
+// asset_index.h — background, watched directory index for the editor's
+// Content / File Browser.
+//
+// The browser grid used to run fs::directory_iterator over the browsed
+// folder every ImGui frame, classify every entry, test each one for a
+// ".disabled" sidecar and each sub-folder for import.rwmeta/terrain.rwmeta,
+// then sort the lot.  On a baked group folder with tens of thousands of
+// .rwgeo/.rwtex that is several milliseconds and thousands of stat() calls
+// per frame.
+//
+// AssetIndex moves all of that off the UI thread:
+//   - a directory is scanned ONCE, on the index thread, the first time the
+//     UI asks for it;
+//   - the result is published as an immutable, sorted AssetDirectorySnapshot
+//     (dirs first, then files, by name) that the UI holds by shared_ptr and
+//     can draw — clipped — in O(visible rows);
+//   - on Linux each indexed directory gets an inotify watch and single
+//     entries are re-stat'ed as events arrive; elsewhere the index thread
+//     re-scans a directory when its mtime moves (checked about once a
+//     second);
+//   - editor actions that change the disk (rename, delete, import, toggle)
+//     call rescan() so the next frame already shows the result.
+//
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+namespace helper {
+
+struct AssetIndexEntry {
+    std::string name;            // file name, no directory
+    std::string path;            // full path as passed to the index
+    std::string ext;             // lower-case, with the dot ("" for dirs)
+    bool        is_dir = false;
+    // Folder holding import.rwmeta (placeable import group).
+    bool        is_group_dir = false;
+    // Folder holding terrain.rwmeta (generated terrain).
+    bool        is_terrain_dir = false;
+    // A "<name>.disabled" sidecar sits next to this entry.
+    bool        disabled = false;
+    uint64_t    size = 0;
+    int64_t     mtime = 0;       // file_time_type ticks since its epoch
+};
+
+struct AssetDirectorySnapshot {
+    std::string                  dir;
+    bool                         exists = false;
+    // Visible entries: directories first, then files, each sorted by name.
+    std::vector<AssetIndexEntry> entries;
+    size_t                       dir_count = 0;
+    // Entries dropped by AssetIndexOptions::is_far_lod.
+    size_t                       far_lod_hidden = 0;
+    // Grows with every republish (unique across the index); lets callers
+    // cache derived data.
+    uint64_t                     generation = 0;
+};
+
+struct AssetIndexOptions {
+    // Return false to keep an entry out of the listing (sidecars, markers).
+    // Runs on the index thread.  Dot-entries are always hidden.
+    std::function<bool(const AssetIndexEntry&)> include;
+    // Entries for which this returns true are hidden and counted in
+    // far_lod_hidden.  Runs on the index thread.
+    std::function<bool(const AssetIndexEntry&)> is_far_lod;
+    // Least-recently-requested directories beyond this are dropped (and
+    // their watches released) — the tree view touches many folders.
+    size_t max_directories = 512;
+};
+
+class AssetIndex {
+public:
+    explicit AssetIndex(const AssetIndexOptions& options);
+    ~AssetIndex();
+
+    AssetIndex(const AssetIndex&) = delete;
+    AssetIndex& operator=(const AssetIndex&) = delete;
+
+    // Latest snapshot of `dir`, or nullptr while its first scan is still
+    // queued.  Never touches the filesystem; cheap enough to call for every
+    // folder-tree node every frame.
+    std::shared_ptr<const AssetDirectorySnapshot> snapshot(const std::string& dir);
+
+    // Re-scan `dir` on the CALLING thread and publish the result before
+    // returning.  For editor actions that just changed the folder, so the
+    // grid never shows a frame of stale state.  No-op for a directory
+    // nobody has asked for yet.
+    void rescan(const std::string& dir);
+
+    // Directories currently indexed (for the HUD / logging).
+    size_t directoryCount() const;
+
+private:
+    struct DirModel;
+
+    void workerLoop();
+    std::shared_ptr<DirModel> scanDirectory(const std::string& dir) const;
+    bool makeEntry(const std::string& dir,
+                   const std::string& name,
+                   AssetIndexEntry& out) const;
+    std::shared_ptr<const AssetDirectorySnapshot> publish(
+        const std::string& dir, const DirModel& model,
+        uint64_t generation) const;
+    void install(const std::string& dir, std::shared_ptr<DirModel> model);
+    void evictLocked();
+
+    // Platform watch hooks (inotify on Linux, no-ops elsewhere).
+    void watchInit();
+    void watchShutdown();
+    int  watchAdd(const std::string& dir);
+    void watchRemove(int wd);
+    // Waits up to `timeout_ms` for filesystem events or a wake-up and
+    // applies them.  Returns false if the platform has no event source.
+    bool watchPoll(int timeout_ms);
+    void wake();
+
+    void applyEntryChange(const std::string& dir, const std::string& name);
+    void pollDirectoryTimes();
+
+    AssetIndexOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<std::string, std::shared_ptr<DirModel>> dirs_;
+    std::vector<std::string> scan_queue_;
+    uint64_t use_clock_ = 0;
+    uint64_t generation_clock_ = 0;
+
+    int inotify_fd_ = -1;
+    int wake_pipe_[2] = { -1, -1 };
+    std::unordered_map<int, std::string> wd_to_dir_;   // guarded by mutex_
+
+    std::atomic<bool> stop_{false};
+    std::thread worker_;
+};
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,521 @@
+//
+// cluster_dag.cpp — build the continuous-LOD cluster DAG (see cluster_dag.h).
+//
+// Per level:
+//
+//   1. Group the level's clusters.  Adjacency counts the edges two clusters
+//      share, on position-welded vertex ids so UV / normal splits do not
+//      hide a neighbour.  Seeds are taken in Morton order of the cluster
+//      spheres; a group grows by the candidate sharing the most edges with
+//      it, and a group that runs out of neighbours (a leaf, a bolt) takes
+//      the nearest free cluster a few steps along the Morton order.
+//
+//   2. Simplify every group independently — in parallel on the pool:
+//      gather its triangles, decimateMesh to `reduction` with
+//      seal_locked_edges, then buildClusterMesh on the result.  The
+//      group's outline is an open boundary of that local mesh, so it is
+//      locked and comes back with the exact input vertices; an output
+//      vertex identical to an input one is mapped back to its global id,
+//      everything else is new.
+//
+//   3. Append the results serially, in group order, so ids and layout do
+//      not depend on the thread count.  Group error = the decimation's
+//      geometric error + the largest child error; group sphere = the union
+//      of the children's lod spheres.
+//
+// A group that does not get below min_progress keeps its clusters as roots;
+// the level after is made of the new clusters only.
+//
+#include "helper/cluster_dag.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "helper/cluster_mesh.h"
+#include "helper/mesh_tool.h"
+#include "helper/thread_pool.h"
+
+namespace engine {
+namespace helper {
+
+namespace {
+
+constexpr uint32_t kNone = UINT32_MAX;
+
+uint64_t hashBytes(const void* data, size_t size) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    uint64_t h = 1469598103934665603ull;               // FNV-1a
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+inline uint32_t spreadBits3(uint32_t x) {
+    x &= 0x3ff;
+    x = (x | (x << 16)) & 0x030000ff;
+    x = (x | (x << 8))  & 0x0300f00f;
+    x = (x | (x << 4))  & 0x030c30c3;
+    x = (x | (x << 2))  & 0x09249249;
+    return x;
+}
+
+// Smallest sphere around both `a` and `b` (a.w / b.w radii).
+glm::vec4 mergeSpheres(const glm::vec4& a, const glm::vec4& b) {
+    const glm::vec3 ca(a), cb(b);
+    const float d = glm::length(cb - ca);
+    if (d + b.w <= a.w) return a;
+    if (d + a.w <= b.w) return b;
+    const float r = 0.5f * (d + a.w + b.w);
+    const glm::vec3 c = ca + (cb - ca) * ((r - a.w) / d);
+    return glm::vec4(c, r);
+}
+
+// Canonical id per vertex: the first vertex at the same position.
+class PositionWeld {
+public:
+    uint32_t add(const std::vector<VertexStruct>& verts, uint32_t v) {
+        const glm::vec3& p = verts[v].position;
+        auto [it, inserted] = first_.emplace(hashBytes(&p, sizeof(p)), v);
+        const uint32_t c =
+            (inserted || verts[it->second].position != p) ? v : it->second;
+        if (canonical_.size() <= v) canonical_.resize(v + 1, kNone);
+        canonical_[v] = c;
+        return c;
+    }
+    uint32_t operator[](uint32_t v) const { return canonical_[v]; }
+
+private:
+    std::unordered_map<uint64_t, uint32_t> first_;
+    std::vector<uint32_t> canonical_;
+};
+
+// What one group's simplification produced, in group-local terms.
+struct GroupWork {
+    std::vector<uint32_t> children;           // dag cluster ids
+    bool     simplified = false;
+    float    error      = 0.0f;
+    std::vector<VertexStruct> verts;          // decimated vertices
+    std::vector<uint32_t> global;             // per vertex: id or kNone
+    std::vector<ClusterDagCluster> clusters;  // first_index into `indices`
+    std::vector<uint32_t> indices;            // local vertex ids
+};
+
+void simplifyGroup(const std::vector<VertexStruct>& all_verts,
+                   const ClusterDag& dag,
+                   const ClusterDagOptions& options,
+                   GroupWork& work) {
+    // Local mesh over the group's vertices, in ascending global id.
+    std::vector<uint32_t> ids;
+    for (uint32_t c : work.children) {
+        const ClusterDagCluster& cl = dag.clusters[c];
+        ids.insert(ids.end(), dag.indices.begin() + cl.first_index,
+                   dag.indices.begin() + cl.first_index + cl.index_count);
+    }
+    const size_t index_count = ids.size();
+    std::vector<uint32_t> local_of(index_count);
+    {
+        std::vector<uint32_t> sorted = ids;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        for (size_t i = 0; i < index_count; ++i) {
+            local_of[i] = static_cast<uint32_t>(
+                std::lower_bound(sorted.begin(), sorted.end(), ids[i]) -
+                sorted.begin());
+        }
+        ids.swap(sorted);                     // ids = local -> global
+    }
+
+    Mesh local;
+    local.vertex_data_ptr->reserve(ids.size());
+    for (uint32_t g : ids) local.vertex_data_ptr->push_back(all_verts[g]);
+    std::vector<int32_t> sections;
+    sections.reserve(index_count / 3);
+    size_t at = 0;
+    for (uint32_t c : work.children) {
+        const ClusterDagCluster& cl = dag.clusters[c];
+        for (uint32_t t = 0; t < cl.index_count / 3; ++t, at += 3) {
+            local.faces_ptr->emplace_back(local_of[at], local_of[at + 1],
+                                          local_of[at + 2]);
+            sections.push_back(static_cast<int32_t>(cl.section));
+        }
+    }
+
+    const size_t tris = local.getFaceCount();
+    const size_t target = std::max<size_t>(
+        1, static_cast<size_t>(static_cast<double>(tris) * options.reduction));
+    Mesh dec;
+    std::vector<int32_t> dec_sections;
+    std::ostringstream silent;
+    double error = 0.0;
+    decimateMesh(local, sections, dec, dec_sections, target, silent,
+                 /*seal_locked_edges=*/true, &error);
+    if (dec.getFaceCount() == 0 ||
+        static_cast<double>(dec.getFaceCount()) >
+            static_cast<double>(tris) * options.min_progress) {
+        return;
+    }
+
+    // Map untouched vertices back to their global ids.
+    std::unordered_map<uint64_t, uint32_t> by_bytes;
+    by_bytes.reserve(ids.size());
+    for (uint32_t l = 0; l < ids.size(); ++l) {
+        const VertexStruct& v = (*local.vertex_data_ptr)[l];
+        by_bytes.emplace(hashBytes(&v, sizeof(v)), l);
+    }
+    work.verts = *dec.vertex_data_ptr;
+    work.global.assign(work.verts.size(), kNone);
+    for (size_t i = 0; i < work.verts.size(); ++i) {
+        const VertexStruct& v = work.verts[i];
+        auto it = by_bytes.find(hashBytes(&v, sizeof(v)));
+        if (it != by_bytes.end() &&
+            std::memcmp(&(*local.vertex_data_ptr)[it->second], &v,
+                        sizeof(v)) == 0) {
+            work.global[i] = ids[it->second];
+        }
+    }
+
+    // Re-cluster, sections kept apart.
+    std::vector<uint32_t> order(dec.getFaceCount());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return dec_sections[a] < dec_sections[b];
+    });
+    Mesh sorted;
+    sorted.vertex_data_ptr = dec.vertex_data_ptr;
+    ClusterBuildOptions build;
+    build.max_triangles = options.max_triangles;
+    build.max_vertices  = options.max_vertices;
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && dec_sections[order[i]] != dec_sections[order[i - 1]]) {
+            build.range_starts.push_back(i);
+        }
+        sorted.faces_ptr->push_back((*dec.faces_ptr)[order[i]]);
+    }
+    ClusterMesh cm;
+    buildClusterMesh(sorted, cm, build);
+
+    for (const MeshletCluster& mc : cm.clusters) {
+        ClusterDagCluster cl;
+        cl.first_index = static_cast<uint32_t>(work.indices.size());
+        cl.index_count = mc.triangleCount() * 3;
+        cl.section = static_cast<uint32_t>(
+            dec_sections[order[mc.face_indices.front()]]);
+        cl.bounds = glm::vec4(mc.bounds_center, mc.bounds_radius);
+        cl.cone   = glm::vec4(mc.cone_axis, mc.cone_cutoff);
+        for (uint32_t f : mc.face_indices) {
+            const Face& face = (*sorted.faces_ptr)[f];
+            work.indices.insert(work.indices.end(), face.v_indices,
+                                face.v_indices + 3);
+        }
+        work.clusters.push_back(cl);
+    }
+    work.error = static_cast<float>(error);
+    work.simplified = true;
+}
+
+// Partition `level` (dag cluster ids) into groups of up to group_size.
+std::vector<std::vector<uint32_t>> groupClusters(
+    const ClusterDag& dag, const PositionWeld& weld,
+    const std::vector<uint32_t>& level, uint32_t group_size) {
+    const uint32_t n = static_cast<uint32_t>(level.size());
+
+    // Shared edges between clusters: sort (edge, cluster) pairs and count
+    // every pair of distinct clusters meeting on one edge.
+    std::vector<std::pair<uint64_t, uint32_t>> edges;
+    for (uint32_t i = 0; i < n; ++i) {
+        const ClusterDagCluster& cl = dag.clusters[level[i]];
+        for (uint32_t k = 0; k < cl.index_count; k += 3) {
+            const uint32_t* tri = &dag.indices[cl.first_index + k];
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = weld[tri[e]], b = weld[tri[(e + 1) % 3]];
+                if (a == b) continue;
+                if (a > b) std::swap(a, b);
+                edges.emplace_back((static_cast<uint64_t>(a) << 32) | b, i);
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    std::vector<std::pair<uint32_t, uint32_t>> links;
+    for (size_t s = 0, e; s < edges.size(); s = e) {
+        for (e = s + 1; e < edges.size() && edges[e].first == edges[s].first; ++e) {}
+        for (size_t x = s; x < e; ++x) {
+            for (size_t y = x + 1; y < e; ++y) {
+                if (edges[x].second == edges[y].second) continue;
+                links.emplace_back(edges[x].second, edges[y].second);
+                links.emplace_back(edges[y].second, edges[x].second);
+            }
+        }
+    }
+    std::sort(links.begin(), links.end());
+    std::vector<uint32_t> adj_begin(n + 1, 0);
+    std::vector<std::pair<uint32_t, uint32_t>> adj;   // (cluster, weight)
+    for (size_t s = 0, e; s < links.size(); s = e) {
+        for (e = s + 1; e < links.size() && links[e] == links[s]; ++e) {}
+        adj.emplace_back(links[s].second, static_cast<uint32_t>(e - s));
+        ++adj_begin[links[s].first + 1];
+    }
+    for (uint32_t i = 0; i < n; ++i) adj_begin[i + 1] += adj_begin[i];
+
+    // Morton order of the lod sphere centres.
+    glm::vec3 lo(FLT_MAX), hi(-FLT_MAX);
+    for (uint32_t c : level) {
+        lo = glm::min(lo, glm::vec3(dag.clusters[c].lod_bounds));
+        hi = glm::max(hi, glm::vec3(dag.clusters[c].lod_bounds));
+    }
+    const glm::vec3 extent = glm::max(hi - lo, glm::vec3(1e-20f));
+    std::vector<uint64_t> keys(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        const glm::vec3 q =
+            (glm::vec3(dag.clusters[level[i]].lod_bounds) - lo) / extent * 1023.0f;
+        const uint32_t code = spreadBits3(static_cast<uint32_t>(q.x)) |
+                              (spreadBits3(static_cast<uint32_t>(q.y)) << 1) |
+                              (spreadBits3(static_cast<uint32_t>(q.z)) << 2);
+        keys[i] = (static_cast<uint64_t>(code) << 32) | i;
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<uint32_t> rank(n);
+    for (uint32_t r = 0; r < n; ++r) rank[static_cast<uint32_t>(keys[r])] = r;
+
+    constexpr uint32_t kLookahead = 16;
+    std::vector<uint8_t> used(n, 0);
+    std::vector<std::vector<uint32_t>> groups;
+    std::vector<std::pair<uint32_t, uint32_t>> cand;  // (cluster, weight)
+    for (uint32_t r = 0; r < n; ++r) {
+        const uint32_t seed = static_cast<uint32_t>(keys[r]);
+        if (used[seed]) continue;
+        std::vector<uint32_t> group{ seed };
+        used[seed] = 1;
+        cand.clear();
+        auto absorb = [&](uint32_t c) {
+            for (uint32_t a = adj_begin[c]; a < adj_begin[c + 1]; ++a) {
+                const uint32_t o = adj[a].first;
+                if (used[o]) continue;
+                auto it = std::find_if(cand.begin(), cand.end(),
+                    [&](const auto& p) { return p.first == o; });
+                if (it == cand.end()) cand.emplace_back(o, adj[a].second);
+                else it->second += adj[a].second;
+            }
+        };
+        absorb(seed);
+        const glm::vec4 seed_sphere = dag.clusters[level[seed]].lod_bounds;
+        while (group.size() < group_size) {
+            uint32_t best = kNone, best_w = 0;
+            for (const auto& [c, w] : cand) {
+                if (used[c]) continue;
+                if (best == kNone || w > best_w ||
+                    (w == best_w && rank[c] < rank[best])) {
+                    best = c;
+                    best_w = w;
+                }
+            }
+            if (best == kNone) {
+                // No neighbour left: nearest free cluster just ahead in
+                // Morton order, if it is about as close as a neighbour.
+                float best_d = FLT_MAX;
+                for (uint32_t q = r + 1; q < n && q <= r + kLookahead; ++q) {
+                    const uint32_t c = static_cast<uint32_t>(keys[q]);
+                    if (used[c]) continue;
+                    const glm::vec4 s = dag.clusters[level[c]].lod_bounds;
+                    const float d = glm::length(glm::vec3(s) - glm::vec3(seed_sphere));
+                    if (d <= 2.0f * (s.w + seed_sphere.w) && d < best_d) {
+                        best = c;
+                        best_d = d;
+                    }
+                }
+                if (best == kNone) break;
+            }
+            used[best] = 1;
+            group.push_back(best);
+            absorb(best);
+        }
+        for (uint32_t& c : group) c = level[c];
+        groups.push_back(std::move(group));
+    }
+    return groups;
+}
+
+}  // namespace
+
+uint32_t ClusterDag::triangleCount(uint32_t level) const {
+    uint32_t tris = 0;
+    for (const ClusterDagCluster& c : clusters) {
+        if (c.level == level) tris += c.index_count / 3;
+    }
+    return tris;
+}
+
+bool buildClusterDag(const Mesh& mesh,
+                     const std::vector<int32_t>& face_sections,
+                     ClusterDag& out,
+                     const ClusterDagOptions& options,
+                     ThreadPool* pool) {
+    out = ClusterDag{};
+    if (!mesh.isValid() || mesh.getFaceCount() == 0) return false;
+    const auto& faces = *mesh.faces_ptr;
+    auto sectionOf = [&](size_t f) {
+        return f < face_sections.size() ? face_sections[f] : 0;
+    };
+
+    std::vector<VertexStruct> verts = *mesh.vertex_data_ptr;
+    out.base_vertex_count = static_cast<uint32_t>(verts.size());
+    PositionWeld weld;
+    for (uint32_t v = 0; v < verts.size(); ++v) weld.add(verts, v);
+
+    // ── Level 0: spatial meshlets of the source, one range per section ──
+    std::vector<uint32_t> order(faces.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return sectionOf(a) < sectionOf(b);
+    });
+    Mesh sorted;
+    sorted.vertex_data_ptr = mesh.vertex_data_ptr;
+    ClusterBuildOptions build;
+    build.max_triangles = options.max_triangles;
+    build.max_vertices  = options.max_vertices;
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && sectionOf(order[i]) != sectionOf(order[i - 1])) {
+            build.range_starts.push_back(i);
+        }
+        sorted.faces_ptr->push_back(faces[order[i]]);
+    }
+    ClusterMesh base;
+    buildClusterMesh(sorted, base, build);
+    if (base.empty()) return false;
+
+    std::vector<uint32_t> level;
+    for (const MeshletCluster& mc : base.clusters) {
+        ClusterDagCluster cl;
+        cl.first_index = static_cast<uint32_t>(out.indices.size());
+        cl.index_count = mc.triangleCount() * 3;
+        cl.section = static_cast<uint32_t>(sectionOf(order[mc.face_indices.front()]));
+        cl.bounds = glm::vec4(mc.bounds_center, mc.bounds_radius);
+        cl.cone   = glm::vec4(mc.cone_axis, mc.cone_cutoff);
+        cl.lod_bounds = cl.bounds;
+        for (uint32_t f : mc.face_indices) {
+            const Face& face = (*sorted.faces_ptr)[f];
+            out.indices.insert(out.indices.end(), face.v_indices,
+                               face.v_indices + 3);
+        }
+        level.push_back(static_cast<uint32_t>(out.clusters.size()));
+        out.clusters.push_back(cl);
+    }
+    out.level_count = 1;
+
+    // ── Levels 1..: group, simplify, re-cluster ─────────────────────────
+    while (level.size() > 1 && out.level_count < options.max_levels) {
+        std::vector<GroupWork> work;
+        for (auto& g : groupClusters(out, weld, level,
+                                     std::max(options.group_size, 2u))) {
+            work.emplace_back();
+            work.back().children = std::move(g);
+        }
+
+        std::vector<std::exception_ptr> errors(work.size());
+        auto run = [&](size_t i) {
+            try {
+                simplifyGroup(verts, out, options, work[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        if (pool && pool->numThreads() > 1 && work.size() > 1) {
+            pool->parallelFor(work.size(), run);
+        } else {
+            for (size_t i = 0; i < work.size(); ++i) run(i);
+        }
+        for (const auto& e : errors) {
+            if (e) std::rethrow_exception(e);
+        }
+
+        std::vector<uint32_t> next;
+        for (GroupWork& w : work) {
+            if (!w.simplified) continue;      // children stay roots
+            glm::vec4 sphere = out.clusters[w.children.front()].lod_bounds;
+            float child_error = 0.0f;
+            uint32_t child_level = 0;
+            for (uint32_t c : w.children) {
+                sphere = mergeSpheres(sphere, out.clusters[c].lod_bounds);
+                child_error = std::max(child_error, out.clusters[c].lod_error);
+                child_level = std::max(child_level, out.clusters[c].level);
+            }
+            // Rounding must never leave a child sphere poking out, or the
+            // parent could project a smaller error than the child.
+            sphere.w += std::max(sphere.w, 1.0f) * 1e-5f;
+            const float error = child_error + w.error;
+            for (uint32_t c : w.children) {
+                out.clusters[c].parent_bounds = sphere;
+                out.clusters[c].parent_error  = error;
+            }
+
+            for (size_t v = 0; v < w.verts.size(); ++v) {
+                if (w.global[v] != kNone) continue;
+                w.global[v] = static_cast<uint32_t>(verts.size());
+                verts.push_back(w.verts[v]);
+                weld.add(verts, w.global[v]);
+            }
+            for (ClusterDagCluster cl : w.clusters) {
+                const uint32_t first = cl.first_index;
+                cl.first_index = static_cast<uint32_t>(out.indices.size());
+                cl.level = child_level + 1;
+                cl.lod_bounds = sphere;
+                cl.lod_error  = error;
+                for (uint32_t k = 0; k < cl.index_count; ++k) {
+                    out.indices.push_back(w.global[w.indices[first + k]]);
+                }
+                next.push_back(static_cast<uint32_t>(out.clusters.size()));
+                out.clusters.push_back(cl);
+                out.level_count = std::max(out.level_count, cl.level + 1);
+            }
+            ++out.group_count;
+        }
+        if (next.empty()) break;              // nothing simplifies any more
+        level.swap(next);
+    }
+
+    out.positions.reserve(verts.size() - out.base_vertex_count);
+    out.normals.reserve(verts.size() - out.base_vertex_count);
+    out.uvs.reserve(verts.size() - out.base_vertex_count);
+    for (size_t v = out.base_vertex_count; v < verts.size(); ++v) {
+        out.positions.push_back(verts[v].position);
+        out.normals.push_back(verts[v].normal);
+        out.uvs.push_back(verts[v].uv);
+    }
+    return true;
+}
+
+float projectedClusterError(const glm::vec4& sphere, float error,
+                            const ClusterDagView& view) {
+    if (error <= 0.0f) return 0.0f;
+    if (error >= FLT_MAX) return FLT_MAX;
+    const float d = glm::length(glm::vec3(sphere) - view.camera_pos) - sphere.w;
+    if (d <= 0.0f) return FLT_MAX;
+    return error * view.error_scale / d;
+}
+
+uint32_t selectClusterDagCut(const ClusterDag& dag, const ClusterDagView& view,
+                             std::vector<uint32_t>& out_clusters) {
+    out_clusters.clear();
+    uint32_t tris = 0;
+    for (uint32_t i = 0; i < dag.clusters.size(); ++i) {
+        const ClusterDagCluster& c = dag.clusters[i];
+        if (projectedClusterError(c.lod_bounds, c.lod_error, view) <=
+                view.threshold_px &&
+            projectedClusterError(c.parent_bounds, c.parent_error, view) >
+                view.threshold_px) {
+            out_clusters.push_back(i);
+            tris += c.index_count / 3;
+        }
+    }
+    return tris;
+}
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,120 @@
+#pragma once
+//
+// cluster_dag.h — continuous LOD: a cluster hierarchy (DAG) over a mesh.
+//
+// Built offline from a Mesh, level by level:
+//
+//   level 0    the spatial meshlets of the source (buildClusterMesh)
+//   level n+1  groups of ~group_size edge-adjacent level-n clusters, each
+//              group merged, simplified to `reduction` of its triangles by
+//              decimateMesh with its outline sealed, and re-clustered
+//
+// until a single cluster is left or no group simplifies any more.  Sealing
+// keeps every vertex on a group's outline bit-exact, so the clusters a
+// group produces meet their neighbours — at any level — on the same
+// vertices, and a cut mixing levels has no cracks.
+//
+// Every cluster carries two (sphere, error) pairs:
+//   lod    — the group that produced it (level 0: its own sphere, error 0)
+//   parent — the group it was simplified in (roots: error = FLT_MAX)
+// Errors accumulate up the DAG and a group's sphere encloses its children's
+// lod spheres, so the projected error only grows towards the roots and each
+// cluster decides on its own, in any order, with no traversal:
+//
+//   draw c  iff  projected(c.lod) <= threshold  <  projected(c.parent)
+//
+// All clusters of one group share the same parent pair, so a group is
+// always drawn either entirely or not at all.  selectClusterDagCut() is the
+// CPU reference of that test for the GPU cull pass.
+//
+// Geometry follows the .rwgeo blob layout: indices reference the source
+// vertex array, with the vertices simplification created appended after it
+// (ids >= base_vertex_count live in positions / normals / uvs here), and
+// each cluster owns one contiguous run of `indices`.
+//
+// glm-only, so model_inspect.h can carry a DAG in ModelPreviewData.
+//
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace engine {
+namespace helper {
+
+struct Mesh;
+class ThreadPool;
+
+struct ClusterDagCluster {
+    uint32_t  first_index   = 0;      // into ClusterDag::indices
+    uint32_t  index_count   = 0;
+    uint32_t  section       = 0;      // face part / material section
+    uint32_t  level         = 0;
+    glm::vec4 bounds        = glm::vec4(0.0f);            // cull sphere
+    glm::vec4 cone          = glm::vec4(0, 0, 1, -1);     // axis, sin cutoff
+    glm::vec4 lod_bounds    = glm::vec4(0.0f);
+    float     lod_error     = 0.0f;
+    glm::vec4 parent_bounds = glm::vec4(0.0f);
+    float     parent_error  = FLT_MAX;                    // FLT_MAX = root
+};
+
+struct ClusterDag {
+    uint32_t base_vertex_count = 0;
+    // Vertices created by simplification, ids base_vertex_count onwards.
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> uvs;
+    std::vector<uint32_t>  indices;
+    std::vector<ClusterDagCluster> clusters;   // ascending level
+    uint32_t level_count = 0;
+    uint32_t group_count = 0;
+
+    bool empty() const { return clusters.empty(); }
+    uint32_t triangleCount(uint32_t level) const;
+};
+
+struct ClusterDagOptions {
+    uint32_t group_size    = 8;       // clusters merged per group
+    float    reduction     = 0.5f;    // triangles kept per simplification
+    // A group keeping more than this fraction of its triangles is not
+    // worth a level: its clusters become roots instead.
+    float    min_progress  = 0.85f;
+    uint32_t max_levels    = 16;
+    uint32_t max_triangles = 124;     // per cluster, as ClusterBuildOptions
+    uint32_t max_vertices  = 64;
+};
+
+// `face_sections[i]` is face i's section (empty = all 0).  Clusters never
+// mix sections; groups may, with the section seams locked.  `pool`
+// simplifies the groups of a level in parallel (null = serial); the result
+// does not depend on it.  Blocks, so must not be called from a pool worker.
+// Returns false when the mesh has no usable face.
+bool buildClusterDag(const Mesh& mesh,
+                     const std::vector<int32_t>& face_sections,
+                     ClusterDag& out,
+                     const ClusterDagOptions& options = {},
+                     ThreadPool* pool = nullptr);
+
+// ─── Cut selection ──────────────────────────────────────────────────────────
+struct ClusterDagView {
+    glm::vec3 camera_pos   = glm::vec3(0.0f);   // in the DAG's mesh space
+    // Pixels per unit of error at distance 1, viewport_height /
+    // (2 tan(fov_y / 2)).  A uniform instance scale cancels out, since
+    // error and distance are both in mesh units.
+    float     error_scale  = 1.0f;
+    float     threshold_px = 1.0f;
+};
+
+// Error in pixels of a (sphere, error) pair seen from `view`, measured at
+// the sphere's nearest point.  0 for error 0, FLT_MAX for roots and when
+// the camera is inside the sphere.
+float projectedClusterError(const glm::vec4& sphere, float error,
+                            const ClusterDagView& view);
+
+// Fills `out_clusters` with the cut for `view` (ascending cluster index)
+// and returns its triangle count.
+uint32_t selectClusterDagCut(const ClusterDag& dag, const ClusterDagView& view,
+                             std::vector<uint32_t>& out_clusters);
+
+}  // namespace helper
+}  // namespace engine
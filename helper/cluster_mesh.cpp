@@ -33,17 +33,49 @@
 // Determinism: seed selection and neighbour traversal both walk in ascending
 // index order, so the same input mesh produces the same clusters every run.
 //
+// That is kGreedyBfs.  kSpatialMeshlet (the default for ClusterBuildOptions)
+// works per face range (material section) instead:
+//
+//   1. Compact the range's vertices and build a flat vertex -> triangle
+//      adjacency (CSR offsets + one index array) — no hashing.  A live
+//      valence per vertex lets growth skip vertices that are used up.
+//
+//   2. Seed each meshlet at the next unused triangle in Morton order of
+//      the triangle centroids, so consecutive meshlets are neighbours and
+//      isolated pieces (leaves, bolts) still group by proximity.
+//
+//   3. Grow greedily over a frontier of the unused triangles touching the
+//      meshlet; when none fits, take the closest of the next few in Morton
+//      order.  Priority is topological first (adds no vertex, then uses up
+//      a vertex nobody else could share, then fewest new vertices), then a
+//      score blending the distance to the meshlet centre (in meshlet radii)
+//      with the angle to its mean normal.  Growth stops at max_vertices or
+//      max_triangles, whichever comes first.
+//
+//   4. Reorder the meshlet's triangles for a 16-entry FIFO post-transform
+//      cache (Tipsify), and list vertex_indices in first use.
+//
+//   5. Bounds: Welzl minimal sphere over the vertices, kept only when it
+//      beats the AABB-centred sphere.  Cone: axis = centre of the minimal
+//      sphere around the unit face normals, or the area-weighted average if
+//      that gives the narrower cone; cutoff as above.
+//
 #include "helper/cluster_mesh.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <limits>
+#include <numeric>
 #include <queue>
 #include <unordered_map>
 #include <utility>
 
+#include "helper/thread_pool.h"
+
 namespace engine {
 namespace helper {
 
@@ -85,6 +117,506 @@ inline glm::vec3 faceNormalWeighted(const VertexStruct& v0,
                       v2.position - v0.position);
 }
 
+inline bool faceUsable(const Face& face, size_t vertex_count) {
+    return !face.isDegenerate() &&
+           face.v_indices[0] < vertex_count &&
+           face.v_indices[1] < vertex_count &&
+           face.v_indices[2] < vertex_count;
+}
+
+// ── Minimal bounding spheres (Welzl, move-to-front) ────────────────────────
+struct Sphere {
+    glm::vec3 center = glm::vec3(0.0f);
+    float     radius = -1.0f;          // < 0: empty
+};
+
+inline bool sphereContains(const Sphere& s, const glm::vec3& p) {
+    if (s.radius < 0.0f) return false;
+    const glm::vec3 d = p - s.center;
+    return glm::dot(d, d) <= s.radius * s.radius * (1.0f + 1e-5f) + 1e-12f;
+}
+
+// Smallest sphere with all `n` (<= 4) points on its surface.  Degenerate
+// sets (collinear / coplanar) fall back to a sphere that still contains
+// every point, so the caller's containment invariant holds.
+Sphere sphereFromBoundary(const glm::vec3* b, int n) {
+    Sphere s;
+    if (n == 0) return s;
+    if (n == 1) { s.center = b[0]; s.radius = 0.0f; return s; }
+    if (n == 2) {
+        s.center = 0.5f * (b[0] + b[1]);
+        s.radius = 0.5f * glm::length(b[1] - b[0]);
+        return s;
+    }
+    if (n == 3) {
+        const glm::vec3 a = b[1] - b[0];
+        const glm::vec3 c = b[2] - b[0];
+        const glm::vec3 axc = glm::cross(a, c);
+        const float d = 2.0f * glm::dot(axc, axc);
+        if (d <= 1e-12f * glm::dot(a, a) * glm::dot(c, c)) {
+            // Collinear: the longest pair spans all three.
+            int i = 0, j = 1;
+            float best = glm::dot(a, a);
+            const float bc = glm::dot(b[2] - b[1], b[2] - b[1]);
+            if (glm::dot(c, c) > best) { best = glm::dot(c, c); j = 2; }
+            if (bc > best) { i = 1; j = 2; }
+            const glm::vec3 pair[2] = { b[i], b[j] };
+            return sphereFromBoundary(pair, 2);
+        }
+        s.center = b[0] + glm::cross(glm::dot(a, a) * c - glm::dot(c, c) * a,
+                                     axc) / d;
+        s.radius = glm::length(s.center - b[0]);
+        return s;
+    }
+    const glm::vec3 a = b[1] - b[0];
+    const glm::vec3 c = b[2] - b[0];
+    const glm::vec3 e = b[3] - b[0];
+    const float det = 2.0f * glm::dot(a, glm::cross(c, e));
+    const float scale = glm::length(a) * glm::length(c) * glm::length(e);
+    if (std::fabs(det) <= 1e-6f * scale) {
+        // Coplanar: circumsphere of the first three, grown to the fourth.
+        s = sphereFromBoundary(b, 3);
+        s.radius = std::max(s.radius, glm::length(b[3] - s.center));
+        return s;
+    }
+    s.center = b[0] + (glm::dot(a, a) * glm::cross(c, e) +
+                       glm::dot(c, c) * glm::cross(e, a) +
+                       glm::dot(e, e) * glm::cross(a, c)) / det;
+    s.radius = glm::length(s.center - b[0]);
+    return s;
+}
+
+Sphere welzl(std::vector<glm::vec3>& pts, uint32_t n,
+             glm::vec3* boundary, int nb) {
+    Sphere s = sphereFromBoundary(boundary, nb);
+    if (nb == 4) return s;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (sphereContains(s, pts[i])) continue;
+        boundary[nb] = pts[i];
+        s = welzl(pts, i, boundary, nb + 1);
+        std::rotate(pts.begin(), pts.begin() + i, pts.begin() + i + 1);
+    }
+    return s;
+}
+
+// Minimal sphere, widened by one exact pass so float error never leaves a
+// point outside.  `pts` is reordered.
+Sphere minimalSphere(std::vector<glm::vec3>& pts) {
+    if (pts.empty()) return Sphere{};
+    glm::vec3 boundary[4];
+    Sphere s = welzl(pts, static_cast<uint32_t>(pts.size()), boundary, 0);
+    float r2 = 0.0f;
+    for (const glm::vec3& p : pts) {
+        const glm::vec3 d = p - s.center;
+        r2 = std::max(r2, glm::dot(d, d));
+    }
+    s.radius = std::sqrt(r2);
+    return s;
+}
+
+// ── Spatial meshlet builder ────────────────────────────────────────────────
+// Spreads the low 10 bits of x so two zero bits follow each one.
+inline uint32_t spreadBits3(uint32_t x) {
+    x &= 0x3ffu;
+    x = (x | (x << 16)) & 0x030000ffu;
+    x = (x | (x << 8))  & 0x0300f00fu;
+    x = (x | (x << 4))  & 0x030c30c3u;
+    x = (x | (x << 2))  & 0x09249249u;
+    return x;
+}
+
+constexpr uint32_t kCacheSize = 16;    // post-transform FIFO being targeted
+constexpr uint32_t kMortonWindow = 32; // fallback candidates per step
+
+// Per-build scratch, sized to the mesh once and reused across ranges.
+struct SpatialScratch {
+    std::vector<uint32_t> local_of;    // mesh vertex -> range-local, or ~0
+};
+
+// Cluster payload for a finished meshlet whose face_indices are already in
+// final order: vertex list, AABB, minimal sphere, tight cone.
+void finishMeshlet(const std::vector<VertexStruct>& verts,
+                   const std::vector<Face>& faces,
+                   MeshletCluster& cl) {
+    std::vector<uint32_t>& vidx = cl.vertex_indices;
+    vidx.clear();
+    std::vector<glm::vec3> pts;
+    for (uint32_t f : cl.face_indices) {
+        for (uint32_t v : faces[f].v_indices) {
+            if (std::find(vidx.begin(), vidx.end(), v) != vidx.end()) continue;
+            vidx.push_back(v);
+            pts.push_back(verts[v].position);
+        }
+    }
+
+    glm::vec3 mn( std::numeric_limits<float>::max());
+    glm::vec3 mx(-std::numeric_limits<float>::max());
+    for (const glm::vec3& p : pts) {
+        mn = glm::min(mn, p);
+        mx = glm::max(mx, p);
+    }
+    cl.aabb_min = mn;
+    cl.aabb_max = mx;
+
+    const glm::vec3 box_center = 0.5f * (mn + mx);
+    float box_r2 = 0.0f;
+    for (const glm::vec3& p : pts) {
+        const glm::vec3 d = p - box_center;
+        box_r2 = std::max(box_r2, glm::dot(d, d));
+    }
+    const Sphere tight = minimalSphere(pts);
+    if (tight.radius >= 0.0f && tight.radius * tight.radius < box_r2) {
+        cl.bounds_center = tight.center;
+        cl.bounds_radius = tight.radius;
+    } else {
+        cl.bounds_center = box_center;
+        cl.bounds_radius = std::sqrt(box_r2);
+    }
+
+    // Cone: try the minimal-sphere axis of the unit normals and the
+    // area-weighted average, keep whichever bounds every normal tighter.
+    std::vector<glm::vec3> normals;
+    normals.reserve(cl.face_indices.size());
+    glm::vec3 sum_n(0.0f);
+    for (uint32_t f : cl.face_indices) {
+        const Face& face = faces[f];
+        const glm::vec3 n = faceNormalWeighted(verts[face.v_indices[0]],
+                                               verts[face.v_indices[1]],
+                                               verts[face.v_indices[2]]);
+        sum_n += n;
+        const float l2 = glm::dot(n, n);
+        if (l2 > 1e-20f) normals.push_back(n / std::sqrt(l2));
+    }
+    auto minDot = [&](const glm::vec3& axis) {
+        float m = 1.0f;
+        for (const glm::vec3& n : normals) m = std::min(m, glm::dot(axis, n));
+        return m;
+    };
+
+    cl.cone_axis   = glm::vec3(0.0f, 0.0f, 1.0f);
+    cl.cone_cutoff = -1.0f;
+    if (normals.empty()) return;
+
+    float best_dot = -1.0f;
+    const float sum_len2 = glm::dot(sum_n, sum_n);
+    if (sum_len2 > 1e-12f) {
+        cl.cone_axis = sum_n / std::sqrt(sum_len2);
+        best_dot = minDot(cl.cone_axis);
+    }
+    std::vector<glm::vec3> normal_pts = normals;
+    const Sphere ns = minimalSphere(normal_pts);
+    const float c_len2 = glm::dot(ns.center, ns.center);
+    if (c_len2 > 1e-12f) {
+        const glm::vec3 axis = ns.center / std::sqrt(c_len2);
+        const float d = minDot(axis);
+        if (d > best_dot) {
+            best_dot = d;
+            cl.cone_axis = axis;
+        }
+    }
+    // sin(θ), see the derivation in buildClusterMesh's BFS payload.
+    if (best_dot > 0.0f) {
+        cl.cone_cutoff = std::sqrt(std::max(0.0f, 1.0f - best_dot * best_dot));
+    }
+}
+
+// Reorders `tris` (range-local triangle ids, vertex ids in `tv`) for a
+// FIFO post-transform cache of kCacheSize entries with Tipsify (Sander et
+// al. 2007): emit every remaining triangle around a fanning vertex, then
+// fan from the neighbour that will still be cached afterwards, else back
+// along the dead-end stack.  Linear in the meshlet size.  `slot_of` is
+// range-vertex scratch, all ~0 on entry and on return.
+void cacheOrderMeshlet(std::vector<uint32_t>& tris,
+                       const std::vector<uint32_t>& tv,
+                       std::vector<uint32_t>& slot_of) {
+    const uint32_t n = static_cast<uint32_t>(tris.size());
+    if (n < 3) return;
+
+    // Meshlet-local vertex slots and slot -> triangle adjacency.
+    std::vector<uint32_t> used;
+    std::vector<uint32_t> tslot(n * 3);
+    for (uint32_t i = 0; i < n * 3; ++i) {
+        const uint32_t v = tv[tris[i / 3] * 3 + i % 3];
+        if (slot_of[v] == UINT32_MAX) {
+            slot_of[v] = static_cast<uint32_t>(used.size());
+            used.push_back(v);
+        }
+        tslot[i] = slot_of[v];
+    }
+    for (uint32_t v : used) slot_of[v] = UINT32_MAX;
+    const uint32_t nv = static_cast<uint32_t>(used.size());
+
+    std::vector<uint32_t> off(nv + 1, 0);
+    for (uint32_t v : tslot) ++off[v + 1];
+    for (uint32_t v = 0; v < nv; ++v) off[v + 1] += off[v];
+    std::vector<uint32_t> adj(n * 3);
+    std::vector<uint32_t> fill(off.begin(), off.end() - 1);
+    for (uint32_t i = 0; i < n * 3; ++i) adj[fill[tslot[i]]++] = i / 3;
+    std::vector<uint32_t> live(nv);
+    for (uint32_t v = 0; v < nv; ++v) live[v] = off[v + 1] - off[v];
+
+    // A vertex is cached while fewer than kCacheSize misses happened since
+    // its own miss (`time` counts misses).
+    std::vector<uint32_t> stamp(nv, 0);
+    uint32_t time = kCacheSize + 1;
+    std::vector<uint8_t>  done(n, 0);
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> dead_end;
+    std::vector<uint32_t> cand;
+    order.reserve(n);
+    dead_end.reserve(n * 3);
+
+    uint32_t fan = tslot[0];
+    uint32_t scan = 0;
+    while (fan != UINT32_MAX) {
+        cand.clear();
+        for (uint32_t a = off[fan]; a < off[fan + 1]; ++a) {
+            const uint32_t t = adj[a];
+            if (done[t]) continue;
+            done[t] = 1;
+            order.push_back(tris[t]);
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = tslot[t * 3 + k];
+                dead_end.push_back(v);
+                cand.push_back(v);
+                --live[v];
+                if (time - stamp[v] > kCacheSize) stamp[v] = time++;
+            }
+        }
+
+        // Oldest candidate that survives emitting its own fan.
+        fan = UINT32_MAX;
+        int64_t best = -1;
+        for (uint32_t v : cand) {
+            if (live[v] == 0) continue;
+            int64_t p = 0;
+            if (time - stamp[v] + 2 * live[v] <= kCacheSize) p = time - stamp[v];
+            if (p > best) {
+                best = p;
+                fan = v;
+            }
+        }
+        while (fan == UINT32_MAX && !dead_end.empty()) {
+            const uint32_t v = dead_end.back();
+            dead_end.pop_back();
+            if (live[v] > 0) fan = v;
+        }
+        while (fan == UINT32_MAX && scan < nv) {
+            if (live[scan] > 0) fan = scan;
+            ++scan;
+        }
+    }
+    tris.swap(order);
+}
+
+// Meshlets for faces [f_begin, f_end), appended to `out`.
+void buildSpatialRange(const std::vector<VertexStruct>& verts,
+                       const std::vector<Face>& faces,
+                       uint32_t f_begin, uint32_t f_end,
+                       const ClusterBuildOptions& opt,
+                       SpatialScratch& sc,
+                       std::vector<MeshletCluster>& out) {
+    // ── compact vertices, triangle list ──
+    std::vector<uint32_t> tri_face;    // range-local triangle -> mesh face
+    std::vector<uint32_t> tv;          // 3 range-local vertex ids per tri
+    std::vector<uint32_t> lv;          // range-local vertex -> mesh vertex
+    for (uint32_t f = f_begin; f < f_end; ++f) {
+        const Face& face = faces[f];
+        if (!faceUsable(face, verts.size())) continue;
+        tri_face.push_back(f);
+        for (uint32_t g : face.v_indices) {
+            uint32_t& l = sc.local_of[g];
+            if (l == UINT32_MAX) {
+                l = static_cast<uint32_t>(lv.size());
+                lv.push_back(g);
+            }
+            tv.push_back(l);
+        }
+    }
+    const uint32_t tri_count = static_cast<uint32_t>(tri_face.size());
+    const uint32_t vtx_count = static_cast<uint32_t>(lv.size());
+    for (uint32_t g : lv) sc.local_of[g] = UINT32_MAX;
+    if (tri_count == 0) return;
+
+    // ── flat vertex -> triangle adjacency ──
+    std::vector<uint32_t> adj_off(vtx_count + 1, 0);
+    for (uint32_t v : tv) ++adj_off[v + 1];
+    for (uint32_t v = 0; v < vtx_count; ++v) adj_off[v + 1] += adj_off[v];
+    std::vector<uint32_t> adj(tv.size());
+    {
+        std::vector<uint32_t> fill(adj_off.begin(), adj_off.end() - 1);
+        for (uint32_t i = 0; i < tv.size(); ++i) adj[fill[tv[i]]++] = i / 3;
+    }
+    std::vector<uint32_t> live(vtx_count);
+    for (uint32_t v = 0; v < vtx_count; ++v) live[v] = adj_off[v + 1] - adj_off[v];
+
+    // ── centroids, unit normals, Morton order ──
+    std::vector<glm::vec3> centroid(tri_count);
+    std::vector<glm::vec3> normal(tri_count);
+    glm::vec3 cmin( std::numeric_limits<float>::max());
+    glm::vec3 cmax(-std::numeric_limits<float>::max());
+    for (uint32_t t = 0; t < tri_count; ++t) {
+        const glm::vec3& p0 = verts[lv[tv[t * 3 + 0]]].position;
+        const glm::vec3& p1 = verts[lv[tv[t * 3 + 1]]].position;
+        const glm::vec3& p2 = verts[lv[tv[t * 3 + 2]]].position;
+        centroid[t] = (p0 + p1 + p2) * (1.0f / 3.0f);
+        const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        const float l2 = glm::dot(n, n);
+        normal[t] = l2 > 1e-20f ? n / std::sqrt(l2) : glm::vec3(0.0f);
+        cmin = glm::min(cmin, centroid[t]);
+        cmax = glm::max(cmax, centroid[t]);
+    }
+    std::vector<uint32_t> order(tri_count);
+    {
+        // (code << 32 | triangle) sorts by code with index as tie-break.
+        std::vector<uint64_t> keyed(tri_count);
+        const glm::vec3 ext = cmax - cmin;
+        float q[3];
+        for (int a = 0; a < 3; ++a) q[a] = ext[a] > 0.0f ? 1023.0f / ext[a] : 0.0f;
+        for (uint32_t t = 0; t < tri_count; ++t) {
+            const glm::vec3 r = centroid[t] - cmin;
+            const uint32_t code = spreadBits3(static_cast<uint32_t>(r.x * q[0])) |
+                                  spreadBits3(static_cast<uint32_t>(r.y * q[1])) << 1 |
+                                  spreadBits3(static_cast<uint32_t>(r.z * q[2])) << 2;
+            keyed[t] = static_cast<uint64_t>(code) << 32 | t;
+        }
+        std::sort(keyed.begin(), keyed.end());
+        for (uint32_t i = 0; i < tri_count; ++i) {
+            order[i] = static_cast<uint32_t>(keyed[i]);
+        }
+    }
+
+    // ── greedy growth ──
+    const uint32_t max_t = opt.max_triangles ? opt.max_triangles : 124;
+    const uint32_t max_v = std::max(3u, opt.max_vertices ? opt.max_vertices : 64);
+    const float    w     = std::clamp(opt.cone_weight, 0.0f, 1.0f);
+
+    std::vector<uint8_t>  emitted(tri_count, 0);
+    std::vector<uint32_t> mark(vtx_count, UINT32_MAX);   // meshlet id
+    std::vector<uint32_t> in_front(tri_count, UINT32_MAX);  // meshlet id
+    std::vector<uint32_t> slot_of(vtx_count, UINT32_MAX);
+    std::vector<uint32_t> frontier;
+    std::vector<uint32_t> m_tris;
+    std::vector<uint32_t> m_verts;
+    m_tris.reserve(max_t);
+    m_verts.reserve(max_v);
+    uint32_t remaining = tri_count;
+    uint32_t cursor = 0;
+    uint32_t meshlet_id = 0;
+
+    while (remaining > 0) {
+        while (emitted[order[cursor]]) ++cursor;
+
+        m_tris.clear();
+        m_verts.clear();
+        frontier.clear();
+        glm::vec3 c_sum(0.0f), n_sum(0.0f);
+        glm::vec3 mn( std::numeric_limits<float>::max());
+        glm::vec3 mx(-std::numeric_limits<float>::max());
+
+        // `frontier` holds every unused triangle touching a meshlet vertex
+        // (plus some already used since, dropped lazily).
+        auto add = [&](uint32_t t) {
+            emitted[t] = 1;
+            --remaining;
+            m_tris.push_back(t);
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = tv[t * 3 + k];
+                --live[v];
+                if (mark[v] == meshlet_id) continue;
+                mark[v] = meshlet_id;
+                m_verts.push_back(v);
+                mn = glm::min(mn, verts[lv[v]].position);
+                mx = glm::max(mx, verts[lv[v]].position);
+                for (uint32_t a = adj_off[v]; a < adj_off[v + 1]; ++a) {
+                    const uint32_t n = adj[a];
+                    if (emitted[n] || in_front[n] == meshlet_id) continue;
+                    in_front[n] = meshlet_id;
+                    frontier.push_back(n);
+                }
+            }
+            c_sum += centroid[t];
+            n_sum += normal[t];
+        };
+
+        // Topological priority first — 0: adds no vertex, 1: uses up a
+        // vertex no later meshlet could share, else 1 + new vertices — then
+        // the locality / normal score.  False when it no longer fits.
+        glm::vec3 center(0.0f), axis(0.0f);
+        float inv_radius = 0.0f;
+        auto rank = [&](uint32_t t, uint32_t& prio, float& score) {
+            uint32_t extra = 0;
+            bool dangling = false;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = tv[t * 3 + k];
+                extra += mark[v] != meshlet_id;
+                dangling |= live[v] == 1;
+            }
+            if (m_verts.size() + extra > max_v) return false;
+            prio = extra == 0 ? 0 : dangling ? 1 : 1 + extra;
+            const float dist = glm::length(centroid[t] - center) * inv_radius;
+            score = (1.0f - w) * dist + w * (1.0f - glm::dot(normal[t], axis));
+            return true;
+        };
+
+        add(order[cursor]);
+        while (m_tris.size() < max_t && remaining > 0) {
+            center = c_sum / static_cast<float>(m_tris.size());
+            inv_radius = 1.0f / std::max(0.5f * glm::length(mx - mn), 1e-12f);
+            const float n_len = glm::length(n_sum);
+            axis = n_len > 1e-6f ? n_sum / n_len : glm::vec3(0.0f);
+
+            uint32_t best = UINT32_MAX;
+            uint32_t best_prio = UINT32_MAX;
+            float best_score = 0.0f;
+            uint32_t prio = 0;
+            float score = 0.0f;
+            auto better = [&](uint32_t t) {
+                return prio < best_prio ||
+                       (prio == best_prio && (score < best_score ||
+                                              (score == best_score && t < best)));
+            };
+            size_t keep = 0;
+            for (uint32_t t : frontier) {
+                if (emitted[t]) continue;
+                frontier[keep++] = t;
+                if (rank(t, prio, score) && better(t)) {
+                    best = t;
+                    best_prio = prio;
+                    best_score = score;
+                }
+            }
+            frontier.resize(keep);
+            if (best == UINT32_MAX) {
+                // Nothing connected fits: the closest of the next few in
+                // Morton order, so separate pieces still fill a meshlet.
+                uint32_t seen = 0;
+                for (uint32_t i = cursor; i < tri_count && seen < kMortonWindow; ++i) {
+                    const uint32_t t = order[i];
+                    if (emitted[t]) continue;
+                    ++seen;
+                    if (!rank(t, prio, score)) continue;
+                    if (better(t)) {
+                        best = t;
+                        best_prio = prio;
+                        best_score = score;
+                    }
+                }
+            }
+            if (best == UINT32_MAX) break;
+            add(best);
+        }
+
+        cacheOrderMeshlet(m_tris, tv, slot_of);
+        out.emplace_back();
+        MeshletCluster& cl = out.back();
+        cl.face_indices.reserve(m_tris.size());
+        for (uint32_t t : m_tris) cl.face_indices.push_back(tri_face[t]);
+        finishMeshlet(verts, faces, cl);
+        ++meshlet_id;
+    }
+}
+
 // ── Cluster-level BVH helpers ──────────────────────────────────────────────
 // One entry per cluster fed into the BVH builder. We keep the cluster index
 // (into ClusterMesh::clusters) plus the cluster's AABB and centroid so the
@@ -247,43 +779,21 @@ bool& clusterIndirectActive() {
     return active;
 }
 
-// ─── buildClusterMesh() ─────────────────────────────────────────────────────
-void buildClusterMesh(const Mesh& mesh,
-                      ClusterMesh& out,
-                      uint32_t max_triangles_per_cluster) {
-    using clock = std::chrono::steady_clock;
-    const auto t_start = clock::now();
-
-    // Reset output in case it was reused.
-    out.clusters.clear();
-    out.source.reset();
-    out.max_triangles_per_cluster_setting = max_triangles_per_cluster;
-    out.total_triangles       = 0;
-    out.total_clusters        = 0;
-    out.min_tris_in_cluster   = 0;
-    out.max_tris_in_cluster   = 0;
-    out.avg_tris_in_cluster   = 0.0f;
-    out.build_time_ms         = 0.0;
-
-    if (!mesh.isValid() || mesh.getFaceCount() == 0) {
-#if CLUSTER_MESH_VERBOSE
-        std::printf("[CLUSTER] skipped: empty or invalid mesh\n");
-#endif
-        return;
-    }
+namespace {
 
-    const auto& verts = *mesh.vertex_data_ptr;
-    const auto& faces = *mesh.faces_ptr;
+// ── kGreedyBfs ─────────────────────────────────────────────────────────────
+void buildGreedyBfsClusters(const std::vector<VertexStruct>& verts,
+                            const std::vector<Face>& faces,
+                            uint32_t max_triangles_per_cluster,
+                            std::vector<MeshletCluster>& clusters) {
     const uint32_t face_count = static_cast<uint32_t>(faces.size());
 
-    if (max_triangles_per_cluster == 0) max_triangles_per_cluster = 128;
-
     // ── 1) edge -> adjacent faces ──────────────────────────────────────────
     std::unordered_map<uint64_t, EdgeAdj> edge_map;
     edge_map.reserve(face_count * 2);  // ~3 edges/face, each shared by 2 faces
     for (uint32_t f = 0; f < face_count; ++f) {
         const Face& face = faces[f];
-        if (face.isDegenerate()) continue;
+        if (!faceUsable(face, verts.size())) continue;
         for (int e = 0; e < 3; ++e) {
             const uint32_t a = face.v_indices[e];
             const uint32_t b = face.v_indices[(e + 1) % 3];
@@ -297,18 +807,18 @@ void buildClusterMesh(const Mesh& mesh,
     neighbour_scratch.reserve(3);
 
     // Pre-size the cluster list conservatively.
-    out.clusters.reserve((face_count + max_triangles_per_cluster - 1) /
+    clusters.reserve((face_count + max_triangles_per_cluster - 1) /
                          max_triangles_per_cluster);
 
     for (uint32_t seed = 0; seed < face_count; ++seed) {
         if (assigned[seed]) continue;
-        if (faces[seed].isDegenerate()) {
+        if (!faceUsable(faces[seed], verts.size())) {
             assigned[seed] = 1;  // silently skip degenerate triangles
             continue;
         }
 
-        out.clusters.emplace_back();
-        MeshletCluster& cl = out.clusters.back();
+        clusters.emplace_back();
+        MeshletCluster& cl = clusters.back();
         cl.face_indices.reserve(max_triangles_per_cluster);
 
         // BFS frontier. We use a plain queue — the traversal order is
@@ -337,7 +847,7 @@ void buildClusterMesh(const Mesh& mesh,
                     if (n == UINT32_MAX) continue;
                     if (n == f)          continue;
                     if (assigned[n])     continue;
-                    if (faces[n].isDegenerate()) continue;
+                    if (!faceUsable(faces[n], verts.size())) continue;
                     neighbour_scratch.push_back(n);
                 }
             }
@@ -360,7 +870,7 @@ void buildClusterMesh(const Mesh& mesh,
     }
 
     // ── 3) per-cluster geometry payload (bounds + normal cone) ─────────────
-    for (MeshletCluster& cl : out.clusters) {
+    for (MeshletCluster& cl : clusters) {
         // Gather unique vertices.
         // Use a small local set — clusters are tiny (<=128 tris, <=~256 verts).
         std::vector<uint32_t>& vidx = cl.vertex_indices;
@@ -455,6 +965,77 @@ void buildClusterMesh(const Mesh& mesh,
             cl.cone_cutoff = -1.0f;
         }
     }
+}
+
+} // anonymous namespace
+
+// ─── buildClusterMesh() ─────────────────────────────────────────────────────
+void buildClusterMesh(const Mesh& mesh,
+                      ClusterMesh& out,
+                      uint32_t max_triangles_per_cluster) {
+    ClusterBuildOptions options;
+    options.mode          = ClusterBuildMode::kGreedyBfs;
+    options.max_triangles = max_triangles_per_cluster;
+    buildClusterMesh(mesh, out, options);
+}
+
+void buildClusterMesh(const Mesh& mesh,
+                      ClusterMesh& out,
+                      const ClusterBuildOptions& options) {
+    using clock = std::chrono::steady_clock;
+    const auto t_start = clock::now();
+
+    const bool spatial = options.mode == ClusterBuildMode::kSpatialMeshlet;
+    uint32_t max_triangles_per_cluster = options.max_triangles;
+    if (max_triangles_per_cluster == 0) {
+        max_triangles_per_cluster = spatial ? 124 : 128;
+    }
+
+    // Reset output in case it was reused.
+    out.clusters.clear();
+    out.source.reset();
+    out.build_mode                        = options.mode;
+    out.max_triangles_per_cluster_setting = max_triangles_per_cluster;
+    out.max_vertices_per_cluster_setting  =
+        spatial ? std::max(3u, options.max_vertices ? options.max_vertices : 64u)
+                : 0u;
+    out.total_triangles       = 0;
+    out.total_clusters        = 0;
+    out.min_tris_in_cluster   = 0;
+    out.max_tris_in_cluster   = 0;
+    out.avg_tris_in_cluster   = 0.0f;
+    out.build_time_ms         = 0.0;
+
+    if (!mesh.isValid() || mesh.getFaceCount() == 0) {
+#if CLUSTER_MESH_VERBOSE
+        std::printf("[CLUSTER] skipped: empty or invalid mesh\n");
+#endif
+        return;
+    }
+
+    const auto& verts = *mesh.vertex_data_ptr;
+    const auto& faces = *mesh.faces_ptr;
+    const uint32_t face_count = static_cast<uint32_t>(faces.size());
+
+    if (!spatial) {
+        buildGreedyBfsClusters(verts, faces, max_triangles_per_cluster,
+                               out.clusters);
+    } else {
+        ClusterBuildOptions opt = options;
+        opt.max_triangles = max_triangles_per_cluster;
+        SpatialScratch scratch;
+        scratch.local_of.assign(verts.size(), UINT32_MAX);
+        uint32_t begin = 0;
+        for (size_t r = 0; r <= options.range_starts.size(); ++r) {
+            const uint32_t end = r < options.range_starts.size()
+                ? std::min(options.range_starts[r], face_count) : face_count;
+            if (end > begin) {
+                buildSpatialRange(verts, faces, begin, end, opt, scratch,
+                                  out.clusters);
+            }
+            begin = std::max(begin, end);
+        }
+    }
 
     // ── 4) aggregate stats ─────────────────────────────────────────────────
     // Store an owning copy of the Mesh struct. The Mesh itself is lightweight
@@ -504,5 +1085,84 @@ void buildClusterMesh(const Mesh& mesh,
     buildClusterBVH(out);
 }
 
+// ─── buildClusterMeshes() ───────────────────────────────────────────────────
+// Largest meshes first, handed out through an atomic cursor so one big mesh
+// does not leave the other workers idle behind parallelFor's static chunks.
+void buildClusterMeshes(std::vector<ClusterBuildJob>& jobs, ThreadPool* pool) {
+    std::vector<uint32_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        const size_t fa = jobs[a].mesh ? jobs[a].mesh->getFaceCount() : 0;
+        const size_t fb = jobs[b].mesh ? jobs[b].mesh->getFaceCount() : 0;
+        return fa > fb;
+    });
+
+    std::atomic<uint32_t> next{0};
+    auto drain = [&](size_t) {
+        for (uint32_t i; (i = next.fetch_add(1)) < order.size();) {
+            ClusterBuildJob& job = jobs[order[i]];
+            if (job.mesh && job.out) {
+                buildClusterMesh(*job.mesh, *job.out, job.options);
+            }
+        }
+    };
+    const size_t workers = pool ? std::min(pool->numThreads(), jobs.size()) : 0;
+    if (workers > 1) {
+        pool->parallelFor(workers, drain);
+    } else {
+        drain(0);
+    }
+}
+
+// ─── computeClusterCullStats() ──────────────────────────────────────────────
+ClusterCullStats computeClusterCullStats(const ClusterMesh& cm) {
+    ClusterCullStats st;
+    st.clusters = static_cast<uint32_t>(cm.clusters.size());
+    if (cm.clusters.empty() || !cm.source || !cm.source->isValid()) return st;
+    const auto& faces = *cm.source->faces_ptr;
+
+    double tris = 0, vtx = 0, cullable = 0, cull_rate = 0, angle = 0;
+    double radius = 0, ratio = 0, misses = 0;
+    uint32_t ratio_n = 0;
+    for (const MeshletCluster& cl : cm.clusters) {
+        tris += cl.triangleCount();
+        vtx  += cl.vertexCount();
+        if (cl.cone_cutoff >= 0.0f) {
+            cullable  += 1.0;
+            cull_rate += 0.5 * (1.0 - cl.cone_cutoff);
+            angle     += std::asin(std::min(1.0f, cl.cone_cutoff)) * 57.29577951;
+        }
+        radius += cl.bounds_radius;
+        const float half_diag = 0.5f * glm::length(cl.aabb_max - cl.aabb_min);
+        if (half_diag > 0.0f) {
+            ratio += cl.bounds_radius / half_diag;
+            ++ratio_n;
+        }
+
+        // Fresh FIFO per cluster: each one is its own draw / meshlet.
+        std::array<uint32_t, kCacheSize> fifo;
+        fifo.fill(UINT32_MAX);
+        uint32_t head = 0;
+        for (uint32_t f : cl.face_indices) {
+            for (uint32_t v : faces[f].v_indices) {
+                if (std::find(fifo.begin(), fifo.end(), v) != fifo.end()) continue;
+                fifo[head] = v;
+                head = (head + 1) % kCacheSize;
+                misses += 1.0;
+            }
+        }
+    }
+    const double n = static_cast<double>(st.clusters);
+    st.avg_triangles       = static_cast<float>(tris / n);
+    st.avg_vertices        = static_cast<float>(vtx / n);
+    st.cullable_fraction   = static_cast<float>(cullable / n);
+    st.backface_cull_rate  = static_cast<float>(cull_rate / n);
+    st.avg_cone_angle_deg  = cullable > 0 ? static_cast<float>(angle / cullable) : 0.0f;
+    st.avg_sphere_radius   = static_cast<float>(radius / n);
+    st.sphere_to_box_ratio = ratio_n ? static_cast<float>(ratio / ratio_n) : 0.0f;
+    st.acmr                = tris > 0 ? static_cast<float>(misses / tris) : 0.0f;
+    return st;
+}
+
 }  // namespace helper
 }  // namespace engine
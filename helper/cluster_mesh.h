@@ -20,6 +20,15 @@
 // exposes the toggle. Next step will consume `ClusterMesh` in a new draw
 // path (mesh-shader / GPU-driven) behind the toggle.
 //
+// Two builders (ClusterBuildMode):
+//   kSpatialMeshlet — meshlets under a vertex AND a triangle cap (64 / 124,
+//                     the mesh-shader sweet spot), grown by adjacency and
+//                     spatial locality, with minimal bounding spheres, tight
+//                     normal cones and cache-ordered triangles / vertices.
+//                     What the engine's load paths use.
+//   kGreedyBfs      — the original edge-adjacency BFS in face order, kept
+//                     as the baseline for computeClusterCullStats().
+//
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -31,6 +40,8 @@
 namespace engine {
 namespace helper {
 
+class ThreadPool;
+
 // ─── Per-cluster data ────────────────────────────────────────────────────────
 // One cluster = up to `max_triangles_per_cluster` contiguous triangles from
 // the source Mesh. `face_indices` are positions into Mesh::faces_ptr so the
@@ -43,6 +54,8 @@ struct MeshletCluster {
     // Unique vertex indices referenced by this cluster's faces. Useful for
     // the eventual mesh-shader path where each meshlet has its own small
     // vertex list (typical HW limit: 64 or 128 verts/meshlet).
+    // kGreedyBfs: ascending.  kSpatialMeshlet: first-use order over
+    // face_indices — the order the cluster renderer emits them in.
     std::vector<uint32_t> vertex_indices;
 
     // ── Culling payload (kept CPU-side now, will be promoted to GPU later) ──
@@ -53,7 +66,9 @@ struct MeshletCluster {
     glm::vec3 aabb_min = glm::vec3( std::numeric_limits<float>::max());
     glm::vec3 aabb_max = glm::vec3(-std::numeric_limits<float>::max());
     // Normal cone for back-face culling whole clusters at once:
-    //   axis    — area-weighted average face normal (unit length, local space)
+    //   axis    — kGreedyBfs: area-weighted average face normal;
+    //             kSpatialMeshlet: centre of the minimal cone around the
+    //             face normals (unit length, local space)
     //   cutoff  — sin(θ_max), where θ_max is the maximum angle between the
     //             axis and any face normal in the cluster.
     //             Stored as sin not cos so the GPU test is simply:
@@ -71,6 +86,26 @@ struct MeshletCluster {
     }
 };
 
+// ─── Build options ──────────────────────────────────────────────────────────
+enum class ClusterBuildMode : uint8_t {
+    kGreedyBfs,
+    kSpatialMeshlet,
+};
+
+struct ClusterBuildOptions {
+    ClusterBuildMode mode = ClusterBuildMode::kSpatialMeshlet;
+    uint32_t max_triangles = 124;
+    uint32_t max_vertices  = 64;      // kSpatialMeshlet only
+    // Growth score blend: 0 = pure spatial locality, 1 = pure normal
+    // agreement (tighter cones, rounder-but-larger spheres lose out).
+    float    cone_weight   = 0.25f;
+    // Ascending first-face offsets of contiguous face ranges that must
+    // never share a cluster — material sections, so a cluster's material
+    // can be resolved from its first face.  Empty = one range.  The
+    // kGreedyBfs builder ignores it.
+    std::vector<uint32_t> range_starts;
+};
+
 // ─── Top-level cluster sidecar ──────────────────────────────────────────────
 // Owned parallel to the Mesh it was built from. Holds only CPU-side data
 // right now; GPU-side mirror (meshlet buffer, cluster BVH) lands in a later
@@ -83,7 +118,9 @@ struct ClusterMesh {
     std::vector<MeshletCluster> clusters;
 
     // ── Aggregate stats (handy for the HUD + debugging) ──
+    ClusterBuildMode build_mode = ClusterBuildMode::kGreedyBfs;
     uint32_t max_triangles_per_cluster_setting = 128;
+    uint32_t max_vertices_per_cluster_setting  = 0;   // 0 = uncapped
     uint32_t total_triangles   = 0;
     uint32_t total_clusters    = 0;
     uint32_t min_tris_in_cluster = 0;
@@ -112,14 +149,50 @@ struct ClusterMesh {
 // Partitions `mesh` into clusters of up to `max_triangles_per_cluster`
 // triangles via greedy edge-adjacency BFS. Deterministic given identical
 // input. Does NOT modify `mesh`.
-//
-// The current implementation is dependency-free (pure std::). We will swap
-// in meshoptimizer's meshlet builder in a later step for better locality
-// and normal-cone quality, but the API here won't change.
 void buildClusterMesh(const Mesh& mesh,
                       ClusterMesh& out_clusters,
                       uint32_t max_triangles_per_cluster = 128);
 
+// Same, with the builder picked by `options.mode` (see ClusterBuildOptions).
+// Both builders are dependency-free and deterministic; degenerate faces and
+// faces with out-of-range indices are left out of every cluster.
+void buildClusterMesh(const Mesh& mesh,
+                      ClusterMesh& out_clusters,
+                      const ClusterBuildOptions& options);
+
+// Batch build: one job per mesh, spread over `pool` (null = serial on the
+// calling thread).  Jobs are independent; the call blocks until all are
+// done and must not be made from a pool worker.
+struct ClusterBuildJob {
+    const Mesh*         mesh = nullptr;
+    ClusterMesh*        out  = nullptr;
+    ClusterBuildOptions options;
+};
+void buildClusterMeshes(std::vector<ClusterBuildJob>& jobs,
+                        ThreadPool* pool = nullptr);
+
+// ─── Cull efficiency report ─────────────────────────────────────────────────
+// Quality numbers for comparing builders on the same mesh.
+struct ClusterCullStats {
+    uint32_t clusters            = 0;
+    float    avg_triangles       = 0.0f;
+    float    avg_vertices        = 0.0f;
+    // Clusters whose cone can cull at all (cone_cutoff >= 0).
+    float    cullable_fraction   = 0.0f;
+    // Expected fraction of clusters rejected by the cone test for a view
+    // direction drawn uniformly from the sphere: (1 - cutoff) / 2 each.
+    float    backface_cull_rate  = 0.0f;
+    float    avg_cone_angle_deg  = 0.0f;   // half-angle, cullable clusters
+    float    avg_sphere_radius   = 0.0f;
+    // Mean sphere radius / AABB half-diagonal.  1 = the AABB-centred
+    // sphere touching the corner; smaller is tighter.
+    float    sphere_to_box_ratio = 0.0f;
+    // Post-transform cache misses per triangle (16-entry FIFO) over each
+    // cluster's emitted index stream.  Floor is vertices / triangles.
+    float    acmr                = 0.0f;
+};
+ClusterCullStats computeClusterCullStats(const ClusterMesh& cm);
+
 // ─── Cluster BVH build ──────────────────────────────────────────────────────
 // Builds a top-down binary BVH over the cluster list already present in
 // `cm.clusters`. Uses median split on the longest centroid-extent axis
@@ -1,30 +1,22 @@
 //
 // dialog_llm.cpp — Ollama /api/chat client for the in-game dialogue box.
-// See dialog_llm.h for the contract.  Transport is a trimmed copy of
-// material_classifier.cpp's WinHTTP path (same daemon, same reasons:
-// NO_PROXY so a system proxy can't eat localhost, plain HTTP).
+// See dialog_llm.h for the contract.  Transport is helper/http_client,
+// the same keep-alive client material_classifier.cpp uses (plain HTTP to
+// the local daemon; no proxy can sit in the way).
 //
 #include <atomic>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
 
-#ifndef NOMINMAX
-#define NOMINMAX
-#endif
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include "Windows.h"
-#include "winhttp.h"
-#pragma comment(lib, "winhttp.lib")
-
 #include "json.hpp"   // vendored at third_parties/tinygltf/json.hpp
 
 #include "dialog_llm.h"
+#include "http_client.h"
 
 namespace engine {
 namespace helper {
@@ -41,11 +33,15 @@ struct State {
     std::atomic<bool>      is_available{false};
     std::atomic<bool>      in_flight{false};
     std::atomic<uint64_t>  revision{0};
+    std::atomic<uint64_t>  turn{0};
     std::string            model;
     std::string            host = "localhost";
     unsigned short         port = 11434;
     std::vector<Msg>       history;   // excludes the system prompt
     std::string            last_reply;
+    // Keep-alive connection to the daemon, created by the probe.  Only
+    // the probe and then the single in-flight turn ever use it.
+    std::unique_ptr<HttpClient> http;
 };
 State& S() {
     static State s;
@@ -57,73 +53,31 @@ std::string getEnvStr(const char* name, const char* fallback) {
     return (v && v[0]) ? std::string(v) : std::string(fallback);
 }
 
-std::wstring widen(const std::string& s) {
-    return std::wstring(s.begin(), s.end());   // host names are ASCII
-}
-
-// Minimal WinHTTP round-trip (blocking — only ever called from the
-// worker threads below, never the render thread).
-struct HttpResult { unsigned int status = 0; std::string body; };
-HttpResult httpRequest(
-    const std::string& host, unsigned short port,
-    const wchar_t* method, const std::string& path,
-    const std::string& body) {
-    HttpResult r{};
-    HINTERNET session = WinHttpOpen(
-        L"RealWorld-DialogLlm/1.0",
-        WINHTTP_ACCESS_TYPE_NO_PROXY,
-        WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
-    if (!session) return r;
-    // Generation on a 2B model can take a while on first load — give
-    // the daemon a generous receive window.
-    WinHttpSetTimeouts(session, 5000, 5000, 120000, 120000);
-    HINTERNET conn = WinHttpConnect(
-        session, widen(host).c_str(), port, 0);
-    if (conn) {
-        HINTERNET req = WinHttpOpenRequest(
-            conn, method, widen(path).c_str(),
-            nullptr, WINHTTP_NO_REFERER,
-            WINHTTP_DEFAULT_ACCEPT_TYPES, 0);
-        if (req) {
-            const wchar_t* hdrs =
-                L"Content-Type: application/json\r\n";
-            BOOL ok = WinHttpSendRequest(
-                req, hdrs, (DWORD)-1,
-                body.empty() ? WINHTTP_NO_REQUEST_DATA
-                             : (LPVOID)body.data(),
-                (DWORD)body.size(), (DWORD)body.size(), 0);
-            if (ok) ok = WinHttpReceiveResponse(req, nullptr);
-            if (ok) {
-                DWORD status = 0, sz = sizeof(status);
-                WinHttpQueryHeaders(
-                    req,
-                    WINHTTP_QUERY_STATUS_CODE |
-                        WINHTTP_QUERY_FLAG_NUMBER,
-                    WINHTTP_HEADER_NAME_BY_INDEX, &status, &sz,
-                    WINHTTP_NO_HEADER_INDEX);
-                r.status = status;
-                for (;;) {
-                    DWORD avail = 0;
-                    if (!WinHttpQueryDataAvailable(req, &avail) ||
-                        avail == 0) {
-                        break;
-                    }
-                    std::string chunk(avail, '\0');
-                    DWORD got = 0;
-                    if (!WinHttpReadData(req, chunk.data(), avail,
-                                         &got) || got == 0) {
-                        break;
-                    }
-                    chunk.resize(got);
-                    r.body += chunk;
-                }
-            }
-            WinHttpCloseHandle(req);
+// Streamed /api/chat reply: one JSON frame per line, each carrying the
+// next few tokens in message.content and the last one "done":true.  Cuts
+// the complete lines off `pending` and appends their text to `reply`; a
+// partial line stays for the next chunk.
+void takeFrames(std::string& pending, std::string& reply, bool& done) {
+    size_t pos = 0, nl;
+    while ((nl = pending.find('\n', pos)) != std::string::npos) {
+        const json frame = json::parse(
+            pending.begin() + pos, pending.begin() + nl, nullptr,
+            /*allow_exceptions=*/false);
+        pos = nl + 1;
+        if (frame.is_discarded() || !frame.is_object()) continue;
+        if (frame.contains("error") && frame["error"].is_string()) {
+            std::cout << "[dialog.llm] ollama error: "
+                      << frame["error"].get<std::string>() << std::endl;
         }
-        WinHttpCloseHandle(conn);
+        const auto msg = frame.find("message");
+        if (msg != frame.end() && msg->is_object()) {
+            const auto content = msg->find("content");
+            if (content != msg->end() && content->is_string())
+                reply += content->get<std::string>();
+        }
+        if (frame.value("done", false)) done = true;
     }
-    WinHttpCloseHandle(session);
-    return r;
+    pending.erase(0, pos);
 }
 
 std::string systemPrompt() {
@@ -160,10 +114,14 @@ void runProbe() {
         std::lock_guard<std::mutex> lk(s.mtx);
         host = s.host;
         port = s.port;
+        s.http = std::make_unique<HttpClient>(host, port);
+        // Generation on a 2B model can take a while on first load — give
+        // the daemon a generous window before the first token.
+        s.http->setTimeouts(5000, 120000);
     }
 
-    const HttpResult tags =
-        httpRequest(host, port, L"GET", "/api/tags", "");
+    const HttpClient::Result tags =
+        s.http->request("GET", "/api/tags", "");
     std::string resolved;
     if (tags.status == 200) {
         // 1. Exact tag from env.
@@ -232,6 +190,8 @@ bool DialogLlm::busy() { return S().in_flight.load(); }
 
 uint64_t DialogLlm::revision() { return S().revision.load(); }
 
+uint64_t DialogLlm::turn() { return S().turn.load(); }
+
 std::string DialogLlm::reply() {
     auto& s = S();
     std::lock_guard<std::mutex> lk(s.mtx);
@@ -250,17 +210,23 @@ bool DialogLlm::send(const std::string& user_text) {
     auto& s = S();
     if (!available() || user_text.empty()) return false;
     if (s.in_flight.exchange(true)) return false;
+    {
+        // The new turn starts empty and grows as tokens stream in.
+        std::lock_guard<std::mutex> lk(s.mtx);
+        s.last_reply.clear();
+        s.turn.fetch_add(1);
+    }
+    s.revision.fetch_add(1);
 
     std::thread([user_text]() {
         auto& s = S();
-        std::string host, model;
-        unsigned short port;
+        std::string model;
+        HttpClient* http = nullptr;
         json messages = json::array();
         {
             std::lock_guard<std::mutex> lk(s.mtx);
-            host  = s.host;
-            port  = s.port;
             model = s.model;
+            http  = s.http.get();
             messages.push_back(
                 { {"role", "system"}, {"content", systemPrompt()} });
             for (const auto& m : s.history) {
@@ -274,25 +240,46 @@ bool DialogLlm::send(const std::string& user_text) {
         json body_j = {
             {"model", model},
             {"messages", messages},
-            {"stream", false},
+            {"stream", true},
         };
-        const HttpResult res = httpRequest(
-            host, port, L"POST", "/api/chat", body_j.dump());
-
-        std::string reply_text;
-        if (res.status == 200) {
-            try {
-                const json j = json::parse(res.body);
-                reply_text = j.value("message", json::object())
-                                 .value("content", "");
-            } catch (...) {}
+        // Publish every piece as it lands so the dialogue box (and the
+        // voice behind it) can start on the first sentence.
+        std::string pending, reply_text;
+        bool done = false;
+        auto publish = [&](size_t from) {
+            if (reply_text.size() == from) return;
+            {
+                std::lock_guard<std::mutex> lk(s.mtx);
+                s.last_reply.append(reply_text, from, std::string::npos);
+            }
+            s.revision.fetch_add(1);
+        };
+        const HttpClient::Result res = http->request(
+            "POST", "/api/chat", body_j.dump(),
+            [&](const char* data, size_t len) {
+                pending.append(data, len);
+                const size_t from = reply_text.size();
+                takeFrames(pending, reply_text, done);
+                publish(from);
+                return true;
+            });
+        if (!pending.empty()) {          // last frame without its newline
+            pending += '\n';
+            const size_t from = reply_text.size();
+            takeFrames(pending, reply_text, done);
+            publish(from);
         }
+
         if (reply_text.empty()) {
             reply_text =
                 "(\xE6\xB2\x89\xE9\xBB\x98\xE4\xB8\x8D\xE8\xAF\xAD)";
             // "(沉默不语)" — visible marker for a failed generation.
             std::cout << "[dialog.llm] chat request failed, status "
                       << res.status << std::endl;
+        } else if (res.status != 200 || !res.complete || !done) {
+            // Keep what was already shown (and maybe spoken).
+            std::cout << "[dialog.llm] reply stream cut short, status "
+                      << res.status << std::endl;
         }
 
         {
@@ -14,7 +14,9 @@
 //
 // All calls are non-blocking: the availability probe and each chat
 // turn run on background threads; ChatBox polls revision()/reply()
-// per frame.  Conversation history is kept process-wide (one NPC
+// per frame.  Replies STREAM: reply() grows token by token while
+// busy(), so the box (and the voice reading it) starts on the first
+// sentence instead of waiting for the whole answer.  Conversation history is kept process-wide (one NPC
 // conversation at a time — matches the single ChatBox).
 //
 #include <cstdint>
@@ -41,7 +43,12 @@ public:
     // Monotonic change counter: bumps when reply() content changes.
     static uint64_t revision();
 
-    // Latest assistant reply, UTF-8 (Chinese for the Jin Yong model).
+    // Bumps when send() starts a new reply (reply() is then cleared and
+    // refills from scratch).
+    static uint64_t turn();
+
+    // Latest assistant reply, UTF-8 (Chinese for the Jin Yong model) —
+    // partial while busy(), complete once it is not.
     static std::string reply();
 
     // Drop the conversation history (keeps the resolved model).
@@ -1,5 +1,6 @@
 #include <fstream>
 #include <filesystem>
+#include <deque>
 #include <mutex>
 #include <unordered_map>
 #include <sstream>
@@ -9,10 +10,14 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <utility>
 
 #include "engine_helper.h"
 #include "renderer/renderer.h"
+#include "renderer/frame_upload_ring.h"
 #include "dds.h"
+#include "ktx2.h"
+#include "vram_cuda.h"
 
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -67,9 +72,63 @@ void storeImageFileWithHeader(
 namespace {
 // Cross-asset texture dedup cache. Keyed by canonical path + srgb + format; the
 // cache OWNS each entry (borrowed_ == false) and hands callers borrowed copies
-// that share the same GPU handles. Frees once at shutdown (destroyTextureCache).
+// that share the same GPU handles. Frees at shutdown (destroyTextureCache), or
+// earlier when an unborrowed entry is evicted (updateTextureResidency).
 std::mutex                                             g_tex_cache_mutex;
 std::unordered_map<std::string, renderer::TextureInfo> g_tex_cache;
+// Bumped by destroyTextureCache so a mip stream queued before it never
+// writes into a freed image.  Guarded by g_tex_cache_mutex.
+uint64_t                                               g_tex_cache_generation = 1;
+
+// VRAM residency of the cache entries, guarded by g_tex_cache_mutex.
+// Entries register whole (tail = every level): a texture bound in a
+// material descriptor set cannot lose mips in place, so the only action
+// the manager can take here is evicting entries nobody borrows any more.
+// An evicted entry comes back through the ordinary cache miss.
+renderer::ResidencyConfig texResidencyConfig() {
+    renderer::ResidencyConfig config;
+    config.idle_frames = 8;            // well past the frames in flight
+    config.evict_after_frames = 600;
+    return config;
+}
+renderer::ResidencyManager                             g_tex_residency{texResidencyConfig()};
+std::unordered_map<std::string, renderer::ResidencyHandle> g_tex_residency_handles;
+std::vector<std::string>                               g_tex_residency_keys;   // by handle
+uint64_t                                               g_tex_residency_frame = 0;
+uint64_t                                               g_tex_residency_cap = 0;
+uint64_t                                               g_tex_budget_query_frame = 0;
+renderer::ResidencyBudgetInputs                        g_tex_budget_inputs;
+
+uint64_t textureLevelBytes(renderer::Format format, uint32_t width,
+                           uint32_t height, uint32_t level) {
+    const uint32_t vk_format = static_cast<uint32_t>(format);
+    if (ktx2BlockBytes(vk_format) != 0)
+        return ktx2LevelBytes(vk_format, width, height, level);
+    const uint64_t texel = format == renderer::Format::R16_UNORM ? 2 : 4;
+    return uint64_t(std::max(width >> level, 1u)) *
+           std::max(height >> level, 1u) * texel;
+}
+
+void registerTexResidency(const std::string& key, renderer::Format format,
+                          uint32_t width, uint32_t height, uint32_t mips) {
+    renderer::ResidencyResourceDesc desc;
+    desc.kind = renderer::ResidencyKind::kTexture;
+    desc.width = width;
+    for (uint32_t l = 0; l < std::max(mips, 1u); ++l)
+        desc.level_bytes.push_back(textureLevelBytes(format, width, height, l));
+    desc.tail_levels = static_cast<uint32_t>(desc.level_bytes.size());
+    const renderer::ResidencyHandle h =
+        g_tex_residency.add(desc, g_tex_residency_frame);
+    if (h >= g_tex_residency_keys.size()) g_tex_residency_keys.resize(h + 1);
+    g_tex_residency_keys[h] = key;
+    g_tex_residency_handles[key] = h;
+}
+
+// .ktx2 high mips waiting for MeshLoadTaskManager::poll(), then, once
+// read, for recordTextureMipUploads().
+std::mutex                                             g_mip_stream_mutex;
+std::vector<std::shared_ptr<TextureMipStream>>         g_mip_streams;
+std::deque<std::shared_ptr<TextureMipStream>>          g_mip_uploads;
 
 std::string texCacheKey(const std::string& file_name, bool srgb,
                         renderer::Format fmt) {
@@ -79,127 +138,262 @@ std::string texCacheKey(const std::string& file_name, bool srgb,
     return p + "|" + (srgb ? "s" : "l") + "|" +
            std::to_string(static_cast<int>(fmt));
 }
-}  // namespace
 
-void createTextureImage(
-    const std::shared_ptr<renderer::Device>& device,
-    const std::string& file_name,
-    const renderer::Format& input_format,
+// Hands out a borrowed copy of the cached entry for `key`, if any.
+bool lookupTexCache(const std::string& key, renderer::TextureInfo& texture) {
+    std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
+    auto it = g_tex_cache.find(key);
+    if (it == g_tex_cache.end()) return false;
+    texture = it->second;      // share the cached GPU handles
+    texture.borrowed_ = true;  // caller must not free; cache owns
+    return true;
+}
+
+[[noreturn]] void failKtx2(const std::string& path, const std::string& why) {
+    const std::string msg =
+        "failed to load texture image '" + path + "' — " + why;
+    std::cout << "[texture] " << msg << std::endl;
+    throw std::runtime_error(msg);
+}
+
+// Mip tail of a .ktx2 plus placeholders for the levels above it (all of
+// them when the format has no placeholder encoder, or for RGB8, which is
+// widened to RGBA8 because few GPUs sample 3-byte texels).
+void decodeKtx2Texture(
+    const std::string& ktx2_path,
     bool is_srgb_texture,
-    renderer::TextureInfo& texture,
-    const std::source_location& src_location,
-    bool cacheable) {
+    DecodedTextureImage& decoded) {
+    Ktx2File file;
+    if (!file.open(ktx2_path)) failKtx2(ktx2_path, file.error());
+    const uint32_t w = file.width();
+    const uint32_t h = file.height();
+    const uint32_t n = file.levelCount();
+    uint32_t fmt = ktx2WithSrgb(file.vkFormat(), is_srgb_texture);
+
+    decoded.is_ktx2 = true;
+    decoded.ktx2_path = ktx2_path;
+    decoded.size = glm::uvec3(w, h, 1);
+    decoded.mip_levels = n;
+
+    uint32_t first = 0;
+    if (ktx2BlockBytes(fmt) == 3) {
+        std::vector<uint8_t> rgb;
+        if (!file.readLevels(0, n, rgb)) failKtx2(ktx2_path, file.error());
+        fmt = is_srgb_texture ? kKtx2R8G8B8A8Srgb : kKtx2R8G8B8A8Unorm;
+        decoded.ktx2_chain.resize(rgb.size() / 3 * 4);
+        for (size_t i = 0, o = 0; i < rgb.size(); i += 3, o += 4) {
+            decoded.ktx2_chain[o + 0] = rgb[i + 0];
+            decoded.ktx2_chain[o + 1] = rgb[i + 1];
+            decoded.ktx2_chain[o + 2] = rgb[i + 2];
+            decoded.ktx2_chain[o + 3] = 255;
+        }
+    } else {
+        first = file.tailStart(kKtx2TailDim);
+        decoded.ktx2_chain.resize(size_t(ktx2LevelOffset(fmt, w, h, 0, n)));
+        if (!file.readLevels(first, n - first, decoded.ktx2_chain,
+                             size_t(ktx2LevelOffset(fmt, w, h, 0, first))))
+            failKtx2(ktx2_path, file.error());
+        if (first > 0 &&
+            !fillKtx2Placeholders(fmt, w, h, first,
+                                  decoded.ktx2_chain.data())) {
+            if (!file.readLevels(0, first, decoded.ktx2_chain))
+                failKtx2(ktx2_path, file.error());
+            first = 0;
+        }
+    }
 
-    // Create a path object
-    std::filesystem::path file_path(file_name);
+    decoded.first_resident_mip = first;
+    decoded.format = static_cast<renderer::Format>(fmt);
+    decoded.level_bytes.resize(n);
+    for (uint32_t l = 0; l < n; ++l)
+        decoded.level_bytes[l] = ktx2LevelBytes(fmt, w, h, l);
+}
 
-    // Get the file extension
-    auto extension = file_path.extension().string();
+// Re-reads levels [0, count) of `path` into `out` after checking the file
+// still describes the texture decoded earlier.
+bool readKtx2HighMips(
+    const std::string& path,
+    renderer::Format format,
+    uint32_t width,
+    uint32_t height,
+    uint32_t count,
+    std::vector<uint8_t>& out,
+    std::string& error) {
+    Ktx2File file;
+    if (!file.open(path)) {
+        error = file.error();
+        return false;
+    }
+    const uint32_t fmt = static_cast<uint32_t>(format);
+    if (file.width() != width || file.height() != height ||
+        file.levelCount() < count ||
+        ktx2WithSrgb(file.vkFormat(), ktx2IsSrgb(fmt)) != fmt) {
+        error = "file changed since its mip tail was loaded";
+        return false;
+    }
+    if (!file.readLevels(0, count, out)) {
+        error = file.error();
+        return false;
+    }
+    return true;
+}
+}  // namespace
 
-    // Cross-asset dedup: identical (path, srgb, format) -> one GPU upload.
-    const bool do_cache = cacheable && !file_name.empty();
-    std::string cache_key;
-    if (do_cache) {
-        cache_key = texCacheKey(file_name, is_srgb_texture, input_format);
-        std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
-        auto it = g_tex_cache.find(cache_key);
-        if (it != g_tex_cache.end()) {
-            texture = it->second;      // share the cached GPU handles
-            texture.borrowed_ = true;  // caller must not free; cache owns
+bool isTextureCached(
+    const std::string& file_name,
+    bool is_srgb_texture,
+    const renderer::Format& format) {
+    if (file_name.empty()) return false;
+    const std::string key = texCacheKey(file_name, is_srgb_texture, format);
+    std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
+    return g_tex_cache.count(key) != 0;
+}
+
+void decodeTextureImage(
+    const std::string& file_name,
+    const renderer::Format& input_format,
+    bool is_srgb_texture,
+    DecodedTextureImage& decoded) {
+
+    decoded = DecodedTextureImage{};
+    decoded.file_name = file_name;
+    decoded.requested_format = input_format;
+    decoded.is_srgb = is_srgb_texture;
+    decoded.format = input_format;
+
+    // A .ktx2 — or a .dds that has been converted (ktx2_convert.h) — is
+    // read mip tail first.
+    const std::filesystem::path path(file_name);
+    const std::string ext = path.extension().string();
+    if (ext == ".ktx2") {
+        decodeKtx2Texture(file_name, is_srgb_texture, decoded);
+        return;
+    }
+    if (ext == ".dds") {
+        std::filesystem::path ktx2 = path;
+        ktx2.replace_extension(".ktx2");
+        std::error_code ec;
+        if (std::filesystem::exists(ktx2, ec)) {
+            decodeKtx2Texture(ktx2.string(), is_srgb_texture, decoded);
             return;
         }
     }
+    decoded.is_dds = ext == ".dds";
 
-    int tex_width = 1, tex_height = 1, tex_channels = 1;
-    void* void_pixels = nullptr;
-
-    bool is_dds =
-        extension == ".dds";
-
-    auto format = input_format;
-    std::vector<char> buffer_data;
-    if (is_dds) {
+    if (decoded.is_dds) {
         renderer::Format actual_format =
             renderer::Format::R8G8B8A8_UNORM;
         loadDdsTexture(
             actual_format,
             is_srgb_texture,
-            texture.size,
-            texture.mip_levels,
-            buffer_data,
+            decoded.size,
+            decoded.mip_levels,
+            decoded.dds_data,
             file_name);
+        decoded.format = actual_format;
+        return;
+    }
 
+    int tex_width = 1, tex_height = 1, tex_channels = 1;
+    void* void_pixels = nullptr;
+    size_t bytes_per_texel = 4;
+    if (input_format == engine::renderer::Format::R16_UNORM) {
         void_pixels =
-            buffer_data.data() +
-            sizeof(helper::DDS_HEADER);
-
-        tex_width = texture.size.x;
-        tex_height = texture.size.y;
-
-        format = actual_format;
+            stbi_load_16(
+                file_name.c_str(),
+                &tex_width,
+                &tex_height,
+                &tex_channels,
+                STBI_grey);
+        bytes_per_texel = 2;
     }
     else {
-        if (format == engine::renderer::Format::R16_UNORM) {
-            stbi_us* pixels =
-                stbi_load_16(
-                    file_name.c_str(),
-                    &tex_width,
-                    &tex_height,
-                    &tex_channels,
-                    STBI_grey);
-            void_pixels = pixels;
-        }
-        else {
-            stbi_uc* pixels =
-                stbi_load(
-                    file_name.c_str(),
-                    &tex_width,
-                    &tex_height,
-                    &tex_channels,
-                    STBI_rgb_alpha);
-            void_pixels = pixels;
-        }
+        void_pixels =
+            stbi_load(
+                file_name.c_str(),
+                &tex_width,
+                &tex_height,
+                &tex_channels,
+                STBI_rgb_alpha);
+    }
 
-        if (!void_pixels) {
-            // NAME THE FILE.  "failed to load texture image!" on its own
-            // says a texture failed but not which one, and the loader is
-            // called for engine assets, imported model textures and
-            // runtime-generated maps alike — so the message was a debug
-            // session, not a diagnosis.  stbi's own reason distinguishes
-            // "file not there" from "there but corrupt/truncated", which
-            // is exactly the fork that decides what to do about it.
-            const char* why = stbi_failure_reason();
-            std::string msg = "failed to load texture image '" +
-                              file_name + "'";
-            {
-                std::error_code fe_ec;
-                if (!std::filesystem::exists(file_name, fe_ec)) {
-                    msg += " — file does not exist";
-                } else {
-                    msg += " — exists (" +
-                           std::to_string(static_cast<unsigned long long>(
-                               std::filesystem::file_size(file_name,
-                                                          fe_ec))) +
-                           " B) but could not be decoded";
-                }
+    if (!void_pixels) {
+        // NAME THE FILE.  "failed to load texture image!" on its own
+        // says a texture failed but not which one, and the loader is
+        // called for engine assets, imported model textures and
+        // runtime-generated maps alike — so the message was a debug
+        // session, not a diagnosis.  stbi's own reason distinguishes
+        // "file not there" from "there but corrupt/truncated", which
+        // is exactly the fork that decides what to do about it.
+        const char* why = stbi_failure_reason();
+        std::string msg = "failed to load texture image '" +
+                          file_name + "'";
+        {
+            std::error_code fe_ec;
+            if (!std::filesystem::exists(file_name, fe_ec)) {
+                msg += " — file does not exist";
+            } else {
+                msg += " — exists (" +
+                       std::to_string(static_cast<unsigned long long>(
+                           std::filesystem::file_size(file_name,
+                                                      fe_ec))) +
+                       " B) but could not be decoded";
             }
-            if (why && *why) {
-                msg += std::string("; stb_image: ") + why;
-            }
-            std::cout << "[texture] " << msg << std::endl;
-            throw std::runtime_error(msg);
         }
+        if (why && *why) {
+            msg += std::string("; stb_image: ") + why;
+        }
+        std::cout << "[texture] " << msg << std::endl;
+        throw std::runtime_error(msg);
+    }
+
+    // One copy out of stb's allocation.  For RGBA8 this vector becomes
+    // texture.cpu_pixels as-is, so the VT manager's CPU copy costs
+    // nothing extra on the thread that creates the image.
+    const size_t bytes =
+        size_t(tex_width) * size_t(tex_height) * bytes_per_texel;
+    const uint8_t* src = static_cast<const uint8_t*>(void_pixels);
+    decoded.pixels = std::make_shared<std::vector<uint8_t>>(src, src + bytes);
+    stbi_image_free(void_pixels);
+
+    decoded.size = glm::uvec3(tex_width, tex_height, 1);
+    decoded.mip_levels = 1;
+}
+
+void createTextureImage(
+    const std::shared_ptr<renderer::Device>& device,
+    DecodedTextureImage& decoded,
+    renderer::TextureInfo& texture,
+    const std::source_location& src_location,
+    bool cacheable) {
+
+    // Cross-asset dedup: identical (path, srgb, format) -> one GPU upload.
+    // Checked again here because the decode may have run on a worker while
+    // another asset uploaded the same file.
+    const bool do_cache = cacheable && !decoded.file_name.empty();
+    std::string cache_key;
+    if (do_cache) {
+        cache_key = texCacheKey(
+            decoded.file_name, decoded.is_srgb, decoded.requested_format);
+        if (lookupTexCache(cache_key, texture)) return;
     }
 
-    if (is_dds) {
+    if (!decoded.is_dds && !decoded.is_ktx2 && !decoded.pixels) {
+        throw std::runtime_error(
+            "texture '" + decoded.file_name + "' was never decoded");
+    }
+
+    const auto format = decoded.format;
+    texture.mip_levels = decoded.mip_levels;
+    if (decoded.is_dds) {
         renderer::Helper::create2DTextureImage(
             device,
             format,
-            tex_width,
-            tex_height,
-            std::max(texture.mip_levels, 1u),
-            buffer_data.size() - sizeof(helper::DDS_HEADER),
-            void_pixels,
+            decoded.size.x,
+            decoded.size.y,
+            std::max(decoded.mip_levels, 1u),
+            decoded.dds_data.size() - sizeof(helper::DDS_HEADER),
+            decoded.dds_data.data() + sizeof(helper::DDS_HEADER),
             texture.image,
             texture.memory,
             src_location);
@@ -207,33 +401,55 @@ void createTextureImage(
         // BC-compressed data, not the RGBA8 the VT manager expects.
         // Materials that use DDS sources will skip VT registration.
     }
+    else if (decoded.is_ktx2) {
+        // Only the cache keeps an image alive long enough to stream its
+        // high mips into; anything else gets the real levels now.
+        if (decoded.first_resident_mip > 0 && !do_cache) {
+            std::string error;
+            if (!readKtx2HighMips(
+                    decoded.ktx2_path, format, decoded.size.x,
+                    decoded.size.y, decoded.first_resident_mip,
+                    decoded.ktx2_chain, error)) {
+                failKtx2(decoded.ktx2_path, error);
+            }
+            decoded.first_resident_mip = 0;
+        }
+        renderer::Helper::create2DTextureImageFromLevels(
+            device,
+            format,
+            decoded.size.x,
+            decoded.size.y,
+            decoded.level_bytes,
+            decoded.ktx2_chain.data(),
+            texture.image,
+            texture.memory,
+            src_location);
+        // Like DDS: block data, so no cpu_pixels for the VT manager.
+    }
     else {
         renderer::Helper::create2DTextureImage(
             device,
             format,
-            tex_width,
-            tex_height,
-            void_pixels,
+            decoded.size.x,
+            decoded.size.y,
+            decoded.pixels->data(),
             texture.image,
             texture.memory,
             src_location);
 
-        // Stash a CPU-side copy of the just-decoded RGBA8 pixels so
-        // the Virtual Texture manager can build its bordered tile
-        // pyramid without a GPU readback.  Only meaningful for the
-        // RGBA8 (4 bytes/texel) path — R16 textures aren't sliced
-        // into VT tiles, so skip the copy.
+        // Keep the decoded RGBA8 pixels CPU-side so the Virtual Texture
+        // manager can build its bordered tile pyramid without a GPU
+        // readback.  Only meaningful for the RGBA8 (4 bytes/texel) path
+        // — R16 textures aren't sliced into VT tiles.
         if (format != engine::renderer::Format::R16_UNORM) {
-            const size_t bytes = size_t(tex_width) * size_t(tex_height) * 4u;
-            const uint8_t* src = static_cast<const uint8_t*>(void_pixels);
-            texture.cpu_pixels = std::make_shared<std::vector<uint8_t>>(
-                src, src + bytes);
+            texture.cpu_pixels = decoded.pixels;
         }
-
-        stbi_image_free(void_pixels);
     }
+    decoded.pixels.reset();
+    decoded.dds_data = {};
+    decoded.ktx2_chain = {};
 
-    texture.size = { tex_width, tex_height, 1.0f };
+    texture.size = { decoded.size.x, decoded.size.y, 1.0f };
 
     texture.view = device->createImageView(
         texture.image,
@@ -245,27 +461,203 @@ void createTextureImage(
         std::max(texture.mip_levels, 1u));
 
     if (do_cache) {
+        std::shared_ptr<TextureMipStream> stream;
+        {
+            std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
+            renderer::TextureInfo owning = texture;
+            owning.borrowed_ = false;              // cache is the sole owner
+            auto [it, inserted] = g_tex_cache.try_emplace(cache_key, owning);
+            if (!inserted) {
+                // Lost a race: free our redundant GPU texture, adopt the cached one.
+                texture.borrowed_ = false;
+                texture.destroy(device);
+            } else {
+                registerTexResidency(cache_key, format, decoded.size.x,
+                                     decoded.size.y, texture.mip_levels);
+                if (decoded.first_resident_mip > 0) {
+                    stream = std::make_shared<TextureMipStream>();
+                    stream->ktx2_path = decoded.ktx2_path;
+                    stream->image = owning.image;
+                    stream->format = format;
+                    stream->width = decoded.size.x;
+                    stream->height = decoded.size.y;
+                    stream->mip_count = decoded.first_resident_mip;
+                    stream->cache_generation = g_tex_cache_generation;
+                }
+            }
+            texture = it->second;
+            texture.borrowed_ = true;              // hand caller a borrowed view
+        }
+        if (stream) {
+            std::lock_guard<std::mutex> lk(g_mip_stream_mutex);
+            g_mip_streams.push_back(std::move(stream));
+        }
+    }
+}
+
+std::vector<std::shared_ptr<TextureMipStream>> takeTextureMipStreams() {
+    std::lock_guard<std::mutex> lk(g_mip_stream_mutex);
+    return std::exchange(g_mip_streams, {});
+}
+
+bool readTextureMipStream(TextureMipStream& stream, std::string& error) {
+    stream.level_bytes.resize(stream.mip_count);
+    for (uint32_t l = 0; l < stream.mip_count; ++l) {
+        stream.level_bytes[l] = ktx2LevelBytes(
+            static_cast<uint32_t>(stream.format), stream.width,
+            stream.height, l);
+    }
+    return readKtx2HighMips(
+        stream.ktx2_path, stream.format, stream.width, stream.height,
+        stream.mip_count, stream.levels, error);
+}
+
+void queueTextureMipUpload(std::shared_ptr<TextureMipStream> stream) {
+    std::lock_guard<std::mutex> lk(g_mip_stream_mutex);
+    g_mip_uploads.push_back(std::move(stream));
+}
+
+void recordTextureMipUploads(
+    const std::shared_ptr<renderer::Device>& device,
+    const std::shared_ptr<renderer::CommandBuffer>& cmd_buf,
+    renderer::FrameUploadRing& staging) {
+    // A burst of streamed materials spreads over a few frames instead of
+    // one long copy.
+    constexpr uint64_t kMipUploadBytesPerFrame = 32ull << 20;
+    uint64_t recorded = 0;
+    while (recorded < kMipUploadBytesPerFrame) {
+        std::shared_ptr<TextureMipStream> stream;
+        {
+            std::lock_guard<std::mutex> lk(g_mip_stream_mutex);
+            if (g_mip_uploads.empty()) return;
+            stream = std::move(g_mip_uploads.front());
+            g_mip_uploads.pop_front();
+        }
+        {
+            std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
+            if (stream->cache_generation != g_tex_cache_generation) continue;
+        }
+        renderer::Helper::update2DTextureMips(
+            device,
+            cmd_buf,
+            staging,
+            stream->image,
+            stream->format,
+            stream->width,
+            stream->height,
+            0,
+            stream->level_bytes,
+            stream->levels.data());
+        recorded += stream->levels.size();
+        stream->levels = {};
+    }
+}
+
+void createTextureImage(
+    const std::shared_ptr<renderer::Device>& device,
+    const std::string& file_name,
+    const renderer::Format& input_format,
+    bool is_srgb_texture,
+    renderer::TextureInfo& texture,
+    const std::source_location& src_location,
+    bool cacheable) {
+
+    // Cache hit: skip the decode entirely.
+    if (cacheable && !file_name.empty() &&
+        lookupTexCache(
+            texCacheKey(file_name, is_srgb_texture, input_format), texture)) {
+        return;
+    }
+
+    DecodedTextureImage decoded;
+    decodeTextureImage(file_name, input_format, is_srgb_texture, decoded);
+    createTextureImage(device, decoded, texture, src_location, cacheable);
+}
+
+void updateTextureResidency(
+    const std::shared_ptr<renderer::Device>& device, uint64_t frame) {
+    // The driver and NVML are asked a few times a second, not every frame.
+    constexpr uint64_t kBudgetQueryFrames = 15;
+    std::vector<renderer::TextureInfo> evicted;
+    {
         std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
-        renderer::TextureInfo owning = texture;
-        owning.borrowed_ = false;                  // cache is the sole owner
-        auto [it, inserted] = g_tex_cache.try_emplace(cache_key, owning);
-        if (!inserted) {
-            // Lost a race: free our redundant GPU texture, adopt the cached one.
-            texture.borrowed_ = false;
-            texture.destroy(device);
+        g_tex_residency_frame = frame;
+        if (frame >= g_tex_budget_query_frame) {
+            g_tex_budget_query_frame = frame + kBudgetQueryFrames;
+            renderer::ResidencyBudgetInputs& in = g_tex_budget_inputs;
+            renderer::Helper::queryVramBudget(
+                device, in.vk_heap_usage, in.vk_heap_budget);
+            unsigned long long dev_free = 0, dev_total = 0;
+            if (queryDeviceWideVramBytes(dev_free, dev_total)) {
+                in.device_free = dev_free;
+                in.device_total = dev_total;
+            } else {
+                in.device_free = in.device_total = 0;
+            }
+            in.managed_bytes = g_tex_residency.residentBytes();
+            in.cap_bytes = g_tex_residency_cap;
+            g_tex_residency.setBudget(renderer::computeResidencyBudget(in));
+        }
+
+        // Borrowed copies share the entry's image: anything above the
+        // cache's own reference means a drawable (or a mip stream) holds it.
+        // No screen size is passed: held textures cannot be degraded (see
+        // the header), so only unborrowed entries are ever evicted.
+        for (const auto& [key, handle] : g_tex_residency_handles) {
+            auto it = g_tex_cache.find(key);
+            if (it != g_tex_cache.end() && it->second.image.use_count() > 1)
+                g_tex_residency.markUsed(handle, frame);
         }
-        texture = it->second;
-        texture.borrowed_ = true;                  // hand caller a borrowed view
+
+        std::vector<renderer::ResidencyAction> actions;
+        g_tex_residency.update(frame, actions);
+        for (const renderer::ResidencyAction& a : actions) {
+            // Whole-resource entries only ever see kEvict.
+            if (a.op != renderer::ResidencyOp::kEvict) continue;
+            const std::string key = g_tex_residency_keys[a.handle];
+            auto it = g_tex_cache.find(key);
+            if (it != g_tex_cache.end()) {
+                evicted.push_back(std::move(it->second));
+                g_tex_cache.erase(it);
+            }
+            g_tex_residency.remove(a.handle);
+            g_tex_residency_handles.erase(key);
+        }
+    }
+    // Unreferenced for idle_frames: no frame in flight can still sample it.
+    for (renderer::TextureInfo& texture : evicted) {
+        texture.borrowed_ = false;
+        texture.destroy(device);
     }
 }
 
+void setTextureResidencyCap(uint64_t bytes) {
+    std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
+    g_tex_residency_cap = bytes;
+    g_tex_budget_query_frame = 0;      // apply at the next update
+}
+
+renderer::ResidencyStats textureResidencyStats() {
+    std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
+    return g_tex_residency.stats();
+}
+
 void destroyTextureCache(const std::shared_ptr<renderer::Device>& device) {
+    {
+        std::lock_guard<std::mutex> lk(g_mip_stream_mutex);
+        g_mip_streams.clear();
+        g_mip_uploads.clear();
+    }
     std::lock_guard<std::mutex> lk(g_tex_cache_mutex);
+    ++g_tex_cache_generation;
     for (auto& kv : g_tex_cache) {
         kv.second.borrowed_ = false;
         kv.second.destroy(device);
     }
     g_tex_cache.clear();
+    g_tex_residency = renderer::ResidencyManager(texResidencyConfig());
+    g_tex_residency_handles.clear();
+    g_tex_residency_keys.clear();
 }
 
 std::shared_ptr<renderer::BufferInfo> createUnifiedMeshBuffer(
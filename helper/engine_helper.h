@@ -2,6 +2,7 @@
 #define __STDC_LIB_EXT1__
 #include <vector>
 #include "renderer/renderer.h"
+#include "renderer/residency_manager.h"
 
 namespace engine {
 namespace helper {
@@ -65,6 +66,128 @@ void createTextureImage(
     const std::source_location& src_location,
     bool cacheable = false);
 
+// CPU half of createTextureImage, for importers that decode many textures
+// on worker threads and create the images afterwards on the loader thread.
+// `pixels` holds the stb decode (RGBA8, or R16 for R16_UNORM requests);
+// `dds_data` the whole .dds file, header included.
+//
+// A .ktx2 (or a .dds with a converted .ktx2 beside it, helper/ktx2.h) is
+// read MIP TAIL FIRST: only the levels up to kKtx2TailDim are read, and
+// `ktx2_chain` holds the full packed chain with placeholders above them.
+// A cacheable createTextureImage uploads that and queues the real high
+// mips as a TextureMipStream; any other reads them before creating the
+// image.
+struct DecodedTextureImage {
+    std::string                           file_name;
+    renderer::Format                      requested_format =
+        renderer::Format::R8G8B8A8_UNORM;
+    bool                                  is_srgb = false;
+    renderer::Format                      format =
+        renderer::Format::R8G8B8A8_UNORM;
+    glm::uvec3                            size = glm::uvec3(1);
+    uint32_t                              mip_levels = 1;
+    bool                                  is_dds = false;
+    std::vector<char>                     dds_data;
+    std::shared_ptr<std::vector<uint8_t>> pixels;
+    bool                                  is_ktx2 = false;
+    std::string                           ktx2_path;
+    uint32_t                              first_resident_mip = 0;
+    std::vector<uint64_t>                 level_bytes;
+    std::vector<uint8_t>                  ktx2_chain;
+};
+
+// Largest level read up front from a .ktx2; bigger ones stream.
+constexpr uint32_t kKtx2TailDim = 128;
+
+// Reads and decodes `file_name` without touching the device; safe on any
+// thread.  Throws std::runtime_error naming the file when it is missing or
+// cannot be decoded, same as createTextureImage.
+void decodeTextureImage(
+    const std::string& file_name,
+    const renderer::Format& format,
+    bool is_srgb_texture,
+    DecodedTextureImage& decoded);
+
+// GPU half: creates the image + view from `decoded` and releases its pixel
+// storage.  Cache semantics match the file-name overload; a cache hit
+// ignores the decoded pixels.
+void createTextureImage(
+    const std::shared_ptr<renderer::Device>& device,
+    DecodedTextureImage& decoded,
+    renderer::TextureInfo& texture,
+    const std::source_location& src_location,
+    bool cacheable = false);
+
+// True when a cacheable createTextureImage for this key would be served
+// from the shared cache, i.e. decoding the file again is wasted work.
+bool isTextureCached(
+    const std::string& file_name,
+    bool is_srgb_texture,
+    const renderer::Format& format);
+
+// High mips [0, mip_count) of a cached .ktx2 texture that was created
+// from its mip tail.  MeshLoadTaskManager::poll() takes the queued ones
+// and runs readTextureMipStream on its worker; its phase3 queues the
+// levels with queueTextureMipUpload, and recordTextureMipUploads copies
+// them on a frame's command buffer.  The view and descriptors never
+// change — only the placeholder levels get replaced.
+struct TextureMipStream {
+    std::string                      ktx2_path;
+    std::shared_ptr<renderer::Image> image;
+    renderer::Format                 format = renderer::Format::R8G8B8A8_UNORM;
+    uint32_t                         width = 0;
+    uint32_t                         height = 0;
+    uint32_t                         mip_count = 0;
+    uint64_t                         cache_generation = 0;
+    std::vector<uint64_t>            level_bytes;     // filled by the read
+    std::vector<uint8_t>             levels;
+};
+
+// Streams queued since the last call, oldest first.
+std::vector<std::shared_ptr<TextureMipStream>> takeTextureMipStreams();
+
+// CPU half, any thread: read and decode the levels.  False with `error`
+// set when the file changed or cannot be read — the placeholders stay.
+bool readTextureMipStream(TextureMipStream& stream, std::string& error);
+
+// Hand a read stream to the next recordTextureMipUploads.  Any thread.
+void queueTextureMipUpload(std::shared_ptr<TextureMipStream> stream);
+
+// GPU half, render thread: record the queued uploads into `cmd_buf`, the
+// frame's graphics command buffer, outside a render pass.  The barriers
+// order each copy after the frames still sampling the placeholders and
+// before this frame's reads.  Stops after ~32 MB (at least one stream);
+// the rest waits for the next frame.  Streams whose texture cache was
+// destroyed since they were queued are dropped (the image is gone).
+void recordTextureMipUploads(
+    const std::shared_ptr<renderer::Device>& device,
+    const std::shared_ptr<renderer::CommandBuffer>& cmd_buf,
+    renderer::FrameUploadRing& staging);
+
+// Keeps the shared texture cache inside the VRAM budget (renderer/
+// residency_manager.h).  Menu::draw calls this once per frame on its draw
+// clock, after the scene has been recorded.  The budget comes from
+// VK_EXT_memory_budget and queryDeviceWideVramBytes (and the cap, if one
+// is set).
+//
+// Today this only reclaims ORPHANED cache entries: under pressure, entries
+// no drawable has borrowed for a few frames are freed, least recently used
+// first, and a later createTextureImage simply decodes them again.  A
+// texture a loaded drawable holds counts as in use every frame, with no
+// on-screen size, and is never dropped or degraded — the manager's
+// screen-size mip policy has nothing to act on until images can lose
+// levels in place and the draw path reports sizes.  A scene whose loaded
+// drawables alone exceed the budget stays over it.
+void updateTextureResidency(
+    const std::shared_ptr<renderer::Device>& device, uint64_t frame);
+
+// Upper bound for the cache on top of what the driver allows; 0 = none.
+// Nothing in-tree sets one; it is left to the application.
+void setTextureResidencyCap(uint64_t bytes);
+
+// Shown in the editor's VRAM overlay.
+renderer::ResidencyStats textureResidencyStats();
+
 // Frees every texture owned by the shared cross-asset texture cache. Call once
 // at shutdown while the device is still valid (paired with the
 // createTextureImage cacheable=true path).
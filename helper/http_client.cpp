@@ -0,0 +1,393 @@
+//
+// http_client.cpp — see http_client.h.  Sockets stay non-blocking for
+// their whole life: every connect, send and recv is preceded by a poll
+// bounded by the client's timeouts, which is the one portable way to
+// get timeouts out of both Winsock and BSD sockets.
+//
+#include "http_client.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+namespace helper {
+namespace {
+
+#if defined(_WIN32)
+using Socket = SOCKET;
+using PollFd = WSAPOLLFD;
+const Socket kNoSocket = INVALID_SOCKET;
+constexpr int kSendFlags = 0;
+
+void startup() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+    });
+}
+int pollOne(PollFd* p, int ms) { return WSAPoll(p, 1, ms); }
+void closeSocket(Socket s) { closesocket(s); }
+bool setNonBlocking(Socket s) {
+    u_long on = 1;
+    return ioctlsocket(s, FIONBIO, &on) == 0;
+}
+bool inProgress() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+#else
+using Socket = int;
+using PollFd = pollfd;
+const Socket kNoSocket = -1;
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;    // a reset peer is an error,
+#else                                       // not a SIGPIPE
+constexpr int kSendFlags = 0;
+#endif
+
+void startup() {}
+int pollOne(PollFd* p, int ms) {
+    for (;;) {
+        const int r = ::poll(p, 1, ms);
+        if (r < 0 && errno == EINTR) continue;
+        return r;
+    }
+}
+void closeSocket(Socket s) { ::close(s); }
+bool setNonBlocking(Socket s) {
+    const int flags = fcntl(s, F_GETFL, 0);
+    return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+bool inProgress() { return errno == EINPROGRESS; }
+bool wouldBlock() {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+#endif
+
+// fill() / readLine() outcomes.
+constexpr int kGotData = 1;
+constexpr int kClosed  = 0;     // orderly close by the peer
+constexpr int kFailed  = -1;    // reset, or any other socket error
+constexpr int kTimeout = -2;
+
+Socket sockOf(intptr_t s) { return Socket(s); }
+
+// 1 when `s` is ready for `events` (or has hung up / errored, which the
+// following call reports), 0 on timeout.
+int waitFor(Socket s, short events, int ms) {
+    PollFd p{};
+    p.fd = s;
+    p.events = events;
+    const int r = pollOne(&p, ms);
+    return r > 0 ? 1 : 0;
+}
+
+std::string lower(std::string s) {
+    for (char& c : s) c = char(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+}  // namespace
+
+HttpClient::HttpClient(std::string host, unsigned short port)
+    : host_(std::move(host)), port_(port) {}
+
+HttpClient::~HttpClient() { close(); }
+
+void HttpClient::close() {
+    if (sock_ != -1) closeSocket(sockOf(sock_));
+    sock_ = -1;
+    rx_.clear();
+    rx_pos_ = 0;
+}
+
+bool HttpClient::open() {
+    close();
+    startup();
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    addrinfo* found = nullptr;
+    const std::string port = std::to_string(port_);
+    if (getaddrinfo(host_.c_str(), port.c_str(), &hints, &found) != 0) {
+        return false;
+    }
+    // "localhost" resolves to ::1 and 127.0.0.1; a daemon listening on
+    // only one of them refuses the other at once, so trying each in
+    // turn costs nothing.
+    Socket s = kNoSocket;
+    for (addrinfo* ai = found; ai; ai = ai->ai_next) {
+        s = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s == kNoSocket) continue;
+        bool ok = setNonBlocking(s);
+        if (ok && ::connect(s, ai->ai_addr, int(ai->ai_addrlen)) != 0) {
+            ok = inProgress() && waitFor(s, POLLOUT, connect_ms_);
+            int err = 0;
+            socklen_t len = sizeof(err);
+            ok = ok && getsockopt(s, SOL_SOCKET, SO_ERROR,
+                                  reinterpret_cast<char*>(&err),
+                                  &len) == 0 &&
+                 err == 0;
+        }
+        if (ok) break;
+        closeSocket(s);
+        s = kNoSocket;
+    }
+    freeaddrinfo(found);
+    if (s == kNoSocket) return false;
+
+    // Requests are one small write each; don't let Nagle hold the
+    // body back waiting for an ACK of the head.
+    int one = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY,
+               reinterpret_cast<const char*>(&one), sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    sock_ = intptr_t(s);
+    ++connects_;
+    return true;
+}
+
+bool HttpClient::sendAll(const char* data, size_t len) {
+    const Socket s = sockOf(sock_);
+    while (len > 0) {
+        if (!waitFor(s, POLLOUT, io_ms_)) return false;
+        const int n = int(::send(s, data, int(std::min<size_t>(len, 1 << 20)),
+                                 kSendFlags));
+        if (n < 0) {
+            if (wouldBlock()) continue;
+            return false;
+        }
+        data += n;
+        len -= size_t(n);
+    }
+    return true;
+}
+
+int HttpClient::fill() {
+    if (rx_pos_ == rx_.size()) {
+        rx_.clear();
+        rx_pos_ = 0;
+    } else if (rx_pos_ > (1u << 16)) {
+        rx_.erase(0, rx_pos_);
+        rx_pos_ = 0;
+    }
+    const Socket s = sockOf(sock_);
+    char buf[16384];
+    for (;;) {
+        if (!waitFor(s, POLLIN, io_ms_)) return kTimeout;
+        const int n = int(::recv(s, buf, int(sizeof(buf)), 0));
+        if (n > 0) {
+            rx_.append(buf, size_t(n));
+            return kGotData;
+        }
+        if (n == 0) return kClosed;
+        if (wouldBlock()) continue;
+        return kFailed;
+    }
+}
+
+int HttpClient::readLine(std::string& line) {
+    for (;;) {
+        const size_t nl = rx_.find('\n', rx_pos_);
+        if (nl != std::string::npos) {
+            line.assign(rx_, rx_pos_, nl - rx_pos_);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            rx_pos_ = nl + 1;
+            return kGotData;
+        }
+        // A header or chunk-size line; anything this long is not HTTP.
+        if (rx_.size() - rx_pos_ > (1u << 16)) return kFailed;
+        const int got = fill();
+        if (got != kGotData) return got;
+    }
+}
+
+bool HttpClient::readBody(size_t len, Result& r, const ChunkFn& on_chunk) {
+    while (len > 0) {
+        if (rx_pos_ == rx_.size() && fill() != kGotData) return false;
+        const size_t n = std::min(len, rx_.size() - rx_pos_);
+        const char* p = rx_.data() + rx_pos_;
+        r.body.append(p, n);
+        rx_pos_ += n;
+        len -= n;
+        if (on_chunk && !on_chunk(p, n)) return false;
+    }
+    return true;
+}
+
+HttpClient::Result HttpClient::request(const char* method,
+                                       const std::string& path,
+                                       const std::string& body,
+                                       const ChunkFn& on_chunk) {
+    const bool is_head = std::strcmp(method, "HEAD") == 0;
+    std::string head;
+    head.reserve(256);
+    head += method;
+    head += ' ';
+    head += path;
+    head += " HTTP/1.1\r\nHost: ";
+    head += host_ + ":" + std::to_string(port_);
+    head += "\r\nUser-Agent: RealWorld/1.0\r\nAccept: */*\r\n";
+    if (!body.empty()) head += "Content-Type: application/json\r\n";
+    if (!body.empty() || (std::strcmp(method, "GET") != 0 && !is_head)) {
+        head += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    head += "\r\n";
+
+    Result r;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        // A kept-alive socket the server has since closed only shows
+        // up as a failed send or an immediate EOF.  That — and only
+        // that, nothing received — is worth one retry on a fresh
+        // connection.
+        const bool reused = sock_ != -1;
+        if (!reused && !open()) return r;
+        rx_.clear();
+        rx_pos_ = 0;
+        if (!sendAll(head.data(), head.size()) ||
+            !sendAll(body.data(), body.size())) {
+            close();
+            if (reused) continue;
+            return r;
+        }
+
+        std::string line;
+        int got = readLine(line);
+        if (got != kGotData) {
+            const bool stale = reused && got != kTimeout;
+            close();
+            if (stale) continue;
+            return r;
+        }
+
+        // Status line, skipping interim 1xx responses.
+        bool keep_alive = true;
+        unsigned int status = 0;
+        size_t content_length = 0;
+        bool has_length = false, chunked = false;
+        for (;;) {
+            if (line.rfind("HTTP/", 0) != 0 || line.size() < 12) {
+                close();
+                return r;
+            }
+            keep_alive = line.compare(0, 8, "HTTP/1.0") != 0;
+            status = unsigned(std::strtoul(line.c_str() + 9, nullptr, 10));
+            for (;;) {
+                if (readLine(line) != kGotData) {
+                    close();
+                    return r;
+                }
+                if (line.empty()) break;
+                const size_t colon = line.find(':');
+                if (colon == std::string::npos) continue;
+                const std::string name = lower(line.substr(0, colon));
+                size_t v = colon + 1;
+                while (v < line.size() && (line[v] == ' ' || line[v] == '\t'))
+                    ++v;
+                const std::string value = lower(line.substr(v));
+                if (name == "content-length") {
+                    content_length = size_t(std::strtoull(value.c_str(),
+                                                          nullptr, 10));
+                    has_length = true;
+                } else if (name == "transfer-encoding") {
+                    chunked = value.find("chunked") != std::string::npos;
+                } else if (name == "connection") {
+                    if (value.find("close") != std::string::npos) {
+                        keep_alive = false;
+                    } else if (value.find("keep-alive") != std::string::npos) {
+                        keep_alive = true;
+                    }
+                }
+            }
+            if (status >= 200 || status < 100) break;
+            if (readLine(line) != kGotData) {
+                close();
+                return r;
+            }
+            content_length = 0;
+            has_length = chunked = false;
+        }
+        r.status = status;
+
+        bool ok = true;
+        if (is_head || status == 204 || status == 304) {
+            // no body
+        } else if (chunked) {
+            for (;;) {
+                if (readLine(line) != kGotData) {
+                    ok = false;
+                    break;
+                }
+                const size_t size =
+                    size_t(std::strtoull(line.c_str(), nullptr, 16));
+                if (size == 0) {
+                    // trailers, up to the blank line
+                    while ((ok = readLine(line) == kGotData) && !line.empty()) {
+                    }
+                    break;
+                }
+                if (!readBody(size, r, on_chunk) ||
+                    readLine(line) != kGotData) {
+                    ok = false;
+                    break;
+                }
+            }
+        } else if (has_length) {
+            ok = readBody(content_length, r, on_chunk);
+        } else {
+            // No length and not chunked: the body runs to the close.
+            keep_alive = false;
+            for (;;) {
+                if (rx_pos_ < rx_.size()) {
+                    const char* p = rx_.data() + rx_pos_;
+                    const size_t n = rx_.size() - rx_pos_;
+                    r.body.append(p, n);
+                    rx_pos_ = rx_.size();
+                    if (on_chunk && !on_chunk(p, n)) {
+                        ok = false;
+                        break;
+                    }
+                }
+                const int more = fill();
+                if (more == kClosed) break;
+                if (more != kGotData) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+        r.complete = ok;
+        if (!ok || !keep_alive) close();
+        return r;
+    }
+    return r;
+}
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,92 @@
+#pragma once
+//
+// http_client.h — minimal portable HTTP/1.1 client for the local
+// daemons the engine talks to (Ollama for the material classifier and
+// the dialogue model).
+//
+// Plain sockets — Winsock on Windows, BSD sockets elsewhere — so the
+// LLM helpers are no longer WinHTTP-only.  Deliberately small: plain
+// HTTP (Ollama serves no TLS), IPv4/IPv6 via getaddrinfo, request
+// bodies sent with Content-Length, responses read as Content-Length,
+// chunked or read-to-close.  No redirects, no proxies, no cookies.
+//
+// One HttpClient is one KEEP-ALIVE connection: consecutive request()
+// calls reuse the socket until the server closes it, and a request
+// that finds the reused socket dead before any reply byte arrives is
+// retried once on a fresh connection.  Concurrency is several clients
+// on several threads — a client itself is NOT thread-safe.
+//
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace engine {
+namespace helper {
+
+class HttpClient {
+public:
+    struct Result {
+        // 0 when no response was received (unreachable, timed out,
+        // malformed status line); the HTTP status code otherwise.
+        unsigned int status = 0;
+        std::string  body;
+        // True when the whole body was read — false after a transport
+        // error or an on_chunk abort mid-body.
+        bool         complete = false;
+    };
+
+    // Called with every piece of the (de-chunked) body as it arrives,
+    // on the calling thread.  Return false to abandon the response;
+    // the connection is then closed, since its remainder is unread.
+    using ChunkFn = std::function<bool(const char* data, size_t len)>;
+
+    HttpClient(std::string host, unsigned short port);
+    ~HttpClient();
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    // connect_ms bounds the TCP connect; io_ms bounds each wait for
+    // the socket to become readable or writable (so a reply streaming
+    // slowly never times out, a silent one does).
+    void setTimeouts(int connect_ms, int io_ms) {
+        connect_ms_ = connect_ms;
+        io_ms_ = io_ms;
+    }
+
+    // One blocking round trip.  `body` is sent with a JSON content type
+    // when non-empty.  The response body is always accumulated into
+    // Result::body; on_chunk (optional) additionally sees it as it
+    // streams in.
+    Result request(const char* method, const std::string& path,
+                   const std::string& body,
+                   const ChunkFn& on_chunk = nullptr);
+
+    // Drops the connection; the next request() reconnects.
+    void close();
+
+    // TCP connections opened so far — 1 for a client whose every
+    // request rode the same keep-alive socket.
+    size_t connectCount() const { return connects_; }
+
+private:
+    bool open();
+    bool sendAll(const char* data, size_t len);
+    // Append whatever is readable to rx_ / consume one CRLF line;
+    // both return 1 on success, else why not (closed, failed, timeout).
+    int  fill();
+    int  readLine(std::string& line);
+    bool readBody(size_t len, Result& r, const ChunkFn& on_chunk);
+
+    std::string    host_;
+    unsigned short port_;
+    intptr_t       sock_ = -1;
+    int            connect_ms_ = 5000;
+    int            io_ms_ = 600000;
+    std::string    rx_;         // received, not yet consumed
+    size_t         rx_pos_ = 0;
+    size_t         connects_ = 0;
+};
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,808 @@
+// ktx2.cpp — see ktx2.h.
+#include "helper/ktx2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "helper/dds.h"
+#include "helper/zstd_block.h"
+
+namespace engine {
+namespace helper {
+
+namespace {
+
+constexpr uint8_t kIdentifier[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+// identifier + the nine header words + the index.
+constexpr uint32_t kHeaderBytes = 12 + 9 * 4 + 4 * 4 + 2 * 8;
+constexpr uint32_t kLevelIndexBytes = 3 * 8;
+constexpr uint32_t kMaxDim = 16384;
+
+// ── Data Format Descriptor (Khronos Data Format 1.3, basic block) ──────────
+
+enum : uint8_t {
+    kModelRgbsda = 1,
+    kModelBc1a = 128, kModelBc2 = 129, kModelBc3 = 130, kModelBc4 = 131,
+    kModelBc5 = 132, kModelBc7 = 134,
+};
+enum : uint8_t { kChannelR = 0, kChannelG = 1, kChannelB = 2, kChannelA = 15 };
+constexpr uint8_t kQualifierLinear = 0x10;   // alpha of an sRGB format
+
+struct DfdSample {
+    uint16_t bit_offset;
+    uint8_t  bit_length;
+    uint8_t  channel;
+    uint32_t upper;
+};
+
+uint32_t lcm4(uint32_t n) {
+    uint32_t a = n, b = 4;
+    while (b) { const uint32_t t = a % b; a = b; b = t; }
+    return n / a * 4;
+}
+
+std::vector<uint32_t> buildDfd(uint32_t fmt, bool supercompressed) {
+    const bool srgb = ktx2IsSrgb(fmt);
+    const uint8_t alpha = uint8_t(kChannelA | (srgb ? kQualifierLinear : 0));
+    uint8_t model = kModelRgbsda;
+    std::vector<DfdSample> s;
+    switch (fmt) {
+    case kKtx2R8G8B8Unorm: case kKtx2R8G8B8Srgb:
+        s = { {0, 8, kChannelR, 255}, {8, 8, kChannelG, 255},
+              {16, 8, kChannelB, 255} };
+        break;
+    case kKtx2R8G8B8A8Unorm: case kKtx2R8G8B8A8Srgb:
+        s = { {0, 8, kChannelR, 255}, {8, 8, kChannelG, 255},
+              {16, 8, kChannelB, 255}, {24, 8, alpha, 255} };
+        break;
+    case kKtx2B8G8R8A8Unorm: case kKtx2B8G8R8A8Srgb:
+        s = { {0, 8, kChannelB, 255}, {8, 8, kChannelG, 255},
+              {16, 8, kChannelR, 255}, {24, 8, alpha, 255} };
+        break;
+    case kKtx2Bc1RgbUnorm: case kKtx2Bc1RgbSrgb:
+        model = kModelBc1a;
+        s = { {0, 64, kChannelR, 0xFFFFFFFFu} };
+        break;
+    case kKtx2Bc1RgbaUnorm: case kKtx2Bc1RgbaSrgb:
+        model = kModelBc1a;
+        s = { {0, 64, alpha, 0xFFFFFFFFu} };
+        break;
+    case kKtx2Bc2Unorm: case kKtx2Bc2Srgb:
+    case kKtx2Bc3Unorm: case kKtx2Bc3Srgb:
+        model = (fmt <= kKtx2Bc2Srgb) ? kModelBc2 : kModelBc3;
+        s = { {0, 64, alpha, 0xFFFFFFFFu}, {64, 64, kChannelR, 0xFFFFFFFFu} };
+        break;
+    case kKtx2Bc4Unorm:
+        model = kModelBc4;
+        s = { {0, 64, kChannelR, 0xFFFFFFFFu} };
+        break;
+    case kKtx2Bc5Unorm:
+        model = kModelBc5;
+        s = { {0, 64, kChannelR, 0xFFFFFFFFu},
+              {64, 64, kChannelG, 0xFFFFFFFFu} };
+        break;
+    default:  // BC7
+        model = kModelBc7;
+        s = { {0, 128, kChannelR, 0xFFFFFFFFu} };
+        break;
+    }
+
+    const uint32_t block_size = 24 + 16 * (uint32_t)s.size();
+    const bool bc = ktx2IsBlockCompressed(fmt);
+    std::vector<uint32_t> w;
+    w.push_back(4 + block_size);                       // dfdTotalSize
+    w.push_back(0);                                    // vendor 0, type 0
+    w.push_back(2u | (block_size << 16));              // version 2 (KDF 1.3)
+    w.push_back(model | (1u << 8) /* BT.709 */ |
+                ((srgb ? 2u : 1u) << 16));             // transfer sRGB / linear
+    w.push_back(bc ? (3u | (3u << 8)) : 0u);           // texel block 4x4 / 1x1
+    // bytesPlane0 is 0 for supercompressed data.
+    w.push_back(supercompressed ? 0u : ktx2BlockBytes(fmt));
+    w.push_back(0);
+    for (const DfdSample& x : s) {
+        w.push_back(uint32_t(x.bit_offset) |
+                    (uint32_t(x.bit_length - 1) << 16) |
+                    (uint32_t(x.channel) << 24));
+        w.push_back(0);                                // sample position
+        w.push_back(0);                                // lower
+        w.push_back(x.upper);
+    }
+    return w;
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& b, const T& v) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+    b.insert(b.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+T get(const uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+// ── BC block averages, for placeholders ───────────────────────────────────
+
+struct Rgb { float r = 0, g = 0, b = 0; };
+
+Rgb expand565(uint16_t c) {
+    Rgb o;
+    o.r = float((c >> 11) & 31) * (255.0f / 31.0f);
+    o.g = float((c >> 5) & 63) * (255.0f / 63.0f);
+    o.b = float(c & 31) * (255.0f / 31.0f);
+    return o;
+}
+
+uint16_t pack565(const Rgb& c) {
+    auto q = [](float v, float max) {
+        return (uint16_t)std::clamp(std::lround(v * max / 255.0f), 0l,
+                                    (long)max);
+    };
+    return uint16_t((q(c.r, 31) << 11) | (q(c.g, 63) << 5) | q(c.b, 31));
+}
+
+// Mean colour of a BC1 colour block, and how many texels are transparent
+// (index 3 in three-colour mode — only meaningful for BC1 itself).
+uint16_t flatBc1(const uint8_t* blk, bool four_colour_only,
+                 int* transparent) {
+    const uint16_t c0 = get<uint16_t>(blk), c1 = get<uint16_t>(blk + 2);
+    const uint32_t idx = get<uint32_t>(blk + 4);
+    const Rgb a = expand565(c0), b = expand565(c1);
+    Rgb pal[4] = { a, b };
+    const bool four = four_colour_only || c0 > c1;
+    if (four) {
+        pal[2] = { (2 * a.r + b.r) / 3, (2 * a.g + b.g) / 3,
+                   (2 * a.b + b.b) / 3 };
+        pal[3] = { (a.r + 2 * b.r) / 3, (a.g + 2 * b.g) / 3,
+                   (a.b + 2 * b.b) / 3 };
+    } else {
+        pal[2] = { (a.r + b.r) / 2, (a.g + b.g) / 2, (a.b + b.b) / 2 };
+    }
+    Rgb sum;
+    int opaque = 0;
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t k = (idx >> (2 * i)) & 3;
+        if (!four && k == 3) continue;
+        sum.r += pal[k].r; sum.g += pal[k].g; sum.b += pal[k].b;
+        ++opaque;
+    }
+    if (transparent) *transparent = 16 - opaque;
+    if (opaque == 0) return 0;
+    sum.r /= opaque; sum.g /= opaque; sum.b /= opaque;
+    return pack565(sum);
+}
+
+// Mean value of a BC4 block (also BC3 alpha and each BC5 channel).
+uint8_t flatBc4(const uint8_t* blk) {
+    const float a0 = blk[0], a1 = blk[1];
+    float pal[8] = { a0, a1 };
+    if (blk[0] > blk[1]) {
+        for (int i = 1; i < 7; ++i)
+            pal[i + 1] = ((7 - i) * a0 + i * a1) / 7.0f;
+    } else {
+        for (int i = 1; i < 5; ++i)
+            pal[i + 1] = ((5 - i) * a0 + i * a1) / 5.0f;
+        pal[6] = 0.0f;
+        pal[7] = 255.0f;
+    }
+    uint64_t bits = 0;
+    std::memcpy(&bits, blk + 2, 6);
+    float sum = 0.0f;
+    for (int i = 0; i < 16; ++i) sum += pal[(bits >> (3 * i)) & 7];
+    return (uint8_t)std::lround(sum / 16.0f);
+}
+
+void writeFlatBc1(uint8_t* dst, uint16_t c) {
+    std::memcpy(dst, &c, 2);
+    std::memcpy(dst + 2, &c, 2);
+    std::memset(dst + 4, 0, 4);                  // every texel = colour 0
+}
+
+void writeFlatBc4(uint8_t* dst, uint8_t v) {
+    dst[0] = dst[1] = v;
+    std::memset(dst + 2, 0, 6);
+}
+
+bool flatBlock(uint32_t fmt, const uint8_t* src, uint8_t* dst) {
+    switch (fmt) {
+    case kKtx2Bc1RgbUnorm: case kKtx2Bc1RgbSrgb:
+    case kKtx2Bc1RgbaUnorm: case kKtx2Bc1RgbaSrgb: {
+        int transparent = 0;
+        const uint16_t c = flatBc1(src, false, &transparent);
+        if (transparent >= 8) {
+            // Mostly cut out: keep it cut out (three-colour mode, all 3).
+            const uint16_t lo = 0, hi = 0xFFFF;
+            std::memcpy(dst, &lo, 2);
+            std::memcpy(dst + 2, &hi, 2);
+            std::memset(dst + 4, 0xFF, 4);
+        } else {
+            writeFlatBc1(dst, c);
+        }
+        return true;
+    }
+    case kKtx2Bc2Unorm: case kKtx2Bc2Srgb: {
+        uint32_t sum = 0;
+        for (int i = 0; i < 8; ++i) sum += (src[i] & 15) + (src[i] >> 4);
+        const uint8_t a = uint8_t((sum + 8) / 16);
+        std::memset(dst, a | (a << 4), 8);
+        writeFlatBc1(dst + 8, flatBc1(src + 8, true, nullptr));
+        return true;
+    }
+    case kKtx2Bc3Unorm: case kKtx2Bc3Srgb:
+        writeFlatBc4(dst, flatBc4(src));
+        writeFlatBc1(dst + 8, flatBc1(src + 8, true, nullptr));
+        return true;
+    case kKtx2Bc4Unorm:
+        writeFlatBc4(dst, flatBc4(src));
+        return true;
+    case kKtx2Bc5Unorm:
+        writeFlatBc4(dst, flatBc4(src));
+        writeFlatBc4(dst + 8, flatBc4(src + 8));
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ── sRGB <-> linear for the mip filter ───────────────────────────────────
+
+float toLinear(uint8_t v) {
+    const float c = v / 255.0f;
+    return c <= 0.04045f ? c / 12.92f
+                         : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+uint8_t toSrgb(float l) {
+    l = std::clamp(l, 0.0f, 1.0f);
+    const float c = l <= 0.0031308f ? l * 12.92f
+                                    : 1.055f * std::pow(l, 1.0f / 2.4f) -
+                                          0.055f;
+    return (uint8_t)std::lround(c * 255.0f);
+}
+
+} // namespace
+
+// ── Formats ────────────────────────────────────────────────────────────────
+
+uint32_t ktx2BlockBytes(uint32_t fmt) {
+    switch (fmt) {
+    case kKtx2R8G8B8Unorm: case kKtx2R8G8B8Srgb:
+        return 3;
+    case kKtx2R8G8B8A8Unorm: case kKtx2R8G8B8A8Srgb:
+    case kKtx2B8G8R8A8Unorm: case kKtx2B8G8R8A8Srgb:
+        return 4;
+    case kKtx2Bc1RgbUnorm: case kKtx2Bc1RgbSrgb:
+    case kKtx2Bc1RgbaUnorm: case kKtx2Bc1RgbaSrgb:
+    case kKtx2Bc4Unorm:
+        return 8;
+    case kKtx2Bc2Unorm: case kKtx2Bc2Srgb:
+    case kKtx2Bc3Unorm: case kKtx2Bc3Srgb:
+    case kKtx2Bc5Unorm:
+    case kKtx2Bc7Unorm: case kKtx2Bc7Srgb:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+bool ktx2IsBlockCompressed(uint32_t fmt) {
+    return fmt >= kKtx2Bc1RgbUnorm && ktx2BlockBytes(fmt) != 0;
+}
+
+bool ktx2IsSrgb(uint32_t fmt) {
+    switch (fmt) {
+    case kKtx2R8G8B8Srgb: case kKtx2R8G8B8A8Srgb: case kKtx2B8G8R8A8Srgb:
+    case kKtx2Bc1RgbSrgb: case kKtx2Bc1RgbaSrgb: case kKtx2Bc2Srgb:
+    case kKtx2Bc3Srgb: case kKtx2Bc7Srgb:
+        return true;
+    default:
+        return false;
+    }
+}
+
+uint32_t ktx2WithSrgb(uint32_t fmt, bool srgb) {
+    if (fmt == kKtx2Bc4Unorm || fmt == kKtx2Bc5Unorm || ktx2IsSrgb(fmt) == srgb)
+        return fmt;
+    // VkFormat keeps each pair a fixed distance apart.
+    const uint32_t step = ktx2IsBlockCompressed(fmt) ? 1 : 6;
+    return srgb ? fmt + step : fmt - step;
+}
+
+uint64_t ktx2LevelBytes(uint32_t fmt, uint32_t width, uint32_t height,
+                        uint32_t level) {
+    const uint64_t w = std::max(1u, width >> level);
+    const uint64_t h = std::max(1u, height >> level);
+    if (ktx2IsBlockCompressed(fmt))
+        return ((w + 3) / 4) * ((h + 3) / 4) * ktx2BlockBytes(fmt);
+    return w * h * ktx2BlockBytes(fmt);
+}
+
+uint64_t ktx2LevelOffset(uint32_t fmt, uint32_t width, uint32_t height,
+                         uint32_t first, uint32_t level) {
+    uint64_t at = 0;
+    for (uint32_t l = first; l < level; ++l)
+        at += ktx2LevelBytes(fmt, width, height, l);
+    return at;
+}
+
+uint32_t ktx2FullMipCount(uint32_t width, uint32_t height) {
+    uint32_t n = 1;
+    for (uint32_t d = std::max(width, height); d > 1; d >>= 1) ++n;
+    return n;
+}
+
+// ── Writer ─────────────────────────────────────────────────────────────────
+
+bool writeKtx2(const std::string& path, const Ktx2Image& image,
+               const Ktx2WriteOptions& options, std::string* error) {
+    auto fail = [&](const std::string& why) {
+        if (error) *error = why;
+        return false;
+    };
+    const uint32_t fmt = image.vk_format;
+    const uint32_t n = (uint32_t)image.levels.size();
+    if (ktx2BlockBytes(fmt) == 0)
+        return fail("unsupported vkFormat " + std::to_string(fmt));
+    if (image.width == 0 || image.height == 0 || image.width > kMaxDim ||
+        image.height > kMaxDim)
+        return fail("bad size");
+    if (n == 0 || n > ktx2FullMipCount(image.width, image.height))
+        return fail("bad level count");
+    for (uint32_t l = 0; l < n; ++l) {
+        if (image.levels[l].size() !=
+            ktx2LevelBytes(fmt, image.width, image.height, l))
+            return fail("level " + std::to_string(l) + " has the wrong size");
+    }
+
+    const bool zstd = options.zstd && zstdAvailable();
+    std::vector<std::vector<uint8_t>> packed;
+    if (zstd) {
+        packed.resize(n);
+        for (uint32_t l = 0; l < n; ++l) {
+            if (!zstdCompress(image.levels[l].data(), image.levels[l].size(),
+                              packed[l], options.zstd_level,
+                              /*must_shrink=*/false))
+                return fail("zstd failed on level " + std::to_string(l));
+        }
+    }
+    auto stored = [&](uint32_t l) -> const std::vector<uint8_t>& {
+        return zstd ? packed[l] : image.levels[l];
+    };
+
+    const std::vector<uint32_t> dfd = buildDfd(fmt, zstd);
+    std::vector<uint8_t> kvd;
+    {
+        static const char kWriter[] = "KTXwriter\0realworld ktx2";
+        put(kvd, (uint32_t)sizeof(kWriter));
+        kvd.insert(kvd.end(), kWriter, kWriter + sizeof(kWriter));
+        while (kvd.size() % 4) kvd.push_back(0);
+    }
+    const uint32_t dfd_offset = kHeaderBytes + kLevelIndexBytes * n;
+    const uint32_t dfd_bytes = (uint32_t)dfd.size() * 4;
+    const uint32_t kvd_offset = dfd_offset + dfd_bytes;
+
+    // Smallest level first, each aligned as the spec asks (1 when
+    // supercompressed).
+    const uint64_t align = zstd ? 1 : lcm4(ktx2BlockBytes(fmt));
+    std::vector<uint64_t> offset(n);
+    uint64_t at = kvd_offset + kvd.size();
+    for (uint32_t l = n; l-- > 0;) {
+        at = (at + align - 1) / align * align;
+        offset[l] = at;
+        at += stored(l).size();
+    }
+
+    std::vector<uint8_t> h;
+    h.insert(h.end(), kIdentifier, kIdentifier + 12);
+    put(h, fmt);
+    put(h, 1u);                                      // typeSize
+    put(h, image.width);
+    put(h, image.height);
+    put(h, 0u);                                      // pixelDepth
+    put(h, 0u);                                      // layerCount
+    put(h, 1u);                                      // faceCount
+    put(h, n);
+    put(h, uint32_t(zstd ? Ktx2Supercompression::kZstd
+                         : Ktx2Supercompression::kNone));
+    put(h, dfd_offset);
+    put(h, dfd_bytes);
+    put(h, kvd_offset);
+    put(h, (uint32_t)kvd.size());
+    put(h, uint64_t(0));                             // no global data
+    put(h, uint64_t(0));
+    for (uint32_t l = 0; l < n; ++l) {
+        put(h, offset[l]);
+        put(h, (uint64_t)stored(l).size());
+        put(h, (uint64_t)image.levels[l].size());
+    }
+    for (uint32_t w : dfd) put(h, w);
+    h.insert(h.end(), kvd.begin(), kvd.end());
+
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os) return fail("cannot write " + path);
+    os.write(reinterpret_cast<const char*>(h.data()),
+             static_cast<std::streamsize>(h.size()));
+    uint64_t pos = h.size();
+    static const char kPad[16] = {};
+    for (uint32_t l = n; l-- > 0;) {
+        os.write(kPad, static_cast<std::streamsize>(offset[l] - pos));
+        os.write(reinterpret_cast<const char*>(stored(l).data()),
+                 static_cast<std::streamsize>(stored(l).size()));
+        pos = offset[l] + stored(l).size();
+    }
+    if (!os) return fail("write failed: " + path);
+    return true;
+}
+
+// ── Reader ─────────────────────────────────────────────────────────────────
+
+bool Ktx2File::fail(const std::string& why) {
+    error_ = why;
+    close();
+    return false;
+}
+
+bool Ktx2File::open(const std::string& path) {
+    close();
+    error_.clear();
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) return fail("cannot open " + path);
+
+    uint8_t h[kHeaderBytes];
+    if (std::fread(h, 1, sizeof h, file_) != sizeof h ||
+        std::memcmp(h, kIdentifier, 12) != 0)
+        return fail("not a KTX2 file");
+    vk_format_ = get<uint32_t>(h + 12);
+    width_ = get<uint32_t>(h + 20);
+    height_ = get<uint32_t>(h + 24);
+    const uint32_t depth = get<uint32_t>(h + 28);
+    const uint32_t layers = get<uint32_t>(h + 32);
+    const uint32_t faces = get<uint32_t>(h + 36);
+    const uint32_t level_count = std::max(1u, get<uint32_t>(h + 40));
+    const uint32_t scheme = get<uint32_t>(h + 44);
+
+    if (vk_format_ == 0)
+        return fail("Basis Universal payload (no transcoder in this build)");
+    if (ktx2BlockBytes(vk_format_) == 0)
+        return fail("unsupported vkFormat " + std::to_string(vk_format_));
+    if (depth != 0 || layers != 0 || faces != 1)
+        return fail("only plain 2D textures are supported");
+    if (width_ == 0 || height_ == 0 || width_ > kMaxDim || height_ > kMaxDim)
+        return fail("bad size");
+    if (level_count > ktx2FullMipCount(width_, height_))
+        return fail("bad level count");
+    if (scheme != uint32_t(Ktx2Supercompression::kNone) &&
+        scheme != uint32_t(Ktx2Supercompression::kZstd))
+        return fail("unsupported supercompression scheme " +
+                    std::to_string(scheme));
+    scheme_ = Ktx2Supercompression(scheme);
+
+    if (std::fseek(file_, 0, SEEK_END) != 0) return fail("seek failed");
+    const long end = std::ftell(file_);
+    if (end < 0 || std::fseek(file_, kHeaderBytes, SEEK_SET) != 0)
+        return fail("seek failed");
+
+    std::vector<uint8_t> idx(size_t(level_count) * kLevelIndexBytes);
+    if (std::fread(idx.data(), 1, idx.size(), file_) != idx.size())
+        return fail("truncated level index");
+    levels_.resize(level_count);
+    for (uint32_t l = 0; l < level_count; ++l) {
+        Level& v = levels_[l];
+        const uint8_t* p = idx.data() + size_t(l) * kLevelIndexBytes;
+        v.byte_offset = get<uint64_t>(p);
+        v.byte_length = get<uint64_t>(p + 8);
+        v.uncompressed_byte_length = get<uint64_t>(p + 16);
+        const bool ok =
+            v.uncompressed_byte_length ==
+                ktx2LevelBytes(vk_format_, width_, height_, l) &&
+            (scheme_ == Ktx2Supercompression::kZstd ||
+             v.byte_length == v.uncompressed_byte_length) &&
+            v.byte_offset <= uint64_t(end) &&
+            v.byte_length <= uint64_t(end) - v.byte_offset;
+        if (!ok) return fail("bad entry for level " + std::to_string(l));
+    }
+    return true;
+}
+
+void Ktx2File::close() {
+    if (file_) std::fclose(file_);
+    file_ = nullptr;
+    levels_.clear();
+    stored_.clear();
+    stored_.shrink_to_fit();
+}
+
+uint32_t Ktx2File::tailStart(uint32_t tail_dim) const {
+    for (uint32_t l = 0; l < levelCount(); ++l) {
+        if (std::max(1u, width_ >> l) <= tail_dim &&
+            std::max(1u, height_ >> l) <= tail_dim)
+            return l;
+    }
+    return levelCount() ? levelCount() - 1 : 0;
+}
+
+bool Ktx2File::readLevels(uint32_t first, uint32_t count,
+                          std::vector<uint8_t>& out, size_t dst_offset) {
+    if (!file_) return false;
+    if (first >= levelCount() || count == 0 || count > levelCount() - first) {
+        error_ = "level range out of bounds";
+        return false;
+    }
+    const uint32_t last = first + count;
+    const uint64_t total =
+        ktx2LevelOffset(vk_format_, width_, height_, first, last);
+    if (out.size() < dst_offset + total) out.resize(dst_offset + total);
+
+    // Files written here keep the range contiguous (smallest level first),
+    // so it is one read; anything else is read level by level.
+    uint64_t lo = UINT64_MAX, hi = 0, sum = 0;
+    for (uint32_t l = first; l < last; ++l) {
+        lo = std::min(lo, levels_[l].byte_offset);
+        hi = std::max(hi, levels_[l].byte_offset + levels_[l].byte_length);
+        sum += levels_[l].byte_length;
+    }
+    const bool one_read = hi - lo <= sum + 16 * uint64_t(count);
+    if (one_read) {
+        stored_.resize(size_t(hi - lo));
+        if (std::fseek(file_, (long)lo, SEEK_SET) != 0 ||
+            std::fread(stored_.data(), 1, stored_.size(), file_) !=
+                stored_.size()) {
+            error_ = "read failed";
+            return false;
+        }
+    }
+
+    for (uint32_t l = first; l < last; ++l) {
+        const Level& v = levels_[l];
+        const uint8_t* src = nullptr;
+        if (one_read) {
+            src = stored_.data() + (v.byte_offset - lo);
+        } else {
+            stored_.resize(size_t(v.byte_length));
+            if (std::fseek(file_, (long)v.byte_offset, SEEK_SET) != 0 ||
+                std::fread(stored_.data(), 1, stored_.size(), file_) !=
+                    stored_.size()) {
+                error_ = "read failed";
+                return false;
+            }
+            src = stored_.data();
+        }
+        uint8_t* dst =
+            out.data() + dst_offset +
+            ktx2LevelOffset(vk_format_, width_, height_, first, l);
+        if (scheme_ == Ktx2Supercompression::kZstd) {
+            if (!zstdDecompress(src, size_t(v.byte_length), dst,
+                                size_t(v.uncompressed_byte_length))) {
+                error_ = zstdAvailable()
+                             ? "corrupt level " + std::to_string(l)
+                             : std::string("zstd-supercompressed and this "
+                                           "build has no zstd");
+                return false;
+            }
+        } else {
+            std::memcpy(dst, src, size_t(v.byte_length));
+        }
+    }
+    return true;
+}
+
+// ── Placeholders ───────────────────────────────────────────────────────────
+
+bool fillKtx2Placeholders(uint32_t fmt, uint32_t width, uint32_t height,
+                          uint32_t first_resident, uint8_t* chain) {
+    const uint32_t bytes = ktx2BlockBytes(fmt);
+    if (bytes == 0) return false;
+    if (first_resident == 0) return true;
+    const bool bc = ktx2IsBlockCompressed(fmt);
+    if (bc && (fmt == kKtx2Bc7Unorm || fmt == kKtx2Bc7Srgb)) return false;
+
+    const uint8_t* src =
+        chain + ktx2LevelOffset(fmt, width, height, 0, first_resident);
+    const uint32_t sw = std::max(1u, width >> first_resident);
+    const uint32_t sh = std::max(1u, height >> first_resident);
+
+    if (!bc) {
+        for (uint32_t l = 0; l < first_resident; ++l) {
+            uint8_t* dst = chain + ktx2LevelOffset(fmt, width, height, 0, l);
+            const uint32_t dw = std::max(1u, width >> l);
+            const uint32_t dh = std::max(1u, height >> l);
+            const uint32_t shift = first_resident - l;
+            for (uint32_t y = 0; y < dh; ++y) {
+                const uint32_t sy = std::min(y >> shift, sh - 1);
+                for (uint32_t x = 0; x < dw; ++x) {
+                    const uint32_t sx = std::min(x >> shift, sw - 1);
+                    std::memcpy(dst + (size_t(y) * dw + x) * bytes,
+                                src + (size_t(sy) * sw + sx) * bytes, bytes);
+                }
+            }
+        }
+        return true;
+    }
+
+    // One flat block per source block, made once and then replicated.
+    const uint32_t sbw = (sw + 3) / 4, sbh = (sh + 3) / 4;
+    std::vector<uint8_t> flat(size_t(sbw) * sbh * bytes);
+    for (size_t b = 0; b < size_t(sbw) * sbh; ++b)
+        flatBlock(fmt, src + b * bytes, flat.data() + b * bytes);
+    for (uint32_t l = 0; l < first_resident; ++l) {
+        uint8_t* dst = chain + ktx2LevelOffset(fmt, width, height, 0, l);
+        const uint32_t dbw = (std::max(1u, width >> l) + 3) / 4;
+        const uint32_t dbh = (std::max(1u, height >> l) + 3) / 4;
+        const uint32_t shift = first_resident - l;
+        for (uint32_t by = 0; by < dbh; ++by) {
+            const uint32_t sy = std::min(by >> shift, sbh - 1);
+            for (uint32_t bx = 0; bx < dbw; ++bx) {
+                const uint32_t sx = std::min(bx >> shift, sbw - 1);
+                std::memcpy(dst + (size_t(by) * dbw + bx) * bytes,
+                            flat.data() + (size_t(sy) * sbw + sx) * bytes,
+                            bytes);
+            }
+        }
+    }
+    return true;
+}
+
+// ── RGBA8 mip chain ────────────────────────────────────────────────────────
+
+void buildKtx2Rgba8(uint32_t width, uint32_t height, const uint8_t* rgba,
+                    bool srgb, Ktx2Image& out) {
+    out = Ktx2Image{};
+    out.vk_format = srgb ? kKtx2R8G8B8A8Srgb : kKtx2R8G8B8A8Unorm;
+    out.width = width;
+    out.height = height;
+    const uint32_t n = ktx2FullMipCount(width, height);
+    out.levels.resize(n);
+    out.levels[0].assign(rgba, rgba + size_t(width) * height * 4);
+
+    float lut[256];
+    for (int i = 0; i < 256; ++i) lut[i] = srgb ? toLinear((uint8_t)i) : i;
+    for (uint32_t l = 1; l < n; ++l) {
+        const std::vector<uint8_t>& s = out.levels[l - 1];
+        const uint32_t sw = std::max(1u, width >> (l - 1));
+        const uint32_t sh = std::max(1u, height >> (l - 1));
+        const uint32_t dw = std::max(1u, width >> l);
+        const uint32_t dh = std::max(1u, height >> l);
+        std::vector<uint8_t>& d = out.levels[l];
+        d.resize(size_t(dw) * dh * 4);
+        for (uint32_t y = 0; y < dh; ++y) {
+            const uint32_t y0 = std::min(2 * y, sh - 1);
+            const uint32_t y1 = std::min(2 * y + 1, sh - 1);
+            for (uint32_t x = 0; x < dw; ++x) {
+                const uint32_t x0 = std::min(2 * x, sw - 1);
+                const uint32_t x1 = std::min(2 * x + 1, sw - 1);
+                const uint8_t* p[4] = {
+                    &s[(size_t(y0) * sw + x0) * 4], &s[(size_t(y0) * sw + x1) * 4],
+                    &s[(size_t(y1) * sw + x0) * 4], &s[(size_t(y1) * sw + x1) * 4] };
+                uint8_t* o = &d[(size_t(y) * dw + x) * 4];
+                for (int c = 0; c < 3; ++c) {
+                    const float v = (lut[p[0][c]] + lut[p[1][c]] +
+                                     lut[p[2][c]] + lut[p[3][c]]) * 0.25f;
+                    o[c] = srgb ? toSrgb(v) : (uint8_t)std::lround(v);
+                }
+                o[3] = uint8_t((p[0][3] + p[1][3] + p[2][3] + p[3][3] + 2) / 4);
+            }
+        }
+    }
+}
+
+// ── DDS ────────────────────────────────────────────────────────────────────
+
+bool ktx2FromDds(const void* data, size_t size, bool srgb, Ktx2Image& out,
+                 std::string* error) {
+    using namespace engine::renderer;
+    auto fail = [&](const std::string& why) {
+        if (error) *error = why;
+        return false;
+    };
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    constexpr size_t kDdsHeader = 4 + sizeof(DDS_HEADER);
+    constexpr size_t kDx10Header = kDdsHeader + sizeof(DDS_HEADER_DXT10);
+    if (size < kDdsHeader || get<uint32_t>(p) != DDS_MAGIC)
+        return fail("not a DDS file");
+    const DDS_HEADER hdr = get<DDS_HEADER>(p + 4);
+    if (hdr.size != sizeof(DDS_HEADER) ||
+        hdr.ddspf.size != sizeof(DDS_PIXELFORMAT))
+        return fail("bad DDS header");
+    if ((hdr.caps2 & DDS_CUBEMAP) != 0 ||
+        (hdr.flags & DDS_HEADER_FLAGS_VOLUME) != 0)
+        return fail("cubemap / volume DDS files are not supported");
+    size_t at = kDdsHeader;
+
+    uint32_t fmt = 0;
+    bool swap_rb = false;       // 24-bit BGR stored as RGB8
+    const uint32_t fourcc = hdr.ddspf.fourCC;
+    if (hdr.ddspf.flags & DDS_FOURCC) {
+        if (fourcc == MAKEFOURCC('D', 'X', '1', '0')) {
+            if (size < kDx10Header) return fail("truncated DX10 header");
+            const DDS_HEADER_DXT10 dx = get<DDS_HEADER_DXT10>(p + at);
+            at = kDx10Header;
+            if (dx.resourceDimension != DDS_DIMENSION_TEXTURE2D || dx.arraySize > 1)
+                return fail("only single 2D DX10 textures are supported");
+            switch ((uint32_t)dx.dxgiFormat) {
+            case 71: fmt = kKtx2Bc1RgbaUnorm; break;
+            case 72: fmt = kKtx2Bc1RgbaSrgb; break;
+            case 74: fmt = kKtx2Bc2Unorm; break;
+            case 75: fmt = kKtx2Bc2Srgb; break;
+            case 77: fmt = kKtx2Bc3Unorm; break;
+            case 78: fmt = kKtx2Bc3Srgb; break;
+            case 80: fmt = kKtx2Bc4Unorm; break;
+            case 83: fmt = kKtx2Bc5Unorm; break;
+            case 98: fmt = kKtx2Bc7Unorm; break;
+            case 99: fmt = kKtx2Bc7Srgb; break;
+            case 28: fmt = kKtx2R8G8B8A8Unorm; break;
+            case 29: fmt = kKtx2R8G8B8A8Srgb; break;
+            case 87: fmt = kKtx2B8G8R8A8Unorm; break;
+            case 91: fmt = kKtx2B8G8R8A8Srgb; break;
+            default:
+                return fail("unsupported DXGI format " +
+                            std::to_string((uint32_t)dx.dxgiFormat));
+            }
+        } else if (fourcc == MAKEFOURCC('D', 'X', 'T', '1')) {
+            fmt = srgb ? kKtx2Bc1RgbSrgb : kKtx2Bc1RgbUnorm;
+        } else if (fourcc == MAKEFOURCC('D', 'X', 'T', '2') ||
+                   fourcc == MAKEFOURCC('D', 'X', 'T', '3')) {
+            fmt = srgb ? kKtx2Bc2Srgb : kKtx2Bc2Unorm;
+        } else if (fourcc == MAKEFOURCC('D', 'X', 'T', '4') ||
+                   fourcc == MAKEFOURCC('D', 'X', 'T', '5')) {
+            fmt = srgb ? kKtx2Bc3Srgb : kKtx2Bc3Unorm;
+        } else if (fourcc == MAKEFOURCC('A', 'T', 'I', '1') ||
+                   fourcc == MAKEFOURCC('B', 'C', '4', 'U')) {
+            fmt = kKtx2Bc4Unorm;
+        } else if (fourcc == MAKEFOURCC('A', 'T', 'I', '2') ||
+                   fourcc == MAKEFOURCC('B', 'C', '5', 'U')) {
+            fmt = kKtx2Bc5Unorm;
+        } else {
+            return fail("unsupported FourCC");
+        }
+    } else if (hdr.ddspf.flags & DDS_RGB) {
+        const auto& pf = hdr.ddspf;
+        if (pf.RGBBitCount == 32 && pf.RBitMask == 0xff &&
+            pf.BBitMask == 0xff0000) {
+            fmt = srgb ? kKtx2R8G8B8A8Srgb : kKtx2R8G8B8A8Unorm;
+        } else if (pf.RGBBitCount == 32 && pf.RBitMask == 0xff0000 &&
+                   pf.BBitMask == 0xff) {
+            fmt = srgb ? kKtx2B8G8R8A8Srgb : kKtx2B8G8R8A8Unorm;
+        } else if (pf.RGBBitCount == 24 &&
+                   (pf.RBitMask == 0xff || pf.RBitMask == 0xff0000)) {
+            fmt = srgb ? kKtx2R8G8B8Srgb : kKtx2R8G8B8Unorm;
+            swap_rb = pf.RBitMask == 0xff0000;
+        } else {
+            return fail("unsupported uncompressed DDS layout");
+        }
+    } else {
+        return fail("unsupported DDS pixel format");
+    }
+
+    if (hdr.width == 0 || hdr.height == 0 || hdr.width > kMaxDim ||
+        hdr.height > kMaxDim)
+        return fail("bad size");
+    const uint32_t levels =
+        std::min(std::max(1u, hdr.mipMapCount),
+                 ktx2FullMipCount(hdr.width, hdr.height));
+
+    out = Ktx2Image{};
+    out.vk_format = fmt;
+    out.width = hdr.width;
+    out.height = hdr.height;
+    out.levels.resize(levels);
+    for (uint32_t l = 0; l < levels; ++l) {
+        const uint64_t n = ktx2LevelBytes(fmt, hdr.width, hdr.height, l);
+        if (n > size - at) return fail("truncated DDS data");
+        out.levels[l].assign(p + at, p + at + n);
+        at += size_t(n);
+        if (swap_rb) {
+            for (size_t i = 0; i + 2 < out.levels[l].size(); i += 3)
+                std::swap(out.levels[l][i], out.levels[l][i + 2]);
+        }
+    }
+    return true;
+}
+
+} // namespace helper
+} // namespace engine
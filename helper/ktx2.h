@@ -0,0 +1,176 @@
+#pragma once
+//
+// ktx2.h — KTX 2.0 textures: container, zstd supercompression, mip tail
+// first.
+//
+// The engine's texture sources were whole-file reads: a .dds went through
+// readFile() into one buffer and every mip was uploaded at once.  A .ktx2
+// written here is instead laid out for streaming:
+//
+//   header, level index, DFD, KVD        (~200 bytes)
+//   level n-1 ... level 1, level 0       smallest first, as KTX2 requires
+//
+// so the MIP TAIL (everything up to, say, 128 px) is one short read right
+// after the header and the big levels are each one further read.  With
+// supercompressionScheme = Zstandard every level is its own zstd frame
+// (helper/zstd_block.h) and decodes independently.
+//
+// Ktx2File::open() reads the header and level index only; readLevels()
+// reads and decodes a range of levels into the packed largest-first layout
+// the uploader's copy regions use (see ktx2LevelOffset()).
+// fillKtx2Placeholders() stands in for levels that are not loaded yet, so
+// an image can be created with its full chain and an unchanging view while
+// the real high mips are still on their way (engine_helper.h).
+//
+// Supported vkFormats: RGB8 / RGBA8 / BGRA8 (UNORM and SRGB), BC1, BC2,
+// BC3, BC4, BC5, BC7.  2D textures only — no arrays, cubemaps or 3D
+// (tiny_mtx2.h keeps loading the HDR cubemaps).  Basis Universal payloads
+// (vkFormat 0) are refused: there is no transcoder in the tree.
+//
+// Also here, renderer-free so tools and tests can use them: building a box
+// filtered (sRGB-aware) RGBA8 mip chain, and splitting a .dds file into
+// levels for the converter (ktx2_convert.h).
+//
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace engine {
+namespace helper {
+
+// VkFormat values the container handles (renderer::Format uses the same
+// numbering).
+enum Ktx2VkFormat : uint32_t {
+    kKtx2R8G8B8Unorm     = 23,
+    kKtx2R8G8B8Srgb      = 29,
+    kKtx2R8G8B8A8Unorm   = 37,
+    kKtx2R8G8B8A8Srgb    = 43,
+    kKtx2B8G8R8A8Unorm   = 44,
+    kKtx2B8G8R8A8Srgb    = 50,
+    kKtx2Bc1RgbUnorm     = 131,
+    kKtx2Bc1RgbSrgb      = 132,
+    kKtx2Bc1RgbaUnorm    = 133,
+    kKtx2Bc1RgbaSrgb     = 134,
+    kKtx2Bc2Unorm        = 135,
+    kKtx2Bc2Srgb         = 136,
+    kKtx2Bc3Unorm        = 137,
+    kKtx2Bc3Srgb         = 138,
+    kKtx2Bc4Unorm        = 139,
+    kKtx2Bc5Unorm        = 141,
+    kKtx2Bc7Unorm        = 145,
+    kKtx2Bc7Srgb         = 146,
+};
+
+enum class Ktx2Supercompression : uint32_t { kNone = 0, kZstd = 2 };
+
+// Bytes of one texel (uncompressed) or one 4x4 block; 0 = unsupported.
+uint32_t ktx2BlockBytes(uint32_t vk_format);
+bool     ktx2IsBlockCompressed(uint32_t vk_format);
+bool     ktx2IsSrgb(uint32_t vk_format);
+// The SRGB or UNORM twin of `vk_format` (itself when it has none: BC4/BC5).
+uint32_t ktx2WithSrgb(uint32_t vk_format, bool srgb);
+
+// Size of one level, and the offset of `level` in a packed chain that
+// starts at `first` (levels first, first + 1, ... back to back).
+uint64_t ktx2LevelBytes(uint32_t vk_format, uint32_t width, uint32_t height,
+                        uint32_t level);
+uint64_t ktx2LevelOffset(uint32_t vk_format, uint32_t width, uint32_t height,
+                         uint32_t first, uint32_t level);
+
+// Levels of a full chain down to 1x1.
+uint32_t ktx2FullMipCount(uint32_t width, uint32_t height);
+
+// A texture in memory: levels[0] is full resolution.
+struct Ktx2Image {
+    uint32_t                          vk_format = 0;
+    uint32_t                          width = 0;
+    uint32_t                          height = 0;
+    std::vector<std::vector<uint8_t>> levels;
+};
+
+struct Ktx2WriteOptions {
+    bool zstd       = true;      // when built with HAS_ZSTD
+    int  zstd_level = 19;        // offline: spend the time once
+};
+
+// Write `image` as .ktx2.  False on an unsupported format, a level of the
+// wrong size, or an I/O error.
+bool writeKtx2(const std::string& path, const Ktx2Image& image,
+               const Ktx2WriteOptions& options = {},
+               std::string* error = nullptr);
+
+class Ktx2File {
+public:
+    Ktx2File() = default;
+    ~Ktx2File() { close(); }
+    Ktx2File(const Ktx2File&) = delete;
+    Ktx2File& operator=(const Ktx2File&) = delete;
+
+    // Header and level index only.  False (with a reason in error()) for a
+    // missing file, a damaged header, or a texture this reader does not
+    // handle.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+    const std::string& error() const { return error_; }
+
+    uint32_t vkFormat() const { return vk_format_; }
+    uint32_t width() const { return width_; }
+    uint32_t height() const { return height_; }
+    uint32_t levelCount() const { return (uint32_t)levels_.size(); }
+    Ktx2Supercompression supercompression() const { return scheme_; }
+
+    // First level of the tail: the largest level no bigger than `tail_dim`
+    // on either side (the smallest level when every level is bigger).
+    uint32_t tailStart(uint32_t tail_dim) const;
+
+    // Read and decode levels [first, first + count) into `out` packed
+    // largest first; with `dst_offset` they land in `out` at that byte
+    // offset instead (`out` grows as needed).  One read for the whole
+    // range.
+    bool readLevels(uint32_t first, uint32_t count, std::vector<uint8_t>& out,
+                    size_t dst_offset = 0);
+
+private:
+    struct Level {
+        uint64_t byte_offset = 0;
+        uint64_t byte_length = 0;
+        uint64_t uncompressed_byte_length = 0;
+    };
+
+    bool fail(const std::string& why);
+
+    std::FILE*           file_ = nullptr;
+    std::string          error_;
+    uint32_t             vk_format_ = 0;
+    uint32_t             width_ = 0;
+    uint32_t             height_ = 0;
+    Ktx2Supercompression scheme_ = Ktx2Supercompression::kNone;
+    std::vector<Level>   levels_;
+    std::vector<uint8_t> stored_;     // compressed range (reused)
+};
+
+// Fill levels [0, first_resident) of a packed full chain (`chain`, level 0
+// at offset 0) from level `first_resident`: texel formats by nearest
+// upsampling, BC1-5 with one flat block per source block.  Cheap stand-ins
+// for the high mips until the real ones are uploaded.  False for formats
+// with no placeholder encoder (BC7) — load those whole.
+bool fillKtx2Placeholders(uint32_t vk_format, uint32_t width, uint32_t height,
+                          uint32_t first_resident, uint8_t* chain);
+
+// Box-filtered mip chain of an RGBA8 image down to 1x1; `srgb` filters in
+// linear light.  Replaces `out`.
+void buildKtx2Rgba8(uint32_t width, uint32_t height, const uint8_t* rgba,
+                    bool srgb, Ktx2Image& out);
+
+// Split a .dds file in memory into levels.  DXT1/DXT3/DXT5/ATI1/ATI2/BC4U/
+// BC5U FourCCs, DX10 headers with the matching DXGI formats and BC7, and
+// 32-bit RGBA / BGRA (24-bit RGB kept as RGB8).  `srgb` picks the SRGB
+// variant where the file does not say.
+bool ktx2FromDds(const void* data, size_t size, bool srgb, Ktx2Image& out,
+                 std::string* error = nullptr);
+
+} // namespace helper
+} // namespace engine
@@ -0,0 +1,99 @@
+// ktx2_convert.cpp — see ktx2_convert.h.
+#include "helper/ktx2_convert.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+#include "helper/model_inspect.h"
+
+namespace engine {
+namespace helper {
+
+namespace fs = std::filesystem;
+
+bool convertDdsToKtx2(const std::string& dds_path,
+                      const std::string& ktx2_path, bool srgb,
+                      const Ktx2WriteOptions& options, std::string* error) {
+    std::ifstream is(dds_path, std::ios::binary);
+    if (!is) {
+        if (error) *error = "cannot open " + dds_path;
+        return false;
+    }
+    const std::vector<char> bytes(std::istreambuf_iterator<char>(is), {});
+    Ktx2Image image;
+    if (!ktx2FromDds(bytes.data(), bytes.size(), srgb, image, error))
+        return false;
+    return writeKtx2(ktx2_path, image, options, error);
+}
+
+bool convertRwTexToKtx2(const std::string& rwtex_path,
+                        const std::string& ktx2_path,
+                        const Ktx2WriteOptions& options, std::string* error) {
+    int w = 0, h = 0;
+    std::vector<unsigned char> rgba;
+    if (!readRwTex(rwtex_path, w, h, rgba) || w <= 0 || h <= 0 ||
+        rgba.size() != size_t(w) * size_t(h) * 4) {
+        if (error) *error = "cannot read " + rwtex_path;
+        return false;
+    }
+    Ktx2Image image;
+    buildKtx2Rgba8((uint32_t)w, (uint32_t)h, rgba.data(), /*srgb=*/true,
+                   image);
+    return writeKtx2(ktx2_path, image, options, error);
+}
+
+Ktx2ConvertStats convertTexturesToKtx2(const std::string& dir, bool srgb,
+                                       const Ktx2WriteOptions& options) {
+    Ktx2ConvertStats stats;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(dir, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        const fs::path& src = it->path();
+        std::string ext = src.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](unsigned char c) { return (char)std::tolower(c); });
+        if (ext != ".dds" && ext != ".rwtex") continue;
+
+        fs::path dst = src;
+        dst.replace_extension(".ktx2");
+        std::error_code tec;
+        const auto src_time = fs::last_write_time(src, tec);
+        if (!tec && fs::exists(dst, tec) &&
+            fs::last_write_time(dst, tec) >= src_time && !tec) {
+            ++stats.up_to_date;
+            continue;
+        }
+
+        std::string error;
+        const bool ok =
+            ext == ".dds"
+                ? convertDdsToKtx2(src.string(), dst.string(), srgb, options,
+                                   &error)
+                : convertRwTexToKtx2(src.string(), dst.string(), options,
+                                     &error);
+        if (!ok) {
+            std::cerr << "[ktx2] " << src.string() << ": " << error
+                      << std::endl;
+            fs::remove(dst, tec);        // never leave half a file behind
+            ++stats.failed;
+            continue;
+        }
+        ++stats.converted;
+        stats.source_bytes += fs::file_size(src, tec);
+        stats.ktx2_bytes += fs::file_size(dst, tec);
+    }
+    if (ec)
+        std::cerr << "[ktx2] cannot walk " << dir << ": " << ec.message()
+                  << std::endl;
+    return stats;
+}
+
+} // namespace helper
+} // namespace engine
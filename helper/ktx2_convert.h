@@ -0,0 +1,51 @@
+#pragma once
+//
+// ktx2_convert.h — offline conversion of .dds / .rwtex textures to .ktx2.
+//
+// The loader prefers a .ktx2 next to a .dds of the same name
+// (engine_helper.cpp), so converting a content folder in place is enough
+// to switch it to mip-tail-first streaming; the .dds files can stay for
+// older builds.
+//
+//   .dds   : levels copied as they are (BC1-5, BC7, RGBA8 / BGRA8, RGB8),
+//            no re-encode.  A .dds with one level keeps one level.
+//   .rwtex : format 0 (legacy RGBA8) gets a box-filtered sRGB mip chain.
+//            Format 1 (baked) converts its small preview only — the
+//            full-resolution albedo of a baked texture lives in its VT
+//            BC7 tile cache, which stays the source for the renderer.
+//
+#include <cstdint>
+#include <string>
+
+#include "helper/ktx2.h"
+
+namespace engine {
+namespace helper {
+
+bool convertDdsToKtx2(const std::string& dds_path,
+                      const std::string& ktx2_path, bool srgb,
+                      const Ktx2WriteOptions& options = {},
+                      std::string* error = nullptr);
+
+bool convertRwTexToKtx2(const std::string& rwtex_path,
+                        const std::string& ktx2_path,
+                        const Ktx2WriteOptions& options = {},
+                        std::string* error = nullptr);
+
+struct Ktx2ConvertStats {
+    uint32_t converted = 0;
+    uint32_t up_to_date = 0;     // .ktx2 newer than its source: skipped
+    uint32_t failed = 0;
+    uint64_t source_bytes = 0;   // of the converted files
+    uint64_t ktx2_bytes = 0;
+};
+
+// Convert every .dds and .rwtex under `dir` (recursively) to a .ktx2
+// beside it.  `srgb` applies to .dds files that do not say (DXT / FourCC
+// headers); .rwtex albedo is always sRGB.  Failures are logged and
+// counted, not fatal.
+Ktx2ConvertStats convertTexturesToKtx2(const std::string& dir, bool srgb,
+                                       const Ktx2WriteOptions& options = {});
+
+} // namespace helper
+} // namespace engine
@@ -1,6 +1,7 @@
 // material_classifier.cpp — Ollama /api/chat backed classifier for
 // static collision mesh categorisation.  See material_classifier.h
-// for the overview; this file is the WinHTTP + nlohmann/json glue.
+// for the overview; this file is the HTTP + nlohmann/json glue and the
+// verdict cache.
 //
 // Talks to a LOCAL Ollama daemon (default http://localhost:11434).
 // Model + host are configurable via env vars:
@@ -27,45 +28,34 @@
 #include <cctype>      // std::isdigit
 #include <cstdlib>     // _dupenv_s (Windows-safe env var read)
 #include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <thread>
 
-// Windows.h must come BEFORE winhttp.h.  application.cpp already pulls
-// in Windows.h transitively, but this TU is built on its own so we
-// include it explicitly here.  NOMINMAX suppresses the legacy `min`
-// and `max` preprocessor macros that Windows.h would otherwise drop
-// on us — without it, any std::min(...) / std::max(...) call later
-// in this file expands to `std::((a)<(b)?(a):(b))(...)` and the
-// compiler trips on the spurious `(` after the scope-resolution `::`
-// (C2589: "illegal token on right side of '::'").
-#define NOMINMAX
-#include "Windows.h"
-#include "winhttp.h"
+#include "helper/http_client.h"
 
 #include "json.hpp"   // vendored at third_parties/tinygltf/json.hpp,
                       // include path "${TP_DIR}/tinygltf" is on the
                       // engine target.
 
-// Tell the linker to pull in winhttp.lib without touching the CMake
-// link list manually.  Either works; the pragma is the lower-friction
-// path because it lives next to the only call site.
-#pragma comment(lib, "winhttp.lib")
-
 namespace engine {
 namespace helper {
 
 namespace {
 
 // ── Live progress counters (shared between worker & main thread) ─────
-// The HTTP receive loop on the worker thread bumps g_bytes_received
-// every chunk; the main-thread progress-bar reads it with relaxed
-// memory order (the value is monotonic non-negative integer — no
-// happens-before requirements with other state).  Reset at the
-// start of every classifyAll() so subsequent runs don't carry
-// previous progress.
+// The HTTP receive loop on the worker threads bumps
+// g_classifier_bytes_received every chunk; the main-thread progress-bar
+// reads it with relaxed memory order (the value is monotonic
+// non-negative integer — no happens-before requirements with other
+// state).  Reset at the start of every classifyAll() so subsequent runs
+// don't carry previous progress.
 std::atomic<size_t> g_classifier_bytes_received{0};
-// Snapshot of the body upload size — gives the bar a sensible
-// baseline before the response starts arriving so the bar shows
+// Running total of request bodies sent — gives the bar a sensible
+// baseline before the responses start arriving so the bar shows
 // "sending" rather than "0".
 std::atomic<size_t> g_classifier_bytes_sent{0};
 
@@ -74,6 +64,7 @@ std::atomic<size_t> g_classifier_bytes_sent{0};
 // _dupenv_s is the Windows-safe alternative to getenv() — MSVC's
 // secure CRT warns about getenv().
 std::string getEnv(const char* name, const char* fallback) {
+#if defined(_WIN32)
     char*  buf  = nullptr;
     size_t len  = 0;
     const errno_t err = _dupenv_s(&buf, &len, name);
@@ -84,6 +75,20 @@ std::string getEnv(const char* name, const char* fallback) {
     std::string s(buf, len > 0 ? len - 1 : 0);
     free(buf);
     return s;
+#else
+    const char* v = std::getenv(name);
+    return v ? std::string(v) : std::string(fallback);
+#endif
+}
+
+// Integer env var clamped to [lo, hi]; `fallback` when unset or junk.
+size_t getEnvCount(const char* name, size_t fallback, int lo, int hi) {
+    const std::string raw = getEnv(name, "");
+    try {
+        const int n = std::stoi(raw);
+        if (n >= lo && n <= hi) return static_cast<size_t>(n);
+    } catch (...) { /* keep default */ }
+    return fallback;
 }
 
 // Parse "host[:port]" into (host, port).  Default port if absent: 11434
@@ -111,242 +116,106 @@ OllamaTarget parseHost(const std::string& raw) {
     return t;
 }
 
-// UTF-8 → UTF-16 helper for the WinHTTP API surface (which is wide-
-// char only).  WinHTTP API names like WinHttpOpen take LPCWSTR for
-// hostnames, paths, and the user-agent string.
-std::wstring toW(const std::string& s) {
-    if (s.empty()) return std::wstring();
-    int n = MultiByteToWideChar(
-        CP_UTF8, 0, s.data(),
-        static_cast<int>(s.size()), nullptr, 0);
-    if (n <= 0) return std::wstring();
-    std::wstring out(static_cast<size_t>(n), L'\0');
-    MultiByteToWideChar(
-        CP_UTF8, 0, s.data(),
-        static_cast<int>(s.size()), out.data(), n);
-    return out;
-}
-
-// ── WinHTTP request ──────────────────────────────────────────────────
-// Single-shot synchronous plaintext-HTTP request to <host>:<port><path>.
-// Returns (status, body) on success; (0, "") on any failure (with a
-// reason printed to stdout for debugging).  Caller checks status >=
-// 200 && < 300.
-//
-// Method is passed as a wide string ("POST" / "GET" / …) because that's
-// what WinHttpOpenRequest takes.  When body is empty (e.g. a GET),
-// the WinHttpSendRequest call passes WINHTTP_NO_REQUEST_DATA / 0
-// instead of a copy of the empty string, which keeps the wire format
-// strictly correct (no trailing CRLF with zero bytes).
+// ── HTTP request ─────────────────────────────────────────────────────
+// One round trip on `http`'s keep-alive connection, publishing bytes to
+// the live progress counters.  Status 0 means no response at all
+// (daemon unreachable); a body cut short is reported as status 0 too,
+// since a truncated NDJSON stream would parse as a partial verdict set.
 //
-// Plaintext (no WINHTTP_FLAG_SECURE) because Ollama serves bare HTTP
-// on localhost.  WinHttpOpen with NO_PROXY because a system-wide proxy
-// configured for browser traffic will typically refuse a connection
-// to localhost on a non-standard port.
-struct HttpResult { unsigned int status = 0; std::string body; };
-HttpResult httpRequest(
-    const std::string& host,
-    unsigned short port,
-    const wchar_t*     method,
+// Local LLM inference can take a while on CPU.  A 3B model at ~30 tok/s
+// on CPU can take minutes over a large batch, so the read timeout is
+// 10 minutes — it bounds each silence, not the whole reply, and the
+// reply streams.  The connect timeout stays tight because it reflects
+// socket-level reachability, not model generation time.
+HttpClient::Result httpRequest(
+    HttpClient&        http,
+    const char*        method,
     const std::string& path,
     const std::string& body) {
-
-    HttpResult r{};
-
-    // Per-phase progress marker.  Forces std::endl so the line is
-    // flushed even when stdout is piped to a file or VS Output window
-    // with line buffering.  Tagged "[mat.cls.http]" so it grep-greps
-    // cleanly out of the larger [mat.cls] / [collision] log spam.
-    auto mark = [](const char* msg) {
-        std::cout << "[mat.cls.http] " << msg << std::endl;
-    };
-
-    mark("WinHttpOpen ...");
-    HINTERNET hSession = WinHttpOpen(
-        L"RealWorld-MaterialClassifier/1.0",
-        WINHTTP_ACCESS_TYPE_NO_PROXY,
-        WINHTTP_NO_PROXY_NAME,
-        WINHTTP_NO_PROXY_BYPASS,
-        0);
-    if (!hSession) {
-        std::cout << "[mat.cls.http] WinHttpOpen FAILED err="
-                  << GetLastError() << std::endl;
-        return r;
+    http.setTimeouts(5000, 600000);
+    g_classifier_bytes_sent.fetch_add(body.size(), std::memory_order_relaxed);
+    HttpClient::Result r = http.request(
+        method, path, body, [](const char*, size_t n) {
+            // Relaxed order — the consumer only reads for display.
+            g_classifier_bytes_received.fetch_add(
+                n, std::memory_order_relaxed);
+            return true;
+        });
+    if (!r.complete) {
+        std::cout << "[mat.cls.http] " << method << " " << path
+                  << " failed (status " << r.status << ", "
+                  << r.body.size() << " bytes before the connection "
+                  << "dropped)" << std::endl;
+        r.status = 0;
     }
+    return r;
+}
 
-    // Local LLM inference can take a while on CPU.  Bistro's bistro
-    // produces ~200 materials + ~300 objects → ~15K output tokens,
-    // which a 3B model at ~30 tok/s on CPU takes 5–8 minutes to
-    // generate.  We pick 10 minutes as the receive ceiling so the
-    // first run "just works" without manual intervention; connect /
-    // send timeouts stay tight because those reflect socket-level
-    // reachability, not model generation time.
-    WinHttpSetTimeouts(hSession, 5000, 10000, 10000, 600000);
-
-    std::cout << "[mat.cls.http] WinHttpConnect " << host << ":" << port
-              << std::endl;
-    HINTERNET hConnect = WinHttpConnect(
-        hSession, toW(host).c_str(), port, 0);
-    if (!hConnect) {
-        std::cout << "[mat.cls.http] WinHttpConnect FAILED err="
-                  << GetLastError() << " (host=" << host
-                  << " port=" << port << ")" << std::endl;
-        WinHttpCloseHandle(hSession);
-        return r;
-    }
+// ── Verdict cache ────────────────────────────────────────────────────
+// Version of the prompt below — system text, payload shape, options.
+// It is part of every cache key, so BUMP IT WITH ANY CHANGE to
+// buildRequestBody(): verdicts from the old prompt then stop matching
+// and are re-asked, instead of silently outliving it.
+constexpr int kPromptVersion = 1;
+
+// One verdict per line, tab-separated, all plain text so the file can
+// be read, diffed and hand-edited:
+//   <m|o> \t <model tag> \t <prompt version> \t <name> \t <TAG>
+// The key is the line up to its last tab.  Verdicts for other models
+// and prompt versions stay in the file, so switching OLLAMA_MODEL back
+// and forth re-asks nothing.
+constexpr const char* kCacheHeader = "# RealWorld material verdicts v1";
+
+std::string verdictKey(bool is_material, const std::string& model,
+                       const std::string& name) {
+    std::string k = is_material ? "m\t" : "o\t";
+    k += model;
+    k += '\t';
+    k += std::to_string(kPromptVersion);
+    k += '\t';
+    k += name;
+    return k;
+}
 
-    // Narrow the wide method back to a printable string just for the
-    // log line — the underlying WinHTTP call still consumes the wide
-    // pointer directly.
-    {
-        std::string method_narrow;
-        for (const wchar_t* p = method; p && *p; ++p) {
-            method_narrow.push_back(static_cast<char>(*p));
-        }
-        std::cout << "[mat.cls.http] WinHttpOpenRequest "
-                  << method_narrow << " " << path << std::endl;
-    }
-    HINTERNET hRequest = WinHttpOpenRequest(
-        hConnect, method, toW(path).c_str(),
-        nullptr, WINHTTP_NO_REFERER,
-        WINHTTP_DEFAULT_ACCEPT_TYPES,
-        /*flags=*/0);  // 0 = plain HTTP; no WINHTTP_FLAG_SECURE.
-    if (!hRequest) {
-        std::cout << "[mat.cls.http] WinHttpOpenRequest FAILED err="
-                  << GetLastError() << std::endl;
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return r;
-    }
+// Names that would break the line format are never cached (and so are
+// simply re-asked every run).
+bool cacheableName(const std::string& s) {
+    return !s.empty() && s.find_first_of("\t\r\n") == std::string::npos;
+}
 
-    // Ollama just needs content-type.  No auth, no API version header.
-    std::wstring headers;
-    headers += L"content-type: application/json\r\n";
-
-    std::cout << "[mat.cls.http] WinHttpSendRequest body_bytes="
-              << body.size() << std::endl;
-    g_classifier_bytes_sent.store(
-        body.size(), std::memory_order_relaxed);
-    // For an empty body (GET pre-flight), feed WINHTTP_NO_REQUEST_DATA
-    // + 0 length so we don't smuggle a phantom byte onto the wire.
-    // We use an if/else rather than ternaries because the LPVOID vs
-    // NULL type-deduction inside a `?:` warns under MSVC's stricter
-    // levels.
-    LPCWSTR headers_ptr;
-    DWORD   headers_len;
-    LPVOID  body_ptr;
-    DWORD   body_len;
-    if (body.empty()) {
-        headers_ptr = WINHTTP_NO_ADDITIONAL_HEADERS;
-        headers_len = 0;
-        body_ptr    = WINHTTP_NO_REQUEST_DATA;
-        body_len    = 0;
-    } else {
-        headers_ptr = headers.c_str();
-        headers_len = static_cast<DWORD>(headers.size());
-        body_ptr    = const_cast<char*>(body.data());
-        body_len    = static_cast<DWORD>(body.size());
-    }
-    BOOL ok = WinHttpSendRequest(
-        hRequest,
-        headers_ptr,
-        headers_len,
-        body_ptr,
-        body_len,
-        body_len,
-        0);
-    if (!ok) {
-        std::cout << "[mat.cls.http] WinHttpSendRequest FAILED err="
-                  << GetLastError() << std::endl;
-        WinHttpCloseHandle(hRequest);
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return r;
+using VerdictMap = std::unordered_map<std::string, MeshCategory>;
+
+VerdictMap loadVerdicts(const std::string& path) {
+    VerdictMap out;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return out;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        const size_t tab = line.rfind('\t');
+        if (tab == std::string::npos) continue;
+        out[line.substr(0, tab)] = meshCategoryFromTag(line.substr(tab + 1));
     }
+    return out;
+}
 
-    mark("WinHttpReceiveResponse waiting (this is the long blocking "
-         "call -- model is generating tokens here)");
-    if (!WinHttpReceiveResponse(hRequest, nullptr)) {
-        std::cout << "[mat.cls.http] WinHttpReceiveResponse FAILED err="
-                  << GetLastError() << std::endl;
-        WinHttpCloseHandle(hRequest);
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return r;
-    }
-    mark("WinHttpReceiveResponse returned -- headers are in");
-
-    // HTTP status.
-    DWORD status_code = 0;
-    DWORD status_size = sizeof(status_code);
-    WinHttpQueryHeaders(
-        hRequest,
-        WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
-        WINHTTP_HEADER_NAME_BY_INDEX, &status_code, &status_size,
-        WINHTTP_NO_HEADER_INDEX);
-    r.status = status_code;
-    std::cout << "[mat.cls.http] status=" << status_code
-              << " -- draining body..." << std::endl;
-
-    // Drain the response body in chunks.  Log every chunk so the user
-    // sees real-time progress; this is the most reassuring thing for
-    // a 5-minute call.  WinHttpQueryDataAvailable() blocks until at
-    // least one byte is ready OR the receive timeout fires, so each
-    // iteration represents actual data arriving (not a busy-loop).
-    size_t total_bytes = 0;
-    int    chunk_idx   = 0;
-    for (;;) {
-        DWORD avail = 0;
-        if (!WinHttpQueryDataAvailable(hRequest, &avail)) {
-            std::cout << "[mat.cls.http] WinHttpQueryDataAvailable FAILED "
-                         "err=" << GetLastError() << " after "
-                      << total_bytes << " bytes" << std::endl;
-            break;
-        }
-        if (avail == 0) {
-            std::cout << "[mat.cls.http] end-of-stream (total "
-                      << total_bytes << " bytes in "
-                      << chunk_idx << " chunks)" << std::endl;
-            break;
-        }
-        std::string buf(avail, '\0');
-        DWORD read = 0;
-        if (!WinHttpReadData(hRequest, buf.data(), avail, &read)) {
-            std::cout << "[mat.cls.http] WinHttpReadData FAILED err="
-                      << GetLastError() << " after " << total_bytes
-                      << " bytes" << std::endl;
-            break;
-        }
-        if (read == 0) {
-            std::cout << "[mat.cls.http] zero-byte read (treating as EOF "
-                         "after " << total_bytes << " bytes)"
-                      << std::endl;
-            break;
+// Rewrites the whole file, through a temp file and a rename so a crash
+// mid-write leaves the previous cache rather than half of one.
+bool saveVerdicts(const std::string& path, const VerdictMap& verdicts) {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out << kCacheHeader << '\n';
+        for (const auto& [key, cat] : verdicts) {
+            out << key << '\t' << meshCategoryTag(cat) << '\n';
         }
-        r.body.append(buf.data(), read);
-        total_bytes += read;
-        ++chunk_idx;
-        // Publish to the live progress counter so the UI bar moves
-        // in real time as bytes arrive.  Relaxed order — the
-        // consumer only reads for display, no synchronisation
-        // requirements with anything else.
-        g_classifier_bytes_received.store(
-            total_bytes, std::memory_order_relaxed);
-        // Per-chunk progress is published to g_classifier_bytes_received
-        // above (drives the UI bar).  The console line below was emitting
-        // one row per network chunk -- thousands of lines per response --
-        // so it is silenced.  Re-enable for low-level transport debugging.
-        // std::cout << "[mat.cls.http] chunk #" << chunk_idx
-        //           << " size=" << read
-        //           << " total=" << total_bytes << " bytes"
-        //           << std::endl;
+        if (!out) return false;
     }
-
-    WinHttpCloseHandle(hRequest);
-    WinHttpCloseHandle(hConnect);
-    WinHttpCloseHandle(hSession);
-    mark("transport done, handles closed");
-    return r;
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
 }
 
 // ── Prompt construction ───────────────────────────────────────────────
@@ -416,8 +285,9 @@ Rules:
     //   • `model` is whatever local tag the user has pulled.
     //   • `system` lives inside the messages array as a role="system"
     //     entry, not as a top-level field.
-    //   • `stream`:false → single JSON response instead of NDJSON
-    //     chunks (which WinHTTP can't easily consume).
+    //   • `stream`:true → NDJSON frames as tokens are generated
+    //     (parseResponse() reassembles them), so bytes keep arriving
+    //     and neither the read timeout nor the progress bar stalls.
     //   • `format`:"json" → Ollama post-processes the model's reply
     //     to make sure it parses as JSON.  Useful for smaller models
     //     that occasionally drift into prose or markdown fences.
@@ -672,12 +542,12 @@ bool MaterialClassifier::classifyAll(const std::string& scene_label) {
     // be pulled locally (`ollama pull qwen3.5:2b`) for classification to
     // run; if Ollama can't resolve the manifest the model-availability
     // check below logs the installed tags and skips the LLM pass.
-    // History: an earlier multi-minute first-batch hang inside
-    // WinHttpSendRequest was caused by the request using stream:false
-    // (the WinHttp call stalled waiting for the whole response) — NOT by
-    // the model tag.  That was fixed by switching /api/chat to
-    // stream:true + NDJSON frame parsing, so the model default is free to
-    // be whatever local tag you prefer.  Override with OLLAMA_MODEL.
+    // History: an earlier multi-minute first-batch hang inside the
+    // transport was caused by the request using stream:false (the call
+    // stalled waiting for the whole response) — NOT by the model tag.
+    // That was fixed by switching /api/chat to stream:true + NDJSON
+    // frame parsing, so the model default is free to be whatever local
+    // tag you prefer.  Override with OLLAMA_MODEL.
     const std::string model = getEnv("OLLAMA_MODEL", "qwen3.5:2b");
 
     // Batch size — environment-overridable, default 10.  Smaller
@@ -687,21 +557,33 @@ bool MaterialClassifier::classifyAll(const std::string& scene_label) {
     // clamp to (1..200) to keep the request body inside a reasonable
     // num_ctx and to make sure a misconfigured "0" doesn't divide-
     // by-zero downstream.
-    size_t batch_size = 10;
-    {
-        const std::string raw = getEnv("OLLAMA_BATCH_SIZE", "10");
-        try {
-            const int n = std::stoi(raw);
-            if (n >= 1 && n <= 200) {
-                batch_size = static_cast<size_t>(n);
-            }
-        } catch (...) { /* keep default */ }
-    }
-
-    // Build a flat list of (kind, name, albedo) tuples.  Materials
-    // first then objects so within each batch the materials sit
-    // together — produces a less confusing batch-mix that the LLM
-    // handles more cleanly than "mat-obj-mat-obj-…".
+    const size_t batch_size = getEnvCount("OLLAMA_BATCH_SIZE", 10, 1, 200);
+
+    // Batches in flight at once — OLLAMA_PARALLEL, default 4, clamped
+    // to (1..16).  Each in-flight batch is one worker with its own
+    // keep-alive connection.  The daemon decodes as many requests at
+    // once as its own OLLAMA_NUM_PARALLEL allows and queues the rest;
+    // even when that is 1, a queued next batch means the model never
+    // idles while this side builds a request or parses a reply.
+    const size_t parallel = getEnvCount("OLLAMA_PARALLEL", 4, 1, 16);
+
+    // ── Verdict cache ────────────────────────────────────────────────
+    // RW_CLASSIFIER_CACHE names the file (default material_verdicts.tsv
+    // in the working directory; "off" disables it).  Every collected
+    // name with a verdict for this (model, prompt version) is answered
+    // from it; only the rest go to the LLM.  A repeat build of the
+    // same map therefore sends nothing at all — not even the pre-flight.
+    const std::string cache_path =
+        getEnv("RW_CLASSIFIER_CACHE", "material_verdicts.tsv");
+    const bool use_cache = !cache_path.empty() && cache_path != "off";
+    VerdictMap verdicts;
+    if (use_cache) verdicts = loadVerdicts(cache_path);
+
+    // Build a flat list of (kind, name, albedo) tuples for the names
+    // the cache can't answer.  Materials first then objects so within
+    // each batch the materials sit together — produces a less confusing
+    // batch-mix that the LLM handles more cleanly than "mat-obj-mat-
+    // obj-…".
     struct Item {
         bool        is_material;
         std::string name;
@@ -709,24 +591,59 @@ bool MaterialClassifier::classifyAll(const std::string& scene_label) {
     };
     std::vector<Item> items;
     items.reserve(mat_collected_.size() + obj_collected_.size());
-    for (const auto& [name, albedo] : mat_collected_) {
-        items.push_back({true,  name, albedo});
+    size_t cache_hits = 0;
+    {
+        std::lock_guard<std::mutex> lock(classified_mu_);
+        for (const auto& [name, albedo] : mat_collected_) {
+            const auto it = verdicts.find(verdictKey(true, model, name));
+            if (it != verdicts.end()) {
+                mat_classified_.emplace(name, it->second);
+                ++cache_hits;
+            } else {
+                items.push_back({true, name, albedo});
+            }
+        }
+        for (const auto& [name, _albedo] : obj_collected_) {
+            const auto it = verdicts.find(verdictKey(false, model, name));
+            if (it != verdicts.end()) {
+                obj_classified_.emplace(name, it->second);
+                ++cache_hits;
+            } else {
+                items.push_back({false, name, std::string()});
+            }
+        }
+        mat_classified_count_.store(mat_classified_.size(),
+                                    std::memory_order_release);
+        obj_classified_count_.store(obj_classified_.size(),
+                                    std::memory_order_release);
     }
-    for (const auto& [name, _albedo] : obj_collected_) {
-        items.push_back({false, name, std::string()});
+
+    if (items.empty()) {
+        std::cout << "[mat.cls] all " << cache_hits << " verdicts from "
+                  << cache_path << " (model='" << model << "', prompt v"
+                  << kPromptVersion << ") — no LLM calls" << std::endl;
+        return true;
     }
 
     const size_t total_items   = items.size();
     const size_t total_batches =
         (total_items + batch_size - 1) / batch_size;
+    const size_t workers = std::min(parallel, total_batches);
 
     std::cout << "[mat.cls] starting batched classify: " << total_items
-              << " items in " << total_batches << " batches of "
-              << batch_size << " (scene='" << scene_label
+              << " items (" << cache_hits << " more cached) in "
+              << total_batches << " batches of " << batch_size << ", "
+              << workers << " in flight (scene='" << scene_label
               << "', model='" << model << "', host="
               << target.host << ":" << target.port << ")"
               << std::endl;
 
+    std::vector<std::unique_ptr<HttpClient>> clients;
+    for (size_t w = 0; w < workers; ++w) {
+        clients.push_back(
+            std::make_unique<HttpClient>(target.host, target.port));
+    }
+
     // ── Pre-flight: GET /api/tags ────────────────────────────────────
     // Cheap (<1 ms locally) sanity check that:
     //   1. The Ollama daemon is actually listening on OLLAMA_HOST, and
@@ -734,16 +651,20 @@ bool MaterialClassifier::classifyAll(const std::string& scene_label) {
     //
     // Without this, a tag that isn't pulled locally makes /api/chat
     // accept the POST and then wedge during manifest resolution.  From
-    // the client's side that can look like a long hang inside
-    // WinHttpSendRequest with no error or diagnostic to act on.
-    // /api/tags, by contrast, returns instantly with the list of
-    // locally-pulled models, so we can fail loudly and helpfully and
-    // fall back to the procedural classifier rather than blocking.
+    // the client's side that can look like a long hang with no error
+    // or diagnostic to act on.  /api/tags, by contrast, returns
+    // instantly with the list of locally-pulled models, so we can fail
+    // loudly and helpfully and fall back to the procedural classifier
+    // rather than blocking.  It rides worker 0's connection, which the
+    // first batch then reuses.
+    //
+    // On failure, whatever the cache answered stands: the run reports
+    // success if that was anything.
     {
         std::cout << "[mat.cls] pre-flight: GET /api/tags ..." << std::endl;
         const auto t_pf_0 = std::chrono::steady_clock::now();
-        const HttpResult tags = httpRequest(
-            target.host, target.port, L"GET", "/api/tags", std::string());
+        const HttpClient::Result tags = httpRequest(
+            *clients[0], "GET", "/api/tags", std::string());
         const auto t_pf_1 = std::chrono::steady_clock::now();
         const double pf_ms = std::chrono::duration<double, std::milli>(
             t_pf_1 - t_pf_0).count();
@@ -754,7 +675,7 @@ bool MaterialClassifier::classifyAll(const std::string& scene_label) {
                       << " — is `ollama serve` running?  (Test with:"
                       << "  curl http://" << target.host << ":"
                       << target.port << "/api/tags)" << std::endl;
-            return false;
+            return cache_hits > 0;
         }
         if (tags.status != 200) {
             std::cout << "[mat.cls] PRE-FLIGHT FAILED: /api/tags HTTP "
@@ -763,7 +684,7 @@ bool MaterialClassifier::classifyAll(const std::string& scene_label) {
                 std::cout << " body: " << tags.body.substr(0, 256);
             }
             std::cout << std::endl;
-            return false;
+            return cache_hits > 0;
         }
 
         // Parse the list and see whether `model` is locally present.
@@ -815,125 +736,169 @@ bool MaterialClassifier::classifyAll(const std::string& scene_label) {
                       << std::endl
                       << "  - set OLLAMA_MODEL env var to one of the tags "
                       << "listed above and relaunch RealWorld." << std::endl;
-            return false;
+            return cache_hits > 0;
         }
     }
 
-    int batches_ok     = 0;
-    int batches_failed = 0;
+    std::atomic<size_t> next_batch{0};
+    std::atomic<int>    batches_ok{0};
+    std::atomic<int>    batches_failed{0};
+    // Verdicts this run learned, for the cache.  Guarded by
+    // classified_mu_ alongside the maps they are merged into.
+    VerdictMap learned;
     const auto t_all_0 = std::chrono::steady_clock::now();
 
-    for (size_t batch_idx = 0; batch_idx < total_batches; ++batch_idx) {
-        const size_t start = batch_idx * batch_size;
-        const size_t end =
-            std::min(total_items, start + batch_size);
-
-        // Re-split this batch back into the (materials, objects)
-        // shape buildRequestBody / parseResponse already expect, so
-        // we don't have to rewrite the prompt schema.
-        std::unordered_map<std::string, std::string> batch_mats;
-        std::unordered_map<std::string, std::string> batch_objs;
-        for (size_t k = start; k < end; ++k) {
-            if (items[k].is_material) {
-                batch_mats.emplace(items[k].name, items[k].albedo);
-            } else {
-                batch_objs.emplace(items[k].name, std::string());
+    // One worker per connection, each taking the next unsent batch
+    // until none are left.  Every item is in exactly one batch, so the
+    // order batches land in changes nothing but the progress bar.
+    auto worker = [&](HttpClient& http) {
+        for (;;) {
+            const size_t batch_idx = next_batch.fetch_add(1);
+            if (batch_idx >= total_batches) return;
+            const size_t start = batch_idx * batch_size;
+            const size_t end =
+                std::min(total_items, start + batch_size);
+
+            // Re-split this batch back into the (materials, objects)
+            // shape buildRequestBody / parseResponse already expect, so
+            // we don't have to rewrite the prompt schema.
+            std::unordered_map<std::string, std::string> batch_mats;
+            std::unordered_map<std::string, std::string> batch_objs;
+            for (size_t k = start; k < end; ++k) {
+                if (items[k].is_material) {
+                    batch_mats.emplace(items[k].name, items[k].albedo);
+                } else {
+                    batch_objs.emplace(items[k].name, std::string());
+                }
             }
-        }
 
-        const std::string body = buildRequestBody(
-            model, scene_label, batch_mats, batch_objs);
-        std::cout << "[mat.cls.batch] " << (batch_idx + 1) << "/"
-                  << total_batches << " sending (mats="
-                  << batch_mats.size() << " objs=" << batch_objs.size()
-                  << ", body=" << body.size() << "B)"
-                  << std::endl;
-
-        const auto t_batch_0 = std::chrono::steady_clock::now();
-        const HttpResult res = httpRequest(
-            target.host, target.port, L"POST", "/api/chat", body);
-        const auto t_batch_1 = std::chrono::steady_clock::now();
-        const double batch_ms = std::chrono::duration<double, std::milli>(
-            t_batch_1 - t_batch_0).count();
-
-        if (res.status < 200 || res.status >= 300) {
-            std::cout << "[mat.cls.batch] " << (batch_idx + 1) << "/"
-                      << total_batches << " FAILED HTTP "
-                      << res.status << " after " << batch_ms << "ms";
-            if (res.status == 0) {
-                std::cout
-                    << " (could not reach " << target.host << ":"
-                    << target.port << " — is `ollama serve` running "
-                    "and model '" << model
-                    << "' pulled with `ollama pull " << model << "`?)";
-            }
-            if (!res.body.empty()) {
-                std::cout << " body: " << res.body.substr(0, 256);
+            const std::string body = buildRequestBody(
+                model, scene_label, batch_mats, batch_objs);
+            // One string per line: workers log concurrently.
+            std::ostringstream tag;
+            tag << "[mat.cls.batch] " << (batch_idx + 1) << "/"
+                << total_batches;
+            std::ostringstream sending;
+            sending << tag.str() << " sending (mats=" << batch_mats.size()
+                    << " objs=" << batch_objs.size()
+                    << ", body=" << body.size() << "B)\n";
+            std::cout << sending.str() << std::flush;
+
+            const auto t_batch_0 = std::chrono::steady_clock::now();
+            const HttpClient::Result res =
+                httpRequest(http, "POST", "/api/chat", body);
+            const auto t_batch_1 = std::chrono::steady_clock::now();
+            const double batch_ms =
+                std::chrono::duration<double, std::milli>(
+                    t_batch_1 - t_batch_0).count();
+
+            std::ostringstream log;
+            log << tag.str();
+            if (res.status < 200 || res.status >= 300) {
+                log << " FAILED HTTP " << res.status << " after "
+                    << batch_ms << "ms";
+                if (res.status == 0) {
+                    log << " (could not reach " << target.host << ":"
+                        << target.port << " — is `ollama serve` running "
+                        "and model '" << model
+                        << "' pulled with `ollama pull " << model << "`?)";
+                }
+                if (!res.body.empty()) {
+                    log << " body: " << res.body.substr(0, 256);
+                }
+                std::cout << log.str() + "\n" << std::flush;
+                ++batches_failed;
+                continue;
             }
-            std::cout << std::endl;
-            ++batches_failed;
-            continue;
-        }
 
-        const ParsedReply reply = parseResponse(res.body);
-        if (reply.materials.empty() && reply.objects.empty()) {
-            std::cout << "[mat.cls.batch] " << (batch_idx + 1) << "/"
-                      << total_batches
-                      << " parsed empty after " << batch_ms << "ms"
-                      << std::endl;
-            ++batches_failed;
-            continue;
-        }
-
-        // Merge under the mutex.  After unlocking, bump the atomic
-        // counters with release semantics so the main thread's
-        // acquire load sees both the map writes AND the bumped count
-        // when it observes the new count.
-        size_t new_mat_count = 0;
-        size_t new_obj_count = 0;
-        {
-            std::lock_guard<std::mutex> lock(classified_mu_);
-            for (const auto& [name, tag] : reply.materials) {
-                mat_classified_.emplace(
-                    name, meshCategoryFromTag(tag));
+            const ParsedReply reply = parseResponse(res.body);
+            if (reply.materials.empty() && reply.objects.empty()) {
+                log << " parsed empty after " << batch_ms << "ms";
+                std::cout << log.str() + "\n" << std::flush;
+                ++batches_failed;
+                continue;
             }
-            for (const auto& [name, tag] : reply.objects) {
-                obj_classified_.emplace(
-                    name, meshCategoryFromTag(tag));
+
+            // Merge under the mutex.  After unlocking, bump the atomic
+            // counters with release semantics so the main thread's
+            // acquire load sees both the map writes AND the bumped
+            // count when it observes the new count.  Only names this
+            // batch asked about are cached — a model that renames or
+            // invents an entry gets no say over a future run.
+            size_t new_mat_count = 0;
+            size_t new_obj_count = 0;
+            {
+                std::lock_guard<std::mutex> lock(classified_mu_);
+                for (const auto& [name, tag_str] : reply.materials) {
+                    const MeshCategory cat = meshCategoryFromTag(tag_str);
+                    mat_classified_.emplace(name, cat);
+                    if (batch_mats.count(name) && cacheableName(name)) {
+                        learned[verdictKey(true, model, name)] = cat;
+                    }
+                }
+                for (const auto& [name, tag_str] : reply.objects) {
+                    const MeshCategory cat = meshCategoryFromTag(tag_str);
+                    obj_classified_.emplace(name, cat);
+                    if (batch_objs.count(name) && cacheableName(name)) {
+                        learned[verdictKey(false, model, name)] = cat;
+                    }
+                }
+                new_mat_count = mat_classified_.size();
+                new_obj_count = obj_classified_.size();
             }
-            new_mat_count = mat_classified_.size();
-            new_obj_count = obj_classified_.size();
+            mat_classified_count_.store(new_mat_count,
+                                        std::memory_order_release);
+            obj_classified_count_.store(new_obj_count,
+                                        std::memory_order_release);
+            ++batches_ok;
+
+            log << " OK in " << batch_ms
+                << "ms (this batch: mats+=" << reply.materials.size()
+                << " objs+=" << reply.objects.size()
+                << "; running total: " << new_mat_count << " mats, "
+                << new_obj_count << " objs)";
+            std::cout << log.str() + "\n" << std::flush;
         }
-        mat_classified_count_.store(new_mat_count,
-                                    std::memory_order_release);
-        obj_classified_count_.store(new_obj_count,
-                                    std::memory_order_release);
-        ++batches_ok;
-
-        std::cout << "[mat.cls.batch] " << (batch_idx + 1) << "/"
-                  << total_batches << " OK in " << batch_ms
-                  << "ms (this batch: mats+="
-                  << reply.materials.size() << " objs+="
-                  << reply.objects.size() << "; running total: "
-                  << new_mat_count << " mats, "
-                  << new_obj_count << " objs)" << std::endl;
+    };
+    {
+        std::vector<std::thread> threads;
+        for (size_t w = 1; w < workers; ++w) {
+            threads.emplace_back(worker, std::ref(*clients[w]));
+        }
+        worker(*clients[0]);
+        for (auto& t : threads) t.join();
     }
 
     const auto t_all_1 = std::chrono::steady_clock::now();
     const double total_ms = std::chrono::duration<double, std::milli>(
         t_all_1 - t_all_0).count();
+    size_t connections = 0;
+    for (const auto& c : clients) connections += c->connectCount();
     std::cout << "[mat.cls] batched classify done in " << total_ms
-              << "ms: " << batches_ok << "/" << total_batches
-              << " batches OK, " << batches_failed
-              << " batches failed, "
+              << "ms: " << batches_ok.load() << "/" << total_batches
+              << " batches OK, " << batches_failed.load()
+              << " batches failed over " << connections
+              << " connection(s), "
               << mat_classified_count_.load() << " mats + "
-              << obj_classified_count_.load() << " objs classified"
-              << std::endl;
+              << obj_classified_count_.load() << " objs classified ("
+              << cache_hits << " from cache)" << std::endl;
+
+    if (use_cache && !learned.empty()) {
+        for (auto& [key, cat] : learned) verdicts[key] = cat;
+        if (saveVerdicts(cache_path, verdicts)) {
+            std::cout << "[mat.cls] cached " << learned.size()
+                      << " new verdicts in " << cache_path << " ("
+                      << verdicts.size() << " total)" << std::endl;
+        } else {
+            std::cout << "[mat.cls] could not write verdict cache "
+                      << cache_path << std::endl;
+        }
+    }
 
-    // Treat ANY successful batch as overall success — the caller
-    // checks classifiedMaterialCount() / classifiedObjectCount() to
-    // decide whether to apply categories.
-    return batches_ok > 0;
+    // Treat ANY successful batch (or cache hit) as overall success —
+    // the caller checks classifiedMaterialCount() /
+    // classifiedObjectCount() to decide whether to apply categories.
+    return batches_ok > 0 || cache_hits > 0;
 }
 
 size_t MaterialClassifier::bytesSent() {
@@ -3,15 +3,25 @@
 // material_classifier.h — LLM-backed mesh-category classifier.
 //
 // Collects (material_name, albedo_filename, object_name) triples from
-// the loaded drawables, fires a single HTTP request to a LOCAL Ollama
-// daemon at world-build time, parses the response, and exposes a
+// the loaded drawables, asks a LOCAL Ollama daemon about them in
+// batches at world-build time, parses the responses, and exposes a
 // lookup that gameplay / collision code can use to override the
 // substring-based classifier in collision_mesh.cpp.
 //
+// Verdicts persist in an on-disk cache keyed by (name, model tag,
+// prompt version): a name the cache knows is never sent, so a repeat
+// build of the same map makes no LLM calls at all and classifyAll()
+// costs one hash lookup per name.
+//
 // Configuration (read from env vars at classifyAll() time):
-//   OLLAMA_HOST   — "localhost:11434" by default.  Hostname[:port].
-//   OLLAMA_MODEL  — "qwen3.5:2b" by default.  Any tag pulled locally
-//                   via `ollama pull <tag>`.
+//   OLLAMA_HOST         — "localhost:11434" by default.  Hostname[:port].
+//   OLLAMA_MODEL        — "qwen3.5:2b" by default.  Any tag pulled
+//                         locally via `ollama pull <tag>`.
+//   OLLAMA_BATCH_SIZE   — names per request, 10 by default.
+//   OLLAMA_PARALLEL     — requests in flight at once, 4 by default.
+//   RW_CLASSIFIER_CACHE — verdict cache file, "material_verdicts.tsv"
+//                         in the working directory by default; "off"
+//                         disables it.
 //
 // Designed to be best-effort and fail-quiet: when the daemon is
 // unreachable, the model isn't pulled, the network request errors, or
@@ -21,8 +31,9 @@
 // place.
 //
 // Threading: collect() is NOT thread-safe; call it serially during the
-// scene-walk phase.  classifyAll() runs synchronously on the calling
-// thread and typically takes 1–3 s for a few hundred materials.
+// scene-walk phase.  classifyAll() blocks the calling thread while it
+// fans the uncached batches out over OLLAMA_PARALLEL worker threads,
+// each with its own keep-alive connection (helper/http_client).
 // lookup() is safe to call concurrently with itself once classifyAll()
 // has returned.
 //
@@ -52,9 +63,9 @@ public:
         const std::string& albedo_filename,
         const std::string& object_name);
 
-    // Fire one classification request via WinHTTP to the local Ollama
-    // daemon's /api/chat endpoint, parse the JSON response into the
-    // classified_ maps.  scene_label is included in the prompt (e.g.
+    // Answer what the verdict cache can, send the rest in batches to
+    // the local Ollama daemon's /api/chat endpoint, parse the JSON
+    // responses into the classified_ maps, and cache the new verdicts.  scene_label is included in the prompt (e.g.
     // "Bistro") so the model can use it as additional context for
     // ambiguous strings.  Model and host come from OLLAMA_MODEL and
     // OLLAMA_HOST env vars (defaults qwen3.5:2b and localhost:11434).
@@ -64,17 +75,20 @@ public:
     // the object verdict win when it disagrees with the material
     // verdict.
     //
-    // Returns true on full success.  Returns false (and leaves the
-    // classified maps empty, so every lookup() returns Unknown) when:
+    // Returns true when anything was classified — from the cache or
+    // from at least one batch.  Returns false (and leaves the
+    // classified maps empty, so every lookup() returns Unknown) when
+    // nothing was cached and:
     //   - the Ollama daemon isn't reachable on OLLAMA_HOST,
     //   - the requested OLLAMA_MODEL isn't pulled locally,
-    //   - WinHTTP returned a non-2xx status,
+    //   - the daemon returned a non-2xx status,
     //   - the response was not valid JSON, or
     //   - the JSON contained no recognisable category tags.
     //
     // Blocking — typically 1–30 s depending on model size and how
-    // many names were collected; the first call after `ollama serve`
-    // starts also pays a one-shot model-load cost (~seconds).
+    // many names were not cached; the first call after `ollama serve`
+    // starts also pays a one-shot model-load cost (~seconds).  A fully
+    // cached run touches no socket.
     bool classifyAll(const std::string& scene_label);
 
     // After classifyAll() succeeds, look up the LLM-assigned category
@@ -157,10 +171,9 @@ public:
     // every classifyAll() entry so the values reflect ONLY the
     // current run.
     //
-    //   bytesSent()      — total request body bytes queued via
-    //                      WinHttpSendRequest (one-shot, jumps to
-    //                      the full body size as soon as the
-    //                      transport queues it).
+    //   bytesSent()      — total request body bytes sent so far
+    //                      (jumps by a whole body as each batch goes
+    //                      out).
     //   bytesReceived()  — running total of response bytes drained
     //                      so far.  Climbs chunk-by-chunk as the
     //                      LLM streams tokens back through Ollama.
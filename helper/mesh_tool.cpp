@@ -1,17 +1,20 @@
+#include <atomic>
 #include <stack>
 #include <map>
 #include <tuple>
-#include <unordered_map>
-#include <unordered_set>
 #include <queue>
 #include <cmath>
+#include <exception>
 #include <iostream>
+#include <numeric>
+#include <sstream>
 #include <OpenMesh/Core/Mesh/TriMesh_ArrayKernelT.hh>
 #include <OpenMesh/Core/IO/MeshIO.hh>
 #include <OpenMesh/Tools/Decimater/DecimaterT.hh>
 #include <OpenMesh/Tools/Decimater/ModQuadricT.hh>
 #include <OpenMesh/Tools/Decimater/ModNormalFlippingT.hh>
 #include "mesh_tool.h"
+#include "thread_pool.h"
 
 namespace engine {
 namespace helper {
@@ -181,6 +184,19 @@ void generateHLODWithSeamProtection(
 // =============================================================================
 // Local Quadric Error Metrics (QEM) decimation — no external library needed.
 // Processes all material parts as one object so seams are never broken.
+//
+// Flat arrays throughout, no half-edge structure and no hashing:
+//   - edges are found by bucketing every face edge under its lower vertex
+//     (CSR) and sorting each small bucket, which yields boundary / seam /
+//     sharp classification, the unique edge list and the hole diagnostic;
+//   - a vertex's faces are the input incidence lists (CSR) of every vertex
+//     merged into it, chained head-to-tail on each collapse, so nothing is
+//     copied or rewritten but the faces' own vertex slots;
+//   - a heap entry is stale once either endpoint's version moved on;
+//   - neighbour sets for the link condition are marked in stamp arrays.
+//
+// Large meshes with a pool decimate in two partitioned passes (see
+// decimatePartitioned below).
 // =============================================================================
 
 namespace {
@@ -225,10 +241,11 @@ struct Quadric {
 struct QEMVert {
     glm::dvec3 pos;
     Quadric    Q;
+    uint32_t   version = 0;
     bool       locked  = false;
     bool       deleted = false;
-    std::vector<int> adj_faces;
-    std::vector<int> adj_verts;
+    int        chain_next = -1;   // next vertex merged into the same one
+    int        chain_tail = -1;   // last of this vertex's chain (self if alone)
 };
 
 struct QEMFace {
@@ -240,15 +257,11 @@ struct QEMFace {
 struct CollapseEntry {
     float      cost;
     int        v0, v1;   // canonical: v0 < v1
-    int        version;
+    uint32_t   ver0, ver1;
     glm::dvec3 new_pos;
     bool operator>(const CollapseEntry& o) const { return cost > o.cost; }
 };
 
-static inline uint64_t edgeKey(int a, int b) {
-    return ((uint64_t)(unsigned)std::min(a,b) << 32) | (uint32_t)std::max(a,b);
-}
-
 static void facePlane(const glm::dvec3& p0, const glm::dvec3& p1,
                       const glm::dvec3& p2,
                       double& a, double& b, double& c, double& d) {
@@ -260,33 +273,42 @@ static void facePlane(const glm::dvec3& p0, const glm::dvec3& p1,
     d = -glm::dot(n, p0);
 }
 
+// Cost of giving the survivor's normal / uv to the vertex it absorbs,
+// scaled by the squared edge length so it is an area like the quadric.
+static double attributeCost(const VertexStruct& a, const VertexStruct& b,
+                            double edge_sq) {
+    const float la = glm::length(a.normal), lb = glm::length(b.normal);
+    const double cos_n = (la > 1e-12f && lb > 1e-12f)
+        ? glm::dot(a.normal, b.normal) / (la * lb) : 1.0;
+    const glm::vec2 duv(a.uv.x - b.uv.x, a.uv.y - b.uv.y);
+    return edge_sq * (c_normal_weight * (1.0 - cos_n) +
+                      c_uv_weight * (duv.x * duv.x + duv.y * duv.y));
+}
+
 static CollapseEntry computeCollapse(
     const std::vector<QEMVert>& verts, int v0, int v1,
-    const std::unordered_map<uint64_t,int>& edge_ver)
+    const std::vector<VertexStruct>* attributes)
 {
     CollapseEntry e;
     e.v0 = v0; e.v1 = v1;
-    auto it = edge_ver.find(edgeKey(v0,v1));
-    e.version = (it != edge_ver.end()) ? it->second : 0;
+    e.ver0 = verts[v0].version; e.ver1 = verts[v1].version;
+    const glm::dvec3 p0 = verts[v0].pos, p1 = verts[v1].pos;
+    const double attr = attributes
+        ? attributeCost((*attributes)[v0], (*attributes)[v1],
+                        glm::dot(p1 - p0, p1 - p0))
+        : 0.0;
 
     // If either endpoint is locked, use its position directly — no need to solve.
-    if (verts[v0].locked) {
-        e.new_pos = verts[v0].pos;
-        Quadric Q = verts[v0].Q; Q += verts[v1].Q;
-        e.cost = (float)std::max(0.0, Q.eval(e.new_pos.x, e.new_pos.y, e.new_pos.z));
-        return e;
-    }
-    if (verts[v1].locked) {
-        e.new_pos = verts[v1].pos;
+    if (verts[v0].locked || verts[v1].locked) {
+        e.new_pos = verts[v0].locked ? p0 : p1;
         Quadric Q = verts[v0].Q; Q += verts[v1].Q;
-        e.cost = (float)std::max(0.0, Q.eval(e.new_pos.x, e.new_pos.y, e.new_pos.z));
+        e.cost = (float)(std::max(0.0, Q.eval(e.new_pos.x, e.new_pos.y, e.new_pos.z)) + attr);
         return e;
     }
 
     Quadric Q = verts[v0].Q;
     Q += verts[v1].Q;
 
-    glm::dvec3 p0 = verts[v0].pos, p1 = verts[v1].pos;
     glm::dvec3 mid = (p0 + p1) * 0.5;
 
     double ox, oy, oz;
@@ -319,40 +341,96 @@ static CollapseEntry computeCollapse(
         else                           e.new_pos = mid;
     }
     double cost = Q.eval(e.new_pos.x, e.new_pos.y, e.new_pos.z);
-    e.cost = (float)std::max(0.0, cost);
+    e.cost = (float)(std::max(0.0, cost) + attr);
     return e;
 }
 
-} // anonymous namespace
+// Every face edge bucketed under its lower vertex and sorted by (upper
+// vertex, face): the runs are the unique edges with their faces.
+struct EdgeTable {
+    std::vector<uint32_t> first;                     // per vertex, CSR
+    std::vector<std::pair<int, int>> entries;        // (upper vertex, face)
+
+    void build(const std::vector<QEMFace>& faces, int nv) {
+        first.assign((size_t)nv + 1, 0);
+        for (const auto& f : faces) {
+            if (f.deleted) continue;
+            for (int k = 0; k < 3; ++k)
+                ++first[std::min(f.v[k], f.v[(k+1)%3]) + 1];
+        }
+        for (int v = 0; v < nv; ++v) first[v + 1] += first[v];
+        entries.resize(first[nv]);
+        std::vector<uint32_t> at(first.begin(), first.end() - 1);
+        for (int fi = 0; fi < (int)faces.size(); ++fi) {
+            if (faces[fi].deleted) continue;
+            for (int k = 0; k < 3; ++k) {
+                const int a = faces[fi].v[k], b = faces[fi].v[(k+1)%3];
+                entries[at[std::min(a,b)]++] = { std::max(a,b), fi };
+            }
+        }
+        for (int v = 0; v < nv; ++v)
+            std::sort(entries.begin() + first[v], entries.begin() + first[v + 1]);
+    }
+    // fn(lower, upper, first entry, entry count) per unique edge.
+    template <typename Fn>
+    void forEachEdge(Fn fn) const {
+        const int nv = (int)first.size() - 1;
+        for (int a = 0; a < nv; ++a) {
+            for (uint32_t s = first[a], e; s < first[a + 1]; s = e) {
+                for (e = s + 1; e < first[a + 1] &&
+                     entries[e].first == entries[s].first; ++e) {}
+                fn(a, entries[s].first, s, e - s);
+            }
+        }
+    }
+};
 
-// -----------------------------------------------------------------------------
+size_t countBoundaryEdges(const EdgeTable& t) {
+    size_t n = 0;
+    t.forEachEdge([&](int, int, uint32_t, uint32_t count) { n += count == 1; });
+    return n;
+}
 
-void decimateMesh(
+// Core serial decimation.  `force_locked` (optional, per input vertex)
+// adds locks on top of the detected ones; `out_source` receives the input
+// vertex each output vertex was copied from.  Returns the result's
+// geometric error (see DecimateOptions::out_max_error).
+double decimateSerial(
     const Mesh& input_mesh,
     const std::vector<int32_t>& face_part_ids,
     Mesh& output_mesh,
     std::vector<int32_t>& output_face_part_ids,
     size_t target_face_count,
     std::ostream& log,
-    bool seal_locked_edges)
+    const DecimateOptions& options,
+    const std::vector<uint8_t>* force_locked,
+    std::vector<uint32_t>* out_source)
 {
     const auto& in_verts = *input_mesh.vertex_data_ptr;
     const auto& in_faces = *input_mesh.faces_ptr;
     const int nv = (int)in_verts.size();
     const int nf = (int)in_faces.size();
+    const bool seal = options.seal_locked_edges;
 
     if (nf == 0 || target_face_count >= (size_t)nf) {
-        output_mesh = input_mesh;
+        if (&output_mesh != &input_mesh) output_mesh = input_mesh;
         output_face_part_ids = face_part_ids;
-        return;
+        if (out_source) {
+            out_source->resize(nv);
+            std::iota(out_source->begin(), out_source->end(), 0u);
+        }
+        return 0.0;
     }
 
     // ── Build working arrays ──────────────────────────────────────────────────
     std::vector<QEMVert> verts(nv);
     std::vector<QEMFace> faces(nf);
 
-    for (int i = 0; i < nv; ++i)
+    for (int i = 0; i < nv; ++i) {
         verts[i].pos = glm::dvec3(in_verts[i].position);
+        verts[i].chain_tail = i;
+        if (force_locked && (*force_locked)[i]) verts[i].locked = true;
+    }
 
     for (int i = 0; i < nf; ++i) {
         faces[i].v[0]    = (int)in_faces[i].v_indices[0];
@@ -361,19 +439,27 @@ void decimateMesh(
         faces[i].part_id = face_part_ids[i];
     }
 
-    // ── Vertex → face adjacency ───────────────────────────────────────────────
-    for (int fi = 0; fi < nf; ++fi)
-        for (int k = 0; k < 3; ++k)
-            verts[faces[fi].v[k]].adj_faces.push_back(fi);
+    // ── Vertex → face incidence (CSR) ─────────────────────────────────────────
+    std::vector<uint32_t> inc_first((size_t)nv + 1, 0);
+    std::vector<int> incident((size_t)nf * 3);
+    for (const auto& f : faces)
+        for (int k = 0; k < 3; ++k) ++inc_first[f.v[k] + 1];
+    for (int v = 0; v < nv; ++v) inc_first[v + 1] += inc_first[v];
+    {
+        std::vector<uint32_t> at(inc_first.begin(), inc_first.end() - 1);
+        for (int fi = 0; fi < nf; ++fi)
+            for (int k = 0; k < 3; ++k) incident[at[faces[fi].v[k]]++] = fi;
+    }
+    // Live faces around v: the incidence of every vertex merged into it.
+    auto forFaces = [&](int v, auto&& fn) {
+        for (int u = v; u != -1; u = verts[u].chain_next)
+            for (uint32_t k = inc_first[u]; k < inc_first[u + 1]; ++k)
+                if (!faces[incident[k]].deleted) fn(incident[k]);
+    };
 
-    // ── Edge → face map (for boundary / seam detection) ───────────────────────
-    std::unordered_map<uint64_t, std::vector<int>> edge_face_map;
-    edge_face_map.reserve((size_t)nf * 3);
-    for (int fi = 0; fi < nf; ++fi)
-        for (int k = 0; k < 3; ++k) {
-            int a = faces[fi].v[k], b = faces[fi].v[(k+1)%3];
-            edge_face_map[edgeKey(a,b)].push_back(fi);
-        }
+    // ── Edge table (for boundary / seam detection and the initial heap) ───────
+    EdgeTable in_edges;
+    in_edges.build(faces, nv);
 
     // ── Lock boundary, inter-part seam, and SHARP FEATURE edges ───────────────
     // Boundary edge  : appears in only 1 face            → lock both endpoints
@@ -394,18 +480,19 @@ void decimateMesh(
     // whether one face was wound backwards.  cos(45 deg) ~= 0.707, so any
     // crease sharper than ~45deg is preserved.
     constexpr double kCosSharpEdge = 0.707; // 45 deg between face normals
-    for (auto& [key, flist] : edge_face_map) {
-        bool lock = (flist.size() == 1); // open boundary
-        if (!lock && flist.size() >= 2) {
-            int32_t p0 = faces[flist[0]].part_id;
-            for (size_t i = 1; i < flist.size(); ++i)
-                if (faces[flist[i]].part_id != p0) { lock = true; break; }
+    in_edges.forEachEdge([&](int va, int vb, uint32_t s, uint32_t count) {
+        const auto* flist = &in_edges.entries[s];
+        bool lock = (count == 1); // open boundary
+        if (!lock && count >= 2) {
+            int32_t p0 = faces[flist[0].second].part_id;
+            for (uint32_t i = 1; i < count; ++i)
+                if (faces[flist[i].second].part_id != p0) { lock = true; break; }
         }
         // Sharp feature edge (exactly two faces, same part): lock if the
         // faces meet at a steep dihedral so the outline keeps its shape.
-        if (!lock && flist.size() == 2) {
-            const auto& fa = faces[flist[0]];
-            const auto& fb = faces[flist[1]];
+        if (!lock && count == 2) {
+            const auto& fa = faces[flist[0].second];
+            const auto& fb = faces[flist[1].second];
             const glm::dvec3 na = glm::cross(
                 verts[fa.v[1]].pos - verts[fa.v[0]].pos,
                 verts[fa.v[2]].pos - verts[fa.v[0]].pos);
@@ -418,12 +505,8 @@ void decimateMesh(
                 if (std::abs(cosang) < kCosSharpEdge) lock = true;
             }
         }
-        if (lock) {
-            int va = (int)(key >> 32);
-            int vb = (int)(uint32_t)key;
-            verts[va].locked = verts[vb].locked = true;
-        }
-    }
+        if (lock) verts[va].locked = verts[vb].locked = true;
+    });
 
     // ── Lock UV-seam vertices ─────────────────────────────────────────────────
     // A UV seam has multiple input vertices at the same 3-D position (one per
@@ -431,18 +514,19 @@ void decimateMesh(
     // crack appears.  Locking every vertex whose position is shared by another
     // vertex prevents the split — the seam stays geometrically intact.
     {
-        std::map<std::tuple<float,float,float>, int> pos_first;
-        for (int i = 0; i < nv; ++i) {
-            auto key = std::make_tuple(
-                in_verts[i].position.x,
-                in_verts[i].position.y,
-                in_verts[i].position.z);
-            auto [it, ins] = pos_first.emplace(key, i);
-            if (!ins) {
-                // Duplicate position — lock both this vertex and the first seen
-                verts[i].locked        = true;
-                verts[it->second].locked = true;
-            }
+        std::vector<int> by_pos(nv);
+        std::iota(by_pos.begin(), by_pos.end(), 0);
+        auto key = [&](int i) {
+            const glm::vec3& p = in_verts[i].position;
+            return std::make_tuple(p.x, p.y, p.z);
+        };
+        std::sort(by_pos.begin(), by_pos.end(),
+                  [&](int a, int b) { return key(a) < key(b); });
+        for (int i = 1; i < nv; ++i) {
+            if (key(by_pos[i - 1]) < key(by_pos[i])) continue;
+            // Duplicate position — lock both this vertex and the previous one
+            verts[by_pos[i]].locked     = true;
+            verts[by_pos[i - 1]].locked = true;
         }
     }
 
@@ -455,54 +539,52 @@ void decimateMesh(
             verts[f.v[k]].Q.addPlane(a,b,c,d);
     }
 
-    // ── Build edge neighbor lists + initial priority queue ────────────────────
-    std::unordered_map<uint64_t,int> edge_ver;
-    edge_ver.reserve((size_t)nf * 3);
+    // seal_locked_edges: skip ANY edge touching a locked vertex
+    // (boundary / seam / sharp) so the outline can never erode;
+    // otherwise only skip when BOTH ends are locked.
+    auto frozen = [&](int a, int b) {
+        return seal ? (verts[a].locked || verts[b].locked)
+                    : (verts[a].locked && verts[b].locked);
+    };
+    const std::vector<VertexStruct>* attributes =
+        options.attribute_aware ? &in_verts : nullptr;
+
+    // ── Initial priority queue ────────────────────────────────────────────────
+    std::vector<CollapseEntry> heap_init;
+    heap_init.reserve((size_t)nf * 3 / 2);
+    in_edges.forEachEdge([&](int a, int b, uint32_t, uint32_t) {
+        if (a == b || frozen(a, b)) return;
+        heap_init.push_back(computeCollapse(verts, a, b, attributes));
+    });
     std::priority_queue<CollapseEntry,
                         std::vector<CollapseEntry>,
-                        std::greater<CollapseEntry>> pq;
+                        std::greater<CollapseEntry>> pq(
+        std::greater<CollapseEntry>(), std::move(heap_init));
 
-    std::unordered_set<uint64_t> seen;
-    seen.reserve((size_t)nf * 3);
-    for (int fi = 0; fi < nf; ++fi)
-        for (int k = 0; k < 3; ++k) {
-            int a = faces[fi].v[k], b = faces[fi].v[(k+1)%3];
-            uint64_t key = edgeKey(a,b);
-            if (!seen.insert(key).second) continue;
-            verts[a].adj_verts.push_back(b);
-            verts[b].adj_verts.push_back(a);
-            // seal_locked_edges: skip ANY edge touching a locked vertex
-            // (boundary / seam / sharp) so the outline can never erode;
-            // otherwise only skip when BOTH ends are locked.
-            if (seal_locked_edges ? (verts[a].locked || verts[b].locked)
-                                  : (verts[a].locked && verts[b].locked))
-                continue;
-            edge_ver[key] = 0;
-            pq.push(computeCollapse(verts, std::min(a,b), std::max(a,b), edge_ver));
-        }
+    // Stamp-marked vertex sets (link condition, neighbour walks).
+    std::vector<uint32_t> mark_a(nv, 0), mark_b(nv, 0);
+    uint32_t stamp = 0;
 
     // ── Main collapse loop ────────────────────────────────────────────────────
     int alive         = nf;
     int collapses_done = 0;
+    double max_cost    = 0.0;
 
     while (alive > (int)target_face_count && !pq.empty()) {
         auto entry = pq.top(); pq.pop();
         int v0 = entry.v0, v1 = entry.v1;
 
         // Stale check
-        {
-            auto it = edge_ver.find(edgeKey(v0,v1));
-            if (it == edge_ver.end() || it->second != entry.version) continue;
-        }
         if (verts[v0].deleted || verts[v1].deleted)   continue;
-        if (seal_locked_edges ? (verts[v0].locked || verts[v1].locked)
-                              : (verts[v0].locked && verts[v1].locked))
-            continue;
+        if (verts[v0].version != entry.ver0 ||
+            verts[v1].version != entry.ver1)          continue;
+        if (frozen(v0, v1))                           continue;
 
-        // Snap to locked endpoint if needed
+        // A locked endpoint survives as itself: it keeps its position AND
+        // its attributes, so what sits on a seam is bit-exact afterwards.
         glm::dvec3 new_pos = entry.new_pos;
-        if      (verts[v0].locked) new_pos = verts[v0].pos;
-        else if (verts[v1].locked) new_pos = verts[v1].pos;
+        if (verts[v1].locked && !verts[v0].locked) std::swap(v0, v1);
+        if (verts[v0].locked) new_pos = verts[v0].pos;
 
         // ── Geometry-quality safety check ────────────────────────────────────
         // Returns true if moving vi_move to new_pos would degrade any surviving
@@ -515,11 +597,12 @@ void decimateMesh(
         static constexpr double kStretchSq = 20.0; // max_edge² / (2·area) > k
 
         auto wouldDegrade = [&](int vi_move, int vi_other) -> bool {
-            for (int fi : verts[vi_move].adj_faces) {
-                if (faces[fi].deleted) continue;
+            bool degrade = false;
+            forFaces(vi_move, [&](int fi) {
+                if (degrade) return;
                 const auto& f = faces[fi];
                 bool has_other = (f.v[0]==vi_other||f.v[1]==vi_other||f.v[2]==vi_other);
-                if (has_other) continue;
+                if (has_other) return;
 
                 glm::dvec3 p[3] = {verts[f.v[0]].pos, verts[f.v[1]].pos, verts[f.v[2]].pos};
                 glm::dvec3 old_n = glm::cross(p[1]-p[0], p[2]-p[0]);
@@ -528,7 +611,7 @@ void decimateMesh(
 
                 // 2. Near-zero area → degenerate triangle
                 double area2 = glm::length(new_n); // = 2 * area
-                if (area2 < 1e-12) return true;
+                if (area2 < 1e-12) { degrade = true; return; }
 
                 // 1. Normal DEVIATION (was: full-flip only).  Reject a
                 //    collapse that rotates a SURVIVING face's normal more
@@ -552,7 +635,7 @@ void decimateMesh(
                     // the denominator is safe.
                     const double cos_dev =
                         glm::dot(old_n, new_n) / (old_area2 * area2);
-                    if (cos_dev < kCosMaxNormalDev) return true;
+                    if (cos_dev < kCosMaxNormalDev) { degrade = true; return; }
                 }
 
                 // 3. Aspect ratio: max_edge² / (2·area) > threshold
@@ -560,9 +643,9 @@ void decimateMesh(
                 double e1sq = glm::dot(p[2]-p[1], p[2]-p[1]);
                 double e2sq = glm::dot(p[0]-p[2], p[0]-p[2]);
                 double max_esq = std::max({e0sq, e1sq, e2sq});
-                if (max_esq > area2 * kStretchSq) return true;
-            }
-            return false;
+                if (max_esq > area2 * kStretchSq) degrade = true;
+            });
+            return degrade;
         };
 
         // ── Link-condition check ──────────────────────────────────────────────
@@ -571,28 +654,22 @@ void decimateMesh(
         // collapse would weld together unrelated surface sheets at a single vertex
         // ("bow-tie" / non-manifold), which renders as severe diagonal streaks.
         {
-            // Count faces that contain both v0 and v1 (these will be deleted)
+            ++stamp;
             int shared_faces = 0;
-            for (int fi : verts[v0].adj_faces) {
-                if (faces[fi].deleted) continue;
+            forFaces(v0, [&](int fi) {
                 const auto& f = faces[fi];
                 if (f.v[0]==v1 || f.v[1]==v1 || f.v[2]==v1) ++shared_faces;
-            }
-
-            // Collect v0's live unique neighbors (excluding v1)
-            std::unordered_set<int> v0_nbrs;
-            v0_nbrs.reserve(verts[v0].adj_verts.size());
-            for (int vn : verts[v0].adj_verts)
-                if (!verts[vn].deleted && vn != v1) v0_nbrs.insert(vn);
-
-            // Count how many of v1's live neighbors are also v0's neighbors
-            std::unordered_set<int> v1_seen;
+                for (int k = 0; k < 3; ++k) mark_a[f.v[k]] = stamp;
+            });
             int shared_nbrs = 0;
-            for (int vn : verts[v1].adj_verts) {
-                if (verts[vn].deleted || vn == v0) continue;
-                if (v1_seen.insert(vn).second && v0_nbrs.count(vn)) ++shared_nbrs;
-            }
-
+            forFaces(v1, [&](int fi) {
+                for (int k = 0; k < 3; ++k) {
+                    const int vn = faces[fi].v[k];
+                    if (vn == v0 || vn == v1 || mark_b[vn] == stamp) continue;
+                    mark_b[vn] = stamp;
+                    if (mark_a[vn] == stamp) ++shared_nbrs;
+                }
+            });
             if (shared_nbrs != shared_faces) continue; // would create non-manifold
         }
 
@@ -603,41 +680,34 @@ void decimateMesh(
         verts[v0].pos      = new_pos;
         verts[v0].Q       += verts[v1].Q;
         verts[v1].deleted  = true;
+        ++verts[v0].version;
+        max_cost = std::max(max_cost,
+                            verts[v0].Q.eval(new_pos.x, new_pos.y, new_pos.z));
 
-        for (int fi : verts[v1].adj_faces) {
-            if (faces[fi].deleted) continue;
+        forFaces(v1, [&](int fi) {
             auto& f = faces[fi];
             bool has_v0 = (f.v[0]==v0||f.v[1]==v0||f.v[2]==v0);
             if (has_v0) {
-                faces[fi].deleted = true; --alive;
+                f.deleted = true; --alive;
             } else {
                 for (int k=0;k<3;++k) if (f.v[k]==v1) f.v[k]=v0;
-                verts[v0].adj_faces.push_back(fi);
             }
-        }
-        verts[v1].adj_faces.clear();
-
-        // Merge v1's neighbor list into v0 (lazy — keeps duplicates, skip on use)
-        for (int vn : verts[v1].adj_verts) {
-            if (vn == v0 || verts[vn].deleted) continue;
-            verts[v0].adj_verts.push_back(vn);
-            for (auto& nb : verts[vn].adj_verts) if (nb == v1) nb = v0;
-        }
-        verts[v1].adj_verts.clear();
-
-        // Remove the collapsed edge
-        edge_ver.erase(edgeKey(v0,v1));
+        });
+        verts[verts[v0].chain_tail].chain_next = v1;
+        verts[v0].chain_tail = verts[v1].chain_tail;
 
         // Recompute all edges incident to v0
-        for (int vn : verts[v0].adj_verts) {
-            if (verts[vn].deleted || vn == v0) continue;
-            if (seal_locked_edges ? (verts[v0].locked || verts[vn].locked)
-                                  : (verts[v0].locked && verts[vn].locked))
-                continue;
-            uint64_t key = edgeKey(v0,vn);
-            ++edge_ver[key];
-            pq.push(computeCollapse(verts, std::min(v0,vn), std::max(v0,vn), edge_ver));
-        }
+        ++stamp;
+        forFaces(v0, [&](int fi) {
+            for (int k = 0; k < 3; ++k) {
+                const int vn = faces[fi].v[k];
+                if (vn == v0 || mark_a[vn] == stamp) continue;
+                mark_a[vn] = stamp;
+                if (frozen(v0, vn)) continue;
+                pq.push(computeCollapse(verts, std::min(v0,vn), std::max(v0,vn),
+                                        attributes));
+            }
+        });
         ++collapses_done;
     }
 
@@ -646,9 +716,12 @@ void decimateMesh(
 
     // ── Build output mesh ─────────────────────────────────────────────────────
     std::vector<int> old_to_new(nv, -1);
-    output_mesh.vertex_data_ptr->clear();
-    output_mesh.faces_ptr->clear();
+    std::vector<VertexStruct> out_verts;
+    std::vector<Face> out_faces;
+    out_faces.reserve(alive);
     output_face_part_ids.clear();
+    output_face_part_ids.reserve(alive);
+    if (out_source) out_source->clear();
 
     // First: assign output vertex indices (only for alive faces)
     for (int fi = 0; fi < nf; ++fi) {
@@ -656,17 +729,18 @@ void decimateMesh(
         for (int k = 0; k < 3; ++k) {
             int vi = faces[fi].v[k];
             if (old_to_new[vi] == -1) {
-                old_to_new[vi] = (int)output_mesh.vertex_data_ptr->size();
+                old_to_new[vi] = (int)out_verts.size();
                 VertexStruct vs   = in_verts[vi];       // copy UV + normal
                 vs.position       = glm::vec3(verts[vi].pos); // QEM position
-                output_mesh.vertex_data_ptr->push_back(vs);
+                out_verts.push_back(vs);
+                if (out_source) out_source->push_back((uint32_t)vi);
             }
         }
     }
     // Second: emit faces
     for (int fi = 0; fi < nf; ++fi) {
         if (faces[fi].deleted) continue;
-        output_mesh.faces_ptr->push_back(Face(
+        out_faces.push_back(Face(
             (uint32_t)old_to_new[faces[fi].v[0]],
             (uint32_t)old_to_new[faces[fi].v[1]],
             (uint32_t)old_to_new[faces[fi].v[2]]));
@@ -683,34 +757,249 @@ void decimateMesh(
     // Logged to std::cout (the `log` stream is discarded at the call
     // site) and throttled so it can't spam across hundreds of prims.
     {
-        size_t in_boundary = 0;
-        for (const auto& kv : edge_face_map)
-            if (kv.second.size() == 1) ++in_boundary;
-        std::unordered_map<uint64_t, int> out_edge_count;
-        out_edge_count.reserve(output_mesh.faces_ptr->size() * 3);
-        for (const auto& f : *output_mesh.faces_ptr)
-            for (int k = 0; k < 3; ++k) {
-                const int a = (int)f.v_indices[k];
-                const int b = (int)f.v_indices[(k + 1) % 3];
-                ++out_edge_count[edgeKey(a, b)];
-            }
-        size_t out_boundary = 0;
-        for (const auto& kv : out_edge_count)
-            if (kv.second == 1) ++out_boundary;
+        const size_t in_boundary = countBoundaryEdges(in_edges);
+        EdgeTable out_edges;
+        out_edges.build(faces, nv);
+        const size_t out_boundary = countBoundaryEdges(out_edges);
         if (out_boundary > in_boundary) {
-            static int s_hole_log = 0;
-            if (s_hole_log < 30) {
-                ++s_hole_log;
+            // Atomic: FBX imports decimate meshes on several threads.
+            static std::atomic<int> s_hole_log{0};
+            const int n_logged = s_hole_log.fetch_add(1) + 1;
+            if (n_logged <= 30) {
                 std::cout << "[QEM.holes] decimation OPENED holes: boundary "
                              "edges in=" << in_boundary << " out="
                           << out_boundary << " (+"
                           << (out_boundary - in_boundary) << "), faces "
-                          << nf << "->" << alive << " (#" << s_hole_log
+                          << nf << "->" << alive << " (#" << n_logged
                           << "/30)" << std::endl;
             }
         }
     }
+
+    *output_mesh.vertex_data_ptr = std::move(out_verts);
+    *output_mesh.faces_ptr       = std::move(out_faces);
+    return std::sqrt(max_cost);
+}
+
+// ── Partitioned decimation ───────────────────────────────────────────────────
+// Faces sorted by the Morton code of their centroid and cut into runs of
+// kPartitionFaces; every run is decimated on the pool as its own mesh, with
+// the vertices it shares with other runs locked, so all runs agree on the
+// seams and the results stitch by input vertex id.  The seams are left at
+// full density, so a second pass over the stitched mesh with the runs
+// shifted by half a run lets them collapse too.  Run boundaries depend only
+// on the mesh, never on the thread count.
+constexpr size_t kPartitionFaces = 65536;
+
+double partitionPass(
+    const Mesh& in, const std::vector<int32_t>& parts,
+    Mesh& out, std::vector<int32_t>& out_parts,
+    size_t target, bool shifted, std::ostream& log,
+    const DecimateOptions& options)
+{
+    const auto& verts = *in.vertex_data_ptr;
+    const auto& faces = *in.faces_ptr;
+    const size_t nf = faces.size();
+
+    // Morton order of the face centroids.
+    glm::vec3 lo(std::numeric_limits<float>::max());
+    glm::vec3 hi(-std::numeric_limits<float>::max());
+    for (const auto& v : verts) {
+        lo = glm::min(lo, v.position);
+        hi = glm::max(hi, v.position);
+    }
+    const glm::vec3 extent = glm::max(hi - lo, glm::vec3(1e-20f));
+    auto spread = [](uint32_t x) {
+        x &= 0x3ff;
+        x = (x | (x << 16)) & 0x030000ff;
+        x = (x | (x << 8))  & 0x0300f00f;
+        x = (x | (x << 4))  & 0x030c30c3;
+        x = (x | (x << 2))  & 0x09249249;
+        return x;
+    };
+    std::vector<uint64_t> keys(nf);
+    for (size_t f = 0; f < nf; ++f) {
+        const auto& fc = faces[f];
+        glm::vec3 c = verts[fc.v_indices[0]].position;
+        c += verts[fc.v_indices[1]].position;
+        c += verts[fc.v_indices[2]].position;
+        const glm::vec3 q = (c * (1.0f / 3.0f) - lo) / extent * 1023.0f;
+        const uint32_t code = spread((uint32_t)q.x) |
+                              (spread((uint32_t)q.y) << 1) |
+                              (spread((uint32_t)q.z) << 2);
+        keys[f] = ((uint64_t)code << 32) | (uint32_t)f;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<size_t> run_start{ 0 };
+    for (size_t s = shifted ? kPartitionFaces / 2 : kPartitionFaces; s < nf;
+         s += kPartitionFaces)
+        run_start.push_back(s);
+    run_start.push_back(nf);
+    const size_t runs = run_start.size() - 1;
+
+    // Vertices used by more than one run are locked in every run.
+    std::vector<uint32_t> owner(verts.size(), UINT32_MAX);
+    std::vector<uint8_t> shared(verts.size(), 0);
+    for (size_t r = 0; r < runs; ++r)
+        for (size_t i = run_start[r]; i < run_start[r + 1]; ++i)
+            for (uint32_t v : faces[(uint32_t)keys[i]].v_indices) {
+                if (owner[v] == UINT32_MAX) owner[v] = (uint32_t)r;
+                else if (owner[v] != r)    shared[v] = 1;
+            }
+
+    struct Run {
+        Mesh out;
+        std::vector<int32_t> parts;
+        std::vector<uint32_t> source;   // output vertex -> input vertex
+        std::ostringstream log;
+        double error = 0.0;
+    };
+    std::vector<Run> results(runs);
+    std::vector<std::exception_ptr> errors(runs);
+    options.pool->parallelFor(runs, [&](size_t r) {
+        try {
+            // Local mesh over the run's vertices, ascending input id.
+            std::vector<uint32_t> ids;
+            for (size_t i = run_start[r]; i < run_start[r + 1]; ++i)
+                for (uint32_t v : faces[(uint32_t)keys[i]].v_indices)
+                    ids.push_back(v);
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            auto local = [&](uint32_t v) {
+                return (uint32_t)(std::lower_bound(ids.begin(), ids.end(), v) -
+                                  ids.begin());
+            };
+            Mesh m;
+            std::vector<uint8_t> locked(ids.size());
+            m.vertex_data_ptr->reserve(ids.size());
+            for (size_t l = 0; l < ids.size(); ++l) {
+                m.vertex_data_ptr->push_back(verts[ids[l]]);
+                locked[l] = shared[ids[l]];
+            }
+            std::vector<int32_t> run_parts;
+            const size_t n = run_start[r + 1] - run_start[r];
+            m.faces_ptr->reserve(n);
+            run_parts.reserve(n);
+            for (size_t i = run_start[r]; i < run_start[r + 1]; ++i) {
+                const uint32_t f = (uint32_t)keys[i];
+                m.faces_ptr->emplace_back(local(faces[f].v_indices[0]),
+                                          local(faces[f].v_indices[1]),
+                                          local(faces[f].v_indices[2]));
+                run_parts.push_back(parts[f]);
+            }
+            const size_t run_target = std::max<size_t>(1,
+                (size_t)((double)target * (double)n / (double)nf + 0.5));
+            Run& res = results[r];
+            res.error = decimateSerial(m, run_parts, res.out, res.parts,
+                                       run_target, res.log, options, &locked,
+                                       &res.source);
+            for (auto& s : res.source) s = ids[s];
+        } catch (...) {
+            errors[r] = std::current_exception();
+        }
+    });
+    for (const auto& e : errors)
+        if (e) std::rethrow_exception(e);
+
+    // Stitch by input vertex id, in run order.
+    std::vector<int> stitched(verts.size(), -1);
+    std::vector<VertexStruct> out_verts;
+    std::vector<Face> out_faces;
+    out_parts.clear();
+    double error = 0.0;
+    for (auto& res : results) {
+        log << res.log.str();
+        error = std::max(error, res.error);
+        std::vector<uint32_t> remap(res.source.size());
+        for (size_t l = 0; l < res.source.size(); ++l) {
+            int& s = stitched[res.source[l]];
+            if (s < 0) {
+                s = (int)out_verts.size();
+                out_verts.push_back((*res.out.vertex_data_ptr)[l]);
+            }
+            remap[l] = (uint32_t)s;
+        }
+        for (const auto& f : *res.out.faces_ptr)
+            out_faces.emplace_back(remap[f.v_indices[0]], remap[f.v_indices[1]],
+                                   remap[f.v_indices[2]]);
+        out_parts.insert(out_parts.end(), res.parts.begin(), res.parts.end());
+    }
+    *out.vertex_data_ptr = std::move(out_verts);
+    *out.faces_ptr       = std::move(out_faces);
+    return error;
+}
+
+double decimatePartitioned(
+    const Mesh& input_mesh,
+    const std::vector<int32_t>& face_part_ids,
+    Mesh& output_mesh,
+    std::vector<int32_t>& output_face_part_ids,
+    size_t target_face_count,
+    std::ostream& log,
+    const DecimateOptions& options)
+{
+    Mesh first;
+    std::vector<int32_t> first_parts;
+    double error = partitionPass(input_mesh, face_part_ids, first, first_parts,
+                                 target_face_count, false, log, options);
+    if (first.getFaceCount() > target_face_count) {
+        error += partitionPass(first, first_parts, output_mesh,
+                               output_face_part_ids, target_face_count, true,
+                               log, options);
+    } else {
+        output_mesh = first;
+        output_face_part_ids = std::move(first_parts);
+    }
+    log << "[QEM] partitioned: faces " << input_mesh.getFaceCount() << " -> "
+        << output_mesh.getFaceCount() << "\n";
+    return error;
+}
+
+} // anonymous namespace
+
+// -----------------------------------------------------------------------------
+
+void decimateMesh(
+    const Mesh& input_mesh,
+    const std::vector<int32_t>& face_part_ids,
+    Mesh& output_mesh,
+    std::vector<int32_t>& output_face_part_ids,
+    size_t target_face_count,
+    std::ostream& log,
+    const DecimateOptions& options)
+{
+    const size_t nf = input_mesh.getFaceCount();
+    const bool partitioned =
+        options.pool && options.pool->numThreads() > 1 &&
+        nf >= std::max(options.partition_min_faces, 2 * kPartitionFaces) &&
+        target_face_count < nf;
+    const double error = partitioned
+        ? decimatePartitioned(input_mesh, face_part_ids, output_mesh,
+                              output_face_part_ids, target_face_count, log,
+                              options)
+        : decimateSerial(input_mesh, face_part_ids, output_mesh,
+                         output_face_part_ids, target_face_count, log,
+                         options, nullptr, nullptr);
+    if (options.out_max_error) *options.out_max_error = error;
+}
+
+void decimateMesh(
+    const Mesh& input_mesh,
+    const std::vector<int32_t>& face_part_ids,
+    Mesh& output_mesh,
+    std::vector<int32_t>& output_face_part_ids,
+    size_t target_face_count,
+    std::ostream& log,
+    bool seal_locked_edges,
+    double* out_max_error)
+{
+    DecimateOptions options;
+    options.seal_locked_edges = seal_locked_edges;
+    options.out_max_error = out_max_error;
+    decimateMesh(input_mesh, face_part_ids, output_mesh, output_face_part_ids,
+                 target_face_count, log, options);
 }
 
 } // game_object
-} // engine
\ No newline at end of file
+} // engine
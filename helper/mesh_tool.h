@@ -66,6 +66,28 @@ extern void generateHLODWithSeamProtection(
     const std::set<uint32_t>& protected_vertex_indices,
     std::ostream& log);
 
+class ThreadPool;
+
+struct DecimateOptions {
+    // See the seal_locked_edges parameter of decimateMesh below.
+    bool    seal_locked_edges = false;
+    // Adds c_normal_weight * (1 - cos normal angle) + c_uv_weight *
+    // uv distance², times the squared edge length, to each collapse cost,
+    // so shading and texture seams within a UV shell simplify last.
+    // Drawable LODs want it; collision proxies have no attributes to keep.
+    bool    attribute_aware   = false;
+    // See the out_max_error parameter of decimateMesh below.  Partitioned
+    // runs report the sum over their passes.
+    double* out_max_error     = nullptr;
+    // Meshes of at least partition_min_faces faces are decimated as
+    // Morton-ordered runs of 64K faces in parallel on `pool`, run seams
+    // locked and then collapsed by a second, shifted pass.  The result
+    // depends on the mesh only, not on the pool's size.  Blocks on the
+    // pool, so a pool worker must leave `pool` null.
+    ThreadPool* pool          = nullptr;
+    size_t  partition_min_faces = 200000;
+};
+
 // Decimate the entire mesh (all material parts at once) using QEM.
 // face_part_ids[i] is the material-part index for face i (0..num_parts-1).
 // Boundary edges and inter-part seam edges are detected automatically and
@@ -86,7 +108,20 @@ extern void decimateMesh(
     // in > out).  Collision proxies pass true so the simplified floor
     // keeps its exact edge; the drawable LOD path leaves it false
     // (default) so boundaries can still simplify.
-    bool seal_locked_edges = false);
+    bool seal_locked_edges = false,
+    // Optional: receives the geometric error of the result, sqrt of the
+    // largest quadric cost among the collapses performed (0 when nothing
+    // collapsed).  The cluster DAG builder stores it per LOD group.
+    double* out_max_error = nullptr);
+
+extern void decimateMesh(
+    const Mesh& input_mesh,
+    const std::vector<int32_t>& face_part_ids,
+    Mesh& output_mesh,
+    std::vector<int32_t>& output_face_part_ids,
+    size_t target_face_count,
+    std::ostream& log,
+    const DecimateOptions& options);
 
 } // game_object
 } // engine
\ No newline at end of file
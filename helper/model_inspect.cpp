@@ -1,5 +1,6 @@
 #include "model_inspect.h"
 #include "helper/mesh_tool.h"   // decimateMesh — bakes .rwgeo LOD levels
+#include "helper/cluster_dag.h" // buildClusterDag — v8 .rwgeo cluster DAG
 
 #include <algorithm>      // std::sort — geometry-key attribute ordering
 #include <cctype>
@@ -11,7 +12,9 @@
 #include <sstream>
 #include <functional>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -21,6 +24,7 @@
 // Bake-time BC7 VT tile-cache encode (static, CPU-only) + the VT tile
 // geometry constants stamped into format-1 .rwtex files.
 #include "scene_rendering/virtual_texture.h"
+#include "helper/thread_pool.h"      // parallel texture / object bake
 
 // stbi_load / stbi_image_free are compiled into the project via tinygltf
 // (STB_IMAGE_IMPLEMENTATION lives in engine_helper.cpp); declare just what
@@ -1412,6 +1416,13 @@ constexpr char kRwGeoMagic6[8] = {'R','W','G','E','O','0','0','6'};
 // FEATURE_MATERIAL_TRIPLANAR), and that decision belongs to the material,
 // so it has to survive the bake.  Everything else is v6.
 constexpr char kRwGeoMagic7[8] = {'R','W','G','E','O','0','0','7'};
+// v8 = v7 + a continuous-LOD cluster DAG: flags bit6 (64u) → after the
+// LOD table, u32 cluster_count, u32 level_count, u32 group_count, then per
+// cluster u32 first_index, index_count, section, level, vec4 bounds, cone,
+// lod_bounds, f32 lod_error, vec4 parent_bounds, f32 parent_error.  Like
+// the LOD levels, the DAG's vertices and indices are appended to the
+// blobs and first_index points into the full index blob.
+constexpr char kRwGeoMagic8[8] = {'R','W','G','E','O','0','0','8'};
 constexpr char kRwHierMagic[8] = {'R','W','H','I','E','R','0','1'};
 constexpr char kRwAnimMagic[8] = {'R','W','A','N','I','M','0','1'};
 
@@ -1464,16 +1475,18 @@ void halveRgba8(const std::vector<unsigned char>& src, int sw, int sh,
 //   plane (cutout textures only, for the forward/shadow mask companion).
 // The runtime VT registration adopts the blob directly — no CPU BC7
 // encode at load.  Falls back to legacy format 0 (raw RGBA8) when the
-// encode fails.
+// encode fails.  `encode_threads` caps the encoder's own threads (0 =
+// all); the bake lowers it while several textures encode at once.
 bool writeRwTex(const std::string& path, int w, int h,
-                const std::vector<unsigned char>& rgba) {
+                const std::vector<unsigned char>& rgba,
+                uint32_t encode_threads = 0) {
     namespace sr = engine::scene_rendering;
 
     // BC7 VT tile cache (the expensive part — runs on the import
     // worker thread, multi-threaded internally).
     std::vector<uint8_t> blob;
     const bool bc7_ok = sr::VirtualTextureManager::encodeAlbedoTileCacheCpu(
-        rgba.data(), (uint32_t)w, (uint32_t)h, blob);
+        rgba.data(), (uint32_t)w, (uint32_t)h, blob, encode_threads);
 
     std::ofstream f(path, std::ios::binary | std::ios::trunc);
     if (!f) return false;
@@ -1818,10 +1831,15 @@ void dedupSoupVertices(std::vector<glm::vec3>& positions,
 // Decimation is skipped when levels are supplied — the caller's levels
 // ARE the chain, and re-decimating them would append a second, unrelated
 // one.
+//
+// `pool` (null = serial) partitions the decimation of very large meshes
+// and the cluster DAG's groups; the output does not depend on it.  A
+// caller running on a pool worker must leave it null.
 bool writeRwGeo(const std::string& path, const ModelPreviewData& d,
                 const std::vector<GeoSectionOut>& sections,
                 const glm::mat4& node_to_world,
-                const std::vector<std::vector<glm::uvec2>>* authored) {
+                const std::vector<std::vector<glm::uvec2>>* authored,
+                ThreadPool* pool = nullptr) {
     std::ofstream f(path, std::ios::binary | std::ios::trunc);
     if (!f) return false;
     bool any_tex = false;
@@ -1950,8 +1968,11 @@ bool writeRwGeo(const std::string& path, const ModelPreviewData& d,
                 (size_t)1);
             Mesh dec;
             std::vector<int32_t> dec_ids;
+            DecimateOptions dec_opts;
+            dec_opts.attribute_aware = true;   // drawn: keep shading seams
+            dec_opts.pool = pool;
             decimateMesh(combined, combined_ids, dec, dec_ids, target,
-                         lod_log);
+                         lod_log, dec_opts);
             if (!dec.faces_ptr || dec.faces_ptr->empty()) {
                 lvl.push_back(src_lvl);
                 continue;
@@ -1986,18 +2007,63 @@ bool writeRwGeo(const std::string& path, const ModelPreviewData& d,
     }
     const bool has_lods = !lod_ranges.empty();
 
-    // v6: v5 + baked LODs (flags bit5); older files remain readable.
-    f.write(kRwGeoMagic7, 8);
+    // ── Continuous-LOD cluster DAG (v8) ──────────────────────────────
+    // Built over the section table (LOD 0) only.  Its simplified
+    // vertices follow everything above, so the DAG's own vertex ids are
+    // already the final ones; its indices are appended and the cluster
+    // ranges rebased.  Skinned meshes skip it for the same reason as the
+    // LODs.  On `pool` only for the meshes runGeoBakeJobs writes alone;
+    // the rest already run one object per pool worker.
+    ClusterDag dag;
+    if (!has_skin && !indices.empty() && !sections.empty()) {
+        Mesh src;
+        src.vertex_data_ptr->resize(positions.size());
+        for (size_t v = 0; v < positions.size(); ++v) {
+            VertexStruct& vs = (*src.vertex_data_ptr)[v];
+            vs.position = positions[v];
+            vs.normal = v < normals.size() ? normals[v]
+                                           : glm::vec3(0.0f, 1.0f, 0.0f);
+            vs.uv = (has_uv && v < uvs.size()) ? uvs[v] : glm::vec2(0.0f);
+        }
+        std::vector<int32_t> src_sections;
+        for (size_t si = 0; si < sections.size(); ++si) {
+            const uint32_t i0 = sections[si].first_index;
+            const uint32_t nn = sections[si].index_count;
+            for (uint32_t ii = i0; ii + 2 < i0 + nn && ii + 2 < indices.size();
+                 ii += 3) {
+                src.faces_ptr->emplace_back(indices[ii], indices[ii + 1],
+                                            indices[ii + 2]);
+                src_sections.push_back((int32_t)si);
+            }
+        }
+        if (buildClusterDag(src, src_sections, dag, ClusterDagOptions{},
+                            pool)) {
+            const uint32_t index_base = (uint32_t)indices.size();
+            for (size_t v = 0; v < dag.positions.size(); ++v) {
+                positions.push_back(dag.positions[v]);
+                normals.push_back(dag.normals[v]);
+                if (has_uv) uvs.push_back(dag.uvs[v]);
+            }
+            indices.insert(indices.end(), dag.indices.begin(),
+                           dag.indices.end());
+            for (auto& c : dag.clusters) c.first_index += index_base;
+        }
+    }
+    const bool has_dag = !dag.empty();
+
+    // v8: v7 + cluster DAG (flags bit6); older files remain readable.
+    f.write(kRwGeoMagic8, 8);
     wrPod(f, (uint32_t)positions.size());
     wrPod(f, (uint32_t)indices.size());
     // bit3 (8u) = second skin set blobs (8-bone debug), bit4 (16u) =
-    // second closeness blob, bit5 (32u) = baked LOD table.  Readers
+    // second closeness blob, bit5 (32u) = baked LOD table, bit6 (64u) =
+    // cluster DAG.  Readers
     // older than a bit ignore it only if it's clear — engine and bake
     // ship together.
     wrPod(f, (uint32_t)((has_uv ? 1u : 0u) | (has_skin ? 2u : 0u) |
                         (has_close ? 4u : 0u) | (has_skin1 ? 8u : 0u) |
                         (has_close1 ? 16u : 0u) |
-                        (has_lods ? 32u : 0u)));
+                        (has_lods ? 32u : 0u) | (has_dag ? 64u : 0u)));
     // v3: geometry is NODE-LOCAL; this matrix places it in source-world
     // space (standalone consumers apply it; hierarchical renderers compose
     // the rwhier chain instead).
@@ -2030,6 +2096,24 @@ bool writeRwGeo(const std::string& path, const ModelPreviewData& d,
             }
         }
     }
+    // Cluster DAG (v8): the cluster table; geometry is in the blobs.
+    if (has_dag) {
+        wrPod(f, (uint32_t)dag.clusters.size());
+        wrPod(f, dag.level_count);
+        wrPod(f, dag.group_count);
+        for (const auto& c : dag.clusters) {
+            wrPod(f, c.first_index);
+            wrPod(f, c.index_count);
+            wrPod(f, c.section);
+            wrPod(f, c.level);
+            wrPod(f, c.bounds);
+            wrPod(f, c.cone);
+            wrPod(f, c.lod_bounds);
+            wrPod(f, c.lod_error);
+            wrPod(f, c.parent_bounds);
+            wrPod(f, c.parent_error);
+        }
+    }
     // Skin joint table (v4): per joint, the hierarchy.rwhier node index
     // it binds to + the inverse bind matrix.
     if (has_skin) {
@@ -2132,6 +2216,293 @@ bool writeRwAnim(const std::string& path,
     return (bool)f;
 }
 
+// ── Incremental bake: content keys + bake.manifest ─────────────────────
+//
+// A re-import used to re-bake the whole group: every .rwtex re-ran the
+// BC7 tile-cache encode and every .rwgeo the QEM decimation, hours of
+// work on a generated library to reproduce bytes already on disk.  Each
+// output is now keyed on a hash of everything that reaches it — the
+// geometry slice or the texture pixels, the section table, the writer's
+// format magic and the bake settings — and <group_dir>/bake.manifest
+// records the key every output was last written from:
+//
+//     rwbake=1
+//     objects/000_rock.rwgeo=3f0c9a1e77d2b410
+//     textures/rock_albedo.rwtex=91b7e0c2d4a85f63
+//
+// An output whose key matches and whose file is present is kept.  Bump
+// kBakeVersion whenever a writer changes what it emits for the same
+// input; every group then re-bakes once.
+constexpr char kBakeVersion[]      = "rwbake-2";
+constexpr char kBakeManifestName[] = "bake.manifest";
+
+class BakeKey {
+public:
+    BakeKey() : h_(stableAssetHash(kBakeVersion)) {}
+    BakeKey& bytes(const void* p, size_t n) {
+        h_ = stableContentHash(p, n, h_);
+        return *this;
+    }
+    template <typename T>
+    BakeKey& pod(const T& v) { return bytes(&v, sizeof(T)); }
+    template <typename T>
+    BakeKey& vec(const std::vector<T>& v) {
+        pod((uint64_t)v.size());
+        return bytes(v.data(), v.size() * sizeof(T));
+    }
+    BakeKey& str(const std::string& v) {
+        pod((uint64_t)v.size());
+        return bytes(v.data(), v.size());
+    }
+    uint64_t value() const { return h_; }
+
+private:
+    uint64_t h_;
+};
+
+uint64_t rwTexBakeKey(int w, int h, const std::vector<unsigned char>& rgba) {
+    namespace sr = engine::scene_rendering;
+    BakeKey k;
+    k.bytes(kRwTexMagic, 8).pod(sr::kVtPageSize).pod(sr::kVtTileBorder);
+    k.pod(w).pod(h).vec(rgba);
+    return k.value();
+}
+
+// Texture CONTENT is not in a .rwgeo key — the file only names its
+// textures, so a repainted texture re-bakes the .rwtex and nothing else.
+uint64_t rwGeoBakeKey(const ModelPreviewData& d,
+                      const std::vector<GeoSectionOut>& sections,
+                      const glm::mat4& node_to_world,
+                      const std::vector<std::vector<glm::uvec2>>* authored) {
+    BakeKey k;
+    k.bytes(kRwGeoMagic8, 8).pod(c_target_lod_ratio).pod(ClusterDagOptions{});
+    k.vec(d.positions).vec(d.normals).vec(d.uvs).vec(d.indices);
+    k.vec(d.joints).vec(d.weights).vec(d.closeness);
+    k.vec(d.joints1).vec(d.weights1).vec(d.closeness1);
+    k.vec(d.skin_joint_nodes).vec(d.skin_inverse_bind);
+    k.pod((uint64_t)sections.size());
+    for (const auto& s : sections) {
+        k.pod(s.first_index).pod(s.index_count).pod(s.flags);
+        k.pod(s.triplanar_tile_m).pod(s.base_color);
+        k.pod(s.metallic).pod(s.roughness);
+        k.str(s.tex_rel).str(s.nrm_rel).str(s.mr_rel);
+    }
+    k.pod(node_to_world);
+    k.pod((uint64_t)(authored ? authored->size() : 0));
+    if (authored)
+        for (const auto& lv : *authored) k.vec(lv);
+    return k.value();
+}
+
+using BakeManifest = std::unordered_map<std::string, uint64_t>;
+
+BakeManifest readBakeManifest(const std::filesystem::path& path) {
+    BakeManifest m;
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line) || line.rfind("rwbake=1", 0) != 0) return m;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        const size_t eq = line.rfind('=');
+        if (eq == std::string::npos || eq == 0) continue;
+        m[line.substr(0, eq)] =
+            std::strtoull(line.c_str() + eq + 1, nullptr, 16);
+    }
+    return m;
+}
+
+// Every bake output goes through here: written to "<path>.tmp" and
+// renamed over the real name only once the writer succeeded, so an
+// interrupted bake leaves the old file or the new one — never a
+// truncated file that bake.manifest would then vouch for.
+template <typename WriteFn>
+bool writeAtomically(const std::filesystem::path& path, WriteFn&& write) {
+    namespace fs = std::filesystem;
+    fs::path tmp = path;
+    tmp += ".tmp";
+    std::error_code ec;
+    if (!write(tmp.string())) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool writeBakeManifest(const std::filesystem::path& path,
+                       const BakeManifest& m) {
+    std::vector<std::pair<std::string, uint64_t>> rows(m.begin(), m.end());
+    std::sort(rows.begin(), rows.end());
+    return writeAtomically(path, [&](const std::string& p) {
+        std::ofstream f(p, std::ios::trunc);
+        f << "rwbake=1\n";
+        char hex[17];
+        for (const auto& r : rows) {
+            std::snprintf(hex, sizeof(hex), "%016llx",
+                          (unsigned long long)r.second);
+            f << r.first << '=' << hex << '\n';
+        }
+        return (bool)f;
+    });
+}
+
+bool bakeOutputCurrent(const BakeManifest& m,
+                       const std::filesystem::path& group,
+                       const std::string& rel, uint64_t key,
+                       bool with_png) {
+    const auto it = m.find(rel);
+    if (it == m.end() || it->second != key) return false;
+    std::error_code ec;
+    if (!std::filesystem::exists(group / rel, ec)) return false;
+    return !with_png ||
+           std::filesystem::exists(group / (rel + ".png"), ec);
+}
+
+// One texture of the bake.  The name is allocated up front, serially, so
+// it does not depend on scheduling; `load` produces the RGBA8 pixels on a
+// pool worker (glTF: widen the already-decoded image, FBX: decode the
+// embedded or on-disk file).
+struct TexBakeJob {
+    std::string rel;
+    std::function<bool(int&, int&, std::vector<unsigned char>&)> load;
+    uint64_t key    = 0;
+    bool     ok     = false;
+    bool     reused = false;
+};
+
+// Encodes every job not already current, spread over the pool.  The BC7
+// encoder is itself threaded, so its share of the cores shrinks as more
+// textures run side by side.
+void runTexBakeJobs(std::vector<TexBakeJob>& jobs,
+                    const std::filesystem::path& group,
+                    const BakeManifest& old_manifest, ThreadPool& pool) {
+    namespace fs = std::filesystem;
+    if (jobs.empty()) return;
+    const size_t side_by_side =
+        std::max<size_t>(1, std::min(jobs.size(), pool.numThreads()));
+    const uint32_t encode_threads = std::max(
+        1u, std::thread::hardware_concurrency() / (uint32_t)side_by_side);
+    pool.parallelFor(jobs.size(), [&](size_t i) {
+        TexBakeJob& j = jobs[i];
+        try {
+            int w = 0, h = 0;
+            std::vector<unsigned char> rgba;
+            if (!j.load(w, h, rgba)) return;
+            j.key = rwTexBakeKey(w, h, rgba);
+            if (bakeOutputCurrent(old_manifest, group, j.rel, j.key, true)) {
+                j.ok = j.reused = true;
+                return;
+            }
+            const fs::path path = group / j.rel;
+            j.ok = writeAtomically(path, [&](const std::string& p) {
+                return writeRwTex(p, w, h, rgba, encode_threads);
+            });
+            // Viewable copy of EXACTLY what was baked (orientation
+            // check + Content Browser thumbnail).
+            fs::path png = path;
+            png += ".png";
+            if (j.ok) {
+                writeAtomically(png, [&](const std::string& p) {
+                    return stbi_write_png(p.c_str(), w, h, 4, rgba.data(),
+                                          w * 4) != 0;
+                });
+            }
+        } catch (const std::exception& e) {
+            j.ok = false;
+            std::cerr << "[bake] texture '" + j.rel + "' failed: " +
+                         e.what() + "\n";
+        }
+    });
+}
+
+// One .rwgeo of the bake; the geometry stays owned by the caller.
+struct GeoBakeJob {
+    std::string                          rel;
+    const ModelPreviewData*              d        = nullptr;
+    const std::vector<GeoSectionOut>*    sections = nullptr;
+    glm::mat4                            node_to_world = glm::mat4(1.0f);
+    std::vector<std::vector<glm::uvec2>> authored;   // empty = decimate
+    uint64_t key    = 0;
+    bool     ok     = false;
+    bool     reused = false;
+};
+
+// Writes every job not already current, one object per pool task — the
+// QEM decimation inside writeRwGeo is the bulk of a geometry bake.  A
+// mesh big enough for partitioned decimation would hold one worker for
+// most of the bake, so those are written afterwards, one at a time, with
+// the whole pool inside writeRwGeo instead.
+void runGeoBakeJobs(std::vector<GeoBakeJob>& jobs,
+                    const std::filesystem::path& group,
+                    const BakeManifest& old_manifest, ThreadPool& pool) {
+    auto bake = [&](GeoBakeJob& j, ThreadPool* inner) {
+        const auto* authored = j.authored.empty() ? nullptr : &j.authored;
+        try {
+            j.key = rwGeoBakeKey(*j.d, *j.sections, j.node_to_world,
+                                 authored);
+            if (bakeOutputCurrent(old_manifest, group, j.rel, j.key,
+                                  false)) {
+                j.ok = j.reused = true;
+                return;
+            }
+            j.ok = writeAtomically(group / j.rel, [&](const std::string& p) {
+                return writeRwGeo(p, *j.d, *j.sections, j.node_to_world,
+                                  authored, inner);
+            });
+        } catch (const std::exception& e) {
+            j.ok = false;
+            std::cerr << "[bake] '" + j.rel + "' failed: " + e.what() +
+                         "\n";
+        }
+    };
+    std::vector<size_t> per_worker, whole_pool;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        size_t faces = 0;
+        for (const auto& sec : *jobs[i].sections) faces += sec.index_count / 3;
+        const bool big = jobs[i].authored.empty() &&
+                         faces >= DecimateOptions{}.partition_min_faces;
+        (big ? whole_pool : per_worker).push_back(i);
+    }
+    pool.parallelFor(per_worker.size(), [&](size_t i) {
+        bake(jobs[per_worker[i]], nullptr);
+    });
+    for (size_t i : whole_pool) bake(jobs[i], &pool);
+}
+
+// After the writes: drop what this bake did not produce — every .rwgeo
+// not in `fresh` (a group is written from ONE source, and both native
+// loaders read every file in objects/, so a leftover loads), textures the
+// PREVIOUS bake made and this one no longer needs, and .tmp files from
+// an interrupted run.  Then record the new manifest.
+void finishBake(const std::filesystem::path& group,
+                const BakeManifest& old_manifest,
+                const BakeManifest& fresh) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<fs::path> stale;
+    for (const char* sub : { "objects", "textures" }) {
+        for (auto& e : fs::directory_iterator(group / sub, ec)) {
+            const fs::path& p = e.path();
+            const std::string rel =
+                std::string(sub) + "/" + p.filename().string();
+            if (p.extension() == ".tmp" ||
+                (p.extension() == ".rwgeo" && !fresh.count(rel)))
+                stale.push_back(p);
+        }
+    }
+    for (const auto& [rel, key] : old_manifest) {
+        if (rel.rfind("textures/", 0) != 0 || fresh.count(rel)) continue;
+        stale.push_back(group / rel);
+        stale.push_back(group / (rel + ".png"));
+    }
+    for (const auto& p : stale) fs::remove(p, ec);
+    writeBakeManifest(group / kBakeManifestName, fresh);
+}
+
 } // anonymous namespace
 
 // Public wrapper over the bake-side soup dedup — see header doc.
@@ -2317,7 +2688,8 @@ bool loadRwGeo(const std::string& rwgeo_path, ModelPreviewData& out,
     if (!f) return false;
     char magic[8];
     if (!f.read(magic, 8)) return false;
-    const bool v7 = std::memcmp(magic, kRwGeoMagic7, 8) == 0;
+    const bool v8 = std::memcmp(magic, kRwGeoMagic8, 8) == 0;
+    const bool v7 = std::memcmp(magic, kRwGeoMagic7, 8) == 0 || v8;
     const bool v6 = std::memcmp(magic, kRwGeoMagic6, 8) == 0 || v7;
     const bool v5 = std::memcmp(magic, kRwGeoMagic5, 8) == 0 || v6;
     const bool v4 = std::memcmp(magic, kRwGeoMagic4, 8) == 0 || v5;
@@ -2336,6 +2708,7 @@ bool loadRwGeo(const std::string& rwgeo_path, ModelPreviewData& out,
     const bool has_skin1  = v4 && (flags & 8u) != 0;  // 8-bone second set
     const bool has_close1 = v4 && (flags & 16u) != 0;
     const bool has_lods   = v6 && (flags & 32u) != 0; // baked LOD table
+    const bool has_dag    = v8 && (flags & 64u) != 0; // cluster DAG
 
     // v3+: node-local geometry + the node's world matrix (re-applied below
     // so standalone consumers keep seeing source-world coordinates).
@@ -2410,6 +2783,32 @@ bool loadRwGeo(const std::string& rwgeo_path, ModelPreviewData& out,
         }
     }
 
+    // Cluster DAG (v8): ranges into the index blob read below.
+    if (has_dag) {
+        uint32_t cc = 0;
+        ClusterDag& dag = out.cluster_dag;
+        if (!rdPod(f, cc) || !rdPod(f, dag.level_count) ||
+            !rdPod(f, dag.group_count))
+            return false;
+        if (cc == 0 || cc > ic / 3 || dag.level_count == 0 ||
+            dag.level_count > 64u)
+            return false;
+        dag.clusters.resize(cc);
+        for (auto& c : dag.clusters) {
+            if (!rdPod(f, c.first_index) || !rdPod(f, c.index_count) ||
+                !rdPod(f, c.section) || !rdPod(f, c.level) ||
+                !rdPod(f, c.bounds) || !rdPod(f, c.cone) ||
+                !rdPod(f, c.lod_bounds) || !rdPod(f, c.lod_error) ||
+                !rdPod(f, c.parent_bounds) || !rdPod(f, c.parent_error))
+                return false;
+            if ((uint64_t)c.first_index + c.index_count > ic ||
+                c.index_count == 0 || c.index_count % 3 != 0 ||
+                c.section >= secs.size() || c.level >= dag.level_count)
+                return false;
+        }
+        dag.base_vertex_count = vc;
+    }
+
     // Skin joint table (v4, has_skin).
     if (has_skin) {
         uint32_t jc = 0;
@@ -2487,6 +2886,29 @@ bool loadRwGeo(const std::string& rwgeo_path, ModelPreviewData& out,
             const float l = glm::length(n);
             if (l > 1e-6f) n /= l;
         }
+        // The DAG's spheres and errors follow; a non-uniform scale keeps
+        // the largest axis and turns the normal cones off.
+        const float sx = glm::length(nm[0]), sy = glm::length(nm[1]),
+                    sz = glm::length(nm[2]);
+        const float smax = std::max(sx, std::max(sy, sz));
+        const bool uniform =
+            smax - std::min(sx, std::min(sy, sz)) <= smax * 1e-3f;
+        auto sphere = [&](glm::vec4& s) {
+            s = glm::vec4(glm::vec3(node_to_world * glm::vec4(glm::vec3(s), 1.0f)),
+                          s.w * smax);
+        };
+        for (auto& c : out.cluster_dag.clusters) {
+            sphere(c.bounds);
+            sphere(c.lod_bounds);
+            sphere(c.parent_bounds);
+            c.lod_error *= smax;
+            if (c.parent_error < FLT_MAX) c.parent_error *= smax;
+            const glm::vec3 axis = nm * glm::vec3(c.cone);
+            const float l = glm::length(axis);
+            c.cone = (uniform && l > 1e-6f)
+                ? glm::vec4(axis / l, c.cone.w)
+                : glm::vec4(0.0f, 0.0f, 1.0f, -1.0f);
+        }
     }
 
     // Textures: group-relative .rwtex files (group = parent of objects/),
@@ -2559,24 +2981,74 @@ bool bakeModelToRenderReady(
     fs::create_directories(fs::path(group_dir) / "objects", ec);
     fs::create_directories(fs::path(group_dir) / "textures", ec);
 
-    // ── Clear the previous bake's geometry ──────────────────────────────
-    // A group directory is written from ONE source model, so every
-    // .rwgeo in it belongs to the bake about to run.  Leaving the old
-    // ones behind used to be harmless because the same node produced
-    // the same file name; now that the names come from the mesh and a
-    // deduped bake writes fewer files, the leftovers would sit in the
-    // folder for ever — the Content Browser lists the directory, and
-    // both native loaders read every file in it, so a stale file is not
-    // cosmetic: it loads.
-    {
-        std::error_code dec;
-        for (auto& e :
-             fs::directory_iterator(fs::path(group_dir) / "objects", dec)) {
-            const std::string fn = e.path().filename().string();
-            if (e.path().extension() == ".rwgeo" || fn == "objects.rwmap")
-                fs::remove(e.path(), dec);
+    // ── The previous bake stays until this one has finished ──────────────
+    // Old outputs used to be deleted up front.  They are now what makes
+    // a re-import cheap: every texture and object whose content key
+    // still matches bake.manifest is kept as it is, and only files this
+    // bake did NOT produce are removed afterwards (finishBake).  That
+    // cleanup still matters — the Content Browser lists the directory
+    // and both native loaders read every file in it, so a stale .rwgeo
+    // is not cosmetic: it loads.
+    const fs::path group(group_dir);
+    const BakeManifest old_manifest =
+        readBakeManifest(group / kBakeManifestName);
+    BakeManifest fresh_manifest;
+    ThreadPool pool;
+
+    // Texture names, allocated serially in first-use order so they do
+    // not depend on scheduling.  Same-stem images from different folders
+    // get _1, _2, ... — checked against THIS bake, not the disk, or a
+    // re-bake would find its own previous output and rename everything.
+    std::unordered_set<std::string> tex_rels;
+    auto tex_rel_new = [&](const std::string& stem) {
+        const std::string base = "textures/" + sanitizeFileName(stem);
+        std::string rel = base + ".rwtex";
+        for (int suffix = 1; !tex_rels.insert(rel).second; ++suffix)
+            rel = base + "_" + std::to_string(suffix) + ".rwtex";
+        return rel;
+    };
+    std::vector<TexBakeJob> tex_jobs;
+
+    // Runs the texture jobs, records what they produced, and returns
+    // the rels that failed so the section tables can drop them before
+    // any .rwgeo is keyed or written.
+    auto bake_textures = [&]() {
+        runTexBakeJobs(tex_jobs, group, old_manifest, pool);
+        std::unordered_set<std::string> failed;
+        size_t reused = 0;
+        for (const auto& j : tex_jobs) {
+            if (!j.ok) { failed.insert(j.rel); continue; }
+            fresh_manifest[j.rel] = j.key;
+            reused += j.reused ? 1 : 0;
         }
-    }
+        std::cout << "[bake] " << tex_jobs.size() << " texture(s): "
+                  << (tex_jobs.size() - failed.size() - reused)
+                  << " baked, " << reused << " unchanged, "
+                  << failed.size() << " failed" << std::endl;
+        return failed;
+    };
+    auto drop_textures = [](std::vector<GeoSectionOut>& secs,
+                            const std::unordered_set<std::string>& failed) {
+        if (failed.empty()) return;
+        for (auto& sec : secs) {
+            if (failed.count(sec.tex_rel)) sec.tex_rel.clear();
+            if (failed.count(sec.nrm_rel)) sec.nrm_rel.clear();
+            if (failed.count(sec.mr_rel))  sec.mr_rel.clear();
+        }
+    };
+    auto bake_geometry = [&](std::vector<GeoBakeJob>& jobs) {
+        runGeoBakeJobs(jobs, group, old_manifest, pool);
+        size_t reused = 0, failed = 0;
+        for (const auto& j : jobs) {
+            if (!j.ok) { ++failed; continue; }
+            fresh_manifest[j.rel] = j.key;
+            reused += j.reused ? 1 : 0;
+        }
+        std::cout << "[bake] " << jobs.size() << " object file(s): "
+                  << (jobs.size() - failed - reused) << " baked, "
+                  << reused << " unchanged, " << failed << " failed"
+                  << std::endl;
+    };
 
     // ── ONE .rwgeo PER DISTINCT GEOMETRY, NOT PER NODE ─────────────────
     //
@@ -2689,15 +3161,30 @@ bool bakeModelToRenderReady(
     std::vector<OrdRef> ordinal_rel;
 
     auto write_obj_map = [&]() {
-        std::ofstream mf(fs::path(group_dir) / "objects" / "objects.rwmap",
-                         std::ios::trunc);
-        if (!mf) return;
-        mf << "rwobjmap=1\n";
-        for (const auto& r : ordinal_rel) {
-            mf << r.ord << '=' << r.rel;
-            if (r.level > 0) mf << '|' << r.level;
-            mf << '\n';
-        }
+        writeAtomically(group / "objects" / "objects.rwmap",
+                        [&](const std::string& p) {
+            std::ofstream mf(p, std::ios::trunc);
+            mf << "rwobjmap=1\n";
+            for (const auto& r : ordinal_rel) {
+                mf << r.ord << '=' << r.rel;
+                if (r.level > 0) mf << '|' << r.level;
+                mf << '\n';
+            }
+            return (bool)mf;
+        });
+    };
+    // Small sidecars (hierarchy, animation, character manifest) are
+    // cheap to regenerate and always rewritten — atomically, like the rest.
+    auto write_rwchar = [&]() {
+        const std::string leaf = group.filename().string();
+        writeAtomically(group / (leaf + ".rwchar"),
+                        [&](const std::string& p) {
+            std::ofstream mf(p, std::ios::trunc);
+            mf << "rwchar=1\nname=" << leaf
+               << "\nhierarchy=hierarchy.rwhier"
+               << "\nanimation=animation.rwanim\n";
+            return (bool)mf;
+        });
     };
 
     if (ext == ".gltf" || ext == ".glb") {
@@ -2731,8 +3218,10 @@ bool bakeModelToRenderReady(
 
         // Texture bake cache: glTF image index → textures/<name>.rwtex.
         std::unordered_map<int, std::string> tex_cache;
-        // Bake ONE glTF texture (by texture index) to textures/<name>.rwtex
-        // — used for albedo, normal and metallic-roughness refs alike.
+        // Name ONE glTF texture (by texture index) and queue its bake to
+        // textures/<name>.rwtex — used for albedo, normal and
+        // metallic-roughness refs alike.  The pixels are widened and
+        // encoded later, in parallel, by bake_textures().
         auto bake_gltf_texture = [&](int tex_idx) -> std::string {
             if (tex_idx < 0 || tex_idx >= (int)model.textures.size())
                 return {};
@@ -2743,27 +3232,27 @@ bool bakeModelToRenderReady(
             const auto& img = model.images[src];
             if (img.image.empty() || img.width <= 0 || img.height <= 0 ||
                 (img.component != 3 && img.component != 4)) return {};
-            std::vector<unsigned char> rgba((size_t)img.width *
-                                            img.height * 4);
-            for (size_t i = 0; i < (size_t)img.width * img.height; ++i) {
-                const uint8_t* sp = img.image.data() + i * img.component;
-                uint8_t* dp = rgba.data() + i * 4;
-                dp[0] = sp[0]; dp[1] = sp[1]; dp[2] = sp[2];
-                dp[3] = (img.component == 4) ? sp[3] : 255;
-            }
             std::string nm = img.uri.empty()
                 ? ("image" + std::to_string(src))
                 : fs::path(img.uri).stem().string();
-            const std::string rel =
-                "textures/" + sanitizeFileName(nm) + ".rwtex";
-            if (!writeRwTex((fs::path(group_dir) / rel).string(),
-                            img.width, img.height, rgba)) return {};
-            // Viewable copy of EXACTLY what was baked (orientation check +
-            // Content Browser thumbnail).
-            stbi_write_png(
-                ((fs::path(group_dir) / rel).string() + ".png").c_str(),
-                img.width, img.height, 4, rgba.data(), img.width * 4);
+            const std::string rel = tex_rel_new(nm);
+            TexBakeJob job;
+            job.rel = rel;
+            job.load = [&img](int& w, int& h,
+                              std::vector<unsigned char>& rgba) {
+                w = img.width;
+                h = img.height;
+                rgba.resize((size_t)w * h * 4);
+                for (size_t i = 0; i < (size_t)w * h; ++i) {
+                    const uint8_t* sp = img.image.data() + i * img.component;
+                    uint8_t* dp = rgba.data() + i * 4;
+                    dp[0] = sp[0]; dp[1] = sp[1]; dp[2] = sp[2];
+                    dp[3] = (img.component == 4) ? sp[3] : 255;
+                }
+                return true;
+            };
             tex_cache.emplace(src, rel);
+            tex_jobs.push_back(std::move(job));
             return rel;
         };
 
@@ -3064,26 +3553,34 @@ bool bakeModelToRenderReady(
             if (progress) progress((size_t)k, total);
         }
 
-        // ── Write one file per object ─────────────────────────────────
-        std::unordered_map<std::string, std::string> failed;
+        // ── Textures, then one file per object, both in parallel ──────
+        // Textures go first: a texture that failed is dropped from the
+        // section tables before they are keyed and written.
+        const std::unordered_set<std::string> tex_failed = bake_textures();
+        std::unordered_set<std::string> failed;
         size_t levelled = 0;
+        std::vector<GeoBakeJob> geo_jobs;
         for (const auto& okey : merged_order) {
             MergedGeo& mg = merged[okey];
             if (mg.d.positions.empty() || mg.d.indices.size() < 3 ||
                 mg.usec.empty())
                 continue;
+            drop_textures(mg.usec, tex_failed);
+            GeoBakeJob job;
+            job.rel = mg.rel;
+            job.d = &mg.d;
+            job.sections = &mg.usec;
+            job.node_to_world = mg.node_world;
             // Levels 1.. are the authored chain; level 0 IS the section
             // table, so it is not repeated here.
-            std::vector<std::vector<glm::uvec2>> authored(
+            job.authored.assign(
                 mg.lvl.begin() + (mg.lvl.empty() ? 0 : 1), mg.lvl.end());
-            const bool multi = !authored.empty();
-            if (multi) ++levelled;
-            if (!writeRwGeo((fs::path(group_dir) / mg.rel).string(),
-                            mg.d, mg.usec, mg.node_world,
-                            multi ? &authored : nullptr)) {
-                failed.emplace(mg.rel, okey);
-            }
+            if (!job.authored.empty()) ++levelled;
+            geo_jobs.push_back(std::move(job));
         }
+        bake_geometry(geo_jobs);
+        for (const auto& j : geo_jobs)
+            if (!j.ok) failed.insert(j.rel);
         if (!failed.empty()) {
             for (auto& r : ordinal_rel)
                 if (failed.count(r.rel)) r.rel.clear();
@@ -3113,8 +3610,10 @@ bool bakeModelToRenderReady(
                 hier[i].mesh_ordinal =
                     (model.nodes[i].mesh >= 0) ? mk++ : -1;
             }
-            writeRwHier(
-                (fs::path(group_dir) / "hierarchy.rwhier").string(), hier);
+            writeAtomically(group / "hierarchy.rwhier",
+                            [&](const std::string& p) {
+                return writeRwHier(p, hier);
+            });
         }
 
         // ── Animation: every glTF clip → animation.rwanim ───────────────
@@ -3174,9 +3673,10 @@ bool bakeModelToRenderReady(
                     clips.push_back(std::move(clip));
             }
             if (!clips.empty()) {
-                writeRwAnim(
-                    (fs::path(group_dir) / "animation.rwanim").string(),
-                    clips);
+                writeAtomically(group / "animation.rwanim",
+                                [&](const std::string& p) {
+                    return writeRwAnim(p, clips);
+                });
                 std::cout << "[bake] baked " << clips.size()
                           << " animation clip(s)" << std::endl;
             }
@@ -3184,16 +3684,7 @@ bool bakeModelToRenderReady(
 
         // Character manifest — lets the engine load this baked group as ONE
         // skinned DrawableObject straight from raw data (no source needed).
-        if (!model.skins.empty()) {
-            const std::string leaf = fs::path(group_dir).filename().string();
-            std::ofstream mf(
-                (fs::path(group_dir) / (leaf + ".rwchar")).string(),
-                std::ios::trunc);
-            if (mf)
-                mf << "rwchar=1\nname=" << leaf
-                   << "\nhierarchy=hierarchy.rwhier"
-                   << "\nanimation=animation.rwanim\n";
-        }
+        if (!model.skins.empty()) write_rwchar();
     } else if (ext == ".fbx") {
         // RAW load options — identical to the engine's loadFbxModel (axis
         // conversion can mirror geometry; see loadModelPreviewData note).
@@ -3203,78 +3694,81 @@ bool bakeModelToRenderReady(
             ufbx_load_file(source_path.c_str(), &opts, &error);
         if (!scene) return false;
 
-        // Texture bake cache: ufbx texture → textures/<name>.rwtex.
+        // Texture bake cache: ufbx texture → textures/<name>.rwtex.  The
+        // decode happens in the queued job, in parallel with the other
+        // textures; one that fails to decode is dropped from the section
+        // tables afterwards (bake_textures / drop_textures).
         std::unordered_map<const ufbx_texture*, std::string> tex_cache;
         auto bake_fbx_texture =
             [&](const ufbx_texture* tex) -> std::string {
             if (!tex) return {};
             auto it = tex_cache.find(tex);
             if (it != tex_cache.end()) return it->second;
-
-            int w = 0, h = 0;
-            std::vector<unsigned char> rgba;
-            bool loaded = false;
-            if (tex->content.size > 0 && tex->content.data) {
-                int comp = 0;
-                unsigned char* px = stbi_load_from_memory(
-                    (const unsigned char*)tex->content.data,
-                    (int)tex->content.size, &w, &h, &comp, 4);
-                if (px && w > 0 && h > 0) {
-                    rgba.assign(px, px + (size_t)w * h * 4);
-                    loaded = true;
-                }
-                if (px) stbi_image_free(px);
-            }
-            if (!loaded && tex->filename.data && tex->filename.length > 0)
-                loaded = loadImageFileRgba(tex->filename.data, w, h, rgba);
-            if (!loaded && tex->absolute_filename.data &&
-                tex->absolute_filename.length > 0)
-                loaded = loadImageFileRgba(tex->absolute_filename.data,
-                                           w, h, rgba);
-            if (!loaded && tex->relative_filename.data &&
-                tex->relative_filename.length > 0) {
-                const fs::path p =
-                    fs::path(source_path).parent_path() /
-                    fs::path(tex->relative_filename.data);
-                loaded = loadImageFileRgba(p.string(), w, h, rgba);
-            }
-            std::cout << "[bake] fbx texture '"
-                      << (tex->filename.data ? tex->filename.data : "?")
-                      << "' -> " << (loaded ? "baked" : "FAILED")
-                      << std::endl;
-            if (!loaded) {
-                tex_cache.emplace(tex, std::string());
-                return {};
-            }
             std::string nm = "texture";
             if (tex->filename.data && tex->filename.length > 0)
                 nm = fs::path(tex->filename.data).stem().string();
-            std::string rel =
-                "textures/" + sanitizeFileName(nm) + ".rwtex";
-            // Avoid same-stem collisions from different folders.
-            int suffix = 1;
-            std::error_code xec;
-            while (fs::exists(fs::path(group_dir) / rel, xec)) {
-                rel = "textures/" + sanitizeFileName(nm) + "_" +
-                      std::to_string(suffix++) + ".rwtex";
-            }
-            if (!writeRwTex((fs::path(group_dir) / rel).string(),
-                            w, h, rgba)) {
-                tex_cache.emplace(tex, std::string());
-                return {};
-            }
-            // Viewable copy of EXACTLY what was baked (orientation check +
-            // Content Browser thumbnail).
-            stbi_write_png(
-                ((fs::path(group_dir) / rel).string() + ".png").c_str(),
-                w, h, 4, rgba.data(), w * 4);
+            const std::string rel = tex_rel_new(nm);
+            TexBakeJob job;
+            job.rel = rel;
+            job.load = [tex, &source_path](int& w, int& h,
+                                           std::vector<unsigned char>& rgba) {
+                bool loaded = false;
+                if (tex->content.size > 0 && tex->content.data) {
+                    int comp = 0;
+                    unsigned char* px = stbi_load_from_memory(
+                        (const unsigned char*)tex->content.data,
+                        (int)tex->content.size, &w, &h, &comp, 4);
+                    if (px && w > 0 && h > 0) {
+                        rgba.assign(px, px + (size_t)w * h * 4);
+                        loaded = true;
+                    }
+                    if (px) stbi_image_free(px);
+                }
+                if (!loaded && tex->filename.data &&
+                    tex->filename.length > 0)
+                    loaded = loadImageFileRgba(tex->filename.data,
+                                               w, h, rgba);
+                if (!loaded && tex->absolute_filename.data &&
+                    tex->absolute_filename.length > 0)
+                    loaded = loadImageFileRgba(tex->absolute_filename.data,
+                                               w, h, rgba);
+                if (!loaded && tex->relative_filename.data &&
+                    tex->relative_filename.length > 0) {
+                    const fs::path p =
+                        fs::path(source_path).parent_path() /
+                        fs::path(tex->relative_filename.data);
+                    loaded = loadImageFileRgba(p.string(), w, h, rgba);
+                }
+                if (!loaded) {
+                    std::cout << std::string("[bake] fbx texture '") +
+                                 (tex->filename.data ? tex->filename.data
+                                                     : "?") +
+                                 "' -> FAILED\n";
+                }
+                return loaded;
+            };
             tex_cache.emplace(tex, rel);
+            tex_jobs.push_back(std::move(job));
             return rel;
         };
 
         size_t total = 0;
         for (size_t i = 0; i < scene->nodes.count; ++i)
             if (scene->nodes.data[i]->mesh) ++total;
+        // Built serially (ufbx access, name allocation), written in
+        // parallel once every node's geometry and textures are known.
+        struct FbxNodeGeo {
+            std::string                name;
+            std::string                rel;
+            int                        ordinal = 0;
+            ModelPreviewData           d;
+            std::vector<GeoSectionOut> secs;
+            glm::mat4                  node_world = glm::mat4(1.0f);
+            glm::vec3                  bmn = glm::vec3(0.0f);
+            glm::vec3                  bmx = glm::vec3(0.0f);
+        };
+        std::vector<FbxNodeGeo> node_geo;
+        node_geo.reserve(total);
         int k = 0;
         for (size_t i = 0; i < scene->nodes.count; ++i) {
             const ufbx_node* node = scene->nodes.data[i];
@@ -3357,17 +3851,40 @@ bool bakeModelToRenderReady(
             // its own file exactly as before — only the allocator is
             // shared, and for names without the _lodtile_ tail it makes
             // the same name the old geo_rel_for did.
-            const std::string geo_rel = geo_rel_new(name);
-            if (writeRwGeo((fs::path(group_dir) / geo_rel).string(),
-                           d, secs, node_world, nullptr)) {
-                out_objects.push_back({ name, geo_rel, bmn, bmx });
-                ordinal_rel.push_back({ k, geo_rel, 0 });
-            } else {
-                out_objects.push_back({ name, std::string(), bmn, bmx });
-            }
+            FbxNodeGeo ng;
+            ng.name = name;
+            ng.rel = geo_rel_new(name);
+            ng.ordinal = k;
+            ng.d = std::move(d);
+            ng.secs = std::move(secs);
+            ng.node_world = node_world;
+            ng.bmn = bmn;
+            ng.bmx = bmx;
+            node_geo.push_back(std::move(ng));
             ++k;
             if (progress) progress((size_t)k, total);
         }
+
+        const std::unordered_set<std::string> tex_failed = bake_textures();
+        std::vector<GeoBakeJob> geo_jobs(node_geo.size());
+        for (size_t n = 0; n < node_geo.size(); ++n) {
+            drop_textures(node_geo[n].secs, tex_failed);
+            geo_jobs[n].rel = node_geo[n].rel;
+            geo_jobs[n].d = &node_geo[n].d;
+            geo_jobs[n].sections = &node_geo[n].secs;
+            geo_jobs[n].node_to_world = node_geo[n].node_world;
+        }
+        bake_geometry(geo_jobs);
+        for (size_t n = 0; n < node_geo.size(); ++n) {
+            const FbxNodeGeo& ng = node_geo[n];
+            if (geo_jobs[n].ok) {
+                out_objects.push_back({ ng.name, ng.rel, ng.bmn, ng.bmx });
+                ordinal_rel.push_back({ ng.ordinal, ng.rel, 0 });
+            } else {
+                out_objects.push_back(
+                    { ng.name, std::string(), ng.bmn, ng.bmx });
+            }
+        }
         // Written here too even though the FBX path does not dedup: a
         // node whose geometry failed to write has no file, so the
         // prefix-is-the-ordinal assumption is not safe here either.
@@ -3392,8 +3909,10 @@ bool bakeModelToRenderReady(
                     : ("node " + std::to_string(i));
                 hier[i].mesh_ordinal = node->mesh ? mk++ : -1;
             }
-            writeRwHier(
-                (fs::path(group_dir) / "hierarchy.rwhier").string(), hier);
+            writeAtomically(group / "hierarchy.rwhier",
+                            [&](const std::string& p) {
+                return writeRwHier(p, hier);
+            });
         }
 
         // ── Animation: bake every FBX anim stack → animation.rwanim ─────
@@ -3458,29 +3977,22 @@ bool bakeModelToRenderReady(
                     clips.push_back(std::move(clip));
             }
             if (!clips.empty()) {
-                writeRwAnim(
-                    (fs::path(group_dir) / "animation.rwanim").string(),
-                    clips);
+                writeAtomically(group / "animation.rwanim",
+                                [&](const std::string& p) {
+                    return writeRwAnim(p, clips);
+                });
                 std::cout << "[bake] baked " << clips.size()
                           << " animation clip(s)" << std::endl;
             }
         }
 
         // Character manifest — see the glTF branch.
-        if (scene->skin_deformers.count > 0) {
-            const std::string leaf = fs::path(group_dir).filename().string();
-            std::ofstream mf(
-                (fs::path(group_dir) / (leaf + ".rwchar")).string(),
-                std::ios::trunc);
-            if (mf)
-                mf << "rwchar=1\nname=" << leaf
-                   << "\nhierarchy=hierarchy.rwhier"
-                   << "\nanimation=animation.rwanim\n";
-        }
+        if (scene->skin_deformers.count > 0) write_rwchar();
         ufbx_free_scene(scene);
     } else {
         return false;
     }
+    finishBake(group, old_manifest, fresh_manifest);
 
     std::cout << "[bake] '" << source_path << "' -> " << out_objects.size()
               << " render-ready object(s) in '" << group_dir << "'"
@@ -3488,6 +4000,8 @@ bool bakeModelToRenderReady(
     return !out_objects.empty();
 }
 
+const char* renderReadyBakeVersion() { return kBakeVersion; }
+
 bool readRwObjBounds(const std::string& rwobj_path,
                      glm::vec3& out_min, glm::vec3& out_max) {
     std::ifstream in(rwobj_path);
@@ -3518,6 +4032,47 @@ uint64_t stableAssetHash(const std::string& s) {
     return h;
 }
 
+uint64_t stableContentHash(const void* data, size_t size, uint64_t seed) {
+    // Eight bytes per step: xor in, rotate so high bits reach the low
+    // ones, multiply to spread them back up.  Words are read with memcpy
+    // as little-endian, which every target platform is.  Finished with
+    // the murmur3 fmix64 avalanche so nearby inputs land far apart.
+    constexpr uint64_t kMul = 0x9e3779b97f4a7c15ull;
+    const auto* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed ^ (14695981039346656037ull + (uint64_t)size * kMul);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        h ^= w;
+        h = ((h << 27) | (h >> 37)) * kMul;
+    }
+    for (; i < size; ++i) {
+        h ^= (uint64_t)p[i];
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+bool stableFileHash(const std::string& path, uint64_t& out_hash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::vector<char> buf(4u << 20);
+    uint64_t h = 0;
+    while (in) {
+        in.read(buf.data(), (std::streamsize)buf.size());
+        const std::streamsize n = in.gcount();
+        if (n <= 0) break;
+        h = stableContentHash(buf.data(), (size_t)n, h);
+    }
+    if (in.bad()) return false;
+    out_hash = h;
+    return true;
+}
+
 std::string makeAssetId(const std::string& type,
                         const std::string& canonical_path,
                         const std::string& name) {
@@ -22,6 +22,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_precision.hpp>   // glm::u16vec4 (skin joint indices)
 
+#include "helper/cluster_dag.h"         // ClusterDag (v8 .rwgeo)
+
 namespace engine {
 namespace helper {
 
@@ -97,6 +99,14 @@ struct ModelPreviewData {
     // detail in every LOD slot).  A (0, 0) range means the level lost
     // that section entirely; consumers reuse the previous level's range.
     std::vector<std::vector<glm::uvec2>> lod_ranges;
+
+    // ── Continuous-LOD cluster DAG (v8 .rwgeo, non-skinned only) ──────
+    // As loaded: clusters only — each cluster's first_index points into
+    // `indices`, and the DAG's simplified vertices / indices are appended
+    // to the blobs like the LOD levels, so positions / normals / uvs /
+    // indices inside cluster_dag stay empty.  Spheres and errors are in
+    // the same space as `positions`.  Empty for files baked before v8.
+    ClusterDag cluster_dag;
 };
 
 // CPU-only preview load (Debug Display): fills world-space triangles +
@@ -226,6 +236,11 @@ bool readRwObjBounds(const std::string& rwobj_path,
 // Returns the baked objects in sub-object enumeration order (the same order
 // listModelSubObjects produces).  `log` (optional) receives one line per
 // bake step — useful in the import log.
+//
+// The bake is incremental: <group_dir>/bake.manifest records a content
+// key per output file, and an output whose inputs hash to the recorded
+// key is kept as it is.  Textures and objects that do need baking are
+// spread over every core, and each file is written atomically.
 struct BakedObject {
     std::string name;        // display name (mesh node)
     std::string rwgeo_rel;   // path relative to group_dir, e.g. "objects/000_Wall.rwgeo"
@@ -242,6 +257,10 @@ bool bakeModelToRenderReady(
     std::vector<BakedObject>& out_objects,
     const std::function<void(size_t, size_t)>& progress = {});
 
+// Identifies what the bake writers emit for a given input; changes
+// whenever they do.  Importers record it to know a group is still current.
+const char* renderReadyBakeVersion();
+
 // Read one baked object (geometry + material + its .rwtex texture) back
 // into preview data.  tex paths inside the .rwgeo are relative to the
 // group folder (= parent of the objects/ folder the .rwgeo lives in).
@@ -353,6 +372,15 @@ bool loadRwAnim(const std::string& path, std::vector<RwAnimClip>& out);
 // external systems (the ML search index, caches, …).
 uint64_t stableAssetHash(const std::string& s);
 
+// Deterministic 64-bit hash of a byte range, for CHANGE DETECTION on bulk
+// data (mesh slices, pixels, whole source files) where stableAssetHash's
+// byte-at-a-time loop is too slow.  Chainable: pass the previous result
+// as `seed` to extend a hash.  Not interchangeable with stableAssetHash.
+uint64_t stableContentHash(const void* data, size_t size,
+                           uint64_t seed = 0);
+// stableContentHash over a whole file, streamed.  False if unreadable.
+bool stableFileHash(const std::string& path, uint64_t& out_hash);
+
 // Canonical asset ID: hash of "type|path|name" with the path lower-cased
 // and slash-normalised.  `canonical_path` should be relative to the
 // content root so the ID is independent of where the project lives.
@@ -0,0 +1,130 @@
+#pragma once
+//
+// plan_grid.h — uniform grid over plan (x, z) positions for radius queries.
+//
+// Maps caller-owned item ids (uint32_t, usually an index into the
+// caller's record table) to square cells.  build() sizes the grid to the
+// items it is given: it spans their plan bounds with cells holding about
+// kItemsPerCell items on average, so a query visits a handful of cells
+// whatever the level's extent or prop density, and every cell is one
+// array index — no hashing, which is what dominates a sparse hash grid
+// at thousands of queries a frame.
+//
+// Items may move afterwards (move()).  Anything outside the built bounds
+// is filed in the nearest edge cell and queries clamp their cell range
+// the same way, so results stay exact; only their cost degrades if most
+// items leave the bounds, and the owner rebuilds on its next load.
+//
+// The grid keeps no positions: move takes the position the item was
+// filed at, and forEachCandidate hands out the items of every cell the
+// query's square touches for the caller to test against its own records.
+//
+// Not thread-safe; the owner's lock covers it.  Queries are const, so a
+// shared lock is enough for them.
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+namespace helper {
+
+class PlanGrid {
+public:
+    static constexpr float    kItemsPerCell = 4.0f;
+    static constexpr float    kMinCell      = 0.5f;    // metres
+    static constexpr uint32_t kMaxCellsAxis = 4096;
+
+    void clear() {
+        cells_.clear();
+        nx_ = nz_ = 0;
+    }
+    bool empty() const { return cells_.empty(); }
+    float cellSize() const { return cell_; }
+    uint32_t cellsX() const { return nx_; }
+    uint32_t cellsZ() const { return nz_; }
+
+    // Files items 0 .. count-1; pos(i, x, z) writes item i's position.
+    template <typename PosFn>
+    void build(uint32_t count, PosFn&& pos) {
+        clear();
+        if (count == 0) return;
+        float x0 = INFINITY, z0 = INFINITY, x1 = -INFINITY, z1 = -INFINITY;
+        for (uint32_t i = 0; i < count; ++i) {
+            float x, z;
+            pos(i, x, z);
+            if (!std::isfinite(x) || !std::isfinite(z)) continue;
+            x0 = std::min(x0, x); x1 = std::max(x1, x);
+            z0 = std::min(z0, z); z1 = std::max(z1, z);
+        }
+        if (!(x0 <= x1)) { x0 = x1 = z0 = z1 = 0.0f; }
+        const float w = std::max(x1 - x0, kMinCell);
+        const float h = std::max(z1 - z0, kMinCell);
+        cell_ = std::max(kMinCell,
+                         std::sqrt(w * h * kItemsPerCell / float(count)));
+        cell_ = std::max({ cell_, w / kMaxCellsAxis, h / kMaxCellsAxis });
+        inv_cell_ = 1.0f / cell_;
+        x0_ = x0;
+        z0_ = z0;
+        nx_ = std::min(uint32_t(w * inv_cell_) + 1, kMaxCellsAxis);
+        nz_ = std::min(uint32_t(h * inv_cell_) + 1, kMaxCellsAxis);
+        cells_.resize(size_t(nx_) * nz_);
+        for (uint32_t i = 0; i < count; ++i) {
+            float x, z;
+            pos(i, x, z);
+            cells_[index(x, z)].push_back(i);
+        }
+    }
+
+    // Re-files `item` from (ox, oz) to (nx, nz); nothing to do while it
+    // stays inside its cell, which is most moves.
+    void move(uint32_t item, float ox, float oz, float nx, float nz) {
+        if (cells_.empty()) return;
+        const size_t from = index(ox, oz), to = index(nx, nz);
+        if (from == to) return;
+        auto& v = cells_[from];
+        const auto at = std::find(v.begin(), v.end(), item);
+        if (at != v.end()) {
+            *at = v.back();              // order within a cell is free
+            v.pop_back();
+        }
+        cells_[to].push_back(item);
+    }
+
+    // fn(item) for every item whose cell overlaps the square bounding
+    // the circle (x, z, radius) — a superset of the items inside it.
+    template <typename Fn>
+    void forEachCandidate(float x, float z, float radius, Fn&& fn) const {
+        if (cells_.empty() || !(radius >= 0.0f)) return;
+        const uint32_t cx0 = column(x - radius, x0_, nx_);
+        const uint32_t cx1 = column(x + radius, x0_, nx_);
+        const uint32_t cz0 = column(z - radius, z0_, nz_);
+        const uint32_t cz1 = column(z + radius, z0_, nz_);
+        for (uint32_t cz = cz0; cz <= cz1; ++cz) {
+            const auto* row = &cells_[size_t(cz) * nx_];
+            for (uint32_t cx = cx0; cx <= cx1; ++cx) {
+                for (uint32_t item : row[cx]) fn(item);
+            }
+        }
+    }
+
+private:
+    // Cell column of v, clamped to the grid (NaN lands in column 0).
+    uint32_t column(float v, float origin, uint32_t n) const {
+        const float c = (v - origin) * inv_cell_;
+        if (!(c > 0.0f)) return 0;
+        return c >= float(n - 1) ? n - 1 : uint32_t(c);
+    }
+    size_t index(float x, float z) const {
+        return size_t(column(z, z0_, nz_)) * nx_ + column(x, x0_, nx_);
+    }
+
+    float    cell_ = 1.0f, inv_cell_ = 1.0f;
+    float    x0_ = 0.0f, z0_ = 0.0f;
+    uint32_t nx_ = 0, nz_ = 0;
+    std::vector<std::vector<uint32_t>> cells_;   // row-major, z rows
+};
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,294 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// cluster_dag_tests.cpp — standalone unit tests for the continuous-LOD
+// cluster DAG (helper/cluster_dag.*).
+//
+// Pure CPU: builds the DAG of a closed icosphere and checks level 0 is the
+// source, every level has fewer triangles, errors and spheres only grow
+// towards the roots, and the build is the same serial and on a pool.  Then
+// selects cuts from near to far and checks each is a closed, consistently
+// wound surface (no cracks between levels), that the triangle count falls
+// with distance and rises with resolution, and that sections stay apart.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. helper/tests/cluster_dag_tests.cpp
+//       helper/cluster_dag.cpp helper/cluster_mesh.cpp helper/mesh_tool.cpp
+//       helper/thread_pool.cpp -lOpenMeshCore -lOpenMeshTools
+//       -lpthread -o cluster_dag_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "helper/cluster_dag.h"
+#include "helper/mesh_tool.h"
+#include "helper/thread_pool.h"
+
+using namespace engine::helper;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+// Closed, welded icosphere: 20 * 4^subdiv triangles.
+static Mesh makeIcosphere(uint32_t subdiv, float radius) {
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    std::vector<glm::vec3> p = {
+        {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+        {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+        {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1} };
+    std::vector<Face> f = {
+        {0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
+        {1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+        {3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
+        {4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1} };
+    for (auto& v : p) v = glm::normalize(v);
+    for (uint32_t s = 0; s < subdiv; ++s) {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> mid;
+        auto midpoint = [&](uint32_t a, uint32_t b) {
+            const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = mid.find(key);
+            if (it != mid.end()) return it->second;
+            p.push_back(glm::normalize(p[a] + p[b]));
+            return mid[key] = static_cast<uint32_t>(p.size() - 1);
+        };
+        std::vector<Face> next;
+        for (const Face& tri : f) {
+            const uint32_t a = tri.v_indices[0], b = tri.v_indices[1],
+                           c = tri.v_indices[2];
+            const uint32_t ab = midpoint(a, b), bc = midpoint(b, c),
+                           ca = midpoint(c, a);
+            next.emplace_back(a, ab, ca);
+            next.emplace_back(b, bc, ab);
+            next.emplace_back(c, ca, bc);
+            next.emplace_back(ab, bc, ca);
+        }
+        f.swap(next);
+    }
+    Mesh m;
+    for (const auto& v : p) {
+        VertexStruct vs{};
+        vs.position = v * radius;
+        vs.normal   = v;
+        m.vertex_data_ptr->push_back(vs);
+    }
+    *m.faces_ptr = f;
+    return m;
+}
+
+static glm::vec3 dagPosition(const Mesh& m, const ClusterDag& dag, uint32_t v) {
+    return v < dag.base_vertex_count ? (*m.vertex_data_ptr)[v].position
+                                     : dag.positions[v - dag.base_vertex_count];
+}
+
+static bool sphereInside(const glm::vec4& inner, const glm::vec4& outer) {
+    return glm::length(glm::vec3(inner) - glm::vec3(outer)) + inner.w <=
+           outer.w * (1.0f + 1e-6f);
+}
+
+static void validateDag(const Mesh& m, const ClusterDag& dag) {
+    const uint32_t vertex_count =
+        dag.base_vertex_count + static_cast<uint32_t>(dag.positions.size());
+    CHECK(dag.normals.size() == dag.positions.size());
+    CHECK(dag.uvs.size() == dag.positions.size());
+    CHECK(dag.triangleCount(0) == m.getFaceCount());
+
+    uint32_t prev_level = 0;
+    for (const ClusterDagCluster& c : dag.clusters) {
+        CHECK(c.level >= prev_level);
+        prev_level = c.level;
+        CHECK(c.index_count > 0 && c.index_count % 3 == 0);
+        CHECK(c.index_count <= 124 * 3);
+        CHECK(c.first_index + c.index_count <= dag.indices.size());
+        for (uint32_t k = 0; k < c.index_count; ++k) {
+            const uint32_t v = dag.indices[c.first_index + k];
+            CHECK(v < vertex_count);
+            if (c.level == 0) CHECK(v < dag.base_vertex_count);
+            // The cull sphere bounds the cluster.
+            const glm::vec3 d = dagPosition(m, dag, v) - glm::vec3(c.bounds);
+            CHECK(glm::length(d) <= c.bounds.w * 1.0001f + 1e-5f);
+        }
+        CHECK(c.level == 0 ? c.lod_error == 0.0f : c.lod_error > 0.0f);
+        CHECK(c.lod_error <= c.parent_error);
+        if (c.parent_error < FLT_MAX) {
+            CHECK(sphereInside(c.lod_bounds, c.parent_bounds));
+        }
+    }
+    CHECK(dag.level_count == prev_level + 1);
+    for (uint32_t l = 1; l < dag.level_count; ++l) {
+        CHECK(dag.triangleCount(l) < dag.triangleCount(l - 1));
+    }
+}
+
+// Every directed edge of a closed surface has exactly one opposite twin.
+// By vertex id, not position: sealed outlines must reuse the same ids
+// across levels.
+static bool cutIsClosed(const ClusterDag& dag, const std::vector<uint32_t>& cut) {
+    std::map<std::pair<uint32_t, uint32_t>, int> edges;
+    for (uint32_t ci : cut) {
+        const ClusterDagCluster& c = dag.clusters[ci];
+        for (uint32_t k = 0; k < c.index_count; k += 3) {
+            const uint32_t* tri = &dag.indices[c.first_index + k];
+            for (int e = 0; e < 3; ++e) {
+                ++edges[{ tri[e], tri[(e + 1) % 3] }];
+            }
+        }
+    }
+    for (const auto& [e, n] : edges) {
+        if (n != 1) return false;
+        auto twin = edges.find({ e.second, e.first });
+        if (twin == edges.end() || twin->second != 1) return false;
+    }
+    return true;
+}
+
+static void testEmpty() {
+    Mesh m;
+    ClusterDag dag;
+    CHECK(!buildClusterDag(m, {}, dag));
+    CHECK(dag.empty());
+    std::vector<uint32_t> cut;
+    CHECK(selectClusterDagCut(dag, ClusterDagView{}, cut) == 0);
+    CHECK(cut.empty());
+}
+
+static void testProjection() {
+    ClusterDagView view;
+    view.camera_pos = glm::vec3(0.0f);
+    view.error_scale = 1000.0f;
+    const glm::vec4 s(0.0f, 0.0f, 10.0f, 1.0f);
+    CHECK(projectedClusterError(s, 0.0f, view) == 0.0f);
+    CHECK(projectedClusterError(s, FLT_MAX, view) == FLT_MAX);
+    CHECK(std::fabs(projectedClusterError(s, 0.01f, view) - 10.0f / 9.0f) < 1e-4f);
+    CHECK(projectedClusterError(glm::vec4(0.0f, 0.0f, 0.5f, 1.0f), 0.01f, view) ==
+          FLT_MAX);
+}
+
+static void testBuildAndCuts() {
+    const Mesh m = makeIcosphere(6, 1.0f);            // 81920 triangles
+    ThreadPool pool(4);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    ClusterDag dag;
+    CHECK(buildClusterDag(m, {}, dag, {}, &pool));
+    const double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    validateDag(m, dag);
+    CHECK(dag.level_count >= 5);
+
+    ClusterDag serial;
+    CHECK(buildClusterDag(m, {}, serial));
+    CHECK(serial.indices == dag.indices);
+    CHECK(serial.clusters.size() == dag.clusters.size());
+    CHECK(serial.positions.size() == dag.positions.size());
+
+    uint32_t root_tris = 0;
+    for (const ClusterDagCluster& c : dag.clusters) {
+        if (c.parent_error == FLT_MAX) root_tris += c.index_count / 3;
+    }
+
+    // 1080p, 60 degree vertical fov, 1 px.
+    ClusterDagView view;
+    view.error_scale = 1080.0f / (2.0f * std::tan(0.5f * 1.0471976f));
+    view.threshold_px = 1.0f;
+
+    std::vector<uint32_t> cut;
+    uint32_t prev = UINT32_MAX;
+    std::printf("  icosphere %zu tris, %u levels, %u groups, %.1f ms:",
+                m.getFaceCount(), dag.level_count, dag.group_count, ms);
+    for (float dist : { 1.001f, 1.5f, 3.0f, 10.0f, 40.0f, 200.0f, 1e6f }) {
+        view.camera_pos = glm::vec3(0.0f, 0.3f, dist);
+        const uint32_t tris = selectClusterDagCut(dag, view, cut);
+        CHECK(!cut.empty());
+        CHECK(std::is_sorted(cut.begin(), cut.end()));
+        CHECK(cutIsClosed(dag, cut));
+        CHECK(tris <= prev);
+        prev = tris;
+        std::printf(" %g:%u", dist, tris);
+
+        // Twice the resolution never draws less.
+        ClusterDagView hi = view;
+        hi.error_scale *= 2.0f;
+        std::vector<uint32_t> hi_cut;
+        CHECK(selectClusterDagCut(dag, hi, hi_cut) >= tris);
+        CHECK(cutIsClosed(dag, hi_cut));
+    }
+    std::printf("\n");
+    CHECK(prev == root_tris);
+
+    // Camera on the surface: full detail where it stands.
+    view.camera_pos = glm::vec3(0.0f, 0.0f, 1.0f);
+    selectClusterDagCut(dag, view, cut);
+    bool has_level0 = false;
+    for (uint32_t c : cut) has_level0 |= dag.clusters[c].level == 0;
+    CHECK(has_level0);
+    CHECK(cutIsClosed(dag, cut));
+}
+
+static void testSections() {
+    const Mesh m = makeIcosphere(5, 2.0f);
+    std::vector<int32_t> sections(m.getFaceCount());
+    const auto& v = *m.vertex_data_ptr;
+    for (size_t f = 0; f < sections.size(); ++f) {
+        const Face& face = (*m.faces_ptr)[f];
+        const float y = v[face.v_indices[0]].position.y +
+                        v[face.v_indices[1]].position.y +
+                        v[face.v_indices[2]].position.y;
+        sections[f] = y > 0.0f ? 1 : 0;
+    }
+    ClusterDag dag;
+    CHECK(buildClusterDag(m, sections, dag));
+    validateDag(m, dag);
+
+    // Level-0 clusters keep their faces' section.
+    std::map<std::vector<uint32_t>, int32_t> section_of;
+    for (size_t f = 0; f < sections.size(); ++f) {
+        std::vector<uint32_t> key((*m.faces_ptr)[f].v_indices,
+                                  (*m.faces_ptr)[f].v_indices + 3);
+        std::sort(key.begin(), key.end());
+        section_of[key] = sections[f];
+    }
+    for (const ClusterDagCluster& c : dag.clusters) {
+        if (c.level != 0) continue;
+        for (uint32_t k = 0; k < c.index_count; k += 3) {
+            std::vector<uint32_t> key(dag.indices.begin() + c.first_index + k,
+                                      dag.indices.begin() + c.first_index + k + 3);
+            std::sort(key.begin(), key.end());
+            CHECK(section_of[key] == static_cast<int32_t>(c.section));
+        }
+    }
+
+    ClusterDagView view;
+    view.error_scale = 500.0f;
+    std::vector<uint32_t> cut;
+    for (float dist : { 2.5f, 8.0f, 60.0f }) {
+        view.camera_pos = glm::vec3(dist, 0.0f, 0.0f);
+        selectClusterDagCut(dag, view, cut);
+        CHECK(cutIsClosed(dag, cut));
+        bool s0 = false, s1 = false;
+        for (uint32_t c : cut) {
+            s0 |= dag.clusters[c].section == 0;
+            s1 |= dag.clusters[c].section == 1;
+        }
+        CHECK(s0 && s1);
+    }
+}
+
+int main() {
+    testEmpty();
+    testProjection();
+    testBuildAndCuts();
+    testSections();
+    std::printf("cluster_dag_tests: %d checks passed\n", g_checks);
+    return 0;
+}
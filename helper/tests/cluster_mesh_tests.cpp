@@ -0,0 +1,289 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// cluster_mesh_tests.cpp — standalone unit tests for the cluster / meshlet
+// builders (helper/cluster_mesh.*).
+//
+// Pure CPU: checks the spatial meshlet builder covers every usable face
+// exactly once within the vertex / triangle caps, keeps clusters inside
+// their face range, lists vertices in first use, produces spheres and cones
+// that really bound their cluster, and is deterministic serial vs batched.
+// Then reports cull efficiency and build throughput against the greedy BFS
+// builder on a tessellated sphere and on a scatter of disconnected cards.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. helper/tests/cluster_mesh_tests.cpp
+//       helper/cluster_mesh.cpp helper/thread_pool.cpp
+//       -lpthread -o cluster_mesh_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "helper/cluster_mesh.h"
+#include "helper/thread_pool.h"
+
+using namespace engine::helper;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static void addVertex(Mesh& m, const glm::vec3& p) {
+    VertexStruct v{};
+    v.position = p;
+    v.normal   = p;
+    m.vertex_data_ptr->push_back(v);
+}
+
+// UV sphere, `rings` x `segments` quads, shared vertices.
+static Mesh makeSphere(uint32_t rings, uint32_t segments, float radius) {
+    Mesh m;
+    for (uint32_t r = 0; r <= rings; ++r) {
+        const float th = 3.14159265f * r / rings;
+        for (uint32_t s = 0; s <= segments; ++s) {
+            const float ph = 6.28318531f * s / segments;
+            addVertex(m, radius * glm::vec3(std::sin(th) * std::cos(ph),
+                                             std::cos(th),
+                                             std::sin(th) * std::sin(ph)));
+        }
+    }
+    auto& f = *m.faces_ptr;
+    for (uint32_t r = 0; r < rings; ++r) {
+        for (uint32_t s = 0; s < segments; ++s) {
+            const uint32_t a = r * (segments + 1) + s;
+            const uint32_t b = a + segments + 1;
+            f.emplace_back(a, a + 1, b);
+            f.emplace_back(a + 1, b + 1, b);
+        }
+    }
+    return m;
+}
+
+// Disconnected two-triangle cards scattered through a box (foliage-like):
+// no shared edges at all, so only the spatial builder can group them well.
+static Mesh makeCards(uint32_t n, uint32_t seed) {
+    Mesh m;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> ang(0.0f, 6.2831853f);
+    for (uint32_t i = 0; i < n; ++i) {
+        const glm::vec3 c(pos(rng), pos(rng) * 0.25f, pos(rng));
+        const float a = ang(rng);
+        const glm::vec3 u(std::cos(a) * 0.3f, 0.0f, std::sin(a) * 0.3f);
+        const glm::vec3 v(0.0f, 0.4f, 0.0f);
+        const uint32_t b = static_cast<uint32_t>(m.vertex_data_ptr->size());
+        addVertex(m, c - u);
+        addVertex(m, c + u);
+        addVertex(m, c + u + v);
+        addVertex(m, c - u + v);
+        m.faces_ptr->emplace_back(b, b + 1, b + 2);
+        m.faces_ptr->emplace_back(b, b + 2, b + 3);
+    }
+    return m;
+}
+
+static glm::vec3 unitNormal(const Mesh& m, uint32_t f) {
+    const Face& face = (*m.faces_ptr)[f];
+    const auto& v = *m.vertex_data_ptr;
+    const glm::vec3 n = glm::cross(v[face.v_indices[1]].position - v[face.v_indices[0]].position,
+                                   v[face.v_indices[2]].position - v[face.v_indices[0]].position);
+    const float l = glm::length(n);
+    return l > 1e-10f ? n / l : glm::vec3(0.0f);
+}
+
+// Structural + bounds checks shared by every spatial build.
+static void validateSpatial(const Mesh& m, const ClusterMesh& cm,
+                            const std::vector<uint32_t>& range_starts) {
+    const auto& faces = *m.faces_ptr;
+    const auto& verts = *m.vertex_data_ptr;
+    std::vector<uint32_t> seen(faces.size(), 0);
+    auto rangeOf = [&](uint32_t f) {
+        return std::upper_bound(range_starts.begin(), range_starts.end(), f) -
+               range_starts.begin();
+    };
+    for (const MeshletCluster& cl : cm.clusters) {
+        CHECK(!cl.face_indices.empty());
+        CHECK(cl.triangleCount() <= cm.max_triangles_per_cluster_setting);
+        CHECK(cl.vertexCount() <= cm.max_vertices_per_cluster_setting);
+
+        std::vector<uint32_t> first_use;
+        for (uint32_t f : cl.face_indices) {
+            ++seen[f];
+            CHECK(rangeOf(f) == rangeOf(cl.face_indices[0]));
+            for (uint32_t v : faces[f].v_indices) {
+                if (std::find(first_use.begin(), first_use.end(), v) == first_use.end())
+                    first_use.push_back(v);
+            }
+        }
+        CHECK(first_use == cl.vertex_indices);
+
+        for (uint32_t v : cl.vertex_indices) {
+            const glm::vec3& p = verts[v].position;
+            CHECK(glm::length(p - cl.bounds_center) <= cl.bounds_radius * 1.0001f + 1e-5f);
+            CHECK(p.x >= cl.aabb_min.x && p.y >= cl.aabb_min.y && p.z >= cl.aabb_min.z);
+            CHECK(p.x <= cl.aabb_max.x && p.y <= cl.aabb_max.y && p.z <= cl.aabb_max.z);
+        }
+        if (cl.cone_cutoff >= 0.0f) {
+            CHECK(std::fabs(glm::length(cl.cone_axis) - 1.0f) < 1e-4f);
+            const float cos_t = std::sqrt(1.0f - cl.cone_cutoff * cl.cone_cutoff);
+            for (uint32_t f : cl.face_indices) {
+                const glm::vec3 n = unitNormal(m, f);
+                if (glm::length(n) > 0.0f) CHECK(glm::dot(n, cl.cone_axis) >= cos_t - 1e-4f);
+            }
+        }
+    }
+    for (uint32_t f = 0; f < faces.size(); ++f) {
+        const Face& face = faces[f];
+        const bool usable = !face.isDegenerate() &&
+                            face.v_indices[0] < verts.size() &&
+                            face.v_indices[1] < verts.size() &&
+                            face.v_indices[2] < verts.size();
+        CHECK(seen[f] == (usable ? 1u : 0u));
+    }
+}
+
+static void testEmptyAndDegenerate() {
+    Mesh empty;
+    ClusterMesh cm;
+    buildClusterMesh(empty, cm, ClusterBuildOptions{});
+    CHECK(cm.empty());
+    CHECK(cm.cluster_bvh_root == nullptr);
+
+    Mesh bad = makeSphere(4, 8, 1.0f);
+    bad.faces_ptr->emplace_back(0, 0, 1);            // degenerate
+    bad.faces_ptr->emplace_back(0, 1, 999999);       // index out of range
+    buildClusterMesh(bad, cm, ClusterBuildOptions{});
+    CHECK(cm.total_triangles == 64);
+    validateSpatial(bad, cm, {});
+    CHECK(computeClusterCullStats(cm).clusters == cm.total_clusters);
+
+    // A single triangle: one cluster, exact sphere (circumscribed on the
+    // longest edge of a right triangle), tight cone.
+    Mesh tri;
+    addVertex(tri, glm::vec3(0.0f, 0.0f, 0.0f));
+    addVertex(tri, glm::vec3(2.0f, 0.0f, 0.0f));
+    addVertex(tri, glm::vec3(0.0f, 2.0f, 0.0f));
+    tri.faces_ptr->emplace_back(0, 1, 2);
+    buildClusterMesh(tri, cm, ClusterBuildOptions{});
+    CHECK(cm.clusters.size() == 1);
+    CHECK(std::fabs(cm.clusters[0].bounds_radius - std::sqrt(2.0f)) < 1e-4f);
+    CHECK(std::fabs(cm.clusters[0].cone_cutoff) < 1e-4f);
+    CHECK(cm.clusters[0].cone_axis.z > 0.999f);
+}
+
+static void testRangesAndDeterminism() {
+    Mesh m = makeSphere(48, 96, 3.0f);
+    const uint32_t nf = static_cast<uint32_t>(m.getFaceCount());
+    ClusterBuildOptions opt;
+    opt.range_starts = { 0, 1000, 1003, nf / 2, nf };   // incl. tiny + empty tail
+    ClusterMesh a, b;
+    buildClusterMesh(m, a, opt);
+    validateSpatial(m, a, opt.range_starts);
+    buildClusterMesh(m, b, opt);
+    CHECK(a.clusters.size() == b.clusters.size());
+    for (size_t i = 0; i < a.clusters.size(); ++i) {
+        CHECK(a.clusters[i].face_indices == b.clusters[i].face_indices);
+    }
+    CHECK(a.cluster_bvh_root != nullptr);
+
+    // Smaller caps are honoured too.
+    opt.max_triangles = 32;
+    opt.max_vertices  = 24;
+    buildClusterMesh(m, b, opt);
+    validateSpatial(m, b, opt.range_starts);
+    CHECK(b.max_vertices_per_cluster_setting == 24);
+}
+
+static void testBatch() {
+    std::vector<Mesh> meshes;
+    for (uint32_t i = 0; i < 9; ++i) meshes.push_back(makeSphere(8 + i * 6, 16 + i * 12, 1.0f + i));
+    meshes.push_back(makeCards(3000, 5));
+    std::vector<ClusterMesh> serial(meshes.size()), batched(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        buildClusterMesh(meshes[i], serial[i], ClusterBuildOptions{});
+    }
+
+    std::vector<ClusterBuildJob> jobs(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        jobs[i].mesh = &meshes[i];
+        jobs[i].out  = &batched[i];
+    }
+    ThreadPool pool(4);
+    buildClusterMeshes(jobs, &pool);
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        CHECK(batched[i].clusters.size() == serial[i].clusters.size());
+        for (size_t c = 0; c < serial[i].clusters.size(); ++c) {
+            CHECK(batched[i].clusters[c].face_indices == serial[i].clusters[c].face_indices);
+        }
+    }
+    // Null pool runs serially.
+    std::vector<ClusterMesh> again(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) jobs[i].out = &again[i];
+    buildClusterMeshes(jobs, nullptr);
+    CHECK(again.back().total_triangles == 6000);
+}
+
+static void compare(const char* name, const Mesh& m, bool connected) {
+    auto timed = [&](ClusterMesh& cm, bool spatial) {
+        const auto t0 = std::chrono::steady_clock::now();
+        if (spatial) buildClusterMesh(m, cm, ClusterBuildOptions{});
+        else         buildClusterMesh(m, cm, 128);
+        return std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+    };
+    ClusterMesh bfs, mlt;
+    const double ms_bfs = timed(bfs, false);
+    const double ms_mlt = timed(mlt, true);
+    validateSpatial(m, mlt, {});
+    const ClusterCullStats sb = computeClusterCullStats(bfs);
+    const ClusterCullStats sm = computeClusterCullStats(mlt);
+
+    // On a connected surface the meshlets are tighter on every axis the
+    // culling passes use.  On disconnected cards BFS can only make one
+    // cluster per card (flat, trivially tight, but 2 triangles a draw);
+    // the meshlets must group them instead.
+    if (connected) {
+        CHECK(sm.sphere_to_box_ratio < sb.sphere_to_box_ratio);
+        CHECK(sm.backface_cull_rate > sb.backface_cull_rate);
+    } else {
+        CHECK(sm.clusters * 8 < sb.clusters);
+    }
+    CHECK(connected ? sm.acmr < sb.acmr : sm.acmr <= sb.acmr);
+
+    const double mtris = m.getFaceCount() / 1000.0;
+    std::printf("  %s, %u tris:\n", name, static_cast<uint32_t>(m.getFaceCount()));
+    for (const auto& [label, st, ms] : { std::tuple{ "bfs    ", sb, ms_bfs },
+                                         std::tuple{ "meshlet", sm, ms_mlt } }) {
+        std::printf("    %s %5u clusters, %5.1f tris %5.1f verts, cullable %4.1f%%, "
+                    "cone cull %4.1f%% (avg %4.1f deg), sphere/box %.3f, "
+                    "ACMR %.3f, %6.1f ms (%.2f Mtri/s)\n",
+                    label, st.clusters, st.avg_triangles, st.avg_vertices,
+                    100.0f * st.cullable_fraction, 100.0f * st.backface_cull_rate,
+                    st.avg_cone_angle_deg, st.sphere_to_box_ratio, st.acmr,
+                    ms, mtris / std::max(ms, 1e-3));
+    }
+}
+
+static void testQualityAgainstBfs() {
+    compare("sphere", makeSphere(256, 512, 10.0f), true);
+    compare("cards", makeCards(40000, 3), false);
+}
+
+int main() {
+    testEmptyAndDegenerate();
+    testRangesAndDeterminism();
+    testBatch();
+    testQualityAgainstBfs();
+    std::printf("cluster_mesh_tests: %d checks passed\n", g_checks);
+    return 0;
+}
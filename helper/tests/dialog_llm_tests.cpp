@@ -0,0 +1,332 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// dialog_llm_tests.cpp — standalone tests for DialogLlm's streamed chat turns
+// (helper/dialog_llm.*) against an in-process mock Ollama daemon.
+//
+// The mock resolves a "jinyong" tag from GET /api/tags and answers POST
+// /api/chat as a chunked NDJSON stream, one token per chunk with a pause
+// between them, the way a real model generates.  Checks that reply() grows
+// while busy() — every snapshot a prefix of the final text — that the first
+// sentence is ready for the voice (via audio/sentence_segmenter) well before
+// the reply ends, that turn() marks each new reply and history rides along
+// on the next request, and that a stream cut mid-reply keeps what arrived.
+//
+// POSIX only (the mock server); the client under test is portable.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. -I<json-dir> helper/tests/dialog_llm_tests.cpp
+//       helper/dialog_llm.cpp helper/http_client.cpp
+//       audio/sentence_segmenter.cpp -lpthread -o dialog_llm_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "json.hpp"
+
+#include "audio/sentence_segmenter.h"
+#include "helper/dialog_llm.h"
+
+using namespace engine::helper;
+using Clock = std::chrono::steady_clock;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static const char* kTokens[] = {
+    "Greetings", ", traveller", ".", " The road", " north", " is",
+    " closed", "!", " Take", " the", " river", " path", "."};
+static const char* kReply =
+    "Greetings, traveller. The road north is closed! Take the river path.";
+
+// ── Mock Ollama ──────────────────────────────────────────────────────────────
+class MockOllama {
+public:
+    std::atomic<int> token_ms{40};
+    std::atomic<int> cut_after{-1};   // drop the connection after N tokens
+    std::mutex       mu;
+    std::string      last_request;    // guarded by mu
+
+    MockOllama() {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in a{};
+        a.sin_family = AF_INET;
+        a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        CHECK(::bind(listen_fd_, reinterpret_cast<sockaddr*>(&a),
+                     sizeof(a)) == 0);
+        CHECK(::listen(listen_fd_, 8) == 0);
+        socklen_t len = sizeof(a);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&a), &len);
+        port_ = ntohs(a.sin_port);
+        acceptor_ = std::thread([this] { acceptLoop(); });
+    }
+    ~MockOllama() {
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        ::close(listen_fd_);
+        acceptor_.join();
+        {
+            std::lock_guard<std::mutex> lk(fds_mu_);
+            for (int fd : fds_) ::shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& t : conns_) t.join();
+    }
+    std::string host() const { return "127.0.0.1:" + std::to_string(port_); }
+
+private:
+    void acceptLoop() {
+        for (;;) {
+            const int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) return;
+            std::lock_guard<std::mutex> lk(fds_mu_);
+            fds_.push_back(fd);
+            conns_.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    static bool sendAll(int fd, const std::string& s) {
+        size_t off = 0;
+        while (off < s.size()) {
+            const ssize_t n = ::send(fd, s.data() + off, s.size() - off,
+                                     MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            off += size_t(n);
+        }
+        return true;
+    }
+
+    static std::string chunk(const std::string& line) {
+        char size[32];
+        std::snprintf(size, sizeof(size), "%zx\r\n", line.size());
+        return size + line + "\r\n";
+    }
+
+    void serve(int fd) {
+        std::string buf;
+        char tmp[4096];
+        for (;;) {
+            size_t head_end;
+            while ((head_end = buf.find("\r\n\r\n")) == std::string::npos) {
+                const ssize_t n = ::recv(fd, tmp, sizeof(tmp), 0);
+                if (n <= 0) {
+                    ::close(fd);
+                    return;
+                }
+                buf.append(tmp, size_t(n));
+            }
+            const std::string head = buf.substr(0, head_end);
+            size_t length = 0;
+            const size_t cl = head.find("Content-Length: ");
+            if (cl != std::string::npos)
+                length = std::strtoull(head.c_str() + cl + 16, nullptr, 10);
+            while (buf.size() < head_end + 4 + length) {
+                const ssize_t n = ::recv(fd, tmp, sizeof(tmp), 0);
+                if (n <= 0) {
+                    ::close(fd);
+                    return;
+                }
+                buf.append(tmp, size_t(n));
+            }
+            const std::string body = buf.substr(head_end + 4, length);
+            buf.erase(0, head_end + 4 + length);
+
+            bool ok;
+            if (head.rfind("GET /api/tags", 0) == 0) {
+                const std::string reply =
+                    R"({"models":[{"name":"qwen:2b"},)"
+                    R"({"name":"JinYong-mock:latest"}]})";
+                ok = sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Length: " +
+                                     std::to_string(reply.size()) +
+                                     "\r\n\r\n" + reply);
+            } else if (head.rfind("POST /api/chat", 0) == 0) {
+                ok = chat(fd, body);
+            } else {
+                ok = sendAll(fd, "HTTP/1.1 404 Not Found\r\n"
+                                 "Content-Length: 0\r\n\r\n");
+            }
+            if (!ok) {
+                ::close(fd);
+                return;
+            }
+        }
+    }
+
+    // Token by token, one chunk each, paced like generation.
+    bool chat(int fd, const std::string& body) {
+        using nlohmann::json;
+        {
+            std::lock_guard<std::mutex> lk(mu);
+            last_request = body;
+        }
+        const json req = json::parse(body);
+        if (!sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Type: "
+                         "application/x-ndjson\r\nTransfer-Encoding: "
+                         "chunked\r\n\r\n"))
+            return false;
+        const int n = int(sizeof(kTokens) / sizeof(kTokens[0]));
+        for (int i = 0; i < n; ++i) {
+            if (i == cut_after.load()) return false;
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(token_ms.load()));
+            const json frame = {
+                {"model", req["model"]},
+                {"message", {{"role", "assistant"}, {"content", kTokens[i]}}},
+                {"done", false}};
+            if (!sendAll(fd, chunk(frame.dump() + "\n"))) return false;
+        }
+        return sendAll(fd, chunk(R"({"done":true})" "\n") + "0\r\n\r\n");
+    }
+
+    int listen_fd_ = -1;
+    unsigned short port_ = 0;
+    std::thread acceptor_;
+    std::mutex fds_mu_;
+    std::vector<int> fds_;
+    std::vector<std::thread> conns_;
+};
+
+static bool waitFor(bool (*pred)(), int ms) {
+    const auto end = Clock::now() + std::chrono::milliseconds(ms);
+    while (!pred()) {
+        if (Clock::now() > end) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+static bool startsWith(const std::string& s, const std::string& prefix) {
+    return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+// One streamed turn, polled the way ChatBox polls it each frame.
+struct Observed {
+    std::vector<std::string> snapshots;   // distinct reply() values
+    std::vector<std::string> sentences;
+    double first_sentence_s = -1.0;
+    double done_s = 0.0;
+};
+
+static Observed runTurn(const std::string& text) {
+    Observed o;
+    const uint64_t turn = DialogLlm::turn();
+    const auto t0 = Clock::now();
+    CHECK(DialogLlm::send(text));
+    CHECK(DialogLlm::turn() == turn + 1);
+    CHECK(!DialogLlm::send("second request while busy"));
+
+    engine::audio::SentenceSegmenter seg;
+    size_t fed = 0;
+    uint64_t seen = ~0ull;
+    for (;;) {
+        const bool done = !DialogLlm::busy();
+        const uint64_t rev = DialogLlm::revision();
+        if (rev != seen) {
+            seen = rev;
+            const std::string r = DialogLlm::reply();
+            if (o.snapshots.empty() || o.snapshots.back() != r)
+                o.snapshots.push_back(r);
+            if (r.size() > fed) {
+                seg.feed(r.substr(fed), o.sentences);
+                fed = r.size();
+            }
+        }
+        if (o.first_sentence_s < 0 && !o.sentences.empty())
+            o.first_sentence_s =
+                std::chrono::duration<double>(Clock::now() - t0).count();
+        if (done) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    seg.flush(o.sentences);
+    o.done_s = std::chrono::duration<double>(Clock::now() - t0).count();
+    return o;
+}
+
+static void testStreamedTurns(MockOllama& mock) {
+    using nlohmann::json;
+    CHECK(waitFor([] { return DialogLlm::available(); }, 3000));
+    CHECK(DialogLlm::modelName() == "JinYong-mock:latest");
+
+    const Observed a = runTurn("Which way to the inn?");
+    CHECK(DialogLlm::reply() == kReply);
+    // The reply arrived piece by piece, each view a prefix of the whole.
+    CHECK(a.snapshots.size() >= 5);
+    for (const auto& snap : a.snapshots) CHECK(startsWith(kReply, snap));
+    CHECK(a.sentences.size() == 3);
+    CHECK(a.sentences[0] == "Greetings, traveller.");
+    CHECK(a.sentences[2] == "Take the river path.");
+    // 13 tokens at 40 ms: the first sentence is complete after 4 of them.
+    CHECK(a.first_sentence_s > 0.0);
+    CHECK(a.first_sentence_s < a.done_s * 0.6);
+    std::printf("  first sentence after %.0f ms, whole reply %.0f ms\n",
+                a.first_sentence_s * 1e3, a.done_s * 1e3);
+
+    json req;
+    {
+        std::lock_guard<std::mutex> lk(mock.mu);
+        req = json::parse(mock.last_request);
+    }
+    CHECK(req["stream"] == true);
+    CHECK(req["model"] == "JinYong-mock:latest");
+    CHECK(req["messages"].size() == 2);   // system + user
+
+    // Second turn: starts from an empty reply and carries the first
+    // exchange as history.
+    const Observed b = runTurn("Thanks.");
+    CHECK(b.snapshots.front().size() < std::strlen(kReply));
+    CHECK(DialogLlm::reply() == kReply);
+    {
+        std::lock_guard<std::mutex> lk(mock.mu);
+        req = json::parse(mock.last_request);
+    }
+    CHECK(req["messages"].size() == 4);
+    CHECK(req["messages"][2]["role"] == "assistant");
+    CHECK(req["messages"][2]["content"] == kReply);
+    CHECK(req["messages"][3]["content"] == "Thanks.");
+}
+
+static void testCutStream(MockOllama& mock) {
+    // The daemon dies after five tokens: what was shown stays.
+    mock.cut_after = 5;
+    const Observed o = runTurn("And the bridge?");
+    CHECK(DialogLlm::reply() == "Greetings, traveller. The road north");
+    CHECK(o.sentences.size() == 2);
+    CHECK(o.sentences[1] == "The road north");
+    mock.cut_after = -1;
+
+    // The next turn reconnects.
+    runTurn("Hello?");
+    CHECK(DialogLlm::reply() == kReply);
+
+    DialogLlm::resetConversation();
+    CHECK(DialogLlm::reply().empty());
+}
+
+int main() {
+    MockOllama mock;
+    setenv("OLLAMA_HOST", mock.host().c_str(), 1);
+    unsetenv("RW_DIALOG_MODEL");
+
+    testStreamedTurns(mock);
+    testCutStream(mock);
+
+    std::printf("dialog_llm_tests: %d checks passed\n", g_checks);
+    return 0;
+}
@@ -0,0 +1,536 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// ktx2_tests.cpp — standalone unit tests for the KTX2 container
+// (helper/ktx2.*).
+//
+// Pure CPU, files under the system temp directory.  Level sizes and packed
+// offsets for texel and BC formats; an sRGB RGBA8 chain filters in linear
+// light; RGBA8, BC1, BC3 and BC7 chains go through writeKtx2 / Ktx2File and
+// come back byte for byte, whole and as a mip tail read into its place in
+// the chain; the file stores the smallest level first with a DFD that
+// names the format; placeholders are flat blocks of the right mean (and
+// cut-out BC1 stays cut out); .dds files split into levels; damaged,
+// truncated and Basis files are refused.  Built with HAS_ZSTD the levels
+// are zstd frames and the same checks hold.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. helper/tests/ktx2_tests.cpp helper/ktx2.cpp
+//       helper/zstd_block.cpp -o ktx2_tests
+//   (add -DHAS_ZSTD ... -lzstd to cover supercompression)
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "helper/ktx2.h"
+#include "helper/dds.h"
+#include "helper/zstd_block.h"
+
+using namespace engine::helper;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream is(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(is), {});
+}
+
+static void writeFile(const std::string& path, const std::vector<uint8_t>& b) {
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    os.write(reinterpret_cast<const char*>(b.data()),
+             static_cast<std::streamsize>(b.size()));
+}
+
+static uint32_t u32(const std::vector<uint8_t>& b, size_t at) {
+    uint32_t v;
+    std::memcpy(&v, b.data() + at, 4);
+    return v;
+}
+
+static uint64_t u64(const std::vector<uint8_t>& b, size_t at) {
+    uint64_t v;
+    std::memcpy(&v, b.data() + at, 8);
+    return v;
+}
+
+// Deterministic filler bytes for block formats.
+static Ktx2Image makeBlockImage(uint32_t fmt, uint32_t w, uint32_t h) {
+    Ktx2Image img;
+    img.vk_format = fmt;
+    img.width = w;
+    img.height = h;
+    uint32_t seed = fmt * 2654435761u;
+    for (uint32_t l = 0; l < ktx2FullMipCount(w, h); ++l) {
+        std::vector<uint8_t> level(ktx2LevelBytes(fmt, w, h, l));
+        for (uint8_t& b : level) {
+            seed = seed * 1664525u + 1013904223u;
+            b = uint8_t(seed >> 24) & 0x0F;    // compressible
+        }
+        img.levels.push_back(std::move(level));
+    }
+    return img;
+}
+
+static std::vector<uint8_t> packed(const Ktx2Image& img, uint32_t first) {
+    std::vector<uint8_t> out;
+    for (uint32_t l = first; l < img.levels.size(); ++l)
+        out.insert(out.end(), img.levels[l].begin(), img.levels[l].end());
+    return out;
+}
+
+static void testFormats() {
+    CHECK(ktx2BlockBytes(kKtx2R8G8B8Unorm) == 3);
+    CHECK(ktx2BlockBytes(kKtx2B8G8R8A8Srgb) == 4);
+    CHECK(ktx2BlockBytes(kKtx2Bc1RgbUnorm) == 8);
+    CHECK(ktx2BlockBytes(kKtx2Bc7Srgb) == 16);
+    CHECK(ktx2BlockBytes(0) == 0);
+    CHECK(ktx2BlockBytes(100) == 0);
+    CHECK(ktx2IsBlockCompressed(kKtx2Bc4Unorm));
+    CHECK(!ktx2IsBlockCompressed(kKtx2R8G8B8A8Unorm));
+    CHECK(ktx2IsSrgb(kKtx2Bc3Srgb) && !ktx2IsSrgb(kKtx2Bc3Unorm));
+    CHECK(ktx2WithSrgb(kKtx2Bc1RgbaUnorm, true) == kKtx2Bc1RgbaSrgb);
+    CHECK(ktx2WithSrgb(kKtx2Bc7Srgb, false) == kKtx2Bc7Unorm);
+    CHECK(ktx2WithSrgb(kKtx2R8G8B8A8Unorm, true) == kKtx2R8G8B8A8Srgb);
+    CHECK(ktx2WithSrgb(kKtx2B8G8R8A8Srgb, false) == kKtx2B8G8R8A8Unorm);
+    CHECK(ktx2WithSrgb(kKtx2R8G8B8Unorm, true) == kKtx2R8G8B8Srgb);
+    CHECK(ktx2WithSrgb(kKtx2Bc5Unorm, true) == kKtx2Bc5Unorm);
+    CHECK(ktx2WithSrgb(kKtx2Bc3Srgb, true) == kKtx2Bc3Srgb);
+
+    CHECK(ktx2FullMipCount(1, 1) == 1);
+    CHECK(ktx2FullMipCount(256, 256) == 9);
+    CHECK(ktx2FullMipCount(300, 20) == 9);
+
+    // 13x7 BC1: 4x2 blocks, then 2x1 (6x3), 1x1 (3x1), 1x1 (1x1).
+    CHECK(ktx2LevelBytes(kKtx2Bc1RgbUnorm, 13, 7, 0) == 4 * 2 * 8);
+    CHECK(ktx2LevelBytes(kKtx2Bc1RgbUnorm, 13, 7, 1) == 2 * 1 * 8);
+    CHECK(ktx2LevelBytes(kKtx2Bc1RgbUnorm, 13, 7, 3) == 8);
+    CHECK(ktx2LevelBytes(kKtx2R8G8B8A8Unorm, 13, 7, 1) == 6 * 3 * 4);
+    CHECK(ktx2LevelBytes(kKtx2R8G8B8A8Unorm, 13, 7, 3) == 4);
+    CHECK(ktx2LevelOffset(kKtx2Bc1RgbUnorm, 13, 7, 0, 0) == 0);
+    CHECK(ktx2LevelOffset(kKtx2Bc1RgbUnorm, 13, 7, 0, 2) == 64 + 16);
+    CHECK(ktx2LevelOffset(kKtx2Bc1RgbUnorm, 13, 7, 1, 3) == 16 + 8);
+}
+
+static void testRgba8Chain() {
+    // 2x2 black/white checker: the sRGB mean is linear 0.5, not 127.
+    const uint8_t px[16] = { 0, 0, 0, 255,      255, 255, 255, 255,
+                             255, 255, 255, 255, 0, 0, 0, 0 };
+    Ktx2Image img;
+    buildKtx2Rgba8(2, 2, px, true, img);
+    CHECK(img.vk_format == kKtx2R8G8B8A8Srgb);
+    CHECK(img.levels.size() == 2);
+    CHECK(img.levels[1].size() == 4);
+    CHECK(img.levels[1][0] == 188 && img.levels[1][2] == 188);
+    CHECK(img.levels[1][3] == 191);           // alpha averages linearly
+
+    buildKtx2Rgba8(2, 2, px, false, img);
+    CHECK(img.vk_format == kKtx2R8G8B8A8Unorm);
+    CHECK(img.levels[1][0] == 128);
+
+    // Odd sizes clamp at the edge and end at 1x1.
+    std::vector<uint8_t> big(37 * 20 * 4);
+    for (size_t i = 0; i < big.size(); ++i) big[i] = uint8_t(i * 7);
+    buildKtx2Rgba8(37, 20, big.data(), true, img);
+    CHECK(img.levels.size() == 6);
+    for (uint32_t l = 0; l < img.levels.size(); ++l)
+        CHECK(img.levels[l].size() ==
+              ktx2LevelBytes(img.vk_format, 37, 20, l));
+}
+
+static void roundTrip(const Ktx2Image& img, const char* name) {
+    const std::string path = tempPath(name);
+    std::string err;
+    CHECK(writeKtx2(path, img, {}, &err));
+    CHECK(err.empty());
+    const uint32_t n = (uint32_t)img.levels.size();
+
+    const std::vector<uint8_t> bytes = readFile(path);
+    CHECK(bytes.size() > 80);
+    CHECK(bytes[0] == 0xAB && std::memcmp(&bytes[1], "KTX 20", 6) == 0);
+    CHECK(u32(bytes, 12) == img.vk_format);
+    CHECK(u32(bytes, 20) == img.width && u32(bytes, 24) == img.height);
+    CHECK(u32(bytes, 40) == n);
+    const bool zstd = zstdAvailable();
+    CHECK(u32(bytes, 44) == (zstd ? 2u : 0u));
+    // Smallest level first: offsets fall as the level index rises.
+    for (uint32_t l = 0; l + 1 < n; ++l)
+        CHECK(u64(bytes, 80 + 24 * l) > u64(bytes, 80 + 24 * (l + 1)));
+    for (uint32_t l = 0; l < n; ++l)
+        CHECK(u64(bytes, 80 + 24 * l + 16) == img.levels[l].size());
+    // DFD: total size then the basic block; bytesPlane0 is 0 when
+    // supercompressed.
+    const uint32_t dfd = u32(bytes, 48);
+    CHECK(dfd == 80 + 24 * n);
+    CHECK(u32(bytes, dfd) == u32(bytes, 52));
+    CHECK((u32(bytes, dfd + 8) & 0xFFFF) == 2);
+    CHECK(((u32(bytes, dfd + 12) >> 16) & 0xFF) ==
+          (ktx2IsSrgb(img.vk_format) ? 2u : 1u));
+    CHECK((u32(bytes, dfd + 20) & 0xFF) ==
+          (zstd ? 0u : ktx2BlockBytes(img.vk_format)));
+
+    Ktx2File f;
+    CHECK(f.open(path));
+    CHECK(f.isOpen());
+    CHECK(f.vkFormat() == img.vk_format);
+    CHECK(f.width() == img.width && f.height() == img.height);
+    CHECK(f.levelCount() == n);
+    CHECK(f.supercompression() == (zstd ? Ktx2Supercompression::kZstd
+                                        : Ktx2Supercompression::kNone));
+
+    std::vector<uint8_t> all;
+    CHECK(f.readLevels(0, n, all));
+    CHECK(all == packed(img, 0));
+
+    // The tail alone, then the rest, each into its place in one chain.
+    const uint32_t tail = f.tailStart(8);
+    CHECK(std::max(1u, img.width >> tail) <= 8 || tail == n - 1);
+    CHECK(tail == 0 || std::max(img.width >> (tail - 1),
+                                img.height >> (tail - 1)) > 8);
+    const uint64_t tail_at =
+        ktx2LevelOffset(img.vk_format, img.width, img.height, 0, tail);
+    std::vector<uint8_t> chain(all.size(), 0xEE);
+    CHECK(f.readLevels(tail, n - tail, chain, size_t(tail_at)));
+    CHECK(std::equal(chain.begin() + tail_at, chain.end(),
+                     all.begin() + tail_at));
+    if (tail > 0) {
+        CHECK(chain[0] == 0xEE);
+        CHECK(f.readLevels(0, tail, chain));
+        CHECK(chain == all);
+    }
+    CHECK(!f.readLevels(n, 1, chain));
+    CHECK(!f.readLevels(0, n + 1, chain));
+    CHECK(!f.readLevels(0, 0, chain));
+
+    f.close();
+    CHECK(!f.isOpen());
+    std::remove(path.c_str());
+}
+
+static void testRoundTrips() {
+    std::vector<uint8_t> rgba(64 * 32 * 4);
+    for (size_t i = 0; i < rgba.size(); ++i) rgba[i] = uint8_t(i / 3);
+    Ktx2Image img;
+    buildKtx2Rgba8(64, 32, rgba.data(), true, img);
+    roundTrip(img, "ktx2_test_rgba8.ktx2");
+
+    roundTrip(makeBlockImage(kKtx2Bc1RgbSrgb, 100, 60),
+              "ktx2_test_bc1.ktx2");
+    roundTrip(makeBlockImage(kKtx2Bc3Unorm, 64, 64), "ktx2_test_bc3.ktx2");
+    roundTrip(makeBlockImage(kKtx2Bc7Srgb, 32, 128), "ktx2_test_bc7.ktx2");
+
+    // A single level (no mips) also works.
+    Ktx2Image one = makeBlockImage(kKtx2Bc5Unorm, 16, 16);
+    one.levels.resize(1);
+    roundTrip(one, "ktx2_test_one.ktx2");
+
+    // Uncompressed when asked, even with zstd.
+    const std::string path = tempPath("ktx2_test_raw.ktx2");
+    Ktx2WriteOptions raw;
+    raw.zstd = false;
+    const Ktx2Image bc4 = makeBlockImage(kKtx2Bc4Unorm, 40, 40);
+    CHECK(writeKtx2(path, bc4, raw));
+    Ktx2File f;
+    CHECK(f.open(path));
+    CHECK(f.supercompression() == Ktx2Supercompression::kNone);
+    std::vector<uint8_t> all;
+    CHECK(f.readLevels(0, f.levelCount(), all));
+    CHECK(all == packed(bc4, 0));
+    f.close();
+    std::remove(path.c_str());
+
+    // Writer refuses what it cannot describe.
+    Ktx2Image bad = makeBlockImage(kKtx2Bc1RgbUnorm, 8, 8);
+    bad.levels[1].pop_back();
+    std::string err;
+    CHECK(!writeKtx2(path, bad, {}, &err) && !err.empty());
+    bad = makeBlockImage(kKtx2Bc1RgbUnorm, 8, 8);
+    bad.vk_format = 0;
+    CHECK(!writeKtx2(path, bad));
+    bad = makeBlockImage(kKtx2Bc1RgbUnorm, 8, 8);
+    bad.levels.push_back(bad.levels.back());
+    CHECK(!writeKtx2(path, bad));
+    bad.levels.clear();
+    CHECK(!writeKtx2(path, bad));
+    std::remove(path.c_str());
+}
+
+static void testPlaceholders() {
+    // Texel formats: nearest upsample of the first resident level.
+    {
+        const uint32_t fmt = kKtx2R8G8B8A8Unorm;
+        std::vector<uint8_t> chain(ktx2LevelOffset(fmt, 8, 8, 0, 4), 0);
+        uint8_t* l2 = chain.data() + ktx2LevelOffset(fmt, 8, 8, 0, 2);
+        const uint8_t quad[16] = { 10, 0, 0, 255, 20, 0, 0, 255,
+                                   30, 0, 0, 255, 40, 0, 0, 255 };
+        std::memcpy(l2, quad, 16);
+        CHECK(fillKtx2Placeholders(fmt, 8, 8, 2, chain.data()));
+        const uint8_t* l0 = chain.data();
+        CHECK(l0[0] == 10 && l0[3 * 4] == 10 && l0[4 * 4] == 20);
+        CHECK(l0[(4 * 8 + 0) * 4] == 30 && l0[(7 * 8 + 7) * 4] == 40);
+        const uint8_t* l1 = chain.data() + ktx2LevelOffset(fmt, 8, 8, 0, 1);
+        CHECK(l1[0] == 10 && l1[2 * 4] == 20 && l1[(3 * 4 + 3) * 4] == 40);
+        // Nothing to do when level 0 is resident.
+        CHECK(fillKtx2Placeholders(fmt, 8, 8, 0, chain.data()));
+    }
+
+    // BC1: one flat block of the source block's mean colour.
+    {
+        const uint32_t fmt = kKtx2Bc1RgbUnorm;
+        std::vector<uint8_t> chain(ktx2LevelOffset(fmt, 16, 16, 0, 5));
+        uint8_t* l2 = chain.data() + ktx2LevelOffset(fmt, 16, 16, 0, 2);
+        // c0 = white, c1 = black, four-colour mode, 12 texels index 0 and
+        // 4 texels index 1: the mean is 3/4 grey.
+        const uint16_t white = 0xFFFF, black = 0;
+        std::memcpy(l2, &white, 2);
+        std::memcpy(l2 + 2, &black, 2);
+        const uint32_t idx = 0x55000000u;     // 12 x index 0, 4 x index 1
+        std::memcpy(l2 + 4, &idx, 4);
+        CHECK(fillKtx2Placeholders(fmt, 16, 16, 2, chain.data()));
+        for (uint32_t b = 0; b < 16 + 4; ++b) {
+            uint16_t c0, c1;
+            uint32_t i;
+            std::memcpy(&c0, chain.data() + b * 8, 2);
+            std::memcpy(&c1, chain.data() + b * 8 + 2, 2);
+            std::memcpy(&i, chain.data() + b * 8 + 4, 4);
+            CHECK(c0 == c1 && i == 0);
+            CHECK(((c0 >> 11) & 31) == 23 && ((c0 >> 5) & 63) == 47);
+        }
+    }
+
+    // BC1 with punch-through alpha: a mostly cut-out block stays cut out.
+    {
+        const uint32_t fmt = kKtx2Bc1RgbaUnorm;
+        std::vector<uint8_t> chain(ktx2LevelOffset(fmt, 8, 8, 0, 4));
+        uint8_t* l1 = chain.data() + ktx2LevelOffset(fmt, 8, 8, 0, 1);
+        const uint16_t c0 = 0x1234, c1 = 0x8000;   // c0 <= c1: 3-colour
+        std::memcpy(l1, &c0, 2);
+        std::memcpy(l1 + 2, &c1, 2);
+        const uint32_t idx = 0xFFFFFF00u;          // 12 of 16 transparent
+        std::memcpy(l1 + 4, &idx, 4);
+        CHECK(fillKtx2Placeholders(fmt, 8, 8, 1, chain.data()));
+        uint16_t a, b;
+        uint32_t i;
+        std::memcpy(&a, chain.data(), 2);
+        std::memcpy(&b, chain.data() + 2, 2);
+        std::memcpy(&i, chain.data() + 4, 4);
+        CHECK(a <= b && i == 0xFFFFFFFFu);
+    }
+
+    // BC3: flat alpha of the mean, colour block flat too.
+    {
+        const uint32_t fmt = kKtx2Bc3Unorm;
+        std::vector<uint8_t> chain(ktx2LevelOffset(fmt, 8, 8, 0, 4));
+        uint8_t* l1 = chain.data() + ktx2LevelOffset(fmt, 8, 8, 0, 1);
+        l1[0] = 200;                    // a0 > a1: eight values
+        l1[1] = 100;
+        // Indices: eight texels 0 (200), eight texels 1 (100).
+        uint64_t bits = 0;
+        for (int t = 8; t < 16; ++t) bits |= uint64_t(1) << (3 * t);
+        std::memcpy(l1 + 2, &bits, 6);
+        CHECK(fillKtx2Placeholders(fmt, 8, 8, 1, chain.data()));
+        CHECK(chain[0] == 150 && chain[1] == 150);
+        for (int k = 2; k < 8; ++k) CHECK(chain[k] == 0);
+    }
+
+    // BC7 has no placeholder encoder: load those whole.
+    {
+        std::vector<uint8_t> chain(
+            ktx2LevelOffset(kKtx2Bc7Unorm, 8, 8, 0, 4));
+        CHECK(!fillKtx2Placeholders(kKtx2Bc7Unorm, 8, 8, 1, chain.data()));
+        CHECK(!fillKtx2Placeholders(0, 8, 8, 1, chain.data()));
+    }
+}
+
+static std::vector<uint8_t> makeDds(uint32_t w, uint32_t h, uint32_t mips,
+                                    uint32_t fourcc, uint32_t dxgi,
+                                    const std::vector<uint8_t>& payload) {
+    using namespace engine::renderer;
+    DDS_HEADER hdr{};
+    hdr.size = sizeof(DDS_HEADER);
+    hdr.flags = DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP;
+    hdr.width = w;
+    hdr.height = h;
+    hdr.mipMapCount = mips;
+    hdr.ddspf.size = sizeof(DDS_PIXELFORMAT);
+    hdr.ddspf.flags = DDS_FOURCC;
+    hdr.ddspf.fourCC = fourcc;
+    std::vector<uint8_t> b(4 + sizeof hdr);
+    const uint32_t magic = DDS_MAGIC;
+    std::memcpy(b.data(), &magic, 4);
+    std::memcpy(b.data() + 4, &hdr, sizeof hdr);
+    if (dxgi) {
+        DDS_HEADER_DXT10 dx{};
+        dx.dxgiFormat = DXGI_FORMAT(dxgi);
+        dx.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+        dx.arraySize = 1;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&dx);
+        b.insert(b.end(), p, p + sizeof dx);
+    }
+    b.insert(b.end(), payload.begin(), payload.end());
+    return b;
+}
+
+static void testDds() {
+    // DXT5, 3 levels of 16x16.
+    const Ktx2Image src = makeBlockImage(kKtx2Bc3Unorm, 16, 16);
+    std::vector<uint8_t> payload;
+    for (uint32_t l = 0; l < 3; ++l)
+        payload.insert(payload.end(), src.levels[l].begin(),
+                       src.levels[l].end());
+    std::vector<uint8_t> dds =
+        makeDds(16, 16, 3, MAKEFOURCC('D', 'X', 'T', '5'), 0, payload);
+    Ktx2Image img;
+    std::string err;
+    CHECK(ktx2FromDds(dds.data(), dds.size(), true, img, &err));
+    CHECK(img.vk_format == kKtx2Bc3Srgb);
+    CHECK(img.width == 16 && img.height == 16);
+    CHECK(img.levels.size() == 3);
+    for (uint32_t l = 0; l < 3; ++l) CHECK(img.levels[l] == src.levels[l]);
+    CHECK(ktx2FromDds(dds.data(), dds.size(), false, img));
+    CHECK(img.vk_format == kKtx2Bc3Unorm);
+
+    // Converted .dds round-trips through the container.
+    roundTrip(img, "ktx2_test_dds.ktx2");
+
+    // Truncated payload, bad magic, cubemap.
+    std::vector<uint8_t> cut(dds.begin(), dds.end() - 1);
+    CHECK(!ktx2FromDds(cut.data(), cut.size(), true, img, &err));
+    CHECK(!err.empty());
+    std::vector<uint8_t> bad = dds;
+    bad[0] = 'X';
+    CHECK(!ktx2FromDds(bad.data(), bad.size(), true, img));
+    bad = dds;
+    const uint32_t cube = DDS_CUBEMAP;
+    std::memcpy(bad.data() + 4 + offsetof(engine::renderer::DDS_HEADER,
+                                          caps2), &cube, 4);
+    CHECK(!ktx2FromDds(bad.data(), bad.size(), true, img));
+    CHECK(!ktx2FromDds(dds.data(), 10, true, img));
+
+    // DX10 header with BC7 sRGB (DXGI 99); `srgb` does not override it.
+    const Ktx2Image bc7 = makeBlockImage(kKtx2Bc7Srgb, 8, 8);
+    dds = makeDds(8, 8, 1, MAKEFOURCC('D', 'X', '1', '0'), 99, bc7.levels[0]);
+    CHECK(ktx2FromDds(dds.data(), dds.size(), false, img));
+    CHECK(img.vk_format == kKtx2Bc7Srgb);
+    CHECK(img.levels.size() == 1 && img.levels[0] == bc7.levels[0]);
+
+    // 24-bit BGR becomes RGB8.
+    {
+        using namespace engine::renderer;
+        std::vector<uint8_t> px = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+        dds = makeDds(2, 2, 1, 0, 0, px);
+        DDS_HEADER hdr;
+        std::memcpy(&hdr, dds.data() + 4, sizeof hdr);
+        hdr.ddspf = DDSPF_R8G8B8;
+        std::memcpy(dds.data() + 4, &hdr, sizeof hdr);
+        CHECK(ktx2FromDds(dds.data(), dds.size(), false, img));
+        CHECK(img.vk_format == kKtx2R8G8B8Unorm);
+        CHECK(img.levels[0][0] == 3 && img.levels[0][2] == 1);
+        CHECK(img.levels[0][9] == 12 && img.levels[0][11] == 10);
+    }
+}
+
+static void testDamaged() {
+    const std::string path = tempPath("ktx2_test_damaged.ktx2");
+    Ktx2File f;
+    CHECK(!f.open(path + ".missing"));
+    CHECK(!f.error().empty());
+
+    const Ktx2Image img = makeBlockImage(kKtx2Bc1RgbUnorm, 32, 32);
+    CHECK(writeKtx2(path, img));
+    const std::vector<uint8_t> good = readFile(path);
+
+    std::vector<uint8_t> b = good;
+    b[5] = 'X';                                 // identifier
+    writeFile(path, b);
+    CHECK(!f.open(path));
+
+    b = good;
+    std::memset(b.data() + 12, 0, 4);           // vkFormat 0 = Basis
+    writeFile(path, b);
+    CHECK(!f.open(path));
+    CHECK(f.error().find("Basis") != std::string::npos);
+
+    b = good;
+    const uint32_t basislz = 1;
+    std::memcpy(b.data() + 44, &basislz, 4);
+    writeFile(path, b);
+    CHECK(!f.open(path));
+
+    b = good;
+    const uint32_t six = 6;
+    std::memcpy(b.data() + 36, &six, 4);        // cubemap
+    writeFile(path, b);
+    CHECK(!f.open(path));
+
+    b = good;
+    const uint32_t too_many = 20;
+    std::memcpy(b.data() + 40, &too_many, 4);
+    writeFile(path, b);
+    CHECK(!f.open(path));
+
+    // Truncated: level 0 (stored last) runs past the end.
+    b.assign(good.begin(), good.end() - 1);
+    writeFile(path, b);
+    CHECK(!f.open(path));
+
+    // Header only.
+    b.assign(good.begin(), good.begin() + 60);
+    writeFile(path, b);
+    CHECK(!f.open(path));
+
+    // Wrong uncompressed size in the level index.
+    b = good;
+    const uint64_t wrong = 1;
+    std::memcpy(b.data() + 80 + 16, &wrong, 8);
+    writeFile(path, b);
+    CHECK(!f.open(path));
+    CHECK(!f.isOpen());
+
+    // Damaged level data: zstd reports it, raw data cannot tell.
+    if (zstdAvailable()) {
+        b = good;
+        const uint64_t at = u64(good, 80);
+        for (uint64_t i = 0; i < u64(good, 88); ++i) b[at + i] ^= 0x5A;
+        writeFile(path, b);
+        CHECK(f.open(path));
+        std::vector<uint8_t> out;
+        CHECK(!f.readLevels(0, 1, out));
+        CHECK(!f.error().empty());
+        CHECK(f.readLevels(1, f.levelCount() - 1, out));
+    }
+
+    writeFile(path, good);
+    CHECK(f.open(path));
+    f.close();
+    std::remove(path.c_str());
+}
+
+int main() {
+    testFormats();
+    testRgba8Chain();
+    testRoundTrips();
+    testPlaceholders();
+    testDds();
+    testDamaged();
+    std::printf("ktx2_tests: %d checks passed (zstd %s)\n", g_checks,
+                zstdAvailable() ? "on" : "off");
+    return 0;
+}
@@ -0,0 +1,455 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// material_classifier_tests.cpp — standalone tests for the portable HTTP
+// transport (helper/http_client.*) and MaterialClassifier's parallel
+// batches and verdict cache, against an in-process mock Ollama daemon.
+//
+// The mock speaks just enough of Ollama: GET /api/tags, and POST
+// /api/chat answered as a chunked NDJSON stream after a fixed "generation"
+// delay, tagging each name by substring.  Checks the client keeps one
+// connection alive across requests, reassembles chunked bodies, survives
+// the server dropping an idle connection, and reports an unreachable
+// daemon as status 0.  Then that classifyAll() keeps several batches in
+// flight, and that a repeat build of the same names answers everything
+// from the cache with no connection made at all — while a new model tag,
+// or a name the model never answered, is asked again.
+//
+// POSIX only (the mock server); the client under test is portable.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. -I<json-dir> -I<glm-dir>
+//       -Ithird_parties/Vulkan-Headers/include
+//       helper/tests/material_classifier_tests.cpp
+//       helper/material_classifier.cpp helper/http_client.cpp
+//       -lpthread -o material_classifier_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "json.hpp"
+
+#include "helper/http_client.h"
+#include "helper/material_classifier.h"
+
+using namespace engine::helper;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+// collision_mesh.cpp brings the whole collision stack with it; its tag
+// table is all the classifier links against, restated here.
+namespace engine {
+namespace helper {
+const char* meshCategoryTag(MeshCategory c) {
+    switch (c) {
+        case MeshCategory::Floor:  return "WALKABLE_SURFACE";
+        case MeshCategory::Wall:   return "WALL";
+        case MeshCategory::Object: return "OBJECT";
+        case MeshCategory::Glass:  return "GLASS";
+        default:                   return "UNKNOWN";
+    }
+}
+MeshCategory meshCategoryFromTag(const std::string& tag) {
+    if (tag == "WALKABLE_SURFACE") return MeshCategory::Floor;
+    if (tag == "WALL")             return MeshCategory::Wall;
+    if (tag == "OBJECT")           return MeshCategory::Object;
+    if (tag == "GLASS")            return MeshCategory::Glass;
+    return MeshCategory::Unknown;
+}
+}  // namespace helper
+}  // namespace engine
+
+// ── Mock Ollama ──────────────────────────────────────────────────────────────
+class MockOllama {
+public:
+    std::atomic<int> connections{0};
+    std::atomic<int> tags_requests{0};
+    std::atomic<int> chat_requests{0};
+    std::atomic<int> in_flight{0};
+    std::atomic<int> max_in_flight{0};
+    std::atomic<bool> drop_after_reply{false};  // silent close, no header
+    int generate_ms = 30;
+
+    MockOllama() {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in a{};
+        a.sin_family = AF_INET;
+        a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        a.sin_port = 0;
+        CHECK(::bind(listen_fd_, reinterpret_cast<sockaddr*>(&a),
+                     sizeof(a)) == 0);
+        CHECK(::listen(listen_fd_, 64) == 0);
+        socklen_t len = sizeof(a);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&a), &len);
+        port_ = ntohs(a.sin_port);
+        acceptor_ = std::thread([this] { acceptLoop(); });
+    }
+    ~MockOllama() {
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        ::close(listen_fd_);
+        acceptor_.join();
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            for (int fd : fds_) ::shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& t : conns_) t.join();
+    }
+    unsigned short port() const { return port_; }
+    std::string host() const { return "127.0.0.1:" + std::to_string(port_); }
+
+private:
+    void acceptLoop() {
+        for (;;) {
+            const int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) return;
+            ++connections;
+            std::lock_guard<std::mutex> lk(mu_);
+            fds_.push_back(fd);
+            conns_.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    static bool sendAll(int fd, const std::string& s) {
+        size_t off = 0;
+        while (off < s.size()) {
+            const ssize_t n = ::send(fd, s.data() + off, s.size() - off,
+                                     MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            off += size_t(n);
+        }
+        return true;
+    }
+
+    void serve(int fd) {
+        std::string buf;
+        char tmp[4096];
+        for (;;) {
+            size_t head_end;
+            while ((head_end = buf.find("\r\n\r\n")) == std::string::npos) {
+                const ssize_t n = ::recv(fd, tmp, sizeof(tmp), 0);
+                if (n <= 0) {
+                    ::close(fd);
+                    return;
+                }
+                buf.append(tmp, size_t(n));
+            }
+            const std::string head = buf.substr(0, head_end);
+            size_t length = 0;
+            const size_t cl = head.find("Content-Length: ");
+            if (cl != std::string::npos) {
+                length = std::strtoull(head.c_str() + cl + 16, nullptr, 10);
+            }
+            while (buf.size() < head_end + 4 + length) {
+                const ssize_t n = ::recv(fd, tmp, sizeof(tmp), 0);
+                if (n <= 0) {
+                    ::close(fd);
+                    return;
+                }
+                buf.append(tmp, size_t(n));
+            }
+            const std::string body = buf.substr(head_end + 4, length);
+            buf.erase(0, head_end + 4 + length);
+
+            bool ok;
+            if (head.rfind("GET /api/tags", 0) == 0) {
+                ++tags_requests;
+                const std::string reply =
+                    R"({"models":[{"name":"mock:1b"},{"name":"mock:7b"}]})";
+                ok = sendAll(fd, "HTTP/1.1 200 OK\r\nContent-Type: "
+                                 "application/json\r\nContent-Length: " +
+                                     std::to_string(reply.size()) +
+                                     "\r\n\r\n" + reply);
+            } else if (head.rfind("POST /api/chat", 0) == 0) {
+                ok = chat(fd, body);
+            } else {
+                ok = sendAll(fd, "HTTP/1.1 404 Not Found\r\n"
+                                 "Content-Length: 0\r\n\r\n");
+            }
+            if (!ok || drop_after_reply) {
+                ::close(fd);
+                return;
+            }
+        }
+    }
+
+    // Tags by substring; "skipme" names are left out of the reply, the
+    // way a small model sometimes drops an entry.
+    static const char* tagFor(const std::string& name) {
+        if (name.find("Floor") != std::string::npos) return "WALKABLE_SURFACE";
+        if (name.find("Wall") != std::string::npos)  return "WALL";
+        if (name.find("Glass") != std::string::npos) return "GLASS";
+        return "OBJECT";
+    }
+
+    bool chat(int fd, const std::string& body) {
+        ++chat_requests;
+        const int now = ++in_flight;
+        int seen = max_in_flight.load();
+        while (now > seen && !max_in_flight.compare_exchange_weak(seen, now)) {
+        }
+        using nlohmann::json;
+        const json req = json::parse(body);
+        const json payload =
+            json::parse(req["messages"][1]["content"].get<std::string>());
+        json verdict = {{"materials", json::object()},
+                        {"objects", json::object()}};
+        for (const char* kind : {"materials", "objects"}) {
+            for (const auto& e : payload[kind]) {
+                const std::string name = e["name"].get<std::string>();
+                if (name.find("skipme") != std::string::npos) continue;
+                verdict[kind][name] = tagFor(name);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(generate_ms));
+
+        // The reply text split over several NDJSON frames, one HTTP chunk
+        // each, the way tokens stream out of the daemon.
+        const std::string text = verdict.dump();
+        std::string out = "HTTP/1.1 200 OK\r\nContent-Type: "
+                          "application/x-ndjson\r\nTransfer-Encoding: "
+                          "chunked\r\n\r\n";
+        const size_t piece = std::max<size_t>(1, text.size() / 5);
+        for (size_t at = 0; at < text.size(); at += piece) {
+            json frame = {{"model", req["model"]},
+                          {"message", {{"role", "assistant"},
+                                       {"content", text.substr(at, piece)}}},
+                          {"done", false}};
+            const std::string line = frame.dump() + "\n";
+            char size[32];
+            std::snprintf(size, sizeof(size), "%zx\r\n", line.size());
+            out += size + line + "\r\n";
+        }
+        const std::string last = R"({"done":true})" "\n";
+        char size[32];
+        std::snprintf(size, sizeof(size), "%zx\r\n", last.size());
+        out += size + last + "\r\n0\r\n\r\n";
+        --in_flight;
+        return sendAll(fd, out);
+    }
+
+    int listen_fd_ = -1;
+    unsigned short port_ = 0;
+    std::thread acceptor_;
+    std::mutex mu_;
+    std::vector<int> fds_;
+    std::vector<std::thread> conns_;
+};
+
+// ── HttpClient ───────────────────────────────────────────────────────────────
+static void testHttpClient() {
+    MockOllama mock;
+    mock.generate_ms = 0;
+    HttpClient http("127.0.0.1", mock.port());
+
+    // Keep-alive: three requests, one connection.
+    for (int i = 0; i < 3; ++i) {
+        const HttpClient::Result r = http.request("GET", "/api/tags", "");
+        CHECK(r.status == 200 && r.complete);
+        CHECK(r.body.find("mock:1b") != std::string::npos);
+    }
+    CHECK(http.connectCount() == 1);
+    CHECK(mock.connections == 1);
+
+    // Chunked NDJSON: reassembled whole, and seen piece by piece.
+    const std::string req =
+        R"({"model":"mock:1b","messages":[{"role":"system","content":""},)"
+        R"({"role":"user","content":"{\"materials\":[{\"name\":\"Wall_A\"}],)"
+        R"(\"objects\":[]}"}]})";
+    int pieces = 0;
+    size_t seen = 0;
+    const HttpClient::Result chat = http.request(
+        "POST", "/api/chat", req, [&](const char*, size_t n) {
+            ++pieces;
+            seen += n;
+            return true;
+        });
+    CHECK(chat.status == 200 && chat.complete);
+    CHECK(seen == chat.body.size());
+    CHECK(pieces > 1);
+    CHECK(chat.body.find("\"done\":true") != std::string::npos);
+    CHECK(chat.body.find("0\r\n") == std::string::npos);   // no framing left
+    CHECK(http.connectCount() == 1);
+
+    // Unknown path: a status, not a failure.
+    CHECK(http.request("GET", "/nope", "").status == 404);
+
+    // The server drops idle connections without saying so: the next
+    // request finds a dead socket and retries once on a fresh one.
+    mock.drop_after_reply = true;
+    CHECK(http.request("GET", "/api/tags", "").status == 200);
+    CHECK(http.request("GET", "/api/tags", "").status == 200);
+    CHECK(http.request("GET", "/api/tags", "").status == 200);
+    CHECK(http.connectCount() == 4);
+
+    // Nothing listening: status 0, quickly.
+    HttpClient none("127.0.0.1", 1);
+    const HttpClient::Result dead = none.request("GET", "/api/tags", "");
+    CHECK(dead.status == 0 && !dead.complete);
+}
+
+// ── MaterialClassifier ───────────────────────────────────────────────────────
+static void collectScene(MaterialClassifier& cls, int n) {
+    for (int i = 0; i < n; ++i) {
+        const std::string k = std::to_string(i);
+        cls.collect("Floor_Tile_" + k, "floor_" + k + "_albedo.png",
+                    "Brick_Wall_" + k + "_mesh_" + std::to_string(4000 + i));
+        cls.collect("Glass_Pane_" + k, "", "Chair_" + k + "_mesh___10__");
+    }
+}
+
+static double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - t0).count();
+}
+
+static void testClassifierParallelAndCache() {
+    MockOllama mock;
+    const std::string cache = "material_classifier_tests.tsv";
+    std::remove(cache.c_str());
+    setenv("OLLAMA_HOST", mock.host().c_str(), 1);
+    setenv("OLLAMA_MODEL", "mock:1b", 1);
+    setenv("OLLAMA_BATCH_SIZE", "4", 1);
+    setenv("OLLAMA_PARALLEL", "4", 1);
+    setenv("RW_CLASSIFIER_CACHE", cache.c_str(), 1);
+
+    // 20 rows → 40 materials + 40 normalised objects = 80 names.
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 20);
+        CHECK(cls.collectedMaterialCount() == 40);
+        CHECK(cls.collectedObjectCount() == 40);
+        CHECK(cls.classifyAll("Mock"));
+        CHECK(cls.classifiedMaterialCount() == 40);
+        CHECK(cls.classifiedObjectCount() == 40);
+        CHECK(cls.lookup("", "Brick_Wall_3_mesh_77") == MeshCategory::Wall);
+        CHECK(cls.lookup("", "Chair_5_mesh") == MeshCategory::Object);
+        CHECK(cls.classifiedMaterials().at("Floor_Tile_0") ==
+              MeshCategory::Floor);
+        CHECK(cls.classifiedMaterials().at("Glass_Pane_0") ==
+              MeshCategory::Glass);
+    }
+    const double cold_ms = msSince(t0);
+    CHECK(mock.chat_requests == 20);
+    CHECK(mock.tags_requests == 1);
+    CHECK(mock.max_in_flight > 1);          // batches overlapped
+    CHECK(mock.connections <= 4);           // one keep-alive per worker
+
+    // The same map again: every name from the cache, nothing sent.
+    const int conns = mock.connections;
+    t0 = std::chrono::steady_clock::now();
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 20);
+        CHECK(cls.classifyAll("Mock"));
+        CHECK(cls.classifiedMaterialCount() == 40);
+        CHECK(cls.classifiedObjectCount() == 40);
+        CHECK(cls.lookup("", "Brick_Wall_3_mesh_77") == MeshCategory::Wall);
+        CHECK(cls.classifiedMaterials().at("Floor_Tile_7") ==
+              MeshCategory::Floor);
+    }
+    const double warm_ms = msSince(t0);
+    CHECK(mock.chat_requests == 20);
+    CHECK(mock.tags_requests == 1);
+    CHECK(mock.connections == conns);
+
+    // A bigger map: only the new names are asked.
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 22);              // 4 + 4 new names
+        CHECK(cls.classifyAll("Mock"));
+        CHECK(cls.classifiedObjectCount() == 44);
+    }
+    CHECK(mock.chat_requests == 22);
+
+    // A name the model never answered is not cached, so it is asked
+    // again next time; the verdicts around it are not.
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 22);
+        cls.collect("", "", "Lamp_skipme_01");
+        CHECK(cls.classifyAll("Mock"));
+        CHECK(cls.lookup("", "Lamp_skipme_01") == MeshCategory::Unknown);
+    }
+    CHECK(mock.chat_requests == 23);
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 22);
+        cls.collect("", "", "Lamp_skipme_01");
+        CHECK(cls.classifyAll("Mock"));
+    }
+    CHECK(mock.chat_requests == 24);
+
+    // Another model tag shares nothing with the first.
+    setenv("OLLAMA_MODEL", "mock:7b", 1);
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 20);
+        CHECK(cls.classifyAll("Mock"));
+    }
+    CHECK(mock.chat_requests == 44);
+
+    // Daemon gone: whatever the cache knows still stands.
+    setenv("OLLAMA_HOST", "127.0.0.1:1", 1);
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 20);
+        cls.collect("", "", "Unseen_Prop");
+        CHECK(cls.classifyAll("Mock"));
+        CHECK(cls.classifiedObjectCount() == 40);
+        CHECK(cls.lookup("", "Unseen_Prop") == MeshCategory::Unknown);
+    }
+    setenv("OLLAMA_HOST", mock.host().c_str(), 1);
+
+    // One batch in flight against four, same 80 names, no cache.
+    setenv("RW_CLASSIFIER_CACHE", "off", 1);
+    setenv("OLLAMA_PARALLEL", "1", 1);
+    t0 = std::chrono::steady_clock::now();
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 20);
+        CHECK(cls.classifyAll("Mock"));
+    }
+    const double serial_ms = msSince(t0);
+    setenv("OLLAMA_PARALLEL", "4", 1);
+    t0 = std::chrono::steady_clock::now();
+    {
+        MaterialClassifier cls;
+        collectScene(cls, 20);
+        CHECK(cls.classifyAll("Mock"));
+    }
+    const double parallel_ms = msSince(t0);
+    CHECK(parallel_ms < serial_ms);
+    std::remove(cache.c_str());
+    std::printf("  80 names, 20 batches at %d ms each: serial %.0f ms, "
+                "4 in flight %.0f ms, first build %.0f ms, cached %.2f ms\n",
+                mock.generate_ms, serial_ms, parallel_ms, cold_ms, warm_ms);
+}
+
+int main() {
+    testHttpClient();
+    testClassifierParallelAndCache();
+    std::printf("material_classifier_tests: %d checks passed\n", g_checks);
+    return 0;
+}
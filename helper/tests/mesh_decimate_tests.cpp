@@ -0,0 +1,368 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// mesh_decimate_tests.cpp — standalone unit tests for the native QEM
+// decimator (decimateMesh in helper/mesh_tool.*).
+//
+// Pure CPU: decimates a closed icosphere and checks it stays closed, near
+// the sphere and at the target; an open grid keeps its outline (sealed or
+// not) and its part seams; attribute-aware costs keep a shading crease
+// dense; and a sphere large enough to partition comes out crack-free and
+// identical on pools of different sizes.  Ends with a timing of the
+// native path against the OpenMesh decimater (generateHLODWithSeamProtection)
+// on the same mesh and target.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. helper/tests/mesh_decimate_tests.cpp
+//       helper/mesh_tool.cpp helper/thread_pool.cpp
+//       -lOpenMeshCore -lOpenMeshTools -lpthread -o mesh_decimate_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "helper/mesh_tool.h"
+#include "helper/thread_pool.h"
+
+using namespace engine::helper;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+// Closed, welded icosphere: 20 * 4^subdiv triangles.
+static Mesh makeIcosphere(uint32_t subdiv, float radius) {
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    std::vector<glm::vec3> p = {
+        {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+        {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+        {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1} };
+    std::vector<Face> f = {
+        {0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
+        {1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+        {3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
+        {4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1} };
+    for (auto& v : p) v = glm::normalize(v);
+    for (uint32_t s = 0; s < subdiv; ++s) {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> mid;
+        auto midpoint = [&](uint32_t a, uint32_t b) {
+            const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = mid.find(key);
+            if (it != mid.end()) return it->second;
+            p.push_back(glm::normalize(p[a] + p[b]));
+            return mid[key] = static_cast<uint32_t>(p.size() - 1);
+        };
+        std::vector<Face> next;
+        for (const Face& tri : f) {
+            const uint32_t a = tri.v_indices[0], b = tri.v_indices[1],
+                           c = tri.v_indices[2];
+            const uint32_t ab = midpoint(a, b), bc = midpoint(b, c),
+                           ca = midpoint(c, a);
+            next.emplace_back(a, ab, ca);
+            next.emplace_back(b, bc, ab);
+            next.emplace_back(c, ca, bc);
+            next.emplace_back(ab, bc, ca);
+        }
+        f.swap(next);
+    }
+    Mesh m;
+    for (const auto& v : p) {
+        VertexStruct vs{};
+        vs.position = v * radius;
+        vs.normal   = v;
+        m.vertex_data_ptr->push_back(vs);
+    }
+    *m.faces_ptr = f;
+    return m;
+}
+
+// Flat n x n quad grid in z = 0 over [0, 1]², two triangles per quad.
+static Mesh makeGrid(uint32_t n) {
+    Mesh m;
+    for (uint32_t y = 0; y <= n; ++y) {
+        for (uint32_t x = 0; x <= n; ++x) {
+            VertexStruct vs{};
+            vs.position = glm::vec3(float(x) / n, float(y) / n, 0.0f);
+            vs.normal   = glm::vec3(0.0f, 0.0f, 1.0f);
+            m.vertex_data_ptr->push_back(vs);
+        }
+    }
+    for (uint32_t y = 0; y < n; ++y) {
+        for (uint32_t x = 0; x < n; ++x) {
+            const uint32_t i = y * (n + 1) + x;
+            m.faces_ptr->emplace_back(i, i + 1, i + n + 2);
+            m.faces_ptr->emplace_back(i, i + n + 2, i + n + 1);
+        }
+    }
+    return m;
+}
+
+using PosKey = std::tuple<float, float, float>;
+
+static PosKey posKey(const glm::vec3& p) { return { p.x, p.y, p.z }; }
+
+// Directed edges by position, so duplicated vertices weld.
+static std::map<std::pair<PosKey, PosKey>, int> directedEdges(const Mesh& m) {
+    std::map<std::pair<PosKey, PosKey>, int> edges;
+    const auto& v = *m.vertex_data_ptr;
+    for (const Face& f : *m.faces_ptr) {
+        for (int e = 0; e < 3; ++e) {
+            ++edges[{ posKey(v[f.v_indices[e]].position),
+                      posKey(v[f.v_indices[(e + 1) % 3]].position) }];
+        }
+    }
+    return edges;
+}
+
+// Every directed edge has exactly one opposite twin.
+static bool isClosed(const Mesh& m) {
+    const auto edges = directedEdges(m);
+    for (const auto& [e, n] : edges) {
+        if (n != 1) return false;
+        auto twin = edges.find({ e.second, e.first });
+        if (twin == edges.end() || twin->second != 1) return false;
+    }
+    return true;
+}
+
+// Directed edges without a twin, i.e. the outline.
+static std::set<std::pair<PosKey, PosKey>> outline(const Mesh& m) {
+    const auto edges = directedEdges(m);
+    std::set<std::pair<PosKey, PosKey>> out;
+    for (const auto& [e, n] : edges) {
+        if (!edges.count({ e.second, e.first })) out.insert(e);
+    }
+    return out;
+}
+
+static void checkIndices(const Mesh& m, const std::vector<int32_t>& parts) {
+    CHECK(parts.size() == m.getFaceCount());
+    for (const Face& f : *m.faces_ptr) {
+        CHECK(!f.isDegenerate());
+        for (uint32_t v : f.v_indices) CHECK(v < m.getVertexCount());
+    }
+}
+
+static void testPassThrough() {
+    const Mesh m = makeIcosphere(2, 1.0f);
+    const std::vector<int32_t> parts(m.getFaceCount(), 3);
+    Mesh out;
+    std::vector<int32_t> out_parts;
+    std::ostringstream log;
+    double error = -1.0;
+    DecimateOptions options;
+    options.out_max_error = &error;
+    decimateMesh(m, parts, out, out_parts, m.getFaceCount(), log, options);
+    CHECK(out.getFaceCount() == m.getFaceCount());
+    CHECK(out_parts == parts);
+    CHECK(error == 0.0);
+}
+
+static void testClosedSphere() {
+    const Mesh m = makeIcosphere(5, 2.0f);            // 20480 triangles
+    const std::vector<int32_t> parts(m.getFaceCount(), 0);
+    const size_t target = m.getFaceCount() / 8;
+    Mesh out;
+    std::vector<int32_t> out_parts;
+    std::ostringstream log;
+    double error = 0.0;
+    DecimateOptions options;
+    options.out_max_error = &error;
+    decimateMesh(m, parts, out, out_parts, target, log, options);
+    checkIndices(out, out_parts);
+    CHECK(out.getFaceCount() <= target);
+    CHECK(out.getFaceCount() > target * 9 / 10);
+    CHECK(isClosed(out));
+    CHECK(error > 0.0 && error < 0.05);
+    for (const auto& v : *out.vertex_data_ptr) {
+        CHECK(std::fabs(glm::length(v.position) - 2.0f) < 0.05f);
+    }
+
+    // The old signature is the same decimation.
+    Mesh legacy;
+    std::vector<int32_t> legacy_parts;
+    decimateMesh(m, parts, legacy, legacy_parts, target, log);
+    CHECK(legacy.getFaceCount() == out.getFaceCount());
+    CHECK(*legacy.vertex_data_ptr == *out.vertex_data_ptr);
+}
+
+static void testOpenGridAndParts() {
+    const uint32_t n = 48;
+    const Mesh m = makeGrid(n);
+    // Left and right halves are different parts.
+    std::vector<int32_t> parts(m.getFaceCount());
+    for (size_t f = 0; f < parts.size(); ++f) {
+        parts[f] = (f / 2) % n < n / 2 ? 0 : 1;
+    }
+    const auto in_outline = outline(m);
+
+    for (bool seal : { false, true }) {
+        Mesh out;
+        std::vector<int32_t> out_parts;
+        std::ostringstream log;
+        decimateMesh(m, parts, out, out_parts, m.getFaceCount() / 10, log, seal);
+        checkIndices(out, out_parts);
+        CHECK(out.getFaceCount() < m.getFaceCount() / 2);
+        if (!seal) CHECK(out.getFaceCount() <= m.getFaceCount() / 10);
+
+        // Flat in, flat out, and the outline keeps every edge.
+        for (const auto& v : *out.vertex_data_ptr) CHECK(v.position.z == 0.0f);
+        CHECK(outline(out) == in_outline);
+
+        // Both parts survive and the seam at x = 0.5 keeps its vertices.
+        std::set<PosKey> positions;
+        for (const auto& v : *out.vertex_data_ptr) positions.insert(posKey(v.position));
+        for (uint32_t y = 0; y <= n; ++y) {
+            CHECK(positions.count(posKey(glm::vec3(0.5f, float(y) / n, 0.0f))));
+        }
+        CHECK(std::count(out_parts.begin(), out_parts.end(), 0) > 0);
+        CHECK(std::count(out_parts.begin(), out_parts.end(), 1) > 0);
+        for (size_t f = 0; f < out.getFaceCount(); ++f) {
+            const Face& face = (*out.faces_ptr)[f];
+            float cx = 0.0f;
+            for (uint32_t v : face.v_indices) cx += (*out.vertex_data_ptr)[v].position.x;
+            CHECK((cx < 1.5f) == (out_parts[f] == 0));
+        }
+    }
+}
+
+// A flat grid whose normals turn through 90 degrees across a thin band
+// (a smoothed shading crease): geometry alone sees nothing there, so only
+// the attribute term keeps the band's vertices.
+static void testAttributeAware() {
+    const uint32_t n = 64;
+    Mesh m = makeGrid(n);
+    for (auto& v : *m.vertex_data_ptr) {
+        const float a = 1.5707964f * std::clamp((v.position.x - 0.45f) * 10.0f,
+                                                0.0f, 1.0f);
+        v.normal = glm::vec3(std::sin(a), 0.0f, std::cos(a));
+    }
+    const std::vector<int32_t> parts(m.getFaceCount(), 0);
+    auto normalSpread = [](const Mesh& out) {
+        double spread = 0.0;
+        const auto& v = *out.vertex_data_ptr;
+        for (const Face& f : *out.faces_ptr) {
+            for (int e = 0; e < 3; ++e) {
+                spread += 1.0 - glm::dot(v[f.v_indices[e]].normal,
+                                         v[f.v_indices[(e + 1) % 3]].normal);
+            }
+        }
+        return spread;
+    };
+
+    double spread[2] = {};
+    for (int aware = 0; aware < 2; ++aware) {
+        Mesh out;
+        std::vector<int32_t> out_parts;
+        std::ostringstream log;
+        DecimateOptions options;
+        options.attribute_aware = aware != 0;
+        decimateMesh(m, parts, out, out_parts, m.getFaceCount() / 6, log, options);
+        checkIndices(out, out_parts);
+        CHECK(out.getFaceCount() <= m.getFaceCount() / 6);
+        CHECK(outline(out) == outline(m));
+        spread[aware] = normalSpread(out);
+    }
+    std::printf("  normal spread over edges: geometric %.2f, attribute-aware %.2f\n",
+                spread[0], spread[1]);
+    CHECK(spread[1] < spread[0] * 0.75);
+}
+
+static void testPartitioned() {
+    const Mesh m = makeIcosphere(7, 1.0f);            // 327680 triangles
+    const std::vector<int32_t> parts(m.getFaceCount(), 0);
+    const size_t target = m.getFaceCount() / 10;
+
+    auto run = [&](ThreadPool* pool, Mesh& out, double& ms) {
+        std::vector<int32_t> out_parts;
+        std::ostringstream log;
+        DecimateOptions options;
+        options.pool = pool;
+        options.attribute_aware = true;
+        const auto t0 = std::chrono::steady_clock::now();
+        decimateMesh(m, parts, out, out_parts, target, log, options);
+        ms = msSince(t0);
+        checkIndices(out, out_parts);
+        CHECK(isClosed(out));
+        CHECK(out.getFaceCount() <= target * 11 / 10);
+        for (const auto& v : *out.vertex_data_ptr) {
+            CHECK(std::fabs(glm::length(v.position) - 1.0f) < 0.01f);
+        }
+        return log.str();
+    };
+
+    ThreadPool pool2(2), pool4(4);
+    Mesh serial, part2, part4;
+    double ms_serial = 0.0, ms2 = 0.0, ms4 = 0.0;
+    const std::string log_serial = run(nullptr, serial, ms_serial);
+    const std::string log2 = run(&pool2, part2, ms2);
+    run(&pool4, part4, ms4);
+    CHECK(log_serial.find("partitioned") == std::string::npos);
+    CHECK(log2.find("partitioned") != std::string::npos);
+
+    // Run boundaries come from the mesh alone.
+    CHECK(part2.getFaceCount() == part4.getFaceCount());
+    CHECK(*part2.vertex_data_ptr == *part4.vertex_data_ptr);
+    for (size_t f = 0; f < part2.getFaceCount(); ++f) {
+        const Face& a = (*part2.faces_ptr)[f];
+        const Face& b = (*part4.faces_ptr)[f];
+        CHECK(a.v_indices[0] == b.v_indices[0] && a.v_indices[1] == b.v_indices[1] &&
+              a.v_indices[2] == b.v_indices[2]);
+    }
+    std::printf("  icosphere %zu -> %zu tris: serial %.1f ms, partitioned "
+                "2 threads %.1f ms (%zu tris), 4 threads %.1f ms\n",
+                m.getFaceCount(), serial.getFaceCount(), ms_serial, ms2,
+                part2.getFaceCount(), ms4);
+}
+
+// Timing only: the native decimator against the OpenMesh one it replaced.
+static void benchmarkOpenMesh() {
+    const Mesh m = makeIcosphere(6, 1.0f);            // 81920 triangles
+    const std::vector<int32_t> parts(m.getFaceCount(), 0);
+    const size_t target = m.getFaceCount() / 10;
+    std::ostringstream log;
+
+    Mesh native;
+    std::vector<int32_t> native_parts;
+    auto t0 = std::chrono::steady_clock::now();
+    decimateMesh(m, parts, native, native_parts, target, log);
+    const double ms_native = msSince(t0);
+    CHECK(native.getFaceCount() <= target);
+
+    Mesh om;
+    t0 = std::chrono::steady_clock::now();
+    generateHLODWithSeamProtection(m, om, target, {}, log);
+    const double ms_om = msSince(t0);
+    CHECK(om.getFaceCount() > 0);
+    std::printf("  icosphere %zu -> %zu tris: native %.1f ms, OpenMesh %.1f ms "
+                "(%zu tris)\n", m.getFaceCount(), native.getFaceCount(),
+                ms_native, ms_om, om.getFaceCount());
+}
+
+int main() {
+    testPassThrough();
+    testClosedSphere();
+    testOpenGridAndParts();
+    testAttributeAware();
+    testPartitioned();
+    benchmarkOpenMesh();
+    std::printf("mesh_decimate_tests: %d checks passed\n", g_checks);
+    return 0;
+}
@@ -0,0 +1,470 @@
+#include "thumbnail_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace engine {
+namespace helper {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// File layout: header, then a flat run of records.
+//   header : "RWTHUMB\0", u32 format, u32 generator version
+//   blob   : u8 'B', u64 key, u16 w, u16 h, w*h*4 RGBA8 bytes
+//   stamp  : u8 'S', u16 path length, path bytes, u64 size, i64 mtime, u64 key
+// A torn record at the tail (crash mid-append) ends the scan; the next
+// append overwrites it.
+constexpr char     kMagic[8] = { 'R', 'W', 'T', 'H', 'U', 'M', 'B', '\0' };
+constexpr uint32_t kFormat = 1;
+constexpr uint64_t kHeaderBytes = sizeof(kMagic) + 2 * sizeof(uint32_t);
+constexpr uint8_t  kTagBlob  = 'B';
+constexpr uint8_t  kTagStamp = 'S';
+// Below this much dead data, compaction is not worth the rewrite.
+constexpr uint64_t kCompactMinDeadBytes = 4ull << 20;
+
+template <typename T>
+bool readPod(std::FILE* f, T& v) {
+    return std::fread(&v, sizeof(T), 1, f) == 1;
+}
+template <typename T>
+void writePod(std::FILE* f, const T& v) {
+    std::fwrite(&v, sizeof(T), 1, f);
+}
+
+// fseek / ftell take a long, which is 32 bits on Windows: a cache file past
+// 2 GiB would seek to a truncated offset.  Use the 64-bit variants.
+bool seekFile(std::FILE* f, uint64_t offset, int whence) {
+#if defined(_WIN32)
+    return _fseeki64(f, (__int64)offset, whence) == 0;
+#else
+    return fseeko(f, (off_t)offset, whence) == 0;
+#endif
+}
+int64_t tellFile(std::FILE* f) {
+#if defined(_WIN32)
+    return _ftelli64(f);
+#else
+    return (int64_t)ftello(f);
+#endif
+}
+
+uint64_t blobBytes(uint16_t w, uint16_t h) {
+    return 1 + 8 + 2 + 2 + (uint64_t)w * h * 4;
+}
+uint64_t stampBytes(const std::string& path) {
+    return 1 + 2 + path.size() + 8 + 8 + 8;
+}
+
+// FNV-1a 64 over the file's bytes, seeded with the generator version so a
+// generator change can never return an old-style thumbnail.
+bool hashFile(const std::string& path, uint32_t version, uint64_t& out) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](const uint8_t* p, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            h ^= p[i];
+            h *= 1099511628211ull;
+        }
+    };
+    mix(reinterpret_cast<const uint8_t*>(&version), sizeof(version));
+    std::vector<uint8_t> buf(1 << 20);
+    size_t n = 0;
+    while ((n = std::fread(buf.data(), 1, buf.size(), f)) > 0) mix(buf.data(), n);
+    const bool ok = !std::ferror(f);
+    std::fclose(f);
+    out = h;
+    return ok;
+}
+
+}  // namespace
+
+// ── ThumbnailCache ──────────────────────────────────────────────────────────
+
+ThumbnailCache::ThumbnailCache(const std::string& file_path,
+                               uint32_t generator_version)
+    : path_(file_path), version_(generator_version) {
+    load();
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    compact();
+    if (file_) std::fclose(file_);
+}
+
+void ThumbnailCache::load() {
+    std::error_code ec;
+    if (fs::path(path_).has_parent_path())
+        fs::create_directories(fs::path(path_).parent_path(), ec);
+
+    file_ = std::fopen(path_.c_str(), "r+b");
+    bool fresh = file_ == nullptr;
+    if (file_) {
+        char magic[sizeof(kMagic)] = {};
+        uint32_t format = 0, version = 0;
+        if (std::fread(magic, sizeof(magic), 1, file_) != 1 ||
+            std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+            !readPod(file_, format) || format != kFormat ||
+            !readPod(file_, version) || version != version_) {
+            std::fclose(file_);
+            file_ = nullptr;
+            fresh = true;
+        }
+    }
+    if (fresh) {
+        file_ = std::fopen(path_.c_str(), "w+b");
+        if (!file_) return;   // read-only location: run without persistence
+        std::fwrite(kMagic, sizeof(kMagic), 1, file_);
+        writePod(file_, kFormat);
+        writePod(file_, version_);
+        std::fflush(file_);
+        file_bytes_ = live_bytes_ = kHeaderBytes;
+        return;
+    }
+
+    seekFile(file_, 0, SEEK_END);
+    const int64_t end_pos = tellFile(file_);
+    const uint64_t end = end_pos < 0 ? 0 : (uint64_t)end_pos;
+    seekFile(file_, kHeaderBytes, SEEK_SET);
+
+    uint64_t pos = kHeaderBytes;
+    for (;;) {
+        uint8_t tag = 0;
+        if (!readPod(file_, tag)) break;
+        if (tag == kTagBlob) {
+            uint64_t key = 0;
+            uint16_t w = 0, h = 0;
+            if (!readPod(file_, key) || !readPod(file_, w) || !readPod(file_, h))
+                break;
+            // The fseek past a torn blob can succeed beyond EOF; trust only
+            // what is really there.
+            if (pos + blobBytes(w, h) > end) break;
+            const uint64_t data = (uint64_t)w * h * 4;
+            if (!seekFile(file_, data, SEEK_CUR)) break;
+            blobs_[key] = Blob{ pos + 1 + 8 + 2 + 2, w, h };
+            pos += blobBytes(w, h);
+        } else if (tag == kTagStamp) {
+            uint16_t len = 0;
+            if (!readPod(file_, len)) break;
+            std::string p(len, '\0');
+            Stamp s{};
+            if ((len && std::fread(p.data(), len, 1, file_) != 1) ||
+                !readPod(file_, s.size) || !readPod(file_, s.mtime) ||
+                !readPod(file_, s.key))
+                break;
+            stamps_[p] = s;
+            pos += stampBytes(p);
+        } else {
+            break;
+        }
+    }
+    // Cut a torn tail off the file, not just off file_bytes_: otherwise
+    // the next append lands mid-record and a later load misparses it.
+    file_bytes_ = pos;
+    if (pos < end) {
+        std::fflush(file_);
+        fs::resize_file(path_, pos, ec);
+        if (ec) {
+            // Appends would overwrite from pos and leave torn bytes past
+            // them for the next load to misparse; go without persistence.
+            std::fclose(file_);
+            file_ = nullptr;
+            blobs_.clear();
+            stamps_.clear();
+            return;
+        }
+    }
+
+    live_bytes_ = kHeaderBytes;
+    for (const auto& kv : blobs_)
+        live_bytes_ += blobBytes(kv.second.width, kv.second.height);
+    for (const auto& kv : stamps_) live_bytes_ += stampBytes(kv.first);
+}
+
+bool ThumbnailCache::contentKey(const std::string& path, uint64_t& out_key) {
+    std::error_code ec;
+    const uint64_t size = fs::file_size(path, ec);
+    if (ec) return false;
+    const int64_t mtime =
+        (int64_t)fs::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) return false;
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = stamps_.find(path);
+        if (it != stamps_.end() &&
+            it->second.size == size && it->second.mtime == mtime) {
+            out_key = it->second.key;
+            return true;
+        }
+    }
+    uint64_t key = 0;
+    if (!hashFile(path, version_, key)) return false;
+    appendStamp(path, Stamp{ size, mtime, key });
+    out_key = key;
+    return true;
+}
+
+void ThumbnailCache::appendStamp(const std::string& path, const Stamp& stamp) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = stamps_.find(path);
+    if (it != stamps_.end()) live_bytes_ -= stampBytes(path);
+    stamps_[path] = stamp;
+    live_bytes_ += stampBytes(path);
+    if (!file_ || path.size() > 0xffff) return;
+    seekFile(file_, file_bytes_, SEEK_SET);
+    writePod(file_, kTagStamp);
+    writePod(file_, (uint16_t)path.size());
+    std::fwrite(path.data(), path.size(), 1, file_);
+    writePod(file_, stamp.size);
+    writePod(file_, stamp.mtime);
+    writePod(file_, stamp.key);
+    std::fflush(file_);
+    file_bytes_ += stampBytes(path);
+}
+
+bool ThumbnailCache::find(uint64_t key, ThumbnailPixels& out) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = blobs_.find(key);
+    if (it == blobs_.end() || !file_) return false;
+    const Blob& b = it->second;
+    out.width  = b.width;
+    out.height = b.height;
+    out.rgba.resize((size_t)b.width * b.height * 4);
+    if (out.rgba.empty()) return true;
+    if (!seekFile(file_, b.offset, SEEK_SET) ||
+        std::fread(out.rgba.data(), out.rgba.size(), 1, file_) != 1) {
+        out = ThumbnailPixels{};
+        return false;
+    }
+    return true;
+}
+
+void ThumbnailCache::store(uint64_t key, const ThumbnailPixels& pixels) {
+    if (pixels.width < 0 || pixels.height < 0 ||
+        pixels.width > 0xffff || pixels.height > 0xffff ||
+        pixels.rgba.size() < (size_t)pixels.width * pixels.height * 4)
+        return;
+    const uint16_t w = (uint16_t)pixels.width, h = (uint16_t)pixels.height;
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!file_) return;
+    auto it = blobs_.find(key);
+    if (it != blobs_.end())
+        live_bytes_ -= blobBytes(it->second.width, it->second.height);
+    seekFile(file_, file_bytes_, SEEK_SET);
+    writePod(file_, kTagBlob);
+    writePod(file_, key);
+    writePod(file_, w);
+    writePod(file_, h);
+    if (w && h) std::fwrite(pixels.rgba.data(), (size_t)w * h * 4, 1, file_);
+    std::fflush(file_);
+    blobs_[key] = Blob{ file_bytes_ + 1 + 8 + 2 + 2, w, h };
+    file_bytes_ += blobBytes(w, h);
+    live_bytes_ += blobBytes(w, h);
+}
+
+size_t ThumbnailCache::entryCount() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return blobs_.size();
+}
+
+// Rewrite the file with the newest stamp per path and only the blobs some
+// stamp still points at (an edited asset's old thumbnail is garbage).
+void ThumbnailCache::compact() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!file_) return;
+    std::unordered_map<uint64_t, Blob> keep;
+    uint64_t keep_bytes = kHeaderBytes;
+    for (const auto& kv : stamps_) {
+        keep_bytes += stampBytes(kv.first);
+        auto it = blobs_.find(kv.second.key);
+        if (it != blobs_.end() && keep.emplace(it->first, it->second).second)
+            keep_bytes += blobBytes(it->second.width, it->second.height);
+    }
+    if (file_bytes_ < keep_bytes + kCompactMinDeadBytes ||
+        file_bytes_ < 2 * keep_bytes)
+        return;
+
+    const std::string tmp = path_ + ".tmp";
+    std::FILE* out = std::fopen(tmp.c_str(), "wb");
+    if (!out) return;
+    std::fwrite(kMagic, sizeof(kMagic), 1, out);
+    writePod(out, kFormat);
+    writePod(out, version_);
+    std::vector<uint8_t> data;
+    bool ok = true;
+    for (const auto& kv : keep) {
+        const Blob& b = kv.second;
+        data.resize((size_t)b.width * b.height * 4);
+        if (!data.empty() &&
+            (!seekFile(file_, b.offset, SEEK_SET) ||
+             std::fread(data.data(), data.size(), 1, file_) != 1)) {
+            ok = false;
+            break;
+        }
+        writePod(out, kTagBlob);
+        writePod(out, kv.first);
+        writePod(out, b.width);
+        writePod(out, b.height);
+        if (!data.empty()) std::fwrite(data.data(), data.size(), 1, out);
+    }
+    for (const auto& kv : stamps_) {
+        if (!ok || kv.first.size() > 0xffff) continue;
+        writePod(out, kTagStamp);
+        writePod(out, (uint16_t)kv.first.size());
+        std::fwrite(kv.first.data(), kv.first.size(), 1, out);
+        writePod(out, kv.second.size);
+        writePod(out, kv.second.mtime);
+        writePod(out, kv.second.key);
+    }
+    ok = ok && !std::ferror(out);
+    std::fclose(out);
+    std::error_code ec;
+    if (!ok) {
+        fs::remove(tmp, ec);
+        return;
+    }
+    std::fclose(file_);
+    file_ = nullptr;
+    fs::rename(tmp, path_, ec);
+    if (ec) fs::remove(tmp, ec);
+}
+
+// ── ThumbnailQueue ──────────────────────────────────────────────────────────
+
+ThumbnailQueue::ThumbnailQueue(const ThumbnailQueueOptions& options)
+    : options_(options),
+      cache_(options.cache_file, options.generator_version) {
+    const size_t n = std::max<size_t>(1, options_.num_workers);
+    for (size_t i = 0; i < n; ++i)
+        workers_.emplace_back([this] { workerLoop(); });
+}
+
+ThumbnailQueue::~ThumbnailQueue() {
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stop_ = true;
+        for (auto& kv : jobs_) kv.second->cancel = true;
+    }
+    cv_.notify_all();
+    for (auto& t : workers_)
+        if (t.joinable()) t.join();
+}
+
+void ThumbnailQueue::request(const std::string& path, int64_t src_mtime,
+                             int priority) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto it = jobs_.find(path);
+    if (it != jobs_.end()) {
+        Job& job = *it->second;
+        if (job.src_mtime == src_mtime) {
+            job.frame    = frame_;
+            job.priority = priority;
+            return;
+        }
+        // The source changed under a pending job: whatever it produces
+        // is already stale.
+        job.cancel = true;
+        queued_.erase(std::remove(queued_.begin(), queued_.end(), it->second),
+                      queued_.end());
+        jobs_.erase(it);
+    }
+    auto job = std::make_shared<Job>();
+    job->path      = path;
+    job->src_mtime = src_mtime;
+    job->priority  = priority;
+    job->frame     = frame_;
+    jobs_.emplace(path, job);
+    queued_.push_back(std::move(job));
+    cv_.notify_one();
+}
+
+void ThumbnailQueue::beginFrame() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    ++frame_;
+    for (auto it = jobs_.begin(); it != jobs_.end();) {
+        if (frame_ - it->second->frame > options_.keep_frames) {
+            it->second->cancel = true;
+            it = jobs_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    queued_.erase(std::remove_if(queued_.begin(), queued_.end(),
+                                 [](const std::shared_ptr<Job>& j) {
+                                     return j->cancel.load();
+                                 }),
+                  queued_.end());
+}
+
+bool ThumbnailQueue::poll(ThumbnailResult& out) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (done_.empty()) return false;
+    out = std::move(done_.front());
+    done_.pop_front();
+    return true;
+}
+
+size_t ThumbnailQueue::pendingCount() const {
+    std::lock_guard<std::mutex> lk(mutex_);
+    return jobs_.size();
+}
+
+void ThumbnailQueue::workerLoop() {
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            cv_.wait(lk, [this] { return stop_ || !queued_.empty(); });
+            if (stop_) return;
+            // Newest frame first, then the caller's order within it.  The
+            // queue is a few hundred entries at most; a linear pick keeps
+            // renewals (which change both keys) free.
+            auto best = queued_.begin();
+            for (auto it = queued_.begin() + 1; it != queued_.end(); ++it) {
+                const Job& a = **it;
+                const Job& b = **best;
+                if (a.frame > b.frame ||
+                    (a.frame == b.frame && a.priority < b.priority))
+                    best = it;
+            }
+            job = std::move(*best);
+            *best = std::move(queued_.back());
+            queued_.pop_back();
+        }
+        runJob(job);
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto it = jobs_.find(job->path);
+        if (it != jobs_.end() && it->second == job) jobs_.erase(it);
+    }
+}
+
+void ThumbnailQueue::runJob(const std::shared_ptr<Job>& job) {
+    ThumbnailResult result;
+    result.path      = job->path;
+    result.src_mtime = job->src_mtime;
+
+    uint64_t key = 0;
+    const bool keyed = cache_.contentKey(job->path, key);
+    if (!keyed || !cache_.find(key, result.pixels)) {
+        if (job->cancel) return;
+        ThumbnailPixels px;
+        const bool ok = options_.generate &&
+                        options_.generate(job->path, job->cancel, px);
+        // A cancelled generator may have bailed half-way; only a finished
+        // answer (thumbnail or a definite "none") is worth remembering.
+        if (job->cancel && !ok) return;
+        if (!ok) px = ThumbnailPixels{};
+        if (keyed) cache_.store(key, px);
+        result.pixels = std::move(px);
+    }
+    if (job->cancel) return;
+    std::lock_guard<std::mutex> lk(mutex_);
+    done_.push_back(std::move(result));
+}
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,159 @@
+#pragma once
+//
+// thumbnail_cache.h — background thumbnail generation for the editor's
+// Content / File Browser, backed by one persistent cache file.
+//
+// Thumbnails used to be produced on the UI thread (image / DDS decode,
+// .rwtex read, a CPU orbit raster for models) and written as one
+// ".thumbnails/<file>.png" sidecar per asset, then uploaded as one GPU
+// texture each.  Opening a large folder stalled the editor for seconds and
+// left thousands of small PNGs behind.
+//
+// ThumbnailCache is the on-disk half: a single append-only file of
+// RGBA8 thumbnails keyed by a 64-bit hash of the SOURCE CONTENT (plus the
+// generator version), so a renamed or copied asset reuses its thumbnail and
+// an edited one misses.  To avoid re-hashing unchanged files every session
+// it also records (path, size, mtime) -> content key; a file is hashed again
+// only when its size or mtime moves.  Later records supersede earlier ones;
+// the file is compacted on close once more than half of it is dead.
+//
+// ThumbnailQueue is the work half: worker threads pull requests in priority
+// order (most recently requested frame first, then the caller's priority —
+// the browser passes the tile's position in the visible rows), consult the
+// cache, run the caller's generator on a miss and hand finished pixels back
+// through poll().  Requests not renewed for `keep_frames` frames — the tile
+// scrolled away — are dropped, and a generator already running for one sees
+// its cancel flag set.
+//
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+namespace helper {
+
+struct ThumbnailPixels {
+    int                  width  = 0;     // 0 x 0: no thumbnail possible
+    int                  height = 0;
+    std::vector<uint8_t> rgba;           // width * height * 4
+};
+
+class ThumbnailCache {
+public:
+    // Opens (or creates) the cache file and indexes its records.  A file
+    // written by a different `generator_version` is discarded.
+    ThumbnailCache(const std::string& file_path, uint32_t generator_version);
+    ~ThumbnailCache();
+
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    // Content key of `path`.  Reuses the recorded key while size and mtime
+    // match; otherwise hashes the file and records the new key.  False if
+    // the file cannot be read.
+    bool contentKey(const std::string& path, uint64_t& out_key);
+
+    // Thumbnail stored under `key` (possibly the 0 x 0 "none" marker).
+    bool find(uint64_t key, ThumbnailPixels& out);
+    void store(uint64_t key, const ThumbnailPixels& pixels);
+
+    size_t entryCount() const;
+
+private:
+    struct Blob  { uint64_t offset; uint16_t width, height; };
+    struct Stamp { uint64_t size; int64_t mtime; uint64_t key; };
+
+    void load();
+    void compact();
+    void appendStamp(const std::string& path, const Stamp& stamp);
+
+    std::string   path_;
+    uint32_t      version_;
+    std::FILE*    file_ = nullptr;
+    uint64_t      file_bytes_ = 0;
+    uint64_t      live_bytes_ = 0;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Blob>     blobs_;
+    std::unordered_map<std::string, Stamp> stamps_;
+};
+
+struct ThumbnailQueueOptions {
+    std::string cache_file;
+    // Bump when the generator's output changes; invalidates the cache.
+    uint32_t    generator_version = 1;
+    size_t      num_workers = 2;
+    // Frames a request survives without being renewed.
+    uint32_t    keep_frames = 2;
+    // Produce the thumbnail for `path`.  Runs on a worker thread; should
+    // poll `cancel` between expensive stages and give up when it is set.
+    // Return false for "no thumbnail for this file" (cached as such).
+    std::function<bool(const std::string& path,
+                       const std::atomic<bool>& cancel,
+                       ThumbnailPixels& out)> generate;
+};
+
+struct ThumbnailResult {
+    std::string     path;
+    int64_t         src_mtime = 0;   // as passed to request()
+    ThumbnailPixels pixels;          // 0 x 0 when none could be produced
+};
+
+class ThumbnailQueue {
+public:
+    explicit ThumbnailQueue(const ThumbnailQueueOptions& options);
+    ~ThumbnailQueue();
+
+    ThumbnailQueue(const ThumbnailQueue&) = delete;
+    ThumbnailQueue& operator=(const ThumbnailQueue&) = delete;
+
+    // Ask for (or renew) `path`.  Lower `priority` runs sooner within a
+    // frame.  `src_mtime` identifies the version wanted; it is echoed in
+    // the result so the caller can discard one that raced an edit.
+    void request(const std::string& path, int64_t src_mtime, int priority);
+
+    // Advance the frame clock and drop requests that were not renewed.
+    void beginFrame();
+
+    // Pop one finished thumbnail.  UI thread.
+    bool poll(ThumbnailResult& out);
+
+    size_t pendingCount() const;
+
+private:
+    struct Job {
+        std::string       path;
+        int64_t           src_mtime = 0;
+        int               priority = 0;
+        uint64_t          frame = 0;
+        std::atomic<bool> cancel{false};
+    };
+
+    void workerLoop();
+    void runJob(const std::shared_ptr<Job>& job);
+
+    ThumbnailQueueOptions options_;
+    ThumbnailCache        cache_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    // Queued and running jobs by path (a path is never worked twice at once).
+    std::unordered_map<std::string, std::shared_ptr<Job>> jobs_;
+    std::vector<std::shared_ptr<Job>> queued_;
+    std::deque<ThumbnailResult> done_;
+    uint64_t frame_ = 0;
+
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace helper
+}  // namespace engine
@@ -0,0 +1,46 @@
+// zstd_block.cpp — see zstd_block.h.
+#include "helper/zstd_block.h"
+
+#if defined(HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace engine {
+namespace helper {
+
+#if defined(HAS_ZSTD)
+
+bool zstdAvailable() { return true; }
+
+bool zstdCompress(const void* src, size_t size, std::vector<uint8_t>& out,
+                  int level, bool must_shrink) {
+    if (size == 0 && must_shrink) return false;
+    out.resize(ZSTD_compressBound(size));
+    const size_t n = ZSTD_compress(out.data(), out.size(), src, size, level);
+    if (ZSTD_isError(n) || (must_shrink && n >= size)) return false;
+    out.resize(n);
+    return true;
+}
+
+bool zstdDecompress(const void* src, size_t size, void* dst,
+                    size_t dst_size) {
+    // The frame header records the content size; check it before
+    // decoding so a block from another file cannot overrun `dst`.
+    const unsigned long long content = ZSTD_getFrameContentSize(src, size);
+    if (content != dst_size) return false;
+    const size_t n = ZSTD_decompress(dst, dst_size, src, size);
+    return !ZSTD_isError(n) && n == dst_size;
+}
+
+#else // !HAS_ZSTD — blocks stay raw
+
+bool zstdAvailable() { return false; }
+bool zstdCompress(const void*, size_t, std::vector<uint8_t>&, int, bool) {
+    return false;
+}
+bool zstdDecompress(const void*, size_t, void*, size_t) { return false; }
+
+#endif // HAS_ZSTD
+
+} // namespace helper
+} // namespace engine
@@ -0,0 +1,38 @@
+#pragma once
+//
+// zstd_block.h — optional zstd (de)compression of binary asset blocks.
+//
+// Compiled against libzstd only when CMake found it (HAS_ZSTD), the same
+// way the TTS backend depends on HAS_SHERPA_ONNX.  Without it writers keep
+// their blocks raw (zstdCompress() returns false) and readers refuse a
+// compressed block (zstdDecompress() returns false), so a build without
+// zstd still reads and writes every uncompressed file.
+//
+// Blocks are whole: the caller records the raw size next to the stored
+// bytes and decompresses into a buffer of exactly that size.
+//
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+namespace helper {
+
+// Built with zstd support.
+bool zstdAvailable();
+
+// Compress `size` bytes at `level` (1..19) into `out` (resized to fit).
+// False — `out` unspecified — when zstd is unavailable or the result is
+// not smaller than the input, i.e. when the block should be stored raw.
+// Formats that require every block to be a zstd frame (KTX2) pass
+// `must_shrink` = false and only fail without zstd.
+bool zstdCompress(const void* src, size_t size, std::vector<uint8_t>& out,
+                  int level = 9, bool must_shrink = true);
+
+// Decompress a whole block into `dst`, which must hold exactly
+// `dst_size` bytes.  False when zstd is unavailable, the data is corrupt
+// or it does not decode to exactly `dst_size` bytes.
+bool zstdDecompress(const void* src, size_t size, void* dst, size_t dst_size);
+
+} // namespace helper
+} // namespace engine
@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 #include <thread>
 #include "renderer_structs.h"
 
@@ -32,6 +33,13 @@ public:
     // is safe; pass std::thread::id{} to clear.
     virtual void registerLoaderThread(std::thread::id id) = 0;
 
+    // Called at the top of every loader-thread setupTransientCommandBuffer().
+    // The async mesh loader installs its UploadScheduler::flush() here so
+    // batched copies are always submitted ahead of a transient command
+    // buffer that may read them (mip generation, BLAS builds).  Set and
+    // cleared from the loader thread itself; pass {} to clear.
+    virtual void setLoaderTransientPrologue(std::function<void()> prologue) = 0;
+
     // ── Async loader queue (Layer 1 of async mesh load) ──────────────────
     // A second queue intended for worker-thread uploads that must not block
     // the main frame tick. On hardware with a dedicated transfer family we
@@ -157,7 +165,9 @@ public:
     // is the only way to find a leak or an over-allocation in a scene
     // with ~9k live buffers.  Buffer totals are exact; image totals are
     // estimated from extent x format (mip chains and layer counts are
-    // not tracked, so a mipped texture reads low by up to ~33%).
+    // not tracked, so a mipped texture reads low by up to ~33%).  Also
+    // prints the sub-allocator's per-heap block / allocation totals
+    // against the driver's VK_EXT_memory_budget.
     virtual void dumpVramBreakdown(const char* tag) = 0;
     virtual void beginDeferredBufferWrites() = 0;
     virtual void flushDeferredBufferWrites() = 0;
@@ -183,6 +193,20 @@ public:
         const MemoryAllocateFlags& allocate_flags,
         const std::source_location& src_location =
             std::source_location::current()) = 0;
+    // Pooled variant: sub-allocates from a shared per-memory-type block
+    // (see memory_allocator.h) instead of one vkAllocateMemory per
+    // resource.  The returned memory binds / maps exactly like a private
+    // allocation — bind*Memory and mapMemory add the sub-allocation offset
+    // internally — so callers only change how they ask for it.  Huge
+    // requests are still given a dedicated allocation.  Safe to call from
+    // the loader thread.
+    virtual std::shared_ptr<DeviceMemory> allocateMemory(
+        const MemoryRequirements& requirements,
+        const MemoryPropertyFlags& properties,
+        const MemoryAllocateFlags& allocate_flags,
+        bool is_image,
+        const std::source_location& src_location =
+            std::source_location::current()) = 0;
     virtual MemoryRequirements getBufferMemoryRequirements(std::shared_ptr<Buffer> buffer) = 0;
     virtual MemoryRequirements getImageMemoryRequirements(std::shared_ptr<Image> image) = 0;
     virtual std::shared_ptr<Buffer> createBuffer(
@@ -234,6 +258,12 @@ public:
         const std::source_location& src_location) = 0;
     virtual std::shared_ptr<Semaphore> createSemaphore(
         const std::source_location& src_location) = 0;
+    // VK_SEMAPHORE_TYPE_TIMELINE semaphore.  Signalled with explicit values
+    // through Helper::submitQueue's signal_semaphore_values and waited on
+    // with waitForSemaphores / polled with getSemaphoreCounterValue.
+    virtual std::shared_ptr<Semaphore> createTimelineSemaphore(
+        uint64_t initial_value,
+        const std::source_location& src_location) = 0;
     virtual std::shared_ptr<Fence> createFence(
         const std::source_location& src_location,
         bool signaled = false) = 0;
@@ -271,6 +301,8 @@ public:
     // Used by the async loader poll loop (vkGetFenceStatus path).
     virtual bool isFenceSignaled(const std::shared_ptr<Fence>& fence) = 0;
     virtual void waitForSemaphores(const std::vector<std::shared_ptr<Semaphore>>& semaphores, uint64_t value) = 0;
+    // Non-blocking read of a timeline semaphore's current value.
+    virtual uint64_t getSemaphoreCounterValue(const std::shared_ptr<Semaphore>& semaphore) = 0;
     virtual void waitIdle() = 0;
     virtual void getAccelerationStructureBuildSizes(
         AccelerationStructureBuildType         as_build_type,
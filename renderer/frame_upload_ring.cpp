@@ -0,0 +1,125 @@
+//
+// frame_upload_ring.cpp — frame-clock staging for uploads recorded on the
+// frame's command buffer.  See the header for the retirement model.
+//
+#include <stdexcept>
+
+#include "frame_upload_ring.h"
+
+namespace engine {
+namespace renderer {
+
+FrameUploadRing::FrameUploadRing(uint64_t capacity, uint64_t retire_frames)
+    : retire_frames_(retire_frames),
+      ring_(capacity) {
+}
+
+FrameUploadRing::~FrameUploadRing() {
+    destroy();
+}
+
+void FrameUploadRing::beginFrame(uint64_t frame) {
+    if (frame <= frame_) return;
+    ring_.closeBatch(frame_ + retire_frames_);
+    ring_.reclaim(frame);
+    size_t kept = 0;
+    for (auto& d : dedicated_) {
+        if (d.frame + retire_frames_ > frame) {
+            dedicated_[kept++] = std::move(d);
+        } else {
+            release(d);
+        }
+    }
+    dedicated_.resize(kept);
+    frame_ = frame;
+}
+
+uint8_t* FrameUploadRing::allocate(
+    const std::shared_ptr<Device>& device,
+    uint64_t size,
+    uint64_t alignment,
+    std::shared_ptr<Buffer>& out_buffer,
+    uint64_t& out_offset) {
+    device_ = device;
+
+    // Anything bigger than half the ring would crowd out the rest of the
+    // frame's uploads; like a full ring, it gets a buffer of its own.
+    uint64_t offset = 0;
+    if (size <= ring_.capacity() / 2) {
+        if (!ring_buffer_) {
+            device_->createBuffer(
+                ring_.capacity(),
+                SET_FLAG_BIT(BufferUsage, TRANSFER_SRC_BIT),
+                SET_FLAG_BIT(MemoryProperty, HOST_VISIBLE_BIT) |
+                SET_FLAG_BIT(MemoryProperty, HOST_COHERENT_BIT),
+                0,
+                ring_buffer_,
+                ring_memory_,
+                std::source_location::current());
+            // Mapped for the ring's lifetime; HOST_COHERENT, so the copy
+            // recorded after the memcpy needs no flush.
+            ring_mapped_ = static_cast<uint8_t*>(
+                device_->mapMemory(ring_memory_, ring_.capacity()));
+            if (!ring_mapped_) {
+                throw std::runtime_error("frame upload ring: failed to map staging ring");
+            }
+        }
+        if (ring_.allocate(size, alignment, offset)) {
+            out_buffer = ring_buffer_;
+            out_offset = offset;
+            return ring_mapped_ + offset;
+        }
+    }
+
+    Dedicated d;
+    d.frame = frame_;
+    d.size = size;
+    device_->createBuffer(
+        size,
+        SET_FLAG_BIT(BufferUsage, TRANSFER_SRC_BIT),
+        SET_FLAG_BIT(MemoryProperty, HOST_VISIBLE_BIT) |
+        SET_FLAG_BIT(MemoryProperty, HOST_COHERENT_BIT),
+        0,
+        d.buffer,
+        d.memory,
+        std::source_location::current());
+    auto* mapped = static_cast<uint8_t*>(device_->mapMemory(d.memory, size));
+    if (!mapped) {
+        device_->destroyBuffer(d.buffer);
+        device_->freeMemory(d.memory);
+        throw std::runtime_error("frame upload ring: failed to map dedicated staging");
+    }
+    out_buffer = d.buffer;
+    out_offset = 0;
+    dedicated_bytes_ += size;
+    dedicated_.push_back(std::move(d));
+    return mapped;
+}
+
+void FrameUploadRing::release(Dedicated& d) {
+    device_->unmapMemory(d.memory);
+    device_->destroyBuffer(d.buffer);
+    device_->freeMemory(d.memory);
+    dedicated_bytes_ -= d.size;
+}
+
+void FrameUploadRing::destroy() {
+    for (auto& d : dedicated_) {
+        release(d);
+    }
+    dedicated_.clear();
+    if (ring_buffer_) {
+        device_->unmapMemory(ring_memory_);
+        device_->destroyBuffer(ring_buffer_);
+        device_->freeMemory(ring_memory_);
+        ring_buffer_.reset();
+        ring_memory_.reset();
+        ring_mapped_ = nullptr;
+    }
+    // Whatever the ring still counted belonged to the frames just waited
+    // on; start over clean.
+    ring_ = StagingRing(ring_.capacity());
+}
+
+} // namespace renderer
+} // namespace engine
@@ -0,0 +1,87 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// frame_upload_ring.h — staging for uploads recorded on the frame's own
+// graphics command buffer.
+//
+// Render-thread updates of resources the frame already samples (scene-DB
+// ranges, thumbnail atlas slots, streamed texture mips) must be ordered
+// against the frames in flight.  A transient submit on another queue is
+// not: it transitions a live image while the graphics queue may still be
+// reading it.  Recording the copy into the frame's command buffer, behind
+// a barrier, gets the ordering for free — the same queue runs the earlier
+// frames first — and leaves one question: when may the staging bytes be
+// reused?  This ring answers it with the frame clock instead of fences:
+// bytes staged in frame F are handed out again once beginFrame() is called
+// with F + retire_frames, by which time the frame that read them has been
+// waited on.
+//
+// One persistently-mapped HOST_VISIBLE buffer used as a StagingRing; a
+// request the ring cannot hold this frame gets a dedicated buffer that
+// ages the same way.  Not thread-safe: the owner's render thread only.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "renderer.h"
+#include "staging_ring.h"
+
+namespace engine {
+namespace renderer {
+
+class FrameUploadRing {
+public:
+    // `retire_frames` must exceed the frames in flight (kMaxFramesInFlight
+    // + 1 is the cushion used elsewhere).  The buffer is created lazily on
+    // the first allocate().
+    FrameUploadRing(uint64_t capacity, uint64_t retire_frames);
+    ~FrameUploadRing();
+
+    FrameUploadRing(const FrameUploadRing&) = delete;
+    FrameUploadRing& operator=(const FrameUploadRing&) = delete;
+
+    // Start `frame` (monotonically increasing): seals what the previous
+    // frame staged and releases everything retire_frames old.
+    void beginFrame(uint64_t frame);
+
+    // `size` bytes of staging for the current frame, aligned to `alignment`
+    // (power of two).  Returns the host pointer to write them through and
+    // the buffer / offset to copy from.
+    uint8_t* allocate(
+        const std::shared_ptr<Device>& device,
+        uint64_t size,
+        uint64_t alignment,
+        std::shared_ptr<Buffer>& out_buffer,
+        uint64_t& out_offset);
+
+    // Frees the ring and every dedicated buffer.  The device must be idle
+    // (or at least done with every frame that used it).
+    void destroy();
+
+    uint64_t capacity() const { return ring_.capacity(); }
+    uint64_t usedBytes() const { return ring_.usedBytes(); }
+    uint64_t dedicatedBytes() const { return dedicated_bytes_; }
+
+private:
+    struct Dedicated {
+        uint64_t                      frame;
+        uint64_t                      size;
+        std::shared_ptr<Buffer>       buffer;
+        std::shared_ptr<DeviceMemory> memory;
+    };
+
+    void release(Dedicated& d);
+
+    std::shared_ptr<Device>       device_;
+    uint64_t                      retire_frames_;
+    uint64_t                      frame_ = 0;
+    std::shared_ptr<Buffer>       ring_buffer_;
+    std::shared_ptr<DeviceMemory> ring_memory_;
+    uint8_t*                      ring_mapped_ = nullptr;
+    StagingRing                   ring_;
+    std::vector<Dedicated>        dedicated_;
+    uint64_t                      dedicated_bytes_ = 0;
+};
+
+} // namespace renderer
+} // namespace engine
@@ -0,0 +1,790 @@
+#include "memory_allocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
+namespace engine {
+namespace renderer {
+
+namespace {
+inline uint32_t highestBit(uint64_t v) {
+    assert(v != 0);
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanReverse64(&idx, v);
+    return static_cast<uint32_t>(idx);
+#else
+    return 63u - static_cast<uint32_t>(__builtin_clzll(v));
+#endif
+}
+
+inline uint32_t lowestBit(uint64_t v) {
+    assert(v != 0);
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, v);
+    return static_cast<uint32_t>(idx);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(v));
+#endif
+}
+
+inline uint64_t alignUp(uint64_t v, uint64_t a) {
+    return a > 1 ? (v + a - 1) / a * a : v;
+}
+
+constexpr uint32_t kInvalidIndex = 0xffffffffu;
+} // namespace
+
+// ── TlsfBlockMetadata ────────────────────────────────────────────────────────
+TlsfBlockMetadata::TlsfBlockMetadata(uint64_t size) : size_(size) {
+    for (auto& row : heads_) {
+        row.fill(kInvalidNode);
+    }
+    first_node_ = newNode();
+    nodes_[first_node_].offset = 0;
+    nodes_[first_node_].size = size;
+    nodes_[first_node_].is_free = true;
+    insertFree(first_node_);
+}
+
+void TlsfBlockMetadata::mapping(uint64_t size, uint32_t& fl, uint32_t& sl) {
+    if (size < kSmallLimit) {
+        fl = 0;
+        sl = static_cast<uint32_t>(size / (kSmallLimit / kSlCount));
+        return;
+    }
+    const uint32_t msb = highestBit(size);
+    fl = msb - kSmallShift + 1;
+    sl = static_cast<uint32_t>(size >> (msb - kSlBits)) - kSlCount;
+}
+
+uint32_t TlsfBlockMetadata::findFree(uint64_t size) const {
+    // Round the request up to the start of the next size class so ANY
+    // range in the class we land in is big enough ("good fit"); without
+    // this the head of the list would need a size check and a walk.
+    if (size < kSmallLimit) {
+        size = alignUp(size, kSmallLimit / kSlCount);
+    }
+    else {
+        const uint64_t round = (1ull << (highestBit(size) - kSlBits)) - 1;
+        if (size > ~0ull - round) {
+            return kInvalidNode;
+        }
+        size += round;
+    }
+    uint32_t fl, sl;
+    mapping(size, fl, sl);
+    if (fl >= kFlCount) {
+        return kInvalidNode;
+    }
+
+    uint32_t sl_map = sl < kSlCount ? (sl_bitmap_[fl] & (~0u << sl)) : 0;
+    if (sl_map == 0) {
+        const uint64_t fl_map =
+            fl + 1 < 64 ? (fl_bitmap_ & (~0ull << (fl + 1))) : 0;
+        if (fl_map == 0) {
+            return kInvalidNode;
+        }
+        fl = lowestBit(fl_map);
+        sl_map = sl_bitmap_[fl];
+        assert(sl_map != 0);
+    }
+    sl = lowestBit(sl_map);
+    return heads_[fl][sl];
+}
+
+uint32_t TlsfBlockMetadata::findFreeExact(uint64_t size, uint64_t alignment) const {
+    // Good-fit rounding skips ranges that are only just big enough, which
+    // would leave the last slot of a block unusable for a run of equal-size
+    // requests.  Walk the few classes between `size` and `size + align - 1`
+    // and test each range for an actual fit.
+    uint32_t fl0, sl0, fl1, sl1;
+    mapping(size, fl0, sl0);
+    mapping(size + (alignment - 1), fl1, sl1);
+    for (uint32_t fl = fl0; fl <= fl1 && fl < kFlCount; ++fl) {
+        const uint32_t sl_begin = fl == fl0 ? sl0 : 0;
+        const uint32_t sl_end = fl == fl1 ? sl1 : kSlCount - 1;
+        for (uint32_t sl = sl_begin; sl <= sl_end; ++sl) {
+            for (uint32_t id = heads_[fl][sl]; id != kInvalidNode;
+                 id = nodes_[id].next_free) {
+                const Node& n = nodes_[id];
+                const uint64_t pad = alignUp(n.offset, alignment) - n.offset;
+                if (n.size >= pad && n.size - pad >= size) {
+                    return id;
+                }
+            }
+        }
+    }
+    return kInvalidNode;
+}
+
+uint32_t TlsfBlockMetadata::newNode() {
+    if (!recycled_nodes_.empty()) {
+        const uint32_t id = recycled_nodes_.back();
+        recycled_nodes_.pop_back();
+        nodes_[id] = Node{};
+        return id;
+    }
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void TlsfBlockMetadata::releaseNode(uint32_t id) {
+    nodes_[id] = Node{};
+    recycled_nodes_.push_back(id);
+}
+
+void TlsfBlockMetadata::insertFree(uint32_t id) {
+    Node& n = nodes_[id];
+    uint32_t fl, sl;
+    mapping(n.size, fl, sl);
+    n.prev_free = kInvalidNode;
+    n.next_free = heads_[fl][sl];
+    if (n.next_free != kInvalidNode) {
+        nodes_[n.next_free].prev_free = id;
+    }
+    heads_[fl][sl] = id;
+    fl_bitmap_ |= 1ull << fl;
+    sl_bitmap_[fl] |= 1u << sl;
+}
+
+void TlsfBlockMetadata::removeFree(uint32_t id) {
+    Node& n = nodes_[id];
+    uint32_t fl, sl;
+    mapping(n.size, fl, sl);
+    if (n.prev_free != kInvalidNode) {
+        nodes_[n.prev_free].next_free = n.next_free;
+    }
+    else {
+        heads_[fl][sl] = n.next_free;
+    }
+    if (n.next_free != kInvalidNode) {
+        nodes_[n.next_free].prev_free = n.prev_free;
+    }
+    n.prev_free = n.next_free = kInvalidNode;
+    if (heads_[fl][sl] == kInvalidNode) {
+        sl_bitmap_[fl] &= ~(1u << sl);
+        if (sl_bitmap_[fl] == 0) {
+            fl_bitmap_ &= ~(1ull << fl);
+        }
+    }
+}
+
+uint32_t TlsfBlockMetadata::allocate(
+    uint64_t size,
+    uint64_t alignment,
+    void* user_data,
+    uint64_t* out_offset) {
+    size = std::max<uint64_t>(size, 1);
+    alignment = std::max<uint64_t>(alignment, 1);
+    const uint64_t search = size + (alignment - 1);
+    if (search < size || size > size_) {
+        return kInvalidNode;
+    }
+    uint32_t id = search <= size_ ? findFree(search) : kInvalidNode;
+    if (id == kInvalidNode) {
+        id = findFreeExact(size, alignment);
+        if (id == kInvalidNode) {
+            return kInvalidNode;
+        }
+    }
+    removeFree(id);
+
+    // Leading pad from alignment becomes its own free range.  Its left
+    // neighbour is necessarily allocated (free neighbours are always
+    // merged), so no coalescing is needed here.
+    const uint64_t aligned = alignUp(nodes_[id].offset, alignment);
+    const uint64_t pad = aligned - nodes_[id].offset;
+    if (pad > 0) {
+        const uint32_t p = newNode();
+        Node& n = nodes_[id];
+        Node& pn = nodes_[p];
+        pn.offset = n.offset;
+        pn.size = pad;
+        pn.is_free = true;
+        pn.prev_phys = n.prev_phys;
+        pn.next_phys = id;
+        if (n.prev_phys != kInvalidNode) {
+            nodes_[n.prev_phys].next_phys = p;
+        }
+        else {
+            first_node_ = p;
+        }
+        n.prev_phys = p;
+        n.offset = aligned;
+        n.size -= pad;
+        insertFree(p);
+    }
+
+    const uint64_t tail = nodes_[id].size - size;
+    if (tail > 0) {
+        const uint32_t t = newNode();
+        Node& n = nodes_[id];
+        Node& tn = nodes_[t];
+        tn.offset = n.offset + size;
+        tn.size = tail;
+        tn.is_free = true;
+        tn.prev_phys = id;
+        tn.next_phys = n.next_phys;
+        if (n.next_phys != kInvalidNode) {
+            nodes_[n.next_phys].prev_phys = t;
+        }
+        n.next_phys = t;
+        n.size = size;
+        insertFree(t);
+    }
+
+    Node& n = nodes_[id];
+    n.is_free = false;
+    n.user_data = user_data;
+    used_bytes_ += n.size;
+    ++allocation_count_;
+    if (out_offset) {
+        *out_offset = n.offset;
+    }
+    return id;
+}
+
+void TlsfBlockMetadata::free(uint32_t id) {
+    assert(id < nodes_.size() && !nodes_[id].is_free);
+    used_bytes_ -= nodes_[id].size;
+    --allocation_count_;
+    nodes_[id].is_free = true;
+    nodes_[id].user_data = nullptr;
+
+    const uint32_t next = nodes_[id].next_phys;
+    if (next != kInvalidNode && nodes_[next].is_free) {
+        removeFree(next);
+        nodes_[id].size += nodes_[next].size;
+        nodes_[id].next_phys = nodes_[next].next_phys;
+        if (nodes_[id].next_phys != kInvalidNode) {
+            nodes_[nodes_[id].next_phys].prev_phys = id;
+        }
+        releaseNode(next);
+    }
+
+    uint32_t merged = id;
+    const uint32_t prev = nodes_[id].prev_phys;
+    if (prev != kInvalidNode && nodes_[prev].is_free) {
+        removeFree(prev);
+        nodes_[prev].size += nodes_[id].size;
+        nodes_[prev].next_phys = nodes_[id].next_phys;
+        if (nodes_[prev].next_phys != kInvalidNode) {
+            nodes_[nodes_[prev].next_phys].prev_phys = prev;
+        }
+        releaseNode(id);
+        merged = prev;
+    }
+    insertFree(merged);
+}
+
+uint64_t TlsfBlockMetadata::largestFreeRange() const {
+    uint64_t best = 0;
+    for (uint32_t id = first_node_; id != kInvalidNode; id = nodes_[id].next_phys) {
+        if (nodes_[id].is_free) {
+            best = std::max(best, nodes_[id].size);
+        }
+    }
+    return best;
+}
+
+void TlsfBlockMetadata::forEachAllocation(
+    const std::function<void(uint32_t, uint64_t, uint64_t, void*)>& fn) const {
+    for (uint32_t id = first_node_; id != kInvalidNode; id = nodes_[id].next_phys) {
+        if (!nodes_[id].is_free) {
+            fn(id, nodes_[id].offset, nodes_[id].size, nodes_[id].user_data);
+        }
+    }
+}
+
+bool TlsfBlockMetadata::validate() const {
+    uint64_t expect_offset = 0;
+    uint64_t used = 0;
+    uint32_t allocs = 0;
+    uint32_t free_nodes = 0;
+    uint32_t prev = kInvalidNode;
+    for (uint32_t id = first_node_; id != kInvalidNode; id = nodes_[id].next_phys) {
+        const Node& n = nodes_[id];
+        if (n.offset != expect_offset || n.prev_phys != prev || n.size == 0) {
+            return false;
+        }
+        if (n.is_free) {
+            if (prev != kInvalidNode && nodes_[prev].is_free) {
+                return false;   // two adjacent free ranges were not merged
+            }
+            ++free_nodes;
+        }
+        else {
+            used += n.size;
+            ++allocs;
+        }
+        expect_offset += n.size;
+        prev = id;
+    }
+    if (expect_offset != size_ || used != used_bytes_ ||
+        allocs != allocation_count_) {
+        return false;
+    }
+
+    uint32_t listed = 0;
+    for (uint32_t fl = 0; fl < kFlCount; ++fl) {
+        for (uint32_t sl = 0; sl < kSlCount; ++sl) {
+            const bool bit = (sl_bitmap_[fl] >> sl) & 1u;
+            if (bit != (heads_[fl][sl] != kInvalidNode)) {
+                return false;
+            }
+            for (uint32_t id = heads_[fl][sl]; id != kInvalidNode;
+                 id = nodes_[id].next_free) {
+                uint32_t f, s;
+                mapping(nodes_[id].size, f, s);
+                if (!nodes_[id].is_free || f != fl || s != sl) {
+                    return false;
+                }
+                ++listed;
+            }
+        }
+        if (((fl_bitmap_ >> fl) & 1ull) != (sl_bitmap_[fl] != 0 ? 1ull : 0ull)) {
+            return false;
+        }
+    }
+    return listed == free_nodes;
+}
+
+// ── MemoryAllocator ──────────────────────────────────────────────────────────
+MemoryAllocator::MemoryAllocator(
+    const MemoryTypeTable& memory_types,
+    MemoryBlockBackend backend,
+    const MemoryAllocatorConfig& config)
+    : memory_types_(memory_types),
+      backend_(std::move(backend)),
+      config_(config) {
+    heap_counters_ =
+        std::make_unique<HeapCounters[]>(std::max<size_t>(memory_types_.heaps.size(), 1));
+    for (size_t i = 0; i < memory_types_.heaps.size(); ++i) {
+        const auto& h = memory_types_.heaps[i];
+        heap_counters_[i].budget.store(h.budget ? h.budget : h.size / 10 * 8);
+    }
+}
+
+MemoryAllocator::~MemoryAllocator() {
+    std::lock_guard<std::mutex> lock(pools_mutex_);
+    uint32_t leaked = 0;
+    for (auto& pool : pools_) {
+        std::lock_guard<std::mutex> pool_lock(pool->mutex);
+        for (auto& block : pool->blocks) {
+            if (block.handle == 0) {
+                continue;
+            }
+            leaked += block.metadata->allocationCount();
+            backend_.free_block(pool->memory_type, block.handle, block.mapped != nullptr);
+        }
+        pool->blocks.clear();
+    }
+    if (leaked) {
+        fprintf(stderr,
+                "[mem_alloc] WARNING: %u sub-allocation(s) still alive at allocator destruction.\n",
+                leaked);
+    }
+}
+
+uint32_t MemoryAllocator::findMemoryType(
+    uint32_t memory_type_bits,
+    MemoryPropertyFlags required_flags) const {
+    for (uint32_t i = 0; i < memory_types_.types.size(); ++i) {
+        if ((memory_type_bits & (1u << i)) &&
+            (memory_types_.types[i].property_flags & required_flags) == required_flags) {
+            return i;
+        }
+    }
+    return kInvalidIndex;
+}
+
+bool MemoryAllocator::isHostVisible(uint32_t memory_type) const {
+    return (memory_types_.types[memory_type].property_flags &
+            static_cast<uint32_t>(MemoryPropertyFlagBits::HOST_VISIBLE_BIT)) != 0;
+}
+
+uint64_t MemoryAllocator::blockSizeFor(uint32_t memory_type) const {
+    const uint32_t heap = memory_types_.types[memory_type].heap_index;
+    uint64_t block = config_.preferred_block_size;
+    if (heap < memory_types_.heaps.size() && memory_types_.heaps[heap].size > 0) {
+        block = std::min(block,
+                         std::max<uint64_t>(memory_types_.heaps[heap].size / 8,
+                                            1ull << 20));
+    }
+    return block;
+}
+
+MemoryAllocator::Pool& MemoryAllocator::poolFor(
+    uint32_t memory_type,
+    MemoryAllocateFlags allocate_flags,
+    AllocationKind kind,
+    uint32_t* out_pool_index) {
+    std::lock_guard<std::mutex> lock(pools_mutex_);
+    for (uint32_t i = 0; i < pools_.size(); ++i) {
+        const Pool& p = *pools_[i];
+        if (p.memory_type == memory_type &&
+            p.allocate_flags == allocate_flags &&
+            p.kind == kind) {
+            *out_pool_index = i;
+            return *pools_[i];
+        }
+    }
+    auto pool = std::make_unique<Pool>();
+    pool->memory_type = memory_type;
+    pool->allocate_flags = allocate_flags;
+    pool->kind = kind;
+    pools_.push_back(std::move(pool));
+    *out_pool_index = static_cast<uint32_t>(pools_.size() - 1);
+    return *pools_.back();
+}
+
+Allocation MemoryAllocator::allocateDedicated(
+    uint32_t memory_type,
+    const AllocationRequest& request) {
+    Allocation out;
+    uint64_t handle = 0;
+    void* mapped = nullptr;
+    const bool map = isHostVisible(memory_type);
+    if (!backend_.allocate_block(memory_type, request.size, request.allocate_flags,
+                                 map, &handle, &mapped) || handle == 0) {
+        return out;
+    }
+    out.block_handle = handle;
+    out.offset = 0;
+    out.size = request.size;
+    out.mapped = mapped;
+    out.memory_type = memory_type;
+    out.dedicated = true;
+
+    auto& c = heap_counters_[memory_types_.types[memory_type].heap_index];
+    c.block_bytes += request.size;
+    c.allocation_bytes += request.size;
+    ++c.block_count;
+    ++c.allocation_count;
+    ++c.dedicated_count;
+    return out;
+}
+
+bool MemoryAllocator::allocateFromPool(
+    Pool& pool,
+    uint32_t pool_index,
+    const AllocationRequest& request,
+    bool allow_new_block,
+    Allocation& out) {
+    auto& c = heap_counters_[memory_types_.types[pool.memory_type].heap_index];
+
+    auto try_block = [&](uint32_t b) {
+        Block& block = pool.blocks[b];
+        uint64_t offset = 0;
+        const uint32_t node = block.metadata->allocate(
+            request.size, request.alignment, request.user_data, &offset);
+        if (node == TlsfBlockMetadata::kInvalidNode) {
+            return false;
+        }
+        out.block_handle = block.handle;
+        out.offset = offset;
+        out.size = request.size;
+        out.mapped = block.mapped ? static_cast<uint8_t*>(block.mapped) + offset : nullptr;
+        out.memory_type = pool.memory_type;
+        out.pool = pool_index;
+        out.block = b;
+        out.node = node;
+        out.dedicated = false;
+        c.allocation_bytes += request.size;
+        ++c.allocation_count;
+        return true;
+    };
+
+    // Fullest-first would pack tighter, but address order is stable and
+    // keeps recently-freed low blocks hot; TLSF already keeps each block
+    // compact, so this is a fine trade for an O(blocks) scan.
+    for (uint32_t b = 0; b < pool.blocks.size(); ++b) {
+        if (pool.blocks[b].handle == 0 || b == pool.draining_block) {
+            continue;
+        }
+        if (try_block(b)) {
+            return true;
+        }
+    }
+    if (!allow_new_block) {
+        return false;
+    }
+
+    // New block.  Halve on failure (fragmented / nearly-full heap) but
+    // never below what this request needs.
+    const uint64_t need = request.size + request.alignment;
+    uint64_t block_size = std::max(blockSizeFor(pool.memory_type), need);
+    const bool map = isHostVisible(pool.memory_type);
+    for (;;) {
+        uint64_t handle = 0;
+        void* mapped = nullptr;
+        if (backend_.allocate_block(pool.memory_type, block_size, pool.allocate_flags,
+                                    map, &handle, &mapped) && handle != 0) {
+            uint32_t slot = kInvalidIndex;
+            for (uint32_t b = 0; b < pool.blocks.size(); ++b) {
+                if (pool.blocks[b].handle == 0) {
+                    slot = b;
+                    break;
+                }
+            }
+            if (slot == kInvalidIndex) {
+                pool.blocks.emplace_back();
+                slot = static_cast<uint32_t>(pool.blocks.size() - 1);
+            }
+            Block& block = pool.blocks[slot];
+            block.handle = handle;
+            block.mapped = mapped;
+            block.metadata = std::make_unique<TlsfBlockMetadata>(block_size);
+            c.block_bytes += block_size;
+            ++c.block_count;
+            return try_block(slot);
+        }
+        if (block_size / 2 < need) {
+            return false;
+        }
+        block_size /= 2;
+    }
+}
+
+Allocation MemoryAllocator::allocate(const AllocationRequest& request) {
+    if (request.size == 0) {
+        return Allocation{};
+    }
+    const uint32_t memory_type =
+        findMemoryType(request.memory_type_bits, request.required_flags);
+    if (memory_type == kInvalidIndex) {
+        return Allocation{};
+    }
+
+    const uint64_t threshold = config_.dedicated_threshold
+        ? config_.dedicated_threshold
+        : blockSizeFor(memory_type) / 2;
+    if (request.dedicated || request.size >= threshold) {
+        return allocateDedicated(memory_type, request);
+    }
+
+    uint32_t pool_index = 0;
+    Pool& pool = poolFor(memory_type, request.allocate_flags, request.kind, &pool_index);
+    Allocation out;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (allocateFromPool(pool, pool_index, request, true, out)) {
+            return out;
+        }
+    }
+    // Could not grow the pool (heap nearly full): an exact-size private
+    // allocation may still fit where a whole new block does not.
+    return allocateDedicated(memory_type, request);
+}
+
+void MemoryAllocator::free(const Allocation& allocation) {
+    if (!allocation.valid()) {
+        return;
+    }
+    auto& c = heap_counters_[memory_types_.types[allocation.memory_type].heap_index];
+    if (allocation.dedicated) {
+        backend_.free_block(allocation.memory_type, allocation.block_handle,
+                            allocation.mapped != nullptr);
+        c.block_bytes -= allocation.size;
+        c.allocation_bytes -= allocation.size;
+        --c.block_count;
+        --c.allocation_count;
+        --c.dedicated_count;
+        return;
+    }
+
+    Pool* pool = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pools_mutex_);
+        assert(allocation.pool < pools_.size());
+        pool = pools_[allocation.pool].get();
+    }
+    std::lock_guard<std::mutex> lock(pool->mutex);
+    Block& block = pool->blocks[allocation.block];
+    assert(block.handle == allocation.block_handle);
+    block.metadata->free(allocation.node);
+    c.allocation_bytes -= allocation.size;
+    --c.allocation_count;
+    if (block.metadata->empty() && allocation.block != pool->draining_block) {
+        trimEmptyBlocksLocked(*pool, config_.empty_blocks_to_keep);
+    }
+}
+
+void MemoryAllocator::trimEmptyBlocksLocked(Pool& pool, uint32_t keep) {
+    auto& c = heap_counters_[memory_types_.types[pool.memory_type].heap_index];
+    uint32_t kept = 0;
+    for (uint32_t b = 0; b < pool.blocks.size(); ++b) {
+        Block& block = pool.blocks[b];
+        if (block.handle == 0 || !block.metadata->empty() || b == pool.draining_block) {
+            continue;
+        }
+        if (kept < keep) {
+            ++kept;
+            continue;
+        }
+        backend_.free_block(pool.memory_type, block.handle, block.mapped != nullptr);
+        c.block_bytes -= block.metadata->size();
+        --c.block_count;
+        block = Block{};
+    }
+}
+
+uint32_t MemoryAllocator::releaseEmptyBlocks() {
+    std::vector<Pool*> pools;
+    {
+        std::lock_guard<std::mutex> lock(pools_mutex_);
+        for (auto& p : pools_) pools.push_back(p.get());
+    }
+    uint32_t released = 0;
+    for (Pool* pool : pools) {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        uint32_t before = 0, after = 0;
+        for (auto& b : pool->blocks) before += b.handle != 0;
+        trimEmptyBlocksLocked(*pool, 0);
+        for (auto& b : pool->blocks) after += b.handle != 0;
+        released += before - after;
+    }
+    return released;
+}
+
+void MemoryAllocator::setHeapBudget(uint32_t heap_index, uint64_t budget) {
+    if (heap_index < memory_types_.heaps.size()) {
+        heap_counters_[heap_index].budget.store(budget);
+    }
+}
+
+MemoryAllocatorStats MemoryAllocator::getStats() const {
+    MemoryAllocatorStats stats;
+    stats.heaps.resize(memory_types_.heaps.size());
+    for (size_t i = 0; i < memory_types_.heaps.size(); ++i) {
+        const auto& c = heap_counters_[i];
+        auto& h = stats.heaps[i];
+        h.heap_size = memory_types_.heaps[i].size;
+        h.budget = c.budget.load();
+        h.block_bytes = c.block_bytes.load();
+        h.allocation_bytes = c.allocation_bytes.load();
+        h.block_count = c.block_count.load();
+        h.allocation_count = c.allocation_count.load();
+        h.dedicated_count = c.dedicated_count.load();
+        stats.total_block_count += h.block_count;
+        stats.total_allocation_count += h.allocation_count;
+    }
+    std::lock_guard<std::mutex> lock(pools_mutex_);
+    stats.pool_count = static_cast<uint32_t>(pools_.size());
+    return stats;
+}
+
+std::vector<DefragmentationMove> MemoryAllocator::beginDefragmentation(
+    uint64_t max_bytes) {
+    std::vector<DefragmentationMove> moves;
+    std::vector<std::pair<Pool*, uint32_t>> pools;
+    {
+        std::lock_guard<std::mutex> lock(pools_mutex_);
+        for (uint32_t i = 0; i < pools_.size(); ++i) {
+            pools.emplace_back(pools_[i].get(), i);
+        }
+    }
+
+    uint64_t budget_left = max_bytes;
+    for (auto& [pool, pool_index] : pools) {
+        if (budget_left == 0) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->draining_block != kInvalidIndex) {
+            continue;   // previous pass not ended yet
+        }
+        uint32_t live = 0;
+        uint32_t source = kInvalidIndex;
+        for (uint32_t b = 0; b < pool->blocks.size(); ++b) {
+            const Block& block = pool->blocks[b];
+            if (block.handle == 0) {
+                continue;
+            }
+            ++live;
+            if (block.metadata->empty()) {
+                continue;
+            }
+            if (source == kInvalidIndex ||
+                block.metadata->usedBytes() <
+                    pool->blocks[source].metadata->usedBytes()) {
+                source = b;
+            }
+        }
+        if (live < 2 || source == kInvalidIndex) {
+            continue;
+        }
+
+        struct Live { uint32_t node; uint64_t offset, size; void* user; };
+        std::vector<Live> items;
+        pool->blocks[source].metadata->forEachAllocation(
+            [&](uint32_t node, uint64_t offset, uint64_t size, void* user) {
+                items.push_back({ node, offset, size, user });
+            });
+
+        pool->draining_block = source;
+        const size_t first_move = moves.size();
+        for (const Live& item : items) {
+            if (item.size > budget_left) {
+                break;
+            }
+            // The original alignment is not stored; the largest power of
+            // two dividing the source offset (capped at 64 KiB, the
+            // largest alignment drivers report for sparse-less resources)
+            // is always a valid alignment for it.
+            const uint64_t alignment = item.offset
+                ? std::min<uint64_t>(item.offset & (~item.offset + 1), 65536)
+                : 65536;
+            AllocationRequest req;
+            req.size = item.size;
+            req.alignment = alignment;
+            req.kind = pool->kind;
+            req.allocate_flags = pool->allocate_flags;
+            req.user_data = item.user;
+            Allocation dst;
+            if (!allocateFromPool(*pool, pool_index, req, false, dst)) {
+                continue;
+            }
+            const Block& src_block = pool->blocks[source];
+            DefragmentationMove move;
+            move.src.block_handle = src_block.handle;
+            move.src.offset = item.offset;
+            move.src.size = item.size;
+            move.src.mapped = src_block.mapped
+                ? static_cast<uint8_t*>(src_block.mapped) + item.offset : nullptr;
+            move.src.memory_type = pool->memory_type;
+            move.src.pool = pool_index;
+            move.src.block = source;
+            move.src.node = item.node;
+            move.dst = dst;
+            move.user_data = item.user;
+            moves.push_back(move);
+            budget_left -= item.size;
+        }
+        if (moves.size() == first_move) {
+            pool->draining_block = kInvalidIndex;
+        }
+    }
+    return moves;
+}
+
+void MemoryAllocator::endDefragmentation(
+    const std::vector<DefragmentationMove>& moves) {
+    for (const auto& move : moves) {
+        free(move.src);
+    }
+    std::lock_guard<std::mutex> lock(pools_mutex_);
+    for (auto& pool : pools_) {
+        std::lock_guard<std::mutex> pool_lock(pool->mutex);
+        if (pool->draining_block != kInvalidIndex) {
+            pool->draining_block = kInvalidIndex;
+            trimEmptyBlocksLocked(*pool, config_.empty_blocks_to_keep);
+        }
+    }
+}
+
+} // namespace renderer
+} // namespace engine
@@ -0,0 +1,314 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// memory_allocator.h — pooled device-memory sub-allocator (TLSF placement).
+//
+// Every buffer and image used to get its own vkAllocateMemory.  With ~4k
+// unique .rwtex plus thousands of drawable / collision-debug buffers that
+// sits right under maxMemoryAllocationCount (4096 on most desktop drivers),
+// and each allocation is a kernel round-trip that stalls the loader thread.
+//
+// MemoryAllocator carves resources out of large per-memory-type BLOCKS:
+//   - one pool per (memory type, allocate flags, buffer|image) — buffers and
+//     optimal-tiling images never share a block, so bufferImageGranularity
+//     can be ignored entirely;
+//   - placement inside a block is TLSF (two-level segregated fit): O(1)
+//     allocate and free, immediate coalescing of neighbours;
+//   - requests at or above `dedicated_threshold` (or flagged `dedicated`)
+//     bypass the pools and get their own block, exactly like before;
+//   - host-visible blocks are mapped ONCE when created, so sub-allocations
+//     never call vkMapMemory (which may not be nested on one VkDeviceMemory).
+//
+// The core is renderer-agnostic: raw blocks come from a MemoryBlockBackend
+// (two std::function hooks), and memory types are a plain table.  The Vulkan
+// device plugs vkAllocateMemory / vkFreeMemory in; the unit tests plug in a
+// fake memory-type table and malloc.  No Vulkan headers are included here.
+//
+// Thread-safety: allocate / free / stats may be called from any thread (the
+// async mesh loader allocates concurrently with the render thread).  Each
+// pool has its own mutex, so loaders hitting different memory types do not
+// serialise; heap byte counters are atomics.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "renderer_definition.h"
+
+namespace engine {
+namespace renderer {
+
+// ── TLSF metadata for one block ──────────────────────────────────────────────
+// Pure offset bookkeeping: knows nothing about the memory it describes.
+// Physical neighbours are a doubly-linked list (for coalescing); free ranges
+// additionally sit in a segregated free list indexed by (first, second) level
+// size class.  Node ids are stable for the lifetime of an allocation and are
+// what Allocation::node carries back into free().
+class TlsfBlockMetadata {
+public:
+    static constexpr uint32_t kInvalidNode = 0xffffffffu;
+
+    explicit TlsfBlockMetadata(uint64_t size);
+
+    // Returns the node id of the new allocation (or kInvalidNode when no
+    // free range can hold `size` bytes at `alignment`).
+    uint32_t allocate(
+        uint64_t size,
+        uint64_t alignment,
+        void* user_data,
+        uint64_t* out_offset);
+    void free(uint32_t node);
+
+    uint64_t size() const { return size_; }
+    uint64_t usedBytes() const { return used_bytes_; }
+    uint32_t allocationCount() const { return allocation_count_; }
+    bool empty() const { return allocation_count_ == 0; }
+    uint64_t largestFreeRange() const;
+
+    // Visit every live allocation in address order:
+    //   fn(node, offset, size, user_data)
+    void forEachAllocation(
+        const std::function<void(uint32_t, uint64_t, uint64_t, void*)>& fn) const;
+
+    // Structural self-check (neighbour links, free-list membership, size
+    // sums).  Used by the unit tests; cheap enough for debug builds too.
+    bool validate() const;
+
+private:
+    static constexpr uint32_t kSlBits = 5;
+    static constexpr uint32_t kSlCount = 1u << kSlBits;
+    // Sizes below kSmallLimit share first level 0, split linearly.
+    static constexpr uint32_t kSmallShift = 8;
+    static constexpr uint64_t kSmallLimit = 1ull << kSmallShift;
+    static constexpr uint32_t kFlCount = 64 - kSmallShift + 1;
+
+    struct Node {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t prev_phys = kInvalidNode;
+        uint32_t next_phys = kInvalidNode;
+        uint32_t prev_free = kInvalidNode;
+        uint32_t next_free = kInvalidNode;
+        void*    user_data = nullptr;
+        bool     is_free = false;
+    };
+
+    static void mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+    uint32_t findFree(uint64_t size) const;
+    uint32_t findFreeExact(uint64_t size, uint64_t alignment) const;
+    uint32_t newNode();
+    void releaseNode(uint32_t id);
+    void insertFree(uint32_t id);
+    void removeFree(uint32_t id);
+
+    uint64_t size_ = 0;
+    uint64_t used_bytes_ = 0;
+    uint32_t allocation_count_ = 0;
+    uint64_t fl_bitmap_ = 0;
+    std::array<uint32_t, kFlCount> sl_bitmap_{};
+    std::array<std::array<uint32_t, kSlCount>, kFlCount> heads_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> recycled_nodes_;
+    uint32_t first_node_ = kInvalidNode;
+};
+
+// ── Memory-type table ────────────────────────────────────────────────────────
+// Mirrors VkPhysicalDeviceMemoryProperties closely enough that the device can
+// fill it with a straight copy, and a test can hand-write one.
+struct MemoryTypeDesc {
+    MemoryPropertyFlags property_flags = 0;
+    uint32_t            heap_index = 0;
+};
+
+struct MemoryHeapDesc {
+    uint64_t size = 0;
+    // VK_EXT_memory_budget value when available; 0 = use 80% of `size`.
+    uint64_t budget = 0;
+};
+
+struct MemoryTypeTable {
+    std::vector<MemoryTypeDesc> types;
+    std::vector<MemoryHeapDesc> heaps;
+};
+
+enum class AllocationKind : uint8_t {
+    kBuffer = 0,
+    kImage  = 1,
+};
+
+struct AllocationRequest {
+    uint64_t            size = 0;
+    uint64_t            alignment = 1;
+    uint32_t            memory_type_bits = 0xffffffffu;
+    MemoryPropertyFlags required_flags = 0;
+    MemoryAllocateFlags allocate_flags = 0;
+    AllocationKind      kind = AllocationKind::kBuffer;
+    // Force a private block (swapchain-sized render targets, huge merged
+    // cluster buffers).  Large requests are promoted automatically.
+    bool                dedicated = false;
+    // Opaque back-pointer reported in defragmentation moves so the owner
+    // can find the resource bound to the allocation.
+    void*               user_data = nullptr;
+};
+
+struct Allocation {
+    uint64_t block_handle = 0;   // backend handle (VkDeviceMemory as integer)
+    uint64_t offset = 0;         // byte offset inside the block
+    uint64_t size = 0;
+    void*    mapped = nullptr;   // persistent host pointer at `offset`, or null
+    uint32_t memory_type = 0xffffffffu;
+    uint32_t pool = 0xffffffffu;
+    uint32_t block = 0xffffffffu;
+    uint32_t node = TlsfBlockMetadata::kInvalidNode;
+    bool     dedicated = false;
+
+    bool valid() const { return block_handle != 0; }
+};
+
+// Raw block provider.  allocate_block must return false (not throw) on
+// failure so the allocator can retry with a smaller block size.
+struct MemoryBlockBackend {
+    std::function<bool(uint32_t memory_type,
+                       uint64_t size,
+                       MemoryAllocateFlags allocate_flags,
+                       bool map,
+                       uint64_t* out_handle,
+                       void** out_mapped)> allocate_block;
+    std::function<void(uint32_t memory_type,
+                       uint64_t handle,
+                       bool mapped)> free_block;
+};
+
+struct MemoryAllocatorConfig {
+    // Size of a freshly created pool block.  Clamped to heap_size / 8 so a
+    // small BAR / host heap is not swallowed by one block.
+    uint64_t preferred_block_size = 64ull * 1024 * 1024;
+    // Requests >= this go dedicated.  0 = preferred_block_size / 2.
+    uint64_t dedicated_threshold = 0;
+    // Empty pool blocks kept around per pool to absorb load/unload churn
+    // instead of bouncing through vkFreeMemory / vkAllocateMemory.
+    uint32_t empty_blocks_to_keep = 1;
+};
+
+struct MemoryHeapStats {
+    uint64_t heap_size = 0;
+    uint64_t budget = 0;
+    uint64_t block_bytes = 0;       // bytes held from the driver
+    uint64_t allocation_bytes = 0;  // bytes handed to resources
+    uint32_t block_count = 0;       // device allocations (pool + dedicated)
+    uint32_t allocation_count = 0;
+    uint32_t dedicated_count = 0;
+};
+
+struct MemoryAllocatorStats {
+    std::vector<MemoryHeapStats> heaps;
+    uint32_t total_block_count = 0;
+    uint32_t total_allocation_count = 0;
+    uint32_t pool_count = 0;
+};
+
+// A planned relocation: `src` should be copied into `dst`, the resource that
+// owns `user_data` rebound, and then the pair handed to endDefragmentation().
+struct DefragmentationMove {
+    Allocation src;
+    Allocation dst;
+    void*      user_data = nullptr;
+};
+
+class MemoryAllocator {
+public:
+    MemoryAllocator(
+        const MemoryTypeTable& memory_types,
+        MemoryBlockBackend backend,
+        const MemoryAllocatorConfig& config = MemoryAllocatorConfig());
+    ~MemoryAllocator();
+
+    MemoryAllocator(const MemoryAllocator&) = delete;
+    MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+    // First memory type in `memory_type_bits` carrying all `required_flags`
+    // (same rule as helper::findMemoryType); 0xffffffff when none does.
+    uint32_t findMemoryType(
+        uint32_t memory_type_bits,
+        MemoryPropertyFlags required_flags) const;
+
+    // Returns an invalid Allocation on failure (no suitable memory type, or
+    // the backend refused every block size it was asked for).
+    Allocation allocate(const AllocationRequest& request);
+    void free(const Allocation& allocation);
+
+    // Refresh per-heap budgets (VK_EXT_memory_budget is per-frame data).
+    void setHeapBudget(uint32_t heap_index, uint64_t budget);
+
+    MemoryAllocatorStats getStats() const;
+
+    // ── Defragmentation hooks ────────────────────────────────────────────
+    // Picks the emptiest block of every pool that has more than one and
+    // reserves destinations for its allocations in the other blocks, up to
+    // `max_bytes` in total.  No new blocks are created to satisfy a move.
+    // The caller records the copies, rebinds, and once the GPU is done
+    // calls endDefragmentation(), which frees the sources so the drained
+    // blocks can be released.
+    std::vector<DefragmentationMove> beginDefragmentation(uint64_t max_bytes);
+    void endDefragmentation(const std::vector<DefragmentationMove>& moves);
+
+    // Return every empty pool block to the backend (keeps none).  Call on
+    // level unload or after endDefragmentation.
+    uint32_t releaseEmptyBlocks();
+
+private:
+    struct Block {
+        uint64_t handle = 0;
+        void*    mapped = nullptr;
+        std::unique_ptr<TlsfBlockMetadata> metadata;
+    };
+    struct Pool {
+        mutable std::mutex  mutex;
+        uint32_t            memory_type = 0;
+        MemoryAllocateFlags allocate_flags = 0;
+        AllocationKind      kind = AllocationKind::kBuffer;
+        std::vector<Block>  blocks;   // empty slots have handle == 0
+        // Set while a defragmentation pass drains this block index.
+        uint32_t            draining_block = 0xffffffffu;
+    };
+    struct HeapCounters {
+        std::atomic<uint64_t> block_bytes{0};
+        std::atomic<uint64_t> allocation_bytes{0};
+        std::atomic<uint32_t> block_count{0};
+        std::atomic<uint32_t> allocation_count{0};
+        std::atomic<uint32_t> dedicated_count{0};
+        std::atomic<uint64_t> budget{0};
+    };
+
+    Pool& poolFor(uint32_t memory_type,
+                  MemoryAllocateFlags allocate_flags,
+                  AllocationKind kind,
+                  uint32_t* out_pool_index);
+    Allocation allocateDedicated(uint32_t memory_type,
+                                 const AllocationRequest& request);
+    bool allocateFromPool(Pool& pool,
+                          uint32_t pool_index,
+                          const AllocationRequest& request,
+                          bool allow_new_block,
+                          Allocation& out);
+    bool isHostVisible(uint32_t memory_type) const;
+    uint64_t blockSizeFor(uint32_t memory_type) const;
+    void trimEmptyBlocksLocked(Pool& pool, uint32_t keep);
+
+    MemoryTypeTable        memory_types_;
+    MemoryBlockBackend     backend_;
+    MemoryAllocatorConfig  config_;
+    std::unique_ptr<HeapCounters[]> heap_counters_;
+
+    // Pools are created lazily and never destroyed before the allocator;
+    // pools_mutex_ only guards the vector itself (lookup / growth), each
+    // Pool's own mutex guards its blocks.
+    mutable std::mutex                  pools_mutex_;
+    std::vector<std::unique_ptr<Pool>>  pools_;
+};
+
+} // namespace renderer
+} // namespace engine
@@ -3,8 +3,11 @@
 #include <algorithm>
 #include <cmath>
 #include <array>
+#include <cstring>
 
 #include "renderer.h"
+#include "frame_upload_ring.h"
+#include "upload_scheduler.h"
 #include "vulkan/vk_device.h"
 #include "vulkan/vk_command_buffer.h"
 #include "vulkan/vk_renderer_helper.h"
@@ -325,6 +328,13 @@ void Helper::createBuffer(
 
     if (has_src_data) {
         if (need_stage_buffer) {
+            // Loader thread: stage through the scheduler's ring and let it
+            // batch the copy with everything else this frame.
+            if (auto* uploader = UploadScheduler::current()) {
+                uploader->uploadBuffer(buffer, 0, buffer_size, src_data);
+                return;
+            }
+
             std::shared_ptr<Buffer> staging_buffer;
             std::shared_ptr<DeviceMemory> staging_buffer_memory;
             device->createBuffer(
@@ -357,6 +367,11 @@ void Helper::updateBufferWithSrcData(
     const std::shared_ptr<Buffer>& buffer,
     const std::source_location& src_location) {
 
+    if (auto* uploader = UploadScheduler::current()) {
+        uploader->uploadBuffer(buffer, 0, buffer_size, src_data);
+        return;
+    }
+
     std::shared_ptr<Buffer> staging_buffer;
     std::shared_ptr<DeviceMemory> staging_buffer_memory;
     device->createBuffer(
@@ -454,6 +469,29 @@ void Helper::create2DTextureImage(
         static_cast<VkDeviceSize>(tex_height) *
         static_cast<VkDeviceSize>(bytes_per_pixel);
 
+    const uint32_t mip_levels = 0;
+    if (auto* uploader = UploadScheduler::current()) {
+        vk::helper::createTextureImage(
+            device,
+            glm::vec3(tex_width, tex_height, 1),
+            mip_levels,
+            format,
+            ImageTiling::OPTIMAL,
+            SET_3_FLAG_BITS(ImageUsage, TRANSFER_DST_BIT, TRANSFER_SRC_BIT, SAMPLED_BIT),
+            SET_FLAG_BIT(MemoryProperty, DEVICE_LOCAL_BIT),
+            texture_image,
+            texture_image_memory,
+            src_location);
+        uploader->uploadImage(
+            texture_image,
+            format,
+            static_cast<uint32_t>(tex_width),
+            static_cast<uint32_t>(tex_height),
+            image_size,
+            pixels);
+        return;
+    }
+
     std::shared_ptr<Buffer> staging_buffer;
     std::shared_ptr<DeviceMemory> staging_buffer_memory;
     device->createBuffer(
@@ -471,7 +509,6 @@ void Helper::create2DTextureImage(
         image_size,
         pixels);
 
-    const uint32_t mip_levels = 0;
     vk::helper::createTextureImage(
         device,
         glm::vec3(tex_width, tex_height, 1),
@@ -512,6 +549,215 @@ void Helper::create2DTextureImage(
     device->freeMemory(staging_buffer_memory);
 }
 
+void Helper::update2DTextureRegion(
+    const std::shared_ptr<renderer::Device>& device,
+    const std::shared_ptr<CommandBuffer>& cmd_buf,
+    FrameUploadRing& staging,
+    const std::shared_ptr<Image>& texture_image,
+    Format format,
+    const glm::ivec2& offset,
+    const glm::uvec2& size,
+    uint32_t bytes_per_pixel,
+    const void* pixels) {
+    const VkDeviceSize region_size =
+        static_cast<VkDeviceSize>(size.x) *
+        static_cast<VkDeviceSize>(size.y) *
+        static_cast<VkDeviceSize>(bytes_per_pixel);
+    if (region_size == 0) return;
+
+    std::shared_ptr<Buffer> staging_buffer;
+    uint64_t staging_offset = 0;
+    uint8_t* dst = staging.allocate(
+        device, region_size, kImageStagingAlignment,
+        staging_buffer, staging_offset);
+    std::memcpy(dst, pixels, region_size);
+
+    BufferImageCopyInfo region{};
+    region.buffer_offset = staging_offset;
+    region.buffer_row_length = 0;
+    region.buffer_image_height = 0;
+    region.image_subresource.aspect_mask = SET_FLAG_BIT(ImageAspect, COLOR_BIT);
+    region.image_subresource.mip_level = 0;
+    region.image_subresource.base_array_layer = 0;
+    region.image_subresource.layer_count = 1;
+    region.image_offset = glm::ivec3(offset, 0);
+    region.image_extent = glm::uvec3(size, 1);
+
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        texture_image,
+        format,
+        ImageLayout::SHADER_READ_ONLY_OPTIMAL,
+        ImageLayout::TRANSFER_DST_OPTIMAL);
+
+    cmd_buf->copyBufferToImage(
+        staging_buffer,
+        texture_image,
+        { region },
+        ImageLayout::TRANSFER_DST_OPTIMAL);
+
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        texture_image,
+        format,
+        ImageLayout::TRANSFER_DST_OPTIMAL,
+        ImageLayout::SHADER_READ_ONLY_OPTIMAL);
+}
+
+namespace {
+// One copy region per level of a packed chain starting at `first_mip`.
+std::vector<BufferImageCopyInfo> packedLevelRegions(
+    uint32_t tex_width,
+    uint32_t tex_height,
+    uint32_t first_mip,
+    const std::vector<uint64_t>& level_bytes) {
+    std::vector<BufferImageCopyInfo> regions(level_bytes.size());
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < level_bytes.size(); ++i) {
+        const uint32_t mip = first_mip + i;
+        auto& region = regions[i];
+        region.buffer_offset = offset;
+        region.buffer_row_length = 0;
+        region.buffer_image_height = 0;
+        region.image_subresource.aspect_mask = SET_FLAG_BIT(ImageAspect, COLOR_BIT);
+        region.image_subresource.mip_level = mip;
+        region.image_subresource.base_array_layer = 0;
+        region.image_subresource.layer_count = 1;
+        region.image_offset = glm::ivec3(0, 0, 0);
+        region.image_extent = glm::uvec3(
+            std::max(tex_width >> mip, 1u),
+            std::max(tex_height >> mip, 1u),
+            1);
+        offset += level_bytes[i];
+    }
+    return regions;
+}
+}  // namespace
+
+void Helper::create2DTextureImageFromLevels(
+    const std::shared_ptr<renderer::Device>& device,
+    Format format,
+    uint32_t tex_width,
+    uint32_t tex_height,
+    const std::vector<uint64_t>& level_bytes,
+    const void* pixels,
+    std::shared_ptr<Image>& texture_image,
+    std::shared_ptr<DeviceMemory>& texture_image_memory,
+    const std::source_location& src_location) {
+
+    const uint32_t mip_levels = static_cast<uint32_t>(level_bytes.size());
+    VkDeviceSize image_size = 0;
+    for (uint64_t bytes : level_bytes) image_size += bytes;
+
+    std::shared_ptr<Buffer> staging_buffer;
+    std::shared_ptr<DeviceMemory> staging_buffer_memory;
+    device->createBuffer(
+        image_size,
+        SET_FLAG_BIT(BufferUsage, TRANSFER_SRC_BIT),
+        SET_FLAG_BIT(MemoryProperty, HOST_VISIBLE_BIT) |
+        SET_FLAG_BIT(MemoryProperty, HOST_COHERENT_BIT),
+        0,
+        staging_buffer,
+        staging_buffer_memory,
+        src_location);
+
+    device->updateBufferMemory(
+        staging_buffer_memory,
+        image_size,
+        pixels);
+
+    vk::helper::createTextureImage(
+        device,
+        glm::vec3(tex_width, tex_height, 1),
+        mip_levels,
+        format,
+        ImageTiling::OPTIMAL,
+        SET_3_FLAG_BITS(ImageUsage, TRANSFER_DST_BIT, TRANSFER_SRC_BIT, SAMPLED_BIT),
+        SET_FLAG_BIT(MemoryProperty, DEVICE_LOCAL_BIT),
+        texture_image,
+        texture_image_memory,
+        src_location);
+
+    auto cmd_buf = device->setupTransientCommandBuffer();
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        texture_image,
+        format,
+        ImageLayout::UNDEFINED,
+        ImageLayout::TRANSFER_DST_OPTIMAL,
+        0, mip_levels);
+
+    vk::helper::copyBufferToImageWithMips(
+        cmd_buf,
+        staging_buffer,
+        texture_image,
+        packedLevelRegions(tex_width, tex_height, 0, level_bytes));
+
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        texture_image,
+        format,
+        ImageLayout::TRANSFER_DST_OPTIMAL,
+        ImageLayout::SHADER_READ_ONLY_OPTIMAL,
+        0, mip_levels);
+    device->submitAndWaitTransientCommandBuffer();
+
+    device->destroyBuffer(staging_buffer);
+    device->freeMemory(staging_buffer_memory);
+}
+
+void Helper::update2DTextureMips(
+    const std::shared_ptr<renderer::Device>& device,
+    const std::shared_ptr<CommandBuffer>& cmd_buf,
+    FrameUploadRing& staging,
+    const std::shared_ptr<Image>& texture_image,
+    Format format,
+    uint32_t tex_width,
+    uint32_t tex_height,
+    uint32_t first_mip,
+    const std::vector<uint64_t>& level_bytes,
+    const void* pixels) {
+    const uint32_t mip_count = static_cast<uint32_t>(level_bytes.size());
+    VkDeviceSize total_size = 0;
+    for (uint64_t bytes : level_bytes) total_size += bytes;
+    if (total_size == 0) return;
+
+    std::shared_ptr<Buffer> staging_buffer;
+    uint64_t staging_offset = 0;
+    uint8_t* dst = staging.allocate(
+        device, total_size, kImageStagingAlignment,
+        staging_buffer, staging_offset);
+    std::memcpy(dst, pixels, total_size);
+
+    auto regions =
+        packedLevelRegions(tex_width, tex_height, first_mip, level_bytes);
+    for (auto& region : regions) {
+        region.buffer_offset += staging_offset;
+    }
+
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        texture_image,
+        format,
+        ImageLayout::SHADER_READ_ONLY_OPTIMAL,
+        ImageLayout::TRANSFER_DST_OPTIMAL,
+        first_mip, mip_count);
+
+    vk::helper::copyBufferToImageWithMips(
+        cmd_buf,
+        staging_buffer,
+        texture_image,
+        regions);
+
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        texture_image,
+        format,
+        ImageLayout::TRANSFER_DST_OPTIMAL,
+        ImageLayout::SHADER_READ_ONLY_OPTIMAL,
+        first_mip, mip_count);
+}
+
 void Helper::create2DTextureImageWithMips(
     const std::shared_ptr<renderer::Device>& device,
     Format format,
@@ -766,6 +1012,36 @@ void Helper::create2DTextureImage(
     texture_2d.size = glm::uvec3(size, 1);
 }
 
+bool Helper::queryVramBudget(
+    const std::shared_ptr<renderer::Device>& device,
+    uint64_t& heap_usage,
+    uint64_t& heap_budget) {
+    heap_usage = 0;
+    heap_budget = 0;
+    const auto& vk_device = RENDER_TYPE_CAST(Device, device);
+    const auto& vk_physical_device =
+        RENDER_TYPE_CAST(PhysicalDevice, vk_device->getPhysicalDevice());
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+    budget.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2 mp{};
+    mp.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    mp.pNext = &budget;
+    vkGetPhysicalDeviceMemoryProperties2(vk_physical_device->get(), &mp);
+
+    const VkPhysicalDeviceMemoryProperties& props = mp.memoryProperties;
+    for (uint32_t i = 0; i < props.memoryHeapCount; ++i) {
+        if (!(props.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+            continue;
+        // Zero when VK_EXT_memory_budget was not enabled.
+        heap_usage += budget.heapUsage[i];
+        heap_budget += budget.heapBudget[i];
+    }
+    if (heap_budget == 0) heap_usage = 0;
+    return heap_budget != 0;
+}
+
 void Helper::dumpTextureImage(
     const std::shared_ptr<renderer::Device>& device,
     const std::shared_ptr<Image>& src_texture_image,
@@ -989,10 +1265,11 @@ void Helper::createCubemapTexture(
 
     auto mem_requirements = device->getImageMemoryRequirements(texture.image);
     texture.memory = device->allocateMemory(
-        mem_requirements.size,
-        mem_requirements.memory_type_bits,
+        mem_requirements,
         vk::helper::toVkMemoryPropertyFlags(SET_FLAG_BIT(MemoryProperty, DEVICE_LOCAL_BIT)),
-        0);
+        0,
+        true,
+        src_location);
     device->bindImageMemory(texture.image, texture.memory);
 
     if (data) {
@@ -1377,8 +1654,10 @@ void Helper::submitQueue(
     submit_info.pCommandBuffers = vk_cmd_bufs.data();
     submit_info.signalSemaphoreCount = static_cast<uint32_t>(vk_signal_semaphores.size());
     submit_info.pSignalSemaphores = vk_signal_semaphores.data();
+    // Declared outside the if: submit_info.pNext points at it until
+    // vkQueueSubmit returns.
+    VkTimelineSemaphoreSubmitInfo timeline_info = {};
     if (signal_semaphore_values.size() > 0) {
-        VkTimelineSemaphoreSubmitInfo timeline_info = {};
         timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
         timeline_info.signalSemaphoreValueCount = static_cast<uint32_t>(signal_semaphore_values.size());
         timeline_info.pSignalSemaphoreValues = signal_semaphore_values.data();
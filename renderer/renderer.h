@@ -15,6 +15,7 @@
 
 #include "device.h"
 #include "command_buffer.h"
+#include "memory_allocator.h"
 
 namespace engine {
 namespace renderer {
@@ -331,9 +332,17 @@ public:
 
 class VulkanDeviceMemory : public DeviceMemory {
     VkDeviceMemory  memory_;
+    // Set when the memory came from the pooled sub-allocator: memory_ is
+    // then the SHARED block, and every bind / map has to add
+    // allocation_.offset.  Invalid for the legacy one-allocation path.
+    Allocation      allocation_;
 public:
     VkDeviceMemory get() { return memory_; }
     void set(const VkDeviceMemory& memory) { memory_ = memory; }
+    void setAllocation(const Allocation& allocation) { allocation_ = allocation; }
+    const Allocation& getAllocation() const { return allocation_; }
+    bool isSubAllocated() const { return allocation_.valid(); }
+    uint64_t getOffset() const { return allocation_.offset; }
 };
 
 class VulkanDescriptorSetLayout : public DescriptorSetLayout {
@@ -502,6 +511,59 @@ public:
         std::shared_ptr<DeviceMemory>& texture_image_memory,
         const std::source_location& src_location);
 
+    // Mip-chain variant with explicit level sizes: `pixels` holds
+    // level_bytes.size() levels packed back to back, mip 0 first, and
+    // each is copied with its own region.  Unlike the overload above it
+    // does not assume 4x4 blocks of 8 / 16 bytes, so texel formats and
+    // every BC format work (the .ktx2 path, helper/ktx2.h).
+    static void create2DTextureImageFromLevels(
+        const std::shared_ptr<renderer::Device>& device,
+        Format format,
+        uint32_t tex_width,
+        uint32_t tex_height,
+        const std::vector<uint64_t>& level_bytes,
+        const void* pixels,
+        std::shared_ptr<Image>& texture_image,
+        std::shared_ptr<DeviceMemory>& texture_image_memory,
+        const std::source_location& src_location);
+
+    // Overwrite mips [first_mip, first_mip + level_bytes.size()) of an
+    // existing sampled image with `pixels` packed as above.  Same
+    // contract as update2DTextureRegion: SHADER_READ_ONLY_OPTIMAL in and
+    // out, recorded into the frame's command buffer and staged through
+    // `staging` — used to replace a streamed texture's placeholder mips
+    // once the real ones are read.
+    static void update2DTextureMips(
+        const std::shared_ptr<renderer::Device>& device,
+        const std::shared_ptr<CommandBuffer>& cmd_buf,
+        FrameUploadRing& staging,
+        const std::shared_ptr<Image>& texture_image,
+        Format format,
+        uint32_t tex_width,
+        uint32_t tex_height,
+        uint32_t first_mip,
+        const std::vector<uint64_t>& level_bytes,
+        const void* pixels);
+
+    // Overwrite a width x height rectangle at `offset` (mip 0) of an
+    // existing sampled image with tightly-packed `pixels`.  The image must
+    // be in SHADER_READ_ONLY_OPTIMAL and is left there.  Recorded into
+    // `cmd_buf` — the frame's graphics command buffer, outside a render
+    // pass — so the barriers order the copy after the reads of earlier
+    // frames on the same queue and before this frame's; `pixels` is copied
+    // into `staging` right away.  For small updates such as a thumbnail
+    // landing in an atlas page.
+    static void update2DTextureRegion(
+        const std::shared_ptr<renderer::Device>& device,
+        const std::shared_ptr<CommandBuffer>& cmd_buf,
+        FrameUploadRing& staging,
+        const std::shared_ptr<Image>& texture_image,
+        Format format,
+        const glm::ivec2& offset,
+        const glm::uvec2& size,
+        uint32_t bytes_per_pixel,
+        const void* pixels);
+
     static void create2DTextureImage(
         const std::shared_ptr<renderer::Device>& device,
         Format depth_format,
@@ -514,6 +576,14 @@ public:
         const renderer::ImageTiling image_tiling = renderer::ImageTiling::OPTIMAL,
         const uint32_t memory_property = SET_FLAG_BIT(MemoryProperty, DEVICE_LOCAL_BIT));
 
+    // Device-local heaps summed, from VK_EXT_memory_budget: what this
+    // process uses and what the driver budgets for it.  False (outputs
+    // zero) when the extension was not enabled.
+    static bool queryVramBudget(
+        const std::shared_ptr<renderer::Device>& device,
+        uint64_t& heap_usage,
+        uint64_t& heap_budget);
+
     static void dumpTextureImage(
         const std::shared_ptr<renderer::Device>& device,
         const std::shared_ptr<Image>& src_texture_image,
@@ -50,6 +50,7 @@ class Queue;
 class Semaphore;
 class Fence;
 class QueryPool;
+class FrameUploadRing;
 struct ImageResourceInfo;
 
 struct MemoryRequirements {
@@ -453,7 +454,8 @@ struct TextureInfo {
     bool                               linear = true;
     // True when this TextureInfo's GPU handles are OWNED by the shared texture
     // cache (engine_helper) and merely borrowed here. DrawableData::destroy must
-    // NOT free a borrowed texture — the cache frees it once at shutdown. Set by
+    // NOT free a borrowed texture — the cache frees it (at shutdown, or once
+    // nothing borrows it and the VRAM budget is tight). Set by
     // createTextureImage(..., cacheable=true) on a cache hit/insert.
     bool                               borrowed_ = false;
     glm::uvec3                         size = glm::uvec3(0);
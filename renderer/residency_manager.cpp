@@ -0,0 +1,358 @@
+#include "residency_manager.h"
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+namespace engine {
+namespace renderer {
+
+namespace {
+inline uint64_t scaledBytes(uint64_t bytes, float scale) {
+    const double v = static_cast<double>(bytes) * static_cast<double>(scale);
+    return v >= static_cast<double>(kUnlimitedResidencyBudget)
+               ? kUnlimitedResidencyBudget
+               : static_cast<uint64_t>(v);
+}
+} // namespace
+
+ResidencyManager::ResidencyManager(const ResidencyConfig& config)
+    : config_(config) {
+    assert(config_.low_water <= config_.high_water);
+}
+
+ResidencyHandle ResidencyManager::add(
+    const ResidencyResourceDesc& desc, uint64_t frame) {
+    assert(!desc.level_bytes.empty());
+    ResidencyHandle handle;
+    if (!free_handles_.empty()) {
+        handle = free_handles_.back();
+        free_handles_.pop_back();
+    } else {
+        handle = static_cast<ResidencyHandle>(resources_.size());
+        resources_.emplace_back();
+    }
+
+    Resource& r = resources_[handle];
+    const uint32_t n = static_cast<uint32_t>(desc.level_bytes.size());
+    r = Resource{};
+    r.live = true;
+    r.kind = desc.kind;
+    r.level_count = n;
+    r.floor_level = n - std::clamp(desc.tail_levels, 1u, n);
+    r.width = desc.width;
+    r.suffix.assign(n + 1, 0);
+    for (uint32_t l = n; l-- > 0;)
+        r.suffix[l] = r.suffix[l + 1] + desc.level_bytes[l];
+    // Never resident below the tail: a partial tail is not a state the
+    // owner can be asked to produce.
+    r.first = desc.first_resident >= n ? n
+                                       : std::min(desc.first_resident,
+                                                  r.floor_level);
+    r.first_before = r.first;
+    r.last_used = frame;
+    resident_bytes_ += r.suffix[r.first];
+    ++live_count_;
+    return handle;
+}
+
+void ResidencyManager::remove(ResidencyHandle handle) {
+    if (!valid(handle)) return;
+    Resource& r = resources_[handle];
+    resident_bytes_ -= r.suffix[r.first];
+    r = Resource{};
+    free_handles_.push_back(handle);
+    --live_count_;
+}
+
+void ResidencyManager::markUsed(
+    ResidencyHandle handle, uint64_t frame, float screen_px) {
+    if (!valid(handle)) return;
+    Resource& r = resources_[handle];
+
+    // Coarsest level still at least as wide as the resource is on screen.
+    uint32_t level = 0;
+    if (screen_px > 0.0f && r.width != 0) {
+        while (level < r.floor_level &&
+               static_cast<float>(r.width >> (level + 1)) >= screen_px)
+            ++level;
+    }
+    if (r.last_used != frame) {
+        r.wanted = level;
+        r.screen_px = screen_px;
+    } else {
+        r.wanted = std::min(r.wanted, level);
+        r.screen_px = (r.screen_px == 0.0f || screen_px == 0.0f)
+                          ? 0.0f
+                          : std::max(r.screen_px, screen_px);
+    }
+    r.last_used = std::max(r.last_used, frame);
+}
+
+void ResidencyManager::setPinned(ResidencyHandle handle, bool pinned) {
+    if (valid(handle)) resources_[handle].pinned = pinned;
+}
+
+bool ResidencyManager::valid(ResidencyHandle handle) const {
+    return handle < resources_.size() && resources_[handle].live;
+}
+
+uint32_t ResidencyManager::firstResident(ResidencyHandle handle) const {
+    return valid(handle) ? resources_[handle].first : 0;
+}
+
+uint32_t ResidencyManager::wantedLevel(ResidencyHandle handle) const {
+    return valid(handle) ? resources_[handle].wanted : 0;
+}
+
+uint32_t ResidencyManager::levelCount(ResidencyHandle handle) const {
+    return valid(handle) ? resources_[handle].level_count : 0;
+}
+
+bool ResidencyManager::isResident(ResidencyHandle handle) const {
+    return valid(handle) &&
+           resources_[handle].first < resources_[handle].level_count;
+}
+
+uint64_t ResidencyManager::idleFrames(const Resource& r, uint64_t frame) const {
+    return frame > r.last_used ? frame - r.last_used : 0;
+}
+
+// On-screen width of what is drawn; resources without one count as their
+// full width, so "unknown" is never cheaper than a measured size.
+float ResidencyManager::importance(const Resource& r) const {
+    if (r.screen_px > 0.0f) return r.screen_px;
+    return r.width != 0 ? static_cast<float>(r.width) : 1.0f;
+}
+
+void ResidencyManager::setFirst(Resource& r, uint32_t first) {
+    resident_bytes_ -= r.suffix[r.first];
+    resident_bytes_ += r.suffix[first];
+    r.first = first;
+}
+
+void ResidencyManager::shed(uint64_t frame, uint64_t target) {
+    auto over = [&] { return resident_bytes_ > target; };
+    // Live, unpinned, resident resources matching `pred`, least recently
+    // used first.
+    auto collectLru = [&](auto pred) {
+        scratch_.clear();
+        for (uint32_t i = 0; i < resources_.size(); ++i) {
+            const Resource& r = resources_[i];
+            if (r.live && !r.pinned && r.first < r.level_count && pred(r))
+                scratch_.push_back(i);
+        }
+        std::stable_sort(scratch_.begin(), scratch_.end(),
+                         [&](uint32_t a, uint32_t b) {
+                             return resources_[a].last_used <
+                                    resources_[b].last_used;
+                         });
+    };
+
+    // 1. Long unused: nobody is going to miss it.
+    collectLru([&](const Resource& r) {
+        return idleFrames(r, frame) >= config_.evict_after_frames;
+    });
+    for (uint32_t i : scratch_) {
+        if (!over()) return;
+        setFirst(resources_[i], resources_[i].level_count);
+    }
+
+    // 2. Levels finer than the screen size needs: invisible to drop.
+    collectLru([&](const Resource& r) { return r.first < r.wanted; });
+    for (uint32_t i : scratch_) {
+        if (!over()) return;
+        setFirst(resources_[i], resources_[i].wanted);
+    }
+
+    // 3. + 4. Off screen for a while: mips first, then the whole resource.
+    collectLru([&](const Resource& r) {
+        return idleFrames(r, frame) >= config_.idle_frames &&
+               r.first < r.floor_level;
+    });
+    for (uint32_t i : scratch_) {
+        if (!over()) return;
+        setFirst(resources_[i], resources_[i].floor_level);
+    }
+    collectLru([&](const Resource& r) {
+        return idleFrames(r, frame) >= config_.idle_frames;
+    });
+    for (uint32_t i : scratch_) {
+        if (!over()) return;
+        setFirst(resources_[i], resources_[i].level_count);
+    }
+
+    // 5. Everything left is in view.  Degrade one level at a time, always
+    // where it costs least: each level already given up doubles the cost
+    // of the next, so the loss spreads evenly instead of one texture
+    // dropping to its tail.  Nothing visible is ever evicted.
+    struct Candidate {
+        float    cost;
+        uint64_t last_used;
+        uint32_t index;
+    };
+    auto worse = [](const Candidate& a, const Candidate& b) {
+        if (a.cost != b.cost) return a.cost > b.cost;
+        if (a.last_used != b.last_used) return a.last_used > b.last_used;
+        return a.index > b.index;
+    };
+    auto costOf = [&](const Resource& r) {
+        const uint32_t given_up = r.first > r.wanted ? r.first - r.wanted : 0;
+        return importance(r) * static_cast<float>(1u << std::min(given_up, 24u));
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(worse)>
+        queue(worse);
+    for (uint32_t i = 0; i < resources_.size(); ++i) {
+        const Resource& r = resources_[i];
+        if (r.live && !r.pinned && r.first < r.floor_level)
+            queue.push({costOf(r), r.last_used, i});
+    }
+    while (over() && !queue.empty()) {
+        const Candidate c = queue.top();
+        queue.pop();
+        Resource& r = resources_[c.index];
+        setFirst(r, r.first + 1);
+        if (r.first < r.floor_level)
+            queue.push({costOf(r), r.last_used, c.index});
+    }
+}
+
+void ResidencyManager::restore(uint64_t frame, uint64_t target) {
+    if (resident_bytes_ >= target) return;
+
+    scratch_.clear();
+    for (uint32_t i = 0; i < resources_.size(); ++i) {
+        const Resource& r = resources_[i];
+        if (r.live && r.first < r.level_count && r.first > r.wanted &&
+            idleFrames(r, frame) < config_.idle_frames)
+            scratch_.push_back(i);
+    }
+    std::stable_sort(scratch_.begin(), scratch_.end(),
+                     [&](uint32_t a, uint32_t b) {
+                         const float ia = importance(resources_[a]);
+                         const float ib = importance(resources_[b]);
+                         if (ia != ib) return ia > ib;
+                         return resources_[a].last_used >
+                                resources_[b].last_used;
+                     });
+
+    // One level per resource per round, the mirror image of the even
+    // degradation in shed(): everyone gets a level back before anyone
+    // gets two.  A single level larger than the per-frame cap still goes
+    // through when it is the only restore of the frame, or it never would.
+    uint64_t restored = 0;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (uint32_t i : scratch_) {
+            Resource& r = resources_[i];
+            if (r.first <= r.wanted) continue;
+            const uint64_t level =
+                r.suffix[r.first - 1] - r.suffix[r.first];
+            if (resident_bytes_ + level > target) continue;
+            if (restored != 0 &&
+                restored + level > config_.max_restore_bytes_per_frame)
+                continue;
+            setFirst(r, r.first - 1);
+            restored += level;
+            progress = true;
+        }
+        if (restored >= config_.max_restore_bytes_per_frame) break;
+    }
+}
+
+void ResidencyManager::update(
+    uint64_t frame, std::vector<ResidencyAction>& actions) {
+    actions.clear();
+    for (Resource& r : resources_)
+        r.first_before = r.first;
+
+    // Restore on demand: an evicted resource that is being drawn gets its
+    // tail back now, budget or not.  The rest follows through restore().
+    for (Resource& r : resources_) {
+        if (r.live && r.first == r.level_count && idleFrames(r, frame) <= 1)
+            setFirst(r, r.floor_level);
+    }
+
+    over_budget_ = false;
+    if (config_.budget_bytes == kUnlimitedResidencyBudget) {
+        restore(frame, kUnlimitedResidencyBudget);
+    } else {
+        const uint64_t high = scaledBytes(config_.budget_bytes, config_.high_water);
+        const uint64_t low = scaledBytes(config_.budget_bytes, config_.low_water);
+        if (resident_bytes_ > high) {
+            shed(frame, low);
+            over_budget_ = resident_bytes_ > high;
+        } else if (resident_bytes_ < low) {
+            restore(frame, low);
+        }
+    }
+
+    for (uint32_t i = 0; i < resources_.size(); ++i) {
+        const Resource& r = resources_[i];
+        if (!r.live || r.first == r.first_before) continue;
+        ResidencyAction a;
+        a.handle = i;
+        a.first_level = r.first;
+        if (r.first > r.first_before) {
+            a.op = r.first == r.level_count ? ResidencyOp::kEvict
+                                            : ResidencyOp::kDropLevels;
+            a.bytes = r.suffix[r.first_before] - r.suffix[r.first];
+            total_dropped_bytes_ += a.bytes;
+            if (a.op == ResidencyOp::kEvict) ++total_evictions_;
+        } else {
+            a.op = r.first_before == r.level_count ? ResidencyOp::kLoad
+                                                   : ResidencyOp::kRestoreLevels;
+            a.bytes = r.suffix[r.first] - r.suffix[r.first_before];
+            total_restored_bytes_ += a.bytes;
+            if (a.op == ResidencyOp::kLoad) ++total_loads_;
+        }
+        actions.push_back(a);
+    }
+}
+
+ResidencyStats ResidencyManager::stats() const {
+    ResidencyStats s;
+    s.budget_bytes = config_.budget_bytes;
+    s.resident_bytes = resident_bytes_;
+    s.resources = live_count_;
+    for (const Resource& r : resources_) {
+        if (!r.live) continue;
+        if (r.first == r.level_count) ++s.evicted_resources;
+        else if (r.first > r.wanted) ++s.degraded_resources;
+    }
+    s.over_budget = over_budget_;
+    s.total_evictions = total_evictions_;
+    s.total_loads = total_loads_;
+    s.total_dropped_bytes = total_dropped_bytes_;
+    s.total_restored_bytes = total_restored_bytes_;
+    return s;
+}
+
+uint64_t computeResidencyBudget(const ResidencyBudgetInputs& in) {
+    auto afterReserve = [&](uint64_t available) {
+        return available > in.reserve_bytes ? available - in.reserve_bytes : 0;
+    };
+    uint64_t budget = in.cap_bytes != 0 ? in.cap_bytes
+                                        : kUnlimitedResidencyBudget;
+    if (in.vk_heap_budget != 0) {
+        // The driver's budget for this process, minus what the rest of the
+        // process (render targets, ImGui, unmanaged buffers) already holds.
+        const uint64_t others = in.vk_heap_usage > in.managed_bytes
+                                    ? in.vk_heap_usage - in.managed_bytes
+                                    : 0;
+        const uint64_t available =
+            in.vk_heap_budget > others ? in.vk_heap_budget - others : 0;
+        budget = std::min(budget, afterReserve(available));
+    }
+    if (in.device_total != 0) {
+        // Device-wide free memory also sees LibTorch and other processes.
+        const uint64_t available =
+            std::min(in.device_free + in.managed_bytes, in.device_total);
+        budget = std::min(budget, afterReserve(available));
+    }
+    return budget;
+}
+
+} // namespace renderer
+} // namespace engine
@@ -0,0 +1,193 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// residency_manager.h — VRAM budget policy for textures and mesh buffers.
+//
+// ~4 000 unique .rwtex at 256² once cost ~1 GB of VRAM; the fix was a static
+// one (previews box-downscaled to 128², drawable_object.cpp).  This module
+// makes the trade-off dynamic instead: every registered resource carries its
+// per-level byte sizes, the frame it was last drawn and how large it was on
+// screen, and update() compares the resident total against a budget:
+//
+//   - above the HIGH water mark it sheds down to the LOW mark, cheapest
+//     first: long-idle resources are evicted, mips finer than the screen
+//     size needs are dropped, idle resources lose their mips and then go,
+//     and only then are visible resources degraded — evenly, one level at
+//     a time, smallest on screen first;
+//   - below the low mark it restores the finest levels that are wanted,
+//     largest on screen first, capped per frame so a camera cut does not
+//     turn into one long upload hitch;
+//   - an evicted resource that is drawn again gets its mip tail back at
+//     once, whatever the budget says (restore on demand).
+//
+// Restores never go past the low mark and shedding only starts above the
+// high one, so a working set near the budget settles instead of
+// oscillating.  A resource keeps `tail_levels` levels while it is resident
+// at all; a buffer is one level with a tail of one, so it is either
+// resident or evicted.
+//
+// The manager only decides.  update() returns what changed and the owner
+// performs it (frees levels after the frames in flight retire, reads and
+// uploads restored ones); the state already reflects the actions on return.
+// No Vulkan headers are included: the unit tests drive it with synthetic
+// usage traces, and computeResidencyBudget() turns VK_EXT_memory_budget and
+// queryDeviceWideVramBytes numbers into the budget.
+//
+// Not thread-safe: one owner calls it from the render thread.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+namespace renderer {
+
+using ResidencyHandle = uint32_t;
+constexpr ResidencyHandle kInvalidResidencyHandle = 0xffffffffu;
+constexpr uint64_t kUnlimitedResidencyBudget = ~0ull;
+
+enum class ResidencyKind : uint8_t {
+    kTexture,
+    kBuffer,
+};
+
+struct ResidencyResourceDesc {
+    ResidencyKind         kind = ResidencyKind::kTexture;
+    // Bytes of each level, level 0 (full resolution) first.  Buffers and
+    // textures without mips have one entry.
+    std::vector<uint64_t> level_bytes;
+    // Coarsest levels that stay while the resource is resident (>= 1).
+    uint32_t              tail_levels = 1;
+    // Level 0 width in texels; with markUsed's screen size it gives the
+    // finest level worth keeping.  0 = always want level 0.
+    uint32_t              width = 0;
+    // First resident level when added; level_bytes.size() = not resident.
+    uint32_t              first_resident = 0;
+};
+
+enum class ResidencyOp : uint8_t {
+    kDropLevels,     // free levels [old first, first_level)
+    kRestoreLevels,  // load levels [first_level, old first)
+    kEvict,          // free everything
+    kLoad,           // was evicted: load levels [first_level, level count)
+};
+
+struct ResidencyAction {
+    ResidencyHandle handle = kInvalidResidencyHandle;
+    ResidencyOp     op = ResidencyOp::kEvict;
+    uint32_t        first_level = 0;   // first resident level afterwards
+    uint64_t        bytes = 0;         // freed or loaded
+};
+
+struct ResidencyConfig {
+    uint64_t budget_bytes = kUnlimitedResidencyBudget;
+    float    high_water = 0.95f;       // shed above budget * high_water ...
+    float    low_water = 0.85f;        // ... down to budget * low_water
+    // Not drawn for this many frames: mips may be dropped and the resource
+    // evicted before anything on screen is touched.  Keep it above the
+    // frames in flight.
+    uint32_t idle_frames = 8;
+    // Not drawn for this long: evicted first, even ahead of dropping the
+    // unneeded mips of resources still in view.
+    uint32_t evict_after_frames = 600;
+    // Optional restores per update (mandatory tail loads are not capped).
+    uint64_t max_restore_bytes_per_frame = 64ull << 20;
+};
+
+struct ResidencyStats {
+    uint64_t budget_bytes = kUnlimitedResidencyBudget;
+    uint64_t resident_bytes = 0;
+    uint32_t resources = 0;
+    uint32_t evicted_resources = 0;
+    uint32_t degraded_resources = 0;    // resident coarser than wanted
+    bool     over_budget = false;       // last update stayed above high water
+    uint64_t total_evictions = 0;
+    uint64_t total_loads = 0;
+    uint64_t total_dropped_bytes = 0;
+    uint64_t total_restored_bytes = 0;
+};
+
+class ResidencyManager {
+public:
+    explicit ResidencyManager(const ResidencyConfig& config = {});
+
+    // `frame` counts as the resource's last use, so a resource that was
+    // just created is not shed before it has had a chance to be drawn.
+    ResidencyHandle add(const ResidencyResourceDesc& desc, uint64_t frame);
+    void remove(ResidencyHandle handle);
+
+    // The resource is drawn in `frame`, `screen_px` texels wide on screen
+    // (0 = unknown: wants level 0).  Several calls in one frame keep the
+    // largest size.
+    void markUsed(ResidencyHandle handle, uint64_t frame, float screen_px = 0.0f);
+    // Pinned resources are counted but never dropped or evicted.
+    void setPinned(ResidencyHandle handle, bool pinned);
+
+    void setBudget(uint64_t bytes) { config_.budget_bytes = bytes; }
+    uint64_t budget() const { return config_.budget_bytes; }
+
+    // Plan `frame`.  `actions` is replaced by this frame's changes, at most
+    // one per resource.
+    void update(uint64_t frame, std::vector<ResidencyAction>& actions);
+
+    bool valid(ResidencyHandle handle) const;
+    uint32_t firstResident(ResidencyHandle handle) const;
+    uint32_t wantedLevel(ResidencyHandle handle) const;
+    uint32_t levelCount(ResidencyHandle handle) const;
+    bool isResident(ResidencyHandle handle) const;
+    uint64_t residentBytes() const { return resident_bytes_; }
+    const ResidencyConfig& config() const { return config_; }
+    ResidencyStats stats() const;
+
+private:
+    struct Resource {
+        bool                  live = false;
+        bool                  pinned = false;
+        ResidencyKind         kind = ResidencyKind::kTexture;
+        std::vector<uint64_t> suffix;      // bytes of levels [l, n); [n] = 0
+        uint32_t              level_count = 0;
+        uint32_t              floor_level = 0;   // first level of the tail
+        uint32_t              width = 0;
+        uint32_t              first = 0;         // level_count = evicted
+        uint32_t              first_before = 0;  // at the start of update()
+        uint32_t              wanted = 0;
+        float                 screen_px = 0.0f;
+        uint64_t              last_used = 0;
+    };
+
+    uint64_t idleFrames(const Resource& r, uint64_t frame) const;
+    float importance(const Resource& r) const;
+    void setFirst(Resource& r, uint32_t first);
+    void shed(uint64_t frame, uint64_t target);
+    void restore(uint64_t frame, uint64_t target);
+
+    ResidencyConfig              config_;
+    std::vector<Resource>        resources_;
+    std::vector<ResidencyHandle> free_handles_;
+    std::vector<uint32_t>        scratch_;
+    uint64_t                     resident_bytes_ = 0;
+    uint32_t                     live_count_ = 0;
+    bool                         over_budget_ = false;
+    uint64_t                     total_evictions_ = 0;
+    uint64_t                     total_loads_ = 0;
+    uint64_t                     total_dropped_bytes_ = 0;
+    uint64_t                     total_restored_bytes_ = 0;
+};
+
+// What the managed resources may occupy, from the driver's and the
+// device's view of VRAM.  Bytes already held by the manager are added back
+// (they are ours to rearrange), `reserve_bytes` is kept free for render
+// targets and transient allocations, and the tightest source wins.
+// Unknown sources (zero) are skipped; with none and no cap the result is
+// kUnlimitedResidencyBudget.
+struct ResidencyBudgetInputs {
+    uint64_t vk_heap_budget = 0;   // VK_EXT_memory_budget, device-local heaps
+    uint64_t vk_heap_usage = 0;
+    uint64_t device_free = 0;      // queryDeviceWideVramBytes
+    uint64_t device_total = 0;
+    uint64_t managed_bytes = 0;    // ResidencyManager::residentBytes()
+    uint64_t reserve_bytes = 256ull << 20;
+    uint64_t cap_bytes = 0;        // user cap, 0 = none
+};
+uint64_t computeResidencyBudget(const ResidencyBudgetInputs& in);
+
+} // namespace renderer
+} // namespace engine
@@ -0,0 +1,97 @@
+//
+// staging_ring.cpp — FIFO byte-range bookkeeping for the upload scheduler's
+// staging buffer.  See the header for the batch / retire model.
+//
+#include "staging_ring.h"
+
+namespace engine {
+namespace renderer {
+
+namespace {
+inline uint64_t alignUp(uint64_t v, uint64_t a) {
+    if (a <= 1) return v;
+    if ((a & (a - 1)) == 0) return (v + a - 1) & ~(a - 1);
+    return (v + a - 1) / a * a;
+}
+}  // namespace
+
+StagingRing::StagingRing(uint64_t capacity)
+    : capacity_(capacity) {
+}
+
+bool StagingRing::allocate(
+    uint64_t size,
+    uint64_t alignment,
+    uint64_t& out_offset) {
+    if (size == 0 || size > capacity_) {
+        return false;
+    }
+    if (used_ == 0) {
+        // Nothing outstanding: restart at 0 so the whole ring is one gap.
+        head_ = tail_ = 0;
+    }
+    if (used_ >= capacity_ || (head_ == tail_ && used_ != 0)) {
+        return false;
+    }
+
+    if (head_ >= tail_) {
+        // Free space is [head, capacity) followed by [0, tail).
+        const uint64_t aligned = alignUp(head_, alignment);
+        if (aligned + size <= capacity_) {
+            open_bytes_ += aligned + size - head_;
+            used_ += aligned + size - head_;
+            out_offset = aligned;
+            head_ = aligned + size;
+            if (head_ == capacity_) {
+                head_ = 0;
+            }
+            return true;
+        }
+        // Wrap: the unused tail end is charged to this batch so it comes
+        // back together with the allocation that skipped it.
+        if (size <= tail_) {
+            const uint64_t skipped = capacity_ - head_;
+            open_bytes_ += skipped + size;
+            used_ += skipped + size;
+            out_offset = 0;
+            head_ = size;
+            return true;
+        }
+        return false;
+    }
+
+    // head < tail: the only gap is [head, tail).
+    const uint64_t aligned = alignUp(head_, alignment);
+    if (aligned + size > tail_) {
+        return false;
+    }
+    open_bytes_ += aligned + size - head_;
+    used_ += aligned + size - head_;
+    out_offset = aligned;
+    head_ = aligned + size;
+    return true;
+}
+
+void StagingRing::closeBatch(uint64_t retire_value) {
+    if (open_bytes_ == 0) {
+        return;
+    }
+    batches_.push_back({ head_, open_bytes_, retire_value });
+    open_bytes_ = 0;
+}
+
+void StagingRing::reclaim(uint64_t completed_value) {
+    while (!batches_.empty() &&
+           batches_.front().retire_value <= completed_value) {
+        const Batch& b = batches_.front();
+        used_ -= b.bytes;
+        tail_ = b.end == capacity_ ? 0 : b.end;
+        batches_.pop_front();
+    }
+    if (used_ == 0) {
+        head_ = tail_ = 0;
+    }
+}
+
+} // namespace renderer
+} // namespace engine
@@ -0,0 +1,78 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// staging_ring.h — bookkeeping for a circular, persistently-mapped staging
+// buffer (see UploadScheduler).
+//
+// The ring hands out byte ranges in FIFO order.  Allocations made between two
+// closeBatch() calls form one batch; the batch is tagged with the timeline
+// value its GPU submission will signal, and its bytes come back in one piece
+// once reclaim() is told that value has completed.  Because batches retire in
+// submission order, free space is always the single gap between head and tail
+// — no free lists, no per-allocation records.
+//
+// Pure CPU arithmetic: the buffer itself lives in UploadScheduler, which makes
+// this class unit-testable without a device.  Not thread-safe; the scheduler
+// only touches it from the loader thread.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace engine {
+namespace renderer {
+
+// Staging offset for buffer→image copies.  vkCmdCopyBufferToImage wants
+// bufferOffset to be a multiple of 4 and of the texel size, or of the block
+// size for compressed formats.  Uncompressed texels are 1/2/3/4/6/8/12/16
+// bytes (12 is RGB32F) and BC blocks are 8 or 16, so the least common
+// multiple of all of those and 4 is 48.  16 is NOT enough:
+// 12-byte texels at a 16-aligned offset like 16 or 32 break the rule.
+constexpr uint64_t kImageStagingAlignment = 48;
+
+class StagingRing {
+public:
+    explicit StagingRing(uint64_t capacity);
+
+    // Reserve `size` bytes aligned to `alignment` (any non-zero value; see
+    // kImageStagingAlignment for why it is not always a power of two) for the
+    // currently open batch.  Returns false if the ring has no contiguous
+    // gap large enough; the caller is expected to submit + reclaim and retry
+    // (or fall back to a dedicated staging buffer for oversized uploads).
+    bool allocate(uint64_t size, uint64_t alignment, uint64_t& out_offset);
+
+    // Seal everything allocated since the previous close; those bytes are
+    // released by the first reclaim() with completed_value >= retire_value.
+    // Values must be monotonically increasing.  No-op for an empty batch.
+    void closeBatch(uint64_t retire_value);
+
+    // Release every closed batch whose retire value is <= completed_value.
+    void reclaim(uint64_t completed_value);
+
+    uint64_t capacity() const { return capacity_; }
+    // Bytes held by open + in-flight batches, including alignment padding
+    // and the tail skipped when an allocation wraps.
+    uint64_t usedBytes() const { return used_; }
+    uint64_t openBytes() const { return open_bytes_; }
+    size_t pendingBatchCount() const { return batches_.size(); }
+    // Retire value of the oldest closed batch, or 0 if nothing is in flight.
+    uint64_t oldestPendingValue() const {
+        return batches_.empty() ? 0 : batches_.front().retire_value;
+    }
+
+private:
+    struct Batch {
+        uint64_t end;            // head position when the batch was closed
+        uint64_t bytes;          // bytes to return to the ring on retire
+        uint64_t retire_value;
+    };
+
+    uint64_t capacity_;
+    uint64_t head_ = 0;          // next byte to hand out
+    uint64_t tail_ = 0;          // first byte still owned by a batch
+    uint64_t used_ = 0;
+    uint64_t open_bytes_ = 0;
+    std::deque<Batch> batches_;
+};
+
+} // namespace renderer
+} // namespace engine
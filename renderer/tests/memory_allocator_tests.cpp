@@ -0,0 +1,411 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// memory_allocator_tests.cpp — standalone unit tests for the device-memory
+// sub-allocator core (renderer/memory_allocator.*).
+//
+// Runs entirely on the CPU: a fake memory-type table stands in for
+// VkPhysicalDeviceMemoryProperties and the block backend hands out malloc'd
+// blocks.  Exercises: TLSF placement / alignment / coalescing, pool growth and
+// block reuse, dedicated promotion, persistent mapping, heap stats, the
+// defragmentation hooks, and concurrent allocate/free from several threads.
+//
+// Build:
+//   g++ -std=c++20 -pthread -Irenderer renderer/tests/memory_allocator_tests.cpp
+//       renderer/memory_allocator.cpp -o memory_allocator_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "memory_allocator.h"
+
+using namespace engine::renderer;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+namespace {
+constexpr MemoryPropertyFlags kDeviceLocal =
+    static_cast<MemoryPropertyFlags>(MemoryPropertyFlagBits::DEVICE_LOCAL_BIT);
+constexpr MemoryPropertyFlags kHostVisible =
+    static_cast<MemoryPropertyFlags>(MemoryPropertyFlagBits::HOST_VISIBLE_BIT) |
+    static_cast<MemoryPropertyFlags>(MemoryPropertyFlagBits::HOST_COHERENT_BIT);
+
+// Discrete-GPU-like table: type 0 = VRAM, type 1 = host-visible sysmem,
+// type 2 = small BAR (device-local + host-visible).
+MemoryTypeTable fakeTable() {
+    MemoryTypeTable t;
+    t.heaps = { { 8ull << 30, 0 }, { 16ull << 30, 0 }, { 256ull << 20, 0 } };
+    t.types = { { kDeviceLocal, 0 }, { kHostVisible, 1 },
+                { kDeviceLocal | kHostVisible, 2 } };
+    return t;
+}
+
+struct FakeBackend {
+    std::atomic<int> live_blocks{0};
+    std::atomic<int> total_allocs{0};
+    std::atomic<int> fail_above_mb{0};   // 0 = never fail
+
+    MemoryBlockBackend make() {
+        MemoryBlockBackend b;
+        b.allocate_block = [this](uint32_t, uint64_t size, MemoryAllocateFlags,
+                                  bool map, uint64_t* handle, void** mapped) {
+            const int limit = fail_above_mb.load();
+            if (limit && size > (uint64_t(limit) << 20)) {
+                return false;
+            }
+            // Host-visible blocks get real storage so writes through the
+            // mapped pointer can be checked; device-local ones only need a
+            // unique non-zero handle.
+            void* p = map ? std::malloc(size_t(size)) : std::malloc(1);
+            *handle = reinterpret_cast<uint64_t>(p);
+            *mapped = map ? p : nullptr;
+            ++live_blocks;
+            ++total_allocs;
+            return true;
+        };
+        b.free_block = [this](uint32_t, uint64_t handle, bool) {
+            std::free(reinterpret_cast<void*>(handle));
+            --live_blocks;
+        };
+        return b;
+    }
+};
+} // namespace
+
+// ── 1. TLSF metadata: placement, alignment, coalescing ───────────────────────
+static void test_tlsf_basic() {
+    TlsfBlockMetadata m(1 << 20);
+    CHECK(m.validate());
+    uint64_t a_off = ~0ull, b_off = ~0ull, c_off = ~0ull;
+    const uint32_t a = m.allocate(1000, 1, nullptr, &a_off);
+    const uint32_t b = m.allocate(4096, 4096, nullptr, &b_off);
+    const uint32_t c = m.allocate(300, 256, nullptr, &c_off);
+    CHECK(a != TlsfBlockMetadata::kInvalidNode);
+    CHECK(b != TlsfBlockMetadata::kInvalidNode);
+    CHECK(c != TlsfBlockMetadata::kInvalidNode);
+    CHECK(b_off % 4096 == 0);
+    CHECK(c_off % 256 == 0);
+    CHECK(m.allocationCount() == 3);
+    CHECK(m.usedBytes() == 1000 + 4096 + 300);
+    CHECK(m.validate());
+
+    // No overlap.
+    auto overlap = [](uint64_t o0, uint64_t s0, uint64_t o1, uint64_t s1) {
+        return o0 < o1 + s1 && o1 < o0 + s0;
+    };
+    CHECK(!overlap(a_off, 1000, b_off, 4096));
+    CHECK(!overlap(a_off, 1000, c_off, 300));
+    CHECK(!overlap(b_off, 4096, c_off, 300));
+
+    // Free in an order that exercises both left and right merges; the
+    // block must collapse back to one free range.
+    m.free(b);
+    CHECK(m.validate());
+    m.free(a);
+    CHECK(m.validate());
+    m.free(c);
+    CHECK(m.validate());
+    CHECK(m.empty());
+    CHECK(m.largestFreeRange() == (1 << 20));
+
+    // Exhaustion returns kInvalidNode rather than overlapping.
+    uint64_t off;
+    CHECK(m.allocate((1 << 20) + 1, 1, nullptr, &off) == TlsfBlockMetadata::kInvalidNode);
+    const uint32_t whole = m.allocate(1 << 20, 1, nullptr, &off);
+    CHECK(whole != TlsfBlockMetadata::kInvalidNode && off == 0);
+    CHECK(m.allocate(1, 1, nullptr, &off) == TlsfBlockMetadata::kInvalidNode);
+    m.free(whole);
+    CHECK(m.validate() && m.empty());
+    std::printf("  [ok] TLSF placement / alignment / coalescing\n");
+}
+
+// ── 2. TLSF randomized stress against validate() ─────────────────────────────
+static void test_tlsf_random() {
+    TlsfBlockMetadata m(64ull << 20);
+    std::mt19937 rng(1234);
+    struct Live { uint32_t node; uint64_t off, size, align; };
+    std::vector<Live> live;
+    for (int i = 0; i < 20000; ++i) {
+        if (live.empty() || (rng() % 3) != 0) {
+            const uint64_t size = 1 + rng() % 200000;
+            const uint64_t align = 1ull << (rng() % 13);
+            uint64_t off;
+            const uint32_t n = m.allocate(size, align, nullptr, &off);
+            if (n != TlsfBlockMetadata::kInvalidNode) {
+                CHECK(off % align == 0);
+                CHECK(off + size <= m.size());
+                live.push_back({ n, off, size, align });
+            }
+        }
+        else {
+            const size_t k = rng() % live.size();
+            m.free(live[k].node);
+            live[k] = live.back();
+            live.pop_back();
+        }
+        if ((i & 1023) == 0) {
+            CHECK(m.validate());
+        }
+    }
+    CHECK(m.validate());
+    for (auto& l : live) m.free(l.node);
+    CHECK(m.validate() && m.empty());
+    std::printf("  [ok] TLSF randomized stress (%d ops)\n", 20000);
+}
+
+// ── 3. Pools: many small resources share few device allocations ──────────────
+static void test_pool_sharing() {
+    FakeBackend fb;
+    MemoryAllocatorConfig cfg;
+    cfg.preferred_block_size = 16ull << 20;
+    MemoryAllocator alloc(fakeTable(), fb.make(), cfg);
+
+    std::vector<Allocation> allocs;
+    for (int i = 0; i < 4000; ++i) {
+        AllocationRequest r;
+        r.size = 16 * 1024;                    // a 64x64 RGBA8 .rwtex
+        r.alignment = 256;
+        r.required_flags = kDeviceLocal;
+        r.kind = AllocationKind::kImage;
+        allocs.push_back(alloc.allocate(r));
+        CHECK(allocs.back().valid());
+        CHECK(!allocs.back().dedicated);
+        CHECK(allocs.back().offset % 256 == 0);
+    }
+    // 4000 x 16 KiB = 62.5 MiB -> 4 x 16 MiB blocks, not 4000 allocations.
+    auto s = alloc.getStats();
+    CHECK(s.heaps[0].block_count == 4);
+    CHECK(s.heaps[0].allocation_count == 4000);
+    CHECK(s.heaps[0].allocation_bytes == 4000ull * 16 * 1024);
+    CHECK(fb.live_blocks == 4);
+
+    // Buffers never share an image block.
+    AllocationRequest br;
+    br.size = 1024;
+    br.required_flags = kDeviceLocal;
+    br.kind = AllocationKind::kBuffer;
+    Allocation buf = alloc.allocate(br);
+    CHECK(buf.valid() && buf.pool != allocs[0].pool);
+    CHECK(alloc.getStats().pool_count == 2);
+    alloc.free(buf);
+
+    for (auto& a : allocs) alloc.free(a);
+    s = alloc.getStats();
+    CHECK(s.heaps[0].allocation_count == 0);
+    // empty_blocks_to_keep = 1 per pool (image + buffer pools).
+    CHECK(fb.live_blocks == 2);
+    CHECK(alloc.releaseEmptyBlocks() == 2);
+    CHECK(fb.live_blocks == 0);
+    CHECK(alloc.getStats().heaps[0].block_bytes == 0);
+    std::printf("  [ok] pooled sub-allocation (4000 images -> 4 blocks)\n");
+}
+
+// ── 4. Dedicated promotion, memory-type selection, persistent mapping ────────
+static void test_dedicated_and_mapping() {
+    FakeBackend fb;
+    MemoryAllocatorConfig cfg;
+    cfg.preferred_block_size = 16ull << 20;
+    MemoryAllocator alloc(fakeTable(), fb.make(), cfg);
+
+    CHECK(alloc.findMemoryType(0x7, kDeviceLocal) == 0);
+    CHECK(alloc.findMemoryType(0x7, kHostVisible) == 1);
+    CHECK(alloc.findMemoryType(0x4, kDeviceLocal | kHostVisible) == 2);
+    CHECK(alloc.findMemoryType(0x1, kHostVisible) == 0xffffffffu);
+
+    AllocationRequest big;
+    big.size = 12ull << 20;          // >= block / 2 -> dedicated
+    big.required_flags = kDeviceLocal;
+    Allocation a = alloc.allocate(big);
+    CHECK(a.valid() && a.dedicated && a.offset == 0);
+    CHECK(alloc.getStats().heaps[0].dedicated_count == 1);
+
+    AllocationRequest forced;
+    forced.size = 4096;
+    forced.required_flags = kDeviceLocal;
+    forced.dedicated = true;
+    Allocation f = alloc.allocate(forced);
+    CHECK(f.valid() && f.dedicated);
+
+    // Host-visible sub-allocations carry a pointer into the block's single
+    // persistent mapping; two neighbours must not alias.
+    AllocationRequest up;
+    up.size = 256;
+    up.alignment = 64;
+    up.required_flags = kHostVisible;
+    Allocation u0 = alloc.allocate(up);
+    Allocation u1 = alloc.allocate(up);
+    CHECK(u0.mapped && u1.mapped && u0.block_handle == u1.block_handle);
+    CHECK(static_cast<uint8_t*>(u0.mapped) ==
+          reinterpret_cast<uint8_t*>(u0.block_handle) + u0.offset);
+    std::memset(u0.mapped, 0xAB, 256);
+    std::memset(u1.mapped, 0xCD, 256);
+    CHECK(static_cast<uint8_t*>(u0.mapped)[255] == 0xAB);
+    CHECK(alloc.getStats().heaps[1].allocation_count == 2);
+
+    // Device-local sub-allocations are never mapped.
+    AllocationRequest dl;
+    dl.size = 256;
+    dl.required_flags = kDeviceLocal;
+    Allocation d = alloc.allocate(dl);
+    CHECK(d.valid() && d.mapped == nullptr);
+
+    // Invalid requests fail cleanly.
+    AllocationRequest bad;
+    bad.size = 64;
+    bad.memory_type_bits = 0x1;
+    bad.required_flags = kHostVisible;
+    CHECK(!alloc.allocate(bad).valid());
+
+    alloc.free(a);
+    alloc.free(f);
+    alloc.free(u0);
+    alloc.free(u1);
+    alloc.free(d);
+    CHECK(alloc.getStats().heaps[0].dedicated_count == 0);
+    alloc.releaseEmptyBlocks();
+    CHECK(fb.live_blocks == 0);
+    std::printf("  [ok] dedicated promotion / type selection / mapping\n");
+}
+
+// ── 5. Block-size fallback when the backend refuses big blocks ───────────────
+static void test_block_fallback() {
+    FakeBackend fb;
+    fb.fail_above_mb = 4;            // driver refuses anything > 4 MiB
+    MemoryAllocatorConfig cfg;
+    cfg.preferred_block_size = 32ull << 20;
+    cfg.dedicated_threshold = 8ull << 20;
+    MemoryAllocator alloc(fakeTable(), fb.make(), cfg);
+
+    AllocationRequest r;
+    r.size = 1 << 20;
+    r.required_flags = kDeviceLocal;
+    Allocation a = alloc.allocate(r);
+    CHECK(a.valid() && !a.dedicated);
+    CHECK(alloc.getStats().heaps[0].block_bytes == (4ull << 20));
+    alloc.free(a);
+    alloc.releaseEmptyBlocks();
+    CHECK(fb.live_blocks == 0);
+    std::printf("  [ok] block-size fallback on allocation failure\n");
+}
+
+// ── 6. Defragmentation hooks ─────────────────────────────────────────────────
+static void test_defragmentation() {
+    FakeBackend fb;
+    MemoryAllocatorConfig cfg;
+    cfg.preferred_block_size = 4ull << 20;
+    cfg.empty_blocks_to_keep = 0;
+    MemoryAllocator alloc(fakeTable(), fb.make(), cfg);
+
+    // Fill three blocks, then free most of the allocations so every block
+    // is sparse: a compaction pass should be able to empty one of them.
+    std::vector<Allocation> allocs;
+    std::vector<int> tags(48);
+    for (int i = 0; i < 48; ++i) {
+        AllocationRequest r;
+        r.size = 256 * 1024;
+        r.alignment = 256;
+        r.required_flags = kDeviceLocal;
+        r.user_data = &tags[i];
+        allocs.push_back(alloc.allocate(r));
+        CHECK(allocs.back().valid());
+    }
+    CHECK(alloc.getStats().heaps[0].block_count == 3);
+    std::vector<Allocation> keep;
+    for (int i = 0; i < 48; ++i) {
+        if (i % 4 == 0) keep.push_back(allocs[i]);
+        else alloc.free(allocs[i]);
+    }
+    CHECK(alloc.getStats().heaps[0].allocation_count == 12);
+
+    auto moves = alloc.beginDefragmentation(~0ull);
+    CHECK(!moves.empty());
+    for (auto& mv : moves) {
+        CHECK(mv.src.block != mv.dst.block);
+        CHECK(mv.dst.size == mv.src.size);
+        CHECK(mv.user_data != nullptr);
+        CHECK(mv.dst.offset % 256 == 0);
+        // Owner rebinds: replace its allocation record with dst.
+        for (auto& k : keep) {
+            if (k.block_handle == mv.src.block_handle && k.offset == mv.src.offset) {
+                k = mv.dst;
+            }
+        }
+    }
+    alloc.endDefragmentation(moves);
+    // The drained block was released.
+    CHECK(alloc.getStats().heaps[0].block_count == 2);
+    CHECK(alloc.getStats().heaps[0].allocation_count == 12);
+    for (auto& k : keep) alloc.free(k);
+    CHECK(fb.live_blocks == 0);
+
+    // Budget-limited pass reserves nothing.
+    CHECK(alloc.beginDefragmentation(0).empty());
+    std::printf("  [ok] defragmentation hooks (%zu moves)\n", moves.size());
+}
+
+// ── 7. Loader-thread concurrency ─────────────────────────────────────────────
+static void test_concurrency() {
+    FakeBackend fb;
+    MemoryAllocatorConfig cfg;
+    cfg.preferred_block_size = 8ull << 20;
+    MemoryAllocator alloc(fakeTable(), fb.make(), cfg);
+
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{0};
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(77 + t);
+            std::vector<Allocation> mine;
+            for (int i = 0; i < 5000; ++i) {
+                if (mine.empty() || rng() % 2) {
+                    AllocationRequest r;
+                    r.size = 64 + rng() % 65536;
+                    r.alignment = 16;
+                    r.required_flags = (rng() % 2) ? kDeviceLocal : kHostVisible;
+                    r.kind = (rng() % 2) ? AllocationKind::kBuffer : AllocationKind::kImage;
+                    Allocation a = alloc.allocate(r);
+                    if (!a.valid()) ++failures;
+                    else mine.push_back(a);
+                }
+                else {
+                    const size_t k = rng() % mine.size();
+                    alloc.free(mine[k]);
+                    mine[k] = mine.back();
+                    mine.pop_back();
+                }
+            }
+            for (auto& a : mine) alloc.free(a);
+        });
+    }
+    for (auto& th : threads) th.join();
+    CHECK(failures == 0);
+    auto s = alloc.getStats();
+    CHECK(s.total_allocation_count == 0);
+    CHECK(s.heaps[0].allocation_bytes == 0 && s.heaps[1].allocation_bytes == 0);
+    alloc.releaseEmptyBlocks();
+    CHECK(fb.live_blocks == 0);
+    std::printf("  [ok] concurrent allocate/free from 4 threads\n");
+}
+
+int main() {
+    std::printf("memory allocator tests\n");
+    test_tlsf_basic();
+    test_tlsf_random();
+    test_pool_sharing();
+    test_dedicated_and_mapping();
+    test_block_fallback();
+    test_defragmentation();
+    test_concurrency();
+    std::printf("all %d checks passed\n", g_checks);
+    return 0;
+}
@@ -0,0 +1,539 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// residency_manager_tests.cpp — standalone unit tests for the VRAM residency
+// policy (renderer/residency_manager.*).
+//
+// Runs entirely on the CPU: synthetic usage traces stand in for the frames a
+// renderer would draw, and a mirror of every resource's resident levels is
+// kept from the returned actions to check they describe the state exactly.
+// Exercises: the budget combination, screen-size driven mip selection,
+// shedding order (idle before visible, unneeded mips before needed ones),
+// even degradation, restore on demand, the per-frame restore cap, pinning,
+// hysteresis under an oscillating camera, and a long randomised trace.
+//
+// Build:
+//   g++ -std=c++20 -Irenderer renderer/tests/residency_manager_tests.cpp
+//       renderer/residency_manager.cpp -o residency_manager_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "residency_manager.h"
+
+using namespace engine::renderer;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+namespace {
+constexpr uint64_t kMiB = 1ull << 20;
+
+// RGBA8 square texture, full chain down to 1x1.
+ResidencyResourceDesc texture(uint32_t width, uint32_t tail_levels = 1) {
+    ResidencyResourceDesc d;
+    d.kind = ResidencyKind::kTexture;
+    d.width = width;
+    d.tail_levels = tail_levels;
+    for (uint32_t w = width; ; w >>= 1) {
+        d.level_bytes.push_back(uint64_t(w) * w * 4);
+        if (w == 1) break;
+    }
+    return d;
+}
+
+ResidencyResourceDesc buffer(uint64_t bytes) {
+    ResidencyResourceDesc d;
+    d.kind = ResidencyKind::kBuffer;
+    d.level_bytes = { bytes };
+    return d;
+}
+
+uint64_t textureBytes(uint32_t width, uint32_t first) {
+    uint64_t total = 0;
+    for (uint32_t w = width >> first; ; w >>= 1) {
+        total += uint64_t(w) * w * 4;
+        if (w <= 1) break;
+    }
+    return total;
+}
+
+// What the owner would hold if it applied every action it was given.
+struct Mirror {
+    std::unordered_map<ResidencyHandle, uint32_t> first;
+
+    void apply(const ResidencyManager& m,
+               const std::vector<ResidencyAction>& actions) {
+        for (const ResidencyAction& a : actions) {
+            const uint32_t n = m.levelCount(a.handle);
+            const uint32_t before = first[a.handle];
+            switch (a.op) {
+            case ResidencyOp::kDropLevels:
+                CHECK(before < a.first_level && a.first_level < n);
+                break;
+            case ResidencyOp::kRestoreLevels:
+                CHECK(a.first_level < before && before < n);
+                break;
+            case ResidencyOp::kEvict:
+                CHECK(before < n && a.first_level == n);
+                break;
+            case ResidencyOp::kLoad:
+                CHECK(before == n && a.first_level < n);
+                break;
+            }
+            CHECK(a.bytes > 0);
+            first[a.handle] = a.first_level;
+        }
+        for (const auto& [h, f] : first)
+            CHECK(m.firstResident(h) == f);
+    }
+};
+} // namespace
+
+// ── computeResidencyBudget ──────────────────────────────────────────────────
+static void test_budget_inputs() {
+    ResidencyBudgetInputs in;
+    in.reserve_bytes = 100;
+    CHECK(computeResidencyBudget(in) == kUnlimitedResidencyBudget);
+
+    in.cap_bytes = 5000;
+    CHECK(computeResidencyBudget(in) == 5000);
+
+    // Driver budget 4000, process uses 3000 of which 1000 is ours: the
+    // other 2000 stay, so we may hold 2000 minus the reserve.
+    in.vk_heap_budget = 4000;
+    in.vk_heap_usage = 3000;
+    in.managed_bytes = 1000;
+    CHECK(computeResidencyBudget(in) == 1900);
+
+    // Device-wide: 500 free plus our 1000 is tighter.
+    in.device_total = 8000;
+    in.device_free = 500;
+    CHECK(computeResidencyBudget(in) == 1400);
+
+    // The cap wins when it is the tightest.
+    in.cap_bytes = 700;
+    CHECK(computeResidencyBudget(in) == 700);
+
+    // Nothing left after the reserve: zero, not a wrap-around.
+    in.cap_bytes = 0;
+    in.device_free = 0;
+    in.managed_bytes = 50;
+    CHECK(computeResidencyBudget(in) == 0);
+
+    // Usage below what we think we hold (driver lag): others count as 0.
+    ResidencyBudgetInputs lag;
+    lag.reserve_bytes = 0;
+    lag.vk_heap_budget = 1000;
+    lag.vk_heap_usage = 100;
+    lag.managed_bytes = 400;
+    CHECK(computeResidencyBudget(lag) == 1000);
+}
+
+// ── Registration and bookkeeping ────────────────────────────────────────────
+static void test_add_remove() {
+    ResidencyManager m;
+    const ResidencyHandle t = m.add(texture(256), 0);
+    const ResidencyHandle b = m.add(buffer(1000), 0);
+    CHECK(m.levelCount(t) == 9);
+    CHECK(m.isResident(t) && m.isResident(b));
+    CHECK(m.residentBytes() == textureBytes(256, 0) + 1000);
+
+    // Not resident at registration: only counted once loaded.
+    ResidencyResourceDesc cold = texture(64);
+    cold.first_resident = static_cast<uint32_t>(cold.level_bytes.size());
+    const ResidencyHandle c = m.add(cold, 0);
+    CHECK(!m.isResident(c));
+    CHECK(m.residentBytes() == textureBytes(256, 0) + 1000);
+
+    // Starting inside the tail is clamped to the tail.
+    ResidencyResourceDesc deep = texture(64, 3);
+    deep.first_resident = 6;
+    const ResidencyHandle d = m.add(deep, 0);
+    CHECK(m.firstResident(d) == 4);
+
+    m.remove(t);
+    CHECK(!m.valid(t));
+    CHECK(m.residentBytes() == 1000 + textureBytes(64, 4));
+    m.remove(t);                                   // double remove is a no-op
+    CHECK(m.stats().resources == 3);
+
+    const ResidencyHandle reused = m.add(buffer(10), 1);
+    CHECK(reused == t);                            // handles are recycled
+    CHECK(m.stats().resources == 4);
+}
+
+// ── Screen-size driven level selection ──────────────────────────────────────
+static void test_wanted_level() {
+    ResidencyManager m;
+    const ResidencyHandle t = m.add(texture(1024, 4), 0);
+
+    m.markUsed(t, 1, 64.0f);
+    CHECK(m.wantedLevel(t) == 4);                  // 64 wide is exactly level 4
+    m.markUsed(t, 1, 65.0f);
+    CHECK(m.wantedLevel(t) == 3);                  // larger call in the frame wins
+    m.markUsed(t, 1, 10.0f);
+    CHECK(m.wantedLevel(t) == 3);
+
+    m.markUsed(t, 2, 1.0f);
+    CHECK(m.wantedLevel(t) == 7);                  // never into the tail
+    m.markUsed(t, 3);
+    CHECK(m.wantedLevel(t) == 0);                  // size unknown: full res
+    m.markUsed(t, 4, 5000.0f);
+    CHECK(m.wantedLevel(t) == 0);
+
+    // Unlimited budget: unneeded levels stay; nothing happens at all.
+    std::vector<ResidencyAction> actions;
+    m.markUsed(t, 5, 64.0f);
+    m.update(5, actions);
+    CHECK(actions.empty());
+    CHECK(m.firstResident(t) == 0);
+}
+
+// ── Shedding order ──────────────────────────────────────────────────────────
+static void test_shed_order() {
+    ResidencyConfig cfg;
+    cfg.idle_frames = 4;
+    cfg.evict_after_frames = 100;
+    ResidencyManager m(cfg);
+    Mirror mirror;
+
+    // A: on screen, needs full res.  B: on screen but tiny (level 4 is
+    // enough).  C: off screen for a while.  D: off screen for ages.
+    const ResidencyHandle a = m.add(texture(256), 0);
+    const ResidencyHandle b = m.add(texture(256), 0);
+    const ResidencyHandle c = m.add(texture(256), 0);
+    const ResidencyHandle d = m.add(texture(256), 0);
+    for (ResidencyHandle h : { a, b, c, d }) mirror.first[h] = 0;
+
+    const uint64_t full = textureBytes(256, 0);
+    std::vector<ResidencyAction> actions;
+    for (uint64_t f = 0; f <= 200; ++f) {
+        m.markUsed(a, f, 256.0f);
+        m.markUsed(b, f, 16.0f);
+        if (f < 190) m.markUsed(c, f, 256.0f);
+        if (f < 10) m.markUsed(d, f, 256.0f);
+        m.update(f, actions);
+        mirror.apply(m, actions);
+        CHECK(actions.empty());                    // unlimited so far
+    }
+
+    // Room for three full textures: the ancient one goes, nothing else.
+    m.setBudget(uint64_t(double(full) * 3.0 / 0.85) + 1);
+    m.update(201, actions);
+    mirror.apply(m, actions);
+    CHECK(actions.size() == 1);
+    CHECK(actions[0].handle == d && actions[0].op == ResidencyOp::kEvict);
+    CHECK(actions[0].bytes == full);
+
+    // Tighter: B's unneeded mips go next, before C is touched.
+    m.setBudget(uint64_t(double(full * 2 + textureBytes(256, 4)) / 0.85) + 1);
+    m.markUsed(a, 202, 256.0f);
+    m.markUsed(b, 202, 16.0f);
+    m.update(202, actions);
+    mirror.apply(m, actions);
+    CHECK(actions.size() == 1);
+    CHECK(actions[0].handle == b && actions[0].op == ResidencyOp::kDropLevels);
+    CHECK(actions[0].first_level == 4);
+    CHECK(m.firstResident(c) == 0);
+
+    // Tighter still: idle C loses its mips, then is evicted — A untouched.
+    m.setBudget(uint64_t(double(full + textureBytes(256, 4) + 4) / 0.85));
+    m.markUsed(a, 203, 256.0f);
+    m.markUsed(b, 203, 16.0f);
+    m.update(203, actions);
+    mirror.apply(m, actions);
+    CHECK(actions.size() == 1);
+    CHECK(actions[0].handle == c && actions[0].op == ResidencyOp::kEvict);
+    CHECK(m.firstResident(a) == 0);
+    CHECK(m.firstResident(b) == 4);
+    CHECK(!m.stats().over_budget);
+    CHECK(m.stats().evicted_resources == 2);
+}
+
+// ── Idle resources lose mips before they are evicted ────────────────────────
+static void test_idle_drops_mips_first() {
+    ResidencyConfig cfg;
+    cfg.idle_frames = 2;
+    ResidencyManager m(cfg);
+    const ResidencyHandle big = m.add(texture(512, 3), 0);
+    const ResidencyHandle pinned = m.add(texture(512), 0);
+    m.setPinned(pinned, true);
+
+    std::vector<ResidencyAction> actions;
+    const uint64_t tail = textureBytes(512, 7);
+    // Budget leaves exactly the pinned texture plus big's tail.
+    m.setBudget(uint64_t(double(textureBytes(512, 0) + tail) / 0.85) + 1);
+    m.update(10, actions);
+    CHECK(actions.size() == 1);
+    CHECK(actions[0].handle == big);
+    CHECK(actions[0].op == ResidencyOp::kDropLevels);
+    CHECK(actions[0].first_level == 7);            // floor of a 3-level tail
+    CHECK(m.firstResident(pinned) == 0);
+
+    // Pinned is never touched even when nothing else is left.
+    m.setBudget(1);
+    m.update(11, actions);
+    CHECK(actions.size() == 1 && actions[0].op == ResidencyOp::kEvict);
+    CHECK(m.firstResident(pinned) == 0);
+    CHECK(m.stats().over_budget);
+}
+
+// ── Even degradation of visible resources ───────────────────────────────────
+static void test_even_degradation() {
+    ResidencyManager m;
+    std::vector<ResidencyHandle> hs;
+    for (int i = 0; i < 4; ++i) hs.push_back(m.add(texture(256), 0));
+    const ResidencyHandle small = m.add(texture(256), 0);
+
+    // Five textures in view, all wanting full resolution.  `small` later
+    // shrinks on screen a little (200 px: still level 0).
+    std::vector<ResidencyAction> actions;
+    for (ResidencyHandle h : hs) m.markUsed(h, 1, 256.0f);
+    m.markUsed(small, 1, 256.0f);
+    m.update(1, actions);
+
+    // Room for everything at level 1: each must lose exactly one level.
+    const uint64_t target = textureBytes(256, 1) * 5;
+    m.setBudget(uint64_t(double(target) / 0.85) + 1);
+    for (ResidencyHandle h : hs) m.markUsed(h, 2, 256.0f);
+    m.markUsed(small, 2, 256.0f);
+    m.update(2, actions);
+    CHECK(actions.size() == 5);
+    for (const ResidencyAction& a : actions) {
+        CHECK(a.op == ResidencyOp::kDropLevels);
+        CHECK(a.first_level == 1);
+    }
+
+    // Halve that: the smallest-on-screen one degrades first and furthest,
+    // but nothing visible is evicted and no two large ones differ by more
+    // than one level.
+    m.setBudget(uint64_t(double(textureBytes(256, 2) * 5) / 0.85) + 1);
+    for (ResidencyHandle h : hs) m.markUsed(h, 3, 256.0f);
+    m.markUsed(small, 3, 200.0f);
+    m.update(3, actions);
+    uint32_t lo = 99, hi = 0;
+    for (ResidencyHandle h : hs) {
+        lo = std::min(lo, m.firstResident(h));
+        hi = std::max(hi, m.firstResident(h));
+        CHECK(m.isResident(h));
+    }
+    CHECK(hi - lo <= 1);
+    CHECK(m.firstResident(small) >= hi);
+    CHECK(m.residentBytes() <= uint64_t(double(m.budget()) * 0.85));
+    CHECK(m.stats().degraded_resources == 5);
+}
+
+// ── Restore on demand and the per-frame restore cap ─────────────────────────
+static void test_restore() {
+    ResidencyConfig cfg;
+    cfg.idle_frames = 2;
+    cfg.evict_after_frames = 4;
+    cfg.max_restore_bytes_per_frame = textureBytes(256, 0) / 2;
+    ResidencyManager m(cfg);
+    Mirror mirror;
+    const ResidencyHandle t = m.add(texture(256, 2), 0);
+    const ResidencyHandle filler = m.add(buffer(textureBytes(256, 0)), 0);
+    mirror.first[t] = 0;
+    mirror.first[filler] = 0;
+
+    std::vector<ResidencyAction> actions;
+    // High water just under the filler plus t's 20-byte tail: t is shed
+    // to its tail while still counting as in view, then evicted once idle.
+    m.setBudget(uint64_t(double(textureBytes(256, 0) + 10) / 0.95));
+    for (uint64_t f = 1; f < 10; ++f) {
+        m.markUsed(filler, f);
+        m.update(f, actions);
+        mirror.apply(m, actions);
+    }
+    CHECK(!m.isResident(t));                       // idle, evicted
+
+    // Drawn again: the tail comes back immediately, over budget or not.
+    m.setBudget(1);
+    m.markUsed(filler, 10);
+    m.markUsed(t, 10, 256.0f);
+    m.update(10, actions);
+    mirror.apply(m, actions);
+    CHECK(m.isResident(t));
+    CHECK(m.firstResident(t) == 7);
+    CHECK(m.stats().total_loads == 1);
+
+    // Budget back: levels return over several frames, each frame within
+    // the cap, finest level last.
+    m.setBudget(kUnlimitedResidencyBudget);
+    uint32_t frames = 0;
+    for (uint64_t f = 11; m.firstResident(t) != 0 && f < 50; ++f) {
+        m.markUsed(t, f, 256.0f);
+        m.markUsed(filler, f);
+        m.update(f, actions);
+        mirror.apply(m, actions);
+        uint64_t restored = 0;
+        for (const ResidencyAction& a : actions) restored += a.bytes;
+        // Level 0 alone is above the cap; it may only come in on its own.
+        CHECK(restored <= cfg.max_restore_bytes_per_frame ||
+              (actions.size() == 1 && actions[0].first_level == 0 &&
+               restored == textureBytes(256, 0) - textureBytes(256, 1)));
+        ++frames;
+    }
+    CHECK(m.firstResident(t) == 0);
+    CHECK(frames >= 2);
+
+    // Restores stop at the low water mark.
+    ResidencyManager capped(cfg);
+    const ResidencyHandle u = capped.add(texture(256), 0);
+    capped.setBudget(uint64_t(double(textureBytes(256, 2)) / 0.85) + 16);
+    capped.markUsed(u, 1, 256.0f);
+    capped.update(1, actions);
+    CHECK(capped.firstResident(u) == 2);
+    capped.setBudget(uint64_t(double(textureBytes(256, 1)) / 0.85) - 16);
+    for (uint64_t f = 2; f < 10; ++f) {
+        capped.markUsed(u, f, 256.0f);
+        capped.update(f, actions);
+    }
+    CHECK(capped.firstResident(u) == 2);           // level 1 would not fit
+    CHECK(capped.residentBytes() <=
+          uint64_t(double(capped.budget()) * 0.85));
+}
+
+// ── Hysteresis: a camera swinging near the budget settles ───────────────────
+static void test_no_thrash() {
+    ResidencyConfig cfg;
+    cfg.idle_frames = 8;
+    cfg.evict_after_frames = 64;
+    ResidencyManager m(cfg);
+    std::vector<ResidencyHandle> hs;
+    for (int i = 0; i < 32; ++i) hs.push_back(m.add(texture(128), 0));
+    const uint64_t full = textureBytes(128, 0);
+
+    // 16 textures always in view; the camera swings between two groups of
+    // 8 every 4 frames, so all 32 stay inside the idle window.  The budget
+    // puts them between the water marks, then a spike squeezes it and it
+    // recovers.
+    const uint64_t roomy = uint64_t(double(full * 32) / 0.9);
+    m.setBudget(roomy);
+    std::vector<ResidencyAction> actions;
+    uint64_t settled_actions = 0;
+    for (uint64_t f = 0; f < 1000; ++f) {
+        if (f == 100) m.setBudget(uint64_t(double(full * 20) / 0.85));
+        if (f == 200) m.setBudget(roomy);
+        for (int i = 0; i < 16; ++i) m.markUsed(hs[i], f, 128.0f);
+        const int group = int(f / 4) % 2;
+        for (int i = 0; i < 8; ++i)
+            m.markUsed(hs[16 + group * 8 + i], f, 128.0f);
+        m.update(f, actions);
+        CHECK(!m.stats().over_budget);
+        if (f < 100 || (f >= 110 && f < 200) || f >= 300)
+            settled_actions += actions.size();
+        if (f == 150) {
+            // Squeezed evenly: every texture is still in view and none is
+            // more than a level down; 12 textures' worth had to go.
+            uint32_t degraded = 0;
+            for (ResidencyHandle h : hs) {
+                CHECK(m.firstResident(h) <= 1);
+                degraded += m.firstResident(h);
+            }
+            CHECK(degraded >= 16);
+        }
+    }
+    // Shedding and restoring happen right after each budget change and
+    // never again while the budget holds still.
+    CHECK(settled_actions == 0);
+    // Restores stopped at the low water mark: a few textures stay one
+    // level down rather than pushing back up towards the high one.
+    CHECK(m.residentBytes() <= uint64_t(double(roomy) * 0.85));
+    CHECK(m.stats().degraded_resources > 0);
+    CHECK(m.stats().evicted_resources == 0);
+}
+
+// ── Randomised trace: bookkeeping and budget invariants ─────────────────────
+static void test_random_trace() {
+    std::mt19937 rng(1234);
+    ResidencyConfig cfg;
+    cfg.idle_frames = 6;
+    cfg.evict_after_frames = 120;
+    cfg.max_restore_bytes_per_frame = 4 * kMiB;
+    ResidencyManager m(cfg);
+    Mirror mirror;
+
+    std::vector<ResidencyHandle> live;
+    std::vector<uint32_t> widths;
+    std::unordered_map<ResidencyHandle, std::vector<uint64_t>> level_bytes;
+    std::vector<ResidencyAction> actions;
+    m.setBudget(48 * kMiB);
+
+    for (uint64_t f = 0; f < 3000; ++f) {
+        if (f % 500 == 250) m.setBudget(12 * kMiB);
+        if (f % 500 == 0) m.setBudget(48 * kMiB);
+
+        if (live.size() < 300 && rng() % 3 == 0) {
+            const uint32_t w = 16u << (rng() % 6);
+            ResidencyResourceDesc d =
+                rng() % 4 == 0 ? buffer(uint64_t(w) * w) : texture(w, 1 + rng() % 3);
+            if (rng() % 2) d.first_resident = uint32_t(d.level_bytes.size());
+            const ResidencyHandle h = m.add(d, f);
+            level_bytes[h] = d.level_bytes;
+            live.push_back(h);
+            widths.push_back(w);
+            mirror.first[h] = m.firstResident(h);
+        }
+        if (!live.empty() && rng() % 5 == 0) {
+            const size_t i = rng() % live.size();
+            mirror.first.erase(live[i]);
+            m.remove(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+            widths[i] = widths.back();
+            widths.pop_back();
+        }
+
+        // A drifting window of visible resources with random screen sizes.
+        const size_t begin = live.empty() ? 0 : (f / 7) % live.size();
+        for (size_t k = 0; k < std::min<size_t>(40, live.size()); ++k) {
+            const size_t i = (begin + k) % live.size();
+            m.markUsed(live[i], f, float(rng() % (widths[i] * 2 + 1)));
+        }
+
+        m.update(f, actions);
+        mirror.apply(m, actions);
+
+        // Resident bytes replayed from the mirror and the level sizes.
+        uint64_t sum = 0;
+        for (ResidencyHandle h : live) {
+            const std::vector<uint64_t>& levels = level_bytes[h];
+            for (uint32_t l = mirror.first[h]; l < levels.size(); ++l)
+                sum += levels[l];
+        }
+        CHECK(sum == m.residentBytes());
+        const ResidencyStats s = m.stats();
+        CHECK(s.resources == live.size());
+        CHECK(s.resident_bytes == m.residentBytes());
+        if (!s.over_budget && s.budget_bytes != kUnlimitedResidencyBudget)
+            CHECK(s.resident_bytes <= uint64_t(double(s.budget_bytes) * 0.95));
+    }
+    const ResidencyStats s = m.stats();
+    CHECK(s.total_evictions > 0);
+    CHECK(s.total_loads > 0);
+    CHECK(s.total_dropped_bytes > 0 && s.total_restored_bytes > 0);
+}
+
+int main() {
+    test_budget_inputs();
+    test_add_remove();
+    test_wanted_level();
+    test_shed_order();
+    test_idle_drops_mips_first();
+    test_even_degradation();
+    test_restore();
+    test_no_thrash();
+    test_random_trace();
+    std::printf("residency_manager_tests: %d checks passed\n", g_checks);
+    return 0;
+}
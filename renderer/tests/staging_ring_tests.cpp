@@ -0,0 +1,181 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// staging_ring_tests.cpp — standalone unit tests for the upload scheduler's
+// staging-ring bookkeeping (renderer/staging_ring.*).
+//
+// Pure CPU: exercises alignment (including the non-power-of-two image
+// alignment), FIFO retirement by timeline value, wrap around (including the
+// skipped tail being returned with its batch), the full / empty distinction
+// when head meets tail, and a randomised producer/retire simulation that
+// checks no two live ranges ever overlap.
+//
+// Build:
+//   g++ -std=c++20 -Irenderer renderer/tests/staging_ring_tests.cpp
+//       renderer/staging_ring.cpp -o staging_ring_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "staging_ring.h"
+
+using namespace engine::renderer;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static void testAlignmentAndRetire() {
+    StagingRing ring(1024);
+    uint64_t a = 0, b = 0;
+    CHECK(ring.allocate(10, 4, a));
+    CHECK(a == 0);
+    CHECK(ring.allocate(16, 16, b));
+    CHECK(b == 16);                       // 10 rounded up to 16
+    CHECK(ring.usedBytes() == 32);
+    CHECK(ring.openBytes() == 32);
+
+    ring.closeBatch(1);
+    CHECK(ring.openBytes() == 0);
+    CHECK(ring.pendingBatchCount() == 1);
+    CHECK(ring.oldestPendingValue() == 1);
+
+    ring.reclaim(0);                      // not done yet
+    CHECK(ring.usedBytes() == 32);
+    ring.reclaim(1);
+    CHECK(ring.usedBytes() == 0);
+    CHECK(ring.pendingBatchCount() == 0);
+
+    // Empty ring restarts at offset 0.
+    CHECK(ring.allocate(8, 4, a));
+    CHECK(a == 0);
+}
+
+// Image copies stage at kImageStagingAlignment (48), which is not a power of
+// two; offsets must still land on exact multiples.
+static void testNonPowerOfTwoAlignment() {
+    StagingRing ring(1024);
+    uint64_t a = 0, b = 0, c = 0;
+    CHECK(ring.allocate(12, 4, a));
+    CHECK(a == 0);
+    CHECK(ring.allocate(36, kImageStagingAlignment, b));
+    CHECK(b == 48);
+    CHECK(b % 12 == 0 && b % 16 == 0);
+    CHECK(ring.allocate(1, 4, c));
+    CHECK(c == 84);
+    CHECK(ring.allocate(8, kImageStagingAlignment, c));
+    CHECK(c == 96);
+    CHECK(ring.usedBytes() == 104);
+}
+
+static void testEmptyBatchIsNoop() {
+    StagingRing ring(256);
+    ring.closeBatch(5);
+    CHECK(ring.pendingBatchCount() == 0);
+    CHECK(ring.oldestPendingValue() == 0);
+}
+
+static void testFullAndWrap() {
+    StagingRing ring(1000);
+    uint64_t off = 0;
+    CHECK(ring.allocate(400, 1, off) && off == 0);
+    ring.closeBatch(1);
+    CHECK(ring.allocate(400, 1, off) && off == 400);
+    ring.closeBatch(2);
+
+    // 200 left at the end; 300 does not fit there and nothing is free at
+    // the front yet.
+    CHECK(!ring.allocate(300, 1, off));
+
+    ring.reclaim(1);                      // frees [0, 400)
+    CHECK(ring.allocate(300, 1, off));
+    CHECK(off == 0);                      // wrapped, skipping [800, 1000)
+    CHECK(ring.usedBytes() == 400 + 200 + 300);
+    ring.closeBatch(3);
+
+    // Head (300) < tail (400): only 100 bytes between them.
+    CHECK(!ring.allocate(101, 1, off));
+    CHECK(ring.allocate(100, 1, off) && off == 300);
+    CHECK(ring.usedBytes() == 1000);
+    // head == tail with data outstanding → full, not empty.
+    CHECK(!ring.allocate(1, 1, off));
+    ring.closeBatch(4);
+
+    ring.reclaim(2);                      // [400, 800) back
+    CHECK(ring.usedBytes() == 200 + 300 + 100);
+    ring.reclaim(3);                      // skipped tail + [0, 300)
+    CHECK(ring.usedBytes() == 100);
+    ring.reclaim(4);
+    CHECK(ring.usedBytes() == 0);
+}
+
+static void testExactFillToEnd() {
+    StagingRing ring(512);
+    uint64_t off = 0;
+    CHECK(ring.allocate(256, 1, off) && off == 0);
+    CHECK(ring.allocate(256, 1, off) && off == 256);
+    CHECK(!ring.allocate(1, 1, off));
+    ring.closeBatch(1);
+    ring.reclaim(1);
+    CHECK(ring.allocate(512, 1, off) && off == 0);
+    CHECK(!ring.allocate(0, 1, off));
+    CHECK(!ring.allocate(513, 1, off));
+}
+
+static void testRandomNoOverlap() {
+    struct Range { uint64_t begin, end, value; };
+    const uint64_t capacity = 64 * 1024;
+    StagingRing ring(capacity);
+    std::mt19937 rng(1234);
+    std::deque<Range> live;
+    uint64_t next_value = 1;
+    uint64_t completed = 0;
+
+    for (int step = 0; step < 20000; ++step) {
+        const uint64_t size = 1 + rng() % 4096;
+        const uint64_t align = 1ull << (rng() % 5);
+        uint64_t off = 0;
+        if (ring.allocate(size, align, off)) {
+            CHECK(off % align == 0);
+            CHECK(off + size <= capacity);
+            for (const auto& r : live) {
+                CHECK(off + size <= r.begin || off >= r.end);
+            }
+            live.push_back({ off, off + size, next_value });
+        }
+        if (rng() % 4 == 0) {
+            ring.closeBatch(next_value++);
+        }
+        if (rng() % 3 == 0 && completed + 1 < next_value) {
+            completed += 1 + rng() % (next_value - completed - 1);
+            ring.reclaim(completed);
+            while (!live.empty() && live.front().value <= completed) {
+                live.pop_front();
+            }
+        }
+        CHECK(ring.usedBytes() <= capacity);
+    }
+
+    ring.closeBatch(next_value);
+    ring.reclaim(next_value);
+    CHECK(ring.usedBytes() == 0);
+    CHECK(ring.pendingBatchCount() == 0);
+}
+
+int main() {
+    testAlignmentAndRetire();
+    testNonPowerOfTwoAlignment();
+    testEmptyBatchIsNoop();
+    testFullAndWrap();
+    testExactFillToEnd();
+    testRandomNoOverlap();
+    std::printf("staging_ring_tests: all %d checks passed\n", g_checks);
+    return 0;
+}
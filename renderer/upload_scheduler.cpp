@@ -0,0 +1,384 @@
+//
+// upload_scheduler.cpp — staging ring + one-submit-per-batch upload path for
+// the async loader.  See the header for the batching / ticket model.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include "upload_scheduler.h"
+#include "vulkan/vk_renderer_helper.h"
+
+namespace engine {
+namespace renderer {
+
+namespace {
+thread_local UploadScheduler* t_current_scheduler = nullptr;
+
+constexpr uint64_t kBufferStagingAlignment = 4;
+}  // namespace
+
+UploadScheduler::UploadScheduler(
+    const std::shared_ptr<Device>& device,
+    const std::shared_ptr<Queue>& queue,
+    const std::shared_ptr<CommandPool>& cmd_pool,
+    const UploadSchedulerConfig& config)
+    : device_(device),
+      queue_(queue),
+      cmd_pool_(cmd_pool),
+      config_(config),
+      ring_(config.ring_size) {
+
+    device_->createBuffer(
+        config_.ring_size,
+        SET_FLAG_BIT(BufferUsage, TRANSFER_SRC_BIT),
+        SET_FLAG_BIT(MemoryProperty, HOST_VISIBLE_BIT) |
+        SET_FLAG_BIT(MemoryProperty, HOST_COHERENT_BIT),
+        0,
+        ring_buffer_,
+        ring_memory_,
+        std::source_location::current());
+
+    // Mapped once for the scheduler's lifetime; HOST_COHERENT so no flushes
+    // are needed between the memcpy and the submit.
+    ring_mapped_ = static_cast<uint8_t*>(
+        device_->mapMemory(ring_memory_, config_.ring_size));
+    if (!ring_mapped_) {
+        throw std::runtime_error("upload scheduler: failed to map staging ring");
+    }
+
+    timeline_ = device_->createTimelineSemaphore(
+        0, std::source_location::current());
+}
+
+UploadScheduler::~UploadScheduler() {
+    releaseThrottle();
+    const uint64_t last = flush();
+    if (last > 0) {
+        device_->waitForSemaphores({ timeline_ }, last);
+    }
+    collect();
+
+    device_->unmapMemory(ring_memory_);
+    device_->destroyBuffer(ring_buffer_);
+    device_->freeMemory(ring_memory_);
+    device_->destroySemaphore(timeline_);
+}
+
+UploadScheduler* UploadScheduler::current() {
+    return t_current_scheduler;
+}
+
+UploadScheduler::ThreadBinding::ThreadBinding(UploadScheduler* scheduler)
+    : previous_(t_current_scheduler) {
+    t_current_scheduler = scheduler;
+}
+
+UploadScheduler::ThreadBinding::~ThreadBinding() {
+    t_current_scheduler = previous_;
+}
+
+uint64_t UploadScheduler::completedValue() const {
+    const uint64_t v = device_->getSemaphoreCounterValue(timeline_);
+    uint64_t prev = completed_value_.load(std::memory_order_relaxed);
+    while (v > prev &&
+           !completed_value_.compare_exchange_weak(prev, v,
+               std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return std::max(v, prev);
+}
+
+void UploadScheduler::wait(uint64_t ticket) {
+    if (ticket == 0) {
+        return;
+    }
+    if (ticket >= next_value_) {
+        flush();
+    }
+    if (!isComplete(ticket)) {
+        device_->waitForSemaphores({ timeline_ }, ticket);
+    }
+    collect();
+}
+
+void UploadScheduler::beginFrame() {
+    {
+        std::lock_guard<std::mutex> lock(budget_mutex_);
+        frame_bytes_ = 0;
+        ++frame_index_;
+    }
+    budget_cv_.notify_all();
+}
+
+void UploadScheduler::releaseThrottle() {
+    {
+        std::lock_guard<std::mutex> lock(budget_mutex_);
+        throttle_released_ = true;
+    }
+    budget_cv_.notify_all();
+}
+
+void UploadScheduler::throttle(uint64_t size) {
+    if (config_.frame_budget_bytes == 0) {
+        return;
+    }
+    bool over_budget;
+    {
+        std::lock_guard<std::mutex> lock(budget_mutex_);
+        over_budget = !throttle_released_ &&
+                      frame_bytes_ > 0 &&
+                      frame_bytes_ + size > config_.frame_budget_bytes;
+    }
+    if (over_budget) {
+        // Get this frame's share moving before we sit out the rest of it.
+        flush();
+        std::unique_lock<std::mutex> lock(budget_mutex_);
+        const uint64_t frame = frame_index_;
+        budget_cv_.wait_for(
+            lock,
+            std::chrono::milliseconds(config_.max_throttle_wait_ms),
+            [&]() { return frame_index_ != frame || throttle_released_; });
+        std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+        stats_.throttle_waits++;
+    }
+    std::lock_guard<std::mutex> lock(budget_mutex_);
+    frame_bytes_ += size;
+}
+
+const std::shared_ptr<CommandBuffer>& UploadScheduler::recordingCommandBuffer() {
+    if (!open_cmd_buf_) {
+        auto cmd_bufs = device_->allocateCommandBuffers(cmd_pool_, 1, true);
+        if (cmd_bufs.empty()) {
+            throw std::runtime_error("upload scheduler: failed to allocate command buffer");
+        }
+        open_cmd_buf_ = cmd_bufs[0];
+        open_cmd_buf_->beginCommandBuffer(
+            SET_FLAG_BIT(CommandBufferUsage, ONE_TIME_SUBMIT_BIT));
+    }
+    return open_cmd_buf_;
+}
+
+void UploadScheduler::stage(
+    uint64_t size,
+    uint64_t alignment,
+    const void* data,
+    std::shared_ptr<Buffer>& out_buffer,
+    uint64_t& out_offset) {
+
+    // Anything bigger than half the ring would force the ring to drain
+    // completely (and stall) every time; give it its own buffer instead.
+    if (size > ring_.capacity() / 2) {
+        std::shared_ptr<Buffer> staging_buffer;
+        std::shared_ptr<DeviceMemory> staging_memory;
+        device_->createBuffer(
+            size,
+            SET_FLAG_BIT(BufferUsage, TRANSFER_SRC_BIT),
+            SET_FLAG_BIT(MemoryProperty, HOST_VISIBLE_BIT) |
+            SET_FLAG_BIT(MemoryProperty, HOST_COHERENT_BIT),
+            0,
+            staging_buffer,
+            staging_memory,
+            std::source_location::current());
+        device_->updateBufferMemory(staging_memory, size, data);
+        open_dedicated_buffers_.push_back(staging_buffer);
+        open_dedicated_memory_.push_back(staging_memory);
+        open_dedicated_bytes_ += size;
+        out_buffer = staging_buffer;
+        out_offset = 0;
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.dedicated_staging++;
+        return;
+    }
+
+    uint64_t offset = 0;
+    while (!ring_.allocate(size, alignment, offset)) {
+        collect();
+        if (ring_.allocate(size, alignment, offset)) {
+            break;
+        }
+        // Still full: the open batch (if any) has to go out so its bytes
+        // can retire, then block on the oldest batch in flight.
+        flush();
+        const uint64_t oldest = ring_.oldestPendingValue();
+        if (oldest == 0) {
+            throw std::runtime_error("upload scheduler: staging ring exhausted");
+        }
+        device_->waitForSemaphores({ timeline_ }, oldest);
+        collect();
+    }
+
+    std::memcpy(ring_mapped_ + offset, data, size);
+    out_buffer = ring_buffer_;
+    out_offset = offset;
+}
+
+uint64_t UploadScheduler::uploadBuffer(
+    const std::shared_ptr<Buffer>& dst,
+    uint64_t dst_offset,
+    uint64_t size,
+    const void* data) {
+    if (size == 0 || !data) {
+        return next_value_ - 1;
+    }
+    throttle(size);
+
+    std::shared_ptr<Buffer> src;
+    uint64_t src_offset = 0;
+    stage(size, kBufferStagingAlignment, data, src, src_offset);
+
+    std::vector<BufferCopyInfo> copy_regions(1);
+    copy_regions[0].src_offset = src_offset;
+    copy_regions[0].dst_offset = dst_offset;
+    copy_regions[0].size = size;
+    recordingCommandBuffer()->copyBuffer(src, dst, copy_regions);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.buffer_uploads++;
+    stats_.bytes_uploaded += size;
+    return next_value_;
+}
+
+uint64_t UploadScheduler::uploadImage(
+    const std::shared_ptr<Image>& dst,
+    Format format,
+    uint32_t width,
+    uint32_t height,
+    uint64_t size,
+    const void* data,
+    ImageLayout final_layout/* = ImageLayout::SHADER_READ_ONLY_OPTIMAL*/) {
+    if (size == 0 || !data) {
+        return next_value_ - 1;
+    }
+    throttle(size);
+
+    std::shared_ptr<Buffer> src;
+    uint64_t src_offset = 0;
+    stage(size, kImageStagingAlignment, data, src, src_offset);
+
+    const auto& cmd_buf = recordingCommandBuffer();
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        dst,
+        format,
+        ImageLayout::UNDEFINED,
+        ImageLayout::TRANSFER_DST_OPTIMAL);
+
+    std::vector<BufferImageCopyInfo> copy_regions(1);
+    auto& region = copy_regions[0];
+    region.buffer_offset = src_offset;
+    region.buffer_row_length = 0;
+    region.buffer_image_height = 0;
+    region.image_subresource.aspect_mask = SET_FLAG_BIT(ImageAspect, COLOR_BIT);
+    region.image_subresource.mip_level = 0;
+    region.image_subresource.base_array_layer = 0;
+    region.image_subresource.layer_count = 1;
+    region.image_offset = glm::ivec3(0, 0, 0);
+    region.image_extent = glm::uvec3(width, height, 1);
+    cmd_buf->copyBufferToImage(
+        src,
+        dst,
+        copy_regions,
+        ImageLayout::TRANSFER_DST_OPTIMAL);
+
+    vk::helper::transitionImageLayout(
+        cmd_buf,
+        dst,
+        format,
+        ImageLayout::TRANSFER_DST_OPTIMAL,
+        final_layout);
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.image_uploads++;
+    stats_.bytes_uploaded += size;
+    return next_value_;
+}
+
+uint64_t UploadScheduler::attachCommandBuffer(
+    const std::shared_ptr<CommandBuffer>& cmd_buf) {
+    if (cmd_buf) {
+        attached_.push_back(cmd_buf);
+    }
+    return next_value_;
+}
+
+uint64_t UploadScheduler::flush() {
+    if (!hasPendingWork()) {
+        return next_value_ - 1;
+    }
+    const uint64_t value = next_value_++;
+
+    std::vector<std::shared_ptr<CommandBuffer>> cmd_bufs;
+    cmd_bufs.reserve(attached_.size() + 1);
+    if (open_cmd_buf_) {
+        // Make the copies visible to everything submitted after this batch
+        // on the same queue — the loader's transient submits (mip
+        // generation, BLAS builds) read what we just uploaded.
+        BarrierList barrier_list;
+        barrier_list.memory_barriers.push_back({
+            SET_FLAG_BIT(Access, TRANSFER_WRITE_BIT),
+            SET_2_FLAG_BITS(Access, MEMORY_READ_BIT, MEMORY_WRITE_BIT) });
+        open_cmd_buf_->addBarriers(
+            barrier_list,
+            SET_FLAG_BIT(PipelineStage, TRANSFER_BIT),
+            SET_FLAG_BIT(PipelineStage, ALL_COMMANDS_BIT));
+        open_cmd_buf_->endCommandBuffer();
+        cmd_bufs.push_back(open_cmd_buf_);
+    }
+    cmd_bufs.insert(cmd_bufs.end(), attached_.begin(), attached_.end());
+
+    Helper::submitQueue(
+        queue_,
+        nullptr,
+        {},
+        cmd_bufs,
+        { timeline_ },
+        { value });
+
+    ring_.closeBatch(value);
+
+    InFlightBatch batch;
+    batch.value = value;
+    batch.cmd_bufs = std::move(cmd_bufs);
+    batch.staging_buffers = std::move(open_dedicated_buffers_);
+    batch.staging_memory = std::move(open_dedicated_memory_);
+    in_flight_.push_back(std::move(batch));
+
+    open_cmd_buf_.reset();
+    attached_.clear();
+    open_dedicated_buffers_.clear();
+    open_dedicated_memory_.clear();
+    open_dedicated_bytes_ = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.submits++;
+    }
+
+    collect();
+    return value;
+}
+
+void UploadScheduler::collect() {
+    const uint64_t completed = completedValue();
+    ring_.reclaim(completed);
+    while (!in_flight_.empty() && in_flight_.front().value <= completed) {
+        auto& batch = in_flight_.front();
+        device_->freeCommandBuffers(cmd_pool_, batch.cmd_bufs);
+        for (auto& buffer : batch.staging_buffers) {
+            device_->destroyBuffer(buffer);
+        }
+        for (auto& memory : batch.staging_memory) {
+            device_->freeMemory(memory);
+        }
+        in_flight_.pop_front();
+    }
+}
+
+UploadSchedulerStats UploadScheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+} // namespace renderer
+} // namespace engine
@@ -0,0 +1,199 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// upload_scheduler.h — batched host→device uploads for the loader thread.
+//
+// Before this, every Helper::createBuffer / create2DTextureImage issued from
+// the async mesh loader created its own staging buffer, recorded one copy
+// into the transient command buffer and did submit + vkWaitForFences.  A
+// streamed .rwobj touches a dozen buffers and a few textures, so dozens of
+// objects per second meant hundreds of submits, fences and staging
+// allocations per second on the loader queue.
+//
+// UploadScheduler replaces that with:
+//   - one persistently-mapped HOST_VISIBLE staging buffer used as a ring
+//     (StagingRing); uploads memcpy straight into it;
+//   - one open command buffer that accumulates every copy / layout
+//     transition until flush(), which submits it (plus any command buffers
+//     attached by the caller) in a single vkQueueSubmit;
+//   - a timeline semaphore: each flush signals the next value, every upload
+//     returns the value ("ticket") at which its data is on the GPU, and
+//     ring space / retired command buffers are recycled by comparing
+//     against the semaphore's counter — no per-upload fences;
+//   - a per-frame byte budget: once `frame_budget_bytes` have been staged
+//     since the last beginFrame(), further uploads wait (bounded) for the
+//     next frame, so a burst of streaming loads cannot saturate PCIe and
+//     starve the render thread's own transfers.
+//
+// Uploads larger than what the ring can ever hold get a dedicated staging
+// buffer that is destroyed when its batch retires.
+//
+// Threading: the recording side (upload*, attachCommandBuffer, flush,
+// collect, wait) belongs to ONE thread — the loader worker.  isComplete(),
+// completedValue() and beginFrame() may be called from any thread.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "renderer.h"
+#include "staging_ring.h"
+
+namespace engine {
+namespace renderer {
+
+struct UploadSchedulerConfig {
+    // Size of the persistent staging ring.
+    uint64_t ring_size = 64ull << 20;
+    // Bytes that may be staged per frame before uploads throttle.  0 means
+    // unlimited (useful for startup barriers that want everything now).
+    uint64_t frame_budget_bytes = 32ull << 20;
+    // Upper bound on how long a throttled upload waits for beginFrame()
+    // before going ahead anyway, so a stalled main thread (modal dialog,
+    // shutdown join) can never deadlock the loader.
+    uint32_t max_throttle_wait_ms = 100;
+};
+
+struct UploadSchedulerStats {
+    uint64_t submits = 0;
+    uint64_t buffer_uploads = 0;
+    uint64_t image_uploads = 0;
+    uint64_t bytes_uploaded = 0;
+    uint64_t dedicated_staging = 0;
+    uint64_t throttle_waits = 0;
+};
+
+class UploadScheduler {
+public:
+    UploadScheduler(
+        const std::shared_ptr<Device>& device,
+        const std::shared_ptr<Queue>& queue,
+        const std::shared_ptr<CommandPool>& cmd_pool,
+        const UploadSchedulerConfig& config = {});
+    // Waits for everything submitted, then releases the ring, semaphore and
+    // command buffers.  Must not race with the recording thread.
+    ~UploadScheduler();
+
+    UploadScheduler(const UploadScheduler&) = delete;
+    UploadScheduler& operator=(const UploadScheduler&) = delete;
+
+    // Stage `size` bytes and record a copy into `dst` at `dst_offset`.
+    // `dst` must have been created with TRANSFER_DST.  Returns the ticket.
+    uint64_t uploadBuffer(
+        const std::shared_ptr<Buffer>& dst,
+        uint64_t dst_offset,
+        uint64_t size,
+        const void* data);
+
+    // Stage a tightly-packed single-mip 2D image and record
+    // UNDEFINED → TRANSFER_DST → copy → `final_layout`.
+    uint64_t uploadImage(
+        const std::shared_ptr<Image>& dst,
+        Format format,
+        uint32_t width,
+        uint32_t height,
+        uint64_t size,
+        const void* data,
+        ImageLayout final_layout = ImageLayout::SHADER_READ_ONLY_OPTIMAL);
+
+    // Submit `cmd_buf` (already ended) in the same vkQueueSubmit as the
+    // current batch, after its copies.  The scheduler frees it back to the
+    // command pool on retire.  Returns the ticket.
+    uint64_t attachCommandBuffer(const std::shared_ptr<CommandBuffer>& cmd_buf);
+
+    // Submit the open batch, if any.  Returns the value that batch signals
+    // (or the last submitted value when nothing was pending).
+    uint64_t flush();
+
+    // Recycle ring space and command buffers of completed batches.  Called
+    // by flush() and whenever the ring runs out of room.
+    void collect();
+
+    // Ticket the currently open batch will signal.
+    uint64_t pendingTicket() const { return next_value_; }
+    bool hasPendingWork() const { return open_cmd_buf_ != nullptr || !attached_.empty(); }
+    uint64_t pendingBytes() const { return ring_.openBytes() + open_dedicated_bytes_; }
+
+    uint64_t completedValue() const;
+    bool isComplete(uint64_t ticket) const { return completedValue() >= ticket; }
+    void wait(uint64_t ticket);
+
+    // Main-thread frame tick: resets the per-frame budget and wakes any
+    // throttled upload.
+    void beginFrame();
+    // Lift throttling for good (shutdown).
+    void releaseThrottle();
+
+    UploadSchedulerStats getStats() const;
+
+    // The scheduler bound to the calling thread, or nullptr.  Helper upload
+    // paths consult this so unmodified loader code batches automatically.
+    static UploadScheduler* current();
+
+    // RAII binding of a scheduler to the calling thread.
+    class ThreadBinding {
+    public:
+        explicit ThreadBinding(UploadScheduler* scheduler);
+        ~ThreadBinding();
+        ThreadBinding(const ThreadBinding&) = delete;
+        ThreadBinding& operator=(const ThreadBinding&) = delete;
+    private:
+        UploadScheduler* previous_;
+    };
+
+private:
+    struct InFlightBatch {
+        uint64_t value;
+        std::vector<std::shared_ptr<CommandBuffer>> cmd_bufs;
+        std::vector<std::shared_ptr<Buffer>> staging_buffers;
+        std::vector<std::shared_ptr<DeviceMemory>> staging_memory;
+    };
+
+    // Copy `data` into staging memory and return the buffer/offset to copy
+    // from.  May flush + wait when the ring is full.
+    void stage(
+        uint64_t size,
+        uint64_t alignment,
+        const void* data,
+        std::shared_ptr<Buffer>& out_buffer,
+        uint64_t& out_offset);
+    const std::shared_ptr<CommandBuffer>& recordingCommandBuffer();
+    void throttle(uint64_t size);
+
+    std::shared_ptr<Device>      device_;
+    std::shared_ptr<Queue>       queue_;
+    std::shared_ptr<CommandPool> cmd_pool_;
+    UploadSchedulerConfig        config_;
+
+    std::shared_ptr<Buffer>       ring_buffer_;
+    std::shared_ptr<DeviceMemory> ring_memory_;
+    uint8_t*                      ring_mapped_ = nullptr;
+    StagingRing                   ring_;
+
+    std::shared_ptr<Semaphore>    timeline_;
+    uint64_t                      next_value_ = 1;
+    mutable std::atomic<uint64_t> completed_value_{0};
+
+    std::shared_ptr<CommandBuffer>              open_cmd_buf_;
+    std::vector<std::shared_ptr<CommandBuffer>> attached_;
+    std::vector<std::shared_ptr<Buffer>>        open_dedicated_buffers_;
+    std::vector<std::shared_ptr<DeviceMemory>>  open_dedicated_memory_;
+    uint64_t                                    open_dedicated_bytes_ = 0;
+    std::deque<InFlightBatch>                   in_flight_;
+
+    // Per-frame budget.
+    std::mutex              budget_mutex_;
+    std::condition_variable budget_cv_;
+    uint64_t                frame_bytes_ = 0;
+    uint64_t                frame_index_ = 0;
+    bool                    throttle_released_ = false;
+
+    mutable std::mutex   stats_mutex_;
+    UploadSchedulerStats stats_;
+};
+
+} // namespace renderer
+} // namespace engine
@@ -201,6 +201,72 @@ VulkanDevice::VulkanDevice(
     transient_fence_ =
         createFence(std::source_location::current());
 
+    // ── Pooled device memory ──
+    // The memory-type table is a straight copy of the physical device's;
+    // blocks are raw vkAllocateMemory calls.  Host-visible blocks are
+    // mapped once here and never again — sub-allocations share the
+    // VkDeviceMemory, and vkMapMemory on an already-mapped object is
+    // invalid, so per-call map/unmap could not work.
+    {
+        auto vk_physical_device =
+            RENDER_TYPE_CAST(PhysicalDevice, physical_device_);
+        VkPhysicalDeviceMemoryProperties mem_properties;
+        vkGetPhysicalDeviceMemoryProperties(
+            vk_physical_device->get(), &mem_properties);
+        MemoryTypeTable table;
+        for (uint32_t i = 0; i < mem_properties.memoryTypeCount; ++i) {
+            MemoryTypeDesc t;
+            t.property_flags = mem_properties.memoryTypes[i].propertyFlags;
+            t.heap_index = mem_properties.memoryTypes[i].heapIndex;
+            table.types.push_back(t);
+        }
+        for (uint32_t i = 0; i < mem_properties.memoryHeapCount; ++i) {
+            MemoryHeapDesc h;
+            h.size = mem_properties.memoryHeaps[i].size;
+            table.heaps.push_back(h);
+        }
+
+        MemoryBlockBackend backend;
+        backend.allocate_block =
+            [this](uint32_t memory_type, uint64_t size,
+                   MemoryAllocateFlags allocate_flags, bool map,
+                   uint64_t* out_handle, void** out_mapped) {
+            VkMemoryAllocateFlagsInfo alloc_flags_info{};
+            alloc_flags_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+            alloc_flags_info.flags = helper::toVkMemoryAllocateFlags(allocate_flags);
+            VkMemoryAllocateInfo alloc_info{};
+            alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            alloc_info.allocationSize = size;
+            alloc_info.memoryTypeIndex = memory_type;
+            if (allocate_flags != 0) {
+                alloc_info.pNext = &alloc_flags_info;
+            }
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            if (vkAllocateMemory(device_, &alloc_info, nullptr, &memory) != VK_SUCCESS) {
+                return false;
+            }
+            void* mapped = nullptr;
+            if (map &&
+                vkMapMemory(device_, memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+                vkFreeMemory(device_, memory, nullptr);
+                return false;
+            }
+            *out_handle = reinterpret_cast<uint64_t>(memory);
+            *out_mapped = mapped;
+            return true;
+        };
+        backend.free_block =
+            [this](uint32_t, uint64_t handle, bool mapped) {
+            VkDeviceMemory memory = reinterpret_cast<VkDeviceMemory>(handle);
+            if (mapped) {
+                vkUnmapMemory(device_, memory);
+            }
+            vkFreeMemory(device_, memory, nullptr);
+        };
+        memory_allocator_ =
+            std::make_unique<MemoryAllocator>(table, std::move(backend));
+    }
+
     // ── Async loader queue setup ──
     // Take a separate queue from the same family as the transient compute
     // queue so the async mesh-load worker can submit staging copies
@@ -283,6 +349,9 @@ std::shared_ptr<CommandBuffer> VulkanDevice::setupTransientCommandBuffer() {
     const std::thread::id tid = std::this_thread::get_id();
     const std::thread::id lid = loader_thread_id_.load(std::memory_order_acquire);
     if (loader_transient_cmd_buffer_ && tid == lid && lid != std::thread::id{}) {
+        if (loader_transient_prologue_) {
+            loader_transient_prologue_();
+        }
         loader_transient_cmd_buffer_->beginCommandBuffer(
             SET_FLAG_BIT(CommandBufferUsage, ONE_TIME_SUBMIT_BIT));
         return loader_transient_cmd_buffer_;
@@ -363,10 +432,11 @@ void VulkanDevice::createBuffer(
     const std::source_location& src_location) {
     buffer = createBuffer(buffer_size, usage, src_location);
     auto mem_requirements = getBufferMemoryRequirements(buffer);
-    buffer_memory = allocateMemory(mem_requirements.size,
-        mem_requirements.memory_type_bits,
+    buffer_memory = allocateMemory(mem_requirements,
         properties,
-        allocate_flags);
+        allocate_flags,
+        false,
+        src_location);
     bindBufferMemory(buffer, buffer_memory);
 
     if ((usage & static_cast<uint32_t>(BufferUsageFlagBits::SHADER_DEVICE_ADDRESS_BIT)) != 0) {
@@ -595,6 +665,45 @@ std::shared_ptr<Semaphore> VulkanDevice::createSemaphore(
     return vk_semaphore;
 }
 
+std::shared_ptr<Semaphore> VulkanDevice::createTimelineSemaphore(
+    uint64_t initial_value,
+    const std::source_location& src_location) {
+    VkSemaphoreTypeCreateInfo type_create_info = {};
+    type_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    type_create_info.initialValue = initial_value;
+
+    VkSemaphoreCreateInfo semaphore_info{};
+    semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphore_info.pNext = &type_create_info;
+
+    VkSemaphore semaphore;
+    auto result =
+        vkCreateSemaphore(
+            device_,
+            &semaphore_info,
+            nullptr,
+            &semaphore);
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(
+            std::string("failed to create timeline semaphore! : ") +
+            VkResultToString(result));
+    }
+
+    nameVkObject(device_, VK_OBJECT_TYPE_SEMAPHORE,
+                 reinterpret_cast<uint64_t>(semaphore), src_location);
+    auto vk_semaphore =
+        std::make_shared<VulkanSemaphore>(semaphore);
+    vk_semaphore->set_source_location(src_location);
+    {
+        std::lock_guard<std::mutex> lock(tracking_mutex_);
+        semaphore_list_.push_back(vk_semaphore);
+    }
+
+    return vk_semaphore;
+}
+
 std::shared_ptr<Fence> VulkanDevice::createFence(
     const std::source_location& src_location,
     bool signaled/* = false*/) {
@@ -1712,6 +1821,46 @@ void VulkanDevice::dumpVramBreakdown(const char* tag) {
            "  (estimated: extent x format, mips/layers not tracked)");
     std::printf("[vram] tracked total ~%.1f MB\n",
                 double(buf_total + img_total) / (1024.0 * 1024.0));
+
+    // Sub-allocator view: what the driver actually holds (blocks) versus
+    // what resources use (allocations), per heap, against the budget.
+    if (memory_allocator_) {
+        auto vk_physical_device =
+            RENDER_TYPE_CAST(PhysicalDevice, physical_device_);
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+        budget.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 mp{};
+        mp.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        mp.pNext = &budget;
+        vkGetPhysicalDeviceMemoryProperties2(vk_physical_device->get(), &mp);
+        for (uint32_t i = 0; i < mp.memoryProperties.memoryHeapCount; ++i) {
+            // Zero when VK_EXT_memory_budget was not enabled.
+            if (budget.heapBudget[i] != 0) {
+                memory_allocator_->setHeapBudget(i, budget.heapBudget[i]);
+            }
+        }
+
+        const auto stats = memory_allocator_->getStats();
+        const double MB = 1024.0 * 1024.0;
+        std::printf("[vram] allocator: %u device allocation(s), %u resource(s), %u pool(s)\n",
+                    stats.total_block_count, stats.total_allocation_count,
+                    stats.pool_count);
+        for (size_t i = 0; i < stats.heaps.size(); ++i) {
+            const auto& h = stats.heaps[i];
+            if (h.block_count == 0) {
+                continue;
+            }
+            const double waste = h.block_bytes
+                ? 100.0 * double(h.block_bytes - h.allocation_bytes) / double(h.block_bytes)
+                : 0.0;
+            std::printf("[vram]    heap %zu: %8.1f MB in %u block(s) (%u dedicated), "
+                        "%8.1f MB used by %u alloc(s), %4.1f%% slack, budget %.1f / %.1f MB\n",
+                        i, double(h.block_bytes) / MB, h.block_count, h.dedicated_count,
+                        double(h.allocation_bytes) / MB, h.allocation_count, waste,
+                        double(h.budget) / MB, double(h.heap_size) / MB);
+        }
+    }
     std::fflush(stdout);
 }
 
@@ -1827,6 +1976,45 @@ VulkanDevice::allocateMemory(
     return vk_device_memory;
 }
 
+std::shared_ptr<DeviceMemory>
+VulkanDevice::allocateMemory(
+    const MemoryRequirements& requirements,
+    const MemoryPropertyFlags& properties,
+    const MemoryAllocateFlags& allocate_flags,
+    bool is_image,
+    const std::source_location& src_location) {
+    AllocationRequest request;
+    request.size = requirements.size;
+    request.alignment = requirements.alignment;
+    request.memory_type_bits = requirements.memory_type_bits;
+    request.required_flags = properties;
+    request.allocate_flags = allocate_flags;
+    request.kind = is_image ? AllocationKind::kImage : AllocationKind::kBuffer;
+
+    const Allocation allocation = memory_allocator_->allocate(request);
+    if (!allocation.valid()) {
+        throw std::runtime_error(
+            std::string("failed to allocate pooled memory! size=") +
+            std::to_string(requirements.size) + " at " +
+            src_location.file_name() + ":" +
+            std::to_string(src_location.line()));
+    }
+
+    // A shared block is named by whichever resource created it; the
+    // name is only a hint in Nsight / RenderDoc, so that is good enough.
+    if (allocation.dedicated || allocation.offset == 0) {
+        nameVkObject(device_, VK_OBJECT_TYPE_DEVICE_MEMORY,
+                     allocation.block_handle, src_location);
+    }
+    auto vk_device_memory =
+        std::make_shared<VulkanDeviceMemory>();
+    vk_device_memory->set(
+        reinterpret_cast<VkDeviceMemory>(allocation.block_handle));
+    vk_device_memory->setAllocation(allocation);
+
+    return vk_device_memory;
+}
+
 MemoryRequirements VulkanDevice::getBufferMemoryRequirements(std::shared_ptr<Buffer> buffer) {
     auto vk_buffer = RENDER_TYPE_CAST(Buffer, buffer);
 
@@ -1862,7 +2050,8 @@ void VulkanDevice::bindBufferMemory(std::shared_ptr<Buffer> buffer, std::shared_
     auto vk_buffer_memory = RENDER_TYPE_CAST(DeviceMemory, buffer_memory);
 
     if (vk_buffer && vk_buffer_memory) {
-        vkBindBufferMemory(device_, vk_buffer->get(), vk_buffer_memory->get(), offset);
+        vkBindBufferMemory(device_, vk_buffer->get(), vk_buffer_memory->get(),
+                           vk_buffer_memory->getOffset() + offset);
     }
 }
 
@@ -1871,7 +2060,8 @@ void VulkanDevice::bindImageMemory(std::shared_ptr<Image> image, std::shared_ptr
     auto vk_image_memory = RENDER_TYPE_CAST(DeviceMemory, image_memory);
 
     if (vk_image && vk_image_memory) {
-        vkBindImageMemory(device_, vk_image->get(), vk_image_memory->get(), offset);
+        vkBindImageMemory(device_, vk_image->get(), vk_image_memory->get(),
+                          vk_image_memory->getOffset() + offset);
     }
 }
 
@@ -1922,6 +2112,13 @@ std::vector<std::shared_ptr<CommandBuffer>> VulkanDevice::allocateCommandBuffers
 void* VulkanDevice::mapMemory(std::shared_ptr<DeviceMemory> memory, uint64_t size, uint64_t offset /*=0*/) {
     void* data = nullptr;
     auto vk_memory = RENDER_TYPE_CAST(DeviceMemory, memory);
+    if (vk_memory && vk_memory->isSubAllocated()) {
+        // Pooled memory is persistently mapped at block creation; a
+        // device-local sub-allocation has no host pointer (nullptr, same
+        // as vkMapMemory failing on non-HOST_VISIBLE memory).
+        auto* base = static_cast<uint8_t*>(vk_memory->getAllocation().mapped);
+        return base ? base + offset : nullptr;
+    }
     if (vk_memory) {
         vkMapMemory(device_, vk_memory->get(), offset, size, 0/*reserved*/, &data);
     }
@@ -1931,6 +2128,9 @@ void* VulkanDevice::mapMemory(std::shared_ptr<DeviceMemory> memory, uint64_t siz
 
 void VulkanDevice::unmapMemory(std::shared_ptr<DeviceMemory> memory) {
     auto vk_memory = RENDER_TYPE_CAST(DeviceMemory, memory);
+    if (vk_memory && vk_memory->isSubAllocated()) {
+        return;   // stays mapped until the block is released
+    }
     if (vk_memory) {
         vkUnmapMemory(device_, vk_memory->get());
     }
@@ -2132,11 +2332,22 @@ void VulkanDevice::destroy() {
         loader_transient_fence_.reset();
     }
 
+    // Returns every pool block to the driver (and warns about leaked
+    // sub-allocations) while the VkDevice is still alive.
+    memory_allocator_.reset();
+
     vkDestroyDevice(device_, nullptr);
 }
 
 void VulkanDevice::freeMemory(std::shared_ptr<DeviceMemory> memory) {
     auto vk_memory = RENDER_TYPE_CAST(DeviceMemory, memory);
+    if (vk_memory && vk_memory->isSubAllocated()) {
+        memory_allocator_->free(vk_memory->getAllocation());
+        // Guard against a double free through a second shared_ptr copy.
+        vk_memory->setAllocation(Allocation{});
+        vk_memory->set(VK_NULL_HANDLE);
+        return;
+    }
     if (vk_memory) {
         vkFreeMemory(device_, vk_memory->get(), nullptr);
     }
@@ -2220,6 +2431,23 @@ bool VulkanDevice::isFenceSignaled(const std::shared_ptr<Fence>& fence) {
     return true;
 }
 
+uint64_t VulkanDevice::getSemaphoreCounterValue(
+    const std::shared_ptr<Semaphore>& semaphore) {
+    uint64_t value = 0;
+    auto result =
+        vkGetSemaphoreCounterValue(
+            device_,
+            RENDER_TYPE_CAST(Semaphore, semaphore)->get(),
+            &value);
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(
+            std::string("get semaphore counter value error : ") +
+            VkResultToString(result));
+    }
+    return value;
+}
+
 void VulkanDevice::waitForSemaphores(
     const std::vector<std::shared_ptr<Semaphore>>& semaphores,
     uint64_t value) {
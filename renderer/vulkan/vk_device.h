@@ -5,6 +5,7 @@
 #include <thread>
 #include <vulkan/vulkan.h>
 #include "../device.h"
+#include "../memory_allocator.h"
 
 namespace engine {
 namespace renderer {
@@ -38,6 +39,7 @@ class VulkanDevice : public Device {
     std::shared_ptr<CommandBuffer> loader_transient_cmd_buffer_;
     std::shared_ptr<Fence>         loader_transient_fence_;
     std::atomic<std::thread::id>   loader_thread_id_{std::thread::id{}};
+    std::function<void()>          loader_transient_prologue_;
 
     // ── Resource tracking lists ──
     // Guarded by tracking_mutex_ because the async mesh-load worker thread
@@ -58,6 +60,12 @@ class VulkanDevice : public Device {
     std::vector<std::shared_ptr<Semaphore>> semaphore_list_;
     std::vector<std::shared_ptr<Fence>> fence_list_;
 
+    // ── Pooled device memory ──
+    // Backs allocateMemory(MemoryRequirements, ...).  Blocks come from
+    // vkAllocateMemory through the backend hooks installed in the
+    // constructor; host-visible blocks stay mapped for their lifetime.
+    std::unique_ptr<MemoryAllocator> memory_allocator_;
+
 public:
     VulkanDevice(
         const std::shared_ptr<PhysicalDevice>& physical_device,
@@ -86,9 +94,13 @@ public:
     virtual void registerLoaderThread(std::thread::id id) final {
         loader_thread_id_.store(id, std::memory_order_release);
     }
+    virtual void setLoaderTransientPrologue(std::function<void()> prologue) final {
+        loader_transient_prologue_ = std::move(prologue);
+    }
 
     const std::shared_ptr<PhysicalDevice>& getPhysicalDevice() {
         return physical_device_; }
+    MemoryAllocator* getMemoryAllocator() { return memory_allocator_.get(); }
     virtual std::shared_ptr<DescriptorPool> createDescriptorPool(
         const std::source_location& src_location =
             std::source_location::current()) final;
@@ -198,6 +210,13 @@ public:
         const MemoryAllocateFlags& allocate_flags,
         const std::source_location& src_location =
             std::source_location::current()) final;
+    virtual std::shared_ptr<DeviceMemory> allocateMemory(
+        const MemoryRequirements& requirements,
+        const MemoryPropertyFlags& properties,
+        const MemoryAllocateFlags& allocate_flags,
+        bool is_image,
+        const std::source_location& src_location =
+            std::source_location::current()) final;
     virtual MemoryRequirements getBufferMemoryRequirements(std::shared_ptr<Buffer> buffer) final;
     virtual MemoryRequirements getImageMemoryRequirements(std::shared_ptr<Image> image) final;
     virtual std::shared_ptr<Buffer> createBuffer(
@@ -249,6 +268,9 @@ public:
         const std::source_location& src_location) final;
     virtual std::shared_ptr<Semaphore> createSemaphore(
         const std::source_location& src_location) final;
+    virtual std::shared_ptr<Semaphore> createTimelineSemaphore(
+        uint64_t initial_value,
+        const std::source_location& src_location) final;
     virtual std::shared_ptr<Fence> createFence(
         const std::source_location& src_location,
         bool signaled = false) final;
@@ -284,6 +306,7 @@ public:
     virtual void waitForFences(const std::vector<std::shared_ptr<Fence>>& fences) final;
     virtual bool isFenceSignaled(const std::shared_ptr<Fence>& fence) final;
     virtual void waitForSemaphores(const std::vector<std::shared_ptr<Semaphore>>& semaphores, uint64_t value) final;
+    virtual uint64_t getSemaphoreCounterValue(const std::shared_ptr<Semaphore>& semaphore) final;
     virtual void waitIdle() final;
     virtual void getAccelerationStructureBuildSizes(
         AccelerationStructureBuildType         as_build_type,
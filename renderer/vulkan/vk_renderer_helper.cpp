@@ -2174,6 +2174,10 @@ std::shared_ptr<renderer::Device> createLogicalDevice(
     // chain).
     enabled_vulkan12_features.shaderFloat16                             = VK_TRUE;
     enabled_vulkan12_features.shaderInt8                                = VK_TRUE;
+    // timelineSemaphore: UploadScheduler tracks batch completion with one
+    // timeline semaphore instead of a fence per upload.  Core in 1.2, so
+    // every device that passes the 1.3 check supports it.
+    enabled_vulkan12_features.timelineSemaphore                         = VK_TRUE;
     enabled_vulkan12_features.pNext = &enabled_vulkan11_features;
 
     enabled_vulkan13_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
@@ -2514,10 +2518,13 @@ void createTextureImage(
         device->getImageMemoryRequirements(image);
     image_memory =
         device->allocateMemory(
-            mem_requirements.size,
-            mem_requirements.memory_type_bits,
+            mem_requirements,
             toVkMemoryPropertyFlags(properties),
-            0);
+            0,
+            // Linear-tiled images are "linear resources" for
+            // bufferImageGranularity, so they may share buffer blocks.
+            tiling == renderer::ImageTiling::OPTIMAL,
+            src_location);
     device->bindImageMemory(image, image_memory);
 }
 
@@ -2604,7 +2611,8 @@ void transitionImageLayout(
         barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
         source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        destination_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        destination_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
     }
     else if (old_layout == renderer::ImageLayout::TRANSFER_SRC_OPTIMAL &&
         new_layout == renderer::ImageLayout::SHADER_READ_ONLY_OPTIMAL) {
@@ -2614,6 +2622,19 @@ void transitionImageLayout(
         source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
         destination_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
     }
+    // In-place update of a sampled image (Helper::update2DTextureRegion /
+    // update2DTextureMips), recorded on the frame's command buffer: the
+    // reads of earlier frames on the queue must finish before the copy
+    // writes.
+    else if (old_layout == renderer::ImageLayout::SHADER_READ_ONLY_OPTIMAL &&
+        new_layout == renderer::ImageLayout::TRANSFER_DST_OPTIMAL) {
+        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        source_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        destination_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
     else if (old_layout == renderer::ImageLayout::UNDEFINED &&
         new_layout == renderer::ImageLayout::DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
         barrier.srcAccessMask = 0;
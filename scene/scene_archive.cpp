@@ -0,0 +1,469 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// scene_archive.cpp — RWSCENE v6 writer and reader; see scene_archive.h.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "scene/scene_archive.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "helper/zstd_block.h"
+#include "scene/scene_io.h"
+
+namespace engine {
+namespace scene {
+
+namespace {
+
+const char kMagic[8] = { 'R', 'W', 'S', 'C', 'E', 'N', 'E', '\0' };
+
+// Fixed part of one object's record in a decoded chunk block.
+constexpr size_t kRecordBytes = 5 * 4 + 10 * 4 + 4 + 5 * 4 + 4 + 1;
+static_assert(kRecordBytes == 89, "keep scene_archive.h in sync");
+
+// Sanity caps against corrupt counts (the legacy loader allows 1M objects).
+constexpr uint32_t kMaxObjects = 1u << 24;
+constexpr uint32_t kMaxStrings = 1u << 24;
+constexpr uint64_t kMaxBlockBytes = 1ull << 31;
+
+struct BlockWriter {
+    std::vector<uint8_t> out;
+    template <typename T>
+    void pod(const T& v) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* b = reinterpret_cast<const uint8_t*>(&v);
+        out.insert(out.end(), b, b + sizeof(T));
+    }
+    void bytes(const void* p, size_t n) {
+        const auto* b = static_cast<const uint8_t*>(p);
+        out.insert(out.end(), b, b + n);
+    }
+};
+
+template <typename T>
+bool readPod(std::FILE* f, T& v) {
+    return std::fread(&v, sizeof(T), 1, f) == 1;
+}
+
+bool readXform(std::FILE* f, Transform& t) {
+    float v[10];
+    if (std::fread(v, sizeof(float), 10, f) != 10) return false;
+    t.translation = glm::vec3(v[0], v[1], v[2]);
+    t.rotation    = glm::quat(v[6], v[3], v[4], v[5]);
+    t.scale       = glm::vec3(v[7], v[8], v[9]);
+    return true;
+}
+
+void writeXform(BlockWriter& w, const Transform& t) {
+    const float v[10] = { t.translation.x, t.translation.y, t.translation.z,
+                          t.rotation.x,    t.rotation.y,    t.rotation.z,
+                          t.rotation.w,    t.scale.x,       t.scale.y,
+                          t.scale.z };
+    w.bytes(v, sizeof(v));
+}
+
+int32_t cellOf(float v, float size) {
+    const float c = std::floor(v / size);
+    if (!(c > (float)INT_MIN)) return INT_MIN;      // also catches NaN
+    if (c >= (float)INT_MAX) return INT_MAX;
+    return (int32_t)c;
+}
+
+// Encode the objects `idx` (scene indices, ascending) as one chunk block.
+void encodeChunk(const Scene& scene, const std::vector<uint32_t>& idx,
+                 const std::vector<uint32_t>& asset_ids,
+                 const std::vector<uint32_t>& clip_ids, BlockWriter& w) {
+    const auto& objs = scene.objects;
+    for (uint32_t i : idx) w.pod(i);
+    for (uint32_t i : idx) w.pod(objs[i].parent_index);
+    for (uint32_t i : idx) w.pod(objs[i].source_node_index);
+    for (uint32_t i : idx) w.pod(asset_ids[i]);
+    for (uint32_t i : idx) w.pod(clip_ids[i]);
+    for (uint32_t i : idx) {
+        const glm::vec3& t = objs[i].transform.translation;
+        const float v[3] = { t.x, t.y, t.z };
+        w.bytes(v, sizeof(v));
+    }
+    for (uint32_t i : idx) {
+        const glm::quat& r = objs[i].transform.rotation;
+        const float v[4] = { r.x, r.y, r.z, r.w };
+        w.bytes(v, sizeof(v));
+    }
+    for (uint32_t i : idx) {
+        const glm::vec3& s = objs[i].transform.scale;
+        const float v[3] = { s.x, s.y, s.z };
+        w.bytes(v, sizeof(v));
+    }
+    for (uint32_t i : idx) w.pod(objs[i].audio_volume);
+    for (uint32_t i : idx) {
+        const Object& o = objs[i];
+        const float v[5] = { o.light_color.x, o.light_color.y, o.light_color.z,
+                             o.light_intensity, o.light_radius };
+        w.bytes(v, sizeof(v));
+    }
+    uint32_t end = 0;
+    for (uint32_t i : idx) {
+        end += (uint32_t)objs[i].name.size();
+        w.pod(end);
+    }
+    for (uint32_t i : idx) {
+        const Object& o = objs[i];
+        w.pod(static_cast<uint8_t>((o.is_group ? kObjectGroup : 0) |
+                                   (o.visible ? kObjectVisible : 0) |
+                                   (o.audio_loop ? kObjectAudioLoop : 0)));
+    }
+    for (uint32_t i : idx) w.bytes(objs[i].name.data(), objs[i].name.size());
+}
+
+} // namespace
+
+// ── Writer ──────────────────────────────────────────────────────────────────
+
+bool writeSceneArchive(const std::string& path, const Scene& scene,
+                       const SceneSaveOptions& options) {
+    const auto& objs = scene.objects;
+    const uint32_t n = (uint32_t)objs.size();
+    if (n > kMaxObjects) return false;
+    const float size = options.chunk_size > 0.0f ? options.chunk_size : 64.0f;
+
+    // Interned, portable paths.  Id 0 is "".
+    std::vector<std::string> strings(1);
+    std::unordered_map<std::string, uint32_t> ids{{std::string(), 0u}};
+    auto intern = [&](const std::string& p) -> uint32_t {
+        auto [it, added] =
+            ids.emplace(toPortableScenePath(p), (uint32_t)strings.size());
+        if (added) strings.push_back(it->first);
+        return it->second;
+    };
+    std::vector<uint32_t> asset_ids(n), clip_ids(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        asset_ids[i] = intern(objs[i].asset_path);
+        clip_ids[i]  = intern(objs[i].audio_clip);
+    }
+    const uint32_t music_id     = intern(scene.music_path);
+    const uint32_t collision_id = intern(scene.collision_map_path);
+
+    // Chunk of each object: the cell of its top-level ancestor.  A broken
+    // parent chain (out of range, or a cycle) ends at the object itself.
+    std::vector<std::pair<int32_t, int32_t>> cell(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t top = i;
+        for (uint32_t hops = 0; hops < n; ++hops) {
+            const int32_t p = objs[top].parent_index;
+            if (p < 0 || (uint32_t)p >= n) break;
+            top = (uint32_t)p;
+        }
+        if (objs[top].parent_index >= 0 &&
+            (uint32_t)objs[top].parent_index < n)
+            top = i;
+        const glm::vec3& t = objs[top].transform.translation;
+        cell[i] = { cellOf(t.z, size), cellOf(t.x, size) };
+    }
+    std::vector<uint32_t> order(n);
+    for (uint32_t i = 0; i < n; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return cell[a] != cell[b] ? cell[a] < cell[b] : a < b;
+    });
+
+    std::vector<SceneChunkEntry> chunks;
+    std::vector<std::vector<uint8_t>> blocks;
+    std::vector<uint32_t> members;
+    for (size_t b = 0; b < order.size();) {
+        size_t e = b;
+        members.clear();
+        while (e < order.size() && cell[order[e]] == cell[order[b]])
+            members.push_back(order[e++]);
+        BlockWriter w;
+        encodeChunk(scene, members, asset_ids, clip_ids, w);
+
+        SceneChunkEntry c;
+        c.cell_z       = cell[order[b]].first;
+        c.cell_x       = cell[order[b]].second;
+        c.object_count = (uint32_t)members.size();
+        c.raw_bytes    = w.out.size();
+        std::vector<uint8_t> packed;
+        if (options.compress &&
+            helper::zstdCompress(w.out.data(), w.out.size(), packed,
+                                 options.zstd_level)) {
+            c.codec = SceneBlockCodec::kZstd;
+            blocks.push_back(std::move(packed));
+        } else {
+            blocks.push_back(std::move(w.out));
+        }
+        c.stored_bytes = blocks.back().size();
+        chunks.push_back(c);
+        b = e;
+    }
+
+    BlockWriter h;
+    h.bytes(kMagic, 8);
+    h.pod(kSceneArchiveVersion);
+    h.pod((uint32_t)scene.name.size());
+    h.bytes(scene.name.data(), scene.name.size());
+    writeXform(h, scene.root);
+    h.pod(music_id);
+    h.pod(collision_id);
+    h.pod(scene.music_volume);
+    h.pod(size);
+    h.pod(n);
+    h.pod((uint32_t)strings.size());
+    h.pod((uint32_t)chunks.size());
+    uint32_t end = 0;
+    for (const auto& s : strings) {
+        end += (uint32_t)s.size();
+        h.pod(end);
+    }
+    for (const auto& s : strings) h.bytes(s.data(), s.size());
+
+    // Blocks follow the index, 4-byte aligned so a raw block can be read
+    // straight into place.
+    uint64_t at = h.out.size() + chunks.size() * sizeof(SceneChunkEntry);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        at = (at + 3) & ~uint64_t(3);
+        chunks[i].offset = at;
+        at += chunks[i].stored_bytes;
+    }
+    for (const auto& c : chunks) h.pod(c);
+
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        return false;
+    }
+    os.write(reinterpret_cast<const char*>(h.out.data()),
+             static_cast<std::streamsize>(h.out.size()));
+    uint64_t pos = h.out.size();
+    static const char kPad[4] = {};
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        os.write(kPad, static_cast<std::streamsize>(chunks[i].offset - pos));
+        os.write(reinterpret_cast<const char*>(blocks[i].data()),
+                 static_cast<std::streamsize>(blocks[i].size()));
+        pos = chunks[i].offset + blocks[i].size();
+    }
+    return static_cast<bool>(os);
+}
+
+// ── Reader ──────────────────────────────────────────────────────────────────
+
+bool SceneArchive::open(const std::string& path) {
+    close();
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) return false;
+
+    std::FILE* f = file_;
+    char magic[8];
+    uint32_t version = 0, name_len = 0, string_count = 0, chunk_count = 0;
+    bool ok = std::fread(magic, 1, 8, f) == 8 &&
+              std::memcmp(magic, kMagic, 8) == 0 && readPod(f, version) &&
+              version == kSceneArchiveVersion && readPod(f, name_len) &&
+              name_len <= (1u << 24);
+    if (ok) {
+        name_.resize(name_len);
+        ok = (name_len == 0 ||
+              std::fread(name_.data(), 1, name_len, f) == name_len) &&
+             readXform(f, root_) && readPod(f, music_path_) &&
+             readPod(f, collision_map_path_) && readPod(f, music_volume_) &&
+             readPod(f, chunk_size_) && readPod(f, object_count_) &&
+             readPod(f, string_count) && readPod(f, chunk_count) &&
+             chunk_size_ > 0.0f && object_count_ <= kMaxObjects &&
+             string_count >= 1 && string_count <= kMaxStrings &&
+             chunk_count <= object_count_;
+    }
+
+    // String table, re-rooted once per distinct path rather than once per
+    // object as the legacy loader does.
+    std::vector<uint32_t> stored_end(ok ? string_count : 0);
+    std::string stored;
+    if (ok) {
+        ok = std::fread(stored_end.data(), 4, string_count, f) ==
+                 string_count &&
+             stored_end[0] == 0 &&
+             std::is_sorted(stored_end.begin(), stored_end.end()) &&
+             stored_end.back() <= (1u << 28);
+    }
+    if (ok) {
+        stored.resize(stored_end.back());
+        ok = stored.empty() ||
+             std::fread(stored.data(), 1, stored.size(), f) == stored.size();
+    }
+    if (ok) {
+        string_end_.resize(string_count);
+        for (uint32_t i = 0; i < string_count; ++i) {
+            const uint32_t b = i ? stored_end[i - 1] : 0;
+            strings_ += resolveScenePath(stored.substr(b, stored_end[i] - b));
+            string_end_[i] = (uint32_t)strings_.size();
+        }
+        ok = music_path_ < string_count && collision_map_path_ < string_count;
+    }
+
+    if (ok) {
+        chunks_.resize(chunk_count);
+        ok = chunk_count == 0 ||
+             std::fread(chunks_.data(), sizeof(SceneChunkEntry), chunk_count,
+                        f) == chunk_count;
+    }
+    uint64_t total = 0;
+    for (size_t i = 0; ok && i < chunks_.size(); ++i) {
+        const SceneChunkEntry& c = chunks_[i];
+        ok = c.object_count > 0 &&
+             (c.codec == SceneBlockCodec::kRaw ||
+              c.codec == SceneBlockCodec::kZstd) &&
+             c.raw_bytes >= uint64_t(c.object_count) * kRecordBytes &&
+             c.raw_bytes <= kMaxBlockBytes &&
+             c.stored_bytes <= kMaxBlockBytes &&
+             (c.codec == SceneBlockCodec::kZstd ||
+              c.stored_bytes == c.raw_bytes) &&
+             c.offset <= (uint64_t)LONG_MAX;
+        total += c.object_count;
+    }
+    ok = ok && total == object_count_;
+    if (!ok) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void SceneArchive::close() {
+    if (file_) std::fclose(file_);
+    file_ = nullptr;
+    name_.clear();
+    root_ = Transform();
+    music_path_ = collision_map_path_ = 0;
+    music_volume_ = 1.0f;
+    chunk_size_ = 64.0f;
+    object_count_ = 0;
+    strings_.clear();
+    string_end_.clear();
+    chunks_.clear();
+}
+
+void SceneArchive::chunksNear(const glm::vec3& p, float radius,
+                              std::vector<uint32_t>& out) const {
+    out.clear();
+    const float r2 = radius * radius;
+    auto dist2 = [&](const SceneChunkEntry& c) {
+        const float x0 = (float)c.cell_x * chunk_size_;
+        const float z0 = (float)c.cell_z * chunk_size_;
+        const float dx = std::max({x0 - p.x, 0.0f, p.x - (x0 + chunk_size_)});
+        const float dz = std::max({z0 - p.z, 0.0f, p.z - (z0 + chunk_size_)});
+        return dx * dx + dz * dz;
+    };
+    for (uint32_t i = 0; i < (uint32_t)chunks_.size(); ++i)
+        if (dist2(chunks_[i]) <= r2) out.push_back(i);
+    std::sort(out.begin(), out.end(), [&](uint32_t a, uint32_t b) {
+        const float da = dist2(chunks_[a]), db = dist2(chunks_[b]);
+        return da != db ? da < db : a < b;
+    });
+}
+
+bool SceneArchive::readChunk(uint32_t chunk, SceneChunkView& out) {
+    out = SceneChunkView();
+    if (!file_ || chunk >= chunks_.size()) return false;
+    const SceneChunkEntry& c = chunks_[chunk];
+    if (std::fseek(file_, (long)c.offset, SEEK_SET) != 0) return false;
+
+    // Raw blocks land straight in raw_; zstd blocks go through stored_.
+    raw_.resize((size_t)c.raw_bytes);
+    if (c.codec == SceneBlockCodec::kRaw) {
+        if (std::fread(raw_.data(), 1, raw_.size(), file_) != raw_.size())
+            return false;
+    } else {
+        stored_.resize((size_t)c.stored_bytes);
+        if (std::fread(stored_.data(), 1, stored_.size(), file_) !=
+            stored_.size())
+            return false;
+        if (!helper::zstdDecompress(stored_.data(), stored_.size(),
+                                    raw_.data(), raw_.size())) {
+            std::cout << "[scene] chunk " << chunk << " is "
+                      << (helper::zstdAvailable()
+                              ? "corrupt"
+                              : "zstd-compressed and this build has no zstd")
+                      << "\n";
+            return false;
+        }
+    }
+
+    const uint32_t n = c.object_count;
+    const uint8_t* p = raw_.data();
+    auto take = [&](auto*& dst, size_t per_object) {
+        dst = reinterpret_cast<std::remove_reference_t<decltype(dst)>>(p);
+        p += per_object * n;
+    };
+    SceneChunkView v;
+    v.count = n;
+    take(v.scene_index, 4);
+    take(v.parent, 4);
+    take(v.source_node, 4);
+    take(v.asset, 4);
+    take(v.audio_clip, 4);
+    take(v.translation, 12);
+    take(v.rotation, 16);
+    take(v.scale, 12);
+    take(v.audio_volume, 4);
+    take(v.light, 20);
+    take(v.name_end, 4);
+    take(v.flags, 1);
+    v.names = reinterpret_cast<const char*>(p);
+
+    // Names must exactly fill the rest of the block.
+    const uint64_t names = c.raw_bytes - uint64_t(n) * kRecordBytes;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (v.name_end[i] < (i ? v.name_end[i - 1] : 0)) return false;
+    }
+    if (v.name_end[n - 1] != names) return false;
+    out = v;
+    return true;
+}
+
+bool readSceneArchive(const std::string& path, Scene& out_scene) {
+    SceneArchive a;
+    if (!a.open(path)) return false;
+
+    Scene s;
+    s.name               = a.name();
+    s.root               = a.root();
+    s.music_path         = std::string(a.musicPath());
+    s.music_volume       = a.musicVolume();
+    s.collision_map_path = std::string(a.collisionMapPath());
+    const uint32_t count = a.objectCount();
+    s.objects.resize(count);
+
+    std::vector<uint8_t> seen(count, 0);
+    SceneChunkView v;
+    for (uint32_t c = 0; c < (uint32_t)a.chunks().size(); ++c) {
+        if (!a.readChunk(c, v)) return false;
+        for (uint32_t i = 0; i < v.count; ++i) {
+            const uint32_t at = v.scene_index[i];
+            if (at >= count || seen[at]) return false;
+            if (v.parent[i] < -1 || v.parent[i] >= (int32_t)count)
+                return false;
+            seen[at] = 1;
+            Object& o = s.objects[at];
+            o.name              = std::string(v.name(i));
+            o.asset_path        = std::string(a.str(v.asset[i]));
+            o.parent_index      = v.parent[i];
+            o.source_node_index = v.source_node[i];
+            o.is_group          = (v.flags[i] & kObjectGroup) != 0;
+            o.visible           = (v.flags[i] & kObjectVisible) != 0;
+            o.transform         = v.transform(i);
+            o.audio_clip        = std::string(a.str(v.audio_clip[i]));
+            o.audio_loop        = (v.flags[i] & kObjectAudioLoop) != 0;
+            o.audio_volume      = v.audio_volume[i];
+            o.light_color = glm::vec3(v.light[5 * i], v.light[5 * i + 1],
+                                      v.light[5 * i + 2]);
+            o.light_intensity = v.light[5 * i + 3];
+            o.light_radius    = v.light[5 * i + 4];
+        }
+    }
+    out_scene = std::move(s);
+    return true;
+}
+
+} // namespace scene
+} // namespace engine
@@ -0,0 +1,189 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// scene_archive.h — compact scene format (RWSCENE v6) with per-chunk reads.
+//
+// v1–v5 files are one stream of variable-length object records, several
+// strings each, so opening a 100k-object scene allocates every string
+// before the app can create a single entity.  v6 instead stores:
+//   - every path (asset, audio clip, music, collision map) once, in an
+//     interned string table;
+//   - objects as fixed-size records laid out structure-of-arrays, one block
+//     per spatial CHUNK — a chunk_size square on the XZ plane, picked by the
+//     position of the object's top-level ancestor, so a group and all its
+//     children share a chunk.  Object names go in a per-chunk blob;
+//   - a chunk index (cell, object count, block offset / size) up front;
+//   - each block optionally zstd-compressed (helper/zstd_block.h).
+//
+// SceneArchive::open() reads the header, string table and chunk index only —
+// its cost follows the number of chunks and distinct paths, not objects —
+// and readChunk() decodes one chunk into buffers the archive reuses, so a
+// streaming loader can materialise the chunks around the player first and
+// the rest later (ecs/scene_chunk_loader.h).  loadSceneBinary() still
+// returns the whole Scene for the editor; the chunk grid is in scene space
+// (before Scene::root).
+//
+// Layout (little-endian):
+//   char    magic[8] = "RWSCENE\0"
+//   uint32  version  = 6
+//   string  scene name                      (uint32 length + raw bytes)
+//   Transform root                          (10 float32)
+//   uint32  music_path, collision_map_path  (string ids)
+//   float32 music_volume
+//   float32 chunk_size                      (metres)
+//   uint32  object_count, string_count, chunk_count
+//   uint32  string_end[string_count]        end of each string in the blob
+//   char    strings[]                       id 0 is always ""
+//   SceneChunkEntry chunks[chunk_count]
+//   chunk blocks, each at its entry's offset
+//
+// Chunk block, decoded (n = the chunk's object count, 89 bytes a record):
+//   uint32  scene_index[n]      position in Scene::objects (PersistentId - 1)
+//   int32   parent[n]           scene index, -1 = top level
+//   int32   source_node[n]
+//   uint32  asset[n]            string id
+//   uint32  audio_clip[n]       string id
+//   float32 translation[3n], rotation[4n] (x y z w), scale[3n]
+//   float32 audio_volume[n]
+//   float32 light[5n]           r g b intensity radius
+//   uint32  name_end[n]         end of each name in the blob
+//   uint8   flags[n]            SceneObjectFlags
+//   char    names[]
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "scene/scene_types.h"
+
+namespace engine {
+namespace scene {
+
+constexpr uint32_t kSceneArchiveVersion = 6;
+
+enum SceneObjectFlags : uint8_t {
+    kObjectGroup     = 1u << 0,
+    kObjectVisible   = 1u << 1,
+    kObjectAudioLoop = 1u << 2,
+};
+
+enum class SceneBlockCodec : uint32_t { kRaw = 0, kZstd = 1 };
+
+struct SceneChunkEntry {
+    int32_t         cell_x = 0;          // covers [cell, cell + 1) * size
+    int32_t         cell_z = 0;
+    uint32_t        object_count = 0;
+    SceneBlockCodec codec = SceneBlockCodec::kRaw;
+    uint64_t        offset = 0;          // block position in the file
+    uint64_t        stored_bytes = 0;
+    uint64_t        raw_bytes = 0;       // decoded size
+};
+static_assert(sizeof(SceneChunkEntry) == 40, "on-disk record");
+
+// One decoded chunk: arrays pointing into SceneArchive-owned memory, valid
+// until the next readChunk() or close().
+struct SceneChunkView {
+    uint32_t        count = 0;
+    const uint32_t* scene_index = nullptr;
+    const int32_t*  parent = nullptr;
+    const int32_t*  source_node = nullptr;
+    const uint32_t* asset = nullptr;
+    const uint32_t* audio_clip = nullptr;
+    const float*    translation = nullptr;   // 3 per object
+    const float*    rotation = nullptr;      // 4 per object, x y z w
+    const float*    scale = nullptr;         // 3 per object
+    const float*    audio_volume = nullptr;
+    const float*    light = nullptr;         // 5 per object
+    const uint32_t* name_end = nullptr;
+    const uint8_t*  flags = nullptr;
+    const char*     names = nullptr;
+
+    std::string_view name(uint32_t i) const {
+        const uint32_t b = i ? name_end[i - 1] : 0;
+        return std::string_view(names + b, name_end[i] - b);
+    }
+    Transform transform(uint32_t i) const {
+        Transform t;
+        t.translation = glm::vec3(translation[3 * i], translation[3 * i + 1],
+                                  translation[3 * i + 2]);
+        t.rotation = glm::quat(rotation[4 * i + 3], rotation[4 * i],
+                               rotation[4 * i + 1], rotation[4 * i + 2]);
+        t.scale = glm::vec3(scale[3 * i], scale[3 * i + 1], scale[3 * i + 2]);
+        return t;
+    }
+};
+
+struct SceneSaveOptions {
+    float chunk_size = 64.0f;    // metres per chunk edge
+    bool  compress   = true;     // zstd blocks (only when built with HAS_ZSTD)
+    int   zstd_level = 9;
+};
+
+class SceneArchive {
+public:
+    SceneArchive() = default;
+    ~SceneArchive() { close(); }
+    SceneArchive(const SceneArchive&) = delete;
+    SceneArchive& operator=(const SceneArchive&) = delete;
+
+    // Reads the header, string table (paths re-rooted as loadSceneBinary
+    // does) and chunk index; the file stays open for readChunk().  False
+    // for a missing / corrupt file or any version other than 6.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+
+    const std::string& name() const { return name_; }
+    const Transform&   root() const { return root_; }
+    std::string_view   musicPath() const { return str(music_path_); }
+    float              musicVolume() const { return music_volume_; }
+    std::string_view   collisionMapPath() const {
+        return str(collision_map_path_);
+    }
+    float              chunkSize() const { return chunk_size_; }
+    uint32_t           objectCount() const { return object_count_; }
+
+    const std::vector<SceneChunkEntry>& chunks() const { return chunks_; }
+
+    // Interned string by id ("" when out of range).
+    std::string_view str(uint32_t id) const {
+        if (id >= string_end_.size()) return std::string_view();
+        const uint32_t b = id ? string_end_[id - 1] : 0;
+        return std::string_view(strings_.data() + b, string_end_[id] - b);
+    }
+
+    // Indices of the chunks whose square comes within `radius` of `p` on
+    // the XZ plane, nearest first.  `out` is cleared first.
+    void chunksNear(const glm::vec3& p, float radius,
+                    std::vector<uint32_t>& out) const;
+
+    // Decode one chunk.  False on an I/O error, a corrupt block, or a zstd
+    // block in a build without zstd.
+    bool readChunk(uint32_t chunk, SceneChunkView& out);
+
+private:
+    std::FILE*                   file_ = nullptr;
+    std::string                  name_;
+    Transform                    root_;
+    uint32_t                     music_path_ = 0;
+    uint32_t                     collision_map_path_ = 0;
+    float                        music_volume_ = 1.0f;
+    float                        chunk_size_ = 64.0f;
+    uint32_t                     object_count_ = 0;
+    std::string                  strings_;
+    std::vector<uint32_t>        string_end_;
+    std::vector<SceneChunkEntry> chunks_;
+    std::vector<uint8_t>         stored_;    // compressed block (reused)
+    std::vector<uint8_t>         raw_;       // decoded block (reused)
+};
+
+// Write `scene` as v6 (saveSceneBinary does this).
+bool writeSceneArchive(const std::string& path, const Scene& scene,
+                       const SceneSaveOptions& options = {});
+
+// Read a whole v6 file into a Scene (loadSceneBinary does this).
+bool readSceneArchive(const std::string& path, Scene& out_scene);
+
+} // namespace scene
+} // namespace engine
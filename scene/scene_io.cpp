@@ -9,8 +9,6 @@
 namespace engine {
 namespace scene {
 
-namespace {
-
 // ── Portable asset paths ─────────────────────────────────────────────────
 // Scenes must survive being moved to another drive or machine.  Asset
 // references are therefore stored RELATIVE to the app root (the working
@@ -60,24 +58,13 @@ std::string resolveScenePath(const std::string& stored) {
     return stored;
 }
 
-template <typename T>
-void writePod(std::ofstream& os, const T& v) {
-    os.write(reinterpret_cast<const char*>(&v), sizeof(T));
-}
+namespace {
 
 template <typename T>
 bool readPod(std::ifstream& is, T& v) {
     return static_cast<bool>(is.read(reinterpret_cast<char*>(&v), sizeof(T)));
 }
 
-void writeStr(std::ofstream& os, const std::string& s) {
-    const uint32_t n = static_cast<uint32_t>(s.size());
-    writePod(os, n);
-    if (n) {
-        os.write(s.data(), static_cast<std::streamsize>(n));
-    }
-}
-
 bool readStr(std::ifstream& is, std::string& s) {
     uint32_t n = 0;
     if (!readPod(is, n)) {
@@ -94,19 +81,6 @@ bool readStr(std::ifstream& is, std::string& s) {
     return true;
 }
 
-void writeXform(std::ofstream& os, const Transform& t) {
-    writePod(os, t.translation.x);
-    writePod(os, t.translation.y);
-    writePod(os, t.translation.z);
-    writePod(os, t.rotation.x);
-    writePod(os, t.rotation.y);
-    writePod(os, t.rotation.z);
-    writePod(os, t.rotation.w);
-    writePod(os, t.scale.x);
-    writePod(os, t.scale.y);
-    writePod(os, t.scale.z);
-}
-
 bool readXform(std::ifstream& is, Transform& t) {
     bool ok = true;
     ok = ok && readPod(is, t.translation.x);
@@ -131,50 +105,14 @@ const char     kMagic[8] = { 'R', 'W', 'S', 'C', 'E', 'N', 'E', '\0' };
 // v5: + per-object light_color (3×f32) + light_intensity (f32) +
 //     light_radius (f32) in each object record (after the audio fields)
 //     — point-light objects (.rwlight) for the ReSTIR lighting path.
-const uint32_t kVersion  = 5;
+// v6: compact chunked layout, read and written by scene_archive.cpp.
+const uint32_t kLastStreamVersion = 5;
 
 } // namespace
 
-bool saveSceneBinary(const std::string& path, const Scene& scene) {
-    std::ofstream os(path, std::ios::binary | std::ios::trunc);
-    if (!os) {
-        return false;
-    }
-
-    os.write(kMagic, 8);
-    writePod(os, kVersion);
-    writeStr(os, scene.name);
-    writeXform(os, scene.root);
-    writePod(os, static_cast<uint32_t>(scene.objects.size()));
-
-    for (const auto& o : scene.objects) {
-        writeStr(os, o.name);
-        writeStr(os, toPortableScenePath(o.asset_path));
-        writePod(os, o.parent_index);
-        writePod(os, o.source_node_index);
-        writePod(os, static_cast<uint8_t>(o.is_group ? 1 : 0));
-        writePod(os, static_cast<uint8_t>(o.visible ? 1 : 0));
-        writeXform(os, o.transform);
-        // v3 per-object audio (BGM objects).
-        writeStr(os, toPortableScenePath(o.audio_clip));
-        writePod(os, static_cast<uint8_t>(o.audio_loop ? 1 : 0));
-        writePod(os, o.audio_volume);
-        // v5 per-object light attributes (.rwlight objects).
-        writePod(os, o.light_color.x);
-        writePod(os, o.light_color.y);
-        writePod(os, o.light_color.z);
-        writePod(os, o.light_intensity);
-        writePod(os, o.light_radius);
-    }
-
-    // v2 trailer: scene music.
-    writeStr(os, toPortableScenePath(scene.music_path));
-    writePod(os, scene.music_volume);
-
-    // v4 trailer: baked collision-map reference.
-    writeStr(os, toPortableScenePath(scene.collision_map_path));
-
-    return static_cast<bool>(os);
+bool saveSceneBinary(const std::string& path, const Scene& scene,
+                     const SceneSaveOptions& options) {
+    return writeSceneArchive(path, scene, options);
 }
 
 bool loadSceneBinary(const std::string& path, Scene& out_scene) {
@@ -195,7 +133,11 @@ bool loadSceneBinary(const std::string& path, Scene& out_scene) {
     if (!readPod(is, version)) {
         return false;
     }
-    if (version < 1 || version > kVersion) {
+    if (version == kSceneArchiveVersion) {
+        is.close();
+        return readSceneArchive(path, out_scene);
+    }
+    if (version < 1 || version > kLastStreamVersion) {
         return false;  // newer than this build understands
     }
 
@@ -20,18 +20,30 @@
 // v2+: music_path (string) + music_volume (f32) trailer.
 // v3+: per-object audio_clip (string) + audio_loop (u8) + audio_volume (f32).
 // v4+: collision_map_path (string) trailer — baked .rwcmap reference.
+// v5+: per-object light_color + light_intensity + light_radius.
+// v6:  compact chunked layout — see scene/scene_archive.h.  Saves always
+//      write v6; loads accept v1–v6.
 //
 // Returns false on any I/O error, bad magic, or unknown version.
 // ─────────────────────────────────────────────────────────────────────────────
 #include <string>
 
+#include "scene/scene_archive.h"
 #include "scene/scene_types.h"
 
 namespace engine {
 namespace scene {
 
-bool saveSceneBinary(const std::string& path, const Scene& scene);
+bool saveSceneBinary(const std::string& path, const Scene& scene,
+                     const SceneSaveOptions& options = {});
 bool loadSceneBinary(const std::string& path, Scene& out_scene);
 
+// Asset references are stored relative to the app root (the working
+// directory) so a scene survives being moved to another drive or machine.
+// toPortableScenePath() makes a path relative when it lies under the root;
+// resolveScenePath() re-roots a stale absolute path from a legacy scene.
+std::string toPortableScenePath(const std::string& p);
+std::string resolveScenePath(const std::string& stored);
+
 } // namespace scene
 } // namespace engine
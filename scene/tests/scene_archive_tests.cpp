@@ -0,0 +1,418 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// scene_archive_tests.cpp — standalone unit tests for the chunked scene
+// format (scene/scene_archive.*, scene/scene_io.*).
+//
+// Pure CPU, files under the system temp directory.  A generated scene —
+// groups with children spread over a few chunks, lights, BGM objects,
+// shared paths — goes through saveSceneBinary / loadSceneBinary and must
+// come back field for field.  Then: paths are interned once, a group and
+// its children land in one chunk, chunksNear() picks and orders chunks by
+// XZ distance, readChunk() decodes one chunk on its own, a hand-written v5
+// file still loads, and truncated or damaged files are refused.  Built
+// with HAS_ZSTD the blocks are compressed and the same checks hold.
+//
+// Build:
+//   g++ -std=c++20 -O2 -I. -I<glm-dir> scene/tests/scene_archive_tests.cpp
+//       scene/scene_archive.cpp scene/scene_io.cpp helper/zstd_block.cpp
+//       -o scene_archive_tests
+//   (add -DHAS_ZSTD ... -lzstd to cover compressed blocks)
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "helper/zstd_block.h"
+#include "scene/scene_archive.h"
+#include "scene/scene_io.h"
+
+using namespace engine::scene;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::vector<char> readFile(const std::string& path) {
+    std::ifstream is(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(is), {});
+}
+
+static void writeFile(const std::string& path, const std::vector<char>& b) {
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    os.write(b.data(), (std::streamsize)b.size());
+}
+
+static bool sameXform(const Transform& a, const Transform& b) {
+    return a.translation == b.translation && a.scale == b.scale &&
+           a.rotation.w == b.rotation.w && a.rotation.x == b.rotation.x &&
+           a.rotation.y == b.rotation.y && a.rotation.z == b.rotation.z;
+}
+
+static bool sameObject(const Object& a, const Object& b) {
+    return a.name == b.name && a.asset_path == b.asset_path &&
+           a.parent_index == b.parent_index &&
+           a.source_node_index == b.source_node_index &&
+           a.is_group == b.is_group && a.visible == b.visible &&
+           sameXform(a.transform, b.transform) &&
+           a.audio_clip == b.audio_clip && a.audio_loop == b.audio_loop &&
+           a.audio_volume == b.audio_volume &&
+           a.light_color == b.light_color &&
+           a.light_intensity == b.light_intensity &&
+           a.light_radius == b.light_radius;
+}
+
+// Groups of 1 + 3 children on a 4 x 3 grid 50 m apart (so chunks of 64 m
+// hold one or two groups), a light and a BGM object, all with relative
+// paths that exist nowhere (resolveScenePath leaves those alone).
+static Scene makeScene() {
+    Scene s;
+    s.name = "archive test";
+    s.root.translation = glm::vec3(1.0f, 2.0f, 3.0f);
+    s.root.scale = glm::vec3(2.0f);
+    s.music_path = "content/audio/theme.wav";
+    s.music_volume = 0.4f;
+    s.collision_map_path = "content/maps/test.rwcmap";
+    for (int gz = 0; gz < 3; ++gz) {
+        for (int gx = 0; gx < 4; ++gx) {
+            const int32_t group = (int32_t)s.objects.size();
+            Object g;
+            g.name = "house_" + std::to_string(gx) + "_" + std::to_string(gz);
+            g.asset_path = (gx & 1) ? "assets/house_a.glb" : "assets/house_b.glb";
+            g.is_group = true;
+            g.transform.translation =
+                glm::vec3(gx * 50.0f - 60.0f, 0.5f, gz * 50.0f - 40.0f);
+            g.transform.rotation = glm::quat(0.8f, 0.0f, 0.6f, 0.0f);
+            s.objects.push_back(g);
+            for (int c = 0; c < 3; ++c) {
+                Object o;
+                o.name = g.name + "/node" + std::to_string(c);
+                o.asset_path = g.asset_path;
+                o.parent_index = group;
+                o.source_node_index = c;
+                o.visible = c != 1;
+                // Children sit far from the group's origin: their chunk
+                // must still be the group's.
+                o.transform.translation = glm::vec3(c * 40.0f, 0.0f, 0.0f);
+                s.objects.push_back(o);
+            }
+        }
+    }
+    Object light;
+    light.name = "lantern";
+    light.asset_path = "assets/lantern.rwlight";
+    light.transform.translation = glm::vec3(5.0f, 3.0f, 5.0f);
+    light.light_color = glm::vec3(0.2f, 0.4f, 1.0f);
+    light.light_intensity = 7.5f;
+    light.light_radius = 30.0f;
+    s.objects.push_back(light);
+    Object bgm;
+    bgm.name = "radio";
+    bgm.asset_path = "assets/radio.rwbgm";
+    bgm.audio_clip = "content/audio/radio.wav";
+    bgm.audio_loop = false;
+    bgm.audio_volume = 0.25f;
+    bgm.transform.translation = glm::vec3(-500.0f, 0.0f, 900.0f);
+    s.objects.push_back(bgm);
+    return s;
+}
+
+static void testRoundTrip() {
+    const Scene s = makeScene();
+    const std::string path = tempPath("rw_scene_archive_rt.rwscene");
+    CHECK(saveSceneBinary(path, s));
+
+    Scene back;
+    CHECK(loadSceneBinary(path, back));
+    CHECK(back.name == s.name);
+    CHECK(sameXform(back.root, s.root));
+    CHECK(back.music_path == s.music_path);
+    CHECK(back.music_volume == s.music_volume);
+    CHECK(back.collision_map_path == s.collision_map_path);
+    CHECK(back.objects.size() == s.objects.size());
+    for (size_t i = 0; i < s.objects.size(); ++i)
+        CHECK(sameObject(back.objects[i], s.objects[i]));
+
+    // Uncompressed blocks read the same.
+    SceneSaveOptions raw;
+    raw.compress = false;
+    CHECK(saveSceneBinary(path, s, raw));
+    Scene back_raw;
+    CHECK(loadSceneBinary(path, back_raw));
+    CHECK(back_raw.objects.size() == s.objects.size());
+    for (size_t i = 0; i < s.objects.size(); ++i)
+        CHECK(sameObject(back_raw.objects[i], s.objects[i]));
+
+    // An empty scene has no chunks and still round-trips.
+    Scene empty;
+    CHECK(saveSceneBinary(path, empty));
+    Scene back_empty;
+    back_empty.objects.resize(3);
+    CHECK(loadSceneBinary(path, back_empty));
+    CHECK(back_empty.name == "Untitled");
+    CHECK(back_empty.objects.empty());
+    std::remove(path.c_str());
+}
+
+static void testLayout() {
+    const Scene s = makeScene();
+    const std::string path = tempPath("rw_scene_archive_layout.rwscene");
+    SceneSaveOptions opt;
+    opt.chunk_size = 64.0f;
+    CHECK(saveSceneBinary(path, s, opt));
+
+    SceneArchive a;
+    CHECK(a.open(path));
+    CHECK(a.isOpen());
+    CHECK(a.objectCount() == s.objects.size());
+    CHECK(a.chunkSize() == 64.0f);
+    CHECK(a.musicPath() == s.music_path);
+
+    // "" + two houses + light + radio + clip + music + collision map.
+    CHECK(a.str(0).empty());
+    CHECK(a.str(8).empty());             // out of range reads as ""
+    CHECK(!a.str(7).empty());
+
+    // Every group shares a chunk with its children; chunk counts add up.
+    std::vector<int64_t> chunk_of(s.objects.size(), -1);
+    SceneChunkView v;
+    uint32_t total = 0;
+    for (uint32_t c = 0; c < (uint32_t)a.chunks().size(); ++c) {
+        CHECK(a.readChunk(c, v));
+        CHECK(v.count == a.chunks()[c].object_count);
+        total += v.count;
+        for (uint32_t i = 0; i < v.count; ++i) {
+            CHECK(chunk_of[v.scene_index[i]] == -1);
+            chunk_of[v.scene_index[i]] = c;
+            CHECK(v.name(i) == s.objects[v.scene_index[i]].name);
+        }
+    }
+    CHECK(total == s.objects.size());
+    for (size_t i = 0; i < s.objects.size(); ++i) {
+        const int32_t p = s.objects[i].parent_index;
+        if (p >= 0) CHECK(chunk_of[i] == chunk_of[(size_t)p]);
+    }
+
+    // The cell of each chunk holds its top-level objects.
+    for (size_t i = 0; i < s.objects.size(); ++i) {
+        if (s.objects[i].parent_index >= 0) continue;
+        const SceneChunkEntry& c = a.chunks()[(size_t)chunk_of[i]];
+        const glm::vec3& t = s.objects[i].transform.translation;
+        CHECK((int32_t)std::floor(t.x / 64.0f) == c.cell_x);
+        CHECK((int32_t)std::floor(t.z / 64.0f) == c.cell_z);
+    }
+
+    // Near the lantern: its own chunk first; a 1 m radius sees only the
+    // chunk the point is in, and the far-off radio only shows up when
+    // the radius reaches it.
+    std::vector<uint32_t> near;
+    a.chunksNear(glm::vec3(5.0f, 0.0f, 5.0f), 1.0f, near);
+    CHECK(near.size() == 1);
+    CHECK(near[0] == (uint32_t)chunk_of[s.objects.size() - 2]);
+    a.chunksNear(glm::vec3(5.0f, 0.0f, 5.0f), 100.0f, near);
+    CHECK(near.size() > 1 && near.size() < a.chunks().size());
+    CHECK(near[0] == (uint32_t)chunk_of[s.objects.size() - 2]);
+    float last = -1.0f;
+    for (uint32_t c : near) {
+        const SceneChunkEntry& e = a.chunks()[c];
+        const float cx = std::max(e.cell_x * 64.0f - 5.0f,
+                                  std::max(0.0f, 5.0f - (e.cell_x + 1) * 64.0f));
+        const float cz = std::max(e.cell_z * 64.0f - 5.0f,
+                                  std::max(0.0f, 5.0f - (e.cell_z + 1) * 64.0f));
+        const float d = cx * cx + cz * cz;
+        CHECK(d <= 100.0f * 100.0f);
+        CHECK(d >= last);
+        last = d;
+    }
+    for (uint32_t c : near)
+        CHECK(c != (uint32_t)chunk_of[s.objects.size() - 1]);
+    a.chunksNear(glm::vec3(5.0f, 0.0f, 5.0f), 2000.0f, near);
+    CHECK(near.size() == a.chunks().size());
+
+    // One chunk decodes on its own, out of order.
+    const uint32_t radio_chunk = (uint32_t)chunk_of[s.objects.size() - 1];
+    CHECK(a.readChunk(radio_chunk, v));
+    CHECK(v.count == 1);
+    CHECK(v.name(0) == "radio");
+    CHECK(a.str(v.asset[0]) == "assets/radio.rwbgm");
+    CHECK(a.str(v.audio_clip[0]) == "content/audio/radio.wav");
+    CHECK((v.flags[0] & kObjectAudioLoop) == 0);
+    CHECK((v.flags[0] & kObjectVisible) != 0);
+    CHECK(v.audio_volume[0] == 0.25f);
+    CHECK(!a.readChunk((uint32_t)a.chunks().size(), v));
+    CHECK(v.count == 0);
+
+    if (engine::helper::zstdAvailable()) {
+        bool any = false;
+        for (const auto& c : a.chunks())
+            any = any || c.codec == SceneBlockCodec::kZstd;
+        CHECK(any);
+    }
+    a.close();
+    CHECK(!a.isOpen());
+    std::remove(path.c_str());
+}
+
+// v5 as the old writer laid it out, by hand.
+template <typename T>
+static void put(std::vector<char>& b, const T& v) {
+    const char* p = reinterpret_cast<const char*>(&v);
+    b.insert(b.end(), p, p + sizeof(T));
+}
+static void putStr(std::vector<char>& b, const std::string& s) {
+    put(b, (uint32_t)s.size());
+    b.insert(b.end(), s.begin(), s.end());
+}
+static void putXform(std::vector<char>& b, const Transform& t) {
+    put(b, t.translation.x); put(b, t.translation.y); put(b, t.translation.z);
+    put(b, t.rotation.x); put(b, t.rotation.y); put(b, t.rotation.z);
+    put(b, t.rotation.w);
+    put(b, t.scale.x); put(b, t.scale.y); put(b, t.scale.z);
+}
+
+static void testLegacyV5() {
+    const Scene s = makeScene();
+    std::vector<char> b;
+    b.insert(b.end(), "RWSCENE", "RWSCENE" + 8);
+    put(b, (uint32_t)5);
+    putStr(b, s.name);
+    putXform(b, s.root);
+    put(b, (uint32_t)s.objects.size());
+    for (const Object& o : s.objects) {
+        putStr(b, o.name);
+        putStr(b, o.asset_path);
+        put(b, o.parent_index);
+        put(b, o.source_node_index);
+        put(b, (uint8_t)o.is_group);
+        put(b, (uint8_t)o.visible);
+        putXform(b, o.transform);
+        putStr(b, o.audio_clip);
+        put(b, (uint8_t)o.audio_loop);
+        put(b, o.audio_volume);
+        put(b, o.light_color.x); put(b, o.light_color.y);
+        put(b, o.light_color.z);
+        put(b, o.light_intensity);
+        put(b, o.light_radius);
+    }
+    putStr(b, s.music_path);
+    put(b, s.music_volume);
+    putStr(b, s.collision_map_path);
+
+    const std::string path = tempPath("rw_scene_archive_v5.rwscene");
+    writeFile(path, b);
+    Scene back;
+    CHECK(loadSceneBinary(path, back));
+    CHECK(back.name == s.name);
+    CHECK(back.collision_map_path == s.collision_map_path);
+    CHECK(back.objects.size() == s.objects.size());
+    for (size_t i = 0; i < s.objects.size(); ++i)
+        CHECK(sameObject(back.objects[i], s.objects[i]));
+
+    // Not a v6 file: the chunk reader says no instead of misreading it.
+    SceneArchive a;
+    CHECK(!a.open(path));
+
+    // Saving it again upgrades it to v6.
+    CHECK(saveSceneBinary(path, back));
+    CHECK(a.open(path));
+    std::remove(path.c_str());
+}
+
+static void testCorrupt() {
+    const Scene s = makeScene();
+    const std::string path = tempPath("rw_scene_archive_bad.rwscene");
+    SceneSaveOptions raw;
+    raw.compress = false;
+    CHECK(saveSceneBinary(path, s, raw));
+    const std::vector<char> good = readFile(path);
+    Scene out;
+    SceneArchive a;
+
+    // Missing file, and every truncation short of the whole file.
+    CHECK(!loadSceneBinary(tempPath("rw_scene_archive_missing.rwscene"), out));
+    for (size_t cut = 0; cut < good.size(); cut += 7) {
+        writeFile(path, std::vector<char>(good.begin(), good.begin() + cut));
+        CHECK(!loadSceneBinary(path, out));
+    }
+
+    // Unknown version.
+    std::vector<char> b = good;
+    b[8] = 7;
+    writeFile(path, b);
+    CHECK(!loadSceneBinary(path, out));
+    CHECK(!a.open(path));
+
+    // Header intact, chunk object counts no longer add up.  The index is
+    // found by the bytes of its first entry.
+    writeFile(path, good);
+    CHECK(a.open(path));
+    const SceneChunkEntry first = a.chunks()[0];
+    a.close();
+    size_t idx = std::string::npos;
+    for (size_t at = 0; at + sizeof first <= good.size(); ++at) {
+        if (std::memcmp(good.data() + at, &first, sizeof first) == 0) {
+            idx = at;
+            break;
+        }
+    }
+    CHECK(idx != std::string::npos);
+    b = good;
+    SceneChunkEntry e;
+    std::memcpy(&e, b.data() + idx, sizeof e);
+    ++e.object_count;
+    std::memcpy(b.data() + idx, &e, sizeof e);
+    writeFile(path, b);
+    CHECK(!a.open(path));
+    CHECK(!loadSceneBinary(path, out));
+
+    // A names table that overruns its block opens (the index is fine) but
+    // the chunk is refused.
+    b = good;
+    std::memcpy(&e, b.data() + idx, sizeof e);
+    // name_end[] follows the 84 bytes a record of fixed-size fields.
+    const size_t name_end_last =
+        (size_t)e.offset + (size_t)e.object_count * 84 +
+        4 * ((size_t)e.object_count - 1);
+    uint32_t bogus = 1u << 30;
+    std::memcpy(b.data() + name_end_last, &bogus, 4);
+    writeFile(path, b);
+    CHECK(a.open(path));
+    SceneChunkView v;
+    uint32_t c = 0;
+    while (a.chunks()[c].offset != e.offset) ++c;
+    CHECK(!a.readChunk(c, v));
+    a.close();
+    CHECK(!loadSceneBinary(path, out));
+
+    // Two records claiming the same scene index.
+    b = good;
+    std::memcpy(b.data() + (size_t)e.offset + 4, b.data() + (size_t)e.offset,
+                4);
+    writeFile(path, b);
+    CHECK(!loadSceneBinary(path, out));
+    std::remove(path.c_str());
+}
+
+int main() {
+    testRoundTrip();
+    testLayout();
+    testLegacyV5();
+    testCorrupt();
+    std::printf("scene_archive_tests: %d checks passed%s\n", g_checks,
+                engine::helper::zstdAvailable() ? " (zstd)" : "");
+    return 0;
+}
@@ -12,13 +12,15 @@
 #include "virtual_texture.h"
 
 #include "glm/gtc/packing.hpp"   // packHalf2x16 for the RT pos+uv repack
-#include "helper/thread_pool.h"  // parallel CPU skinning (updateRtSkeletons)
+#include "helper/thread_pool.h"  // RT CPU workers (skinning, shadow BVH builds)
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdarg>
 #include <cstdio>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <source_location>
 #include <cstring>
@@ -26,6 +28,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <thread>
 
 namespace er  = engine::renderer;
 
@@ -1153,6 +1156,7 @@ void ClusterRenderer::uploadMeshClusters(
     mesh_prim_material_[uploaded_mesh_count_] = prim_to_mat_idx;
 
     ++uploaded_mesh_count_;
+    live_clusters_ += num_clusters;
 }
 
 // ─── preRegisterVtMaterials ────────────────────────────────────────────────
@@ -1324,6 +1328,20 @@ void ClusterRenderer::finalizeUploads() {
         return;
     }
 
+    // Auto-snapshot: the first finalize defines the base scene unless the
+    // application marked it explicitly beforehand.  Taken BEFORE the
+    // scene-database padding below so the base never includes headroom.
+    if (!base_marked_) {
+        markBaseUploads();
+    }
+
+    // Size the scene database (headroom for live adds) and pad every
+    // staging stream to that capacity; the buffers below are created at
+    // the padded sizes, so live edits only ever write sub-ranges.
+    reserveSceneDbCapacity();
+    total_clusters_all_meshes_ =
+        static_cast<uint32_t>(staging_cull_infos_.size());
+
     // Create cull_info as HOST_VISIBLE so we can verify the data.
     {
         const uint64_t sz = total_clusters_all_meshes_ * sizeof(glsl::ClusterCullInfo);
@@ -1817,6 +1835,8 @@ void ClusterRenderer::finalizeUploads() {
             const uint32_t step = std::max(1u, total / want);
             for (uint32_t i = 0; i < total && debug_sample_clusters_.size() < want;
                  i += step) {
+                // Skip scene-database placeholders (poisoned sphere).
+                if (staging_cull_infos_[i].bounds_sphere.w < 0.0f) continue;
                 debug_sample_clusters_.push_back(staging_cull_infos_[i]);
             }
         }
@@ -1875,14 +1895,12 @@ void ClusterRenderer::finalizeUploads() {
 
     // CPU staging is RETAINED (not cleared) so the editor's incremental
     // flow can resetToBaseUploads() + re-stage placed objects + call
-    // finalizeUploads() again.  Costs one CPU copy of the merged VB/IB —
-    // acceptable for the editor; revisit with a "shipping" mode flag if
-    // the retained copy ever matters for the packaged game.
-    if (!base_marked_) {
-        // Auto-snapshot: the first finalize defines the base scene unless
-        // the application marked it explicitly beforehand.
-        markBaseUploads();
-    }
+    // finalizeUploads() again, and so the live scene database has its
+    // CPU mirror.  Costs one CPU copy of the merged VB/IB — acceptable
+    // for the editor; revisit with a "shipping" mode flag if the
+    // retained copy ever matters for the packaged game.
+    // The RT shadow structures were rebuilt from the current staging.
+    scene_db_rt_stale_ = false;
 
     // On a RE-finalize the bindless graphics set (if the pipeline is
     // already up) still points at the old, just-replaced buffers —
@@ -1903,6 +1921,7 @@ void ClusterRenderer::markBaseUploads() {
     base_tex_count_      = staging_tex_views_.size();
     base_normal_tex_count_ = staging_normal_tex_views_.size();
     base_mesh_count_     = uploaded_mesh_count_;
+    base_live_clusters_  = live_clusters_;
     base_marked_         = true;
     clog_printf("[CLUSTER_RENDERER] Base uploads marked: %u meshes, "
                 "%zu clusters, %zu verts.\n",
@@ -1914,6 +1933,10 @@ void ClusterRenderer::resetToBaseUploads() {
         markBaseUploads();
         return;
     }
+    // Live meshes past the base are about to be truncated away (the
+    // application re-stages its placed set), and the next finalize
+    // re-packs and re-sizes every stream.
+    resetSceneDb();
     // staging_draw_infos_ is 1:1 with staging_cull_infos_ (one entry per
     // cluster, including geometry-less placeholders) — same truncation.
     staging_cull_infos_.resize(base_cluster_count_);
@@ -1927,6 +1950,7 @@ void ClusterRenderer::resetToBaseUploads() {
         mesh_prim_material_.resize(base_mesh_count_);
     }
     uploaded_mesh_count_ = base_mesh_count_;
+    live_clusters_       = base_live_clusters_;
 
     // Drop the placed tail's texture views too: a removed object's
     // drawable (and its GPU textures) may be destroyed right after this
@@ -1959,6 +1983,661 @@ void ClusterRenderer::resetToBaseUploads() {
     }
 }
 
+// ─── Persistent scene database ─────────────────────────────────────────────
+// Live add / remove of single meshes inside the finalized merged buffers —
+// see the header doc.  All of it runs on the render thread.
+
+namespace {
+
+// Frames a retired range stays untouched before it can be handed out again
+// (same cushion as the retireBuffer ring: kMaxFramesInFlight + 1).
+constexpr uint64_t kSceneDbRetireFrames = 3;
+// Batches up to this size are recorded inline with vkCmdUpdateBuffer
+// (65536 B per call); larger ones are packed into the staging ring.  A
+// batch over half the ring gets a buffer of its own.
+constexpr uint64_t kSceneDbInlineBytes = 64ull << 10;
+constexpr uint64_t kSceneDbUpdateChunk = 65536u;
+constexpr uint64_t kSceneDbUploadRingBytes = 16ull << 20;
+
+// Free room kept past the packed content of each stream: an eighth of it,
+// but never less than a few typical placed props.
+inline uint32_t sceneDbHeadroom(uint32_t used, uint32_t min_slack) {
+    return std::max(min_slack, used / 8u);
+}
+
+// Unused cluster slot: the negative radius fails every frustum test (the
+// setMeshClustersHidden poison) and the inverted AABB overlaps nothing, so
+// neither the cull nor the RT BVH build ever picks it.
+glsl::ClusterCullInfo sceneDbPlaceholderCull() {
+    glsl::ClusterCullInfo c{};
+    c.bounds_sphere    = glm::vec4(0.0f, 0.0f, 0.0f, -1e30f);
+    c.cone_axis_cutoff = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    c.aabb_min_pad     = glm::vec4(glm::vec3(1e30f), 0.0f);
+    c.aabb_max_pad     = glm::vec4(glm::vec3(-1e30f), 0.0f);
+    return c;
+}
+
+// Sort + merge overlapping / adjacent element ranges in place.
+template <typename Range>
+void coalesceSceneRanges(std::vector<Range>& ranges) {
+    std::sort(ranges.begin(), ranges.end(),
+              [](const Range& a, const Range& b) { return a.offset < b.offset; });
+    size_t out = 0;
+    for (const Range& r : ranges) {
+        if (r.count == 0) continue;
+        if (out > 0 &&
+            ranges[out - 1].offset + ranges[out - 1].count >= r.offset) {
+            Range& last = ranges[out - 1];
+            last.count = std::max(last.offset + last.count,
+                                  r.offset + r.count) - last.offset;
+        } else {
+            ranges[out++] = r;
+        }
+    }
+    ranges.resize(out);
+}
+
+} // namespace
+
+void ClusterRenderer::reserveSceneDbCapacity() {
+    // Only called from finalizeUploads, after its waitIdle on a re-run (and
+    // with nothing in flight on the first run): every retired range is
+    // out of scope, and the full upload below supersedes any queued range
+    // write.
+    releaseRetiredSceneRanges(/*force*/ true);
+    scene_dirty_clusters_.clear();
+    scene_dirty_vertices_.clear();
+    scene_dirty_indices_.clear();
+    scene_dirty_materials_.clear();
+    scene_dirty_rt_hidden_.clear();
+
+    struct Stream {
+        SceneRangeAllocator& alloc;
+        uint32_t             used;
+        uint32_t             min_slack;
+    };
+    Stream streams[] = {
+        { scene_cluster_alloc_,
+          static_cast<uint32_t>(staging_cull_infos_.size()),      1024u },
+        { scene_vertex_alloc_,
+          static_cast<uint32_t>(staging_vertices_.size()),        65536u },
+        { scene_index_alloc_,
+          static_cast<uint32_t>(staging_indices_.size()),         196608u },
+        { scene_material_alloc_,
+          static_cast<uint32_t>(staging_material_params_.size()), 256u },
+    };
+    for (Stream& st : streams) {
+        const uint32_t want = st.used + sceneDbHeadroom(st.used, st.min_slack);
+        if (!scene_db_active_ || st.used < st.alloc.capacity()) {
+            // First finalize, or staging was truncated under the database
+            // (resetToBaseUploads already dropped the live meshes).
+            st.alloc.reset(st.used, want);
+        } else if (st.used > st.alloc.capacity()) {
+            // Content appended past the old capacity (plain uploads or an
+            // addSceneMesh fallback) stays occupied; fresh headroom after it.
+            st.alloc.extend(st.used, want);
+        }
+        // used == capacity: nothing appended, keep the current headroom.
+    }
+
+    staging_cull_infos_.resize(scene_cluster_alloc_.capacity(),
+                               sceneDbPlaceholderCull());
+    staging_draw_infos_.resize(scene_cluster_alloc_.capacity(),
+                               glsl::ClusterDrawInfo{});
+    staging_vertices_.resize(scene_vertex_alloc_.capacity(), BindlessVertex{});
+    staging_indices_.resize(scene_index_alloc_.capacity(), 0u);
+    staging_material_params_.resize(scene_material_alloc_.capacity(),
+                                    glsl::BindlessMaterialParams{});
+    staging_material_names_.resize(scene_material_alloc_.capacity());
+    scene_db_active_ = true;
+}
+
+bool ClusterRenderer::placeSceneMeshTail(
+    SceneMeshRecord& rec,
+    size_t cluster_base, size_t vertex_base,
+    size_t index_base, size_t material_base,
+    uint32_t object_idx) {
+
+    // ── 1. Reserve all four ranges (all or nothing) ───────────────────
+    struct Want {
+        SceneRangeAllocator& alloc;
+        SceneRange&          range;
+        uint32_t             count;
+    };
+    Want wants[] = {
+        { scene_cluster_alloc_,  rec.clusters,
+          static_cast<uint32_t>(staging_cull_infos_.size() - cluster_base) },
+        { scene_vertex_alloc_,   rec.vertices,
+          static_cast<uint32_t>(staging_vertices_.size() - vertex_base) },
+        { scene_index_alloc_,    rec.indices,
+          static_cast<uint32_t>(staging_indices_.size() - index_base) },
+        { scene_material_alloc_, rec.materials,
+          static_cast<uint32_t>(staging_material_params_.size() -
+                                material_base) },
+    };
+    size_t got = 0;
+    for (; got < std::size(wants); ++got) {
+        Want& w = wants[got];
+        w.range = { 0u, w.count };
+        if (w.count == 0) continue;
+        const uint32_t off = w.alloc.allocate(w.count);
+        if (off == SceneRangeAllocator::kInvalidOffset) break;
+        w.range.offset = off;
+    }
+    if (got < std::size(wants)) {
+        for (size_t i = 0; i < got; ++i) {
+            wants[i].alloc.free(wants[i].range.offset, wants[i].range.count);
+            wants[i].range = {};
+        }
+        return false;
+    }
+
+    // ── 2. Move the appended tail into its ranges, rebasing references ─
+    // uploadMeshClusters emits ABSOLUTE vertex ids (vertex_offset 0),
+    // absolute index offsets and absolute material ids, all relative to
+    // the staging sizes at the time of the call.
+    const uint32_t vo = rec.vertices.offset;
+    const uint32_t io = rec.indices.offset;
+    const uint32_t mo = rec.materials.offset;
+    const uint32_t co = rec.clusters.offset;
+    const uint32_t v_base = static_cast<uint32_t>(vertex_base);
+    const uint32_t i_base = static_cast<uint32_t>(index_base);
+    const uint32_t m_base = static_cast<uint32_t>(material_base);
+
+    std::copy(staging_vertices_.begin() + vertex_base,
+              staging_vertices_.end(),
+              staging_vertices_.begin() + vo);
+    for (uint32_t k = 0; k < rec.indices.count; ++k) {
+        staging_indices_[io + k] =
+            staging_indices_[index_base + k] - v_base + vo;
+    }
+    for (uint32_t k = 0; k < rec.materials.count; ++k) {
+        staging_material_params_[mo + k] =
+            staging_material_params_[material_base + k];
+        staging_material_names_[mo + k] =
+            std::move(staging_material_names_[material_base + k]);
+        if (mo + k < material_params_backup_.size()) {
+            material_params_backup_[mo + k] = staging_material_params_[mo + k];
+        }
+    }
+    uint64_t tris = 0;
+    for (uint32_t k = 0; k < rec.clusters.count; ++k) {
+        glsl::ClusterDrawInfo di = staging_draw_infos_[cluster_base + k];
+        if (di.index_count > 0) {
+            di.index_offset = di.index_offset - i_base + io;
+        }
+        if (di.material_idx >= m_base) {
+            di.material_idx = di.material_idx - m_base + mo;
+        }
+        staging_cull_infos_[co + k] = staging_cull_infos_[cluster_base + k];
+        staging_draw_infos_[co + k] = di;
+        if (co + k < cluster_tri_counts_.size()) {
+            cluster_tri_counts_[co + k] = di.index_count / 3;
+        }
+        if (co + k < cluster_to_mesh_.size()) {
+            cluster_to_mesh_[co + k] = rec.global_mesh_idx;
+        }
+        tris += di.index_count / 3;
+    }
+    total_triangles_all_meshes_ += tris;
+
+    mesh_cluster_ranges_[rec.global_mesh_idx].cluster_start = co;
+    if (object_idx < mesh_prim_material_.size()) {
+        for (auto& kv : mesh_prim_material_[object_idx]) {
+            if (kv.second >= m_base) kv.second = kv.second - m_base + mo;
+        }
+    }
+    mesh_visible_.resize(mesh_cluster_ranges_.size(), true);
+
+    // ── 3. Drop the tail: staging is back to exactly the capacity ─────
+    staging_cull_infos_.resize(cluster_base);
+    staging_draw_infos_.resize(cluster_base);
+    staging_vertices_.resize(vertex_base);
+    staging_indices_.resize(index_base);
+    staging_material_params_.resize(material_base);
+    staging_material_names_.resize(material_base);
+
+    scene_dirty_clusters_.push_back(rec.clusters);
+    scene_dirty_vertices_.push_back(rec.vertices);
+    scene_dirty_indices_.push_back(rec.indices);
+    scene_dirty_materials_.push_back(rec.materials);
+    return true;
+}
+
+ClusterRenderer::SceneMeshHandle ClusterRenderer::addSceneMesh(
+    const helper::ClusterMesh& cluster_mesh,
+    const game_object::DrawableData& drawable_data,
+    uint32_t mesh_idx,
+    const std::vector<uint32_t>& cluster_prim_map,
+    const glm::mat4& model_transform) {
+
+    const size_t cluster_base  = staging_cull_infos_.size();
+    const size_t vertex_base   = staging_vertices_.size();
+    const size_t index_base    = staging_indices_.size();
+    const size_t material_base = staging_material_params_.size();
+    const size_t tex_base      = staging_tex_views_.size();
+    const size_t normal_base   = staging_normal_tex_views_.size();
+    const size_t mesh_base     = mesh_cluster_ranges_.size();
+    const uint32_t object_idx  = uploaded_mesh_count_;
+
+    uploadMeshClusters(cluster_mesh, drawable_data, mesh_idx,
+                       cluster_prim_map, model_transform);
+    if (mesh_cluster_ranges_.size() == mesh_base) {
+        return kInvalidSceneMesh;              // empty mesh: nothing staged
+    }
+
+    // Take over a retired global mesh slot when there is one: the mesh
+    // uploadMeshClusters just appended moves into it and the tables shrink
+    // back, so moves (remove + add) do not grow them.
+    uint32_t global_mesh_idx = object_idx;
+    if (!scene_global_mesh_free_.empty() && object_idx == mesh_base &&
+        mesh_prim_material_.size() == size_t(object_idx) + 1) {
+        global_mesh_idx = scene_global_mesh_free_.back();
+        scene_global_mesh_free_.pop_back();
+        mesh_cluster_ranges_[global_mesh_idx] = mesh_cluster_ranges_.back();
+        mesh_cluster_ranges_.pop_back();
+        mesh_prim_material_[global_mesh_idx] =
+            std::move(mesh_prim_material_[object_idx]);
+        mesh_prim_material_.pop_back();
+        --uploaded_mesh_count_;
+        for (size_t k = cluster_base; k < staging_draw_infos_.size(); ++k) {
+            staging_draw_infos_[k].object_idx = global_mesh_idx;
+        }
+        if (global_mesh_idx < mesh_visible_.size()) {
+            mesh_visible_[global_mesh_idx] = true;
+        }
+    }
+
+    SceneMeshRecord rec;
+    rec.global_mesh_idx = global_mesh_idx;
+    // Where the tail sits right now — stays true for the staged-only and
+    // fallback paths below.
+    rec.clusters  = { static_cast<uint32_t>(cluster_base),
+                      static_cast<uint32_t>(
+                          staging_cull_infos_.size() - cluster_base) };
+    rec.vertices  = { static_cast<uint32_t>(vertex_base),
+                      static_cast<uint32_t>(
+                          staging_vertices_.size() - vertex_base) };
+    rec.indices   = { static_cast<uint32_t>(index_base),
+                      static_cast<uint32_t>(
+                          staging_indices_.size() - index_base) };
+    rec.materials = { static_cast<uint32_t>(material_base),
+                      static_cast<uint32_t>(
+                          staging_material_params_.size() - material_base) };
+
+    if (scene_db_active_ && gpu_ready_) {
+        // New legacy bindless texture slots would need a descriptor
+        // rewrite on a set the in-flight frame is using — that stays on
+        // the drained full path, as does running out of headroom.
+        const bool new_textures =
+            staging_tex_views_.size() != tex_base ||
+            staging_normal_tex_views_.size() != normal_base;
+        if (!new_textures &&
+            placeSceneMeshTail(rec, cluster_base, vertex_base, index_base,
+                               material_base, global_mesh_idx)) {
+            ++scene_db_live_adds_;
+            // The software-RT BVH picks it up by itself (refit into a
+            // recycled slot, else a background rebuild); the hardware AS
+            // waits for a full finalize.
+            rt_pending_clusters_.push_back(rec.clusters);
+            rt_pending_vertices_.push_back(rec.vertices);
+            rt_pending_materials_.push_back(rec.materials);
+            rt_bvh_dirty_ = true;
+            scene_db_rt_stale_ = true;
+        } else {
+            ++scene_db_fallback_finalizes_;
+            clog_printf("[CLUSTER_RENDERER] Scene DB: %s — full re-finalize "
+                        "(%u clusters, %u verts).\n",
+                        new_textures ? "new texture slots" : "out of headroom",
+                        rec.clusters.count, rec.vertices.count);
+            finalizeUploads();
+        }
+    }
+    // else: staged only — the caller's finalizeUploads() publishes it.
+
+    uint32_t slot;
+    if (!scene_mesh_free_.empty()) {
+        slot = scene_mesh_free_.back();
+        scene_mesh_free_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(scene_meshes_.size());
+        scene_meshes_.emplace_back();
+    }
+    rec.generation = scene_meshes_[slot].generation + 1;
+    rec.in_use = true;
+    scene_meshes_[slot] = rec;
+    return (static_cast<uint64_t>(rec.generation) << 32) | (slot + 1u);
+}
+
+ClusterRenderer::SceneMeshRecord* ClusterRenderer::findSceneMesh(
+    uint64_t handle) {
+    const uint32_t slot_plus_one = static_cast<uint32_t>(handle & 0xffffffffu);
+    if (slot_plus_one == 0 || slot_plus_one > scene_meshes_.size()) {
+        return nullptr;
+    }
+    SceneMeshRecord& rec = scene_meshes_[slot_plus_one - 1];
+    if (!rec.in_use ||
+        rec.generation != static_cast<uint32_t>(handle >> 32)) {
+        return nullptr;
+    }
+    return &rec;
+}
+
+void ClusterRenderer::removeSceneMesh(SceneMeshHandle handle) {
+    SceneMeshRecord* rec = findSceneMesh(handle);
+    if (!rec) return;
+
+    // Placeholders over the clusters: nothing references the mesh's
+    // vertices, indices or materials any more, so those need no write.
+    const SceneRange c = rec->clusters;
+    const glsl::ClusterCullInfo hidden = sceneDbPlaceholderCull();
+    uint64_t tris = 0;
+    for (uint32_t k = c.offset;
+         k < c.offset + c.count && k < staging_cull_infos_.size(); ++k) {
+        tris += staging_draw_infos_[k].index_count / 3;
+        staging_cull_infos_[k] = hidden;
+        staging_draw_infos_[k] = glsl::ClusterDrawInfo{};
+        if (k < cluster_tri_counts_.size()) cluster_tri_counts_[k] = 0;
+    }
+    if (rec->global_mesh_idx < mesh_cluster_ranges_.size()) {
+        mesh_cluster_ranges_[rec->global_mesh_idx].cluster_count = 0;
+    }
+    live_clusters_ -= std::min(live_clusters_, c.count);
+
+    if (scene_db_active_) {
+        total_triangles_all_meshes_ -=
+            std::min<uint64_t>(tris, total_triangles_all_meshes_);
+        scene_dirty_clusters_.push_back(c);
+        // The RT shadow BVH / duplicates still reference these clusters:
+        // hide them there too so the object stops casting immediately.
+        scene_dirty_rt_hidden_.push_back(c);
+        scene_retired_.push_back({ scene_db_frame_, rec->global_mesh_idx,
+                                   rec->clusters, rec->vertices,
+                                   rec->indices, rec->materials });
+        rt_bvh_dirty_ = true;                  // refit shrinks the boxes
+        scene_db_rt_stale_ = true;
+    } else {
+        // Not finalized yet: the placeholders simply get uploaded, and no
+        // frame reads the mesh slot, so it can be reused at once.
+        scene_global_mesh_free_.push_back(rec->global_mesh_idx);
+    }
+
+    rec->in_use = false;
+    scene_mesh_free_.push_back(
+        static_cast<uint32_t>(rec - scene_meshes_.data()));
+}
+
+void ClusterRenderer::releaseRetiredSceneRanges(bool force) {
+    size_t kept = 0;
+    for (auto& r : scene_retired_) {
+        if (!force && r.frame + kSceneDbRetireFrames > scene_db_frame_) {
+            scene_retired_[kept++] = r;
+            continue;
+        }
+        scene_cluster_alloc_.free(r.clusters.offset, r.clusters.count);
+        scene_vertex_alloc_.free(r.vertices.offset, r.vertices.count);
+        scene_index_alloc_.free(r.indices.offset, r.indices.count);
+        scene_material_alloc_.free(r.materials.offset, r.materials.count);
+        scene_global_mesh_free_.push_back(r.global_mesh_idx);
+    }
+    scene_retired_.resize(kept);
+}
+
+void ClusterRenderer::resetSceneDb() {
+    for (uint32_t i = 0; i < scene_meshes_.size(); ++i) {
+        if (scene_meshes_[i].in_use) {
+            scene_meshes_[i].in_use = false;
+            scene_mesh_free_.push_back(i);
+        }
+    }
+    // Ranges go away with the allocators; upload staging may still be
+    // read by an in-flight frame, so it keeps aging normally.  Retired
+    // mesh slots past the base are truncated away by the caller.
+    scene_retired_.clear();
+    scene_global_mesh_free_.clear();
+    scene_dirty_clusters_.clear();
+    scene_dirty_vertices_.clear();
+    scene_dirty_indices_.clear();
+    scene_dirty_materials_.clear();
+    scene_dirty_rt_hidden_.clear();
+    // The RT tree is rebuilt by the next finalize; an in-flight build is
+    // dropped when it lands.
+    ++rt_bvh_epoch_;
+    rt_bvh_dirty_ = false;
+    rt_pending_clusters_.clear();
+    rt_pending_vertices_.clear();
+    rt_pending_materials_.clear();
+    scene_db_active_ = false;
+}
+
+void ClusterRenderer::recordSceneUpdates(
+    const std::shared_ptr<renderer::CommandBuffer>& cmd_buf) {
+    ++scene_db_frame_;
+    releaseRetiredSceneRanges(/*force*/ false);
+    if (scene_upload_ring_) {
+        scene_upload_ring_->beginFrame(scene_db_frame_);
+    }
+    if (!gpu_ready_ || !scene_db_active_ || !cmd_buf) return;
+    // Software-RT BVH upkeep rides the same batch.
+    const bool rt_tree = updateRtShadowBvh();
+    if (scene_dirty_clusters_.empty() && scene_dirty_vertices_.empty() &&
+        scene_dirty_indices_.empty() && scene_dirty_materials_.empty() &&
+        scene_dirty_rt_hidden_.empty() && !rt_tree) {
+        return;
+    }
+
+    if (rt_tree) {
+        // Published clusters go up from staging, which already holds the
+        // placeholders of removed ones — folding the hide ranges in keeps
+        // the RT duplicate writes disjoint.
+        rt_publish_clusters_.insert(rt_publish_clusters_.end(),
+                                    scene_dirty_rt_hidden_.begin(),
+                                    scene_dirty_rt_hidden_.end());
+        scene_dirty_rt_hidden_.clear();
+        coalesceSceneRanges(rt_publish_clusters_);
+        coalesceSceneRanges(rt_publish_vertices_);
+        coalesceSceneRanges(rt_publish_materials_);
+    }
+    coalesceSceneRanges(scene_dirty_clusters_);
+    coalesceSceneRanges(scene_dirty_vertices_);
+    coalesceSceneRanges(scene_dirty_indices_);
+    coalesceSceneRanges(scene_dirty_materials_);
+    coalesceSceneRanges(scene_dirty_rt_hidden_);
+
+    // Sources that are not a staging slice: materials go up from the
+    // backup (category bits live there) with VT ids stripped while VT is
+    // off, and the RT duplicates only ever receive placeholders.
+    std::vector<glsl::BindlessMaterialParams> mat_src;
+    for (const SceneRange& r : scene_dirty_materials_) {
+        for (uint32_t k = r.offset; k < r.offset + r.count; ++k) {
+            glsl::BindlessMaterialParams mp =
+                k < material_params_backup_.size()
+                    ? material_params_backup_[k]
+                    : staging_material_params_[k];
+            if (!vt_enabled_) {
+                mp.albedo_vt_id   = kInvalidVtId;
+                mp.normal_vt_id   = kInvalidVtId;
+                mp.mr_ao_vt_id    = kInvalidVtId;
+                mp.emissive_vt_id = kInvalidVtId;
+            }
+            mat_src.push_back(mp);
+        }
+    }
+    const bool rt_dups =
+        rt_cull_infos_buffer_.buffer && rt_draw_infos_buffer_.buffer;
+    uint32_t rt_max = 0;
+    for (const SceneRange& r : scene_dirty_rt_hidden_) {
+        rt_max = std::max(rt_max, r.count);
+    }
+    std::vector<glsl::ClusterCullInfo> rt_cull_src(
+        rt_dups ? rt_max : 0u, sceneDbPlaceholderCull());
+    std::vector<glsl::ClusterDrawInfo> rt_draw_src(
+        rt_dups ? rt_max : 0u, glsl::ClusterDrawInfo{});
+
+    struct Write {
+        std::shared_ptr<renderer::Buffer> dst;
+        uint64_t    dst_offset;
+        uint64_t    size;
+        const void* src;
+    };
+    std::vector<Write> writes;
+    uint64_t total_bytes = 0;
+    auto addWrites = [&](const renderer::BufferInfo& buf,
+                         const std::vector<SceneRange>& ranges,
+                         const void* base, size_t stride, bool base_is_packed) {
+        if (!buf.buffer) return;
+        uint64_t packed = 0;
+        for (const SceneRange& r : ranges) {
+            const uint64_t bytes = uint64_t(r.count) * stride;
+            const uint64_t src_off =
+                base_is_packed ? packed : uint64_t(r.offset) * stride;
+            writes.push_back({ buf.buffer, uint64_t(r.offset) * stride, bytes,
+                               static_cast<const uint8_t*>(base) + src_off });
+            total_bytes += bytes;
+            packed += bytes;
+        }
+    };
+    addWrites(cull_info_buffer_, scene_dirty_clusters_,
+              staging_cull_infos_.data(), sizeof(glsl::ClusterCullInfo), false);
+    addWrites(draw_info_buffer_, scene_dirty_clusters_,
+              staging_draw_infos_.data(), sizeof(glsl::ClusterDrawInfo), false);
+    addWrites(merged_vertex_buffer_, scene_dirty_vertices_,
+              staging_vertices_.data(), sizeof(BindlessVertex), false);
+    addWrites(merged_index_buffer_, scene_dirty_indices_,
+              staging_indices_.data(), sizeof(uint32_t), false);
+    addWrites(material_params_buffer_, scene_dirty_materials_,
+              mat_src.data(), sizeof(glsl::BindlessMaterialParams), true);
+    if (rt_dups) {
+        // Every range reads the same placeholder run from offset 0.
+        for (const SceneRange& r : scene_dirty_rt_hidden_) {
+            const std::vector<SceneRange> one{ r };
+            addWrites(rt_cull_infos_buffer_, one, rt_cull_src.data(),
+                      sizeof(glsl::ClusterCullInfo), true);
+            addWrites(rt_draw_infos_buffer_, one, rt_draw_src.data(),
+                      sizeof(glsl::ClusterDrawInfo), true);
+        }
+    }
+    std::vector<glm::vec4> rt_pos_src;
+    if (rt_tree && rt_dups) {
+        // The new / refit tree plus the duplicate data of every cluster it
+        // newly references, in one batch: the trace never sees a tree
+        // pointing at clusters its buffers do not hold yet.
+        addWrites(rt_cull_infos_buffer_, rt_publish_clusters_,
+                  staging_cull_infos_.data(), sizeof(glsl::ClusterCullInfo),
+                  false);
+        addWrites(rt_draw_infos_buffer_, rt_publish_clusters_,
+                  staging_draw_infos_.data(), sizeof(glsl::ClusterDrawInfo),
+                  false);
+        addWrites(rt_materials_buffer_, rt_publish_materials_,
+                  staging_material_params_.data(),
+                  sizeof(glsl::BindlessMaterialParams), false);
+        for (const SceneRange& r : rt_publish_vertices_) {
+            for (uint32_t k = r.offset; k < r.offset + r.count; ++k) {
+                const BindlessVertex& v = staging_vertices_[k];
+                rt_pos_src.emplace_back(v.position,
+                                        glm::uintBitsToFloat(v.packed_uv));
+            }
+        }
+        addWrites(rt_pos_uv_buffer_, rt_publish_vertices_, rt_pos_src.data(),
+                  sizeof(glm::vec4), true);
+        const std::vector<SceneRange> node_range{
+            { 0u, static_cast<uint32_t>(rt_bvh_cpu_.nodes.size()) } };
+        addWrites(rt_bvh_nodes_buffer_, node_range, rt_bvh_cpu_.nodes.data(),
+                  sizeof(RtClusterBvhNode), false);
+        if (!rt_bvh_cpu_.leaf_indices.empty()) {
+            const std::vector<SceneRange> leaf_range{
+                { 0u, static_cast<uint32_t>(rt_bvh_cpu_.leaf_indices.size()) } };
+            addWrites(rt_bvh_leaves_buffer_, leaf_range,
+                      rt_bvh_cpu_.leaf_indices.data(), sizeof(uint32_t), false);
+        }
+    }
+
+    scene_dirty_clusters_.clear();
+    scene_dirty_vertices_.clear();
+    scene_dirty_indices_.clear();
+    scene_dirty_materials_.clear();
+    scene_dirty_rt_hidden_.clear();
+    scene_db_last_upload_bytes_ = total_bytes;
+    if (writes.empty()) return;
+
+    // Earlier frames on this queue may still read the ranges' previous
+    // contents (a recycled range) — order the transfer after them, and
+    // every later read after the transfer.
+    std::vector<std::shared_ptr<renderer::Buffer>> touched;
+    for (const Write& w : writes) {
+        if (std::find(touched.begin(), touched.end(), w.dst) == touched.end()) {
+            touched.push_back(w.dst);
+        }
+    }
+    const er::BufferResourceInfo any_read{
+        SET_FLAG_BIT(Access, MEMORY_READ_BIT),
+        SET_FLAG_BIT(PipelineStage, ALL_COMMANDS_BIT) };
+    const er::BufferResourceInfo xfer_write{
+        SET_FLAG_BIT(Access, TRANSFER_WRITE_BIT),
+        SET_FLAG_BIT(PipelineStage, TRANSFER_BIT) };
+    for (const auto& buf : touched) {
+        cmd_buf->addBufferBarrier(buf, any_read, xfer_write);
+    }
+
+    if (total_bytes <= kSceneDbInlineBytes) {
+        // A placed prop: a few KB recorded straight into the command
+        // buffer, no staging memory at all.
+        for (const Write& w : writes) {
+            for (uint64_t done = 0; done < w.size;
+                 done += kSceneDbUpdateChunk) {
+                const uint64_t n = std::min(kSceneDbUpdateChunk, w.size - done);
+                cmd_buf->updateBuffer(w.dst, w.dst_offset + done, n,
+                                      static_cast<const uint8_t*>(w.src) + done);
+            }
+        }
+    } else {
+        // Larger objects: pack every range into the persistently mapped
+        // staging ring and copy out of it; the bytes ride the same
+        // frame-delayed retirement as freed ranges.
+        if (!scene_upload_ring_) {
+            scene_upload_ring_ = std::make_unique<renderer::FrameUploadRing>(
+                kSceneDbUploadRingBytes, kSceneDbRetireFrames);
+            scene_upload_ring_->beginFrame(scene_db_frame_);
+        }
+        std::shared_ptr<renderer::Buffer> staging;
+        uint64_t staging_off = 0;
+        uint8_t* packed = scene_upload_ring_->allocate(
+            device_, total_bytes, 16, staging, staging_off);
+        uint64_t src_off = 0;
+        for (const auto& buf : touched) {
+            std::vector<er::BufferCopyInfo> regions;
+            for (const Write& w : writes) {
+                if (w.dst != buf) continue;
+                std::memcpy(packed + src_off, w.src, w.size);
+                regions.push_back({ staging_off + src_off, w.dst_offset, w.size });
+                src_off += w.size;
+            }
+            cmd_buf->copyBuffer(staging, buf, regions);
+        }
+    }
+
+    for (const auto& buf : touched) {
+        cmd_buf->addBufferBarrier(buf, xfer_write, any_read);
+    }
+}
+
+ClusterRenderer::SceneDbStats ClusterRenderer::sceneDbStats() const {
+    SceneDbStats s;
+    for (const auto& m : scene_meshes_) s.live_meshes += m.in_use ? 1u : 0u;
+    s.cluster_capacity   = scene_cluster_alloc_.capacity();
+    s.cluster_free       = scene_cluster_alloc_.freeCount();
+    s.vertex_capacity    = scene_vertex_alloc_.capacity();
+    s.vertex_free        = scene_vertex_alloc_.freeCount();
+    s.index_capacity     = scene_index_alloc_.capacity();
+    s.index_free         = scene_index_alloc_.freeCount();
+    s.material_capacity  = scene_material_alloc_.capacity();
+    s.material_free      = scene_material_alloc_.freeCount();
+    s.live_adds          = scene_db_live_adds_;
+    s.fallback_finalizes = scene_db_fallback_finalizes_;
+    s.last_upload_bytes  = scene_db_last_upload_bytes_;
+    return s;
+}
+
 // ─── setMeshClustersHidden ─────────────────────────────────────────────────
 // Poison / restore one mesh's cluster bounding spheres in the HOST_VISIBLE
 // cull-info buffer.  See header doc.
@@ -4843,13 +5522,14 @@ void ClusterRenderer::recreate(
 // ─── Destroy ──────────────────────────────────────────────────────────────
 
 // ─── Software-RT shadow BVH (world-space raytraced shadows) ──────────────
-// Median-split binary BVH over every cluster's bounding-sphere AABB.
-// Leaves hold ≤ kRtBvhLeafSize cluster indices.  Children of an inner node
+// Binary BVH over every cluster's bounding-sphere AABB (binned SAH, leaves
+// of at most 4 clusters — rt_cluster_bvh.h).  Children of an inner node
 // are allocated ADJACENTLY (right = left + 1) so a node only stores the
-// left index.  Built single-threaded on the CPU from staging_cull_infos_
-// (a few hundred ms worst case for Bistro-scale cluster counts — runs
-// inside finalizeUploads, which is already a load-time hitch) and uploaded
-// as SSBOs for deferred_resolve.comp's per-pixel traversal.
+// left index.  finalizeUploads builds it from staging_cull_infos_ with the
+// fast median split, serially on the render thread, and uploads it as SSBOs
+// for deferred_resolve.comp's per-pixel traversal; the binned-SAH tree is
+// then built in the background and swapped in, like the rebuilds after
+// live edits (updateRtShadowBvh).
 //
 // DEVICE_LOCAL is non-negotiable for every buffer the trace touches: a
 // per-pixel traversal reading host memory over PCIe is a 10-100× slowdown.
@@ -4906,93 +5586,67 @@ static void ensureDeviceSSBO(const std::shared_ptr<er::Device>& device,
     info = createDeviceSSBO(device, size, data, as_input);
 }
 
+static_assert(sizeof(glsl::RtBvhNode) == sizeof(RtClusterBvhNode),
+              "RtClusterBvhNode mirrors glsl::RtBvhNode");
+
+// Snapshot of the first `n` cluster bounding spheres for the BVH builders.
+static std::vector<RtClusterSphere> rtClusterSpheres(
+    const std::vector<glsl::ClusterCullInfo>& cull_infos, uint32_t n) {
+    std::vector<RtClusterSphere> spheres(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        const glm::vec4& b = cull_infos[i].bounds_sphere;
+        spheres[i] = { b.x, b.y, b.z, b.w };
+    }
+    return spheres;
+}
+
+static RtClusterBvhBuilder rtBvhBuilder(bool median) {
+    return median ? RtClusterBvhBuilder::kMedian
+                  : RtClusterBvhBuilder::kBinnedSah;
+}
+
 void ClusterRenderer::buildRtShadowBvh() {
     rt_shadow_ready_ = false;
+    // Whatever a background build is still working on predates this
+    // layout; it is dropped when it lands.
+    ++rt_bvh_epoch_;
+    rt_bvh_dirty_ = false;
+    rt_pending_clusters_.clear();
+    rt_pending_vertices_.clear();
+    rt_pending_materials_.clear();
     if (staging_cull_infos_.empty() || total_clusters_all_meshes_ == 0) {
         return;
     }
     const auto t0 = std::chrono::steady_clock::now();
-    constexpr uint32_t kRtBvhLeafSize = 4u;
 
     const uint32_t n =
         std::min<uint32_t>(total_clusters_all_meshes_,
                            (uint32_t)staging_cull_infos_.size());
 
-    // Per-cluster AABB (sphere-derived) + centroid.
-    struct Prim { glm::vec3 mn, mx, c; uint32_t idx; };
-    std::vector<Prim> prims(n);
-    for (uint32_t i = 0; i < n; ++i) {
-        const glm::vec4 s = staging_cull_infos_[i].bounds_sphere;
-        const glm::vec3 ctr(s.x, s.y, s.z);
-        const glm::vec3 ext(s.w);
-        prims[i] = { ctr - ext, ctr + ext, ctr, i };
-    }
-
-    std::vector<glsl::RtBvhNode> nodes;
-    nodes.reserve(2 * (size_t)n);
-    std::vector<uint32_t> leaf_indices;
-    leaf_indices.reserve(n);
-
-    // Explicit stack: (node index, prim range) — children pre-allocated
-    // adjacently before pushing so left_first is final at pop time.
-    struct Item { uint32_t node; uint32_t first, count; };
-    std::vector<Item> stack;
-    nodes.push_back({});
-    stack.push_back({0u, 0u, n});
-
-    while (!stack.empty()) {
-        const Item it = stack.back();
-        stack.pop_back();
-
-        glm::vec3 mn(std::numeric_limits<float>::max());
-        glm::vec3 mx(std::numeric_limits<float>::lowest());
-        for (uint32_t i = 0; i < it.count; ++i) {
-            mn = glm::min(mn, prims[it.first + i].mn);
-            mx = glm::max(mx, prims[it.first + i].mx);
-        }
-        glsl::RtBvhNode& node = nodes[it.node];
-        node.aabb_min = mn;
-        node.aabb_max = mx;
-
-        if (it.count <= kRtBvhLeafSize) {
-            node.left_first = (uint32_t)leaf_indices.size();
-            node.prim_count = it.count;
-            for (uint32_t i = 0; i < it.count; ++i) {
-                leaf_indices.push_back(prims[it.first + i].idx);
-            }
-            continue;
-        }
-
-        // Median split on the widest centroid axis.
-        glm::vec3 cmin(std::numeric_limits<float>::max());
-        glm::vec3 cmax(std::numeric_limits<float>::lowest());
-        for (uint32_t i = 0; i < it.count; ++i) {
-            cmin = glm::min(cmin, prims[it.first + i].c);
-            cmax = glm::max(cmax, prims[it.first + i].c);
-        }
-        const glm::vec3 cext = cmax - cmin;
-        const int axis = (cext.x > cext.y)
-                             ? (cext.x > cext.z ? 0 : 2)
-                             : (cext.y > cext.z ? 1 : 2);
-        const uint32_t half = it.count / 2u;
-        std::nth_element(
-            prims.begin() + it.first,
-            prims.begin() + it.first + half,
-            prims.begin() + it.first + it.count,
-            [axis](const Prim& a, const Prim& b) {
-                return a.c[axis] < b.c[axis];
-            });
-
-        const uint32_t left = (uint32_t)nodes.size();
-        nodes.push_back({});
-        nodes.push_back({});
-        nodes[it.node].left_first = left;
-        nodes[it.node].prim_count = 0u;
-        stack.push_back({left,      it.first,        half});
-        stack.push_back({left + 1u, it.first + half, it.count - half});
-    }
-
-    rt_bvh_node_count_    = (uint32_t)nodes.size();
+    // This build is part of the finalize hitch, so it is the median split
+    // (about a third of the binned-SAH time, and needs no workers); the
+    // SAH tree follows from the background job and the median one serves
+    // until the swap.
+    rt_bvh_cpu_ = buildRtClusterBvh(rtClusterSpheres(staging_cull_infos_, n),
+                                    RtClusterBvhBuilder::kMedian);
+    rt_bvh_sah_upgrade_ = !rt_bvh_median_builder_;
+    const double bvh_ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    rt_bvh_built_sah_ = rt_bvh_cpu_.sah_cost;
+    rt_bvh_build_ms_  = bvh_ms;
+    ++rt_bvh_full_builds_;
+
+    // Worst case over the whole cluster capacity (placeholders included),
+    // so refits and background rebuilds write in place.  Padding nodes are
+    // never reached from the root.
+    std::vector<glsl::RtBvhNode> nodes(2 * (size_t)n - 1);
+    std::memcpy(nodes.data(), rt_bvh_cpu_.nodes.data(),
+                rt_bvh_cpu_.nodes.size() * sizeof(glsl::RtBvhNode));
+    std::vector<uint32_t> leaf_indices(n, 0u);
+    std::copy(rt_bvh_cpu_.leaf_indices.begin(),
+              rt_bvh_cpu_.leaf_indices.end(), leaf_indices.begin());
+
+    rt_bvh_node_count_    = (uint32_t)rt_bvh_cpu_.nodes.size();
     ensureDeviceSSBO(device_, rt_bvh_nodes_buffer_,
                      nodes.size() * sizeof(glsl::RtBvhNode), nodes.data());
     ensureDeviceSSBO(device_, rt_bvh_leaves_buffer_,
@@ -5174,9 +5828,12 @@ void ClusterRenderer::buildRtShadowBvh() {
     const double ms = std::chrono::duration<double, std::milli>(
         std::chrono::steady_clock::now() - t0).count();
     clog_printf(
-        "[CLUSTER_RENDERER] RT shadow BVH: %u clusters -> %u nodes, "
-        "%zu leaf refs (%.1f ms build, %.1f MB)\n",
-        n, rt_bvh_node_count_, leaf_indices.size(), ms,
+        "[CLUSTER_RENDERER] RT shadow BVH (median%s): %u clusters -> %u "
+        "nodes, %zu leaf refs, SAH cost %.1f (%.1f ms build, %.1f ms total, "
+        "%.1f MB)\n",
+        rt_bvh_sah_upgrade_ ? ", binned SAH to follow" : "",
+        rt_bvh_cpu_.live_count, rt_bvh_node_count_,
+        rt_bvh_cpu_.leaf_indices.size(), rt_bvh_cpu_.sah_cost, bvh_ms, ms,
         (nodes.size() * sizeof(glsl::RtBvhNode) +
          leaf_indices.size() * 4.0) / (1024.0 * 1024.0));
 
@@ -5184,6 +5841,154 @@ void ClusterRenderer::buildRtShadowBvh() {
     buildHwRtShadowAs();
 }
 
+// ─── Software-RT shadow BVH: live-edit upkeep ──────────────────────────────
+// See the member-block comment in cluster_renderer.h.  Render thread only;
+// the background build touches nothing but its own RtBvhJob.
+
+// A refit whose SAH cost grows past this factor of the built cost queues a
+// rebuild — moved objects stretch boxes the old splits never planned for.
+static constexpr float kRtBvhRefitDegrade = 1.5f;
+
+// One background rebuild.  Owns its snapshot and thread; the destructor
+// joins, so dropping a job that is still running blocks until it finishes.
+struct ClusterRenderer::RtBvhJob {
+    std::vector<RtClusterSphere>        spheres;
+    RtClusterBvhBuilder                 builder = RtClusterBvhBuilder::kBinnedSah;
+    std::shared_ptr<helper::ThreadPool> pool;
+    uint64_t                            epoch = 0;
+    // Live-placed ranges the snapshot covers — published with the tree.
+    std::vector<SceneRange>             clusters, vertices, materials;
+    RtClusterBvh                        result;
+    double                              build_ms = 0.0;
+    std::atomic<bool>                   done{false};
+    std::thread                         thread;
+
+    ~RtBvhJob() {
+        if (thread.joinable()) thread.join();
+    }
+};
+
+void ClusterRenderer::startRtShadowBvhJob() {
+    const uint32_t n =
+        std::min<uint32_t>(total_clusters_all_meshes_,
+                           (uint32_t)staging_cull_infos_.size());
+    // Two workers: a rebuild is allowed to take a few frames, and must
+    // not contend with the per-frame work on rt_cpu_pool_.
+    if (!rt_bvh_pool_) rt_bvh_pool_ = std::make_shared<helper::ThreadPool>(2);
+    auto job = std::make_shared<RtBvhJob>();
+    job->spheres   = rtClusterSpheres(staging_cull_infos_, n);
+    job->builder   = rtBvhBuilder(rt_bvh_median_builder_);
+    job->pool      = rt_bvh_pool_;
+    job->epoch     = rt_bvh_epoch_;
+    job->clusters  = std::move(rt_pending_clusters_);
+    job->vertices  = std::move(rt_pending_vertices_);
+    job->materials = std::move(rt_pending_materials_);
+    rt_pending_clusters_.clear();
+    rt_pending_vertices_.clear();
+    rt_pending_materials_.clear();
+
+    RtBvhJob* j = job.get();
+    job->thread = std::thread([j]() {
+        const auto t0 = std::chrono::steady_clock::now();
+        j->result = buildRtClusterBvh(j->spheres, j->builder, j->pool.get());
+        j->build_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+        j->done.store(true, std::memory_order_release);
+    });
+    rt_bvh_job_ = std::move(job);
+    rt_bvh_dirty_ = false;
+    // Built with the selected builder from the current scene: covers a
+    // pending upgrade of the finalize-time median tree too.
+    rt_bvh_sah_upgrade_ = false;
+}
+
+bool ClusterRenderer::updateRtShadowBvh() {
+    rt_publish_clusters_.clear();
+    rt_publish_vertices_.clear();
+    rt_publish_materials_.clear();
+    if (!rt_shadow_ready_) return false;
+    const uint32_t n =
+        std::min<uint32_t>(total_clusters_all_meshes_,
+                           (uint32_t)staging_cull_infos_.size());
+    bool changed = false;
+
+    // ── 1. A finished background build replaces the tree ──────────────
+    if (rt_bvh_job_ && rt_bvh_job_->done.load(std::memory_order_acquire)) {
+        std::shared_ptr<RtBvhJob> job = std::move(rt_bvh_job_);
+        // Same epoch = same cluster capacity, so it fits the buffers.
+        if (job->epoch == rt_bvh_epoch_ && job->result.sphere_count == n) {
+            rt_bvh_cpu_       = std::move(job->result);
+            rt_bvh_built_sah_ = rt_bvh_cpu_.sah_cost;
+            rt_bvh_build_ms_  = job->build_ms;
+            rt_bvh_node_count_ = (uint32_t)rt_bvh_cpu_.nodes.size();
+            ++rt_bvh_background_builds_;
+            rt_publish_clusters_  = std::move(job->clusters);
+            rt_publish_vertices_  = std::move(job->vertices);
+            rt_publish_materials_ = std::move(job->materials);
+            changed = true;
+            clog_printf(
+                "[CLUSTER_RENDERER] RT shadow BVH swapped in: %u clusters "
+                "-> %u nodes, SAH cost %.1f (%.1f ms off-thread)\n",
+                rt_bvh_cpu_.live_count, rt_bvh_node_count_,
+                rt_bvh_cpu_.sah_cost, job->build_ms);
+        }
+    }
+
+    // ── 2. Edits since the last build: refit, or rebuild in the background
+    // While a build is in flight, edits wait for it (removals are already
+    // hidden through the RT duplicates) and are checked against its tree.
+    if (rt_bvh_dirty_ && !rt_bvh_job_) {
+        const auto t0 = std::chrono::steady_clock::now();
+        if (refitRtClusterBvh(rt_bvh_cpu_,
+                              rtClusterSpheres(staging_cull_infos_, n))) {
+            rt_bvh_refit_ms_ = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - t0).count();
+            ++rt_bvh_refits_;
+            auto append = [](std::vector<SceneRange>& dst,
+                             std::vector<SceneRange>& src) {
+                dst.insert(dst.end(), src.begin(), src.end());
+                src.clear();
+            };
+            append(rt_publish_clusters_,  rt_pending_clusters_);
+            append(rt_publish_vertices_,  rt_pending_vertices_);
+            append(rt_publish_materials_, rt_pending_materials_);
+            rt_bvh_dirty_ = false;
+            changed = true;
+            if (rt_bvh_cpu_.sah_cost > kRtBvhRefitDegrade * rt_bvh_built_sah_) {
+                startRtShadowBvhJob();
+            }
+        } else {
+            // New occupied slots: the tree's topology no longer covers the
+            // scene.  The current tree keeps serving until the swap.
+            startRtShadowBvhJob();
+        }
+    }
+
+    // ── 3. The finalize-time median tree still awaits its SAH rebuild ──
+    // Started here rather than in buildRtShadowBvh so a job left over from
+    // before the finalize is never joined on the render thread.
+    if (rt_bvh_sah_upgrade_ && !rt_bvh_job_) {
+        startRtShadowBvhJob();
+    }
+    return changed;
+}
+
+ClusterRenderer::RtShadowBvhStats ClusterRenderer::rtShadowBvhStats() const {
+    RtShadowBvhStats s;
+    s.clusters          = rt_bvh_cpu_.live_count;
+    s.nodes             = (uint32_t)rt_bvh_cpu_.nodes.size();
+    s.leaf_refs         = (uint32_t)rt_bvh_cpu_.leaf_indices.size();
+    s.sah_cost          = rt_bvh_cpu_.sah_cost;
+    s.built_sah_cost    = rt_bvh_built_sah_;
+    s.build_ms          = rt_bvh_build_ms_;
+    s.refit_ms          = rt_bvh_refit_ms_;
+    s.full_builds       = rt_bvh_full_builds_;
+    s.background_builds = rt_bvh_background_builds_;
+    s.refits            = rt_bvh_refits_;
+    s.building          = rt_bvh_job_ != nullptr;
+    return s;
+}
+
 // ─── Hardware-RT shadow acceleration structure ────────────────────────────
 // See the member-block comment in cluster_renderer.h.  Mirrors the AS-build
 // sequence of ray_tracing/raytracing_shadow.cpp, but over the merged cluster
@@ -5622,6 +6427,79 @@ void ClusterRenderer::flushRetiredBuffers(bool force) {
     retired_as_.resize(kept);
 }
 
+namespace {
+
+// Bone palette width: top three rows of an affine 4x4 (the bottom row
+// of every skin transform is (0,0,0,1)), row-major.
+constexpr uint32_t kSkinRowFloats = 12;
+
+// palette = [model * jm[0], ..., model * jm[n-1], model], 12 floats each.
+// Folding the model matrix into the palette saves a mat4 x vec4 per
+// vertex; since skinning is linear in the blended matrix the result is
+// identical to model * (blend / wsum) * p.
+void buildSkinPalette(const glm::mat4& model,
+                      const std::vector<glm::mat4>& jm,
+                      std::vector<float>& palette) {
+    palette.resize((jm.size() + 1) * kSkinRowFloats);
+    float* out = palette.data();
+    auto put = [&out](const glm::mat4& m) {
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 4; ++c) *out++ = m[c][r];
+        }
+    };
+    for (const auto& j : jm) put(model * j);
+    put(model);
+}
+
+// Skin vertices [v0, v1) with kBones influences each (4 = JOINTS_0 only,
+// 8 = JOINTS_0 + JOINTS_1).  The bone loop is a fixed-width 12-float
+// multiply-add over the palette row, with no branches and no mat4
+// temporaries, which the compiler unrolls and vectorises (SSE/AVX/NEON,
+// whatever the target has).  Matches base.vert: weights normalised by
+// their sum, identity skin for unweighted vertices.
+template <int kBones>
+void skinVertexRange(const float* palette, uint32_t joint_count,
+                     const glm::vec3* positions,
+                     const glm::u16vec4* joints0, const glm::vec4* weights0,
+                     const glm::u16vec4* joints1, const glm::vec4* weights1,
+                     size_t v0, size_t v1, glm::vec4* out) {
+    const uint32_t last = joint_count - 1u;
+    const float* model_row = palette + size_t(joint_count) * kSkinRowFloats;
+    for (size_t v = v0; v < v1; ++v) {
+        uint32_t idx[kBones];
+        float    wt[kBones];
+        for (int b = 0; b < 4; ++b) {
+            idx[b] = std::min<uint32_t>(joints0[v][b], last);
+            wt[b]  = weights0[v][b];
+        }
+        if constexpr (kBones == 8) {
+            for (int b = 0; b < 4; ++b) {
+                idx[4 + b] = std::min<uint32_t>(joints1[v][b], last);
+                wt[4 + b]  = weights1[v][b];
+            }
+        }
+        float acc[kSkinRowFloats] = {};
+        float wsum = 0.0f;
+        for (int b = 0; b < kBones; ++b) {
+            const float* row = palette + size_t(idx[b]) * kSkinRowFloats;
+            for (uint32_t k = 0; k < kSkinRowFloats; ++k) acc[k] += wt[b] * row[k];
+            wsum += wt[b];
+        }
+        const float* m = acc;
+        float scale = 1.0f;
+        if (wsum > 1e-4f) scale = 1.0f / wsum;
+        else              m = model_row;
+        const glm::vec3& p = positions[v];
+        out[v] = glm::vec4(
+            (m[0] * p.x + m[1] * p.y + m[2]  * p.z + m[3])  * scale,
+            (m[4] * p.x + m[5] * p.y + m[6]  * p.z + m[7])  * scale,
+            (m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11]) * scale,
+            1.0f);
+    }
+}
+
+} // namespace
+
 void ClusterRenderer::updateRtSkeletons(
     const std::shared_ptr<renderer::CommandBuffer>& cmd_buf,
     const std::vector<RtSkeletonFrameData>& skeletons) {
@@ -5633,55 +6511,11 @@ void ClusterRenderer::updateRtSkeletons(
     // Age out buffers retired on previous ticks (grow paths below).
     flushRetiredBuffers();
 
-    // ── 0. Change detection ───────────────────────────────────────────
-    // Pose = model matrix + joint matrices.  If every skeleton's pose
-    // is bytewise identical to the previous update, all GPU state
-    // (positions, chunks, headers, BLAS, TLAS) is still valid — skip
-    // the whole update.  Frees idle characters (and the editor at
-    // rest) from the ~7 ms skinning bill.
-    {
-        static const std::vector<glm::mat4> s_empty_jm;
-        bool same = rt_skel_have_gpu_state_ &&
-                    rt_skel_cache_.size() == skeletons.size();
-        if (same) {
-            for (size_t i = 0; i < skeletons.size(); ++i) {
-                const auto& jm = skeletons[i].joint_matrices
-                                     ? *skeletons[i].joint_matrices
-                                     : s_empty_jm;
-                const auto& c = rt_skel_cache_[i];
-                if (skeletons[i].model != c.model ||
-                    jm.size() != c.jm.size() ||
-                    (!jm.empty() &&
-                     std::memcmp(jm.data(), c.jm.data(),
-                                 jm.size() * sizeof(glm::mat4)) != 0)) {
-                    same = false;
-                    break;
-                }
-            }
-        }
-        if (same) return;
-        rt_skel_cache_.resize(skeletons.size());
-        for (size_t i = 0; i < skeletons.size(); ++i) {
-            rt_skel_cache_[i].model = skeletons[i].model;
-            rt_skel_cache_[i].jm    = skeletons[i].joint_matrices
-                                          ? *skeletons[i].joint_matrices
-                                          : s_empty_jm;
-        }
-    }
-
-    // Fixed worker pool for the skinning burst — created once, sized to
-    // hardware_concurrency.  parallelFor is only ever entered from the
-    // render thread, so the "no re-entry from workers" rule holds.
-    static helper::ThreadPool s_skel_pool;
-
-    // ── 1. CPU-skin every skeleton into world space ───────────────────
-    std::vector<glm::vec4>          all_pos;
-    std::vector<uint32_t>           all_idx;
-    std::vector<glm::vec4>          all_chunks;   // min,max pairs
-    std::vector<glsl::RtSkelHeader> headers;
-
-    for (const auto& s : skeletons) {
-        if (headers.size() >= RT_SKEL_MAX) break;
+    // ── 0. Accept + layout check ──────────────────────────────────────
+    rt_skel_accept_.clear();
+    for (uint32_t i = 0; i < (uint32_t)skeletons.size(); ++i) {
+        if (rt_skel_accept_.size() >= RT_SKEL_MAX) break;
+        const auto& s = skeletons[i];
         if (!s.positions || !s.joints || !s.weights || !s.indices ||
             !s.joint_matrices || s.joint_matrices->empty() ||
             s.positions->empty() || s.indices->size() < 3 ||
@@ -5689,98 +6523,171 @@ void ClusterRenderer::updateRtSkeletons(
             s.weights->size() != s.positions->size()) {
             continue;
         }
+        rt_skel_accept_.push_back(i);
+    }
+    auto hasSet1 = [](const RtSkeletonFrameData& s) {
+        return s.joints1 && s.weights1 &&
+               s.joints1->size() == s.positions->size() &&
+               s.weights1->size() == s.positions->size();
+    };
+    bool relayout = !rt_skel_have_gpu_state_ ||
+                    rt_skel_slots_.size() != rt_skel_accept_.size();
+    for (size_t k = 0; !relayout && k < rt_skel_accept_.size(); ++k) {
+        const auto& s = skeletons[rt_skel_accept_[k]];
+        const auto& slot = rt_skel_slots_[k];
+        relayout = slot.positions != s.positions ||
+                   slot.indices != s.indices ||
+                   slot.pos_data != s.positions->data() ||
+                   slot.idx_data != s.indices->data() ||
+                   slot.vcount != (uint32_t)s.positions->size() ||
+                   slot.header.tri_count != (uint32_t)(s.indices->size() / 3u) ||
+                   slot.two_sets != hasSet1(s);
+    }
+
+    // ── 1. Per-skeleton change detection ──────────────────────────────
+    // Pose = model matrix + joint matrices, bytewise.  A clean skeleton
+    // keeps its range in every buffer untouched.
+    uint32_t dirty_count = 0;
+    if (relayout) rt_skel_slots_.resize(rt_skel_accept_.size());
+    for (size_t k = 0; k < rt_skel_accept_.size(); ++k) {
+        const auto& s = skeletons[rt_skel_accept_[k]];
+        auto& slot = rt_skel_slots_[k];
         const auto& jm = *s.joint_matrices;
-        const uint32_t jm_n = (uint32_t)jm.size();
-        const uint32_t vbase = (uint32_t)all_pos.size();
-        const bool has_set1 =
-            s.joints1 && s.weights1 &&
-            s.joints1->size() == s.positions->size() &&
-            s.weights1->size() == s.positions->size();
-
-        const size_t vcount = s.positions->size();
-        all_pos.resize(vbase + vcount);
-        // Parallel skinning: block-granular (1024 verts per task) so the
-        // per-invocation std::function overhead amortises to nothing.
-        // Each block writes a disjoint all_pos range — no sharing.
-        const size_t kVertBlock = 1024;
-        const size_t nblocks = (vcount + kVertBlock - 1) / kVertBlock;
-        s_skel_pool.parallelFor(nblocks, [&](size_t b) {
-            const size_t v0 = b * kVertBlock;
-            const size_t v1 = std::min(v0 + kVertBlock, vcount);
-            for (size_t v = v0; v < v1; ++v) {
-                const glm::u16vec4& j0 = (*s.joints)[v];
-                const glm::vec4&    w0 = (*s.weights)[v];
-                glm::mat4 skin =
-                    w0.x * jm[std::min((uint32_t)j0.x, jm_n - 1u)] +
-                    w0.y * jm[std::min((uint32_t)j0.y, jm_n - 1u)] +
-                    w0.z * jm[std::min((uint32_t)j0.z, jm_n - 1u)] +
-                    w0.w * jm[std::min((uint32_t)j0.w, jm_n - 1u)];
-                float wsum = w0.x + w0.y + w0.z + w0.w;
-                if (has_set1) {
-                    const glm::u16vec4& j1 = (*s.joints1)[v];
-                    const glm::vec4&    w1 = (*s.weights1)[v];
-                    skin += w1.x * jm[std::min((uint32_t)j1.x, jm_n - 1u)] +
-                            w1.y * jm[std::min((uint32_t)j1.y, jm_n - 1u)] +
-                            w1.z * jm[std::min((uint32_t)j1.z, jm_n - 1u)] +
-                            w1.w * jm[std::min((uint32_t)j1.w, jm_n - 1u)];
-                    wsum += w1.x + w1.y + w1.z + w1.w;
-                }
-                // Match base.vert: normalize by the weight sum; identity
-                // for unweighted verts.
-                if (wsum > 1e-4f) skin *= (1.0f / wsum);
-                else              skin  = glm::mat4(1.0f);
-                const glm::vec4 wp =
-                    s.model * (skin * glm::vec4((*s.positions)[v], 1.0f));
-                all_pos[vbase + v] = glm::vec4(glm::vec3(wp), 1.0f);
+        slot.dirty = relayout || s.model != slot.model ||
+                     jm.size() != slot.jm.size() ||
+                     std::memcmp(jm.data(), slot.jm.data(),
+                                 jm.size() * sizeof(glm::mat4)) != 0;
+        if (!slot.dirty) continue;
+        ++dirty_count;
+        slot.model = s.model;
+        slot.jm.assign(jm.begin(), jm.end());
+        buildSkinPalette(slot.model, slot.jm, slot.palette);
+    }
+    if (!relayout && dirty_count == 0) return;
+
+    // ── 2. Relayout: assign persistent ranges, rebuild the index table ─
+    if (relayout) {
+        uint32_t vtotal = 0, ttotal = 0, ctotal = 0;
+        for (size_t k = 0; k < rt_skel_accept_.size(); ++k) {
+            const auto& s = skeletons[rt_skel_accept_[k]];
+            auto& slot = rt_skel_slots_[k];
+            slot.positions = s.positions;
+            slot.indices   = s.indices;
+            slot.pos_data  = s.positions->data();
+            slot.idx_data  = s.indices->data();
+            slot.two_sets  = hasSet1(s);
+            slot.vbase     = vtotal;
+            slot.vcount    = (uint32_t)s.positions->size();
+            slot.header.tri_offset   = ttotal;
+            slot.header.tri_count    = (uint32_t)(s.indices->size() / 3u);
+            slot.header.chunk_offset = ctotal;
+            slot.cbase  = ctotal;
+            slot.ccount = (slot.header.tri_count + RT_SKEL_CHUNK_TRIS - 1u) /
+                          RT_SKEL_CHUNK_TRIS;
+            vtotal += slot.vcount;
+            ttotal += slot.header.tri_count;
+            ctotal += slot.ccount;
+        }
+        rt_skel_pos_cpu_.resize(vtotal);
+        rt_skel_chunk_cpu_.resize(size_t(ctotal) * 2u);
+        rt_skel_idx_cpu_.resize(size_t(ttotal) * 3u);
+        for (const auto& slot : rt_skel_slots_) {
+            uint32_t* dst = rt_skel_idx_cpu_.data() +
+                            size_t(slot.header.tri_offset) * 3u;
+            const uint32_t n = slot.header.tri_count * 3u;
+            for (uint32_t i = 0; i < n; ++i) {
+                dst[i] = std::min(slot.idx_data[i], slot.vcount - 1u) +
+                         slot.vbase;
             }
-        });
-
-        glsl::RtSkelHeader h{};
-        h.tri_offset   = (uint32_t)(all_idx.size() / 3u);
-        h.tri_count    = (uint32_t)(s.indices->size() / 3u);
-        h.chunk_offset = (uint32_t)(all_chunks.size() / 2u);
-        all_idx.reserve(all_idx.size() + s.indices->size());
-        for (uint32_t idx : *s.indices) {
-            all_idx.push_back(std::min(idx, (uint32_t)s.positions->size() - 1u)
-                              + vbase);
         }
+    }
+
+    // Skinning workers — created once, sized to hardware_concurrency.
+    // parallelFor is only ever entered from the render thread, so the
+    // "no re-entry from workers" rule holds.
+    if (!rt_cpu_pool_) rt_cpu_pool_ = std::make_shared<helper::ThreadPool>();
+
+    // ── 3. CPU-skin the dirty skeletons into world space ──────────────
+    // One parallel burst over every dirty skeleton: block-granular
+    // (1024 verts per item) so the per-invocation std::function cost
+    // amortises to nothing.  Items write disjoint rt_skel_pos_cpu_
+    // ranges — no sharing.
+    const uint32_t kVertBlock = 1024;
+    rt_skel_jobs_.clear();
+    for (uint32_t k = 0; k < (uint32_t)rt_skel_slots_.size(); ++k) {
+        const auto& slot = rt_skel_slots_[k];
+        if (!slot.dirty) continue;
+        for (uint32_t v = 0; v < slot.vcount; v += kVertBlock)
+            rt_skel_jobs_.emplace_back(k, v);
+    }
+    rt_cpu_pool_->parallelFor(rt_skel_jobs_.size(), [&](size_t j) {
+        const auto [k, v0] = rt_skel_jobs_[j];
+        const auto& slot = rt_skel_slots_[k];
+        const auto& s = skeletons[rt_skel_accept_[k]];
+        const uint32_t v1 = std::min(v0 + kVertBlock, slot.vcount);
+        glm::vec4* out = rt_skel_pos_cpu_.data() + slot.vbase;
+        const uint32_t joint_count = (uint32_t)slot.jm.size();
+        if (slot.two_sets) {
+            skinVertexRange<8>(slot.palette.data(), joint_count,
+                               s.positions->data(), s.joints->data(),
+                               s.weights->data(), s.joints1->data(),
+                               s.weights1->data(), v0, v1, out);
+        } else {
+            skinVertexRange<4>(slot.palette.data(), joint_count,
+                               s.positions->data(), s.joints->data(),
+                               s.weights->data(), nullptr, nullptr,
+                               v0, v1, out);
+        }
+    });
 
-        // Chunk AABBs (parallel — each chunk is independent), then the
-        // skeleton AABB as a cheap serial reduction over the chunks.
-        const uint32_t chunk_n =
-            (h.tri_count + RT_SKEL_CHUNK_TRIS - 1u) / RT_SKEL_CHUNK_TRIS;
-        const uint32_t chunk_base = h.chunk_offset;
-        all_chunks.resize((chunk_base + chunk_n) * 2u);
-        s_skel_pool.parallelFor(chunk_n, [&](size_t c) {
+    // Chunk AABBs of the dirty skeletons (parallel — each chunk is
+    // independent), then each skeleton AABB as a cheap serial reduction
+    // over its chunks.
+    const uint32_t kChunkBlock = 16;
+    rt_skel_jobs_.clear();
+    for (uint32_t k = 0; k < (uint32_t)rt_skel_slots_.size(); ++k) {
+        const auto& slot = rt_skel_slots_[k];
+        if (!slot.dirty) continue;
+        for (uint32_t c = 0; c < slot.ccount; c += kChunkBlock)
+            rt_skel_jobs_.emplace_back(k, c);
+    }
+    rt_cpu_pool_->parallelFor(rt_skel_jobs_.size(), [&](size_t j) {
+        const auto [k, c0] = rt_skel_jobs_[j];
+        const auto& slot = rt_skel_slots_[k];
+        const uint32_t c1 = std::min(c0 + kChunkBlock, slot.ccount);
+        const uint32_t tri_end =
+            (slot.header.tri_offset + slot.header.tri_count) * 3u;
+        for (uint32_t c = c0; c < c1; ++c) {
             glm::vec3 cmin(std::numeric_limits<float>::max());
             glm::vec3 cmax(std::numeric_limits<float>::lowest());
             const uint32_t t0i =
-                (h.tri_offset + (uint32_t)c * RT_SKEL_CHUNK_TRIS) * 3u;
-            const uint32_t t1i = std::min(
-                (uint32_t)all_idx.size(),
-                t0i + RT_SKEL_CHUNK_TRIS * 3u);
+                (slot.header.tri_offset + c * RT_SKEL_CHUNK_TRIS) * 3u;
+            const uint32_t t1i =
+                std::min(tri_end, t0i + RT_SKEL_CHUNK_TRIS * 3u);
             for (uint32_t i = t0i; i < t1i; ++i) {
-                const glm::vec3 p(all_pos[all_idx[i]]);
+                const glm::vec3 p(rt_skel_pos_cpu_[rt_skel_idx_cpu_[i]]);
                 cmin = glm::min(cmin, p);
                 cmax = glm::max(cmax, p);
             }
-            all_chunks[(chunk_base + c) * 2u + 0u] = glm::vec4(cmin, 0.0f);
-            all_chunks[(chunk_base + c) * 2u + 1u] = glm::vec4(cmax, 0.0f);
-        });
+            rt_skel_chunk_cpu_[(slot.cbase + c) * 2u + 0u] = glm::vec4(cmin, 0.0f);
+            rt_skel_chunk_cpu_[(slot.cbase + c) * 2u + 1u] = glm::vec4(cmax, 0.0f);
+        }
+    });
+    for (auto& slot : rt_skel_slots_) {
+        if (!slot.dirty) continue;
         glm::vec3 smin(std::numeric_limits<float>::max());
         glm::vec3 smax(std::numeric_limits<float>::lowest());
-        for (uint32_t c = 0; c < chunk_n; ++c) {
+        for (uint32_t c = 0; c < slot.ccount; ++c) {
             smin = glm::min(smin,
-                            glm::vec3(all_chunks[(chunk_base + c) * 2u]));
+                glm::vec3(rt_skel_chunk_cpu_[(slot.cbase + c) * 2u]));
             smax = glm::max(smax,
-                            glm::vec3(all_chunks[(chunk_base + c) * 2u + 1u]));
+                glm::vec3(rt_skel_chunk_cpu_[(slot.cbase + c) * 2u + 1u]));
         }
-        h.aabb_min = glm::vec4(smin, 0.0f);
-        h.aabb_max = glm::vec4(smax, 0.0f);
-        headers.push_back(h);
+        slot.header.aabb_min = glm::vec4(smin, 0.0f);
+        slot.header.aabb_max = glm::vec4(smax, 0.0f);
     }
 
-    // ── 2. (Re)create / grow the HOST_VISIBLE buffers ─────────────────
+    // ── 4. (Re)create / grow the HOST_VISIBLE buffers ─────────────────
     auto ensure = [&](renderer::BufferInfo& buf, uint32_t& cap_elems,
                       uint32_t need_elems, uint32_t elem_bytes,
                       bool as_input) -> bool {
@@ -5805,76 +6712,110 @@ void ClusterRenderer::updateRtSkeletons(
         cap_elems = new_cap;
         return true;
     };
+    const bool has_slots = !rt_skel_slots_.empty();
     bool rewrote = false;
-    if (!headers.empty()) {
+    if (has_slots) {
         rewrote |= ensure(rt_skel_chunk_buffer_, rt_skel_chunk_cap_,
-                          (uint32_t)(all_chunks.size() / 2u), 2u * sizeof(glm::vec4),
-                          false);
+                          (uint32_t)(rt_skel_chunk_cpu_.size() / 2u),
+                          2u * sizeof(glm::vec4), false);
         rewrote |= ensure(rt_skel_pos_buffer_, rt_skel_pos_cap_,
-                          (uint32_t)all_pos.size(), sizeof(glm::vec4), true);
+                          (uint32_t)rt_skel_pos_cpu_.size(),
+                          sizeof(glm::vec4), true);
         rewrote |= ensure(rt_skel_index_buffer_, rt_skel_idx_cap_,
-                          (uint32_t)all_idx.size(), sizeof(uint32_t), true);
+                          (uint32_t)rt_skel_idx_cpu_.size(),
+                          sizeof(uint32_t), true);
         if (rewrote) writeRtSkeletonDescriptors();
 
-        // deferrable: these four are the per-frame RT-skeleton set, read
-        // by the previous frame's still-in-flight resolve.  Queued during
+        // deferrable: these are the per-frame RT-skeleton set, read by
+        // the previous frame's still-in-flight resolve.  Queued during
         // recording and applied just before submit — see
         // Device::beginDeferredBufferWrites.  Safe because the capacity
         // grow (ensure() above) already ran, so the memory these name is
         // the memory the flush will map.
-        device_->updateBufferMemory(rt_skel_pos_buffer_.memory,
-            all_pos.size() * sizeof(glm::vec4), all_pos.data(), 0, true);
-        device_->updateBufferMemory(rt_skel_index_buffer_.memory,
-            all_idx.size() * sizeof(uint32_t), all_idx.data(), 0, true);
-        device_->updateBufferMemory(rt_skel_chunk_buffer_.memory,
-            all_chunks.size() * sizeof(glm::vec4), all_chunks.data(), 0, true);
+        if (relayout || rewrote) {
+            // Fresh layout (or fresh buffers): everything goes up once.
+            device_->updateBufferMemory(rt_skel_pos_buffer_.memory,
+                rt_skel_pos_cpu_.size() * sizeof(glm::vec4),
+                rt_skel_pos_cpu_.data(), 0, true);
+            device_->updateBufferMemory(rt_skel_index_buffer_.memory,
+                rt_skel_idx_cpu_.size() * sizeof(uint32_t),
+                rt_skel_idx_cpu_.data(), 0, true);
+            device_->updateBufferMemory(rt_skel_chunk_buffer_.memory,
+                rt_skel_chunk_cpu_.size() * sizeof(glm::vec4),
+                rt_skel_chunk_cpu_.data(), 0, true);
+        } else {
+            // Only the moved skeletons' ranges; indices never change
+            // without a relayout.
+            for (const auto& slot : rt_skel_slots_) {
+                if (!slot.dirty) continue;
+                device_->updateBufferMemory(rt_skel_pos_buffer_.memory,
+                    uint64_t(slot.vcount) * sizeof(glm::vec4),
+                    rt_skel_pos_cpu_.data() + slot.vbase,
+                    uint64_t(slot.vbase) * sizeof(glm::vec4), true);
+                device_->updateBufferMemory(rt_skel_chunk_buffer_.memory,
+                    uint64_t(slot.ccount) * 2u * sizeof(glm::vec4),
+                    rt_skel_chunk_cpu_.data() + size_t(slot.cbase) * 2u,
+                    uint64_t(slot.cbase) * 2u * sizeof(glm::vec4), true);
+            }
+        }
     }
     {
         // Header buffer: count + entries (count 0 disables the loop).
-        std::vector<uint8_t> hdr(
+        // Small and fixed-size — rewritten whole whenever anything moved.
+        rt_skel_hdr_cpu_.assign(
             sizeof(glm::uvec4) + RT_SKEL_MAX * sizeof(glsl::RtSkelHeader), 0);
-        glm::uvec4 counts((uint32_t)headers.size(), 0u, 0u, 0u);
-        std::memcpy(hdr.data(), &counts, sizeof(counts));
-        if (!headers.empty()) {
-            std::memcpy(hdr.data() + sizeof(glm::uvec4), headers.data(),
-                        headers.size() * sizeof(glsl::RtSkelHeader));
+        glm::uvec4 counts((uint32_t)rt_skel_slots_.size(), 0u, 0u, 0u);
+        std::memcpy(rt_skel_hdr_cpu_.data(), &counts, sizeof(counts));
+        for (size_t k = 0; k < rt_skel_slots_.size(); ++k) {
+            std::memcpy(rt_skel_hdr_cpu_.data() + sizeof(glm::uvec4) +
+                            k * sizeof(glsl::RtSkelHeader),
+                        &rt_skel_slots_[k].header, sizeof(glsl::RtSkelHeader));
         }
         device_->updateBufferMemory(rt_skel_header_buffer_.memory,
-                                    hdr.size(), hdr.data(), 0, true);
+                                    rt_skel_hdr_cpu_.size(),
+                                    rt_skel_hdr_cpu_.data(), 0, true);
     }
-    // GPU state is now consistent with rt_skel_cache_ — identical poses
+    // GPU state is now consistent with the slot caches — identical poses
     // next frame skip the whole update (see the change detection above).
     rt_skel_have_gpu_state_ = true;
 
     // Heartbeat (every ~5 s at 60 fps) so "no character shadows" is
-    // debuggable: shows how many skeletons made it through the guards.
+    // debuggable: shows how many skeletons made it through the guards
+    // and how many actually moved.
+    const uint32_t skel_tris = (uint32_t)(rt_skel_idx_cpu_.size() / 3u);
     {
         static int s_frame = 0;
         if ((s_frame++ % 300) == 0) {
             clog_printf(
-                "[RT_SKEL] update: %zu/%zu skeleton(s), %u tris, hw_as=%d\n",
-                headers.size(), skeletons.size(),
-                (uint32_t)(all_idx.size() / 3u),
+                "[RT_SKEL] update: %zu/%zu skeleton(s), %u re-skinned, "
+                "%u tris, hw_as=%d\n",
+                rt_skel_slots_.size(), skeletons.size(), dirty_count,
+                has_slots ? skel_tris : 0u,
                 hw_rt_shadow_ready_ ? 1 : 0);
         }
     }
 
-    // ── 3. Hardware mode: skeleton BLAS rebuild + TLAS rebuild ────────
+    // ── 5. Hardware mode: skeleton BLAS build/refit + TLAS rebuild ────
     if (!hw_rt_shadow_ready_ || !cmd_buf) return;
 
-    const uint32_t skel_tris = (uint32_t)(all_idx.size() / 3u);
-    const bool has_skels = !headers.empty() && skel_tris > 0;
+    const bool has_skels = has_slots && skel_tris > 0;
     // NOTE: even with NO skeletons this frame we still fall through to
     // the TLAS rebuild below (static instance only) — an early return
     // here would leave the LAST frame's skeleton instance in the TLAS
     // forever (phantom shadows from unbound / hidden characters).
 
+    // A relayout changes the triangle set and new buffers change the
+    // vertex/index addresses: both need a full build.  Pose-only frames
+    // refit the previous build in place.
+    if (relayout || rewrote) hw_rt_skel_blas_refittable_ = false;
+
     // (Re)create the skeleton BLAS when the triangle budget grows.
     if (has_skels &&
         (skel_tris > hw_rt_skel_blas_tri_cap_ || !hw_rt_skel_blas_handle_)) {
         // Deferred (in-flight): frame N-1's ray query may still hold
         // this BLAS through the previous TLAS.
         retireAs(hw_rt_skel_blas_handle_);
+        hw_rt_skel_blas_refittable_ = false;
         uint32_t tri_cap = std::max(1024u, hw_rt_skel_blas_tri_cap_);
         while (tri_cap < skel_tris) tri_cap *= 2u;
 
@@ -5898,8 +6839,9 @@ void ClusterRenderer::updateRtSkeletons(
 
         er::AccelerationStructureBuildGeometryInfo info{};
         info.type = er::AccelerationStructureType::BOTTOM_LEVEL_KHR;
-        info.flags = SET_FLAG_BIT(BuildAccelerationStructure,
-                                  PREFER_FAST_BUILD_BIT_KHR);
+        info.flags = SET_2_FLAG_BITS(BuildAccelerationStructure,
+                                     PREFER_FAST_BUILD_BIT_KHR,
+                                     ALLOW_UPDATE_BIT_KHR);
         info.geometries = { g };
         er::AccelerationStructureBuildSizesInfo sz{};
         sz.struct_type = er::StructureType::
@@ -5921,8 +6863,9 @@ void ClusterRenderer::updateRtSkeletons(
             hw_rt_skel_blas_buffer_.buffer,
             er::AccelerationStructureType::BOTTOM_LEVEL_KHR);
         retireBuffer(hw_rt_skel_blas_scratch_);  // deferred (in-flight)
+        // One scratch serves both the full build and the refit.
         device_->createBuffer(
-            sz.build_scratch_size,
+            std::max(sz.build_scratch_size, sz.update_scratch_size),
             SET_FLAG_BIT(BufferUsage, STORAGE_BUFFER_BIT) |
             SET_FLAG_BIT(BufferUsage, SHADER_DEVICE_ADDRESS_BIT),
             SET_FLAG_BIT(MemoryProperty, DEVICE_LOCAL_BIT),
@@ -5965,7 +6908,8 @@ void ClusterRenderer::updateRtSkeletons(
     cmd_buf->addBufferBarrier(
         hw_rt_tlas_buffer_.buffer, as_read_compute, as_write_build);
 
-    // Skeleton BLAS rebuild (positions changed this frame).
+    // Skeleton BLAS build, or refit when only poses changed since the
+    // last full build (same triangles, same buffers).
     if (has_skels) {
         auto g = std::make_shared<er::AccelerationStructureGeometry>();
         g->geometry_type = er::GeometryType::TRIANGLES_KHR;
@@ -5987,9 +6931,15 @@ void ClusterRenderer::updateRtSkeletons(
 
         er::AccelerationStructureBuildGeometryInfo info{};
         info.type = er::AccelerationStructureType::BOTTOM_LEVEL_KHR;
-        info.flags = SET_FLAG_BIT(BuildAccelerationStructure,
-                                  PREFER_FAST_BUILD_BIT_KHR);
-        info.mode = er::BuildAccelerationStructureMode::BUILD_KHR;
+        info.flags = SET_2_FLAG_BITS(BuildAccelerationStructure,
+                                     PREFER_FAST_BUILD_BIT_KHR,
+                                     ALLOW_UPDATE_BIT_KHR);
+        if (hw_rt_skel_blas_refittable_) {
+            info.mode = er::BuildAccelerationStructureMode::UPDATE_KHR;
+            info.src_as = hw_rt_skel_blas_handle_;
+        } else {
+            info.mode = er::BuildAccelerationStructureMode::BUILD_KHR;
+        }
         info.dst_as = hw_rt_skel_blas_handle_;
         info.geometries = { g };
         info.scratch_data.device_address =
@@ -5997,6 +6947,7 @@ void ClusterRenderer::updateRtSkeletons(
         std::vector<er::AccelerationStructureBuildRangeInfo> ranges = {
             { skel_tris, 0u, 0u, 0u } };
         cmd_buf->buildAccelerationStructures({ info }, ranges);
+        hw_rt_skel_blas_refittable_ = true;
     }
 
     // BLAS write → TLAS build read.
@@ -6069,8 +7020,10 @@ void ClusterRenderer::updateRtSkeletons(
 }
 
 void ClusterRenderer::destroy() {
-    // Drain the deferred-retirement list before member teardown.
+    // Drain the deferred-retirement lists before member teardown.
     flushRetiredBuffers(/*force*/ true);
+    releaseRetiredSceneRanges(/*force*/ true);
+    scene_upload_ring_.reset();
     bindless_pipeline_.reset();
     bindless_translucent_pipeline_.reset();
     bindless_translucent_oit_pipeline_.reset();
@@ -6109,12 +7062,17 @@ void ClusterRenderer::destroy() {
         device_->destroyAccelerationStructure(hw_rt_skel_blas_handle_);
         hw_rt_skel_blas_handle_ = {};
         hw_rt_skel_blas_tri_cap_ = 0;
+        hw_rt_skel_blas_refittable_ = false;
     }
     hw_rt_desc_set_.reset();
     hw_rt_desc_set_layout_.reset();
     hw_rt_shadow_ready_ = false;
     rt_skel_have_gpu_state_ = false;
-    rt_skel_cache_.clear();
+    rt_skel_slots_.clear();
+    rt_bvh_job_.reset();                 // joins a background build
+    rt_bvh_cpu_ = RtClusterBvh{};
+    rt_cpu_pool_.reset();
+    rt_bvh_pool_.reset();
 
     // CSM silhouette prepass pipeline.
     silhouette_prepass_pipeline_.reset();
@@ -15,15 +15,23 @@
 //   1. Construct once (creates pipelines, descriptor set layouts).
 //   2. Call uploadMeshClusters() per drawable mesh — appends to CPU staging.
 //   3. Call finalizeUploads() once all meshes are uploaded — creates GPU SSBOs.
-//   4. Each frame: cull() → draw() in the forward pass.
+//   4. Each frame: recordSceneUpdates() → cull() → draw() in the forward pass.
 //   5. recreate() on swap chain resize (re-alloc descriptor sets).
 //   6. destroy() at shutdown.
 //
+// After the first finalize the merged buffers double as a persistent scene
+// database: addSceneMesh() / removeSceneMesh() place or drop one object by
+// writing only its ranges (see the "Persistent scene database" block).
+//
 
 #include "renderer/renderer.h"
+#include "renderer/frame_upload_ring.h"
 #include "helper/cluster_mesh.h"
 #include "shaders/global_definition.glsl.h"
+#include "scene_range_allocator.h"
+#include "rt_cluster_bvh.h"
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <memory>
@@ -35,7 +43,7 @@
 namespace engine {
 
 namespace game_object { struct DrawableData; }
-namespace helper      { class MaterialClassifier; }
+namespace helper      { class MaterialClassifier; class ThreadPool; }
 
 namespace scene_rendering {
 
@@ -160,6 +168,92 @@ private:
     size_t base_tex_count_      = 0;
     size_t base_normal_tex_count_ = 0;
     uint32_t base_mesh_count_   = 0;
+    uint32_t base_live_clusters_ = 0;
+
+    // ── Persistent scene database (live add / remove) ────────────────
+    // finalizeUploads pads every merged stream (clusters — cull + draw
+    // infos 1:1 —, vertices, indices, materials) with headroom and hands
+    // the free part to one SceneRangeAllocator per stream.  The staging
+    // vectors stay sized to that CAPACITY and are the CPU mirror of the
+    // GPU buffers: unused cluster slots hold placeholder entries (poisoned
+    // sphere, index_count 0) that the cull rejects for free.
+    //
+    // addSceneMesh stages through uploadMeshClusters as before, then moves
+    // the appended tail into allocated ranges (rebasing indices, index
+    // offsets and material ids) and queues just those ranges for
+    // recordSceneUpdates.  removeSceneMesh writes placeholders over the
+    // mesh's clusters and retires its ranges; they return to the
+    // allocators kSceneDbRetireFrames frames later, once no in-flight
+    // frame can still read the old contents.  Its global mesh slot
+    // (mesh_cluster_ranges_ / mesh_prim_material_ / object_idx) retires
+    // with them and the next addSceneMesh takes it over, so a session of
+    // moves (remove + add) does not grow the per-mesh tables.
+    struct SceneRange {
+        uint32_t offset = 0;
+        uint32_t count  = 0;
+    };
+    struct SceneMeshRecord {
+        SceneRange clusters;
+        SceneRange vertices;
+        SceneRange indices;
+        SceneRange materials;
+        uint32_t   global_mesh_idx = 0;   // mesh_cluster_ranges_ index
+        uint32_t   generation      = 0;
+        bool       in_use          = false;
+    };
+    struct RetiredSceneRanges {
+        uint64_t   frame = 0;
+        uint32_t   global_mesh_idx = 0;
+        SceneRange clusters;
+        SceneRange vertices;
+        SceneRange indices;
+        SceneRange materials;
+    };
+    bool                scene_db_active_ = false;
+    SceneRangeAllocator scene_cluster_alloc_;
+    SceneRangeAllocator scene_vertex_alloc_;
+    SceneRangeAllocator scene_index_alloc_;
+    SceneRangeAllocator scene_material_alloc_;
+    std::vector<SceneMeshRecord>    scene_meshes_;      // handle slot → record
+    std::vector<uint32_t>           scene_mesh_free_;   // recycled slots
+    std::vector<uint32_t>           scene_global_mesh_free_;  // retired ids
+    std::vector<RetiredSceneRanges> scene_retired_;
+    // Element ranges written since the last recordSceneUpdates.  RT
+    // "hide" ranges go to the software-RT duplicates of the cull / draw
+    // infos only (see removeSceneMesh).
+    std::vector<SceneRange> scene_dirty_clusters_;
+    std::vector<SceneRange> scene_dirty_vertices_;
+    std::vector<SceneRange> scene_dirty_indices_;
+    std::vector<SceneRange> scene_dirty_materials_;
+    std::vector<SceneRange> scene_dirty_rt_hidden_;
+    // Upload staging for batches too large for inline vkCmdUpdateBuffer:
+    // a persistent ring whose bytes are reused on the same frame-delayed
+    // clock.  Created on the first such batch.
+    std::unique_ptr<renderer::FrameUploadRing> scene_upload_ring_;
+    uint64_t scene_db_frame_ = 0;
+    // Set when live edits happened since the hardware-RT shadow AS was
+    // last built — added meshes reach it only with the next full
+    // finalizeUploads.  The software-RT BVH tracks edits itself.
+    bool     scene_db_rt_stale_ = false;
+    uint32_t scene_db_live_adds_ = 0;
+    uint32_t scene_db_fallback_finalizes_ = 0;
+    uint64_t scene_db_last_upload_bytes_ = 0;
+
+    // finalizeUploads helper: size each allocator to the staged content
+    // plus headroom (keeping live ranges) and pad staging to capacity.
+    void reserveSceneDbCapacity();
+    // Move the tail uploadMeshClusters just appended into allocated
+    // ranges.  False (nothing changed) when any stream is out of room.
+    bool placeSceneMeshTail(SceneMeshRecord& rec,
+                            size_t cluster_base, size_t vertex_base,
+                            size_t index_base, size_t material_base,
+                            uint32_t object_idx);
+    // Return retired ranges that are `force`-ably or kSceneDbRetireFrames
+    // old to their allocators.
+    void releaseRetiredSceneRanges(bool force);
+    // Forget every live mesh (resetToBaseUploads truncates their data).
+    void resetSceneDb();
+    SceneMeshRecord* findSceneMesh(uint64_t handle);
 
     // Re-point the bindless graphics descriptor set (bindings 0..3) at
     // the freshly created merged buffers + texture staging after a
@@ -227,7 +321,8 @@ private:
 
     // Per-mesh (prim_idx → global material_idx) map, indexed by the
     // mesh's global object id (the uploaded_mesh_count_ value at upload
-    // time, == ClusterDrawInfo::object_idx).  Populated at the end of
+    // time, or the retired slot addSceneMesh took over;
+    // == ClusterDrawInfo::object_idx).  Populated at the end of
     // uploadMeshClusters from its local prim_to_mat_idx cache.  Used by
     // materialIdxForPrimitive() so the collision isolate-debug overlay can
     // resolve an isolated source primitive to the cluster material_idx its
@@ -409,8 +504,11 @@ private:
         cluster_mesh_data_desc_set_;
 
     // ── Software-RT shadow BVH (world-space raytraced shadows) ─────────
-    // CPU-built binary BVH over every cluster's bounding-sphere AABB,
-    // rebuilt at the end of each finalizeUploads.  Traversed per pixel
+    // CPU-built binary BVH over every cluster's bounding-sphere AABB
+    // (binned SAH, see rt_cluster_bvh.h), rebuilt at the end of each
+    // finalizeUploads — median split on the render thread, upgraded to
+    // SAH by a background build — and kept current across live scene
+    // edits by updateRtShadowBvh (refit or background rebuild).  Traversed per pixel
     // by deferred_resolve.comp (COMPUTE) to trace sun-shadow rays against
     // the actual merged cluster geometry — no RT hardware involved.
     //   rt_bvh_nodes_buffer_  : glsl::RtBvhNode[]   (32 B / node)
@@ -456,6 +554,45 @@ private:
         rt_shadow_desc_set_;
     void buildRtShadowBvh();   // called from finalizeUploads
 
+    // Live-edit maintenance of the same tree.  The node / leaf buffers are
+    // sized at finalize for the worst case over the cluster capacity
+    // (2n - 1 nodes, n leaf refs), so a later rebuild or refit is a plain
+    // range write in recordSceneUpdates' batch — no new buffer, no
+    // descriptor rewrite.
+    //   removed / re-used slots → refitRtClusterBvh on the render thread
+    //   newly occupied slots    → background build (RtBvhJob) against a
+    //                             snapshot of staging_cull_infos_, swapped
+    //                             in on the first frame after it finishes
+    // A refit that lets the SAH cost drift past kRtBvhRefitDegrade × the
+    // built cost also queues a rebuild.  Live-placed clusters reach the RT
+    // duplicates (cull / draw infos, pos+uv, materials) together with the
+    // first tree that references them (rt_pending_* → job → publish).
+    struct RtBvhJob;                      // defined in cluster_renderer.cpp
+    RtClusterBvh                rt_bvh_cpu_;    // tree currently on the GPU
+    std::shared_ptr<RtBvhJob>   rt_bvh_job_;    // in-flight rebuild, or null
+    uint64_t                    rt_bvh_epoch_ = 0;  // bumped by full builds
+    bool                        rt_bvh_dirty_ = false;  // edits since build
+    bool                        rt_bvh_median_builder_ = false;  // debug
+    // The tree on the GPU is finalize's median build; a background SAH
+    // build is still owed.
+    bool                        rt_bvh_sah_upgrade_ = false;
+    float                       rt_bvh_built_sah_ = 0.0f;
+    double                      rt_bvh_build_ms_ = 0.0;
+    double                      rt_bvh_refit_ms_ = 0.0;
+    uint32_t                    rt_bvh_full_builds_ = 0;
+    uint32_t                    rt_bvh_background_builds_ = 0;
+    uint32_t                    rt_bvh_refits_ = 0;
+    std::vector<SceneRange>     rt_pending_clusters_;
+    std::vector<SceneRange>     rt_pending_vertices_;
+    std::vector<SceneRange>     rt_pending_materials_;
+    // Filled by updateRtShadowBvh for the current recordSceneUpdates batch.
+    std::vector<SceneRange>     rt_publish_clusters_;
+    std::vector<SceneRange>     rt_publish_vertices_;
+    std::vector<SceneRange>     rt_publish_materials_;
+    // True when rt_bvh_cpu_ changed and must be uploaded this frame.
+    bool updateRtShadowBvh();
+    void startRtShadowBvhJob();
+
     // ── Hardware-RT shadow acceleration structure (ray query) ──────────
     // One static BLAS over the merged cluster geometry, TWO geometries:
     //   geometry 0 — OPAQUE flag: all triangles of clusters whose material
@@ -508,8 +645,9 @@ private:
     //   SW mode — writes header/chunk-AABB/position/index SSBOs (RT set
     //             bindings 8..11); rtShadowFactor tests skeleton AABB →
     //             chunk AABBs (RT_SKEL_CHUNK_TRIS tris each) → triangles.
-    //   HW mode — rebuilds ONE skeleton BLAS over the concatenated
-    //             triangles (FAST_BUILD) + the shared TLAS (static
+    //   HW mode — refits ONE skeleton BLAS over the concatenated
+    //             triangles (FAST_BUILD | ALLOW_UPDATE; full build only
+    //             after a relayout) + rebuilds the shared TLAS (static
     //             instance + skeleton instance) on the frame cmd buffer.
     // Buffers are HOST_VISIBLE|HOST_COHERENT and single-buffered — same
     // per-frame overwrite policy the engine already uses for the skinning
@@ -546,17 +684,57 @@ private:
     uint32_t hw_rt_skel_blas_tri_cap_ = 0;  // BLAS sized for this many tris
     renderer::BufferInfo hw_rt_frame_instance_buffer_;  // TLAS rebuild input
     void writeRtSkeletonDescriptors();  // rewrite RT-set bindings 8..11
-    // Change detection for updateRtSkeletons: pose = model matrix +
-    // joint matrices, cached per input slot.  When every skeleton's
-    // pose is bytewise identical to last frame, the whole update
-    // (CPU skinning + uploads + BLAS/TLAS rebuild) is skipped — the
-    // GPU state from the previous update is still valid.  Invalidated
-    // by finalize (buildHwRtShadowAs rebuilds a static-only TLAS).
-    struct RtSkelPoseCache {
-        glm::mat4              model = glm::mat4(1.0f);
-        std::vector<glm::mat4> jm;
+    // ── Incremental skeleton update ───────────────────────────────────
+    // Every accepted skeleton owns a PERSISTENT range of the position,
+    // index and chunk buffers, assigned on relayout (the skeleton set or
+    // a mesh changed — rare).  Each frame only skeletons whose pose
+    // (model matrix + joint matrices, compared bytewise with the cache
+    // here) moved are re-skinned, and only their ranges are uploaded; an
+    // idle NPC next to the animated player costs one memcmp.  When no
+    // pose moved at all, the whole update (uploads + BLAS/TLAS rebuild)
+    // is skipped — the GPU state from the previous update is still
+    // valid.  Invalidated by finalize (buildHwRtShadowAs rebuilds a
+    // static-only TLAS).
+    struct RtSkelSlot {
+        // Layout key: the source mesh arrays this range was laid out for.
+        const std::vector<glm::vec3>* positions = nullptr;
+        const std::vector<uint32_t>*  indices   = nullptr;
+        const glm::vec3*              pos_data  = nullptr;
+        const uint32_t*               idx_data  = nullptr;
+        uint32_t                      vbase = 0, vcount = 0;
+        uint32_t                      cbase = 0, ccount = 0;
+        bool                          two_sets = false;  // 8-bone kernel
+        bool                          dirty = true;
+        // Pose cache.
+        glm::mat4                     model = glm::mat4(1.0f);
+        std::vector<glm::mat4>        jm;
+        // model * joint matrix, top three rows (12 floats) per joint,
+        // plus `model` itself last for unweighted vertices.
+        std::vector<float>            palette;
+        glsl::RtSkelHeader            header{};
     };
-    std::vector<RtSkelPoseCache> rt_skel_cache_;
+    std::vector<RtSkelSlot> rt_skel_slots_;
+    // CPU mirrors of the skeleton buffers.  Kept across frames so a
+    // clean skeleton's range never needs recomputing and no per-frame
+    // vector is allocated once the set is stable.
+    std::vector<glm::vec4>  rt_skel_pos_cpu_;
+    std::vector<uint32_t>   rt_skel_idx_cpu_;
+    std::vector<glm::vec4>  rt_skel_chunk_cpu_;   // min,max pairs
+    std::vector<uint8_t>    rt_skel_hdr_cpu_;     // counts + RtSkelHeader[]
+    // Per-frame scratch (cleared, never shrunk): accepted input indices,
+    // and (slot, first element) work items for the parallel bursts.
+    std::vector<uint32_t>                      rt_skel_accept_;
+    std::vector<std::pair<uint32_t, uint32_t>> rt_skel_jobs_;
+    // CPU workers for per-frame RT upkeep (skeleton skinning here) and the
+    // synchronous first shadow BVH build.  Created on first use.
+    std::shared_ptr<helper::ThreadPool> rt_cpu_pool_;
+    // The background shadow BVH builds get workers of their own: the pool
+    // is FIFO, so a rebuild queued on rt_cpu_pool_ would hold the frame's
+    // skinning parallelFor behind it.
+    std::shared_ptr<helper::ThreadPool> rt_bvh_pool_;
+    // The skeleton BLAS holds a full build of the CURRENT layout and was
+    // built with ALLOW_UPDATE, so pose-only changes can refit it.
+    bool hw_rt_skel_blas_refittable_ = false;
     bool rt_skel_have_gpu_state_ = false;
 
     // ── CSM silhouette prepass pipeline ─────────────────────────────────
@@ -626,7 +804,12 @@ private:
     std::vector<glsl::ClusterCullInfo> debug_sample_clusters_;
 
     // Global stats for debug UI.
+    // Cluster slots in the merged buffers — the cull dispatch extent, so
+    // it includes the scene-database headroom and the placeholders of
+    // removed meshes.  live_clusters_ counts only staged, not-removed
+    // clusters and is what the stats report.
     uint32_t total_clusters_all_meshes_ = 0;
+    uint32_t live_clusters_ = 0;
     uint32_t rt_instance_count_ = 0;   // RT-only instanced casters staged
     uint32_t total_visible_all_meshes_ = 0;
 
@@ -737,9 +920,58 @@ public:
     // again after further uploads (editor placed-object flow): a re-run
     // drains the GPU (waitIdle), replaces every merged buffer, and
     // rewrites the cull / mesh-data / bindless descriptors in place —
-    // pipelines and descriptor-set handles are reused.
+    // pipelines and descriptor-set handles are reused.  Every merged
+    // stream is sized with headroom for the live scene database below,
+    // so single-object edits normally never come back here.
     void finalizeUploads();
 
+    // ── Persistent scene database (editor place / move / delete) ─────
+    // Handle of one mesh placed through addSceneMesh.  0 = invalid.
+    using SceneMeshHandle = uint64_t;
+    static constexpr SceneMeshHandle kInvalidSceneMesh = 0;
+    // Stage one mesh exactly like uploadMeshClusters and, once the scene
+    // is finalized, publish it LIVE: its clusters / vertices / indices /
+    // materials are sub-allocated in the finalize headroom and only those
+    // ranges are uploaded by the next recordSceneUpdates — no waitIdle,
+    // no buffer replacement, no descriptor rewrite.  Falls back to a full
+    // finalizeUploads() (which regrows the headroom) when a stream is out
+    // of room or the mesh needs new legacy bindless texture slots.
+    // Before the first finalize it only stages; the caller's
+    // finalizeUploads() publishes it.  Moving an object is
+    // removeSceneMesh + addSceneMesh with the new transform.
+    SceneMeshHandle addSceneMesh(
+        const helper::ClusterMesh& cluster_mesh,
+        const game_object::DrawableData& drawable_data,
+        uint32_t mesh_idx,
+        const std::vector<uint32_t>& cluster_prim_map,
+        const glm::mat4& model_transform);
+    // Drop a mesh placed by addSceneMesh: its clusters stop drawing with
+    // the next recordSceneUpdates, and its ranges are recycled a few
+    // frames later.  Stale / invalid handles are ignored.
+    void removeSceneMesh(SceneMeshHandle handle);
+    // Record the pending scene-database writes into `cmd_buf` (inline
+    // vkCmdUpdateBuffer for small batches, copies out of a staging ring
+    // otherwise) bracketed by buffer barriers, and advance the frame clock
+    // that recycles retired ranges.  Call ONCE per frame, outside any render
+    // pass, before the first cull / draw that reads the merged buffers.
+    void recordSceneUpdates(
+        const std::shared_ptr<renderer::CommandBuffer>& cmd_buf);
+    // True when live edits happened since the hardware-RT shadow AS was
+    // built — the application can schedule a debounced full finalize.  The
+    // software-RT BVH catches up on its own (refit / background rebuild).
+    bool sceneRtStale() const { return scene_db_rt_stale_; }
+    struct SceneDbStats {
+        uint32_t live_meshes = 0;
+        uint32_t cluster_capacity = 0,  cluster_free = 0;
+        uint32_t vertex_capacity = 0,   vertex_free = 0;
+        uint32_t index_capacity = 0,    index_free = 0;
+        uint32_t material_capacity = 0, material_free = 0;
+        uint32_t live_adds = 0;           // published without a finalize
+        uint32_t fallback_finalizes = 0;  // adds that needed a full one
+        uint64_t last_upload_bytes = 0;   // last recordSceneUpdates batch
+    };
+    SceneDbStats sceneDbStats() const;
+
     // ── Editor incremental upload API ─────────────────────────────────
     // Snapshot the CURRENT staging tail as the immutable base scene.
     // The application calls this after staging the level meshes (New
@@ -748,8 +980,9 @@ public:
     void markBaseUploads();
     bool baseUploadsMarked() const { return base_marked_; }
     // Truncate staging back to the base snapshot, dropping every
-    // placed-object upload.  Call before re-staging the placed set,
-    // then uploadMeshClusters() per placed object + finalizeUploads().
+    // placed-object upload (scene-database handles included).  Call
+    // before re-staging the placed set, then uploadMeshClusters() per
+    // placed object + finalizeUploads().
     void resetToBaseUploads();
     // True once initBindlessPipeline has built the graphics pipelines —
     // the application's late (editor) finalize uses this to decide
@@ -1182,6 +1415,23 @@ public:
     // ran with geometry present) — the app gates FEATURE_INPUT_RT_SHADOW
     // on this so the resolve shader never traverses an empty tree.
     bool rtShadowReady() const { return rt_shadow_ready_; }
+    // Software-RT BVH quality / cost, for comparing builders in the debug
+    // UI.  sah_cost is rtClusterBvhSahCost (lower is better).
+    struct RtShadowBvhStats {
+        uint32_t clusters  = 0;       // live clusters in the tree
+        uint32_t nodes     = 0;
+        uint32_t leaf_refs = 0;
+        float    sah_cost  = 0.0f;    // current tree (after refits)
+        float    built_sah_cost = 0.0f;  // at its last full build
+        double   build_ms  = 0.0;     // last build (finalize or background)
+        double   refit_ms  = 0.0;     // last refit
+        uint32_t full_builds = 0, background_builds = 0, refits = 0;
+        bool     building  = false;   // background build in flight
+    };
+    RtShadowBvhStats rtShadowBvhStats() const;
+    // Debug: build with the original median splitter instead of binned SAH
+    // (takes effect on the next build).
+    bool& getRtBvhMedianBuilder() { return rt_bvh_median_builder_; }
     const std::shared_ptr<renderer::DescriptorSet>& getRtShadowDescSet() const {
         return rt_shadow_desc_set_;
     }
@@ -1219,7 +1469,7 @@ public:
     const glm::vec4& getDebugFirstCluster() const { return debug_first_cluster_bounds_; }
     const glm::vec4& getDebugFirstLocal() const { return debug_first_local_bounds_; }
     const glm::vec4& getDebugFirstModelDiag() const { return debug_first_model_diag_; }
-    uint32_t getTotalClusters() const { return total_clusters_all_meshes_; }
+    uint32_t getTotalClusters() const { return live_clusters_; }
 
     // ── RT-only instanced caster bookkeeping ──────────────────────────
     // How many EXT_mesh_gpu_instancing placements the application staged
@@ -1234,9 +1484,10 @@ public:
     uint64_t getTotalTriangles() const { return total_triangles_all_meshes_; }
     uint64_t getVisibleTriangles() const { return visible_triangles_; }
     float getCullPercentage() const {
-        if (total_clusters_all_meshes_ == 0) return 0.0f;
-        return 100.0f * (1.0f - float(total_visible_all_meshes_) /
-                                 float(total_clusters_all_meshes_));
+        if (live_clusters_ == 0) return 0.0f;
+        return 100.0f * (1.0f - float(std::min(total_visible_all_meshes_,
+                                               live_clusters_)) /
+                                 float(live_clusters_));
     }
     uint32_t getMeshCount() const { return uploaded_mesh_count_; }
 
@@ -0,0 +1,409 @@
+#include "rt_cluster_bvh.h"
+#include "helper/thread_pool.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace engine {
+namespace scene_rendering {
+
+namespace {
+
+constexpr uint32_t kSahBins = 16;
+// Subtrees below this many clusters are never split further on the calling
+// thread — they become one parallel task each.
+constexpr uint32_t kMinTaskPrims = 2048;
+
+struct Box {
+    float mn[3];
+    float mx[3];
+};
+
+Box emptyBox() {
+    constexpr float kMax = std::numeric_limits<float>::max();
+    return { { kMax, kMax, kMax }, { -kMax, -kMax, -kMax } };
+}
+
+void grow(Box& b, const Box& o) {
+    for (int a = 0; a < 3; ++a) {
+        b.mn[a] = std::min(b.mn[a], o.mn[a]);
+        b.mx[a] = std::max(b.mx[a], o.mx[a]);
+    }
+}
+
+bool isEmpty(const Box& b) {
+    return b.mn[0] > b.mx[0] || b.mn[1] > b.mx[1] || b.mn[2] > b.mx[2];
+}
+
+float area(const Box& b) {
+    if (isEmpty(b)) return 0.0f;
+    const float dx = b.mx[0] - b.mn[0];
+    const float dy = b.mx[1] - b.mn[1];
+    const float dz = b.mx[2] - b.mn[2];
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+Box sphereBox(const RtClusterSphere& s) {
+    return { { s.x - s.radius, s.y - s.radius, s.z - s.radius },
+             { s.x + s.radius, s.y + s.radius, s.z + s.radius } };
+}
+
+Box nodeBox(const RtClusterBvhNode& n) {
+    return { { n.aabb_min[0], n.aabb_min[1], n.aabb_min[2] },
+             { n.aabb_max[0], n.aabb_max[1], n.aabb_max[2] } };
+}
+
+void setNodeBox(RtClusterBvhNode& n, const Box& b) {
+    for (int a = 0; a < 3; ++a) {
+        n.aabb_min[a] = b.mn[a];
+        n.aabb_max[a] = b.mx[a];
+    }
+}
+
+RtClusterBvhNode emptyNode() {
+    RtClusterBvhNode n{};
+    setNodeBox(n, emptyBox());
+    return n;
+}
+
+struct Prim {
+    Box      box;
+    float    c[3];
+    uint32_t idx;
+};
+
+Box rangeBox(const Prim* p, uint32_t count) {
+    Box b = emptyBox();
+    for (uint32_t i = 0; i < count; ++i) grow(b, p[i].box);
+    return b;
+}
+
+uint32_t binOf(float c, float cmin, float scale, uint32_t bins) {
+    const float f = (c - cmin) * scale;
+    return std::min(bins - 1u, f > 0.0f ? static_cast<uint32_t>(f) : 0u);
+}
+
+// Partition p[0, count) for one node and return the size of the left
+// half, or 0 to make the node a leaf.
+uint32_t splitPrims(Prim* p, uint32_t count, const Box& bounds,
+                    RtClusterBvhBuilder builder, uint32_t max_leaf) {
+    Box cb = emptyBox();
+    for (uint32_t i = 0; i < count; ++i) {
+        for (int a = 0; a < 3; ++a) {
+            cb.mn[a] = std::min(cb.mn[a], p[i].c[a]);
+            cb.mx[a] = std::max(cb.mx[a], p[i].c[a]);
+        }
+    }
+
+    if (builder == RtClusterBvhBuilder::kMedian) {
+        if (count <= max_leaf) return 0;
+        const float ex = cb.mx[0] - cb.mn[0];
+        const float ey = cb.mx[1] - cb.mn[1];
+        const float ez = cb.mx[2] - cb.mn[2];
+        const int axis = (ex > ey) ? (ex > ez ? 0 : 2) : (ey > ez ? 1 : 2);
+        const uint32_t half = count / 2u;
+        std::nth_element(p, p + half, p + count,
+                         [axis](const Prim& a, const Prim& b) {
+                             return a.c[axis] < b.c[axis];
+                         });
+        return half;
+    }
+
+    // Binned SAH: evaluate the bins - 1 planes of every axis with a
+    // non-zero centroid extent.  Small nodes use fewer bins — they are most
+    // of the tree, and more bins than clusters buys nothing.
+    const uint32_t bins = std::clamp(count, 4u, kSahBins);
+    float best_cost  = std::numeric_limits<float>::max();
+    int   best_axis  = -1;
+    uint32_t best_plane = 0;
+    for (int a = 0; a < 3; ++a) {
+        const float extent = cb.mx[a] - cb.mn[a];
+        if (!(extent > 0.0f)) continue;
+        const float scale = float(bins) / extent;
+        Box      bin_box[kSahBins];
+        uint32_t bin_n[kSahBins] = {};
+        for (uint32_t b = 0; b < bins; ++b) bin_box[b] = emptyBox();
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t b = binOf(p[i].c[a], cb.mn[a], scale, bins);
+            grow(bin_box[b], p[i].box);
+            ++bin_n[b];
+        }
+        // Right-to-left sweep first, then score each plane on the way back.
+        float    right_area[kSahBins];
+        uint32_t right_n[kSahBins];
+        Box acc = emptyBox();
+        uint32_t n = 0;
+        for (uint32_t b = bins - 1; b > 0; --b) {
+            grow(acc, bin_box[b]);
+            n += bin_n[b];
+            right_area[b] = area(acc);
+            right_n[b]    = n;
+        }
+        acc = emptyBox();
+        n = 0;
+        for (uint32_t plane = 1; plane < bins; ++plane) {
+            grow(acc, bin_box[plane - 1]);
+            n += bin_n[plane - 1];
+            if (n == 0 || right_n[plane] == 0) continue;
+            const float cost = area(acc) * float(n) +
+                               right_area[plane] * float(right_n[plane]);
+            if (cost < best_cost) {
+                best_cost  = cost;
+                best_axis  = a;
+                best_plane = plane;
+            }
+        }
+    }
+
+    if (best_axis < 0) {
+        // Every centroid coincides: no plane separates them.
+        return count <= max_leaf ? 0u : count / 2u;
+    }
+    if (count <= max_leaf) {
+        const float a = area(bounds);
+        const float split_cost = a > 0.0f ? 1.0f + best_cost / a : 1.0f;
+        if (float(count) <= split_cost) return 0;
+    }
+    const float scale = float(bins) / (cb.mx[best_axis] - cb.mn[best_axis]);
+    const float cmin = cb.mn[best_axis];
+    Prim* mid = std::partition(p, p + count, [&](const Prim& q) {
+        return binOf(q.c[best_axis], cmin, scale, bins) < best_plane;
+    });
+    return static_cast<uint32_t>(mid - p);
+}
+
+// Serial build of the subtree rooted at the existing node `root` over
+// prims[first, first + count).  Children are allocated as an adjacent pair
+// before either is visited, so left_first is final when it is written.
+void buildSerial(Prim* prims, uint32_t first, uint32_t count, uint32_t root,
+                 RtClusterBvhBuilder builder, uint32_t max_leaf,
+                 std::vector<RtClusterBvhNode>& nodes,
+                 std::vector<uint32_t>& leaves) {
+    struct Item { uint32_t node, first, count; };
+    std::vector<Item> stack;
+    stack.push_back({ root, first, count });
+    while (!stack.empty()) {
+        const Item it = stack.back();
+        stack.pop_back();
+        const Box bounds = rangeBox(prims + it.first, it.count);
+        setNodeBox(nodes[it.node], bounds);
+
+        const uint32_t left_n =
+            splitPrims(prims + it.first, it.count, bounds, builder, max_leaf);
+        if (left_n == 0) {
+            nodes[it.node].left_first = static_cast<uint32_t>(leaves.size());
+            nodes[it.node].prim_count = it.count;
+            for (uint32_t i = 0; i < it.count; ++i) {
+                leaves.push_back(prims[it.first + i].idx);
+            }
+            continue;
+        }
+        const uint32_t left = static_cast<uint32_t>(nodes.size());
+        nodes.push_back({});
+        nodes.push_back({});
+        nodes[it.node].left_first = left;
+        nodes[it.node].prim_count = 0u;
+        stack.push_back({ left,      it.first,          left_n });
+        stack.push_back({ left + 1u, it.first + left_n, it.count - left_n });
+    }
+}
+
+} // namespace
+
+RtClusterBvh buildRtClusterBvh(const std::vector<RtClusterSphere>& spheres,
+                               RtClusterBvhBuilder builder,
+                               helper::ThreadPool* pool,
+                               uint32_t max_leaf_size) {
+    RtClusterBvh bvh;
+    bvh.sphere_count = static_cast<uint32_t>(spheres.size());
+    max_leaf_size = std::max(max_leaf_size, 1u);
+
+    std::vector<Prim> prims;
+    prims.reserve(spheres.size());
+    for (uint32_t i = 0; i < bvh.sphere_count; ++i) {
+        const RtClusterSphere& s = spheres[i];
+        if (!(s.radius >= 0.0f)) continue;            // placeholder
+        prims.push_back({ sphereBox(s), { s.x, s.y, s.z }, i });
+    }
+    const uint32_t n = static_cast<uint32_t>(prims.size());
+    bvh.live_count = n;
+    bvh.nodes.reserve(n > 0 ? 2 * size_t(n) - 1 : 1);
+    bvh.leaf_indices.reserve(n);
+    // An empty scene is one root with an inverted box: every ray misses it.
+    bvh.nodes.push_back(emptyNode());
+    if (n == 0) return bvh;
+
+    const size_t threads = pool ? pool->numThreads() : 0;
+    const uint32_t task_prims = std::max<uint32_t>(
+        kMinTaskPrims, threads ? uint32_t(n / (threads * 4)) : n);
+    if (threads < 2 || n < 2 * task_prims) {
+        buildSerial(prims.data(), 0, n, 0, builder, max_leaf_size,
+                    bvh.nodes, bvh.leaf_indices);
+        bvh.sah_cost = rtClusterBvhSahCost(bvh);
+        return bvh;
+    }
+
+    // ── Top of the tree on this thread, breadth first ─────────────────
+    struct Task { uint32_t node, first, count; };
+    std::vector<Task> tasks;
+    std::vector<Task> open{ { 0u, 0u, n } };
+    for (size_t head = 0; head < open.size(); ++head) {
+        const Task t = open[head];
+        if (t.count <= task_prims) {
+            tasks.push_back(t);
+            continue;
+        }
+        Prim* p = prims.data() + t.first;
+        const Box bounds = rangeBox(p, t.count);
+        setNodeBox(bvh.nodes[t.node], bounds);
+        // count > task_prims >= max leaf size: always splits.
+        const uint32_t left_n =
+            splitPrims(p, t.count, bounds, builder, max_leaf_size);
+        const uint32_t left = static_cast<uint32_t>(bvh.nodes.size());
+        bvh.nodes.push_back({});
+        bvh.nodes.push_back({});
+        bvh.nodes[t.node].left_first = left;
+        bvh.nodes[t.node].prim_count = 0u;
+        open.push_back({ left,      t.first,          left_n });
+        open.push_back({ left + 1u, t.first + left_n, t.count - left_n });
+    }
+
+    // ── Independent subtrees in parallel (disjoint prim ranges) ───────
+    struct Subtree {
+        std::vector<RtClusterBvhNode> nodes;
+        std::vector<uint32_t>         leaves;
+    };
+    std::vector<Subtree> sub(tasks.size());
+    pool->parallelFor(tasks.size(), [&](size_t i) {
+        const Task& t = tasks[i];
+        Subtree& s = sub[i];
+        s.nodes.reserve(2 * size_t(t.count) - 1);
+        s.leaves.reserve(t.count);
+        s.nodes.push_back({});
+        buildSerial(prims.data(), t.first, t.count, 0, builder,
+                    max_leaf_size, s.nodes, s.leaves);
+    });
+
+    // ── Stitch in task order: local root → its reserved slot ──────────
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const Subtree& s = sub[i];
+        const uint32_t node_base = static_cast<uint32_t>(bvh.nodes.size());
+        const uint32_t leaf_base =
+            static_cast<uint32_t>(bvh.leaf_indices.size());
+        auto remap = [&](RtClusterBvhNode nd) {
+            nd.left_first = nd.prim_count > 0
+                                ? nd.left_first + leaf_base
+                                : node_base + nd.left_first - 1u;
+            return nd;
+        };
+        bvh.nodes[tasks[i].node] = remap(s.nodes[0]);
+        for (size_t k = 1; k < s.nodes.size(); ++k) {
+            bvh.nodes.push_back(remap(s.nodes[k]));
+        }
+        bvh.leaf_indices.insert(bvh.leaf_indices.end(),
+                                s.leaves.begin(), s.leaves.end());
+    }
+    bvh.sah_cost = rtClusterBvhSahCost(bvh);
+    return bvh;
+}
+
+bool refitRtClusterBvh(RtClusterBvh& bvh,
+                       const std::vector<RtClusterSphere>& spheres) {
+    if (spheres.size() != bvh.sphere_count || bvh.nodes.empty()) return false;
+    uint32_t live = 0;
+    for (const RtClusterSphere& s : spheres) live += s.radius >= 0.0f;
+    uint32_t live_in_tree = 0;
+    for (uint32_t idx : bvh.leaf_indices) {
+        live_in_tree += spheres[idx].radius >= 0.0f;
+    }
+    if (live != live_in_tree) return false;
+
+    for (size_t k = bvh.nodes.size(); k-- > 0;) {
+        RtClusterBvhNode& nd = bvh.nodes[k];
+        Box b = emptyBox();
+        if (nd.prim_count > 0) {
+            for (uint32_t i = 0; i < nd.prim_count; ++i) {
+                const RtClusterSphere& s =
+                    spheres[bvh.leaf_indices[nd.left_first + i]];
+                if (s.radius >= 0.0f) grow(b, sphereBox(s));
+            }
+        } else if (k > 0 || !bvh.leaf_indices.empty()) {
+            grow(b, nodeBox(bvh.nodes[nd.left_first]));
+            grow(b, nodeBox(bvh.nodes[nd.left_first + 1]));
+        }
+        setNodeBox(nd, b);
+    }
+    bvh.live_count = live;
+    bvh.sah_cost = rtClusterBvhSahCost(bvh);
+    return true;
+}
+
+float rtClusterBvhSahCost(const RtClusterBvh& bvh) {
+    if (bvh.nodes.empty()) return 0.0f;
+    const float root = area(nodeBox(bvh.nodes[0]));
+    if (!(root > 0.0f)) return 0.0f;
+    double cost = 0.0;
+    for (const RtClusterBvhNode& nd : bvh.nodes) {
+        const double a = area(nodeBox(nd));
+        cost += nd.prim_count > 0 ? a * nd.prim_count : a;
+    }
+    return static_cast<float>(cost / root);
+}
+
+bool validateRtClusterBvh(const RtClusterBvh& bvh,
+                          const std::vector<RtClusterSphere>& spheres) {
+    if (bvh.nodes.empty() || spheres.size() != bvh.sphere_count) return false;
+    auto contains = [](const Box& outer, const Box& inner) {
+        for (int a = 0; a < 3; ++a) {
+            if (inner.mn[a] < outer.mn[a] || inner.mx[a] > outer.mx[a]) {
+                return false;
+            }
+        }
+        return true;
+    };
+    std::vector<uint8_t> seen(spheres.size(), 0);
+    std::vector<uint8_t> reached(bvh.nodes.size(), 0);
+    const bool empty_root = bvh.leaf_indices.empty();
+    std::vector<uint32_t> stack{ 0u };
+    while (!stack.empty()) {
+        const uint32_t k = stack.back();
+        stack.pop_back();
+        if (k >= bvh.nodes.size() || reached[k]) return false;
+        reached[k] = 1;
+        const RtClusterBvhNode& nd = bvh.nodes[k];
+        const Box b = nodeBox(nd);
+        if (nd.prim_count > 0) {
+            if (size_t(nd.left_first) + nd.prim_count > bvh.leaf_indices.size())
+                return false;
+            for (uint32_t i = 0; i < nd.prim_count; ++i) {
+                const uint32_t idx = bvh.leaf_indices[nd.left_first + i];
+                if (idx >= spheres.size() || seen[idx]) return false;
+                seen[idx] = 1;
+                if (spheres[idx].radius >= 0.0f &&
+                    !contains(b, sphereBox(spheres[idx]))) {
+                    return false;
+                }
+            }
+            continue;
+        }
+        if (k == 0 && empty_root) continue;
+        const uint32_t l = nd.left_first;
+        if (l <= k || size_t(l) + 1 >= bvh.nodes.size()) return false;
+        for (uint32_t c = l; c <= l + 1; ++c) {
+            const Box cb = nodeBox(bvh.nodes[c]);
+            if (!isEmpty(cb) && !contains(b, cb)) return false;
+        }
+        stack.push_back(l);
+        stack.push_back(l + 1);
+    }
+    for (uint8_t r : reached) {
+        if (!r) return false;
+    }
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        if (spheres[i].radius >= 0.0f && !seen[i]) return false;
+    }
+    return true;
+}
+
+} // namespace scene_rendering
+} // namespace engine
@@ -0,0 +1,93 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// rt_cluster_bvh.h — CPU builder for the software-RT shadow BVH over the
+// ClusterRenderer's clusters.
+//
+// Input is a snapshot of every cluster's bounding sphere (xyz centre, w
+// radius) in global cluster order; the tree's leaves reference those global
+// indices.  Slots with a negative radius are scene-database placeholders
+// (free headroom, removed objects) and are left out of the tree entirely.
+//
+// Node layout is bit-identical to glsl::RtBvhNode (32 B, std430):
+//   inner node: prim_count == 0, left_first = LEFT child, right child is
+//               always left_first + 1
+//   leaf node : prim_count  > 0, left_first = offset into leaf_indices
+// Children are always stored after their parent, so a reverse sweep over
+// the node array visits every node after both of its children — refit()
+// relies on that.
+//
+// Two builders:
+//   kBinnedSah — 16-bin SAH on all three axes.  The top of the tree is
+//                split on the calling thread until there are enough
+//                independent subtrees, which are then built in parallel
+//                on the pool and stitched in a fixed order, so the result
+//                does not depend on the thread count.
+//   kMedian    — the original median split on the widest centroid axis,
+//                kept to compare node quality and build time against.
+//
+// Pure CPU, no GPU or glm dependency.  A build only reads its arguments,
+// so it can run on any thread against a private snapshot.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+namespace helper { class ThreadPool; }
+namespace scene_rendering {
+
+struct RtClusterSphere {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    float radius = -1.0f;                  // < 0: placeholder, not in tree
+};
+
+struct RtClusterBvhNode {
+    float    aabb_min[3];
+    uint32_t left_first;
+    float    aabb_max[3];
+    uint32_t prim_count;
+};
+static_assert(sizeof(RtClusterBvhNode) == 32, "must match glsl::RtBvhNode");
+
+enum class RtClusterBvhBuilder : uint8_t {
+    kBinnedSah,
+    kMedian,
+};
+
+struct RtClusterBvh {
+    std::vector<RtClusterBvhNode> nodes;
+    std::vector<uint32_t>         leaf_indices;   // global cluster indices
+    uint32_t sphere_count = 0;    // snapshot size the tree was built over
+    uint32_t live_count   = 0;    // spheres actually referenced by leaves
+    float    sah_cost     = 0.0f; // at build / last refit, see sahCost()
+};
+
+// Build over `spheres`.  `pool` may be null (fully serial); the call blocks
+// until the tree is complete and must not be made from a pool worker.
+// `max_leaf_size` bounds every leaf; SAH may stop earlier when splitting
+// does not pay.
+RtClusterBvh buildRtClusterBvh(const std::vector<RtClusterSphere>& spheres,
+                               RtClusterBvhBuilder builder,
+                               helper::ThreadPool* pool = nullptr,
+                               uint32_t max_leaf_size = 4);
+
+// Recompute every node box bottom-up from `spheres` without touching the
+// topology.  Spheres that turned into placeholders leave empty (inverted)
+// boxes behind.  Returns false — and leaves `bvh` unchanged — when the
+// topology no longer covers the scene: a different snapshot size, or a
+// live sphere that is not referenced by any leaf (an added object).
+bool refitRtClusterBvh(RtClusterBvh& bvh,
+                       const std::vector<RtClusterSphere>& spheres);
+
+// Surface-area heuristic cost of the tree, normalised by the root area:
+// one unit per inner-node visit plus one per cluster test.  Empty nodes
+// count zero.  Lower is better.
+float rtClusterBvhSahCost(const RtClusterBvh& bvh);
+
+// Structural self-check for the unit tests: every live sphere referenced
+// exactly once, child order, and each node box containing its children /
+// prim boxes.
+bool validateRtClusterBvh(const RtClusterBvh& bvh,
+                          const std::vector<RtClusterSphere>& spheres);
+
+} // namespace scene_rendering
+} // namespace engine
@@ -0,0 +1,89 @@
+#include "scene_range_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace engine {
+namespace scene_rendering {
+
+void SceneRangeAllocator::reset(uint32_t used, uint32_t capacity) {
+    free_.clear();
+    capacity_ = std::max(used, capacity);
+    free_count_ = capacity_ - used;
+    if (free_count_ > 0) {
+        free_.emplace(used, free_count_);
+    }
+}
+
+void SceneRangeAllocator::extend(uint32_t first_free, uint32_t capacity) {
+    if (capacity <= capacity_) return;
+    first_free = std::clamp(first_free, capacity_, capacity);
+    capacity_ = capacity;
+    if (first_free < capacity) {
+        free(first_free, capacity - first_free);
+    }
+}
+
+uint32_t SceneRangeAllocator::allocate(uint32_t count) {
+    if (count == 0 || count > free_count_) return kInvalidOffset;
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+        if (it->second < count) continue;
+        const uint32_t offset = it->first;
+        const uint32_t rest = it->second - count;
+        free_.erase(it);
+        if (rest > 0) {
+            free_.emplace(offset + count, rest);
+        }
+        free_count_ -= count;
+        return offset;
+    }
+    return kInvalidOffset;
+}
+
+void SceneRangeAllocator::free(uint32_t offset, uint32_t count) {
+    if (count == 0 || offset >= capacity_) return;
+    count = std::min(count, capacity_ - offset);
+    uint32_t end = offset + count;
+
+    // Reject anything that overlaps an already-free range (double free).
+    auto next = free_.lower_bound(offset);
+    if (next != free_.end() && next->first < end) return;
+    if (next != free_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second > offset) return;
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            free_.erase(prev);
+        }
+    }
+    if (next != free_.end() && next->first == end) {
+        end += next->second;
+        free_.erase(next);
+    }
+    free_.emplace(offset, end - offset);
+    free_count_ += count;
+}
+
+uint32_t SceneRangeAllocator::largestFreeRange() const {
+    uint32_t best = 0;
+    for (const auto& r : free_) best = std::max(best, r.second);
+    return best;
+}
+
+bool SceneRangeAllocator::validate() const {
+    uint64_t sum = 0;
+    uint64_t prev_end = 0;
+    bool first = true;
+    for (const auto& r : free_) {
+        if (r.second == 0) return false;
+        if (!first && r.first <= prev_end) return false;   // overlap / adjacent
+        if (uint64_t(r.first) + r.second > capacity_) return false;
+        prev_end = uint64_t(r.first) + r.second;
+        sum += r.second;
+        first = false;
+    }
+    return sum == free_count_;
+}
+
+} // namespace scene_rendering
+} // namespace engine
@@ -0,0 +1,64 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+// scene_range_allocator.h — free-list sub-allocation of element ranges inside
+// the ClusterRenderer's merged scene buffers.
+//
+// The merged cluster / vertex / index / material arrays are sized with
+// headroom at finalize, and the editor's live add / remove path carves one
+// contiguous range per stream out of that headroom instead of re-packing the
+// whole scene.  Offsets and counts are in ELEMENTS of the owning array, not
+// bytes — each ClusterRenderer stream keeps its own allocator.
+//
+// Bookkeeping is a map of free ranges (offset → count): first-fit allocate,
+// free() coalesces with both neighbours, so a placed-and-deleted object
+// leaves no fragment behind once its neighbours are gone too.  Live ranges
+// are NOT tracked — the caller hands the same (offset, count) back to free(),
+// which is what lets the initial packed scene be one implicit "used" prefix.
+//
+// Pure CPU, not thread-safe (render thread only).
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdint>
+#include <map>
+
+namespace engine {
+namespace scene_rendering {
+
+class SceneRangeAllocator {
+public:
+    static constexpr uint32_t kInvalidOffset = 0xffffffffu;
+
+    // [0, used) is occupied, [used, capacity) is free.  Drops all state.
+    void reset(uint32_t used, uint32_t capacity);
+
+    // Grow to `capacity`.  [this->capacity(), first_free) becomes occupied
+    // (content appended past the old capacity by a full re-finalize) and
+    // [first_free, capacity) free.  No-op when `capacity` does not grow.
+    void extend(uint32_t first_free, uint32_t capacity);
+
+    // First-fit.  Returns kInvalidOffset when no free range holds `count`.
+    // `count` must be > 0.
+    uint32_t allocate(uint32_t count);
+
+    // Return a range previously obtained from allocate() (or part of the
+    // implicit used prefix).  Double frees are ignored.
+    void free(uint32_t offset, uint32_t count);
+
+    uint32_t capacity() const { return capacity_; }
+    uint32_t freeCount() const { return free_count_; }
+    uint32_t largestFreeRange() const;
+    uint32_t freeRangeCount() const {
+        return static_cast<uint32_t>(free_.size());
+    }
+
+    // Structural self-check (ranges disjoint, non-adjacent, in bounds, sum
+    // matches freeCount).  Used by the unit tests.
+    bool validate() const;
+
+private:
+    std::map<uint32_t, uint32_t> free_;   // offset → count
+    uint32_t capacity_   = 0;
+    uint32_t free_count_ = 0;
+};
+
+} // namespace scene_rendering
+} // namespace engine
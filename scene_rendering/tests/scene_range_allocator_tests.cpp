@@ -0,0 +1,152 @@
+// ─────────────────────────────────────────────────────────────────────────────
+// scene_range_allocator_tests.cpp — standalone unit tests for the free-list
+// range allocator behind ClusterRenderer's live scene database
+// (scene_rendering/scene_range_allocator.*).
+//
+// Pure CPU: checks the implicit used prefix, first-fit placement, coalescing
+// with either and both neighbours, double-free rejection, extend() keeping
+// appended content occupied, and a randomised add/remove simulation that
+// verifies live ranges never overlap and everything coalesces back to one
+// free range once the scene is empty.
+//
+// Build:
+//   g++ -std=c++20 -Iscene_rendering
+//       scene_rendering/tests/scene_range_allocator_tests.cpp
+//       scene_rendering/scene_range_allocator.cpp -o scene_range_allocator_tests
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "scene_range_allocator.h"
+
+using engine::scene_rendering::SceneRangeAllocator;
+
+static int g_checks = 0;
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        ++g_checks;                                                           \
+        if (!(cond)) {                                                        \
+            std::printf("FAIL: %s  (line %d)\n", #cond, __LINE__);            \
+            std::exit(1);                                                     \
+        }                                                                     \
+    } while (0)
+
+static constexpr uint32_t kInvalid = SceneRangeAllocator::kInvalidOffset;
+
+static void testPrefixAndFirstFit() {
+    SceneRangeAllocator a;
+    a.reset(100, 164);
+    CHECK(a.capacity() == 164);
+    CHECK(a.freeCount() == 64);
+    CHECK(a.validate());
+
+    CHECK(a.allocate(0) == kInvalid);
+    CHECK(a.allocate(65) == kInvalid);
+    const uint32_t r0 = a.allocate(16);
+    const uint32_t r1 = a.allocate(16);
+    CHECK(r0 == 100);
+    CHECK(r1 == 116);
+    CHECK(a.freeCount() == 32);
+
+    // Freeing part of the used prefix makes it allocatable, lowest first.
+    a.free(10, 8);
+    CHECK(a.allocate(8) == 10);
+    CHECK(a.allocate(32) == 132);
+    CHECK(a.freeCount() == 0);
+    CHECK(a.allocate(1) == kInvalid);
+    CHECK(a.validate());
+}
+
+static void testCoalescing() {
+    SceneRangeAllocator a;
+    a.reset(0, 30);
+    const uint32_t x = a.allocate(10);
+    const uint32_t y = a.allocate(10);
+    const uint32_t z = a.allocate(10);
+    CHECK(x == 0 && y == 10 && z == 20);
+
+    a.free(x, 10);
+    a.free(z, 10);
+    CHECK(a.freeRangeCount() == 2);
+    a.free(y, 10);                          // joins both neighbours
+    CHECK(a.freeRangeCount() == 1);
+    CHECK(a.largestFreeRange() == 30);
+    CHECK(a.validate());
+
+    // Double free and overlapping free are ignored.
+    a.free(5, 10);
+    CHECK(a.freeCount() == 30);
+    CHECK(a.validate());
+}
+
+static void testExtend() {
+    SceneRangeAllocator a;
+    a.reset(50, 60);
+    // A full re-finalize appended 30 elements past the old capacity and
+    // wants 20 more headroom.
+    a.extend(90, 110);
+    CHECK(a.capacity() == 110);
+    CHECK(a.freeCount() == 30);
+    CHECK(a.freeRangeCount() == 2);
+    CHECK(a.allocate(20) == 90);
+    CHECK(a.allocate(10) == 50);
+    CHECK(a.freeCount() == 0);
+    // Shrinking is a no-op.
+    a.extend(0, 40);
+    CHECK(a.capacity() == 110);
+    CHECK(a.validate());
+}
+
+static void testRandomised() {
+    std::mt19937 rng(1234);
+    SceneRangeAllocator a;
+    const uint32_t cap = 1u << 16;
+    a.reset(0, cap);
+    std::vector<std::pair<uint32_t, uint32_t>> live;
+    std::vector<uint8_t> owner(cap, 0);
+
+    for (int step = 0; step < 20000; ++step) {
+        const bool add = live.empty() || (rng() % 100) < 55;
+        if (add) {
+            const uint32_t n = 1 + rng() % 900;
+            const uint32_t off = a.allocate(n);
+            if (off == kInvalid) {
+                CHECK(a.largestFreeRange() < n);
+                continue;
+            }
+            CHECK(off + n <= cap);
+            bool clash = false;
+            for (uint32_t i = off; i < off + n; ++i) {
+                clash |= owner[i] != 0;
+                owner[i] = 1;
+            }
+            CHECK(!clash);
+            live.emplace_back(off, n);
+        } else {
+            const size_t k = rng() % live.size();
+            const auto r = live[k];
+            live[k] = live.back();
+            live.pop_back();
+            for (uint32_t i = r.first; i < r.first + r.second; ++i) owner[i] = 0;
+            a.free(r.first, r.second);
+        }
+        if (step % 1000 == 0) CHECK(a.validate());
+    }
+    for (const auto& r : live) a.free(r.first, r.second);
+    CHECK(a.freeCount() == cap);
+    CHECK(a.freeRangeCount() == 1);
+    CHECK(a.validate());
+}
+
+int main() {
+    testPrefixAndFirstFit();
+    testCoalescing();
+    testExtend();
+    testRandomised();
+    std::printf("scene_range_allocator_tests: %d checks passed\n", g_checks);
+    return 0;
+}
@@ -1601,7 +1601,7 @@ uint64_t VirtualTextureManager::albedoTileCacheBytes(
 
 bool VirtualTextureManager::encodeAlbedoTileCacheCpu(
     const uint8_t* rgba, uint32_t width, uint32_t height,
-    std::vector<uint8_t>& out_blob) {
+    std::vector<uint8_t>& out_blob, uint32_t max_threads) {
     out_blob.clear();
     if (!rgba || width == 0 || height == 0) return false;
 
@@ -1680,7 +1680,9 @@ bool VirtualTextureManager::encodeAlbedoTileCacheCpu(
     };
 
     const uint32_t n_threads = std::max(
-        1u, std::min(std::thread::hardware_concurrency(), 16u));
+        1u, std::min(max_threads ? max_threads
+                                 : std::thread::hardware_concurrency(),
+                     16u));
     if (n_threads <= 1 || total_pages < 8) {
         for (uint32_t e = 0; e < total_pages; ++e) encode_entry(e);
     } else {
@@ -326,10 +326,12 @@ public:
     // runtime, so a baked blob can be handed straight to
     // registerMaterial(..., albedo_bc7_tiles).  Static + CPU-only: the
     // import bake calls it without a VT instance or GPU.  Multi-threaded
-    // internally.
+    // internally on up to `max_threads` threads (0 = all hardware
+    // threads, capped at 16) — a bake encoding several textures at once
+    // splits the cores between them instead of oversubscribing.
     static bool encodeAlbedoTileCacheCpu(
         const uint8_t* rgba, uint32_t width, uint32_t height,
-        std::vector<uint8_t>& out_blob);
+        std::vector<uint8_t>& out_blob, uint32_t max_threads = 0);
     // Expected blob size for a width×height source (0 for degenerate
     // dims) — bake writes it, loaders validate against it.
     static uint64_t albedoTileCacheBytes(uint32_t width, uint32_t height);
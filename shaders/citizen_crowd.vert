@@ -0,0 +1,215 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#include "global_definition.glsl.h"
+
+// ── ONE RECORD PER PERSON, POSED HERE ───────────────────────────────
+// citizen.vert takes a finished part transform per instance: 80 B for
+// every box, six boxes a detailed figure, built on the CPU each frame.
+// This takes the 24 B CitizenRecord per PERSON (game_object/
+// citizen_pose.h) and does the posing itself: the part comes from the
+// vertex index — the body mesh is six copies of the unit cube, 24
+// vertices each, in part order — and its transform from the record and
+// the pose clock.
+//
+// This is expandCitizen() (game_object/citizen_pose.cpp) evaluated per
+// vertex.  The CPU function is the reference the unit tests pin; any
+// change to the pose table, the part layout or the duty colours has to
+// land in both.
+//
+// Two draws feed it: the far tier with the first cube only — one slot
+// per person, hidden ones included — then the detailed figures with the
+// whole body mesh.  A far record ignores the part index and draws the
+// single person-box; a hidden one collapses to a point off screen.
+layout(push_constant) uniform CitizenCrowdUniformBufferObject {
+    CitizenCrowdParams params;
+};
+
+layout(std430, set = VIEW_PARAMS_SET, binding = VIEW_CAMERA_BUFFER_INDEX)
+    readonly buffer CameraInfoBuffer {
+    ViewCameraInfo camera_info;
+};
+
+layout(location = VINPUT_POSITION) in vec3 in_position;
+layout(location = VINPUT_NORMAL) in vec3 in_normal;
+
+// per-instance: the CitizenRecord, see citizen_pose.h for the packing
+layout(location = 10) in vec3 in_root;
+layout(location = 11) in vec2 in_angles;     // yaw, walk phase / 2*pi
+layout(location = 12) in uint in_bits;       // act | duty | flags | seed
+layout(location = 13) in vec2 in_size;       // height, bulk / size range
+
+layout(location = 0) out vec3 out_normal_ws;
+layout(location = 1) out vec3 out_position_ws;
+layout(location = 2) out vec4 out_color;
+
+const float kTwoPi = 6.28318531;
+const float kFourPi = 12.56637061;
+const float kSizeRange = 4.0;              // kCitizenSizeRange
+const uint  kDetailed = 1u << 9;
+const uint  kLying = 1u << 10;
+const uint  kSeated = 1u << 11;
+const uint  kHidden = 1u << 12;
+
+// Activity enum, citizen_pose.h
+const int kActWalk = 1;
+const int kActSit = 2;
+const int kActCook = 3;
+const int kActBrowse = 4;
+const int kActCare = 5;
+const int kActDeskWork = 6;
+const int kActPlay = 7;
+const int kActSleepish = 8;
+const int kActWash = 9;
+
+// dutyColor(), citizen_pose.cpp
+const vec3 kDutyColor[18] = vec3[](
+    vec3(0.6, 0.6, 0.6),
+    vec3(0.92, 0.95, 0.98), vec3(0.95, 0.75, 0.80),
+    vec3(0.25, 0.60, 0.35), vec3(0.16, 0.22, 0.45),
+    vec3(0.10, 0.16, 0.38), vec3(0.75, 0.15, 0.10),
+    vec3(0.92, 0.90, 0.85), vec3(0.30, 0.28, 0.30),
+    vec3(0.85, 0.55, 0.15), vec3(0.35, 0.42, 0.55),
+    vec3(0.55, 0.35, 0.60), vec3(0.85, 0.75, 0.20),
+    vec3(0.90, 0.70, 0.75), vec3(0.55, 0.55, 0.55),
+    vec3(0.40, 0.35, 0.30), vec3(0.70, 0.55, 0.75),
+    vec3(0.80, 0.50, 0.20));
+
+// glm::rotate about +X / +Y, applied to a vector
+vec3 rotX(vec3 v, float a) {
+    float c = cos(a), s = sin(a);
+    return vec3(v.x, c * v.y - s * v.z, s * v.y + c * v.z);
+}
+vec3 rotY(vec3 v, float a) {
+    float c = cos(a), s = sin(a);
+    return vec3(c * v.x + s * v.z, v.y, -s * v.x + c * v.z);
+}
+
+void main() {
+    if ((in_bits & kHidden) != 0u) {
+        // every vertex at one point outside the clip volume: the box's
+        // triangles are degenerate and never reach the rasteriser
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        out_normal_ws = vec3(0.0, 1.0, 0.0);
+        out_position_ws = vec3(0.0);
+        out_color = vec4(0.0);
+        return;
+    }
+    float yaw = in_angles.x * kTwoPi;
+    float phase = in_angles.y * kTwoPi;
+    int act = int(in_bits & 15u);
+    uint duty = (in_bits >> 4) & 31u;
+    float seed = float(in_bits >> 16) / 65535.0 * kFourPi;
+    float s = in_size.x * kSizeRange / 1.75;
+    float bw = in_size.y * kSizeRange;
+    bool walking = act == kActWalk;
+    vec3 col = kDutyColor[duty < 18u ? duty : 0u];
+
+    vec3 position_ws;
+    vec3 normal_ws;
+    if ((in_bits & kDetailed) == 0u) {
+        // far tier: one person-box
+        float bob = walking ? abs(cos(phase)) * 0.03 * s : 0.0;
+        vec3 local = in_position * vec3(0.20 * s * bw, 0.875 * s,
+                                        0.13 * s * bw) +
+                     vec3(0.0, 0.875 * s, 0.0);
+        position_ws = rotY(local, yaw) + in_root + vec3(0.0, bob, 0.0);
+        normal_ws = rotY(in_normal, yaw);
+    } else {
+        bool lying = (in_bits & kLying) != 0u;
+        bool seated = (in_bits & kSeated) != 0u;
+        float swing = sin(phase);
+        float anim_phase = params.anim_t + seed;
+        float root_y = in_root.y;
+        float pitch = 0.0;
+        float leg_l = 0.0, leg_r = 0.0, arm_l = 0.0, arm_r = 0.0;
+        bool sitting = false;
+        if (act == kActWalk) {
+            leg_l = swing * 0.55;
+            leg_r = -swing * 0.55;
+            arm_l = -swing * 0.45;
+            arm_r = swing * 0.45;
+            root_y += abs(cos(phase)) * 0.03 * s;
+        } else if (act == kActSleepish) {
+            if (lying) {
+                pitch = -1.5707963;
+                root_y += 0.12 * s;
+            } else {
+                arm_l = arm_r = 0.04 * sin(anim_phase * 0.5);
+            }
+        } else if (act == kActSit || act == kActDeskWork) {
+            if (seated) {
+                sitting = true;
+                leg_l = leg_r = -1.45;
+                arm_l = arm_r = act == kActDeskWork ? -0.9 : -0.4;
+            } else {
+                arm_l = arm_r = 0.10 * sin(anim_phase * 0.5);
+            }
+        } else if (act == kActCook) {
+            arm_r = -1.1 + 0.25 * sin(params.anim_t * 4.0 + phase);
+            arm_l = -0.5;
+            pitch = 0.12;
+        } else if (act == kActBrowse) {
+            arm_r = -0.9;
+            pitch = 0.08;
+        } else if (act == kActWash) {
+            arm_l = -1.15 + 0.10 * sin(anim_phase * 3.0);
+            arm_r = -1.15 - 0.10 * sin(anim_phase * 3.0);
+            pitch = 0.15;
+        } else if (act == kActCare) {
+            arm_l = -0.7 + 0.2 * sin(anim_phase * 2.0);
+            pitch = 0.16;
+        } else if (act == kActPlay) {
+            arm_l = sin(params.anim_t * 5.0 + phase) * 0.8;
+            arm_r = -sin(params.anim_t * 5.0 + phase) * 0.8;
+        } else {
+            arm_l = arm_r = 0.10 * sin(anim_phase * 0.5);
+        }
+        if (!walking) {
+            float br = sin(anim_phase * 1.5);
+            if (!lying) pitch += 0.015 * br;
+            root_y += 0.008 * s * br;
+        }
+        if (sitting) root_y -= 0.42 * s;
+
+        // torso, head, arm l/r, leg l/r — expandCitizen's order
+        int part = gl_VertexIndex / 24;
+        vec3 centre, half_ext, pivot = vec3(0.0);
+        float rot = 0.0;
+        if (part == 0) {
+            centre = vec3(0.0, 1.18 * s, 0.0);
+            half_ext = vec3(0.17 * s * bw, 0.27 * s, 0.11 * s * bw);
+        } else if (part == 1) {
+            centre = vec3(0.0, 1.62 * s, 0.0);
+            half_ext = vec3(0.105 * s, 0.115 * s, 0.105 * s);
+            col = mix(vec3(0.87, 0.72, 0.58), col, 0.15);
+        } else if (part <= 3) {
+            float side = part == 2 ? -1.0 : 1.0;
+            centre = vec3(side * 0.235 * s * bw, 1.14 * s, 0.0);
+            half_ext = vec3(0.05 * s, 0.27 * s, 0.05 * s);
+            pivot = vec3(centre.x, 1.40 * s, 0.0);
+            rot = part == 2 ? arm_l : arm_r;
+        } else {
+            float side = part == 4 ? -1.0 : 1.0;
+            centre = vec3(side * 0.09 * s, 0.47 * s, 0.0);
+            half_ext = vec3(0.07 * s * bw, 0.44 * s, 0.07 * s * bw);
+            pivot = vec3(centre.x, 0.90 * s, 0.0);
+            rot = part == 4 ? leg_l : leg_r;
+        }
+        vec3 local = in_position * half_ext + centre;
+        vec3 n = in_normal;
+        if (rot != 0.0) {
+            local = pivot + rotX(local - pivot, rot);
+            n = rotX(n, rot);
+        }
+        position_ws = rotY(rotX(local, pitch), yaw) +
+                      vec3(in_root.x, root_y, in_root.z);
+        normal_ws = rotY(rotX(n, pitch), yaw);
+    }
+
+    gl_Position = camera_info.view_proj * vec4(position_ws, 1.0);
+    out_position_ws = position_ws;
+    // Face normals of an axis-aligned box keep their direction under
+    // the part's scale, so rotating them is the whole transform.
+    out_normal_ws = normalize(normal_ws);
+    out_color = vec4(col, 0.12);
+}
@@ -1014,6 +1014,18 @@ struct CitizenDrawParams {
     vec4            color;
 };
 
+// Push constants for the GPU-expanded citizen draw (citizen_crowd.vert),
+// where the instance stream is one CitizenRecord per PERSON and the
+// parts are posed in the vertex shader.  anim_t is the shared pose
+// clock (CitizenSystem::anim_t_, real seconds wrapped at 8*pi).  Fits
+// inside the CitizenDrawParams range the pipeline layout declares.
+struct CitizenCrowdParams {
+    float           anim_t;
+    float           pad0;
+    float           pad1;
+    float           pad2;
+};
+
 // Push constants for the "Nanite-lite" per-cluster flat-color debug draw.
 // Populated on the C++ side by the ClusterDebugDraw helper, consumed by
 // cluster_debug.vert / cluster_debug.frag. Only the model transform is
@@ -9,12 +9,55 @@
 #include "renderer/renderer_helper.h"
 #include "helper/engine_helper.h"
 #include "audio/tts_engine.h"   // speak NPC dialog lines
+#include "audio/sentence_segmenter.h"
+#include "helper/dialog_llm.h"
 
 #include "chat_box.h"
 
 namespace engine {
 namespace ui {
 
+namespace {
+
+// Voice the dialogue model's reply WHILE it streams: every sentence goes to
+// TTS the moment it is complete — the first with speak() (cutting off what
+// the NPC was saying), the rest with enqueue() so they play back to back.
+// `busy` must be read before `reply`, so a finished turn is seen whole.
+void voiceStreamedReply(bool busy, const std::string& reply) {
+    static uint64_t s_turn = 0;
+    static size_t s_fed = 0;
+    static bool s_started = false;
+    static bool s_flushed = true;
+    static engine::audio::SentenceSegmenter s_seg;
+
+    const uint64_t turn = engine::helper::DialogLlm::turn();
+    if (turn != s_turn) {
+        s_turn = turn;
+        s_seg.reset();
+        s_fed = 0;
+        s_started = false;
+        s_flushed = false;
+    }
+    if (s_flushed) return;
+
+    std::vector<std::string> sentences;
+    if (reply.size() > s_fed) {
+        s_seg.feed(reply.substr(s_fed), sentences);
+        s_fed = reply.size();
+    }
+    if (!busy) {
+        s_seg.flush(sentences);
+        s_flushed = true;
+    }
+    for (const auto& sentence : sentences) {
+        if (s_started) engine::audio::TtsEngine::enqueue(sentence);
+        else           engine::audio::TtsEngine::speak(sentence);
+        s_started = true;
+    }
+}
+
+} // namespace
+
 bool ChatBox::draw(
     const std::shared_ptr<renderer::CommandBuffer>& cmd_buf,
     const std::shared_ptr<renderer::RenderPass>& render_pass,
@@ -84,12 +127,24 @@ bool ChatBox::draw(
     };
     std::string currentQuestionLine = "You got any questions, now's the time.";
 
+    // Once the dialogue model is up and has been asked something, its reply
+    // replaces the scripted lines — shown as it streams in.
+    const bool llm = engine::helper::DialogLlm::available();
+    const bool llm_busy = llm && engine::helper::DialogLlm::busy();
+    const std::string llm_reply =
+        llm ? engine::helper::DialogLlm::reply() : std::string();
+    const bool show_llm = llm && (llm_busy || !llm_reply.empty());
+
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.8f, 0.8f, 1.0f)); // Slightly dimmer for dialogue
-    for (const auto& line : currentDialogueLines) {
-        ImGui::TextWrapped("%s", line.c_str()); // TextWrapped is crucial here with the defined width
+    if (show_llm) {
+        ImGui::TextWrapped("%s%s", llm_reply.c_str(), llm_busy ? " ..." : "");
+    } else {
+        for (const auto& line : currentDialogueLines) {
+            ImGui::TextWrapped("%s", line.c_str()); // TextWrapped is crucial here with the defined width
+        }
+        ImGui::Spacing(); // Adds a small vertical space
+        ImGui::TextWrapped("%s", currentQuestionLine.c_str());
     }
-    ImGui::Spacing(); // Adds a small vertical space
-    ImGui::TextWrapped("%s", currentQuestionLine.c_str());
     ImGui::PopStyleColor(); // Pop text color
 
     // ── Text-to-voice ────────────────────────────────────────────────────
@@ -97,8 +152,11 @@ bool ChatBox::draw(
     // every frame, so keying on the concatenated text is what gives
     // "say each new line once" semantics).  TtsEngine synthesizes on a
     // worker thread and plays on the voice bus; a no-op when the
-    // sherpa-onnx backend or the voice model is absent.
-    {
+    // sherpa-onnx backend or the voice model is absent.  A model reply is
+    // spoken sentence by sentence as it streams instead.
+    if (show_llm) {
+        voiceStreamedReply(llm_busy, llm_reply);
+    } else {
         std::string spoken;
         for (const auto& line : currentDialogueLines) {
             spoken += line;
@@ -108,6 +166,10 @@ bool ChatBox::draw(
         static std::string s_last_spoken;
         if (spoken != s_last_spoken) {
             s_last_spoken = spoken;
+            // Scripted lines come back every session: marking them stock
+            // (speak() takes over the prefetch) keeps them on disk.
+            engine::audio::TtsEngine::prefetch(spoken, 0, 1.0f,
+                                               /*stock=*/true);
             engine::audio::TtsEngine::speak(spoken);
         }
     }
@@ -181,7 +243,8 @@ bool ChatBox::draw(
 
         if (ImGui::Selectable(dialogueOptions[i].c_str(), isSelected, ImGuiSelectableFlags_DontClosePopups)) {
             currentlySelectedOption = i;
-            // ... Your game logic ...
+            // Ask the dialogue model; its reply streams into the lines above.
+            if (llm) engine::helper::DialogLlm::send(dialogueOptions[i]);
         }
         ImGui::PopID();
         ImGui::PopStyleColor();
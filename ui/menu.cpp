@@ -870,20 +870,16 @@ void Menu::init(
     rt_texture_id_   = ImTextureID(0);
     main_texture_id_ = ImTextureID(0);
 
-    // Content-browser thumbnail textures hit the SAME hazard: their
+    // Content-browser thumbnail atlas pages hit the SAME hazard: their
     // ImTextureIDs are VkDescriptorSets allocated from the descriptor pool
     // that cleanupSwapChain just destroyed.  The underlying Vulkan images
-    // (TextureInfo) survive recreation, so re-register each surviving view
-    // with the fresh pool; drop any that lost their view.  Without this the
-    // grid binds a dangling descriptor on the next frame and the NVIDIA
-    // driver faults inside ImGui_ImplVulkan_RenderDrawData (seen on resize).
-    for (auto& kv : thumb_cache_) {
-        ThumbTex& t = kv.second;
-        if (t.failed) continue;
-        if (t.info && t.info->view)
-            t.id = renderer::Helper::addImTextureID(sampler_, t.info->view);
-        else
-            t.failed = true;
+    // (TextureInfo) survive recreation, so re-register each page's view
+    // with the fresh pool.  Without this the grid binds a dangling
+    // descriptor on the next frame and the NVIDIA driver faults inside
+    // ImGui_ImplVulkan_RenderDrawData (seen on resize).
+    for (auto& page : thumb_pages_) {
+        if (page.info && page.info->view)
+            page.id = renderer::Helper::addImTextureID(sampler_, page.info->view);
     }
     // Retired (superseded) thumbnail textures are no longer referenced by the
     // UI; the device is idle here, so free them outright rather than
@@ -924,6 +920,19 @@ bool Menu::draw(
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
+    // Reap finished voices and re-rank real vs virtual ones (cheap no-op
+    // until something has been played).
+    engine::audio::AudioEngine::update();
+
+    // Texture updates go out first: on this frame's command buffer, before
+    // any render pass, ordered behind the frames still reading them.
+    ++draw_frame_;
+    recordFrameUploads(cmd_buf);
+    // Texture cache residency runs on the same clock.  The scene has been
+    // recorded by now, so every texture this frame draws is already held
+    // by a drawable and cannot be picked for eviction.
+    if (device_) engine::helper::updateTextureResidency(device_, draw_frame_);
+
     // ── Clean-viewport capture path (terrain verify loop) ─────────────
     // Begin/end the ImGui frame and run the final present-layout render
     // pass with an EMPTY draw list so the swapchain keeps the 3D scene
@@ -2736,6 +2745,14 @@ bool Menu::draw(
                             cluster_renderer_->getTotalVisible(), visBuf);
             }
             ImGui::Text("Culled:          %.1f%%", cluster_renderer_->getCullPercentage());
+            {
+                const auto db = cluster_renderer_->sceneDbStats();
+                if (db.cluster_capacity > 0) {
+                    ImGui::Text("Scene DB:        %u live, %u / %u clusters free",
+                                db.live_meshes, db.cluster_free,
+                                db.cluster_capacity);
+                }
+            }
             // Show per-mesh visibility stats.
             {
                 uint32_t total_m = cluster_renderer_->getRegisteredMeshCount();
@@ -3924,6 +3941,9 @@ bool Menu::draw(
             } else {
                 vram_dev_valid_ = false;
             }
+            // (3) Shared texture cache, as the residency manager counts it.
+            const er::ResidencyStats tex = engine::helper::textureResidencyStats();
+            vram_tex_mb_ = (double)tex.resident_bytes / (1024.0 * 1024.0);
             vram_last_poll_ = now;
         }
 
@@ -3942,13 +3962,15 @@ bool Menu::draw(
             const double free_mb = std::max(0.0, cap_mb - use_mb);
             if (dev && vram_valid_)
                 snprintf(vbuf, sizeof(vbuf),
-                         "VRAM %.1f / %.0f GB  ·  engine %.1f  ·  %.1f free",
+                         "VRAM %.1f / %.0f GB  ·  engine %.1f  ·  tex %.1f  ·  %.1f free",
                          use_mb / 1024.0, cap_mb / 1024.0,
-                         mine_mb / 1024.0, free_mb / 1024.0);
+                         mine_mb / 1024.0, vram_tex_mb_ / 1024.0,
+                         free_mb / 1024.0);
             else
                 snprintf(vbuf, sizeof(vbuf),
-                         "VRAM %.1f / %.0f GB  ·  %.1f free%s",
-                         use_mb / 1024.0, cap_mb / 1024.0, free_mb / 1024.0,
+                         "VRAM %.1f / %.0f GB  ·  tex %.1f  ·  %.1f free%s",
+                         use_mb / 1024.0, cap_mb / 1024.0,
+                         vram_tex_mb_ / 1024.0, free_mb / 1024.0,
                          dev ? "" : "  (engine only)");
         }
 
@@ -4071,6 +4093,15 @@ void Menu::destroyResources() {
         play_icon_info_.reset();
         play_icon_id_ = ImTextureID(0);
     }
+    // Thumbnail workers first (they only touch files), then the atlas.
+    thumb_queue_.reset();
+    thumb_cache_.clear();
+    thumb_uploads_.clear();
+    for (auto& page : thumb_pages_) {
+        if (page.info && device_) page.info->destroy(device_);
+    }
+    thumb_pages_.clear();
+    frame_uploads_.destroy();
 }
 
 // ============================================================================
@@ -5801,19 +5832,27 @@ bool decodeDdsToRgba(const std::string& path, int& W, int& H,
     return false;
 }
 
-}  // namespace
-
-// Produce/refresh the sidecar thumbnail for `src` and return its path (or "").
-// Thumbnails live in a hidden ".thumbnails" folder next to the asset, named
-// "<filename>.png".  Regeneration is incremental: an existing thumbnail at
-// least as new as the source is kept untouched; only a stale/missing one is
-// rebuilt.  Dispatches by type: images (stb) and .dds (decoded) are
-// box-downscaled; .gltf/.glb/.fbx are rasterised to an orbit view.
-std::string Menu::ensureThumbnail(const std::string& src) {
+// Thumbnail generator for the browser's ThumbnailQueue — runs on its
+// worker threads, so it touches nothing but the source file.  Dispatches by
+// type: images (stb), .dds (decoded) and .rwtex are box-downscaled to
+// <= kThumbnailSize; .gltf/.glb/.fbx are rasterised to one orbit view.
+// Returns false when the file has no thumbnail (the queue caches that too).
+constexpr int      kThumbnailSize = 128;
+// Bump whenever the pixels produced below change; stale cache entries are
+// then dropped wholesale instead of being served.
+constexpr uint32_t kThumbnailGeneratorVersion = 1;
+// Resident thumbnails share a few RGBA8 atlas pages (one descriptor each)
+// rather than owning a texture apiece: 4 pages x 64 slots.
+constexpr int      kThumbAtlasSize     = 1024;
+constexpr int      kThumbSlotsPerRow   = kThumbAtlasSize / kThumbnailSize;
+constexpr size_t   kMaxThumbAtlasPages = 4;
+
+bool generateThumbnail(const std::string& src,
+                       const std::atomic<bool>& cancel,
+                       engine::helper::ThumbnailPixels& out) {
     namespace fs = std::filesystem;
     namespace ar = plugins::auto_rig;
-    std::error_code ec;
-    constexpr int kThumb = 128;
+    constexpr int kThumb = kThumbnailSize;
 
     fs::path srcP(src);
     std::string ext = srcP.extension().string();
@@ -5827,23 +5866,12 @@ std::string Menu::ensureThumbnail(const std::string& src) {
     // format-1 (the BC7 VT tile cache) — either way more than a 128 px
     // thumbnail needs, so it goes through the same box-downscale below.
     const bool is_rwtex = (ext == ".rwtex");
-    if (!is_img && !is_dds && !is_model && !is_rwtex) return "";
-
-    const fs::path thumbDir = srcP.parent_path() / ".thumbnails";
-    const fs::path thumb     = thumbDir / (srcP.filename().string() + ".png");
-
-    // Incremental: keep the existing thumbnail unless the source is newer.
-    if (fs::exists(thumb, ec)) {
-        const auto t_src = fs::last_write_time(src, ec);
-        const auto t_thb = fs::last_write_time(thumb, ec);
-        if (!ec && t_src <= t_thb) return thumb.string();
-    }
-    fs::create_directories(thumbDir, ec);
+    if (!is_img && !is_dds && !is_model && !is_rwtex) return false;
 
     // ── 3D model → rasterise one auto-framed orbit view ──
     if (is_model) {
         ar::TriangleMesh mesh;
-        if (!ar::loadMeshForThumbnail(src, mesh)) return "";
+        if (!ar::loadMeshForThumbnail(src, mesh)) return false;
         // World-scale GLBs (the PCG tree / clutter / ground layers span
         // the whole 32 km map, bbox diagonal ~46 km) rasterise to a
         // meaningless dot-cloud at 128 px and cost a full CPU orbit
@@ -5858,35 +5886,45 @@ std::string Menu::ensureThumbnail(const std::string& src) {
                     "(world-scale asset)\n",
                     srcP.filename().string().c_str(),
                     thumb_ext, kThumbMaxExtentM);
-            return "";
+            return false;
         }
+        // Loading is the cheap half; don't start the raster for a tile
+        // that has scrolled away meanwhile.
+        if (cancel) return false;
         ar::SimpleRasterizer rast;
         auto caps = rast.captureOrbit(mesh, /*views*/1, kThumb,
                                       /*elevation*/15.0f, /*radius_mult*/1.5f);
-        if (caps.empty() || caps[0].color.empty()) return "";
+        if (caps.empty() || caps[0].color.empty()) return false;
         const auto& c = caps[0];
-        if (!stbi_write_png(thumb.string().c_str(), c.width, c.height, 3,
-                            c.color.data(), c.width * 3))
-            return "";
-        return thumb.string();
+        out.width  = c.width;
+        out.height = c.height;
+        out.rgba.resize((size_t)c.width * c.height * 4);
+        for (size_t i = 0, n = (size_t)c.width * c.height; i < n; ++i) {
+            out.rgba[i * 4 + 0] = c.color[i * 3 + 0];
+            out.rgba[i * 4 + 1] = c.color[i * 3 + 1];
+            out.rgba[i * 4 + 2] = c.color[i * 3 + 2];
+            out.rgba[i * 4 + 3] = 255;
+        }
+        return true;
     }
 
     // ── Image / DDS → RGBA pixels, then box-downscale to <=kThumb ──
     int w = 0, h = 0;
     std::vector<unsigned char> rgba;
     if (is_dds) {
-        if (!decodeDdsToRgba(src, w, h, rgba)) return "";
+        if (!decodeDdsToRgba(src, w, h, rgba)) return false;
     } else if (is_rwtex) {
         if (!engine::helper::readRwTex(src, w, h, rgba) ||
             w <= 0 || h <= 0 || rgba.size() < (size_t)w * h * 4)
-            return "";
+            return false;
     } else {
         int comp = 0;
         unsigned char* px = stbi_load(src.c_str(), &w, &h, &comp, STBI_rgb_alpha);
-        if (!px || w <= 0 || h <= 0) { if (px) stbi_image_free(px); return ""; }
+        if (!px || w <= 0 || h <= 0) { if (px) stbi_image_free(px); return false; }
         rgba.assign(px, px + (size_t)w * h * 4);
         stbi_image_free(px);
     }
+    if (cancel) return false;
 
     int dw = w, dh = h;
     if (w > kThumb || h > kThumb) {
@@ -5894,21 +5932,23 @@ std::string Menu::ensureThumbnail(const std::string& src) {
         dw = std::max(1, (int)(w * s));
         dh = std::max(1, (int)(h * s));
     }
-    std::vector<unsigned char> out((size_t)dw * dh * 4);
+    out.width  = dw;
+    out.height = dh;
+    out.rgba.resize((size_t)dw * dh * 4);
     for (int y = 0; y < dh; ++y) {
         for (int x = 0; x < dw; ++x) {
             const int sx = std::min(w - 1, (int)(((float)x + 0.5f) * w / dw));
             const int sy = std::min(h - 1, (int)(((float)y + 0.5f) * h / dh));
             const unsigned char* sp = rgba.data() + ((size_t)sy * w + sx) * 4;
-            unsigned char* dp = out.data() + ((size_t)y * dw + x) * 4;
+            unsigned char* dp = out.rgba.data() + ((size_t)y * dw + x) * 4;
             dp[0] = sp[0]; dp[1] = sp[1]; dp[2] = sp[2]; dp[3] = sp[3];
         }
     }
-    if (!stbi_write_png(thumb.string().c_str(), dw, dh, 4, out.data(), dw * 4))
-        return "";
-    return thumb.string();
+    return true;
 }
 
+}  // namespace
+
 // ── Full-size image viewer ──────────────────────────────────────────────────
 void Menu::openImageViewer(const std::string& path) {
     // Retire any previous full-size texture (same GPU-safety pattern as
@@ -5932,7 +5972,7 @@ void Menu::drawImageViewer() {
         return;
     }
 
-    // Lazy full-res load.  Same guard as getThumbnail: never do main-thread
+    // Lazy full-res load.  Same guard as pumpThumbnails: never do main-thread
     // GPU uploads while the async mesh loader is busy (queue/pool hazard);
     // just retry on a later frame — the window shows "Loading..." meanwhile.
     if (!image_viewer_id_ && !image_viewer_path_.empty() &&
@@ -5990,91 +6030,262 @@ void Menu::drawImageViewer() {
     ImGui::End();
 }
 
-ImTextureID Menu::getThumbnail(const std::string& src) {
-    namespace fs = std::filesystem;
-    std::error_code ec;
-    const auto src_time = fs::last_write_time(src, ec);
-
+Menu::ThumbRef Menu::getThumbnail(const std::string& src, int64_t src_mtime,
+                                  int priority) {
     auto it = thumb_cache_.find(src);
-    if (it != thumb_cache_.end()) {
-        // Reuse the cached entry unless the source changed since we built
-        // it.  This applies to FAILED entries too: the browser can catch a
-        // freshly generated file mid-write (stbi fails on the partial
-        // PNG) — the failure is retried once the source's mtime moves,
-        // instead of hiding the thumbnail forever.
-        if (ec || src_time == it->second.src_time)
-            return it->second.failed ? 0 : it->second.id;
-        // Source is newer — retire the stale GPU texture (kept alive so ImGui
-        // never touches a freed descriptor) and rebuild below.
-        if (it->second.info) retired_thumbs_.push_back(it->second.info);
+    // A changed source (new mtime from the directory index) invalidates the
+    // entry — including a FAILED one: the browser can catch a freshly
+    // generated file mid-write, and that failure must be retried once the
+    // file settles instead of hiding the thumbnail forever.
+    if (it != thumb_cache_.end() && it->second.src_mtime != src_mtime) {
+        releaseThumbSlot(it->second);
         thumb_cache_.erase(it);
-    }
-
-    if (thumb_budget_ <= 0) return 0;   // budget spent — retry next frame
+        it = thumb_cache_.end();
+    }
+    if (it == thumb_cache_.end()) {
+        it = thumb_cache_.emplace(src, ThumbTex{}).first;
+        it->second.src_mtime = src_mtime;
+    }
+    ThumbTex& t = it->second;
+    t.last_used_frame = draw_frame_;
+    if (t.page >= 0) {
+        // Placed but not copied yet: recordFrameUploads does that next
+        // frame.
+        return t.resident ? ThumbRef{ thumb_pages_[t.page].id, t.uv0, t.uv1 }
+                          : ThumbRef{};
+    }
+    // Renewed every frame the tile is visible; the queue drops it a couple
+    // of frames after the tile scrolls away.
+    if (!t.failed && thumb_queue_)
+        thumb_queue_->request(src, src_mtime, priority);
+    return ThumbRef{};
+}
 
-    // CRITICAL: do NOT create thumbnails while the async mesh loader is busy.
-    // Thumbnail generation does GPU work on the MAIN thread — ensureThumbnail()
-    // loads/rasterises a model (tinygltf/ufbx) and createTextureImage() records
-    // a command buffer + submits to a queue + allocates device memory.  The
-    // mesh-load WORKER thread does the same kinds of GPU work concurrently, and
-    // Vulkan requires external synchronisation for queues / command pools / the
-    // allocator.  Running both at once corrupts driver state and faults later
-    // inside vkAllocateDescriptorSets (the createDescriptorSets crash).  Defer
-    // all thumbnail creation until the loader has drained; cached thumbnails
-    // still display (the cache-hit path above returns before this point).
+// Once per frame, before either browser draws: advance the request queue
+// and give finished thumbnails an atlas slot.  The copy itself is recorded
+// by recordFrameUploads at the top of the next frame.
+void Menu::pumpThumbnails() {
+    const int frame = ImGui::GetFrameCount();
+    if (thumb_pump_frame_ == frame) return;
+    thumb_pump_frame_ = frame;
+
+    if (!thumb_queue_) {
+        helper::ThumbnailQueueOptions opts;
+        opts.cache_file        = ".thumbnails.bin";
+        opts.generator_version = kThumbnailGeneratorVersion;
+        opts.num_workers       = 2;
+        opts.generate          = generateThumbnail;
+        thumb_queue_ = std::make_unique<helper::ThumbnailQueue>(opts);
+    }
+    thumb_queue_->beginFrame();
+
+    // CRITICAL: no main-thread transient uploads while the async mesh
+    // loader is busy.  Its worker records / submits / allocates
+    // concurrently, and Vulkan requires external synchronisation for
+    // queues, command pools and the allocator — overlapping the two
+    // corrupted driver state and faulted later inside
+    // vkAllocateDescriptorSets.  A new atlas page is created (and
+    // transitioned) on the transient channel, so placements wait; their
+    // copies go on the frame's command buffer.  Generation itself is
+    // CPU-only and keeps running on the queue's threads; finished results
+    // simply wait in it until an idle frame.
     if (mesh_load_task_manager_ &&
         mesh_load_task_manager_->inFlightCount() > 0) {
-        return 0;   // loader active — retry on a later, idle frame
+        return;
     }
 
-    // Hard cap on cached thumbnails (bounds ImGui's own descriptor pool).
-    constexpr size_t kMaxThumbs = 192;
-    if (thumb_cache_.size() >= kMaxThumbs) return 0;
+    // Each placement is one small copy on the next frame's command buffer;
+    // a handful per frame keeps a cold folder filling in without a
+    // visible hitch.
+    constexpr int kPlacementsPerFrame = 8;
+    helper::ThumbnailResult r;
+    for (int n = 0; n < kPlacementsPerFrame && thumb_queue_->poll(r); ) {
+        auto it = thumb_cache_.find(r.path);
+        // Deleted, or superseded by an edit while it was being generated.
+        if (it == thumb_cache_.end() || it->second.src_mtime != r.src_mtime ||
+            it->second.page >= 0)
+            continue;
+        ThumbTex& t = it->second;
+        if (r.pixels.width <= 0 || r.pixels.height <= 0) {
+            t.failed = true;
+            continue;
+        }
+        // every slot still on screen or in flight
+        if (!allocThumbSlot(t, draw_frame_)) continue;
+        const int sx = (t.slot % kThumbSlotsPerRow) * kThumbnailSize;
+        const int sy = (t.slot / kThumbSlotsPerRow) * kThumbnailSize;
+        const int w  = std::min(r.pixels.width,  kThumbnailSize);
+        const int h  = std::min(r.pixels.height, kThumbnailSize);
+        // Half-texel inset: the sampler filters linearly and neighbouring
+        // slots hold unrelated images.
+        const float inv = 1.0f / (float)kThumbAtlasSize;
+        t.uv0 = ImVec2(((float)sx + 0.5f) * inv, ((float)sy + 0.5f) * inv);
+        t.uv1 = ImVec2(((float)(sx + w) - 0.5f) * inv,
+                       ((float)(sy + h) - 0.5f) * inv);
+        ThumbUpload u;
+        u.path = r.path;
+        u.page = t.page;
+        u.slot = t.slot;
+        u.size = glm::uvec2(w, h);
+        u.rgba = std::move(r.pixels.rgba);
+        thumb_uploads_.push_back(std::move(u));
+        ++n;
+    }
+}
 
-    --thumb_budget_;
+void Menu::recordFrameUploads(
+    const std::shared_ptr<er::CommandBuffer>& cmd_buf) {
+    frame_uploads_.beginFrame(draw_frame_);
+    if (!device_ || !cmd_buf) return;
 
-    ThumbTex t;
-    t.src_time = src_time;
-    const std::string thumb = ensureThumbnail(src);   // incremental: only if stale
-    if (thumb.empty()) {
-        t.failed = true;
-    } else {
+    // Streamed .ktx2 high mips read by the mesh loader.
+    helper::recordTextureMipUploads(device_, cmd_buf, frame_uploads_);
+
+    for (auto& u : thumb_uploads_) {
+        auto it = thumb_cache_.find(u.path);
+        // Dropped, re-placed or evicted since pumpThumbnails placed it.
+        if (it == thumb_cache_.end() || it->second.page != u.page ||
+            it->second.slot != u.slot || it->second.resident)
+            continue;
+        ThumbTex& t = it->second;
+        const int sx = (u.slot % kThumbSlotsPerRow) * kThumbnailSize;
+        const int sy = (u.slot / kThumbSlotsPerRow) * kThumbnailSize;
         try {
-            t.info = std::make_shared<renderer::TextureInfo>();
-            engine::helper::createTextureImage(
-                device_, thumb, renderer::Format::R8G8B8A8_UNORM, true,
-                *t.info, std::source_location::current());
-            if (t.info && t.info->view)
-                t.id = renderer::Helper::addImTextureID(sampler_, t.info->view);
-            else
-                t.failed = true;
+            renderer::Helper::update2DTextureRegion(
+                device_, cmd_buf, frame_uploads_,
+                thumb_pages_[u.page].info->image,
+                renderer::Format::R8G8B8A8_UNORM,
+                glm::ivec2(sx, sy), u.size, 4, u.rgba.data());
         } catch (...) {
+            releaseThumbSlot(t);
             t.failed = true;
-            t.info.reset();
+            continue;
         }
+        t.resident = true;
     }
-    const ImTextureID id = t.failed ? 0 : t.id;
-    thumb_cache_.emplace(src, std::move(t));
-    return id;
+    thumb_uploads_.clear();
 }
 
-void Menu::drawFolderTree(const std::string& dir, int depth,
-                          std::string& cur_dir) {
-    namespace fs = std::filesystem;
-    std::error_code ec;
-    if (!fs::exists(dir, ec) || !fs::is_directory(dir, ec)) return;
+// Slots freed by releaseThumbSlot are held back until the last frame that
+// drew them is kThumbSlotReuseFrames old (kMaxFramesInFlight + 1), so a
+// new copy never lands under a frame still sampling the old image.
+constexpr uint64_t kThumbSlotReuseFrames = 3;
+
+bool Menu::allocThumbSlot(ThumbTex& t, uint64_t frame) {
+    for (auto& page : thumb_pages_) {
+        auto& retired = page.retired_slots;
+        size_t kept = 0;
+        for (const auto& rs : retired) {
+            if (rs.second + kThumbSlotReuseFrames <= frame)
+                page.free_slots.push_back(rs.first);
+            else
+                retired[kept++] = rs;
+        }
+        retired.resize(kept);
+    }
+    for (size_t p = 0; p < thumb_pages_.size(); ++p) {
+        auto& free_slots = thumb_pages_[p].free_slots;
+        if (free_slots.empty()) continue;
+        t.page = (int)p;
+        t.slot = free_slots.back();
+        free_slots.pop_back();
+        return true;
+    }
+    if (thumb_pages_.size() < kMaxThumbAtlasPages) {
+        ThumbAtlasPage page;
+        try {
+            page.info = std::make_shared<renderer::TextureInfo>();
+            renderer::Helper::create2DTextureImage(
+                device_, renderer::Format::R8G8B8A8_UNORM,
+                glm::uvec2(kThumbAtlasSize, kThumbAtlasSize), 1, *page.info,
+                SET_2_FLAG_BITS(ImageUsage, SAMPLED_BIT, TRANSFER_DST_BIT),
+                renderer::ImageLayout::SHADER_READ_ONLY_OPTIMAL,
+                std::source_location::current());
+            page.id = renderer::Helper::addImTextureID(sampler_, page.info->view);
+        } catch (...) {
+            return false;
+        }
+        for (int i = kThumbSlotsPerRow * kThumbSlotsPerRow - 1; i >= 0; --i)
+            page.free_slots.push_back(i);
+        thumb_pages_.push_back(std::move(page));
+        return allocThumbSlot(t, frame);
+    }
+    // Atlas full: take the slot of the thumbnail drawn longest ago, unless
+    // a frame that drew it may still be in flight.
+    ThumbTex* victim = nullptr;
+    for (auto& kv : thumb_cache_) {
+        ThumbTex& c = kv.second;
+        if (c.page < 0 || c.last_used_frame + kThumbSlotReuseFrames > frame)
+            continue;
+        if (!victim || c.last_used_frame < victim->last_used_frame)
+            victim = &c;
+    }
+    if (!victim) return false;
+    releaseThumbSlot(*victim);
+    return allocThumbSlot(t, frame);
+}
 
-    std::vector<fs::directory_entry> subs;
-    for (auto& e : fs::directory_iterator(dir, ec)) {
-        if (!e.is_directory()) continue;
-        // Hide dot-folders (.git, .thumbnails, .flux_tmp, …) — internal
-        // bookkeeping, never browsable assets.
-        const std::string fn = e.path().filename().string();
-        if (!fn.empty() && fn[0] == '.') continue;
-        subs.push_back(e);
+void Menu::releaseThumbSlot(ThumbTex& t) {
+    if (t.page >= 0 && t.page < (int)thumb_pages_.size()) {
+        auto& page = thumb_pages_[t.page];
+        // A slot whose copy was never recorded was never drawn either.
+        if (t.resident)
+            page.retired_slots.emplace_back(t.slot, t.last_used_frame);
+        else
+            page.free_slots.push_back(t.slot);
     }
-    std::sort(subs.begin(), subs.end(), [](const auto& a, const auto& b) {
-        return a.path().filename().string() < b.path().filename().string(); });
+    t.page = -1;
+    t.slot = -1;
+    t.resident = false;
+}
+
+void Menu::dropThumbnail(const std::string& src) {
+    auto it = thumb_cache_.find(src);
+    if (it == thumb_cache_.end()) return;
+    releaseThumbSlot(it->second);
+    thumb_cache_.erase(it);
+}
+
+helper::AssetIndex& Menu::browserIndex(bool is_content) {
+    auto& index = is_content ? content_index_ : file_index_;
+    if (!index) {
+        helper::AssetIndexOptions opts;
+        if (is_content) {
+            // Sidecars and markers are bookkeeping, not assets: .rwmeta
+            // (import records, group / terrain markers), the baked
+            // asset_index.tsv, a group's bake.manifest, and the
+            // ".disabled" flags.
+            opts.include = [](const helper::AssetIndexEntry& e) {
+                return e.ext != ".rwmeta" && e.ext != ".disabled" &&
+                       e.name != "asset_index.tsv" &&
+                       e.name != "bake.manifest";
+            };
+        } else {
+            // The File Browser is the raw view; only the enable markers
+            // are hidden, as they always were.
+            opts.include = [](const helper::AssetIndexEntry& e) {
+                return e.ext != ".disabled";
+            };
+        }
+        // Both browsers list LOD 0 only (see drawBrowserBody).
+        opts.is_far_lod = [](const helper::AssetIndexEntry& e) {
+            return e.ext == ".rwgeo" && isFarLodFile(e.path);
+        };
+        index = std::make_unique<helper::AssetIndex>(opts);
+    }
+    return *index;
+}
+
+void Menu::drawFolderTree(const std::string& dir, int depth,
+                          std::string& cur_dir, bool is_content) {
+    namespace fs = std::filesystem;
+    // Sub-folders come from the directory index (dot-folders — .git,
+    // .thumbnails, .flux_tmp, … — are already hidden; dirs sort first).
+    // A folder whose first scan is still queued draws as a non-leaf.
+    const auto snap = browserIndex(is_content).snapshot(dir);
+    if (snap && !snap->exists) return;
+    const size_t sub_count = snap ? snap->dir_count : 0;
+    const bool   no_subs   = snap && sub_count == 0;
 
     std::string name = fs::path(dir).filename().string();
     if (name.empty()) name = dir;
@@ -6083,7 +6294,7 @@ void Menu::drawFolderTree(const std::string& dir, int depth,
                                ImGuiTreeNodeFlags_SpanAvailWidth;
     if (cur_dir == dir) flags |= ImGuiTreeNodeFlags_Selected;
     if (depth == 0)          flags |= ImGuiTreeNodeFlags_DefaultOpen;
-    if (subs.empty())
+    if (no_subs)
         flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
 
     const bool open = ImGui::TreeNodeEx(name.c_str(), flags);
@@ -6105,9 +6316,10 @@ void Menu::drawFolderTree(const std::string& dir, int depth,
                               "(the folder itself is kept)");
         ImGui::EndPopup();
     }
-    if (open && !subs.empty()) {
-        for (auto& s : subs)
-            drawFolderTree(s.path().string(), depth + 1, cur_dir);
+    if (open && !no_subs) {
+        for (size_t i = 0; i < sub_count; ++i)
+            drawFolderTree(snap->entries[i].path, depth + 1, cur_dir,
+                           is_content);
         ImGui::TreePop();
     }
 }
@@ -7065,7 +7277,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                            bool is_content) {
     namespace fs = std::filesystem;
     {
-        thumb_budget_ = 3;   // cap texture loads per frame so big folders don't stall
+        pumpThumbnails();    // once per frame, shared by both browsers
 
         // ── Streaming-import progress (Content Browser only) ───────────
         // Shown while the app's background thread copies the chosen file
@@ -7092,7 +7304,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
 
         // ── Left: folder tree (names only) ────────────────────────────
         ImGui::BeginChild("##cb_tree", ImVec2(left_w, 0), true);
-        drawFolderTree(tree_root, 0, cur_dir);
+        drawFolderTree(tree_root, 0, cur_dir, is_content);
         ImGui::EndChild();
 
         // Vertical splitter between the two panes.
@@ -7222,53 +7434,33 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 content_sel_anchor_.clear();
                 content_browser_last_dir_ = cur_dir;
             }
-            std::vector<fs::directory_entry> items;   // dirs first, then files
-            std::vector<fs::directory_entry> dirs, files;
-            size_t far_lod_hidden = 0;
-            for (auto& e : fs::directory_iterator(cur_dir, ec)) {
-                // Hide dot-entries (.thumbnails, .flux_tmp, .git, …).
-                const std::string fn = e.path().filename().string();
-                if (!fn.empty() && fn[0] == '.') continue;
-                // ── Only LOD 0 is a browsable asset ────────────────
-                // The plant library authors its LODs as separate meshes,
-                // so every species baked three .rwgeo files and the grid
-                // listed all three.  Two of them are meshes that only
-                // make sense from 200 m away — an impostor card is a
-                // cross of two quads — so arrow-keying through the grid
-                // kept landing on one and previewing it at arm's length.
-                // The browser lists LOD 0.  The rest stay on
-                // disk, load with the group, and still draw in the world
-                // at their range; they are just not things to click.
-                if (e.path().extension() == ".rwgeo" &&
-                    isFarLodFile(e.path().string())) {
-                    ++far_lod_hidden;
-                    continue;
-                }
-                // Sidecar metadata / the asset index stay invisible in the
-                // asset view.
-                if (is_content &&
-                    e.path().extension() == ".rwmeta") continue;
-                if (is_content &&
-                    e.path().filename() == "asset_index.tsv") continue;
-                // ".disabled" markers are the persistent form of the
-                // per-tile Enabled toggle — never shown as tiles.
-                if (e.path().extension() == ".disabled") continue;
-                (e.is_directory() ? dirs : files).push_back(e);
-            }
-            auto byname = [](const fs::directory_entry& a, const fs::directory_entry& b) {
-                return a.path().filename().string() < b.path().filename().string(); };
-            std::sort(dirs.begin(), dirs.end(), byname);
-            std::sort(files.begin(), files.end(), byname);
-            items.insert(items.end(), dirs.begin(), dirs.end());
-            items.insert(items.end(), files.begin(), files.end());
+            // Listing comes from the background directory index: scanned
+            // once, kept current by the watcher, already filtered (dot
+            // entries, sidecars, markers, far LODs) and sorted dirs-first.
+            // Holding the snapshot keeps it alive for this frame even if
+            // the index republishes underneath us.
+            const auto snap = browserIndex(is_content).snapshot(cur_dir);
+            static const std::vector<helper::AssetIndexEntry> kNoEntries;
+            const std::vector<helper::AssetIndexEntry>& items =
+                snap ? snap->entries : kNoEntries;
+            // ── Only LOD 0 is a browsable asset ────────────────
+            // The plant library authors its LODs as separate meshes,
+            // so every species baked three .rwgeo files and the grid
+            // listed all three.  Two of them are meshes that only
+            // make sense from 200 m away — an impostor card is a
+            // cross of two quads — so arrow-keying through the grid
+            // kept landing on one and previewing it at arm's length.
+            // The browser lists LOD 0 (the index drops the rest).  They
+            // stay on disk, load with the group, and still draw in the
+            // world at their range; they are just not things to click.
             // Said once per folder, not once per frame.
-            if (far_lod_hidden > 0) {
+            if (snap && snap->far_lod_hidden > 0) {
                 static std::string lod_note_dir;
                 if (lod_note_dir != cur_dir) {
                     lod_note_dir = cur_dir;
                     EditorLog::get().push(
                         "[browser] LOD 0 only — " +
-                        std::to_string(far_lod_hidden) +
+                        std::to_string(snap->far_lod_hidden) +
                         " mesh(es) at LOD 1+ not listed here (they load with "
                         "the group and draw at range)");
                 }
@@ -7283,12 +7475,45 @@ void Menu::drawBrowserBody(const std::string& tree_root,
             // column to grid_x0 + k*(cell+14) so wide labels can't skew the row.
             const float grid_x0 = ImGui::GetCursorPosX();
 
-            for (size_t i = 0; i < items.size(); ++i) {
-                const fs::directory_entry& e = items[i];
-                const std::string name = e.path().filename().string();
-                std::string ext = e.path().extension().string();
-                for (auto& c : ext) c = (char)std::tolower((unsigned char)c);
-                const bool is_dir = e.is_directory();
+            // Which tile the Debug Display is showing (amber border).
+            auto tileIsPreviewed = [&](const helper::AssetIndexEntry& t) {
+                if (!is_content) return false;
+                if (t.ext == ".rwobj")
+                    return preview_nav_ == PreviewNav::RwObjSiblings &&
+                           t.path == preview_nav_path_;
+                if (t.ext == ".gltf" || t.ext == ".glb" ||
+                    t.ext == ".obj"  || t.ext == ".fbx")
+                    return dbg_asset_key_ == t.path + "#-1";
+                if (t.ext == ".rwgeo")
+                    return dbg_asset_key_ == t.path + "#geo";
+                return false;
+            };
+
+            // Only the visible rows are laid out — a folder of 50k baked
+            // files costs what one screenful costs.  Arrow-key navigation
+            // may select a tile that is scrolled away, so its row is forced
+            // in for the frame that scrolls to it.
+            const int grid_rows = ((int)items.size() + cols - 1) / cols;
+            ImGuiListClipper grid_clipper;
+            grid_clipper.Begin(grid_rows);
+            if (browser_scroll_to_selected_) {
+                for (size_t k = 0; k < items.size(); ++k) {
+                    if (tileIsPreviewed(items[k])) {
+                        grid_clipper.IncludeItemByIndex((int)(k / (size_t)cols));
+                        break;
+                    }
+                }
+            }
+            while (grid_clipper.Step())
+            for (size_t i = (size_t)grid_clipper.DisplayStart * (size_t)cols,
+                        i_end = std::min(items.size(),
+                            (size_t)grid_clipper.DisplayEnd * (size_t)cols);
+                 i < i_end; ++i) {
+                const helper::AssetIndexEntry& ent = items[i];
+                const fs::path e_path(ent.path);
+                const std::string& name = ent.name;
+                const std::string& ext = ent.ext;
+                const bool is_dir = ent.is_dir;
                 const bool is_img = (ext == ".png" || ext == ".jpg" ||
                                      ext == ".jpeg" || ext == ".bmp" ||
                                      ext == ".tga"  || ext == ".dds");
@@ -7327,29 +7552,26 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 const bool is_rwtex  = (ext == ".rwtex");
                 // Import GROUP folder (holds import.rwmeta + .rwobj files):
                 // placeable as a whole — every object, original layout.
-                bool is_group_dir = false;
-                if (is_content && is_dir) {
-                    std::error_code gec;
-                    is_group_dir =
-                        fs::exists(e.path() / "import.rwmeta", gec);
-                }
+                const bool is_group_dir = is_content && ent.is_group_dir;
                 // Generated TERRAIN folder (holds terrain.rwmeta): one
                 // whole world as a single asset — the heightmap, its
                 // colour/segmentation maps, and the imported PCG layer
                 // groups nested inside.  Every generation writes a new
                 // one, so several sit side by side; dropping one into
                 // the scene makes it the terrain.
-                bool is_terrain_dir = false;
-                if (is_content && is_dir) {
-                    std::error_code tec;
-                    is_terrain_dir =
-                        fs::exists(e.path() / "terrain.rwmeta", tec);
-                }
+                const bool is_terrain_dir = is_content && ent.is_terrain_dir;
 
                 // Anything with a generatable thumbnail goes through getThumbnail;
-                // it returns 0 (→ type tile) for formats we can't render yet.
-                ImTextureID tex = (!is_dir && (is_img || is_model || is_rwtex))
-                                  ? getThumbnail(e.path().string()) : 0;
+                // it returns 0 (→ type tile) while queued or for formats we
+                // can't render.  Priority = position among the visible tiles,
+                // so the top rows fill in first.
+                const ThumbRef thumb =
+                    (!is_dir && (is_img || is_model || is_rwtex))
+                        ? getThumbnail(ent.path, ent.mtime,
+                              (int)(i - (size_t)grid_clipper.DisplayStart *
+                                            (size_t)cols))
+                        : ThumbRef{};
+                const ImTextureID tex = thumb.id;
 
                 ImGui::PushID((int)i);
                 // Debug enable flag: disabled assets are greyed out in the
@@ -7358,12 +7580,9 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 // a disabled sub-mesh is SKIPPED everywhere (forward, CSM,
                 // both RT shadow paths).  The in-memory set mirrors the
                 // sidecars for cheap per-frame dimming.
-                const std::string item_path = e.path().string();
-                {
-                    std::error_code dec;
-                    if (fs::exists(item_path + ".disabled", dec))
-                        content_disabled_.insert(item_path);
-                }
+                const std::string& item_path = ent.path;
+                if (ent.disabled)
+                    content_disabled_.insert(item_path);
                 const bool tile_disabled =
                     content_disabled_.find(item_path) != content_disabled_.end();
                 if (tile_disabled)
@@ -7372,13 +7591,14 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 ImGui::BeginGroup();
                 bool clicked = false;
                 if (tex) {
-                    clicked = ImGui::ImageButton("##t", tex, ImVec2(cell, cell));
+                    clicked = ImGui::ImageButton("##t", tex, ImVec2(cell, cell),
+                                                 thumb.uv0, thumb.uv1);
                 } else {
                     // Audio tiles flip to a brighter "PLAYING" tint while
                     // their clip is on the preview bus.
                     const bool audio_playing =
                         is_audio && audio_preview_handle_ != 0 &&
-                        audio_preview_path_ == e.path().string() &&
+                        audio_preview_path_ == e_path.string() &&
                         engine::audio::AudioEngine::isPlaying(
                             audio_preview_handle_);
                     const ImVec4 c = is_dir    ? ImVec4(0.24f, 0.31f, 0.45f, 1.0f)
@@ -7414,25 +7634,25 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                     ImGui::IsItemHovered() &&
                     ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left);
                 if (tile_dbl && (is_dir || (is_content && is_model))) {
-                    cur_dir = e.path().string();
+                    cur_dir = e_path.string();
                 }
                 // Double-click a .anim → preview it on the standard rig in the
                 // right-side Debug Display (works in either browser).
                 if (tile_dbl && is_anim) {
                     buildStandardRigAnimPreview(
-                        e.path().string(),
-                        e.path().stem().string());
+                        e_path.string(),
+                        e_path.stem().string());
                 }
                 // Double-click a .scene → ask the app to open it.  The app
                 // skips the load when this file is already the live scene,
                 // so a stray double-click can't dump unsaved edits.
                 if (tile_dbl && is_scene) {
-                    content_scene_open_request_ = e.path().string();
+                    content_scene_open_request_ = e_path.string();
                 }
                 // Double-click an image → full-size viewer (the tile only
                 // shows the downscaled thumbnail).
                 if (tile_dbl && is_img) {
-                    openImageViewer(e.path().string());
+                    openImageViewer(e_path.string());
                 }
 
                 // Drag a placeable tile into the 3D viewport to add it to
@@ -7445,7 +7665,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                     (is_model || is_object || is_group_dir ||
                      is_terrain_dir || is_img || is_audio) &&
                     ImGui::BeginDragDropSource()) {
-                    const std::string pay = e.path().string();
+                    const std::string pay = e_path.string();
                     ImGui::SetDragDropPayload("RW_CONTENT_ASSET",
                                               pay.c_str(), pay.size() + 1);
                     ImGui::TextUnformatted(name.c_str());
@@ -7468,18 +7688,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 // The tile whose object is currently shown in the Debug
                 // Display (clicked or arrow-stepped) gets an amber border,
                 // matching the editor's selection colour.
-                bool tile_selected = false;
-                if (is_content && is_object &&
-                    preview_nav_ == PreviewNav::RwObjSiblings) {
-                    tile_selected =
-                        (e.path().string() == preview_nav_path_);
-                } else if (is_content && is_model) {
-                    tile_selected =
-                        (dbg_asset_key_ == e.path().string() + "#-1");
-                } else if (is_content && is_geo) {
-                    tile_selected =
-                        (dbg_asset_key_ == e.path().string() + "#geo");
-                }
+                const bool tile_selected = tileIsPreviewed(ent);
                 if (tile_selected) {
                     const ImVec2 ra = ImGui::GetItemRectMin();
                     const ImVec2 rb = ImGui::GetItemRectMax();
@@ -7538,6 +7747,9 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                                 std::ofstream(sp + ".disabled") << "1\n";
                             }
                         }
+                        // Republish now: a snapshot from before the toggle
+                        // would put the old state back next frame.
+                        browserIndex(is_content).rescan(cur_dir);
                         dbg_asset_key_.clear();
                         EditorLog::get().push(
                             std::string("[content] ") +
@@ -7571,7 +7783,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                         }
                     }
                     if (ImGui::MenuItem("Rename")) {
-                        rename_target_ = e.path().string();
+                        rename_target_ = e_path.string();
                         std::snprintf(rename_buf_, sizeof(rename_buf_), "%s",
                                       name.c_str());
                         rename_open_ = true;
@@ -7599,9 +7811,9 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                     // anything it displayed.  Nothing below is content
                     // specific: deleteOne() in the confirm dialog already
                     // handles a plain file, a directory, and a model's
-                    // rwmeta / exploded / thumbnail sidecars alike, and the
-                    // grid re-reads the directory every frame, so a removed
-                    // tile disappears without a cache to invalidate.
+                    // rwmeta / exploded / thumbnail sidecars alike, and it
+                    // rescans the parent in the directory index, so a removed
+                    // tile disappears on the next frame.
                     if (ImGui::MenuItem(multi
                             ? (std::string("Delete (") +
                                std::to_string(sel_n) + ")").c_str()
@@ -7635,7 +7847,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 } else if (clicked && is_content && mod_shift) {
                     int ai = -1, ci = -1;
                     for (int k = 0; k < (int)items.size(); ++k) {
-                        const std::string sp = items[k].path().string();
+                        const std::string& sp = items[k].path;
                         if (sp == content_sel_anchor_) ai = k;
                         if (sp == item_path)           ci = k;
                     }
@@ -7644,7 +7856,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                         content_selected_.clear();
                         const int lo = std::min(ai, ci), hi = std::max(ai, ci);
                         for (int k = lo; k <= hi; ++k)
-                            content_selected_.insert(items[k].path().string());
+                            content_selected_.insert(items[k].path);
                     }
                 } else if (clicked && is_content) {
                     content_selected_.clear();
@@ -7663,7 +7875,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                     if (is_terrain_dir && is_content) {
                         // A terrain is not geometry you can orbit — the
                         // readout is the preview.
-                        buildTerrainFolderPreview(e.path().string(), name);
+                        buildTerrainFolderPreview(e_path.string(), name);
                     } else if (is_group_dir && is_content) {
                         // Group folder, Explorer-style: a single CLICK previews
                         // the assembled collection in the Debug Display; a
@@ -7676,33 +7888,33 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                         // back to the merge for an empty marker file).
                         std::error_code iec;
                         const fs::path ipath =
-                            e.path() / "instances.rwinst";
+                            e_path / "instances.rwinst";
                         if (fs::exists(ipath, iec))
                             buildRwInstPreview(ipath.string(), name);
                         else
-                            buildRwGroupPreview(e.path().string(), name);
+                            buildRwGroupPreview(e_path.string(), name);
                     } else {
-                        cur_dir = e.path().string();   // plain folder: enter
+                        cur_dir = e_path.string();   // plain folder: enter
                     }
                 } else if (plain_click && is_content && is_model) {
-                    buildAssetPreview(e.path().string(), -1, name);
+                    buildAssetPreview(e_path.string(), -1, name);
                 } else if (plain_click && is_content && is_object) {
                     // Prefers the baked .rwgeo/.rwtex render-ready data.
-                    buildRwObjPreview(e.path().string(), name);
+                    buildRwObjPreview(e_path.string(), name);
                 } else if (plain_click && is_content && is_geo) {
-                    buildRwGeoPreview(e.path().string(), name);
+                    buildRwGeoPreview(e_path.string(), name);
                 } else if (plain_click && is_content && is_inst) {
-                    buildRwInstPreview(e.path().string(), name);
+                    buildRwInstPreview(e_path.string(), name);
                 } else if (plain_click && is_content && is_hier) {
-                    buildRwHierPreview(e.path().string(), name);
+                    buildRwHierPreview(e_path.string(), name);
                 } else if (plain_click && is_content && is_rwanim) {
-                    buildRwAnimPreview(e.path().string(), name);
+                    buildRwAnimPreview(e_path.string(), name);
                 } else if (plain_click && is_content && is_rwtex) {
-                    buildRwTexPreview(e.path().string(), name);
+                    buildRwTexPreview(e_path.string(), name);
                 } else if (plain_click && is_audio) {
                     // Toggle preview: clicking the playing clip stops it;
                     // clicking another clip switches to it.
-                    const std::string p = e.path().string();
+                    const std::string p = e_path.string();
                     const bool was_this =
                         audio_preview_handle_ != 0 &&
                         audio_preview_path_ == p &&
@@ -7724,11 +7936,16 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                     }
                 }
 
-                if ((int)((i + 1) % (size_t)cols) != 0)
+                // The last tile must end its row: the clipper measures the
+                // row height from the cursor, and a dangling SameLine on a
+                // one-row folder would leave it at zero.
+                if ((int)((i + 1) % (size_t)cols) != 0 && i + 1 < items.size())
                     ImGui::SameLine(grid_x0 +
                         (float)((i + 1) % (size_t)cols) * (cell + 14.0f));
             }
-            if (items.empty()) ImGui::TextDisabled("(empty)");
+            grid_clipper.End();
+            if (!snap) ImGui::TextDisabled("(scanning...)");
+            else if (items.empty()) ImGui::TextDisabled("(empty)");
         } else {
             ImGui::TextDisabled("(folder not found: %s)", cur_dir.c_str());
         }
@@ -7756,7 +7973,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 // content_disabled_ set the per-tile right-click toggle uses
                 // (disabled items render dimmed and are skipped by the loader /
                 // assembler at build time).  Keys are the entry path strings,
-                // exactly as inserted per-tile (e.path().string()).
+                // exactly as inserted per-tile (AssetIndexEntry::path).
                 auto setFolderEnabled = [&](bool enabled) {
                     std::error_code lec;
                     int n = 0;
@@ -7773,6 +7990,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                             std::ofstream(ip + ".disabled") << "1\n";
                         }
                     }
+                    browserIndex(true).rescan(cur_dir);
                     EditorLog::get().push(
                         std::string("[content] ") + (enabled ? "enabled " : "disabled ") +
                         std::to_string(n) + " item(s) in " + cur_dir);
@@ -7847,6 +8065,8 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                             fs::rename(meta_src,
                                        dst.string() + ".rwmeta", mec);
                         }
+                        browserIndex(is_content).rescan(
+                            src.parent_path().string());
                     }
                 }
                 ImGui::CloseCurrentPopup();
@@ -7914,6 +8134,8 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                         const fs::path exploded = t.parent_path() / t.stem();
                         if (fs::is_directory(exploded, dec2))
                             fs::remove_all(exploded, dec2);
+                        // Sidecar PNG written before thumbnails moved
+                        // into the shared cache file.
                         const fs::path thumb = t.parent_path() / ".thumbnails" /
                             (t.filename().string() + ".png");
                         fs::remove(thumb, dec2);
@@ -7925,14 +8147,11 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                         EditorLog::get().push("[delete] removed '" +
                             t.filename().string() + "'");
                     asset_children_cache_.erase(path);
-                    auto itc = thumb_cache_.find(path);
-                    if (itc != thumb_cache_.end()) {
-                        if (itc->second.info)
-                            retired_thumbs_.push_back(itc->second.info);
-                        thumb_cache_.erase(itc);
-                    }
+                    dropThumbnail(path);
                     if (cur_dir.rfind(path, 0) == 0) cur_dir = tree_root;
                     content_selected_.erase(path);
+                    browserIndex(is_content).rescan(
+                        t.parent_path().string());
                 };
                 for (const auto& dp : del_list) deleteOne(dp);
                 delete_paths_.clear();
@@ -8010,12 +8229,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                     }
                     // drop caches that referenced the removed path
                     asset_children_cache_.erase(vp);
-                    auto itc = thumb_cache_.find(vp);
-                    if (itc != thumb_cache_.end()) {
-                        if (itc->second.info)
-                            retired_thumbs_.push_back(itc->second.info);
-                        thumb_cache_.erase(itc);
-                    }
+                    dropThumbnail(vp);
                     content_selected_.erase(vp);
                 }
                 EditorLog::get().push("[clear] '" +
@@ -8028,6 +8242,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                 if (cur_dir.rfind(clear_target_, 0) == 0 &&
                     cur_dir != clear_target_)
                     cur_dir = clear_target_;
+                browserIndex(is_content).rescan(clear_target_);
                 content_sel_anchor_.clear();
                 clear_target_.clear();
                 ImGui::CloseCurrentPopup();
@@ -8074,6 +8289,7 @@ void Menu::drawBrowserBody(const std::string& tree_root,
                         } else {
                             EditorLog::get().push(
                                 "[content] created folder: " + np.string());
+                            browserIndex(true).rescan(cur_dir);
                             cur_dir = np.string();
                         }
                     }
@@ -9958,9 +10174,9 @@ void Menu::buildRwGroupPreview(const std::string& group_dir,
             md.positions.empty() || md.indices.empty()) {
             continue;
         }
-        // v6 bakes: merge LOD 0 only (decimated levels are appended
-        // after the section spans).
-        if (!md.lod_ranges.empty()) {
+        // v6 / v8 bakes: merge LOD 0 only (decimated levels and the
+        // cluster DAG are appended after the section spans).
+        if (!md.lod_ranges.empty() || !md.cluster_dag.empty()) {
             uint32_t lod0_end = 0;
             for (const auto& sec : md.sections)
                 lod0_end = std::max(lod0_end,
@@ -10323,9 +10539,9 @@ void Menu::buildRwGeoPreview(const std::string& rwgeo_path,
             "[preview] baked geometry unreadable: " + rwgeo_path);
         return;
     }
-    // v6 bakes append decimated LOD indices after the full-detail
-    // sections — the preview shows LOD 0 only.
-    if (!data.lod_ranges.empty()) {
+    // v6 / v8 bakes append decimated LOD and cluster-DAG indices after
+    // the full-detail sections — the preview shows LOD 0 only.
+    if (!data.lod_ranges.empty() || !data.cluster_dag.empty()) {
         uint32_t lod0_end = 0;
         for (const auto& sec : data.sections)
             lod0_end = std::max(lod0_end,
@@ -10520,9 +10736,11 @@ void Menu::buildRwInstPreview(const std::string& rwinst_path,
             std::vector<std::string> tpaths;
             if (engine::helper::loadRwGeo(git->second, gc.md, &tpaths) &&
                 !gc.md.positions.empty() && gc.md.indices.size() >= 3) {
-                // v6 bakes append decimated LOD indices after the section
-                // spans — the preview shows LOD 0 only.
-                if (!gc.md.lod_ranges.empty()) {
+                // v6 / v8 bakes append decimated LOD and cluster-DAG
+                // indices after the section spans — the preview shows
+                // LOD 0 only.
+                if (!gc.md.lod_ranges.empty() ||
+                    !gc.md.cluster_dag.empty()) {
                     uint32_t lod0_end = 0;
                     for (const auto& s : gc.md.sections)
                         lod0_end = std::max(lod0_end,
@@ -11238,7 +11456,7 @@ void Menu::drawDebugDisplayPanel() {
         // Uploading is main-thread GPU work (command buffer + queue submit
         // + device allocation) and MUST NOT run while the async mesh
         // loader is doing the same on its worker — the identical hazard
-        // getThumbnail documents.  The path waits here until the loader
+        // pumpThumbnails documents.  The path waits here until the loader
         // has drained; the panel shows "Decoding..." meanwhile.
         if (!dbg_tex_pending_.empty() &&
             !(mesh_load_task_manager_ &&
@@ -12,8 +12,11 @@
 #include <cstdint>
 #include <future>                  // text-to-animation worker (Generate Animation)
 #include "renderer/renderer.h"
+#include "renderer/frame_upload_ring.h"
 #include "helper/mesh_preview.h"   // Debug Display GPU preview payload
 #include "helper/model_inspect.h"  // RwAnimClip (animated preview)
+#include "helper/asset_index.h"    // watched directory listings (browsers)
+#include "helper/thumbnail_cache.h" // background browser thumbnails
 #include "scene/scene_types.h"     // group-node transform editing (Details)
 #include "scene_rendering/skydome.h"
 #include "shaders/global_definition.glsl.h"
@@ -480,6 +483,17 @@ private:
     std::shared_ptr<renderer::Device> device_;
     std::shared_ptr<renderer::Sampler> sampler_;
 
+    // Staging for the uploads recordFrameUploads() records on the frame's
+    // command buffer, retired on draw_frame_ (kMaxFramesInFlight + 1).
+    renderer::FrameUploadRing frame_uploads_{ 8ull << 20, 3 };
+    // Menu::draw calls.  Unlike ImGui's frame count it survives the
+    // context being recreated with the swapchain.
+    uint64_t draw_frame_ = 0;
+    // Record this frame's texture uploads into `cmd_buf` — streamed .ktx2
+    // mips, then placed thumbnails.  Called at the top of draw(), before
+    // any render pass is open.
+    void recordFrameUploads(const std::shared_ptr<renderer::CommandBuffer>& cmd_buf);
+
     // Stars detected in the background image at load time.
     // Positions are normalised [0,1] so they scale with any viewport.
     struct DetectedStar {
@@ -1073,7 +1087,7 @@ public:
 
     // ── .rwtex: decoded image shown in place of the mesh preview ───────
     // Uploaded on an IDLE frame only (main-thread GPU work races the async
-    // mesh loader — same hazard getThumbnail documents), so the path is
+    // mesh loader — same hazard pumpThumbnails documents), so the path is
     // parked in dbg_tex_pending_ until the loader has drained.
     std::shared_ptr<renderer::TextureInfo> dbg_tex_info_;
     ImTextureID  dbg_tex_id_ = ImTextureID(0);
@@ -1126,6 +1140,10 @@ public:
     std::unordered_set<std::string> content_selected_;
     std::string content_sel_anchor_;          // Shift+click range pivot
     std::string content_browser_last_dir_;    // dir change -> clear selection
+    // Background directory indexes behind the folder tree and asset grid —
+    // one per browser because they filter differently (see browserIndex).
+    std::unique_ptr<helper::AssetIndex> content_index_;
+    std::unique_ptr<helper::AssetIndex> file_index_;
     // File Browser current folder — raw disk view rooted at the project dir.
     std::string  file_dir_          = ".";
     float        file_left_w_       = 0.0f;   // File Browser splitter width
@@ -1276,6 +1294,7 @@ public:
     double vram_total_mb_  = 0.0;   // Vulkan device-local capacity
     double vram_dev_used_mb_  = 0.0; // device-wide used (all consumers, ML incl.)
     double vram_dev_total_mb_ = 0.0; // device-wide capacity (CUDA-reported)
+    double vram_tex_mb_    = 0.0;   // shared texture cache (residency manager)
     double vram_last_poll_ = -1.0;  // ImGui::GetTime() of last query
     bool   vram_valid_     = false; // Vulkan query succeeded
     bool   vram_dev_valid_ = false; // CUDA device-wide query succeeded
@@ -1301,31 +1320,65 @@ private:
     void drawBrowserBody(const std::string& tree_root, std::string& cur_dir,
                          float& left_w, bool is_content);
     void drawFluxGeneratePopup();     // FLUX.2 popup + poll (once per frame)
-    void drawFolderTree(const std::string& dir, int depth, std::string& cur_dir);
-    // Lazily load (budgeted) a thumbnail texture for an asset; returns 0 (none)
-    // for files that have no thumbnail yet / failed.
-    ImTextureID getThumbnail(const std::string& path);
-    // Make sure a sidecar thumbnail PNG exists and is up to date.  Returns the
-    // thumbnail path on success, or "" if none could be produced.  Regenerates
-    // only when the source asset is newer than the existing thumbnail
-    // (mtime comparison) — otherwise the cached PNG is kept as-is.
-    std::string ensureThumbnail(const std::string& src);
-
-    // Content-browser thumbnail cache (source path -> loaded texture).  Loads
-    // are budgeted per frame so opening a big folder doesn't stall.  Each entry
-    // records the source mtime it was built from; if the source later changes,
-    // the entry is rebuilt and the stale GPU texture is retired (kept alive
-    // until shutdown so ImGui never references a freed descriptor).
+    void drawFolderTree(const std::string& dir, int depth, std::string& cur_dir,
+                        bool is_content);
+    // The Content / File Browser directory index, created on first use.
+    helper::AssetIndex& browserIndex(bool is_content);
+    // Content-browser thumbnails.  Pixels come from thumb_queue_ — worker
+    // threads backed by one content-hash-keyed cache file — and are placed
+    // into a few shared atlas pages (one GPU texture + ImTextureID each).
+    // thumb_cache_ maps source path -> atlas slot; entries are keyed by the
+    // source mtime the directory index reported, so an edited file is
+    // re-requested.  Slots are recycled least-recently-drawn first, and
+    // only once the frames that drew them have retired.
+    struct ThumbRef {
+        ImTextureID id = 0;                    // 0: none (draw a type tile)
+        ImVec2      uv0{ 0.0f, 0.0f };
+        ImVec2      uv1{ 1.0f, 1.0f };
+    };
     struct ThumbTex {
+        int      page = -1;                    // atlas page, -1 = no slot
+        int      slot = -1;
+        ImVec2   uv0{ 0.0f, 0.0f }, uv1{ 0.0f, 0.0f };
+        bool     resident = false;             // slot's copy recorded
+        bool     failed = false;               // no thumbnail for this file
+        int64_t  src_mtime = 0;
+        uint64_t last_used_frame = 0;          // draw_frame_
+    };
+    struct ThumbAtlasPage {
         std::shared_ptr<renderer::TextureInfo> info;
-        ImTextureID                            id     = 0;
-        bool                                   failed = false;
-        std::filesystem::file_time_type        src_time{};
+        ImTextureID                            id = 0;
+        std::vector<int>                       free_slots;
+        // Released slots and the frame they were last drawn in; they
+        // rejoin free_slots once that frame has retired.
+        std::vector<std::pair<int, uint64_t>>  retired_slots;
+    };
+    // A placed thumbnail waiting for recordFrameUploads().
+    struct ThumbUpload {
+        std::string          path;
+        int                  page = -1;
+        int                  slot = -1;
+        glm::uvec2           size{ 0, 0 };
+        std::vector<uint8_t> rgba;
     };
+    // Thumbnail for an asset tile, or {0} while it is queued / has none.
+    // `priority` orders requests within a frame (lower = sooner).
+    ThumbRef getThumbnail(const std::string& path, int64_t src_mtime,
+                          int priority);
+    void pumpThumbnails();
+    bool allocThumbSlot(ThumbTex& t, uint64_t frame);
+    void releaseThumbSlot(ThumbTex& t);
+    void dropThumbnail(const std::string& path);
+
+    std::unique_ptr<helper::ThumbnailQueue>   thumb_queue_;
+    std::vector<ThumbAtlasPage>               thumb_pages_;
     std::unordered_map<std::string, ThumbTex> thumb_cache_;
+    std::vector<ThumbUpload>                  thumb_uploads_;
+    // Superseded full-size textures (image viewer, Debug Display), kept alive
+    // so ImGui never references a freed descriptor.
     std::vector<std::shared_ptr<renderer::TextureInfo>> retired_thumbs_;
+    int   thumb_pump_frame_ = -1;
     float content_left_w_ = 0.0f;
-    int   thumb_budget_   = 0;
 
     // Content Browser rename (right-click a tile → Rename → dialog).
     std::string rename_target_;        // full path of the item being renamed